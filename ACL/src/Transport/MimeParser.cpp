@@ -14,6 +14,7 @@
  */
 
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Timing/LatencyTrace.h>
 #include "ACL/Transport/MimeParser.h"
 #include <sstream>
 
@@ -47,6 +48,34 @@ static const int LEADING_CRLF_CHAR_SIZE = 2;
 static const char CARRIAGE_RETURN_ASCII = 13;
 /// ASCII value of LF
 static const char LINE_FEED_ASCII = 10;
+/// The quoted key of the dialogRequestId in the header of a directive.
+static const std::string DIALOG_REQUEST_ID_KEY = "\"dialogRequestId\"";
+
+/**
+ * Finds the dialogRequestId of a directive without parsing its JSON, which is left to the @c MessageInterpreter.
+ *
+ * @param directive The JSON text of the directive.
+ * @return The dialogRequestId, or an empty string if the directive has none.
+ */
+static std::string findDialogRequestId(const std::string& directive) {
+    auto key = directive.find(DIALOG_REQUEST_ID_KEY);
+    if (std::string::npos == key) {
+        return "";
+    }
+    auto colon = directive.find(':', key + DIALOG_REQUEST_ID_KEY.size());
+    if (std::string::npos == colon) {
+        return "";
+    }
+    auto start = directive.find('"', colon + 1);
+    if (std::string::npos == start) {
+        return "";
+    }
+    auto end = directive.find('"', start + 1);
+    if (std::string::npos == end) {
+        return "";
+    }
+    return directive.substr(start + 1, end - start - 1);
+}
 
 /**
  *  Sanitize the Content-ID field in MIME header.
@@ -235,6 +264,12 @@ void MimeParser::partEndCallback(void* userData) {
             }
             // Check there's data to send out, because in a re-drive we may skip a directive that's been seen before.
             if (parser->m_directiveBeingReceived != "") {
+                auto& latencyTrace = timing::LatencyTrace::getInstance();
+                if (latencyTrace.isEnabled()) {
+                    latencyTrace.record(
+                        timing::LatencyTrace::Point::DIRECTIVE_RECEIVED,
+                        findDialogRequestId(parser->m_directiveBeingReceived));
+                }
                 parser->m_messageConsumer->consumeMessage(
                     parser->m_attachmentContextId, parser->m_directiveBeingReceived);
                 parser->m_directiveBeingReceived = "";
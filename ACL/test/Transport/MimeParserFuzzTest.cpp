@@ -145,7 +145,9 @@ public:
 };
 
 void MimeParserFuzzTest::SetUp() {
-    m_attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    // Cap attachment growth so that the writer still blocks on the slow reader.
+    m_attachmentManager = std::make_shared<AttachmentManager>(
+        AttachmentManager::AttachmentType::IN_PROCESS, InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES);
     auto testableConsumer = std::make_shared<TestableConsumer>();
     testableConsumer->setMessageObserver(std::make_shared<TestableMessageObserver>());
     m_parser = std::make_shared<MimeParser>(testableConsumer, m_attachmentManager);
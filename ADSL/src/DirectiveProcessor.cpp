@@ -20,6 +20,7 @@
 #include <AVSCommon/AVS/ExceptionErrorType.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
+#include <AVSCommon/Utils/Timing/LatencyTrace.h>
 
 #include "ADSL/DirectiveProcessor.h"
 
@@ -243,6 +244,8 @@ bool DirectiveProcessor::handleDirectiveLocked(std::unique_lock<std::mutex>& loc
     m_isHandlingDirective = true;
     lock.unlock();
     auto policy = BlockingPolicy::NONE;
+    utils::timing::LatencyTrace::getInstance().record(
+        utils::timing::LatencyTrace::Point::DIRECTIVE_DISPATCHED, directive->getDialogRequestId());
     auto handled = m_directiveRouter->handleDirective(directive, &policy);
     lock.lock();
     if (!handled || BlockingPolicy::BLOCKING != policy) {
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTBUFFERPOOL_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTBUFFERPOOL_H_
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * A pool of the buffers which back in-process attachments.
+ *
+ * Buffers are grouped in size classes, which are powers of two of the stream's data size.  A stream created by this
+ * pool holds its buffer until the stream and every reader and writer on it have been destroyed, at which point the
+ * buffer is returned to the pool (if the pool still exists and has room for it) instead of being freed.  The next
+ * stream of the same size class then reuses the buffer instead of allocating a new one.  The idle buffers are bounded
+ * both per size class and in total bytes of stream data, and @c releaseIdleBuffers() frees those which have not been
+ * reused for a while, so that the buffers kept after a peak in demand are eventually given back.
+ *
+ * This class is thread safe.
+ */
+class AttachmentBufferPool : public std::enable_shared_from_this<AttachmentBufferPool> {
+public:
+    /// Type aliases for convenience.
+    using SDSType = avsCommon::utils::sds::InProcessSDS;
+    using SDSBufferType = avsCommon::utils::sds::InProcessSDSTraits::Buffer;
+
+    /// The smallest size class, in bytes of stream data.
+    static constexpr size_t MINIMUM_SIZE_CLASS_IN_BYTES = 0x1000;
+
+    /// The default number of idle buffers kept in each size class.
+    static constexpr size_t DEFAULT_MAX_IDLE_BUFFERS_PER_SIZE_CLASS = 4;
+
+    /// The default maximum number of bytes of stream data held by idle buffers over all size classes.
+    static constexpr size_t DEFAULT_MAX_IDLE_BYTES = 0x100000;
+
+    /**
+     * Create an @c AttachmentBufferPool.
+     *
+     * @param maxIdleBuffersPerSizeClass The maximum number of idle buffers kept in each size class.  Buffers released
+     *     to a size class which is already full are freed.
+     * @param maxIdleBytes The maximum number of bytes of stream data held by idle buffers, not counting the headers of
+     *     the streams, so that a buffer of a size class as large as the limit can be kept.  Buffers which would take
+     *     the pool over this limit are freed.
+     * @return The new pool.
+     */
+    static std::shared_ptr<AttachmentBufferPool> create(
+        size_t maxIdleBuffersPerSizeClass = DEFAULT_MAX_IDLE_BUFFERS_PER_SIZE_CLASS,
+        size_t maxIdleBytes = DEFAULT_MAX_IDLE_BYTES);
+
+    /**
+     * Create a stream whose buffer is taken from this pool.
+     *
+     * @param dataSizeInBytes The minimum number of bytes of data the stream must be able to hold.  The stream will hold
+     *     the data size of the size class @c dataSizeInBytes falls in.
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @return The new stream, or @c nullptr if it could not be created.
+     */
+    std::unique_ptr<SDSType> createSDS(size_t dataSizeInBytes, size_t maxReaders = 1);
+
+    /**
+     * Get the total number of bytes this pool has allocated for buffers over its lifetime.
+     *
+     * @return The number of bytes allocated.
+     */
+    size_t getAllocatedBytes() const;
+
+    /**
+     * Get the number of bytes of stream data held by idle buffers in this pool.
+     *
+     * @return The number of idle bytes.
+     */
+    size_t getIdleBytes() const;
+
+    /**
+     * Free the idle buffers which have not been reused for a given time.
+     *
+     * @param maxIdleTime The time for which a buffer may stay idle before it is freed.
+     */
+    void releaseIdleBuffers(std::chrono::steady_clock::duration maxIdleTime);
+
+private:
+    /// An idle buffer, and the time it was returned to the pool.
+    struct IdleBuffer {
+        /// The buffer.
+        std::unique_ptr<SDSBufferType> buffer;
+        /// The number of bytes of stream data the buffer holds.
+        size_t dataSize;
+        /// The time the buffer was returned to the pool.
+        std::chrono::steady_clock::time_point releaseTime;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param maxIdleBuffersPerSizeClass The maximum number of idle buffers kept in each size class.
+     * @param maxIdleBytes The maximum number of bytes of stream data held by idle buffers.
+     */
+    AttachmentBufferPool(size_t maxIdleBuffersPerSizeClass, size_t maxIdleBytes);
+
+    /**
+     * Take an idle buffer from the pool, or allocate a new one.
+     *
+     * @param bufferSize The size in bytes of the buffer.
+     * @return The buffer.
+     */
+    std::unique_ptr<SDSBufferType> acquireBuffer(size_t bufferSize);
+
+    /**
+     * Return a buffer to the pool, or free it if its size class is full.
+     *
+     * @param buffer The buffer to return.
+     * @param dataSize The number of bytes of stream data the buffer holds.
+     */
+    void releaseBuffer(std::unique_ptr<SDSBufferType> buffer, size_t dataSize);
+
+    /**
+     * Get the size class of a data size.
+     *
+     * @param dataSizeInBytes The data size.
+     * @return The smallest size class which can hold @c dataSizeInBytes.
+     */
+    static size_t getSizeClass(size_t dataSizeInBytes);
+
+    /// The maximum number of idle buffers kept in each size class.
+    const size_t m_maxIdleBuffersPerSizeClass;
+
+    /// The maximum number of bytes of stream data held by idle buffers.
+    const size_t m_maxIdleBytes;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The idle buffers, keyed by buffer size, each in the order they were returned to the pool.
+    std::map<size_t, std::vector<IdleBuffer>> m_idleBuffers;
+
+    /// The total number of bytes allocated for buffers.
+    size_t m_allocatedBytes;
+
+    /// The number of bytes of stream data held by idle buffers.
+    size_t m_idleBytes;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTBUFFERPOOL_H_
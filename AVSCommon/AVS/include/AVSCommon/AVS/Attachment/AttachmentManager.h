@@ -16,10 +16,15 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTMANAGER_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTMANAGER_H_
 
+#include <array>
+#include <atomic>
+#include <list>
 #include <mutex>
 #include <unordered_map>
 
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
 #include "AVSCommon/AVS/Attachment/AttachmentManagerInterface.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -35,6 +40,12 @@ namespace attachment {
  *
  * Application code may query the manager for a reader and writer object at any time, and in any order.
  *
+ * Attachments are spread over a fixed number of shards by a hash of their id, each with its own lock, so that
+ * writers (typically on the network thread) and readers (typically on media threads) working on different
+ * attachments rarely contend.  The buffers backing in-process attachments are taken from an
+ * @c AttachmentBufferPool, so that a burst of attachments reuses the buffers of earlier ones rather than
+ * allocating new ones.
+ *
  * @note Resource management is currently implemented by a timeout approach.  This does have the following limitations:
  *
  *  @li An AttachmentReader or AttachmentWriter has reference to a shared buffer resource for the actual data.  This
@@ -50,8 +61,8 @@ namespace attachment {
 class AttachmentManager : public AttachmentManagerInterface {
 public:
     /**
-     * This is the default timeout value for attachments.  Any attachment which is inspected in the
-     * @c removeExpiredAttachmentsLocked() call, and whose lifetime exceeds this value, will be released.
+     * This is the default timeout value for attachments.  Any attachment whose lifetime exceeds this value will be
+     * released by the @c removeExpiredAttachments() call that follows the creation of a reader or writer.
      */
     static constexpr std::chrono::minutes ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT = std::chrono::hours(12);
 
@@ -75,8 +86,12 @@ public:
      * Constructor.
      *
      * @param attachmentType The type of attachments which will be managed.
+     * @param maxAttachmentSizeInBytes The size up to which the buffer of an attachment may grow while its writer is
+     *     ahead of its reader.
      */
-    AttachmentManager(AttachmentType attachmentType);
+    AttachmentManager(
+        AttachmentType attachmentType,
+        size_t maxAttachmentSizeInBytes = InProcessAttachment::SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES);
 
     std::string generateAttachmentId(const std::string& contextId, const std::string& contentId) const override;
 
@@ -90,6 +105,9 @@ public:
         override;
 
 private:
+    /// The number of shards attachments are spread over.
+    static constexpr size_t NUMBER_OF_SHARDS = 16;
+
     /**
      * A utility structure to encapsulate an @c Attachment, its creation time, and other appropriate data fields.
      */
@@ -103,34 +121,74 @@ private:
         std::chrono::steady_clock::time_point creationTime;
         /// The Attachment this object is managing.
         std::unique_ptr<Attachment> attachment;
+        /// The position of this attachment's id in its shard's @c expiryQueue.
+        std::list<std::string>::iterator expiryQueuePosition;
+    };
+
+    /**
+     * A subset of the attachments being managed, with its own lock.
+     */
+    struct Shard {
+        /// The mutex to ensure the members below are accessed safely.
+        std::mutex mutex;
+        /// The map of attachment details.
+        std::unordered_map<std::string, AttachmentManagementDetails> attachmentDetailsMap;
+        /// The ids of the attachments in @c attachmentDetailsMap, oldest first.
+        std::list<std::string> expiryQueue;
     };
 
+    /**
+     * Get the shard which holds an attachment.
+     *
+     * @param attachmentId The attachment id.
+     * @return The shard which holds the attachment.
+     */
+    Shard& getShard(const std::string& attachmentId);
+
     /**
      * A utility function to acquire the details object for an attachment being managed.  This function
      * encapsulates logic to set up the object if it does not already exist, before returning it.
      *
-     * @note The class mutex @c m_mutex must be locked before calling this function.
+     * @note The shard's mutex must be locked before calling this function.
      *
+     * @param shard The shard which holds the attachment.
      * @param attachmentId The attachment id for the attachment detail being requested.
      * @return The attachment detail object.
      */
-    AttachmentManagementDetails& getDetailsLocked(const std::string& attachmentId);
+    AttachmentManagementDetails& getDetailsLocked(Shard& shard, const std::string& attachmentId);
+
+    /**
+     * A cleanup function, which will release the @c AttachmentManagementDetails of @c attachmentId from its shard if
+     * both a writer and reader have been created.
+     *
+     * @note: The shard's mutex must be acquired before calling this function.
+     *
+     * @param shard The shard which holds the attachment.
+     * @param attachmentId The id of the attachment which has just been accessed.
+     */
+    void removeCompletedAttachmentLocked(Shard& shard, const std::string& attachmentId);
 
     /**
-     * A cleanup function, which will release an @c AttachmentManagementDetails from the map if either both a writer
-     * and reader have been created, or if its lifetime has exceeded the timeout.
-     * @note: @c m_mutex must be acquired before calling this function.
+     * A cleanup function, which will release any attachment in any shard whose lifetime has exceeded the timeout, and
+     * free the pooled buffers which have stayed idle for too long.  It does nothing if it last ran only a short while
+     * ago.
+     *
+     * @note: No shard's mutex may be held when calling this function.
      */
-    void removeExpiredAttachmentsLocked();
+    void removeExpiredAttachments();
 
     /// The type of attachments that this manager will create.
     AttachmentType m_attachmentType;
     /// The timeout in minutes.  Any attachment whose lifetime exceeds this value will be released.
-    std::chrono::minutes m_attachmentExpirationMinutes;
-    /// The mutex to ensure the non-static public APIs are thread safe.
-    std::mutex m_mutex;
-    /// The map of attachment details.
-    std::unordered_map<std::string, AttachmentManagementDetails> m_attachmentDetailsMap;
+    std::atomic<std::chrono::minutes> m_attachmentExpirationMinutes;
+    /// The size up to which the buffer of an attachment may grow.
+    const size_t m_maxAttachmentSizeInBytes;
+    /// The pool of buffers for in-process attachments.
+    std::shared_ptr<AttachmentBufferPool> m_bufferPool;
+    /// The shards holding the attachments.
+    std::array<Shard, NUMBER_OF_SHARDS> m_shards;
+    /// The earliest time @c removeExpiredAttachments() will next sweep the shards.
+    std::atomic<std::chrono::steady_clock::time_point> m_nextSweepTime;
 };
 
 }  // namespace attachment
@@ -17,7 +17,9 @@
 #define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENT_H_
 
 #include "AVSCommon/AVS/Attachment/Attachment.h"
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentReader.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachmentSegmentChain.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentWriter.h"
 
 #include "AVSCommon/Utils/SDS/InProcessSDS.h"
@@ -29,6 +31,9 @@ namespace attachment {
 
 /**
  * A class that represents an AVS attachment following an in-process memory management model.
+ *
+ * Unless it is given an SDS to use, an attachment starts with a small buffer, and grows it on demand (up to a maximum
+ * size) when the writer gets ahead of the reader.  See @c InProcessAttachmentSegmentChain.
  */
 class InProcessAttachment : public Attachment {
 public:
@@ -39,14 +44,35 @@ public:
     /// Default size of underlying SDS when created internally.
     static const int SDS_BUFFER_DEFAULT_SIZE_IN_BYTES = 0x100000;
 
+    /// Default initial size of the buffer of an attachment which grows on demand.
+    static const size_t SDS_BUFFER_INITIAL_SIZE_IN_BYTES = 0x4000;
+
+    /// Default maximum size of the buffer of an attachment which grows on demand.
+    static const size_t SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES = 0x400000;
+
     /**
      * Constructor.
      *
      * @param id The attachment id.
-     * @param sds The underlying @c SharedDataStream object.  If not specified, then this class will create its own.
+     * @param sds The underlying @c SharedDataStream object.  If not specified, then this class will create its own,
+     *     which grows on demand.
      */
     InProcessAttachment(const std::string& id, std::unique_ptr<SDSType> sds = nullptr);
 
+    /**
+     * Constructor for an attachment whose buffer grows on demand.
+     *
+     * @param id The attachment id.
+     * @param bufferPool The pool to take the buffers from.
+     * @param maxSizeInBytes The maximum size of the attachment's buffer.
+     * @param initialSizeInBytes The initial size of the attachment's buffer.
+     */
+    InProcessAttachment(
+        const std::string& id,
+        std::shared_ptr<AttachmentBufferPool> bufferPool,
+        size_t maxSizeInBytes = SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES,
+        size_t initialSizeInBytes = SDS_BUFFER_INITIAL_SIZE_IN_BYTES);
+
     std::unique_ptr<AttachmentWriter> createWriter(
         InProcessAttachmentWriter::SDSTypeWriter::Policy policy =
             InProcessAttachmentWriter::SDSTypeWriter::Policy::ALL_OR_NOTHING) override;
@@ -54,8 +80,11 @@ public:
     std::unique_ptr<AttachmentReader> createReader(InProcessAttachmentReader::SDSTypeReader::Policy policy) override;
 
 private:
-    // The sds from which we will create the reader and writer.
+    // The sds from which we will create the reader and writer, if this attachment does not grow.
     std::shared_ptr<SDSType> m_sds;
+
+    // The chain of segments from which we will create the reader and writer, if this attachment grows.
+    std::shared_ptr<InProcessAttachmentSegmentChain> m_segmentChain;
 };
 
 }  // namespace attachment
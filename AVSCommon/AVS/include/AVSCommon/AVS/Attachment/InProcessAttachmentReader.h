@@ -20,6 +20,7 @@
 #include "AVSCommon/Utils/SDS/Reader.h"
 
 #include "AttachmentReader.h"
+#include "InProcessAttachmentSegmentChain.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -56,6 +57,18 @@ public:
         SDSTypeIndex offset = 0,
         SDSTypeReader::Reference reference = SDSTypeReader::Reference::ABSOLUTE);
 
+    /**
+     * Create an InProcessAttachmentReader which reads from a chain of segments.  The reader reads each segment in
+     * place, and releases it once it has read all of it and the writer has moved on to the next one.
+     *
+     * @param policy The policy this reader should adhere to.
+     * @param segmentChain The @c InProcessAttachmentSegmentChain which this object will read from.
+     * @return Returns a new InProcessAttachmentReader, or nullptr if the operation failed.
+     */
+    static std::unique_ptr<InProcessAttachmentReader> createFromSegmentChain(
+        SDSTypeReader::Policy policy,
+        std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain);
+
     /**
      * Destructor.
      */
@@ -82,8 +95,37 @@ private:
      */
     InProcessAttachmentReader(SDSTypeReader::Policy policy, std::shared_ptr<SDSType> sds);
 
+    /**
+     * Constructor.
+     *
+     * @param policy The @c ReaderPolicy of this object.
+     * @param segmentChain The @c InProcessAttachmentSegmentChain which this object will read from.
+     */
+    InProcessAttachmentReader(
+        SDSTypeReader::Policy policy,
+        std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain);
+
+    /**
+     * Move @c m_reader to the next segment of @c m_segmentChain, if the writer has moved on to it.
+     *
+     * @return Whether the reader moved to the next segment.
+     */
+    bool nextSegment();
+
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeReader> m_reader;
+
+    /// The @c ReaderPolicy of this object.
+    SDSTypeReader::Policy m_policy;
+
+    /// The chain of segments being read from, or @c nullptr if this reader reads from a single stream.
+    std::shared_ptr<InProcessAttachmentSegmentChain> m_segmentChain;
+
+    /// The offset in the attachment of the first byte of the segment @c m_reader reads from.
+    uint64_t m_segmentOffset;
+
+    /// Whether @c close() has been called, in which case the reader does not move on to further segments.
+    bool m_closed;
 };
 
 }  // namespace attachment
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENTSEGMENTCHAIN_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENTSEGMENTCHAIN_H_
+
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * The storage of an in-process attachment which grows on demand.
+ *
+ * The attachment data is held in a chain of @c SharedDataStream segments.  The chain starts with a single small
+ * segment.  When the writer would block on a full segment, it appends a new, larger, segment and continues writing
+ * there, as long as the total size of the segments stays within a ceiling.  The reader reads each segment in place,
+ * and moves on to the next segment once it has read all of the current one, at which point that segment is released.
+ *
+ * The writer always writes to the last segment, and the reader always reads from the first one.
+ *
+ * This class is thread safe.
+ */
+class InProcessAttachmentSegmentChain {
+public:
+    /// Type aliases for convenience.
+    using SDSType = avsCommon::utils::sds::InProcessSDS;
+
+    /**
+     * A segment of the chain.
+     */
+    struct Segment {
+        /// The stream holding the data of the segment.
+        std::shared_ptr<SDSType> sds;
+        /// The offset of the first byte of the segment in the attachment.
+        uint64_t offset;
+    };
+
+    /**
+     * Create an @c InProcessAttachmentSegmentChain.
+     *
+     * @param bufferPool The pool to take the segment buffers from.
+     * @param initialSizeInBytes The data size of the first segment.
+     * @param maxSizeInBytes The maximum total data size of the segments in the chain.
+     * @return The new chain, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<InProcessAttachmentSegmentChain> create(
+        std::shared_ptr<AttachmentBufferPool> bufferPool,
+        size_t initialSizeInBytes,
+        size_t maxSizeInBytes);
+
+    /**
+     * Get the first segment of the chain, which is the one to read from.
+     *
+     * @return The first segment.
+     */
+    Segment getFirstSegment();
+
+    /**
+     * Get the last segment of the chain, which is the one to write to.
+     *
+     * @return The last segment.
+     */
+    Segment getLastSegment();
+
+    /**
+     * Append a segment to the chain.  The new segment is twice the size of the last segment, or large enough to hold
+     * @c minimumSizeInBytes if that is larger.
+     *
+     * @param offset The offset in the attachment of the first byte of the new segment, which is where the writer
+     *     stopped writing to the last segment.
+     * @param minimumSizeInBytes The minimum data size of the new segment.
+     * @param maxSizeInBytes A total data size of the segments, lower than the chain's maximum size, which the new
+     *     segment must not take the chain over.
+     * @return The new segment's stream, or @c nullptr if it would take the chain over its maximum size.
+     */
+    std::shared_ptr<SDSType> addSegment(
+        uint64_t offset,
+        size_t minimumSizeInBytes,
+        size_t maxSizeInBytes = std::numeric_limits<size_t>::max());
+
+    /**
+     * Get the segment after the first segment of the chain.
+     *
+     * @param[out] next The second segment.
+     * @return Whether the chain has a second segment.
+     */
+    bool getNextSegment(Segment* next);
+
+    /**
+     * Release the first segment of the chain, if it has a successor.
+     *
+     * @param[out] next The new first segment.
+     * @return Whether the first segment was released.
+     */
+    bool releaseFirstSegment(Segment* next);
+
+    /**
+     * Record that bytes have been written to the attachment.
+     *
+     * @param numBytes The number of bytes written.
+     */
+    void addBytesWritten(uint64_t numBytes);
+
+    /**
+     * Get the number of bytes written to the attachment so far.
+     *
+     * @return The number of bytes written.
+     */
+    uint64_t getBytesWritten() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param bufferPool The pool to take the segment buffers from.
+     * @param maxSizeInBytes The maximum total data size of the segments in the chain.
+     */
+    InProcessAttachmentSegmentChain(std::shared_ptr<AttachmentBufferPool> bufferPool, size_t maxSizeInBytes);
+
+    /// The pool to take the segment buffers from.
+    std::shared_ptr<AttachmentBufferPool> m_bufferPool;
+
+    /// The maximum total data size of the segments in the chain.
+    const size_t m_maxSizeInBytes;
+
+    /// The number of bytes written to the attachment so far.
+    std::atomic<uint64_t> m_bytesWritten;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The segments of the chain, in attachment order.
+    std::deque<Segment> m_segments;
+
+    /// The total data size of the segments in the chain.
+    size_t m_sizeInBytes;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENTSEGMENTCHAIN_H_
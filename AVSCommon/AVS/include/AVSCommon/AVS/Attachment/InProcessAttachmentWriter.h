@@ -16,10 +16,13 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENTWRITER_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENTWRITER_H_
 
+#include <limits>
+
 #include "AVSCommon/Utils/SDS/InProcessSDS.h"
 #include "AVSCommon/Utils/SDS/Writer.h"
 
 #include "AttachmentWriter.h"
+#include "InProcessAttachmentSegmentChain.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -48,6 +51,19 @@ public:
         std::shared_ptr<SDSType> sds,
         SDSTypeWriter::Policy policy = SDSTypeWriter::Policy::ALL_OR_NOTHING);
 
+    /**
+     * Create an InProcessAttachmentWriter which writes to a chain of segments.  When a write would block on a full
+     * segment, the writer appends a new segment to the chain and writes there instead, unless the chain has reached
+     * its maximum size.
+     *
+     * @param segmentChain The @c InProcessAttachmentSegmentChain which this object will write to.
+     * @param policy The policy of the new Writer.
+     * @return Returns a new InProcessAttachmentWriter, or nullptr if the operation failed.
+     */
+    static std::unique_ptr<InProcessAttachmentWriter> createFromSegmentChain(
+        std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain,
+        SDSTypeWriter::Policy policy = SDSTypeWriter::Policy::ALL_OR_NOTHING);
+
     /**
      * Destructor.
      */
@@ -72,8 +88,37 @@ protected:
         std::shared_ptr<SDSType> sds,
         SDSTypeWriter::Policy policy = SDSTypeWriter::Policy::ALL_OR_NOTHING);
 
+    /**
+     * Constructor.
+     *
+     * @param segmentChain The @c InProcessAttachmentSegmentChain which this object will write to.
+     * @param policy The policy of the new Writer.
+     */
+    InProcessAttachmentWriter(
+        std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain,
+        SDSTypeWriter::Policy policy);
+
+    /**
+     * Append a segment to @c m_segmentChain and move @c m_writer to it.
+     *
+     * @param minimumSizeInBytes The minimum data size of the new segment.
+     * @param maxSizeInBytes A total data size of the segments, lower than the chain's maximum size, which the new
+     *     segment must not take the chain over.
+     * @return Whether the writer moved to a new segment.
+     */
+    bool addSegment(size_t minimumSizeInBytes, size_t maxSizeInBytes = std::numeric_limits<size_t>::max());
+
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeWriter> m_writer;
+
+    /// The policy of the writer.
+    SDSTypeWriter::Policy m_policy;
+
+    /// The chain of segments being written to, or @c nullptr if this writer writes to a single stream.
+    std::shared_ptr<InProcessAttachmentSegmentChain> m_segmentChain;
+
+    /// The offset in the attachment of the first byte of the segment @c m_writer writes to.
+    uint64_t m_segmentOffset;
 };
 
 }  // namespace attachment
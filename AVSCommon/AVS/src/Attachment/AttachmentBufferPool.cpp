@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Memory/Memory.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+using namespace alexaClientSDK::avsCommon::utils::memory;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AttachmentBufferPool");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+// The definition for these static class members.
+constexpr size_t AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES;
+constexpr size_t AttachmentBufferPool::DEFAULT_MAX_IDLE_BUFFERS_PER_SIZE_CLASS;
+constexpr size_t AttachmentBufferPool::DEFAULT_MAX_IDLE_BYTES;
+
+std::shared_ptr<AttachmentBufferPool> AttachmentBufferPool::create(
+    size_t maxIdleBuffersPerSizeClass,
+    size_t maxIdleBytes) {
+    return std::shared_ptr<AttachmentBufferPool>(new AttachmentBufferPool(maxIdleBuffersPerSizeClass, maxIdleBytes));
+}
+
+AttachmentBufferPool::AttachmentBufferPool(size_t maxIdleBuffersPerSizeClass, size_t maxIdleBytes) :
+        m_maxIdleBuffersPerSizeClass{maxIdleBuffersPerSizeClass},
+        m_maxIdleBytes{maxIdleBytes},
+        m_allocatedBytes{0},
+        m_idleBytes{0} {
+}
+
+std::unique_ptr<AttachmentBufferPool::SDSType> AttachmentBufferPool::createSDS(
+    size_t dataSizeInBytes,
+    size_t maxReaders) {
+    auto dataSize = getSizeClass(dataSizeInBytes);
+    auto bufferSize = SDSType::calculateBufferSize(dataSize, 1, maxReaders);
+    if (0 == bufferSize) {
+        ACSDK_ERROR(LX("createSDSFailed").d("reason", "invalidSize").d("dataSizeInBytes", dataSizeInBytes));
+        return nullptr;
+    }
+
+    std::weak_ptr<AttachmentBufferPool> weakPool = shared_from_this();
+    std::shared_ptr<SDSBufferType> buffer(
+        acquireBuffer(bufferSize).release(), [weakPool, dataSize](SDSBufferType* buffer) {
+            std::unique_ptr<SDSBufferType> ownedBuffer(buffer);
+            if (auto pool = weakPool.lock()) {
+                pool->releaseBuffer(std::move(ownedBuffer), dataSize);
+            }
+        });
+
+    auto sds = SDSType::create(buffer, 1, maxReaders);
+    if (!sds) {
+        ACSDK_ERROR(LX("createSDSFailed").d("reason", "createFailed").d("bufferSize", bufferSize));
+    }
+    return sds;
+}
+
+size_t AttachmentBufferPool::getAllocatedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_allocatedBytes;
+}
+
+size_t AttachmentBufferPool::getIdleBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idleBytes;
+}
+
+std::unique_ptr<AttachmentBufferPool::SDSBufferType> AttachmentBufferPool::acquireBuffer(size_t bufferSize) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_idleBuffers.find(bufferSize);
+        if (it != m_idleBuffers.end() && !it->second.empty()) {
+            auto buffer = std::move(it->second.back().buffer);
+            m_idleBytes -= it->second.back().dataSize;
+            it->second.pop_back();
+            return buffer;
+        }
+        m_allocatedBytes += bufferSize;
+    }
+
+    // Allocate outside of the lock, since zero-filling a large buffer is comparatively slow.
+    return make_unique<SDSBufferType>(bufferSize);
+}
+
+void AttachmentBufferPool::releaseBuffer(std::unique_ptr<SDSBufferType> buffer, size_t dataSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& idleBuffers = m_idleBuffers[buffer->size()];
+    if (idleBuffers.size() >= m_maxIdleBuffersPerSizeClass || m_idleBytes + dataSize > m_maxIdleBytes) {
+        return;
+    }
+    m_idleBytes += dataSize;
+    idleBuffers.push_back({std::move(buffer), dataSize, std::chrono::steady_clock::now()});
+}
+
+void AttachmentBufferPool::releaseIdleBuffers(std::chrono::steady_clock::duration maxIdleTime) {
+    // The buffers are destroyed after the lock is released, since freeing a large buffer is comparatively slow.
+    std::vector<IdleBuffer> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto oldestKept = std::chrono::steady_clock::now() - maxIdleTime;
+        for (auto& sizeClass : m_idleBuffers) {
+            auto& idleBuffers = sizeClass.second;
+            auto firstKept = std::find_if(idleBuffers.begin(), idleBuffers.end(), [oldestKept](const IdleBuffer& idle) {
+                return idle.releaseTime > oldestKept;
+            });
+            for (auto it = idleBuffers.begin(); it != firstKept; ++it) {
+                m_idleBytes -= it->dataSize;
+                expired.push_back(std::move(*it));
+            }
+            idleBuffers.erase(idleBuffers.begin(), firstKept);
+        }
+    }
+}
+
+size_t AttachmentBufferPool::getSizeClass(size_t dataSizeInBytes) {
+    size_t sizeClass = MINIMUM_SIZE_CLASS_IN_BYTES;
+    while (sizeClass < dataSizeInBytes) {
+        if (sizeClass > std::numeric_limits<size_t>::max() / 2) {
+            return dataSizeInBytes;
+        }
+        sizeClass <<= 1;
+    }
+    return sizeClass;
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
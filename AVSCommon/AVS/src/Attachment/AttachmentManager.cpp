@@ -13,8 +13,6 @@
  * permissions and limitations under the License.
  */
 
-#include <vector>
-
 #include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 #include "AVSCommon/Utils/Memory/Memory.h"
@@ -39,9 +37,16 @@ static const std::string TAG("AttachmentManager");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-// The definition for these two static class members.
+// The definition for these static class members.
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT;
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_MINIMUM;
+constexpr size_t AttachmentManager::NUMBER_OF_SHARDS;
+
+/// The time for which a buffer may stay idle in the pool before it is freed.
+static const std::chrono::minutes BUFFER_POOL_IDLE_TIMEOUT = std::chrono::minutes(1);
+
+/// The shortest time between two sweeps for expired attachments, which is short next to the minimum timeout.
+static const std::chrono::seconds EXPIRED_ATTACHMENTS_SWEEP_INTERVAL = std::chrono::seconds(10);
 
 // Used within generateAttachmentId().
 static const std::string ATTACHMENT_ID_COMBINING_SUBSTRING = ":";
@@ -50,9 +55,12 @@ AttachmentManager::AttachmentManagementDetails::AttachmentManagementDetails() :
         creationTime{std::chrono::steady_clock::now()} {
 }
 
-AttachmentManager::AttachmentManager(AttachmentType attachmentType) :
+AttachmentManager::AttachmentManager(AttachmentType attachmentType, size_t maxAttachmentSizeInBytes) :
         m_attachmentType{attachmentType},
-        m_attachmentExpirationMinutes{ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT} {
+        m_attachmentExpirationMinutes(ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT),
+        m_maxAttachmentSizeInBytes{maxAttachmentSizeInBytes},
+        m_bufferPool{AttachmentBufferPool::create()},
+        m_nextSweepTime{std::chrono::steady_clock::time_point()} {
 }
 
 std::string AttachmentManager::generateAttachmentId(const std::string& contextId, const std::string& contentId) const {
@@ -84,14 +92,23 @@ bool AttachmentManager::setAttachmentTimeoutMinutes(std::chrono::minutes minutes
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_attachmentExpirationMinutes = minutes;
     return true;
 }
 
-AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLocked(const std::string& attachmentId) {
+AttachmentManager::Shard& AttachmentManager::getShard(const std::string& attachmentId) {
+    return m_shards[std::hash<std::string>{}(attachmentId) % NUMBER_OF_SHARDS];
+}
+
+AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLocked(
+    Shard& shard,
+    const std::string& attachmentId) {
     // This call ensures the details object exists, whether updated previously, or as a new object.
-    auto& details = m_attachmentDetailsMap[attachmentId];
+    auto previousSize = shard.attachmentDetailsMap.size();
+    auto& details = shard.attachmentDetailsMap[attachmentId];
+    if (shard.attachmentDetailsMap.size() != previousSize) {
+        details.expiryQueuePosition = shard.expiryQueue.insert(shard.expiryQueue.end(), attachmentId);
+    }
 
     // If it's a new object, the inner attachment has not yet been created.  Let's go do that.
     if (!details.attachment) {
@@ -99,7 +116,8 @@ AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLoc
         switch (m_attachmentType) {
             // The in-process attachment type.
             case AttachmentType::IN_PROCESS:
-                details.attachment = make_unique<InProcessAttachment>(attachmentId);
+                details.attachment =
+                    make_unique<InProcessAttachment>(attachmentId, m_bufferPool, m_maxAttachmentSizeInBytes);
                 break;
         }
 
@@ -117,59 +135,85 @@ AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLoc
 std::unique_ptr<AttachmentWriter> AttachmentManager::createWriter(
     const std::string& attachmentId,
     utils::sds::WriterPolicy policy) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<AttachmentWriter> writer;
+    {
+        auto& shard = getShard(attachmentId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-    auto& details = getDetailsLocked(attachmentId);
-    if (!details.attachment) {
-        ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
-        return nullptr;
-    }
+        auto& details = getDetailsLocked(shard, attachmentId);
+        if (!details.attachment) {
+            ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
+            return nullptr;
+        }
 
-    auto writer = details.attachment->createWriter(policy);
-    removeExpiredAttachmentsLocked();
+        writer = details.attachment->createWriter(policy);
+        removeCompletedAttachmentLocked(shard, attachmentId);
+    }
+    removeExpiredAttachments();
     return writer;
 }
 
 std::unique_ptr<AttachmentReader> AttachmentManager::createReader(
     const std::string& attachmentId,
     sds::ReaderPolicy policy) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<AttachmentReader> reader;
+    {
+        auto& shard = getShard(attachmentId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-    auto& details = getDetailsLocked(attachmentId);
-    if (!details.attachment) {
-        ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
-        return nullptr;
-    }
+        auto& details = getDetailsLocked(shard, attachmentId);
+        if (!details.attachment) {
+            ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
+            return nullptr;
+        }
 
-    auto reader = details.attachment->createReader(policy);
-    removeExpiredAttachmentsLocked();
+        reader = details.attachment->createReader(policy);
+        removeCompletedAttachmentLocked(shard, attachmentId);
+    }
+    removeExpiredAttachments();
     return reader;
 }
 
-void AttachmentManager::removeExpiredAttachmentsLocked() {
-    std::vector<std::string> idsToErase;
-    auto now = std::chrono::steady_clock::now();
-
-    for (auto& iter : m_attachmentDetailsMap) {
-        auto& details = iter.second;
-
-        /*
-         * Our criteria for releasing an AttachmentManagementDetails object - either:
-         *  - Both futures have been returned, which means the attachment now has a reader and writer.  Great!
-         *  - Only the reader or writer future was returned, and the attachment has exceeded its lifetime limit.
-         */
-
-        auto attachmentLifetime = std::chrono::duration_cast<std::chrono::minutes>(now - details.creationTime);
+void AttachmentManager::removeCompletedAttachmentLocked(Shard& shard, const std::string& attachmentId) {
+    // Both a reader and a writer have been created, so the manager has no further use for the attachment.
+    auto it = shard.attachmentDetailsMap.find(attachmentId);
+    if (it != shard.attachmentDetailsMap.end() && it->second.attachment &&
+        it->second.attachment->hasCreatedReader() && it->second.attachment->hasCreatedWriter()) {
+        shard.expiryQueue.erase(it->second.expiryQueuePosition);
+        shard.attachmentDetailsMap.erase(it);
+    }
+}
 
-        if ((details.attachment->hasCreatedReader() && details.attachment->hasCreatedWriter()) ||
-            attachmentLifetime > m_attachmentExpirationMinutes) {
-            idsToErase.push_back(iter.first);
+void AttachmentManager::removeExpiredAttachments() {
+    /*
+     * An attachment for which only the reader or writer was created, and which has exceeded its lifetime limit, is
+     * released.  Every shard is swept, since an orphaned attachment's own shard may never be accessed again.  Each
+     * shard's expiry queue is ordered by creation time, so the sweep of a shard stops at its first live attachment.
+     * Locking every shard on every access would make the shards contend again, so the sweep is run by at most one
+     * caller every @c EXPIRED_ATTACHMENTS_SWEEP_INTERVAL, which delays a release by no more than that.
+     */
+    auto now = std::chrono::steady_clock::now();
+    auto nextSweepTime = m_nextSweepTime.load();
+    if (now < nextSweepTime ||
+        !m_nextSweepTime.compare_exchange_strong(nextSweepTime, now + EXPIRED_ATTACHMENTS_SWEEP_INTERVAL)) {
+        return;
+    }
+    std::chrono::minutes expirationMinutes = m_attachmentExpirationMinutes;
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (!shard.expiryQueue.empty()) {
+            auto oldest = shard.attachmentDetailsMap.find(shard.expiryQueue.front());
+            auto attachmentLifetime =
+                std::chrono::duration_cast<std::chrono::minutes>(now - oldest->second.creationTime);
+            if (attachmentLifetime <= expirationMinutes) {
+                break;
+            }
+            shard.expiryQueue.pop_front();
+            shard.attachmentDetailsMap.erase(oldest);
         }
     }
 
-    for (auto id : idsToErase) {
-        m_attachmentDetailsMap.erase(id);
-    }
+    m_bufferPool->releaseIdleBuffers(BUFFER_POOL_IDLE_TIMEOUT);
 }
 
 }  // namespace attachment
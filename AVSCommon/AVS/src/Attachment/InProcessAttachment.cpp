@@ -23,16 +23,30 @@ namespace attachment {
 
 using namespace alexaClientSDK::avsCommon::utils::memory;
 
+// The definition for these static class members.
+const int InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES;
+const size_t InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES;
+const size_t InProcessAttachment::SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES;
+
 InProcessAttachment::InProcessAttachment(const std::string& id, std::unique_ptr<SDSType> sds) :
         Attachment(id),
         m_sds{std::move(sds)} {
     if (!m_sds) {
-        auto buffSize = SDSType::calculateBufferSize(SDS_BUFFER_DEFAULT_SIZE_IN_BYTES);
-        auto buff = std::make_shared<SDSBufferType>(buffSize);
-        m_sds = SDSType::create(buff);
+        // Without a shared pool, a pool which keeps no idle buffers simply allocates the segments.
+        m_segmentChain = InProcessAttachmentSegmentChain::create(
+            AttachmentBufferPool::create(0), SDS_BUFFER_INITIAL_SIZE_IN_BYTES, SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES);
     }
 }
 
+InProcessAttachment::InProcessAttachment(
+    const std::string& id,
+    std::shared_ptr<AttachmentBufferPool> bufferPool,
+    size_t maxSizeInBytes,
+    size_t initialSizeInBytes) :
+        Attachment(id),
+        m_segmentChain{InProcessAttachmentSegmentChain::create(bufferPool, initialSizeInBytes, maxSizeInBytes)} {
+}
+
 std::unique_ptr<AttachmentWriter> InProcessAttachment::createWriter(
     InProcessAttachmentWriter::SDSTypeWriter::Policy policy) {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -41,7 +55,8 @@ std::unique_ptr<AttachmentWriter> InProcessAttachment::createWriter(
         return nullptr;
     }
 
-    auto writer = InProcessAttachmentWriter::create(m_sds, policy);
+    auto writer = m_segmentChain ? InProcessAttachmentWriter::createFromSegmentChain(m_segmentChain, policy)
+                                 : InProcessAttachmentWriter::create(m_sds, policy);
     if (writer) {
         m_hasCreatedWriter = true;
     }
@@ -57,7 +72,8 @@ std::unique_ptr<AttachmentReader> InProcessAttachment::createReader(
         return nullptr;
     }
 
-    auto reader = InProcessAttachmentReader::create(policy, m_sds);
+    auto reader = m_segmentChain ? InProcessAttachmentReader::createFromSegmentChain(policy, m_segmentChain)
+                                 : InProcessAttachmentReader::create(policy, m_sds);
     if (reader) {
         m_hasCreatedReader = true;
     }
@@ -53,7 +53,23 @@ std::unique_ptr<InProcessAttachmentReader> InProcessAttachmentReader::create(
     return reader;
 }
 
-InProcessAttachmentReader::InProcessAttachmentReader(SDSTypeReader::Policy policy, std::shared_ptr<SDSType> sds) {
+std::unique_ptr<InProcessAttachmentReader> InProcessAttachmentReader::createFromSegmentChain(
+    SDSTypeReader::Policy policy,
+    std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain) {
+    auto reader = std::unique_ptr<InProcessAttachmentReader>(new InProcessAttachmentReader(policy, segmentChain));
+
+    if (!reader->m_reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "object not fully created"));
+        return nullptr;
+    }
+
+    return reader;
+}
+
+InProcessAttachmentReader::InProcessAttachmentReader(SDSTypeReader::Policy policy, std::shared_ptr<SDSType> sds) :
+        m_policy{policy},
+        m_segmentOffset{0},
+        m_closed{false} {
     if (!sds) {
         ACSDK_ERROR(LX("ConstructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
@@ -67,6 +83,28 @@ InProcessAttachmentReader::InProcessAttachmentReader(SDSTypeReader::Policy polic
     }
 }
 
+InProcessAttachmentReader::InProcessAttachmentReader(
+    SDSTypeReader::Policy policy,
+    std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain) :
+        m_policy{policy},
+        m_segmentChain{segmentChain},
+        m_segmentOffset{0},
+        m_closed{false} {
+    if (!m_segmentChain) {
+        ACSDK_ERROR(LX("ConstructorFailed").d("reason", "segmentChain parameter is nullptr"));
+        return;
+    }
+
+    auto segment = m_segmentChain->getFirstSegment();
+    m_reader = segment.sds->createReader(policy);
+    m_segmentOffset = segment.offset;
+
+    if (!m_reader) {
+        ACSDK_ERROR(LX("ConstructorFailed").d("reason", "could not create an SDS reader"));
+        return;
+    }
+}
+
 InProcessAttachmentReader::~InProcessAttachmentReader() {
     close();
 }
@@ -111,6 +149,30 @@ std::size_t InProcessAttachmentReader::read(
 
     auto readResult = m_reader->read(buf, numWords, timeoutMs);
 
+    /*
+     * The end of a segment is only the end of the attachment if the writer has not moved on to another segment.  Once
+     * there is a next segment, the writer will not write to the current one again, so move on only when the current
+     * segment is drained.  A segment reports that it is closed (0) when the writer left it after writing to it.  When
+     * it has no data (WOULDBLOCK), the writer may have written to it and moved on since the read, so read it again
+     * before moving on; a segment the writer left without writing to it never reports that it is closed.
+     */
+    while (0 == readResult || SDSType::Reader::Error::WOULDBLOCK == readResult) {
+        if (SDSType::Reader::Error::WOULDBLOCK == readResult) {
+            InProcessAttachmentSegmentChain::Segment next;
+            if (!m_segmentChain || !m_segmentChain->getNextSegment(&next)) {
+                break;
+            }
+            readResult = m_reader->read(buf, numWords, timeoutMs);
+            if (0 != readResult && SDSType::Reader::Error::WOULDBLOCK != readResult) {
+                break;
+            }
+        }
+        if (!nextSegment()) {
+            break;
+        }
+        readResult = m_reader->read(buf, numWords, timeoutMs);
+    }
+
     /*
      * Convert SDS return code accordingly:
      *
@@ -156,6 +218,7 @@ std::size_t InProcessAttachmentReader::read(
 }
 
 void InProcessAttachmentReader::close(ClosePoint closePoint) {
+    m_closed = true;
     if (m_reader) {
         switch (closePoint) {
             case ClosePoint::IMMEDIATELY:
@@ -169,13 +232,34 @@ void InProcessAttachmentReader::close(ClosePoint closePoint) {
 }
 
 bool InProcessAttachmentReader::seek(uint64_t offset) {
-    if (m_reader) {
+    if (!m_reader) {
+        return false;
+    }
+    if (!m_segmentChain) {
         return m_reader->seek(offset);
     }
-    return false;
+
+    if (offset < m_segmentOffset) {
+        ACSDK_ERROR(LX("seekFailed").d("reason", "segment already released").d("offset", offset));
+        return false;
+    }
+
+    // Skip the segments which end before offset.  Those have been fully written, so the writer has moved on.
+    InProcessAttachmentSegmentChain::Segment next;
+    while (!m_closed && m_segmentChain->getNextSegment(&next) && offset >= next.offset) {
+        if (!nextSegment()) {
+            return false;
+        }
+    }
+    return m_reader->seek((offset - m_segmentOffset) / m_reader->getWordSize());
 }
 
 uint64_t InProcessAttachmentReader::getNumUnreadBytes() {
+    if (m_reader && m_segmentChain) {
+        auto readOffset = m_segmentOffset + m_reader->tell() * m_reader->getWordSize();
+        auto bytesWritten = m_segmentChain->getBytesWritten();
+        return bytesWritten > readOffset ? bytesWritten - readOffset : 0;
+    }
     if (m_reader) {
         return m_reader->tell(utils::sds::InProcessSDS::Reader::Reference::BEFORE_WRITER);
     }
@@ -184,6 +268,27 @@ uint64_t InProcessAttachmentReader::getNumUnreadBytes() {
     return 0;
 }
 
+bool InProcessAttachmentReader::nextSegment() {
+    if (!m_segmentChain || m_closed) {
+        return false;
+    }
+
+    InProcessAttachmentSegmentChain::Segment next;
+    if (!m_segmentChain->releaseFirstSegment(&next)) {
+        return false;
+    }
+
+    auto reader = next.sds->createReader(m_policy);
+    if (!reader) {
+        ACSDK_ERROR(LX("nextSegmentFailed").d("reason", "could not create an SDS reader"));
+        return false;
+    }
+
+    m_reader = std::move(reader);
+    m_segmentOffset = next.offset;
+    return true;
+}
+
 }  // namespace attachment
 }  // namespace avs
 }  // namespace avsCommon
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AVSCommon/AVS/Attachment/InProcessAttachmentSegmentChain.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("InProcessAttachmentSegmentChain");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<InProcessAttachmentSegmentChain> InProcessAttachmentSegmentChain::create(
+    std::shared_ptr<AttachmentBufferPool> bufferPool,
+    size_t initialSizeInBytes,
+    size_t maxSizeInBytes) {
+    if (!bufferPool) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullBufferPool"));
+        return nullptr;
+    }
+    if (0 == initialSizeInBytes || initialSizeInBytes > maxSizeInBytes) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidSize")
+                        .d("initialSizeInBytes", initialSizeInBytes)
+                        .d("maxSizeInBytes", maxSizeInBytes));
+        return nullptr;
+    }
+
+    std::shared_ptr<SDSType> sds = bufferPool->createSDS(initialSizeInBytes);
+    if (!sds) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createSDSFailed"));
+        return nullptr;
+    }
+
+    auto chain = std::shared_ptr<InProcessAttachmentSegmentChain>(
+        new InProcessAttachmentSegmentChain(std::move(bufferPool), maxSizeInBytes));
+    chain->m_sizeInBytes = sds->getDataSize();
+    chain->m_segments.push_back({sds, 0});
+    return chain;
+}
+
+InProcessAttachmentSegmentChain::InProcessAttachmentSegmentChain(
+    std::shared_ptr<AttachmentBufferPool> bufferPool,
+    size_t maxSizeInBytes) :
+        m_bufferPool{std::move(bufferPool)},
+        m_maxSizeInBytes{maxSizeInBytes},
+        m_bytesWritten{0},
+        m_sizeInBytes{0} {
+}
+
+InProcessAttachmentSegmentChain::Segment InProcessAttachmentSegmentChain::getFirstSegment() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_segments.front();
+}
+
+InProcessAttachmentSegmentChain::Segment InProcessAttachmentSegmentChain::getLastSegment() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_segments.back();
+}
+
+std::shared_ptr<InProcessAttachmentSegmentChain::SDSType> InProcessAttachmentSegmentChain::addSegment(
+    uint64_t offset,
+    size_t minimumSizeInBytes,
+    size_t maxSizeInBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    maxSizeInBytes = std::min(maxSizeInBytes, m_maxSizeInBytes);
+
+    // Double the size of the last segment, then back off towards minimumSizeInBytes if that does not fit.
+    size_t sizeInBytes = m_segments.back().sds->getDataSize() * 2;
+    while (sizeInBytes < minimumSizeInBytes) {
+        sizeInBytes *= 2;
+    }
+    while (m_sizeInBytes + sizeInBytes > maxSizeInBytes && sizeInBytes / 2 >= minimumSizeInBytes) {
+        sizeInBytes /= 2;
+    }
+    sizeInBytes = std::max(sizeInBytes, AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES);
+    if (m_sizeInBytes + sizeInBytes > maxSizeInBytes) {
+        ACSDK_DEBUG9(LX("addSegmentFailed")
+                         .d("reason", "maxSizeReached")
+                         .d("sizeInBytes", m_sizeInBytes)
+                         .d("maxSizeInBytes", maxSizeInBytes));
+        return nullptr;
+    }
+
+    std::shared_ptr<SDSType> sds = m_bufferPool->createSDS(sizeInBytes);
+    if (!sds) {
+        ACSDK_ERROR(LX("addSegmentFailed").d("reason", "createSDSFailed"));
+        return nullptr;
+    }
+
+    m_sizeInBytes += sds->getDataSize();
+    m_segments.push_back({sds, offset});
+    ACSDK_DEBUG9(LX("addSegment").d("offset", offset).d("segmentSize", sds->getDataSize()).d("size", m_sizeInBytes));
+    return sds;
+}
+
+bool InProcessAttachmentSegmentChain::getNextSegment(Segment* next) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_segments.size() < 2) {
+        return false;
+    }
+    *next = m_segments[1];
+    return true;
+}
+
+bool InProcessAttachmentSegmentChain::releaseFirstSegment(Segment* next) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_segments.size() < 2) {
+        return false;
+    }
+    m_sizeInBytes -= m_segments.front().sds->getDataSize();
+    m_segments.pop_front();
+    *next = m_segments.front();
+    return true;
+}
+
+void InProcessAttachmentSegmentChain::addBytesWritten(uint64_t numBytes) {
+    m_bytesWritten += numBytes;
+}
+
+uint64_t InProcessAttachmentSegmentChain::getBytesWritten() const {
+    return m_bytesWritten;
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
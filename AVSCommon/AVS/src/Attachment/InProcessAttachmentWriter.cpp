@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentWriter.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 
@@ -33,6 +34,25 @@ static const std::string TAG("InProcessAttachmentWriter");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/**
+ * How long a blocking writer to a chain of segments waits for space in the current segment before moving to a new one.
+ */
+static const std::chrono::milliseconds BLOCKING_SEGMENT_FULL_TIMEOUT(1);
+
+/**
+ * The total data size up to which a blocking writer grows a chain of segments.  Blocking writers download media on
+ * threads of their own, where waiting for the reader is the intended back-pressure, so they only grow the chain up to
+ * the size of the fixed buffer attachments used to have.  Beyond that, they wait for the reader as they used to.
+ */
+static const size_t BLOCKING_MAX_SIZE_IN_BYTES = InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES;
+
+/**
+ * The size of the segment a non-blockable writer to a chain of segments writes to.  Such a writer never waits for the
+ * reader, so it cannot tell when to grow the chain.  Instead, it moves to a segment of this size as soon as it is
+ * created.
+ */
+static const size_t NONBLOCKABLE_SEGMENT_SIZE_IN_BYTES = 0x100000;
+
 std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(
     std::shared_ptr<SDSType> sds,
     SDSTypeWriter::Policy policy) {
@@ -46,7 +66,22 @@ std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(
     return writer;
 }
 
-InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sds, SDSTypeWriter::Policy policy) {
+std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::createFromSegmentChain(
+    std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain,
+    SDSTypeWriter::Policy policy) {
+    auto writer = std::unique_ptr<InProcessAttachmentWriter>(new InProcessAttachmentWriter(segmentChain, policy));
+
+    if (!writer->m_writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "could not create instance"));
+        return nullptr;
+    }
+
+    return writer;
+}
+
+InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sds, SDSTypeWriter::Policy policy) :
+        m_policy{policy},
+        m_segmentOffset{0} {
     if (!sds) {
         ACSDK_ERROR(LX("constructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
@@ -54,6 +89,25 @@ InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sd
     m_writer = sds->createWriter(policy);
 }
 
+InProcessAttachmentWriter::InProcessAttachmentWriter(
+    std::shared_ptr<InProcessAttachmentSegmentChain> segmentChain,
+    SDSTypeWriter::Policy policy) :
+        m_policy{policy},
+        m_segmentChain{segmentChain},
+        m_segmentOffset{0} {
+    if (!m_segmentChain) {
+        ACSDK_ERROR(LX("constructorFailed").d("reason", "segmentChain parameter is nullptr"));
+        return;
+    }
+    auto segment = m_segmentChain->getLastSegment();
+    m_writer = segment.sds->createWriter(policy);
+    m_segmentOffset = segment.offset;
+
+    if (m_writer && SDSTypeWriter::Policy::NONBLOCKABLE == policy) {
+        addSegment(NONBLOCKABLE_SEGMENT_SIZE_IN_BYTES);
+    }
+}
+
 InProcessAttachmentWriter::~InProcessAttachmentWriter() {
     close();
 }
@@ -90,7 +144,21 @@ std::size_t InProcessAttachmentWriter::write(
 
     std::size_t bytesWritten = 0;
     auto numWords = numBytes / wordSize;
-    auto writeResult = m_writer->write(buff, numWords, timeout);
+    ssize_t writeResult = 0;
+
+    // If the current segment is full, try to continue in a new one rather than making the caller wait for the reader.
+    if (m_segmentChain && SDSTypeWriter::Policy::BLOCKING == m_policy) {
+        writeResult = m_writer->write(buff, numWords, BLOCKING_SEGMENT_FULL_TIMEOUT);
+        if (SDSType::Writer::Error::TIMEDOUT == writeResult) {
+            addSegment(numWords * wordSize, BLOCKING_MAX_SIZE_IN_BYTES);
+            writeResult = m_writer->write(buff, numWords, timeout);
+        }
+    } else {
+        writeResult = m_writer->write(buff, numWords, timeout);
+        if (SDSType::Writer::Error::WOULDBLOCK == writeResult && addSegment(numWords * wordSize)) {
+            writeResult = m_writer->write(buff, numWords, timeout);
+        }
+    }
 
     /*
      * Convert SDS return code accordingly:
@@ -132,6 +200,9 @@ std::size_t InProcessAttachmentWriter::write(
         close();
     } else {
         bytesWritten = static_cast<size_t>(writeResult) * wordSize;
+        if (m_segmentChain) {
+            m_segmentChain->addBytesWritten(bytesWritten);
+        }
     }
 
     return bytesWritten;
@@ -143,6 +214,30 @@ void InProcessAttachmentWriter::close() {
     }
 }
 
+bool InProcessAttachmentWriter::addSegment(size_t minimumSizeInBytes, size_t maxSizeInBytes) {
+    if (!m_segmentChain) {
+        return false;
+    }
+
+    auto offset = m_segmentOffset + m_writer->tell() * m_writer->getWordSize();
+    auto sds = m_segmentChain->addSegment(offset, minimumSizeInBytes, maxSizeInBytes);
+    if (!sds) {
+        return false;
+    }
+
+    auto writer = sds->createWriter(m_policy);
+    if (!writer) {
+        ACSDK_ERROR(LX("addSegmentFailed").d("reason", "could not create an SDS writer"));
+        return false;
+    }
+
+    // The new segment is already in the chain, so a reader which sees the old segment close will move on to it.
+    m_writer->close();
+    m_writer = std::move(writer);
+    m_segmentOffset = offset;
+    return true;
+}
+
 }  // namespace attachment
 }  // namespace avs
 }  // namespace avsCommon
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
+
+using namespace ::testing;
+using namespace alexaClientSDK::avsCommon::avs::attachment;
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// A data size which falls in the smallest size class.
+static const size_t SMALL_DATA_SIZE = AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES / 2;
+/// A data size which falls in a larger size class.
+static const size_t LARGE_DATA_SIZE = AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES * 3;
+
+/**
+ * Test that a stream holds at least the requested data size.
+ */
+TEST(AttachmentBufferPoolTest, testStreamHoldsRequestedSize) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(LARGE_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_GE(sds->getDataSize(), LARGE_DATA_SIZE);
+}
+
+/**
+ * Test that the buffer of a destroyed stream is reused by the next stream of the same size class.
+ */
+TEST(AttachmentBufferPoolTest, testBufferReuse) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    auto dataSize = sds->getDataSize();
+    auto allocatedBytes = pool->getAllocatedBytes();
+    EXPECT_GT(allocatedBytes, dataSize);
+    EXPECT_EQ(pool->getIdleBytes(), 0u);
+
+    sds.reset();
+    EXPECT_EQ(pool->getIdleBytes(), dataSize);
+
+    sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_EQ(pool->getAllocatedBytes(), allocatedBytes);
+    EXPECT_EQ(pool->getIdleBytes(), 0u);
+
+    // A different size class needs its own buffer.
+    auto largeSds = pool->createSDS(LARGE_DATA_SIZE);
+    ASSERT_NE(largeSds, nullptr);
+    EXPECT_GT(pool->getAllocatedBytes(), allocatedBytes);
+}
+
+/**
+ * Test that a reused buffer is reinitialized, so that a new stream does not see the data of an old one.
+ */
+TEST(AttachmentBufferPoolTest, testReusedBufferIsReinitialized) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(AttachmentBufferPool::SDSType::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer, nullptr);
+    uint8_t data[] = {1, 2, 3, 4};
+    ASSERT_EQ(writer->write(data, sizeof(data)), static_cast<ssize_t>(sizeof(data)));
+    writer.reset();
+    sds.reset();
+
+    sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    auto reader = sds->createReader(AttachmentBufferPool::SDSType::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->tell(), 0u);
+    EXPECT_EQ(reader->read(data, sizeof(data)), AttachmentBufferPool::SDSType::Reader::Error::WOULDBLOCK);
+}
+
+/**
+ * Test that the pool keeps no more idle buffers per size class than it was created with.
+ */
+TEST(AttachmentBufferPoolTest, testIdleBufferLimit) {
+    auto pool = AttachmentBufferPool::create(1);
+    auto sds1 = pool->createSDS(SMALL_DATA_SIZE);
+    auto sds2 = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds1, nullptr);
+    ASSERT_NE(sds2, nullptr);
+    auto dataSize = sds1->getDataSize();
+
+    sds1.reset();
+    sds2.reset();
+    EXPECT_EQ(pool->getIdleBytes(), dataSize);
+}
+
+/**
+ * Test that the pool keeps no more idle bytes over all size classes than it was created with.
+ */
+TEST(AttachmentBufferPoolTest, testIdleBytesLimit) {
+    auto pool = AttachmentBufferPool::create(
+        AttachmentBufferPool::DEFAULT_MAX_IDLE_BUFFERS_PER_SIZE_CLASS,
+        AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES * 4);
+    auto sds1 = pool->createSDS(LARGE_DATA_SIZE);
+    auto sds2 = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds1, nullptr);
+    ASSERT_NE(sds2, nullptr);
+    auto largeDataSize = sds1->getDataSize();
+    ASSERT_EQ(largeDataSize, AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES * 4);
+
+    sds1.reset();
+    sds2.reset();
+    EXPECT_EQ(pool->getIdleBytes(), largeDataSize);
+}
+
+/**
+ * Test that with the default limits, a buffer of a size class as large as the limit on idle bytes is kept and reused,
+ * since the headers of the streams are not counted against the limit.
+ */
+TEST(AttachmentBufferPoolTest, testBufferAsLargeAsIdleBytesLimitReused) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(AttachmentBufferPool::DEFAULT_MAX_IDLE_BYTES);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_EQ(sds->getDataSize(), static_cast<size_t>(AttachmentBufferPool::DEFAULT_MAX_IDLE_BYTES));
+    auto allocatedBytes = pool->getAllocatedBytes();
+
+    sds.reset();
+    EXPECT_EQ(pool->getIdleBytes(), static_cast<size_t>(AttachmentBufferPool::DEFAULT_MAX_IDLE_BYTES));
+    sds = pool->createSDS(AttachmentBufferPool::DEFAULT_MAX_IDLE_BYTES);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_EQ(pool->getAllocatedBytes(), allocatedBytes);
+    EXPECT_EQ(pool->getIdleBytes(), 0u);
+}
+
+/**
+ * Test that releaseIdleBuffers() frees only the buffers which have been idle for longer than the given time.
+ */
+TEST(AttachmentBufferPoolTest, testReleaseIdleBuffers) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    sds.reset();
+    auto idleBytes = pool->getIdleBytes();
+    ASSERT_GT(idleBytes, 0u);
+    auto allocatedBytes = pool->getAllocatedBytes();
+
+    pool->releaseIdleBuffers(std::chrono::hours(1));
+    EXPECT_EQ(pool->getIdleBytes(), idleBytes);
+
+    pool->releaseIdleBuffers(std::chrono::steady_clock::duration::zero());
+    EXPECT_EQ(pool->getIdleBytes(), 0u);
+
+    sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_EQ(pool->getAllocatedBytes(), 2 * allocatedBytes);
+}
+
+/**
+ * Test that a stream remains usable after its pool has been destroyed.
+ */
+TEST(AttachmentBufferPoolTest, testStreamOutlivesPool) {
+    auto pool = AttachmentBufferPool::create();
+    auto sds = pool->createSDS(SMALL_DATA_SIZE);
+    ASSERT_NE(sds, nullptr);
+    pool.reset();
+
+    auto writer = sds->createWriter(AttachmentBufferPool::SDSType::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer, nullptr);
+    uint8_t data[] = {1, 2, 3, 4};
+    EXPECT_EQ(writer->write(data, sizeof(data)), static_cast<ssize_t>(sizeof(data)));
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -13,6 +13,10 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -146,6 +150,173 @@ TEST_F(AttachmentTest, testAttachmentCreateMultipleWriters) {
     ASSERT_EQ(writer2, nullptr);
 }
 
+/**
+ * Verify that an Attachment grows its buffer when the writer gets ahead of the reader, and that the reader reads all of
+ * the data back in order.
+ */
+TEST_F(AttachmentTest, testAttachmentGrowsOnDemand) {
+    static const size_t dataSize = InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES * 5 + 100;
+    auto pool = AttachmentBufferPool::create();
+    auto attachment = std::make_shared<InProcessAttachment>(TEST_ATTACHMENT_ID_STRING_ONE, pool);
+    auto writer = attachment->createWriter();
+    ASSERT_NE(writer, nullptr);
+
+    auto testPattern = createTestPattern(dataSize);
+    size_t offset = 0;
+    while (offset < testPattern.size()) {
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        auto chunkSize = std::min<size_t>(TEST_SDS_PARTIAL_WRITE_AMOUNT_IN_BYTES, testPattern.size() - offset);
+        ASSERT_EQ(writer->write(testPattern.data() + offset, chunkSize, &writeStatus), chunkSize);
+        ASSERT_EQ(writeStatus, AttachmentWriter::WriteStatus::OK);
+        offset += chunkSize;
+    }
+    writer->close();
+    EXPECT_GT(pool->getAllocatedBytes(), InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES * 5);
+
+    auto reader = attachment->createReader(ReaderPolicy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->getNumUnreadBytes(), dataSize);
+
+    std::vector<uint8_t> result(dataSize);
+    offset = 0;
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    while (offset < result.size()) {
+        auto numRead = reader->read(result.data() + offset, result.size() - offset, &readStatus);
+        ASSERT_EQ(readStatus, AttachmentReader::ReadStatus::OK);
+        ASSERT_GT(numRead, 0u);
+        offset += numRead;
+    }
+    EXPECT_EQ(result, testPattern);
+    EXPECT_EQ(reader->getNumUnreadBytes(), 0u);
+
+    uint8_t byte;
+    EXPECT_EQ(reader->read(&byte, 1, &readStatus), 0u);
+    EXPECT_EQ(readStatus, AttachmentReader::ReadStatus::CLOSED);
+}
+
+/**
+ * Verify that an Attachment does not grow its buffer beyond its maximum size.
+ */
+TEST_F(AttachmentTest, testAttachmentGrowthIsBounded) {
+    static const size_t maxSize = InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES * 3;
+    auto attachment =
+        std::make_shared<InProcessAttachment>(TEST_ATTACHMENT_ID_STRING_ONE, AttachmentBufferPool::create(), maxSize);
+    auto writer = attachment->createWriter();
+    ASSERT_NE(writer, nullptr);
+
+    auto testPattern = createTestPattern(InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES);
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    size_t totalWritten = 0;
+    while (AttachmentWriter::WriteStatus::OK == writeStatus && totalWritten <= maxSize) {
+        totalWritten += writer->write(testPattern.data(), testPattern.size(), &writeStatus);
+    }
+    EXPECT_EQ(writeStatus, AttachmentWriter::WriteStatus::OK_BUFFER_FULL);
+    EXPECT_EQ(totalWritten, maxSize);
+}
+
+/**
+ * Verify that a reader can seek forward past the segments of a grown Attachment.
+ */
+TEST_F(AttachmentTest, testAttachmentSeekAcrossSegments) {
+    static const size_t dataSize = InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES * 4;
+    static const size_t seekOffset = InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES * 3 + 10;
+    auto writer = m_attachment->createWriter();
+    auto reader = m_attachment->createReader(ReaderPolicy::NONBLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+
+    auto testPattern = createTestPattern(dataSize);
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    ASSERT_EQ(writer->write(testPattern.data(), testPattern.size() / 2, &writeStatus), testPattern.size() / 2);
+    ASSERT_EQ(
+        writer->write(testPattern.data() + testPattern.size() / 2, testPattern.size() / 2, &writeStatus),
+        testPattern.size() / 2);
+
+    ASSERT_TRUE(reader->seek(seekOffset));
+    EXPECT_EQ(reader->getNumUnreadBytes(), dataSize - seekOffset);
+    uint8_t byte;
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(reader->read(&byte, 1, &readStatus), 1u);
+    EXPECT_EQ(byte, testPattern[seekOffset]);
+
+    // Data before the current segment has been released.
+    EXPECT_FALSE(reader->seek(0));
+}
+
+/**
+ * Verify that a nonblocking reader which keeps catching up with the writer reads all of the data in order while the
+ * writer moves from one segment to the next, rather than skipping what was written to a segment just before the writer
+ * left it.
+ */
+TEST_F(AttachmentTest, testNonblockingReaderFollowsWriterAcrossSegments) {
+    static const size_t initialSize = AttachmentBufferPool::MINIMUM_SIZE_CLASS_IN_BYTES;
+    static const size_t maxSize = initialSize * 3;
+    static const size_t dataSize = maxSize * 256;
+    static const size_t writeSize = 100;
+    static const size_t readSize = 64;
+    auto attachment = std::make_shared<InProcessAttachment>(
+        TEST_ATTACHMENT_ID_STRING_ONE, AttachmentBufferPool::create(), maxSize, initialSize);
+    auto writer = attachment->createWriter();
+    auto reader = attachment->createReader(ReaderPolicy::NONBLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+
+    auto testPattern = createTestPattern(dataSize);
+    std::thread writerThread([&writer, &testPattern] {
+        size_t offset = 0;
+        while (offset < testPattern.size()) {
+            auto writeStatus = AttachmentWriter::WriteStatus::OK;
+            auto chunkSize = std::min(writeSize, testPattern.size() - offset);
+            offset += writer->write(testPattern.data() + offset, chunkSize, &writeStatus);
+            if (AttachmentWriter::WriteStatus::OK_BUFFER_FULL == writeStatus) {
+                std::this_thread::yield();
+            } else if (AttachmentWriter::WriteStatus::OK != writeStatus) {
+                break;
+            }
+        }
+        writer->close();
+    });
+
+    std::vector<uint8_t> result;
+    uint8_t buffer[readSize];
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    while (AttachmentReader::ReadStatus::CLOSED != readStatus && result.size() <= testPattern.size()) {
+        auto numRead = reader->read(buffer, sizeof(buffer), &readStatus);
+        result.insert(result.end(), buffer, buffer + numRead);
+        if (AttachmentReader::ReadStatus::OK_WOULDBLOCK == readStatus) {
+            std::this_thread::yield();
+        } else if (AttachmentReader::ReadStatus::OK != readStatus) {
+            break;
+        }
+    }
+    writerThread.join();
+
+    EXPECT_EQ(readStatus, AttachmentReader::ReadStatus::CLOSED);
+    ASSERT_EQ(result.size(), testPattern.size());
+    EXPECT_EQ(result, testPattern);
+}
+
+/**
+ * Verify that a blocking writer only grows an Attachment up to the size of the fixed buffer attachments used to have,
+ * and waits for the reader beyond that.
+ */
+TEST_F(AttachmentTest, testBlockingWriterGrowthIsBounded) {
+    static const std::chrono::milliseconds writeTimeout(10);
+    auto writer = m_attachment->createWriter(WriterPolicy::BLOCKING);
+    ASSERT_NE(writer, nullptr);
+
+    auto testPattern = createTestPattern(InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES);
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    size_t totalWritten = 0;
+    while (AttachmentWriter::WriteStatus::OK == writeStatus &&
+           totalWritten <= InProcessAttachment::SDS_BUFFER_MAXIMUM_SIZE_IN_BYTES) {
+        totalWritten += writer->write(testPattern.data(), testPattern.size(), &writeStatus, writeTimeout);
+    }
+    EXPECT_EQ(writeStatus, AttachmentWriter::WriteStatus::TIMEDOUT);
+    EXPECT_GT(totalWritten, static_cast<size_t>(InProcessAttachment::SDS_BUFFER_INITIAL_SIZE_IN_BYTES));
+    EXPECT_LE(totalWritten, static_cast<size_t>(InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES));
+}
+
 }  // namespace test
 }  // namespace avs
 }  // namespace avsCommon
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMFILE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/**
+ * Reads a WAV file of interleaved 16-bit LPCM samples, at whatever rate and number of channels it was recorded.  The
+ * chunks of the file are walked, so any chunks before or between the "fmt " and "data" chunks are skipped.
+ *
+ * @param path The path of the file.
+ * @param[out] sampleRateHz The rate of the samples.
+ * @param[out] numChannels The number of channels.
+ * @param[out] samples The samples of every whole frame in the file, in the byte order of the platform.
+ * @return Whether the file could be read, was a WAV file of 16-bit LPCM, and held at least one frame.
+ */
+bool readWavFile(
+    const std::string& path,
+    unsigned int* sampleRateHz,
+    unsigned int* numChannels,
+    std::vector<int16_t>* samples);
+
+/**
+ * Reads a file of interleaved 16-bit little-endian samples, either raw or in a WAV file.
+ *
+ * @param path The path of the file.
+ * @param sampleRateHz The rate of the samples.  If the file is a WAV file, its rate must match.
+ * @param numChannels The number of channels.  If the file is a WAV file, its channels must match.
+ * @param[out] samples The samples of every whole frame in the file, in the byte order of the platform.
+ * @return Whether the file could be read, was in the format, and held at least one frame.
+ */
+bool readPcmFile(
+    const std::string& path,
+    unsigned int sampleRateHz,
+    unsigned int numChannels,
+    std::vector<int16_t>* samples);
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMFILE_H_
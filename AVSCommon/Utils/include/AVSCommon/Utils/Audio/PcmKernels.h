@@ -0,0 +1,226 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMKERNELS_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace kernels {
+
+/**
+ * The sample-level loops of the audio path.  Each kernel is vectorized with SSE2 on x86 and NEON on ARM, and falls
+ * back to the plain C++ loop in @c kernels::scalar on other targets.  The instruction set is chosen when the SDK is
+ * compiled.
+ *
+ * Unless a kernel says otherwise, its input and output must not overlap.
+ */
+
+/**
+ * Gets the name of the instruction set the kernels were compiled for.
+ *
+ * @return "SSE2", "NEON" or "scalar".
+ */
+const char* getInstructionSet();
+
+/**
+ * Adds a scaled signal to another: @c dst[i] += @c gain * @c src[i].
+ *
+ * @param dst The signal to add to.
+ * @param src The signal to add.
+ * @param gain The gain to apply to @c src.
+ * @param numSamples The number of samples.
+ */
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples);
+
+/**
+ * Multiplies a signal by a gain which changes linearly from @c startGain, for the first sample, toward @c endGain,
+ * which would apply to the sample after the last.
+ *
+ * @param data The signal.
+ * @param numSamples The number of samples.
+ * @param startGain The gain of the first sample.
+ * @param endGain The gain the ramp ends at.
+ */
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain);
+
+/**
+ * Computes the sum of the squares of a signal.
+ *
+ * @param data The signal.
+ * @param numSamples The number of samples.
+ * @return The sum of the squares.
+ */
+float sumOfSquares(const float* data, size_t numSamples);
+
+/**
+ * Computes the sum of the products of two signals.
+ *
+ * @param a The first signal.
+ * @param b The second signal.
+ * @param numSamples The number of samples.
+ * @return The sum of the products.
+ */
+float dotProduct(const float* a, const float* b, size_t numSamples);
+
+/**
+ * Converts a signal to 16-bit samples, rounding to the nearest value and saturating at the 16-bit range.
+ *
+ * @param src The signal.
+ * @param[out] dst The 16-bit samples.
+ * @param numSamples The number of samples.
+ */
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples);
+
+/**
+ * Converts 16-bit samples to a signal of the same scale.
+ *
+ * @param src The 16-bit samples.
+ * @param[out] dst The signal.
+ * @param numSamples The number of samples.
+ */
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples);
+
+/**
+ * Swaps the bytes of 16-bit samples, which converts them between little-endian and big-endian.
+ *
+ * @param src The samples.
+ * @param[out] dst The swapped samples, which may be @c src to swap in place.
+ * @param numSamples The number of samples.
+ */
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples);
+
+/**
+ * Checks whether the platform stores integers little-endian, so that little-endian samples can be used without
+ * @c byteswap16().
+ *
+ * @return Whether the platform is little-endian.
+ */
+bool isPlatformLittleEndian();
+
+/**
+ * Converts one channel of interleaved 16-bit frames to a signal.  One and two channels are vectorized.
+ *
+ * @param src The interleaved frames.
+ * @param numChannels The number of channels of a frame.
+ * @param channel The channel to take, less than @c numChannels.
+ * @param[out] dst The signal.
+ * @param numFrames The number of frames.
+ */
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames);
+
+/**
+ * Mixes interleaved 16-bit frames down to one channel, whose samples are the mean of the channels of each frame,
+ * rounded down.  One and two channels are vectorized.
+ *
+ * @param src The interleaved frames.
+ * @param numChannels The number of channels of a frame.
+ * @param[out] dst The mixed samples.
+ * @param numFrames The number of frames.
+ */
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames);
+
+/**
+ * Multiplies 16-bit samples by a gain, rounding as @c floatToInt16 does and saturating at the 16-bit range.
+ *
+ * @param data The samples.
+ * @param numSamples The number of samples.
+ * @param gain The gain.
+ */
+void applyGain(int16_t* data, size_t numSamples, float gain);
+
+/**
+ * Computes the sum of the squares of 16-bit samples exactly.
+ *
+ * @param data The samples.
+ * @param numSamples The number of samples.
+ * @return The sum of the squares.
+ */
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples);
+
+/**
+ * Finds the largest magnitude of 16-bit samples.
+ *
+ * @param data The samples.
+ * @param numSamples The number of samples.
+ * @return The largest magnitude, which is 32768 for a sample of -32768, or 0 for no samples.
+ */
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples);
+
+/**
+ * Counts the 16-bit samples whose sign differs from the sample before, which is how often the signal crosses zero.
+ *
+ * @param data The samples.
+ * @param numSamples The number of samples.
+ * @param previous The sample before the first.
+ * @return The number of sign changes.
+ */
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous);
+
+/// The plain C++ kernels, which the vectorized kernels match.
+namespace scalar {
+
+/// @see kernels::accumulateScaled
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples);
+
+/// @see kernels::applyGainRamp
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain);
+
+/// @see kernels::sumOfSquares
+float sumOfSquares(const float* data, size_t numSamples);
+
+/// @see kernels::dotProduct
+float dotProduct(const float* a, const float* b, size_t numSamples);
+
+/// @see kernels::floatToInt16
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples);
+
+/// @see kernels::int16ToFloat
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples);
+
+/// @see kernels::byteswap16
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples);
+
+/// @see kernels::deinterleaveToFloat
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames);
+
+/// @see kernels::downmixToMono
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames);
+
+/// @see kernels::applyGain
+void applyGain(int16_t* data, size_t numSamples, float gain);
+
+/// @see kernels::sumOfSquares
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples);
+
+/// @see kernels::peakMagnitude
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples);
+
+/// @see kernels::countSignChanges
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous);
+
+}  // namespace scalar
+}  // namespace kernels
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_PCMKERNELS_H_
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_RESAMPLER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/**
+ * Converts one channel of 16-bit samples from one sample rate to another, such as 48 kHz or 44.1 kHz capture to the
+ * 16 kHz the keyword detectors and AVS take.
+ *
+ * The resampler is a polyphase FIR filter: the ratio of the rates is reduced to @c L / @c M, and each output sample is
+ * the dot product of one of @c L phases of a windowed-sinc low pass filter with the latest input samples.  The filter
+ * cuts off below the lower of the two Nyquist frequencies, and delays the signal by about half its length, which is a
+ * few milliseconds.
+ *
+ * Samples may be passed in blocks of any size; the output does not depend on how the input is split up.
+ */
+class Resampler {
+public:
+    /**
+     * Creates a @c Resampler.
+     *
+     * @param inputRateHz The sample rate of the input.
+     * @param outputRateHz The sample rate of the output, which must differ from @c inputRateHz.
+     * @return The resampler, or @c nullptr if the rates are invalid, or their ratio would need too long a filter.
+     */
+    static std::unique_ptr<Resampler> create(unsigned int inputRateHz, unsigned int outputRateHz);
+
+    /**
+     * Gets the most samples a call to @c process() can produce.
+     *
+     * @param numInputSamples The number of samples passed to the call.
+     * @return The most samples the call writes.
+     */
+    size_t getMaxOutputSize(size_t numInputSamples) const;
+
+    /**
+     * Resamples a block of samples.
+     *
+     * @param input The samples.
+     * @param numInputSamples The number of samples.
+     * @param[out] output The resampled samples, which must have room for @c getMaxOutputSize(numInputSamples).
+     * @return The number of samples written to @c output.
+     */
+    size_t process(const int16_t* input, size_t numInputSamples, int16_t* output);
+
+    /// Discards the input held for the next call, as if the resampler had just been created.
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param interpolation The factor the input is upsampled by, @c L.
+     * @param decimation The factor the upsampled input is downsampled by, @c M.
+     * @param tapsPerPhase The number of input samples each output sample is computed from.
+     * @param cutoff The cutoff of the filter, as a share of the upsampled rate.
+     */
+    Resampler(size_t interpolation, size_t decimation, size_t tapsPerPhase, double cutoff);
+
+    /// The factor the input is upsampled by.
+    const size_t m_interpolation;
+
+    /// The factor the upsampled input is downsampled by.
+    const size_t m_decimation;
+
+    /// The number of input samples each output sample is computed from.
+    const size_t m_tapsPerPhase;
+
+    /// The phases of the filter, one after another, each reversed so that it lines up with the input in time order.
+    std::vector<float> m_coefficients;
+
+    /// The input which later output samples need, starting @c m_tapsPerPhase - 1 samples before the next one.
+    std::vector<float> m_history;
+
+    /// Where the next output sample falls, in upsampled samples from the start of @c m_history.
+    size_t m_offset;
+
+    /// The output of a call, before it is converted to 16-bit samples.
+    std::vector<float> m_output;
+};
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_RESAMPLER_H_
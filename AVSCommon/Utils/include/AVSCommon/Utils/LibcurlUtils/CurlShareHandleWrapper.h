@@ -0,0 +1,119 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
+
+#include <array>
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/**
+ * This class wraps a @c libcurl @c share @c handle as a C++ object.
+ *
+ * The @c libcurl @c handles which use the same instance share their DNS cache and TLS session cache. Transfers to a
+ * host which has been used before can therefore skip the DNS lookup and resume the TLS session rather than perform a
+ * full handshake. The connection cache is not shared, since @c libcurl does not support a shared connection cache
+ * being used by transfers on several threads at once.
+ *
+ * The shared data is locked internally, so the @c libcurl @c handles using an instance may perform transfers on
+ * different threads. An instance must outlive all of the @c libcurl @c handles which use it.
+ */
+class CurlShareHandleWrapper {
+public:
+    /**
+     * Create a CurlShareHandleWrapper.
+     *
+     * @return The new CurlShareHandleWrapper instance, or nullptr if the operation fails.
+     */
+    static std::shared_ptr<CurlShareHandleWrapper> create();
+
+    /**
+     * Destructor.
+     */
+    ~CurlShareHandleWrapper();
+
+    /**
+     * Get the @c libcurl @c share @c handle underlying this instance, to set as the @c CURLOPT_SHARE option of a
+     * @c libcurl @c handle.
+     *
+     * @return The @c libcurl @c share @c handle underlying this instance.
+     */
+    CURLSH* getCurlHandle();
+
+    /**
+     * Get whether the @c libcurl @c handles using this instance share a kind of data.
+     *
+     * @param data The kind of data.
+     * @return Whether the data is shared.
+     */
+    bool isSharing(curl_lock_data data) const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param handle The @c libcurl @c share @c handle to wrap.
+     */
+    CurlShareHandleWrapper(CURLSH* handle);
+
+    /**
+     * Set up the locking of the shared data and the kinds of data to share.
+     *
+     * @return Whether the operation was successful.
+     */
+    bool init();
+
+    /**
+     * The callback @c libcurl calls to lock shared data.
+     *
+     * @param handle The @c libcurl @c handle accessing the data.
+     * @param data The kind of data to lock.
+     * @param access The kind of access to the data.
+     * @param userData This instance.
+     */
+    static void lockCallback(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+
+    /**
+     * The callback @c libcurl calls to unlock shared data.
+     *
+     * @param handle The @c libcurl @c handle accessing the data.
+     * @param data The kind of data to unlock.
+     * @param userData This instance.
+     */
+    static void unlockCallback(CURL* handle, curl_lock_data data, void* userData);
+
+    /// The wrapped @c libcurl @c share @c handle.
+    CURLSH* m_handle;
+
+    /// A mutex for each kind of shared data.
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> m_mutexes;
+
+    /// Whether each kind of data is shared.
+    std::array<bool, CURL_LOCK_DATA_LAST> m_isSharing;
+};
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
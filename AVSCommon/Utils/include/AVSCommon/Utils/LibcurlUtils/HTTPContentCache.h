@@ -0,0 +1,343 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/**
+ * A persistent cache of HTTP response bodies, kept as one file per URL in a directory.
+ *
+ * Each file holds the response body along with its content type, its validators (the @c ETag and @c Last-Modified
+ * headers) and the time until which it is fresh. Cached bodies are read through a read-only memory mapping, and a
+ * checksum of the body is verified before an entry is handed out, so a damaged file is dropped rather than played.
+ *
+ * The total size of the files is kept within a budget by evicting the least recently used entries. The recency of the
+ * entries survives restarts through the modification times of their files.
+ *
+ * This class is thread safe.
+ */
+class HTTPContentCache {
+public:
+    /// The response data stored alongside a cached body.
+    struct Metadata {
+        /// Constructor.
+        Metadata();
+
+        /// The URL the response was fetched from.
+        std::string url;
+
+        /// The content type of the response.
+        std::string contentType;
+
+        /// The @c ETag header of the response, or an empty string if it had none.
+        std::string eTag;
+
+        /// The @c Last-Modified header of the response, or an empty string if it had none.
+        std::string lastModified;
+
+        /// The time after which the response must be revalidated with the server before it is used again.
+        std::chrono::system_clock::time_point expiry;
+    };
+
+    /// A cached response, mapped into memory. The mapping stays valid even if the entry is evicted or replaced.
+    class Entry {
+    public:
+        /// Destructor. Unmaps the file.
+        ~Entry();
+
+        /**
+         * Gets the response data stored alongside the body.
+         *
+         * @return The metadata.
+         */
+        const Metadata& getMetadata() const;
+
+        /**
+         * Gets the body.
+         *
+         * @return A pointer to the first byte of the body.
+         */
+        const char* getData() const;
+
+        /**
+         * Gets the size of the body.
+         *
+         * @return The size of the body in bytes.
+         */
+        size_t getSize() const;
+
+        /**
+         * Gets whether the entry can be used without revalidating it with the server.
+         *
+         * @return Whether the entry is fresh.
+         */
+        bool isFresh() const;
+
+        /**
+         * Gets whether the entry carries validators, and so can be revalidated with a conditional request.
+         *
+         * @return Whether the entry can be revalidated.
+         */
+        bool hasValidators() const;
+
+    private:
+        friend class HTTPContentCache;
+
+        /**
+         * Constructor.
+         *
+         * @param metadata The response data stored alongside the body.
+         * @param mapping The mapping of the whole file.
+         * @param mappingSize The size of @c mapping.
+         * @param dataOffset The offset of the body in the file.
+         */
+        Entry(Metadata metadata, void* mapping, size_t mappingSize, size_t dataOffset);
+
+        /// The response data stored alongside the body.
+        Metadata m_metadata;
+
+        /// The mapping of the whole file.
+        void* m_mapping;
+
+        /// The size of @c m_mapping.
+        size_t m_mappingSize;
+
+        /// The offset of the body in the file.
+        size_t m_dataOffset;
+    };
+
+    /// Statistics about the use of the cache.
+    struct Statistics {
+        /// Constructor.
+        Statistics();
+
+        /// The number of fetches served from the cache, including those revalidated with the server first.
+        uint64_t numHits;
+
+        /// The number of cacheable fetches which could not be served from the cache.
+        uint64_t numMisses;
+
+        /// The number of hits which needed a conditional request to the server first.
+        uint64_t numRevalidations;
+
+        /// The number of entries stored.
+        uint64_t numStores;
+
+        /// The number of entries evicted to stay within the size budget.
+        uint64_t numEvictions;
+
+        /// The number of entries found damaged and dropped.
+        uint64_t numCorruptEntries;
+
+        /// The total size of the cached files in bytes.
+        uint64_t sizeInBytes;
+
+        /// The total time from the request to the first byte of the body, for the hits.
+        std::chrono::microseconds hitStartLatency;
+
+        /// The total time from the request to the first byte of the body, for the misses.
+        std::chrono::microseconds missStartLatency;
+    };
+
+    /**
+     * Creates a cache in a directory, picking up any entries already stored there.
+     *
+     * @param directory The directory to keep the cache in. It is created if it does not exist.
+     * @param maxSizeInBytes The size budget of the cache.
+     * @param maxEntrySizeInBytes The size of the largest body to cache. Defaults to an eighth of the size budget.
+     * @return The cache, or @c nullptr if the directory could not be used.
+     */
+    static std::shared_ptr<HTTPContentCache> create(
+        const std::string& directory,
+        uint64_t maxSizeInBytes,
+        uint64_t maxEntrySizeInBytes = 0);
+
+    /**
+     * Gets the cached response of a URL. A hit or a miss must be recorded by the caller once it knows whether the
+     * entry could be used.
+     *
+     * @param url The URL.
+     * @return The entry, or @c nullptr if the URL is not cached or its file is damaged.
+     */
+    std::unique_ptr<Entry> get(const std::string& url);
+
+    /**
+     * Stores a response, replacing any response already cached for its URL, and evicts the least recently used entries
+     * as needed to stay within the size budget.
+     *
+     * @param metadata The response data to store alongside the body.
+     * @param body The body.
+     * @return Whether the response was stored.
+     */
+    bool put(const Metadata& metadata, const std::string& body);
+
+    /**
+     * Updates the time until which the cached response of a URL is fresh, after the server has confirmed it is still
+     * valid.
+     *
+     * @param url The URL.
+     * @param expiry The new expiry time.
+     * @return Whether the entry was updated.
+     */
+    bool refresh(const std::string& url, std::chrono::system_clock::time_point expiry);
+
+    /**
+     * Removes the cached response of a URL.
+     *
+     * @param url The URL.
+     */
+    void remove(const std::string& url);
+
+    /**
+     * Gets the size of the largest body the cache stores.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getMaxEntrySize() const;
+
+    /**
+     * Records a fetch served from the cache.
+     *
+     * @param startLatency The time from the request to the first byte of the body.
+     * @param revalidated Whether a conditional request to the server was needed first.
+     */
+    void recordHit(std::chrono::microseconds startLatency, bool revalidated);
+
+    /**
+     * Records a cacheable fetch which could not be served from the cache.
+     *
+     * @param startLatency The time from the request to the first byte of the body.
+     */
+    void recordMiss(std::chrono::microseconds startLatency);
+
+    /**
+     * Gets statistics about the use of the cache.
+     *
+     * @return The statistics.
+     */
+    Statistics getStatistics();
+
+private:
+    /// The size and recency of a cached file.
+    struct IndexEntry {
+        /// The size of the file in bytes.
+        uint64_t sizeInBytes;
+
+        /// The position of the entry in @c m_recency.
+        std::list<std::string>::iterator recency;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param directory The directory to keep the cache in.
+     * @param maxSizeInBytes The size budget of the cache.
+     * @param maxEntrySizeInBytes The size of the largest body to cache.
+     */
+    HTTPContentCache(const std::string& directory, uint64_t maxSizeInBytes, uint64_t maxEntrySizeInBytes);
+
+    /**
+     * Indexes the entries already stored in the directory, dropping any damaged files.
+     *
+     * @return Whether the directory could be read.
+     */
+    bool loadIndex();
+
+    /**
+     * Gets the name of the file of a URL within the directory.
+     *
+     * @param url The URL.
+     * @return The file name.
+     */
+    static std::string getFileName(const std::string& url);
+
+    /**
+     * Gets the path of a file within the directory.
+     *
+     * @param fileName The name of the file.
+     * @return The path.
+     */
+    std::string getPath(const std::string& fileName) const;
+
+    /**
+     * Adds a file to the index as the most recently used one, replacing any existing index entry for it.
+     *
+     * @note This must be called with @c m_mutex held.
+     *
+     * @param fileName The name of the file.
+     * @param sizeInBytes The size of the file in bytes.
+     */
+    void addToIndexLocked(const std::string& fileName, uint64_t sizeInBytes);
+
+    /**
+     * Removes a file from the index and the directory.
+     *
+     * @note This must be called with @c m_mutex held.
+     *
+     * @param fileName The name of the file.
+     */
+    void removeLocked(const std::string& fileName);
+
+    /**
+     * Evicts the least recently used entries until the cache is within its size budget.
+     *
+     * @note This must be called with @c m_mutex held.
+     */
+    void evictLocked();
+
+    /// The directory the cache is kept in.
+    const std::string m_directory;
+
+    /// The size budget of the cache.
+    const uint64_t m_maxSizeInBytes;
+
+    /// The size of the largest body to cache.
+    const uint64_t m_maxEntrySizeInBytes;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The cached files, keyed by file name.
+    std::unordered_map<std::string, IndexEntry> m_index;
+
+    /// The names of the cached files, from the least to the most recently used.
+    std::list<std::string> m_recency;
+
+    /// A counter used to give temporary files unique names.
+    uint64_t m_nextTemporaryFileId;
+
+    /// Statistics about the use of the cache.
+    Statistics m_statistics;
+};
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
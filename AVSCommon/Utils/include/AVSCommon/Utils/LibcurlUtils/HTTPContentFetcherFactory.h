@@ -21,6 +21,8 @@
 
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h>
+#include <AVSCommon/Utils/LibcurlUtils/HTTPContentCache.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -29,10 +31,31 @@ namespace libcurlUtils {
 
 /**
  * A class that produces @c HTTPContentFetchers.
+ *
+ * The fetchers produced by one factory share their DNS cache and TLS session cache, so that fetching a series of URLs
+ * from the same host (such as a playlist and its entries) does not pay for a new DNS lookup and a full TLS handshake
+ * each time.
+ *
+ * Given an @c HTTPContentCache, the fetchers also serve repeatedly fetched URLs, such as alert and notification
+ * sounds, from the cache.
  */
 class HTTPContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param cache The cache of response bodies to give the fetchers, or @c nullptr to not cache them.
+     */
+    explicit HTTPContentFetcherFactory(std::shared_ptr<HTTPContentCache> cache = nullptr);
+
     std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) override;
+
+private:
+    /// The caches shared by the fetchers, or @c nullptr if they could not be created.
+    std::shared_ptr<CurlShareHandleWrapper> m_shareHandle;
+
+    /// The cache of response bodies, or @c nullptr if they are not cached.
+    std::shared_ptr<HTTPContentCache> m_cache;
 };
 
 }  // namespace libcurlUtils
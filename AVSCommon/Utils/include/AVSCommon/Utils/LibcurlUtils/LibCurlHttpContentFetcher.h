@@ -17,12 +17,16 @@
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_LIBCURLHTTPCONTENTFETCHER_H_
 
 #include <atomic>
+#include <chrono>
 #include <future>
+#include <mutex>
 #include <string>
 #include <thread>
 
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h>
+#include <AVSCommon/Utils/LibcurlUtils/HTTPContentCache.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -32,10 +36,51 @@ namespace libcurlUtils {
 /**
  * A class used to retrieve content from remote URLs. Note that this object will only write to the Attachment while it
  * remains alive. If the object goes out of scope, writing to the Attachment will abort.
+ *
+ * If given an @c HTTPContentCache, the body of an @c ENTIRE_BODY fetch is served from the cache while the cached
+ * response is fresh, and a stale cached response is revalidated with a conditional request. Responses which may be
+ * cached are stored once they have been fetched in full.
  */
 class LibCurlHttpContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
 public:
-    LibCurlHttpContentFetcher(const std::string& url);
+    /**
+     * The timings of a fetch. Each is measured from the start of the fetch, so the time taken by a phase is the
+     * difference with the timing of the previous phase.
+     */
+    struct Timings {
+        /// When the name of the host was resolved.
+        std::chrono::microseconds nameLookup;
+
+        /// When the connection to the host was established.
+        std::chrono::microseconds connect;
+
+        /// When the TLS handshake completed, or zero if there was none.
+        std::chrono::microseconds tlsHandshake;
+
+        /// When the first byte of the response was received.
+        std::chrono::microseconds firstByte;
+
+        /// When the fetch completed.
+        std::chrono::microseconds total;
+
+        /// Whether the fetch reused a connection opened by an earlier fetch, skipping the connect and the handshake.
+        bool connectionReused;
+
+        /// Constructor.
+        Timings();
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param url The URL to fetch from.
+     * @param shareHandle The caches to share with other fetchers, or @c nullptr to not share any.
+     * @param cache The cache of response bodies, or @c nullptr to not cache them.
+     */
+    LibCurlHttpContentFetcher(
+        const std::string& url,
+        std::shared_ptr<CurlShareHandleWrapper> shareHandle = nullptr,
+        std::shared_ptr<HTTPContentCache> cache = nullptr);
 
     /**
      * @copydoc
@@ -50,7 +95,66 @@ public:
      */
     ~LibCurlHttpContentFetcher() override;
 
+    /**
+     * Gets the timings of the fetch.
+     *
+     * @param[out] timings The timings of the fetch.
+     * @return @c true if the fetch has completed and @c timings was set, or @c false otherwise.
+     */
+    bool getTimings(Timings* timings);
+
 private:
+    /**
+     * Records the timings of the fetch, once @c curl_easy_perform() has returned.
+     */
+    void recordTimings();
+
+    /**
+     * Satisfies the promises of the status code and content type with the last ones parsed, unless that has already
+     * been done.
+     */
+    void satisfyPromises();
+
+    /**
+     * Writes part of the body to the stream, and keeps a copy of it for the cache if the response is being cached.
+     *
+     * @param data The data to write.
+     * @param numBytes The number of bytes to write.
+     * @return The number of bytes written.
+     */
+    size_t writeBody(const char* data, size_t numBytes);
+
+    /**
+     * Serves the body of @c m_cachedEntry as the response.
+     *
+     * @param revalidated Whether the server was asked whether the entry is still valid first.
+     */
+    void writeCachedEntry(bool revalidated);
+
+    /**
+     * Stores the response in the cache if it was fetched in full and may be cached, once @c curl_easy_perform() has
+     * returned.
+     *
+     * @param curlReturnValue The result of @c curl_easy_perform().
+     */
+    void storeInCache(CURLcode curlReturnValue);
+
+    /**
+     * Checks whether the headers of the last response allow it to be stored in the cache, which is known before its
+     * body arrives.
+     *
+     * @return Whether the response may be stored.
+     */
+    bool isCacheable();
+
+    /**
+     * Gets the time until which the last response may be used without revalidating it, from its @c Cache-Control and
+     * @c Last-Modified headers. Playlists are never considered fresh on the strength of their @c Last-Modified header.
+     *
+     * @return The expiry time.
+     */
+    std::chrono::system_clock::time_point getExpiry();
+
     /// The callback to parse HTTP headers.
     static size_t headerCallback(char* data, size_t size, size_t nmemb, void* userData);
 
@@ -63,9 +167,21 @@ private:
     /// The URL to fetch from.
     std::string m_url;
 
+    /// The caches shared with other fetchers. This must outlive @c m_curlWrapper.
+    std::shared_ptr<CurlShareHandleWrapper> m_shareHandle;
+
     /// A libcurl wrapper.
     CurlEasyHandleWrapper m_curlWrapper;
 
+    /// Serializes access to @c m_timings and @c m_hasTimings.
+    std::mutex m_timingsMutex;
+
+    /// The timings of the fetch.
+    Timings m_timings;
+
+    /// Whether @c m_timings has been recorded.
+    bool m_hasTimings;
+
     /// A promise to the caller of @c getContent() that the HTTP status code will be set.
     std::promise<long> m_statusCodePromise;
 
@@ -95,9 +211,45 @@ private:
      */
     std::string m_lastContentType;
 
+    /// The value of the last @c ETag header parsed, or an empty string if the last response had none.
+    std::string m_lastETag;
+
+    /// The value of the last @c Last-Modified header parsed, or an empty string if the last response had none.
+    std::string m_lastLastModified;
+
+    /// The value of the last @c Cache-Control header parsed, in lower case, or an empty string if there was none.
+    std::string m_lastCacheControl;
+
+    /// The cache of response bodies, or @c nullptr if they are not cached.
+    std::shared_ptr<HTTPContentCache> m_cache;
+
+    /// Whether the response of this fetch may come from or go to @c m_cache.
+    bool m_useCache;
+
+    /// The cached response for the URL, if there is one which may be used.
+    std::unique_ptr<HTTPContentCache::Entry> m_cachedEntry;
+
+    /// Whether the body is being kept in @c m_body to store it in the cache.
+    bool m_cacheBody;
+
+    /// A copy of the body to store in the cache.
+    std::string m_body;
+
+    /// When @c getContent() was called.
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /// The time from the call to @c getContent() to the status code being known.
+    std::chrono::microseconds m_startLatency;
+
     /// Flag to indicate that the data-fetch operation has completed.
     std::atomic<bool> m_done;
 
+    /**
+     * Flag to indicate that the writer was created by @c getContent() rather than passed in by its caller. In that
+     * case the download is stopped when this object is destroyed.
+     */
+    bool m_writerWasCreatedLocally;
+
     /**
      * Internal thread that does the curl_easy_perform. The reason for using a thread is that curl_easy_perform may
      * block forever if the URL specified is a live stream.
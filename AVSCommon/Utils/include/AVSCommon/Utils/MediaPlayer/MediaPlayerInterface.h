@@ -116,6 +116,24 @@ public:
      */
     virtual SourceId setSource(std::shared_ptr<std::istream> stream, bool repeat) = 0;
 
+    /**
+     * Prepares a url source to be played after the current one, so that its content is already fetched and buffered
+     * by the time it is set. The current source keeps playing undisturbed.
+     *
+     * A later call to @c setSource() with the same url and offset uses the prepared source, and any other call to
+     * @c setSource() discards it. Preparing another source also discards the previously prepared one.
+     *
+     * @param url The url of the next source.
+     * @param offset The offset the next source will start playing from.
+     * @return Whether the source is being prepared. Implementations which do not support preparing sources return
+     *     @c false, in which case @c setSource() fetches the url as usual.
+     */
+    virtual bool prepareNextSource(
+        const std::string& url,
+        std::chrono::milliseconds offset = std::chrono::milliseconds::zero()) {
+        return false;
+    }
+
     /**
      * Starts playing audio specified by the @c setSource() call.
      *
@@ -16,6 +16,7 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_MEDIAPLAYER_MEDIAPLAYEROBSERVERINTERFACE_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_MEDIAPLAYER_MEDIAPLAYEROBSERVERINTERFACE_H_
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
@@ -84,6 +85,19 @@ public:
      */
     virtual void onPlaybackFinished(SourceId id) = 0;
 
+    /**
+     * This is an indication to the observer that the @c MediaPlayer is close to the end of the source, which is a
+     * good time to prepare the source to play next with @c MediaPlayerInterface::prepareNextSource(). It is sent at
+     * most once per source, and not at all if the duration of the source is unknown.
+     *
+     * @note The observer must quickly return from this callback. Failure to do so could block the @c MediaPlayer from
+     * further processing.
+     *
+     * @param id The id of the source to which this callback corresponds to.
+     */
+    virtual void onPlaybackNearlyFinished(SourceId id) {
+    }
+
     /**
      * This is an indication to the observer that the @c MediaPlayer encountered an error. Errors can occur during
      * playback.
@@ -151,6 +165,20 @@ public:
     virtual void onBufferRefilled(SourceId id) {
     }
 
+    /**
+     * This is an indication to the observer that the first buffer of audio of a source has reached the output of the
+     * @c MediaPlayer. It is sent at most once per source, and is meant to measure how long the audio took to start.
+     *
+     * @note The observer must quickly return from this callback. Failure to do so could block the @c MediaPlayer from
+     * further processing.
+     *
+     * @param id The id of the source to which this callback corresponds to.
+     * @param latency The time from the call to @c MediaPlayerInterface::setSource() which set the source to its first
+     * buffer of audio reaching the output.
+     */
+    virtual void onFirstBufferRendered(SourceId id, std::chrono::milliseconds latency) {
+    }
+
     /**
      * This is an indication to the observer that the @c MediaPlayer has found tags in the stream.
      * Tags are key value pairs extracted from the metadata of the stream. There can be multiple
@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/SDS/TimeIndex.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -211,6 +212,25 @@ public:
      */
     std::unique_ptr<Writer> createWriter(typename Writer::Policy policy, bool forceReplacement = false);
 
+    /**
+     * This function makes the @c Writers this stream creates record when each of their writes completes in a
+     * @c TimeIndex, so that a time (such as when a keyword was detected by a DSP, or when the user pressed a button)
+     * can be mapped to the index of the audio written at that time without seeking a @c Reader to the @c Writer.  It
+     * must be called before @c createWriter().  The index lives in this process, so only this @c SharedDataStream and
+     * its @c Writers see it, and not other streams which @c open() the same @c Buffer.
+     *
+     * @param capacity The number of writes to remember, which bounds how far back times can be mapped.
+     * @return Whether the index was enabled, which fails if @c capacity is invalid.
+     */
+    bool enableTimeIndex(size_t capacity);
+
+    /**
+     * This function returns the @c TimeIndex enabled by @c enableTimeIndex().
+     *
+     * @return The @c TimeIndex, or @c nullptr if it has not been enabled.
+     */
+    std::shared_ptr<TimeIndex> getTimeIndex() const;
+
     /**
      * This function adds a @c Reader to the stream.  Up to @c getMaxReaders() can be added to the stream.  This
      * function can be safely called from multiple threads or processes.
@@ -301,6 +321,9 @@ private:
 
     /// The @c BufferLayout of the shared buffer.
     std::shared_ptr<BufferLayout> m_bufferLayout;
+
+    /// The @c TimeIndex which @c Writers record their writes in, or @c nullptr if it has not been enabled.
+    std::shared_ptr<TimeIndex> m_timeIndex;
 };
 
 template <typename T>
@@ -386,8 +409,24 @@ std::unique_ptr<typename SharedDataStream<T>::Writer> SharedDataStream<T>::creat
                                .d("forceReplacement", "false"));
         return nullptr;
     } else {
-        return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout));
+        return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout, m_timeIndex));
+    }
+}
+
+template <typename T>
+bool SharedDataStream<T>::enableTimeIndex(size_t capacity) {
+    std::shared_ptr<TimeIndex> timeIndex = TimeIndex::create(capacity);
+    if (!timeIndex) {
+        logger::acsdkError(logger::LogEntry(TAG, "enableTimeIndexFailed").d("reason", "createFailed"));
+        return false;
     }
+    m_timeIndex = timeIndex;
+    return true;
+}
+
+template <typename T>
+std::shared_ptr<TimeIndex> SharedDataStream<T>::getTimeIndex() const {
+    return m_timeIndex;
 }
 
 template <typename T>
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMEINDEX_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMEINDEX_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/**
+ * A table of when each recent write to a @c SharedDataStream completed, which maps a time to the index of the word
+ * written at that time, and an index to the time it was written.
+ *
+ * The @c Writer of a stream records an entry after each write: the index after the last word written, and the time on
+ * @c std::chrono::steady_clock.  Between two entries the words are taken to have been written at an even pace, which
+ * is exact for a stream fed in real time by a capture device, since each write holds the audio captured since the
+ * previous one.  Lookups are binary searches, so they take O(log n) time in the number of entries, and the table holds
+ * a fixed number of the most recent entries, so it takes a fixed amount of memory.
+ *
+ * This class is thread-safe: one thread may record while others look up.
+ */
+class TimeIndex {
+public:
+    /// The type of an index in the stream.
+    using Index = uint64_t;
+
+    /// The clock of the entries.
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Creates a @c TimeIndex.
+     *
+     * @param capacity The number of entries to hold, which must be at least 2.
+     * @return The @c TimeIndex, or @c nullptr if @c capacity is invalid.
+     */
+    static std::unique_ptr<TimeIndex> create(size_t capacity);
+
+    /**
+     * Records that the words before an index had been written at a time, replacing the oldest entry if the table is
+     * full.  Entries must be recorded in order of index; an entry whose index is not after the last is ignored, and
+     * one whose time is before the last is taken to be at the time of the last.
+     *
+     * @param index The index after the last word written.
+     * @param time When the words had been written.
+     */
+    void record(Index index, Clock::time_point time);
+
+    /**
+     * Gets the index of the word which was written at a time.  A time up to one write interval (the mean time between
+     * the entries) after the newest entry is extrapolated at the pace of the whole table, so that an event which
+     * happens between writes maps to the index its audio will be written at.  The index is then at most one write's
+     * worth of words past the newest entry.
+     *
+     * @param time The time.
+     * @param[out] index The index.
+     * @return Whether the time is covered by the table, which it is not if the table is empty, the time is before its
+     *     oldest entry, or the time is more than one write interval after its newest entry, since the writer has then
+     *     stopped writing.
+     */
+    bool getIndex(Clock::time_point time, Index* index) const;
+
+    /**
+     * Gets the time a word was written at.
+     *
+     * @param index The index of the word.
+     * @param[out] time The time.
+     * @return Whether the index is covered by the table, which it is not if the table is empty or the index is before
+     *     its oldest entry or after its newest.
+     */
+    bool getTime(Index index, Clock::time_point* time) const;
+
+    /**
+     * Gets the number of entries the table holds.
+     *
+     * @return The number of entries.
+     */
+    size_t size() const;
+
+    /**
+     * Gets the number of entries the table can hold.
+     *
+     * @return The capacity.
+     */
+    size_t getCapacity() const;
+
+private:
+    /// An entry of the table.
+    struct Entry {
+        /// The time since the epoch of @c Clock, in nanoseconds.
+        int64_t time;
+        /// The index after the last word written.
+        Index index;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The number of entries to hold.
+     */
+    TimeIndex(size_t capacity);
+
+    /**
+     * Gets an entry, which must be held.  @c m_mutex must be locked.
+     *
+     * @param position The position of the entry from the oldest.
+     * @return The entry.
+     */
+    const Entry& at(size_t position) const;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The entries, as a ring buffer.
+    std::vector<Entry> m_entries;
+
+    /// The position in @c m_entries of the oldest entry.
+    size_t m_oldest;
+
+    /// The number of entries held.
+    size_t m_size;
+};
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMEINDEX_H_
@@ -71,8 +71,9 @@ public:
      *
      * @param policy The policy to use for reading from the stream.
      * @param stream The @c BufferLayout to use for writing stream data.
+     * @param timeIndex The @c TimeIndex to record each write in, or @c nullptr to not record writes.
      */
-    Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout);
+    Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout, std::shared_ptr<TimeIndex> timeIndex = nullptr);
 
     /// This destructor detaches the @c Writer from a @c BufferLayout.
     ~Writer();
@@ -136,6 +137,9 @@ private:
     /// The @c BufferLayout to use for writing stream data.
     std::shared_ptr<BufferLayout> m_bufferLayout;
 
+    /// The @c TimeIndex to record each write in, or @c nullptr to not record writes.
+    std::shared_ptr<TimeIndex> m_timeIndex;
+
     /**
      * A flag indicating whether this writer has closed.  This flag prevents trying to disable the writer during
      * destruction after previously having closed the writer.  Usage of this flag must be locked by
@@ -148,9 +152,13 @@ template <typename T>
 const std::string SharedDataStream<T>::Writer::TAG = "SdsWriter";
 
 template <typename T>
-SharedDataStream<T>::Writer::Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout) :
+SharedDataStream<T>::Writer::Writer(
+    Policy policy,
+    std::shared_ptr<BufferLayout> bufferLayout,
+    std::shared_ptr<TimeIndex> timeIndex) :
         m_policy{policy},
         m_bufferLayout{bufferLayout},
+        m_timeIndex{timeIndex},
         m_closed{false} {
     // Note - SharedDataStream::createWriter() holds writerEnableMutex while calling this function.
     auto header = m_bufferLayout->getHeader();
@@ -292,6 +300,11 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords, std::
         dataAvailableLock.unlock();
     }
 
+    // Record when the data became available, so that times can be mapped to indexes in the stream.
+    if (m_timeIndex) {
+        m_timeIndex->record(header->writeStartCursor, TimeIndex::Clock::now());
+    }
+
     // Notify the reader(s).
     // Note: as an optimization, we could skip this if there are no blocking readers (ACSDK-251).
     header->dataAvailableConditionVariable.notify_all();
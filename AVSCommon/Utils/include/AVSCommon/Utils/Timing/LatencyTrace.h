@@ -0,0 +1,258 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_LATENCYTRACE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_LATENCYTRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * A trace of the points an interaction passes through between the end of the user's speech and the first audio of
+ * the response, keyed by the dialogRequestId of the interaction.
+ *
+ * Points are recorded into a fixed size ring without taking a lock or allocating, so that recording is cheap enough
+ * to leave enabled in production.  Once the ring is full, the oldest points are overwritten.  The recorded points can
+ * be read back as a list, as per-point histograms of the time since the end of speech, or as a trace file for the
+ * Chrome trace viewer (chrome://tracing).
+ *
+ * dialogRequestIds longer than @c MAX_ID_LENGTH are truncated.  This class is thread-safe.
+ */
+class LatencyTrace {
+public:
+    /// The clock used to time the points.
+    using Clock = std::chrono::steady_clock;
+
+    /// The points of an interaction, in the order they are normally reached.
+    enum class Point {
+        /// The @c AudioInputProcessor stopped capturing the user's speech.
+        END_OF_SPEECH,
+        /// The bytes of a directive were received from AVS.
+        DIRECTIVE_RECEIVED,
+        /// A directive was passed to its handler by the @c DirectiveProcessor.
+        DIRECTIVE_DISPATCHED,
+        /// The @c SpeechSynthesizer started handling a Speak directive.
+        SPEAK_HANDLED,
+        /// The @c SpeechSynthesizer set the source of its media player.
+        SET_SOURCE,
+        /// The first buffer of the speech was rendered by the media player.
+        FIRST_BUFFER_RENDERED
+    };
+
+    /// The number of values of @c Point.
+    static constexpr size_t NUM_POINTS = 6;
+
+    /// The longest dialogRequestId which is recorded in full.
+    static constexpr size_t MAX_ID_LENGTH = 40;
+
+    /// The number of events kept by the instance returned by @c getInstance().
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    /// A recorded point.
+    struct Event {
+        /// The point.
+        Point point;
+        /// The dialogRequestId of the interaction.
+        std::string dialogRequestId;
+        /// The time at which the point was reached.
+        Clock::time_point time;
+    };
+
+    /// A histogram of the time taken to reach a point since the end of speech, over the interactions in the trace.
+    struct Histogram {
+        /// The point.
+        Point point;
+        /// The number of interactions which reached the point after their end of speech.
+        size_t count;
+        /// The shortest time.
+        std::chrono::milliseconds min;
+        /// The median time.
+        std::chrono::milliseconds median;
+        /// The 90th percentile time.
+        std::chrono::milliseconds p90;
+        /// The longest time.
+        std::chrono::milliseconds max;
+        /**
+         * The number of interactions in each bucket.  Bucket @c i counts the times up to @c getBucketBounds()[i], and
+         * the last bucket counts the times beyond the last bound.
+         */
+        std::vector<size_t> bucketCounts;
+    };
+
+    /**
+     * Gets the trace which the SDK records into.
+     *
+     * @return The trace, which holds @c DEFAULT_CAPACITY events.
+     */
+    static LatencyTrace& getInstance();
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The number of events to keep, which is rounded up to a power of two.
+     */
+    explicit LatencyTrace(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Sets whether points are recorded.  Recording is enabled by default.
+     *
+     * @param enabled Whether points are recorded.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Gets whether points are recorded.  Callers which need work to find the dialogRequestId of a point can check
+     * this first.
+     *
+     * @return Whether points are recorded.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Records that an interaction reached a point now.
+     *
+     * @param point The point.
+     * @param dialogRequestId The dialogRequestId of the interaction.  Points with an empty id are not recorded.
+     */
+    void record(Point point, const std::string& dialogRequestId);
+
+    /**
+     * Records that an interaction reached a point at a given time.
+     *
+     * @param point The point.
+     * @param dialogRequestId The dialogRequestId of the interaction.  Points with an empty id are not recorded.
+     * @param time The time at which the point was reached.
+     */
+    void record(Point point, const std::string& dialogRequestId, Clock::time_point time);
+
+    /// Drops the recorded events.
+    void clear();
+
+    /**
+     * Gets the events in the ring, in the order they were recorded.  Events being recorded while this is called may
+     * be left out.
+     *
+     * @return The events.
+     */
+    std::vector<Event> getEvents() const;
+
+    /**
+     * Gets a histogram for each point after @c END_OF_SPEECH, over the interactions whose end of speech is in the ring.
+     *
+     * @return The histograms, in the order of @c Point.
+     */
+    std::vector<Histogram> getHistograms() const;
+
+    /**
+     * Writes the events in the Chrome trace event format.  Each interaction is shown on its own row, with a span for
+     * each step between its points.
+     *
+     * @param stream The stream to write to.
+     * @return Whether the trace was written.
+     */
+    bool writeChromeTrace(std::ostream& stream) const;
+
+    /**
+     * Writes the events to a file in the Chrome trace event format.
+     *
+     * @param path The path of the file.
+     * @return Whether the file was written.
+     */
+    bool writeChromeTrace(const std::string& path) const;
+
+    /**
+     * Gets the upper bounds of the buckets of a @c Histogram, but the last one.
+     *
+     * @return The bounds.
+     */
+    static const std::vector<std::chrono::milliseconds>& getBucketBounds();
+
+private:
+    /// The number of 64-bit words holding a dialogRequestId in a @c Slot.
+    static constexpr size_t ID_WORDS = MAX_ID_LENGTH / sizeof(uint64_t);
+
+    /**
+     * An event in the ring.  All fields are atomic so that a reader can copy a slot while it is being written, and
+     * detect that from @c sequence changing under it.
+     */
+    struct Slot {
+        /// Constructor.
+        Slot();
+
+        /**
+         * Twice the ticket of the event in the slot, plus one while the event is being written and plus two once it
+         * is written.  Zero if the slot has never been written.
+         */
+        std::atomic<uint64_t> sequence;
+        /// The time of the event, as a count of @c Clock::duration since the epoch of @c Clock.
+        std::atomic<int64_t> time;
+        /// The @c Point of the event.
+        std::atomic<uint8_t> point;
+        /// The length of the dialogRequestId of the event.
+        std::atomic<uint8_t> idLength;
+        /// The bytes of the dialogRequestId of the event.
+        std::atomic<uint64_t> id[ID_WORDS];
+    };
+
+    /**
+     * Rounds a capacity up to a power of two.
+     *
+     * @param capacity The capacity.
+     * @return The rounded capacity.
+     */
+    static size_t roundUpCapacity(size_t capacity);
+
+    /// The number of slots in the ring, which is a power of two.
+    const size_t m_capacity;
+
+    /// The slots of the ring.
+    std::unique_ptr<Slot[]> m_slots;
+
+    /// The ticket of the next event to be recorded.  Event @c n is in slot @c n modulo @c m_capacity.
+    std::atomic<uint64_t> m_nextTicket;
+
+    /// Events with tickets below this were cleared.
+    std::atomic<uint64_t> m_firstTicket;
+
+    /// Whether points are recorded.
+    std::atomic<bool> m_isEnabled;
+};
+
+/**
+ * Write a @c LatencyTrace::Point value to an @c ostream as a string.
+ *
+ * @param stream The stream to write the value to.
+ * @param point The value to write to the @c ostream as a string.
+ * @return The @c ostream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, LatencyTrace::Point point);
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_LATENCYTRACE_H_
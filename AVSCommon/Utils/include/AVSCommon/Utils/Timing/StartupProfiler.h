@@ -0,0 +1,142 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_STARTUPPROFILER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_STARTUPPROFILER_H_
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * A utility class which records how long the named stages of a startup sequence take.
+ *
+ * Sequential stages are recorded with @c markStage(), which closes the stage started by the previous call (or by the
+ * construction of the profiler).  Stages which run concurrently are recorded with @c measureStage(), which does not
+ * affect the sequential stages.  This class is thread-safe.
+ */
+class StartupProfiler {
+public:
+    /// The clock used to time the stages.
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * A single stage of the startup sequence.
+     */
+    struct Stage {
+        /// The name of the stage.
+        std::string name;
+        /// The time at which the stage started, relative to the construction of the profiler.
+        std::chrono::milliseconds start;
+        /// How long the stage took.
+        std::chrono::milliseconds duration;
+    };
+
+    /**
+     * Constructor.  Construction marks the start of the first sequential stage.
+     */
+    StartupProfiler();
+
+    /**
+     * Record a sequential stage which started at the previous call to @c markStage() and ends now.
+     *
+     * @param name The name of the stage.
+     */
+    void markStage(const std::string& name);
+
+    /**
+     * Run a function and record how long it takes as a stage.
+     *
+     * @param name The name of the stage.
+     * @param function The function to run.
+     * @return The value returned by @c function.
+     */
+    template <typename FunctionType>
+    auto measureStage(const std::string& name, FunctionType function) -> decltype(function());
+
+    /**
+     * Get the stages recorded so far, in the order in which they completed.
+     *
+     * @return The recorded stages.
+     */
+    std::vector<Stage> getStages() const;
+
+    /**
+     * Get the time elapsed since the construction of the profiler.
+     *
+     * @return The elapsed time.
+     */
+    std::chrono::milliseconds getElapsed() const;
+
+    /**
+     * Get a human readable report of the recorded stages, with one line per stage.
+     *
+     * @return The report.
+     */
+    std::string getReport() const;
+
+private:
+    /**
+     * Add a stage to @c m_stages.
+     *
+     * @param name The name of the stage.
+     * @param start The time at which the stage started.
+     * @param end The time at which the stage ended.
+     */
+    void addStage(const std::string& name, Clock::time_point start, Clock::time_point end);
+
+    /// The time at which the profiler was constructed.
+    const Clock::time_point m_origin;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The time at which the current sequential stage started.
+    Clock::time_point m_lastMark;
+
+    /// The stages recorded so far.
+    std::vector<Stage> m_stages;
+};
+
+template <typename FunctionType>
+auto StartupProfiler::measureStage(const std::string& name, FunctionType function) -> decltype(function()) {
+    /*
+     * Records the stage when it goes out of scope, so that the result of @c function can be returned directly
+     * (including when it is @c void).
+     */
+    struct StageRecorder {
+        ~StageRecorder() {
+            profiler->addStage(name, start, Clock::now());
+        }
+        StartupProfiler* profiler;
+        const std::string& name;
+        Clock::time_point start;
+    } recorder{this, name, Clock::now()};
+
+    return function();
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_STARTUPPROFILER_H_
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "AVSCommon/Utils/Audio/PcmFile.h"
+#include "AVSCommon/Utils/Audio/PcmKernels.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PcmFile");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The size of a RIFF chunk header: a four character id and a 32-bit size.
+static const size_t CHUNK_HEADER_SIZE = 8;
+
+/// The size of the RIFF header of a WAV file: the RIFF chunk header and the "WAVE" form type.
+static const size_t RIFF_HEADER_SIZE = 12;
+
+/// The format tag of LPCM in a WAV file's "fmt " chunk.
+static const uint16_t WAVE_FORMAT_PCM = 1;
+
+/// The number of bits in a sample.
+static const uint16_t BITS_PER_SAMPLE = 16;
+
+/**
+ * Reads a little-endian integer from a byte buffer.
+ *
+ * @param bytes The bytes.
+ * @param size The number of bytes in the integer.
+ * @return The integer.
+ */
+static uint32_t readLittleEndian(const char* bytes, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Reads the whole of a file.
+ *
+ * @param path The path of the file.
+ * @param[out] bytes The contents of the file.
+ * @return Whether the file could be opened.
+ */
+static bool readBytes(const std::string& path, std::vector<char>* bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    bytes->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * Checks whether the contents of a file start with the RIFF header of a WAV file.
+ *
+ * @param bytes The contents of the file.
+ * @return Whether the file is a WAV file.
+ */
+static bool isWav(const std::vector<char>& bytes) {
+    return bytes.size() >= RIFF_HEADER_SIZE && 0 == std::memcmp(&bytes[0], "RIFF", 4) &&
+           0 == std::memcmp(&bytes[8], "WAVE", 4);
+}
+
+/**
+ * Finds the samples of a WAV file, and the format they are in.
+ *
+ * @param bytes The contents of the file.
+ * @param[out] sampleRateHz The rate of the samples.
+ * @param[out] numChannels The number of channels.
+ * @param[out] begin The offset of the samples in @c bytes.
+ * @param[out] end The offset of the end of the samples in @c bytes.
+ * @return Whether the file is a WAV file of 16-bit LPCM, with its format given before its samples.
+ */
+static bool findWavSamples(
+    const std::vector<char>& bytes,
+    unsigned int* sampleRateHz,
+    unsigned int* numChannels,
+    size_t* begin,
+    size_t* end) {
+    bool isLpcm = false;
+    size_t position = RIFF_HEADER_SIZE;
+    while (position + CHUNK_HEADER_SIZE <= bytes.size()) {
+        const char* chunk = &bytes[position];
+        size_t size = readLittleEndian(chunk + 4, 4);
+        size_t body = position + CHUNK_HEADER_SIZE;
+        if (0 == std::memcmp(chunk, "fmt ", 4) && size >= 16 && body + size <= bytes.size()) {
+            isLpcm = WAVE_FORMAT_PCM == readLittleEndian(&bytes[body], 2) &&
+                     BITS_PER_SAMPLE == readLittleEndian(&bytes[body + 14], 2);
+            *numChannels = readLittleEndian(&bytes[body + 2], 2);
+            *sampleRateHz = readLittleEndian(&bytes[body + 4], 4);
+        } else if (0 == std::memcmp(chunk, "data", 4)) {
+            *begin = body;
+            *end = std::min(bytes.size(), body + size);
+            return isLpcm && *numChannels > 0;
+        }
+        // Chunks are padded to an even size.
+        position = body + size + (size % 2);
+    }
+    return false;
+}
+
+/**
+ * Copies the whole frames of samples out of the contents of a file.
+ *
+ * @param bytes The contents of the file.
+ * @param begin The offset of the samples in @c bytes.
+ * @param end The offset of the end of the samples in @c bytes.
+ * @param numChannels The number of channels.
+ * @param[out] samples The samples, in the byte order of the platform.
+ * @return Whether there was at least one frame.
+ */
+static bool copyFrames(
+    const std::vector<char>& bytes,
+    size_t begin,
+    size_t end,
+    unsigned int numChannels,
+    std::vector<int16_t>* samples) {
+    size_t frameSize = numChannels * sizeof(int16_t);
+    size_t numFrames = (end - begin) / frameSize;
+    if (0 == numFrames) {
+        return false;
+    }
+    samples->resize(numFrames * numChannels);
+    std::memcpy(samples->data(), &bytes[begin], samples->size() * sizeof(int16_t));
+    if (!kernels::isPlatformLittleEndian()) {
+        kernels::byteswap16(samples->data(), samples->data(), samples->size());
+    }
+    return true;
+}
+
+bool readWavFile(
+    const std::string& path,
+    unsigned int* sampleRateHz,
+    unsigned int* numChannels,
+    std::vector<int16_t>* samples) {
+    if (!sampleRateHz || !numChannels || !samples) {
+        ACSDK_ERROR(LX("readWavFileFailed").d("reason", "invalidArguments").d("path", path));
+        return false;
+    }
+    std::vector<char> bytes;
+    if (!readBytes(path, &bytes)) {
+        ACSDK_ERROR(LX("readWavFileFailed").d("reason", "openFailed").d("path", path));
+        return false;
+    }
+    size_t begin = 0;
+    size_t end = 0;
+    if (!isWav(bytes) || !findWavSamples(bytes, sampleRateHz, numChannels, &begin, &end)) {
+        ACSDK_ERROR(LX("readWavFileFailed").d("reason", "unsupportedWavFormat").d("path", path));
+        return false;
+    }
+    if (!copyFrames(bytes, begin, end, *numChannels, samples)) {
+        ACSDK_ERROR(LX("readWavFileFailed").d("reason", "noFrames").d("path", path));
+        return false;
+    }
+    return true;
+}
+
+bool readPcmFile(
+    const std::string& path,
+    unsigned int sampleRateHz,
+    unsigned int numChannels,
+    std::vector<int16_t>* samples) {
+    if (!samples || 0 == numChannels) {
+        ACSDK_ERROR(LX("readPcmFileFailed").d("reason", "invalidArguments").d("path", path));
+        return false;
+    }
+    std::vector<char> bytes;
+    if (!readBytes(path, &bytes)) {
+        ACSDK_ERROR(LX("readPcmFileFailed").d("reason", "openFailed").d("path", path));
+        return false;
+    }
+
+    size_t begin = 0;
+    size_t end = bytes.size();
+    if (isWav(bytes)) {
+        unsigned int wavSampleRateHz = 0;
+        unsigned int wavNumChannels = 0;
+        if (!findWavSamples(bytes, &wavSampleRateHz, &wavNumChannels, &begin, &end) ||
+            wavSampleRateHz != sampleRateHz || wavNumChannels != numChannels) {
+            ACSDK_ERROR(LX("readPcmFileFailed").d("reason", "unsupportedWavFormat").d("path", path));
+            return false;
+        }
+    }
+    if (!copyFrames(bytes, begin, end, numChannels, samples)) {
+        ACSDK_ERROR(LX("readPcmFileFailed").d("reason", "noFrames").d("path", path));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,688 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ACSDK_PCM_KERNELS_NEON
+#endif
+
+#include "AVSCommon/Utils/Audio/PcmKernels.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace kernels {
+
+/// The largest 16-bit sample, as a float.
+static const float INT16_MAX_FLOAT = 32767.0f;
+
+/// The smallest 16-bit sample, as a float.
+static const float INT16_MIN_FLOAT = -32768.0f;
+
+/// The number of floats in a vector register.
+static const size_t LANES = 4;
+
+/// The number of 16-bit samples in a vector register.
+static const size_t INT16_LANES = 8;
+
+/// The number of vectors whose sign changes can be counted in 16-bit lanes without overflowing.
+static const size_t MAX_COUNT_ITERATIONS = 32767;
+
+bool isPlatformLittleEndian() {
+    const uint16_t one = 1;
+    return 1 == *reinterpret_cast<const uint8_t*>(&one);
+}
+
+namespace scalar {
+
+/**
+ * Rounds a sample to the nearest 16-bit value, half away from zero, and saturates it at the 16-bit range.
+ *
+ * @param sample The sample.
+ * @return The 16-bit sample.
+ */
+static int16_t toInt16(float sample) {
+    sample = std::min(std::max(sample, INT16_MIN_FLOAT), INT16_MAX_FLOAT);
+    // Round half away from zero, as the vectorized kernels do.
+    return static_cast<int16_t>(sample + std::copysign(0.5f, sample));
+}
+
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        dst[i] += gain * src[i];
+    }
+}
+
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    if (0 == numSamples) {
+        return;
+    }
+    float step = (endGain - startGain) / numSamples;
+    for (size_t i = 0; i < numSamples; ++i) {
+        data[i] *= startGain + step * i;
+    }
+}
+
+float sumOfSquares(const float* data, size_t numSamples) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        sum += data[i] * data[i];
+    }
+    return sum;
+}
+
+float dotProduct(const float* a, const float* b, size_t numSamples) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        dst[i] = toInt16(src[i]);
+    }
+}
+
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        auto sample = static_cast<uint16_t>(src[i]);
+        dst[i] = static_cast<int16_t>(static_cast<uint16_t>((sample << 8) | (sample >> 8)));
+    }
+}
+
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames) {
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        dst[frame] = src[frame * numChannels + channel];
+    }
+}
+
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames) {
+    auto divisor = static_cast<int32_t>(numChannels);
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        int32_t sum = 0;
+        for (size_t channel = 0; channel < numChannels; ++channel) {
+            sum += src[frame * numChannels + channel];
+        }
+        // Round down, as an arithmetic shift does, rather than toward zero.
+        int32_t mean = sum / divisor;
+        if (sum % divisor != 0 && sum < 0) {
+            --mean;
+        }
+        dst[frame] = static_cast<int16_t>(mean);
+    }
+}
+
+void applyGain(int16_t* data, size_t numSamples, float gain) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        data[i] = toInt16(data[i] * gain);
+    }
+}
+
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        sum += static_cast<int32_t>(data[i]) * data[i];
+    }
+    return sum;
+}
+
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples) {
+    unsigned int peak = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        peak = std::max(peak, static_cast<unsigned int>(std::abs(static_cast<int>(data[i]))));
+    }
+    return peak;
+}
+
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous) {
+    uint64_t count = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        count += static_cast<uint16_t>(data[i] ^ previous) >> 15;
+        previous = data[i];
+    }
+    return count;
+}
+
+}  // namespace scalar
+
+#if defined(__SSE2__)
+
+/**
+ * Converts eight 16-bit samples to floats.
+ *
+ * @param samples The samples.
+ * @param[out] low The first four samples.
+ * @param[out] high The last four samples.
+ */
+static inline void toFloats(__m128i samples, __m128* low, __m128* high) {
+    // Unpacking a vector with itself puts each sample in the high half of a 32-bit lane, ready to be sign extended.
+    *low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+    *high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+}
+
+/**
+ * Converts eight floats to 16-bit samples, rounding and saturating as @c scalar::floatToInt16 does.
+ *
+ * @param low The first four floats.
+ * @param high The last four floats.
+ * @return The samples.
+ */
+static inline __m128i toInt16(__m128 low, __m128 high) {
+    const __m128 maxima = _mm_set1_ps(INT16_MAX_FLOAT);
+    const __m128 minima = _mm_set1_ps(INT16_MIN_FLOAT);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    low = _mm_min_ps(_mm_max_ps(low, minima), maxima);
+    high = _mm_min_ps(_mm_max_ps(high, minima), maxima);
+    low = _mm_add_ps(low, _mm_or_ps(half, _mm_and_ps(low, signMask)));
+    high = _mm_add_ps(high, _mm_or_ps(half, _mm_and_ps(high, signMask)));
+    return _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high));
+}
+
+const char* getInstructionSet() {
+    return "SSE2";
+}
+
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples) {
+    size_t i = 0;
+    __m128 gains = _mm_set1_ps(gain);
+    for (; i + LANES <= numSamples; i += LANES) {
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(gains, _mm_loadu_ps(src + i)));
+        _mm_storeu_ps(dst + i, sum);
+    }
+    scalar::accumulateScaled(dst + i, src + i, gain, numSamples - i);
+}
+
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    if (0 == numSamples) {
+        return;
+    }
+    float step = (endGain - startGain) / numSamples;
+    __m128 gains = _mm_add_ps(_mm_set1_ps(startGain), _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0, 1, 2, 3)));
+    __m128 increment = _mm_set1_ps(step * LANES);
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), gains));
+        gains = _mm_add_ps(gains, increment);
+    }
+    for (; i < numSamples; ++i) {
+        data[i] *= startGain + step * i;
+    }
+}
+
+float sumOfSquares(const float* data, size_t numSamples) {
+    __m128 sums = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        __m128 samples = _mm_loadu_ps(data + i);
+        sums = _mm_add_ps(sums, _mm_mul_ps(samples, samples));
+    }
+    float lanes[LANES];
+    _mm_storeu_ps(lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+float dotProduct(const float* a, const float* b, size_t numSamples) {
+    __m128 sums = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float lanes[LANES];
+    _mm_storeu_ps(lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::dotProduct(a + i, b + i, numSamples - i);
+}
+
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128i packed = toInt16(_mm_loadu_ps(src + i), _mm_loadu_ps(src + i + LANES));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+    scalar::floatToInt16(src + i, dst + i, numSamples - i);
+}
+
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128 low;
+        __m128 high;
+        toFloats(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &low, &high);
+        _mm_storeu_ps(dst + i, low);
+        _mm_storeu_ps(dst + i + LANES, high);
+    }
+    scalar::int16ToFloat(src + i, dst + i, numSamples - i);
+}
+
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i swapped = _mm_or_si128(_mm_slli_epi16(samples, 8), _mm_srli_epi16(samples, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), swapped);
+    }
+    scalar::byteswap16(src + i, dst + i, numSamples - i);
+}
+
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames) {
+    if (1 == numChannels) {
+        int16ToFloat(src, dst, numFrames);
+        return;
+    }
+    size_t frame = 0;
+    if (2 == numChannels) {
+        // Each 32-bit lane holds a frame, with the first channel in its low half.
+        for (; frame + LANES <= numFrames; frame += LANES) {
+            __m128i frames = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + frame * 2));
+            __m128i samples = 0 == channel ? _mm_srai_epi32(_mm_slli_epi32(frames, 16), 16)
+                                           : _mm_srai_epi32(frames, 16);
+            _mm_storeu_ps(dst + frame, _mm_cvtepi32_ps(samples));
+        }
+    }
+    scalar::deinterleaveToFloat(
+        src + frame * numChannels, numChannels, channel, dst + frame, numFrames - frame);
+}
+
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames) {
+    if (1 == numChannels) {
+        std::copy(src, src + numFrames, dst);
+        return;
+    }
+    size_t frame = 0;
+    if (2 == numChannels) {
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; frame + INT16_LANES <= numFrames; frame += INT16_LANES) {
+            // Multiplying by one and adding pairs sums the channels of each frame in a 32-bit lane.
+            __m128i low = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + frame * 2)), ones);
+            __m128i high = _mm_madd_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + frame * 2 + INT16_LANES)), ones);
+            __m128i means = _mm_packs_epi32(_mm_srai_epi32(low, 1), _mm_srai_epi32(high, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + frame), means);
+        }
+    }
+    scalar::downmixToMono(src + frame * numChannels, numChannels, dst + frame, numFrames - frame);
+}
+
+void applyGain(int16_t* data, size_t numSamples, float gain) {
+    const __m128 gains = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128 low;
+        __m128 high;
+        toFloats(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), &low, &high);
+        __m128i packed = toInt16(_mm_mul_ps(low, gains), _mm_mul_ps(high, gains));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), packed);
+    }
+    scalar::applyGain(data + i, numSamples - i, gain);
+}
+
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples) {
+    // The sum of two squares is at most 2^31, so the 32-bit sums are widened as unsigned before they are added up.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero;
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i squares = _mm_madd_epi16(samples, samples);
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(squares, zero));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(squares, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    return lanes[0] + lanes[1] + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples) {
+    __m128i maxima = _mm_setzero_si128();
+    __m128i minima = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        maxima = _mm_max_epi16(maxima, samples);
+        minima = _mm_min_epi16(minima, samples);
+    }
+    int16_t maximumLanes[INT16_LANES];
+    int16_t minimumLanes[INT16_LANES];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maximumLanes), maxima);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(minimumLanes), minima);
+    unsigned int peak = scalar::peakMagnitude(data + i, numSamples - i);
+    for (size_t lane = 0; lane < INT16_LANES; ++lane) {
+        peak = std::max(peak, static_cast<unsigned int>(maximumLanes[lane]));
+        peak = std::max(peak, static_cast<unsigned int>(-static_cast<int>(minimumLanes[lane])));
+    }
+    return peak;
+}
+
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous) {
+    if (0 == numSamples) {
+        return 0;
+    }
+    uint64_t count = static_cast<uint16_t>(previous ^ data[0]) >> 15;
+    const __m128i ones = _mm_set1_epi16(1);
+    size_t i = 1;
+    while (i + INT16_LANES <= numSamples) {
+        // The 16-bit counts are added up before they can overflow.
+        size_t end = std::min(numSamples, i + INT16_LANES * MAX_COUNT_ITERATIONS);
+        __m128i counts = _mm_setzero_si128();
+        for (; i + INT16_LANES <= end; i += INT16_LANES) {
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i before = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 1));
+            // Each lane is -1 where the signs differ.
+            counts = _mm_sub_epi16(counts, _mm_srai_epi16(_mm_xor_si128(current, before), 15));
+        }
+        int32_t lanes[LANES];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_madd_epi16(counts, ones));
+        count += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    return count + scalar::countSignChanges(data + i, numSamples - i, data[i - 1]);
+}
+
+#elif defined(ACSDK_PCM_KERNELS_NEON)
+
+/**
+ * Converts eight 16-bit samples to floats.
+ *
+ * @param samples The samples.
+ * @param[out] low The first four samples.
+ * @param[out] high The last four samples.
+ */
+static inline void toFloats(int16x8_t samples, float32x4_t* low, float32x4_t* high) {
+    *low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+    *high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+}
+
+/**
+ * Converts eight floats to 16-bit samples, rounding and saturating as @c scalar::floatToInt16 does.
+ *
+ * @param low The first four floats.
+ * @param high The last four floats.
+ * @return The samples.
+ */
+static inline int16x8_t toInt16(float32x4_t low, float32x4_t high) {
+    const float32x4_t maxima = vdupq_n_f32(INT16_MAX_FLOAT);
+    const float32x4_t minima = vdupq_n_f32(INT16_MIN_FLOAT);
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000);
+    const uint32x4_t half = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+    low = vminq_f32(vmaxq_f32(low, minima), maxima);
+    high = vminq_f32(vmaxq_f32(high, minima), maxima);
+    low = vaddq_f32(low, vreinterpretq_f32_u32(vorrq_u32(half, vandq_u32(vreinterpretq_u32_f32(low), signMask))));
+    high = vaddq_f32(high, vreinterpretq_f32_u32(vorrq_u32(half, vandq_u32(vreinterpretq_u32_f32(high), signMask))));
+    return vcombine_s16(vqmovn_s32(vcvtq_s32_f32(low)), vqmovn_s32(vcvtq_s32_f32(high)));
+}
+
+const char* getInstructionSet() {
+    return "NEON";
+}
+
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples) {
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), gain));
+    }
+    scalar::accumulateScaled(dst + i, src + i, gain, numSamples - i);
+}
+
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    if (0 == numSamples) {
+        return;
+    }
+    float step = (endGain - startGain) / numSamples;
+    const float offsets[LANES] = {0, 1, 2, 3};
+    float32x4_t gains = vmlaq_n_f32(vdupq_n_f32(startGain), vld1q_f32(offsets), step);
+    float32x4_t increment = vdupq_n_f32(step * LANES);
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), gains));
+        gains = vaddq_f32(gains, increment);
+    }
+    for (; i < numSamples; ++i) {
+        data[i] *= startGain + step * i;
+    }
+}
+
+float sumOfSquares(const float* data, size_t numSamples) {
+    float32x4_t sums = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        float32x4_t samples = vld1q_f32(data + i);
+        sums = vmlaq_f32(sums, samples, samples);
+    }
+    float lanes[LANES];
+    vst1q_f32(lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+float dotProduct(const float* a, const float* b, size_t numSamples) {
+    float32x4_t sums = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + LANES <= numSamples; i += LANES) {
+        sums = vmlaq_f32(sums, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float lanes[LANES];
+    vst1q_f32(lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::dotProduct(a + i, b + i, numSamples - i);
+}
+
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        vst1q_s16(dst + i, toInt16(vld1q_f32(src + i), vld1q_f32(src + i + LANES)));
+    }
+    scalar::floatToInt16(src + i, dst + i, numSamples - i);
+}
+
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        float32x4_t low;
+        float32x4_t high;
+        toFloats(vld1q_s16(src + i), &low, &high);
+        vst1q_f32(dst + i, low);
+        vst1q_f32(dst + i + LANES, high);
+    }
+    scalar::int16ToFloat(src + i, dst + i, numSamples - i);
+}
+
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        vst1q_s16(dst + i, vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(vld1q_s16(src + i)))));
+    }
+    scalar::byteswap16(src + i, dst + i, numSamples - i);
+}
+
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames) {
+    if (1 == numChannels) {
+        int16ToFloat(src, dst, numFrames);
+        return;
+    }
+    size_t frame = 0;
+    if (2 == numChannels) {
+        for (; frame + INT16_LANES <= numFrames; frame += INT16_LANES) {
+            int16x8x2_t frames = vld2q_s16(src + frame * 2);
+            float32x4_t low;
+            float32x4_t high;
+            toFloats(frames.val[channel], &low, &high);
+            vst1q_f32(dst + frame, low);
+            vst1q_f32(dst + frame + LANES, high);
+        }
+    }
+    scalar::deinterleaveToFloat(
+        src + frame * numChannels, numChannels, channel, dst + frame, numFrames - frame);
+}
+
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames) {
+    if (1 == numChannels) {
+        std::copy(src, src + numFrames, dst);
+        return;
+    }
+    size_t frame = 0;
+    if (2 == numChannels) {
+        for (; frame + INT16_LANES <= numFrames; frame += INT16_LANES) {
+            int16x8x2_t frames = vld2q_s16(src + frame * 2);
+            // The halving add rounds down, and cannot overflow.
+            vst1q_s16(dst + frame, vhaddq_s16(frames.val[0], frames.val[1]));
+        }
+    }
+    scalar::downmixToMono(src + frame * numChannels, numChannels, dst + frame, numFrames - frame);
+}
+
+void applyGain(int16_t* data, size_t numSamples, float gain) {
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        float32x4_t low;
+        float32x4_t high;
+        toFloats(vld1q_s16(data + i), &low, &high);
+        vst1q_s16(data + i, toInt16(vmulq_n_f32(low, gain), vmulq_n_f32(high, gain)));
+    }
+    scalar::applyGain(data + i, numSamples - i, gain);
+}
+
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples) {
+    uint64x2_t sums = vdupq_n_u64(0);
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        int16x8_t samples = vld1q_s16(data + i);
+        int16x4_t low = vget_low_s16(samples);
+        int16x4_t high = vget_high_s16(samples);
+        sums = vpadalq_u32(sums, vreinterpretq_u32_s32(vmull_s16(low, low)));
+        sums = vpadalq_u32(sums, vreinterpretq_u32_s32(vmull_s16(high, high)));
+    }
+    return vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1) + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples) {
+    int16x8_t maxima = vdupq_n_s16(0);
+    int16x8_t minima = vdupq_n_s16(0);
+    size_t i = 0;
+    for (; i + INT16_LANES <= numSamples; i += INT16_LANES) {
+        int16x8_t samples = vld1q_s16(data + i);
+        maxima = vmaxq_s16(maxima, samples);
+        minima = vminq_s16(minima, samples);
+    }
+    int16_t maximumLanes[INT16_LANES];
+    int16_t minimumLanes[INT16_LANES];
+    vst1q_s16(maximumLanes, maxima);
+    vst1q_s16(minimumLanes, minima);
+    unsigned int peak = scalar::peakMagnitude(data + i, numSamples - i);
+    for (size_t lane = 0; lane < INT16_LANES; ++lane) {
+        peak = std::max(peak, static_cast<unsigned int>(maximumLanes[lane]));
+        peak = std::max(peak, static_cast<unsigned int>(-static_cast<int>(minimumLanes[lane])));
+    }
+    return peak;
+}
+
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous) {
+    if (0 == numSamples) {
+        return 0;
+    }
+    uint64_t count = static_cast<uint16_t>(previous ^ data[0]) >> 15;
+    size_t i = 1;
+    while (i + INT16_LANES <= numSamples) {
+        // The 16-bit counts are added up before they can overflow.
+        size_t end = std::min(numSamples, i + INT16_LANES * MAX_COUNT_ITERATIONS);
+        int16x8_t counts = vdupq_n_s16(0);
+        for (; i + INT16_LANES <= end; i += INT16_LANES) {
+            int16x8_t current = vld1q_s16(data + i);
+            int16x8_t before = vld1q_s16(data + i - 1);
+            // Each lane is -1 where the signs differ.
+            counts = vsubq_s16(counts, vshrq_n_s16(veorq_s16(current, before), 15));
+        }
+        int64x2_t pairs = vpaddlq_s32(vpaddlq_s16(counts));
+        count += vgetq_lane_s64(pairs, 0) + vgetq_lane_s64(pairs, 1);
+    }
+    return count + scalar::countSignChanges(data + i, numSamples - i, data[i - 1]);
+}
+
+#else
+
+const char* getInstructionSet() {
+    return "scalar";
+}
+
+void accumulateScaled(float* dst, const float* src, float gain, size_t numSamples) {
+    scalar::accumulateScaled(dst, src, gain, numSamples);
+}
+
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    scalar::applyGainRamp(data, numSamples, startGain, endGain);
+}
+
+float sumOfSquares(const float* data, size_t numSamples) {
+    return scalar::sumOfSquares(data, numSamples);
+}
+
+float dotProduct(const float* a, const float* b, size_t numSamples) {
+    return scalar::dotProduct(a, b, numSamples);
+}
+
+void floatToInt16(const float* src, int16_t* dst, size_t numSamples) {
+    scalar::floatToInt16(src, dst, numSamples);
+}
+
+void int16ToFloat(const int16_t* src, float* dst, size_t numSamples) {
+    scalar::int16ToFloat(src, dst, numSamples);
+}
+
+void byteswap16(const int16_t* src, int16_t* dst, size_t numSamples) {
+    scalar::byteswap16(src, dst, numSamples);
+}
+
+void deinterleaveToFloat(const int16_t* src, size_t numChannels, size_t channel, float* dst, size_t numFrames) {
+    scalar::deinterleaveToFloat(src, numChannels, channel, dst, numFrames);
+}
+
+void downmixToMono(const int16_t* src, size_t numChannels, int16_t* dst, size_t numFrames) {
+    scalar::downmixToMono(src, numChannels, dst, numFrames);
+}
+
+void applyGain(int16_t* data, size_t numSamples, float gain) {
+    scalar::applyGain(data, numSamples, gain);
+}
+
+uint64_t sumOfSquares(const int16_t* data, size_t numSamples) {
+    return scalar::sumOfSquares(data, numSamples);
+}
+
+unsigned int peakMagnitude(const int16_t* data, size_t numSamples) {
+    return scalar::peakMagnitude(data, numSamples);
+}
+
+uint64_t countSignChanges(const int16_t* data, size_t numSamples, int16_t previous) {
+    return scalar::countSignChanges(data, numSamples, previous);
+}
+
+#endif
+
+}  // namespace kernels
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "AVSCommon/Utils/Audio/PcmKernels.h"
+#include "AVSCommon/Utils/Audio/Resampler.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("Resampler");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * The number of input samples each output sample is computed from, per multiple of the output rate the input rate
+ * is.  At 48 kHz to 16 kHz, this makes the transition band of the filter about 1.4 kHz wide.
+ */
+static const size_t TAPS_PER_DECIMATION = 64;
+
+/// Where the middle of the filter's transition band falls, as a share of the lower Nyquist frequency.
+static const double CUTOFF_SHARE = 0.9;
+
+/// The most coefficients a filter may have, which keeps rates with a complex ratio, such as 44.1 kHz to 48 kHz, cheap.
+static const size_t MAX_COEFFICIENTS = 1 << 18;
+
+/**
+ * Computes the greatest common divisor of two numbers.
+ *
+ * @param a The first number.
+ * @param b The second number.
+ * @return The greatest common divisor.
+ */
+static unsigned int greatestCommonDivisor(unsigned int a, unsigned int b) {
+    while (b != 0) {
+        auto remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+std::unique_ptr<Resampler> Resampler::create(unsigned int inputRateHz, unsigned int outputRateHz) {
+    if (0 == inputRateHz || 0 == outputRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidRate").d("input", inputRateHz).d("output", outputRateHz));
+        return nullptr;
+    }
+    if (inputRateHz == outputRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "sameRate").d("rate", inputRateHz));
+        return nullptr;
+    }
+    auto divisor = greatestCommonDivisor(inputRateHz, outputRateHz);
+    size_t interpolation = outputRateHz / divisor;
+    size_t decimation = inputRateHz / divisor;
+    size_t tapsPerPhase = TAPS_PER_DECIMATION * ((decimation + interpolation - 1) / interpolation);
+    if (interpolation * tapsPerPhase > MAX_COEFFICIENTS) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "filterTooLong")
+                        .d("input", inputRateHz)
+                        .d("output", outputRateHz)
+                        .d("coefficients", interpolation * tapsPerPhase));
+        return nullptr;
+    }
+    double cutoff = CUTOFF_SHARE * std::min(inputRateHz, outputRateHz) / (2.0 * inputRateHz * interpolation);
+    return std::unique_ptr<Resampler>(new Resampler(interpolation, decimation, tapsPerPhase, cutoff));
+}
+
+size_t Resampler::getMaxOutputSize(size_t numInputSamples) const {
+    // The input held from the last call can add at most one sample.
+    return numInputSamples * m_interpolation / m_decimation + 2;
+}
+
+size_t Resampler::process(const int16_t* input, size_t numInputSamples, int16_t* output) {
+    auto historySize = m_history.size();
+    m_history.resize(historySize + numInputSamples);
+    kernels::int16ToFloat(input, m_history.data() + historySize, numInputSamples);
+
+    m_output.clear();
+    while (m_offset / m_interpolation + m_tapsPerPhase <= m_history.size()) {
+        auto phase = m_offset % m_interpolation;
+        m_output.push_back(kernels::dotProduct(
+            m_coefficients.data() + phase * m_tapsPerPhase,
+            m_history.data() + m_offset / m_interpolation,
+            m_tapsPerPhase));
+        m_offset += m_decimation;
+    }
+
+    auto consumed = std::min(m_offset / m_interpolation, m_history.size());
+    m_history.erase(m_history.begin(), m_history.begin() + consumed);
+    m_offset -= consumed * m_interpolation;
+
+    kernels::floatToInt16(m_output.data(), output, m_output.size());
+    return m_output.size();
+}
+
+void Resampler::reset() {
+    m_history.assign(m_tapsPerPhase - 1, 0.0f);
+    m_offset = 0;
+}
+
+Resampler::Resampler(size_t interpolation, size_t decimation, size_t tapsPerPhase, double cutoff) :
+        m_interpolation{interpolation},
+        m_decimation{decimation},
+        m_tapsPerPhase{tapsPerPhase},
+        m_coefficients(interpolation * tapsPerPhase),
+        m_offset{0} {
+    // A Blackman-windowed sinc at the upsampled rate.
+    const double pi = std::acos(-1.0);
+    const size_t length = m_coefficients.size();
+    const double center = (length - 1) / 2.0;
+    std::vector<double> filter(length);
+    for (size_t i = 0; i < length; ++i) {
+        double x = i - center;
+        double sinc = 0.0 == x ? 2.0 * cutoff : std::sin(2.0 * pi * cutoff * x) / (pi * x);
+        double angle = 2.0 * pi * i / (length - 1);
+        double window = 0.42 - 0.5 * std::cos(angle) + 0.08 * std::cos(2.0 * angle);
+        filter[i] = sinc * window;
+    }
+
+    // Each phase is scaled to a gain of one, so that a constant signal comes out unchanged whatever the phase.
+    for (size_t phase = 0; phase < m_interpolation; ++phase) {
+        double sum = 0.0;
+        for (size_t tap = 0; tap < m_tapsPerPhase; ++tap) {
+            sum += filter[phase + tap * m_interpolation];
+        }
+        for (size_t tap = 0; tap < m_tapsPerPhase; ++tap) {
+            m_coefficients[phase * m_tapsPerPhase + m_tapsPerPhase - 1 - tap] =
+                static_cast<float>(filter[phase + tap * m_interpolation] / sum);
+        }
+    }
+    reset();
+}
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,385 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Timing/LatencyTrace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LatencyTrace");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The process id written to the Chrome trace, which shows a single process.
+static const int CHROME_TRACE_PID = 1;
+
+constexpr size_t LatencyTrace::NUM_POINTS;
+constexpr size_t LatencyTrace::MAX_ID_LENGTH;
+constexpr size_t LatencyTrace::DEFAULT_CAPACITY;
+constexpr size_t LatencyTrace::ID_WORDS;
+
+static_assert(LatencyTrace::MAX_ID_LENGTH % sizeof(uint64_t) == 0, "MAX_ID_LENGTH must be a whole number of words");
+static_assert(LatencyTrace::MAX_ID_LENGTH <= UINT8_MAX, "MAX_ID_LENGTH must fit in Slot::idLength");
+
+/**
+ * Gets the time between two points in microseconds, as used by the Chrome trace format.
+ *
+ * @param time The time.
+ * @param origin The time written as zero.
+ * @return The number of microseconds from @c origin to @c time.
+ */
+static int64_t toTraceMicroseconds(LatencyTrace::Clock::time_point time, LatencyTrace::Clock::time_point origin) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+}
+
+/**
+ * Gets a percentile of sorted times, using the nearest rank.
+ *
+ * @param times The times, sorted and not empty.
+ * @param percent The percentile.
+ * @return The time at the percentile.
+ */
+static std::chrono::milliseconds percentile(const std::vector<std::chrono::milliseconds>& times, size_t percent) {
+    size_t rank = (times.size() * percent + 99) / 100;
+    return times[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * Sorts events by their time, keeping the order in which events with the same time were recorded.
+ *
+ * @param events The events.
+ */
+static void sortByTime(std::vector<LatencyTrace::Event>* events) {
+    std::stable_sort(
+        events->begin(), events->end(), [](const LatencyTrace::Event& lhs, const LatencyTrace::Event& rhs) {
+            return lhs.time < rhs.time;
+        });
+}
+
+LatencyTrace::Slot::Slot() : sequence{0}, time{0}, point{0}, idLength{0} {
+    for (auto& word : id) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyTrace& LatencyTrace::getInstance() {
+    static LatencyTrace instance;
+    return instance;
+}
+
+LatencyTrace::LatencyTrace(size_t capacity) :
+        m_capacity{roundUpCapacity(capacity)},
+        m_slots{new Slot[m_capacity]},
+        m_nextTicket{0},
+        m_firstTicket{0},
+        m_isEnabled{true} {
+}
+
+void LatencyTrace::setEnabled(bool enabled) {
+    m_isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyTrace::isEnabled() const {
+    return m_isEnabled.load(std::memory_order_relaxed);
+}
+
+void LatencyTrace::record(Point point, const std::string& dialogRequestId) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(point, dialogRequestId, Clock::now());
+}
+
+void LatencyTrace::record(Point point, const std::string& dialogRequestId, Clock::time_point time) {
+    if (!isEnabled() || dialogRequestId.empty()) {
+        return;
+    }
+    auto ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[ticket & (m_capacity - 1)];
+
+    // Mark the slot as being written before any of its fields change, so that readers drop a partial copy.
+    slot.sequence.store(ticket * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.time.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+    slot.point.store(static_cast<uint8_t>(point), std::memory_order_relaxed);
+    auto length = std::min(dialogRequestId.size(), MAX_ID_LENGTH);
+    slot.idLength.store(static_cast<uint8_t>(length), std::memory_order_relaxed);
+    for (size_t i = 0; i < ID_WORDS; ++i) {
+        uint64_t word = 0;
+        auto offset = i * sizeof(word);
+        if (offset < length) {
+            std::memcpy(&word, dialogRequestId.data() + offset, std::min(sizeof(word), length - offset));
+        }
+        slot.id[i].store(word, std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(ticket * 2 + 2, std::memory_order_release);
+}
+
+void LatencyTrace::clear() {
+    m_firstTicket.store(m_nextTicket.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+std::vector<LatencyTrace::Event> LatencyTrace::getEvents() const {
+    std::vector<Event> events;
+    auto nextTicket = m_nextTicket.load(std::memory_order_acquire);
+    auto oldestTicket = nextTicket - std::min<uint64_t>(nextTicket, m_capacity);
+    auto firstTicket = std::max(m_firstTicket.load(std::memory_order_relaxed), oldestTicket);
+    events.reserve(nextTicket - firstTicket);
+
+    for (auto ticket = firstTicket; ticket < nextTicket; ++ticket) {
+        const auto& slot = m_slots[ticket & (m_capacity - 1)];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != ticket * 2 + 2) {
+            // The event is still being written, or has already been overwritten.
+            continue;
+        }
+        auto time = slot.time.load(std::memory_order_relaxed);
+        auto point = slot.point.load(std::memory_order_relaxed);
+        auto length = slot.idLength.load(std::memory_order_relaxed);
+        char id[MAX_ID_LENGTH];
+        for (size_t i = 0; i < ID_WORDS; ++i) {
+            auto word = slot.id[i].load(std::memory_order_relaxed);
+            std::memcpy(id + i * sizeof(word), &word, sizeof(word));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        Event event;
+        event.point = static_cast<Point>(point);
+        event.dialogRequestId.assign(id, std::min<size_t>(length, MAX_ID_LENGTH));
+        event.time = Clock::time_point(Clock::duration(time));
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+std::vector<LatencyTrace::Histogram> LatencyTrace::getHistograms() const {
+    // Points recorded with an earlier time may follow later ones in the ring.
+    auto events = getEvents();
+    sortByTime(&events);
+
+    // The first end of speech of each interaction.
+    std::unordered_map<std::string, Clock::time_point> endOfSpeechTimes;
+    for (const auto& event : events) {
+        if (Point::END_OF_SPEECH == event.point) {
+            endOfSpeechTimes.insert({event.dialogRequestId, event.time});
+        }
+    }
+
+    // The time from the end of speech to the first time each interaction reached each point.
+    std::vector<std::unordered_map<std::string, std::chrono::milliseconds>> firstTimes(NUM_POINTS);
+    for (const auto& event : events) {
+        auto endOfSpeech = endOfSpeechTimes.find(event.dialogRequestId);
+        if (Point::END_OF_SPEECH == event.point || endOfSpeechTimes.end() == endOfSpeech ||
+            event.time < endOfSpeech->second) {
+            continue;
+        }
+        firstTimes[static_cast<size_t>(event.point)].insert(
+            {event.dialogRequestId,
+             std::chrono::duration_cast<std::chrono::milliseconds>(event.time - endOfSpeech->second)});
+    }
+
+    const auto& bounds = getBucketBounds();
+    std::vector<Histogram> histograms;
+    for (size_t i = static_cast<size_t>(Point::END_OF_SPEECH) + 1; i < NUM_POINTS; ++i) {
+        std::vector<std::chrono::milliseconds> times;
+        times.reserve(firstTimes[i].size());
+        for (const auto& entry : firstTimes[i]) {
+            times.push_back(entry.second);
+        }
+        std::sort(times.begin(), times.end());
+
+        Histogram histogram;
+        histogram.point = static_cast<Point>(i);
+        histogram.count = times.size();
+        histogram.min = times.empty() ? std::chrono::milliseconds::zero() : times.front();
+        histogram.median = times.empty() ? std::chrono::milliseconds::zero() : percentile(times, 50);
+        histogram.p90 = times.empty() ? std::chrono::milliseconds::zero() : percentile(times, 90);
+        histogram.max = times.empty() ? std::chrono::milliseconds::zero() : times.back();
+        histogram.bucketCounts.assign(bounds.size() + 1, 0);
+        for (auto time : times) {
+            auto bucket = std::lower_bound(bounds.begin(), bounds.end(), time) - bounds.begin();
+            ++histogram.bucketCounts[bucket];
+        }
+        histograms.push_back(std::move(histogram));
+    }
+    return histograms;
+}
+
+bool LatencyTrace::writeChromeTrace(std::ostream& stream) const {
+    auto events = getEvents();
+    sortByTime(&events);
+    auto origin = events.empty() ? Clock::time_point() : events.front().time;
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    // Each interaction gets its own row, named after its dialogRequestId, in the order the interactions started.
+    std::unordered_map<std::string, int> rows;
+    std::unordered_map<std::string, const Event*> previousEvents;
+    for (const auto& event : events) {
+        auto row = rows.find(event.dialogRequestId);
+        if (rows.end() == row) {
+            row = rows.insert({event.dialogRequestId, static_cast<int>(rows.size()) + 1}).first;
+            writer.StartObject();
+            writer.Key("name");
+            writer.String("thread_name");
+            writer.Key("ph");
+            writer.String("M");
+            writer.Key("pid");
+            writer.Int(CHROME_TRACE_PID);
+            writer.Key("tid");
+            writer.Int(row->second);
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(event.dialogRequestId.c_str());
+            writer.EndObject();
+            writer.EndObject();
+        }
+
+        std::ostringstream name;
+        name << event.point;
+
+        // A span for the step from the previous point of the interaction to this one.
+        auto previous = previousEvents.find(event.dialogRequestId);
+        if (previousEvents.end() != previous) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(name.str().c_str());
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("ts");
+            writer.Int64(toTraceMicroseconds(previous->second->time, origin));
+            writer.Key("dur");
+            writer.Int64(toTraceMicroseconds(event.time, previous->second->time));
+            writer.Key("pid");
+            writer.Int(CHROME_TRACE_PID);
+            writer.Key("tid");
+            writer.Int(row->second);
+            writer.EndObject();
+        }
+        previousEvents[event.dialogRequestId] = &event;
+
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name.str().c_str());
+        writer.Key("ph");
+        writer.String("i");
+        writer.Key("s");
+        writer.String("t");
+        writer.Key("ts");
+        writer.Int64(toTraceMicroseconds(event.time, origin));
+        writer.Key("pid");
+        writer.Int(CHROME_TRACE_PID);
+        writer.Key("tid");
+        writer.Int(row->second);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("dialogRequestId");
+        writer.String(event.dialogRequestId.c_str());
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    stream << buffer.GetString();
+    return static_cast<bool>(stream);
+}
+
+bool LatencyTrace::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        ACSDK_ERROR(LX("writeChromeTraceFailed").d("reason", "openFailed").d("path", path));
+        return false;
+    }
+    if (!writeChromeTrace(file)) {
+        ACSDK_ERROR(LX("writeChromeTraceFailed").d("reason", "writeFailed").d("path", path));
+        return false;
+    }
+    return true;
+}
+
+const std::vector<std::chrono::milliseconds>& LatencyTrace::getBucketBounds() {
+    static const std::vector<std::chrono::milliseconds> bounds = {std::chrono::milliseconds(50),
+                                                                  std::chrono::milliseconds(100),
+                                                                  std::chrono::milliseconds(200),
+                                                                  std::chrono::milliseconds(300),
+                                                                  std::chrono::milliseconds(500),
+                                                                  std::chrono::milliseconds(750),
+                                                                  std::chrono::milliseconds(1000),
+                                                                  std::chrono::milliseconds(1500),
+                                                                  std::chrono::milliseconds(2000),
+                                                                  std::chrono::milliseconds(3000),
+                                                                  std::chrono::milliseconds(5000)};
+    return bounds;
+}
+
+size_t LatencyTrace::roundUpCapacity(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+std::ostream& operator<<(std::ostream& stream, LatencyTrace::Point point) {
+    switch (point) {
+        case LatencyTrace::Point::END_OF_SPEECH:
+            return stream << "END_OF_SPEECH";
+        case LatencyTrace::Point::DIRECTIVE_RECEIVED:
+            return stream << "DIRECTIVE_RECEIVED";
+        case LatencyTrace::Point::DIRECTIVE_DISPATCHED:
+            return stream << "DIRECTIVE_DISPATCHED";
+        case LatencyTrace::Point::SPEAK_HANDLED:
+            return stream << "SPEAK_HANDLED";
+        case LatencyTrace::Point::SET_SOURCE:
+            return stream << "SET_SOURCE";
+        case LatencyTrace::Point::FIRST_BUFFER_RENDERED:
+            return stream << "FIRST_BUFFER_RENDERED";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+using namespace alexaClientSDK::avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("CurlShareHandleWrapper");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<CurlShareHandleWrapper> CurlShareHandleWrapper::create() {
+    auto handle = curl_share_init();
+    if (!handle) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "curlShareInitFailed"));
+        return nullptr;
+    }
+    auto wrapper = std::shared_ptr<CurlShareHandleWrapper>(new CurlShareHandleWrapper(handle));
+    if (!wrapper->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initFailed"));
+        return nullptr;
+    }
+    return wrapper;
+}
+
+CurlShareHandleWrapper::~CurlShareHandleWrapper() {
+    auto result = curl_share_cleanup(m_handle);
+    if (result != CURLSHE_OK) {
+        // This happens if a libcurl handle still uses the share handle, in which case it must be leaked.
+        ACSDK_ERROR(LX("shareHandleLeaked").d("error", curl_share_strerror(result)));
+    }
+    m_handle = nullptr;
+}
+
+CURLSH* CurlShareHandleWrapper::getCurlHandle() {
+    return m_handle;
+}
+
+bool CurlShareHandleWrapper::isSharing(curl_lock_data data) const {
+    return data >= 0 && data < CURL_LOCK_DATA_LAST && m_isSharing[data];
+}
+
+CurlShareHandleWrapper::CurlShareHandleWrapper(CURLSH* handle) : m_handle{handle}, m_isSharing() {
+}
+
+bool CurlShareHandleWrapper::init() {
+    if (curl_share_setopt(m_handle, CURLSHOPT_LOCKFUNC, lockCallback) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_UNLOCKFUNC, unlockCallback) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_USERDATA, this) != CURLSHE_OK) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "setLockCallbacksFailed"));
+        return false;
+    }
+
+    /*
+     * Sharing is only an optimization, so carry on with whatever kinds of data this libcurl is able to share.  The
+     * connection cache is deliberately not shared: the fetchers run their transfers on threads of their own, and
+     * libcurl does not support a shared connection cache being used by concurrent transfers, even with locking.
+     */
+    const curl_lock_data sharedData[] = {CURL_LOCK_DATA_DNS, CURL_LOCK_DATA_SSL_SESSION};
+    for (auto data : sharedData) {
+        auto result = curl_share_setopt(m_handle, CURLSHOPT_SHARE, data);
+        if (result != CURLSHE_OK) {
+            ACSDK_WARN(LX("shareDataFailed").d("data", data).d("error", curl_share_strerror(result)));
+            continue;
+        }
+        m_isSharing[data] = true;
+    }
+    return true;
+}
+
+void CurlShareHandleWrapper::lockCallback(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData) {
+    auto wrapper = static_cast<CurlShareHandleWrapper*>(userData);
+    if (!wrapper || data < 0 || data >= CURL_LOCK_DATA_LAST) {
+        return;
+    }
+    wrapper->m_mutexes[data].lock();
+}
+
+void CurlShareHandleWrapper::unlockCallback(CURL* handle, curl_lock_data data, void* userData) {
+    auto wrapper = static_cast<CurlShareHandleWrapper*>(userData);
+    if (!wrapper || data < 0 || data >= CURL_LOCK_DATA_LAST) {
+        return;
+    }
+    wrapper->m_mutexes[data].unlock();
+}
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,542 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "AVSCommon/Utils/LibcurlUtils/HTTPContentCache.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("HTTPContentCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The extension of the files holding cached entries.
+static const std::string ENTRY_FILE_EXTENSION(".entry");
+
+/// The extension of the files an entry is written to before it is moved into place.
+static const std::string TEMPORARY_FILE_EXTENSION(".tmp");
+
+/// The value at the start of every entry file, which also identifies the version of the file format.
+static const char FILE_MAGIC[8] = {'A', 'C', 'S', 'D', 'K', 'H', 'C', '1'};
+
+/// The number of variable length strings following the header of an entry file.
+static const int NUM_STRINGS = 4;
+
+/// The length of the longest string stored in an entry file, which guards against reading damaged lengths.
+static const uint32_t MAX_STRING_LENGTH = 0x10000;
+
+/// The header of an entry file. It is followed by the URL, content type, ETag and Last-Modified strings, then the body.
+struct FileHeader {
+    /// @c FILE_MAGIC.
+    char magic[sizeof(FILE_MAGIC)];
+
+    /// The expiry time of the entry, in seconds since the epoch.
+    int64_t expiry;
+
+    /// The size of the body in bytes.
+    uint64_t bodySize;
+
+    /// The checksum of the body.
+    uint64_t bodyChecksum;
+
+    /// The lengths of the strings following the header.
+    uint32_t stringLengths[NUM_STRINGS];
+};
+
+/// The offset of the expiry time in an entry file, which is rewritten when an entry is refreshed.
+static const off_t EXPIRY_OFFSET = offsetof(FileHeader, expiry);
+
+/**
+ * Computes the 64-bit FNV-1a hash of some data.
+ *
+ * @param data The data.
+ * @param size The size of the data in bytes.
+ * @return The hash.
+ */
+static uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Converts a time to seconds since the epoch.
+ *
+ * @param time The time.
+ * @return The number of seconds.
+ */
+static int64_t toSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * Checks whether a string ends with a suffix.
+ *
+ * @param string The string.
+ * @param suffix The suffix.
+ * @return Whether @c string ends with @c suffix.
+ */
+static bool endsWith(const std::string& string, const std::string& suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Parses the header and strings of an entry file.
+ *
+ * @param data The start of the file. At least @c sizeof(FileHeader) bytes must be readable.
+ * @param availableSize The number of bytes readable at @c data.
+ * @param fileSize The size of the file.
+ * @param[out] header The header.
+ * @param[out] metadata The metadata, or @c nullptr to skip parsing the strings.
+ * @param[out] dataOffset The offset of the body in the file.
+ * @return Whether the header is consistent with the size of the file.
+ */
+static bool parseHeader(
+    const char* data,
+    size_t availableSize,
+    uint64_t fileSize,
+    FileHeader* header,
+    HTTPContentCache::Metadata* metadata,
+    size_t* dataOffset) {
+    if (availableSize < sizeof(FileHeader) || fileSize < sizeof(FileHeader)) {
+        return false;
+    }
+    memcpy(header, data, sizeof(FileHeader));
+    if (memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        return false;
+    }
+    uint64_t offset = sizeof(FileHeader);
+    for (int i = 0; i < NUM_STRINGS; ++i) {
+        if (header->stringLengths[i] > MAX_STRING_LENGTH) {
+            return false;
+        }
+        offset += header->stringLengths[i];
+    }
+    if (fileSize != offset + header->bodySize) {
+        return false;
+    }
+    *dataOffset = static_cast<size_t>(offset);
+    if (!metadata) {
+        return true;
+    }
+    if (availableSize < offset) {
+        return false;
+    }
+    std::string* strings[NUM_STRINGS] = {
+        &metadata->url, &metadata->contentType, &metadata->eTag, &metadata->lastModified};
+    offset = sizeof(FileHeader);
+    for (int i = 0; i < NUM_STRINGS; ++i) {
+        strings[i]->assign(data + offset, header->stringLengths[i]);
+        offset += header->stringLengths[i];
+    }
+    metadata->expiry = std::chrono::system_clock::time_point(std::chrono::seconds(header->expiry));
+    return true;
+}
+
+/**
+ * Writes all of a buffer to a file.
+ *
+ * @param fd The file.
+ * @param data The buffer.
+ * @param size The size of the buffer.
+ * @return Whether the whole buffer was written.
+ */
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto bytesWritten = write(fd, data, size);
+        if (bytesWritten < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        data += bytesWritten;
+        size -= bytesWritten;
+    }
+    return true;
+}
+
+HTTPContentCache::Metadata::Metadata() : expiry{std::chrono::system_clock::time_point::min()} {
+}
+
+HTTPContentCache::Entry::Entry(Metadata metadata, void* mapping, size_t mappingSize, size_t dataOffset) :
+        m_metadata{std::move(metadata)},
+        m_mapping{mapping},
+        m_mappingSize{mappingSize},
+        m_dataOffset{dataOffset} {
+}
+
+HTTPContentCache::Entry::~Entry() {
+    munmap(m_mapping, m_mappingSize);
+}
+
+const HTTPContentCache::Metadata& HTTPContentCache::Entry::getMetadata() const {
+    return m_metadata;
+}
+
+const char* HTTPContentCache::Entry::getData() const {
+    return static_cast<const char*>(m_mapping) + m_dataOffset;
+}
+
+size_t HTTPContentCache::Entry::getSize() const {
+    return m_mappingSize - m_dataOffset;
+}
+
+bool HTTPContentCache::Entry::isFresh() const {
+    return std::chrono::system_clock::now() < m_metadata.expiry;
+}
+
+bool HTTPContentCache::Entry::hasValidators() const {
+    return !m_metadata.eTag.empty() || !m_metadata.lastModified.empty();
+}
+
+HTTPContentCache::Statistics::Statistics() :
+        numHits{0},
+        numMisses{0},
+        numRevalidations{0},
+        numStores{0},
+        numEvictions{0},
+        numCorruptEntries{0},
+        sizeInBytes{0},
+        hitStartLatency{0},
+        missStartLatency{0} {
+}
+
+std::shared_ptr<HTTPContentCache> HTTPContentCache::create(
+    const std::string& directory,
+    uint64_t maxSizeInBytes,
+    uint64_t maxEntrySizeInBytes) {
+    if (directory.empty() || 0 == maxSizeInBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidParameter").d("maxSizeInBytes", maxSizeInBytes));
+        return nullptr;
+    }
+    if (0 == maxEntrySizeInBytes) {
+        maxEntrySizeInBytes = maxSizeInBytes / 8;
+    }
+    if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "mkdirFailed").d("directory", directory).d("errno", errno));
+        return nullptr;
+    }
+    auto cache = std::shared_ptr<HTTPContentCache>(
+        new HTTPContentCache(directory, maxSizeInBytes, std::min(maxEntrySizeInBytes, maxSizeInBytes)));
+    if (!cache->loadIndex()) {
+        return nullptr;
+    }
+    return cache;
+}
+
+HTTPContentCache::HTTPContentCache(
+    const std::string& directory,
+    uint64_t maxSizeInBytes,
+    uint64_t maxEntrySizeInBytes) :
+        m_directory{directory},
+        m_maxSizeInBytes{maxSizeInBytes},
+        m_maxEntrySizeInBytes{maxEntrySizeInBytes},
+        m_nextTemporaryFileId{0} {
+}
+
+bool HTTPContentCache::loadIndex() {
+    DIR* dir = opendir(m_directory.c_str());
+    if (!dir) {
+        ACSDK_ERROR(LX("loadIndexFailed").d("reason", "opendirFailed").d("directory", m_directory).d("errno", errno));
+        return false;
+    }
+    // The modification time in seconds, name and size of each entry file.
+    std::vector<std::tuple<int64_t, std::string, uint64_t>> files;
+    uint64_t numCorruptEntries = 0;
+    while (auto dirEntry = readdir(dir)) {
+        std::string fileName = dirEntry->d_name;
+        auto path = getPath(fileName);
+        if (endsWith(fileName, TEMPORARY_FILE_EXTENSION)) {
+            // Left behind by an interrupted store.
+            unlink(path.c_str());
+            continue;
+        }
+        if (!endsWith(fileName, ENTRY_FILE_EXTENSION)) {
+            continue;
+        }
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        struct stat fileStatus;
+        char buffer[sizeof(FileHeader)];
+        FileHeader header;
+        size_t dataOffset = 0;
+        bool valid = fstat(fd, &fileStatus) == 0 && pread(fd, buffer, sizeof(buffer), 0) == sizeof(buffer) &&
+                     parseHeader(buffer, sizeof(buffer), fileStatus.st_size, &header, nullptr, &dataOffset);
+        close(fd);
+        if (!valid) {
+            ACSDK_WARN(LX("loadIndex").d("reason", "corruptEntry").d("file", fileName));
+            unlink(path.c_str());
+            ++numCorruptEntries;
+            continue;
+        }
+        // Only whole seconds are portable, so entries used within the same second may swap places across a restart.
+        files.emplace_back(static_cast<int64_t>(fileStatus.st_mtime), fileName, fileStatus.st_size);
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.numCorruptEntries += numCorruptEntries;
+    for (auto& file : files) {
+        addToIndexLocked(std::get<1>(file), std::get<2>(file));
+    }
+    evictLocked();
+    ACSDK_DEBUG(LX("loadIndex").d("numEntries", m_index.size()).d("sizeInBytes", m_statistics.sizeInBytes));
+    return true;
+}
+
+std::unique_ptr<HTTPContentCache::Entry> HTTPContentCache::get(const std::string& url) {
+    auto fileName = getFileName(url);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_index.find(fileName) == m_index.end()) {
+            return nullptr;
+        }
+    }
+
+    // Map and verify the file outside of the lock, since checksumming a large body takes a while.
+    auto path = getPath(fileName);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        removeLocked(fileName);
+        return nullptr;
+    }
+    struct stat fileStatus;
+    void* mapping = MAP_FAILED;
+    bool hasStatus = fstat(fd, &fileStatus) == 0;
+    if (hasStatus && fileStatus.st_size > 0) {
+        mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    Metadata metadata;
+    FileHeader header;
+    size_t dataOffset = 0;
+    bool valid = false;
+    if (mapping != MAP_FAILED) {
+        auto data = static_cast<const char*>(mapping);
+        size_t size = static_cast<size_t>(fileStatus.st_size);
+        valid = parseHeader(data, size, size, &header, &metadata, &dataOffset) &&
+                fnv1a(data + dataOffset, header.bodySize) == header.bodyChecksum;
+    }
+    if (valid && metadata.url != url) {
+        // Another URL with the same hash owns the file, so this is a miss rather than a damaged entry.
+        ACSDK_DEBUG9(LX("getMissed").d("reason", "urlMismatch").d("file", fileName));
+        munmap(mapping, fileStatus.st_size);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!valid) {
+        if (mapping != MAP_FAILED) {
+            munmap(mapping, fileStatus.st_size);
+        }
+        /*
+         * Only drop the file if it is still the one which was read. A concurrent put() may have moved a new file into
+         * place since, which must not be removed.
+         */
+        struct stat currentStatus;
+        if (!hasStatus || stat(path.c_str(), &currentStatus) != 0 || currentStatus.st_dev != fileStatus.st_dev ||
+            currentStatus.st_ino != fileStatus.st_ino) {
+            return nullptr;
+        }
+        ACSDK_WARN(LX("getFailed").d("reason", "corruptEntry").d("file", fileName));
+        removeLocked(fileName);
+        ++m_statistics.numCorruptEntries;
+        return nullptr;
+    }
+    auto it = m_index.find(fileName);
+    if (it != m_index.end()) {
+        m_recency.splice(m_recency.end(), m_recency, it->second.recency);
+        // Persist the recency of the entry across restarts.
+        utimes(path.c_str(), nullptr);
+    }
+    return std::unique_ptr<Entry>(new Entry(std::move(metadata), mapping, fileStatus.st_size, dataOffset));
+}
+
+bool HTTPContentCache::put(const Metadata& metadata, const std::string& body) {
+    if (body.size() > m_maxEntrySizeInBytes) {
+        ACSDK_DEBUG9(LX("putSkipped").d("reason", "entryTooLarge").d("size", body.size()));
+        return false;
+    }
+    const std::string* strings[NUM_STRINGS] = {
+        &metadata.url, &metadata.contentType, &metadata.eTag, &metadata.lastModified};
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.expiry = toSeconds(metadata.expiry);
+    header.bodySize = body.size();
+    header.bodyChecksum = fnv1a(body.data(), body.size());
+    std::string headerAndStrings(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (int i = 0; i < NUM_STRINGS; ++i) {
+        if (strings[i]->size() > MAX_STRING_LENGTH) {
+            ACSDK_ERROR(LX("putFailed").d("reason", "headerTooLong"));
+            return false;
+        }
+        header.stringLengths[i] = static_cast<uint32_t>(strings[i]->size());
+        headerAndStrings += *strings[i];
+    }
+    memcpy(&headerAndStrings[0], &header, sizeof(header));
+
+    auto fileName = getFileName(metadata.url);
+    std::string temporaryPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        temporaryPath = getPath(fileName + "." + std::to_string(m_nextTemporaryFileId++) + TEMPORARY_FILE_EXTENSION);
+    }
+    // Write the entry to a temporary file and move it into place, so that no one ever maps a partly written entry.
+    int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        ACSDK_ERROR(LX("putFailed").d("reason", "openFailed").d("errno", errno));
+        return false;
+    }
+    bool written =
+        writeAll(fd, headerAndStrings.data(), headerAndStrings.size()) && writeAll(fd, body.data(), body.size());
+    if (close(fd) != 0 || !written || rename(temporaryPath.c_str(), getPath(fileName).c_str()) != 0) {
+        ACSDK_ERROR(LX("putFailed").d("reason", "writeFailed").d("errno", errno));
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    addToIndexLocked(fileName, headerAndStrings.size() + body.size());
+    ++m_statistics.numStores;
+    evictLocked();
+    return true;
+}
+
+bool HTTPContentCache::refresh(const std::string& url, std::chrono::system_clock::time_point expiry) {
+    auto fileName = getFileName(url);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_index.find(fileName) == m_index.end()) {
+        return false;
+    }
+    int fd = open(getPath(fileName).c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    int64_t expirySeconds = toSeconds(expiry);
+    bool written = pwrite(fd, &expirySeconds, sizeof(expirySeconds), EXPIRY_OFFSET) == sizeof(expirySeconds);
+    close(fd);
+    return written;
+}
+
+void HTTPContentCache::remove(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeLocked(getFileName(url));
+}
+
+uint64_t HTTPContentCache::getMaxEntrySize() const {
+    return m_maxEntrySizeInBytes;
+}
+
+void HTTPContentCache::recordHit(std::chrono::microseconds startLatency, bool revalidated) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_statistics.numHits;
+    if (revalidated) {
+        ++m_statistics.numRevalidations;
+    }
+    m_statistics.hitStartLatency += startLatency;
+}
+
+void HTTPContentCache::recordMiss(std::chrono::microseconds startLatency) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_statistics.numMisses;
+    m_statistics.missStartLatency += startLatency;
+}
+
+HTTPContentCache::Statistics HTTPContentCache::getStatistics() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+std::string HTTPContentCache::getFileName(const std::string& url) {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << fnv1a(url.data(), url.size()) << ENTRY_FILE_EXTENSION;
+    return stream.str();
+}
+
+std::string HTTPContentCache::getPath(const std::string& fileName) const {
+    return m_directory + "/" + fileName;
+}
+
+void HTTPContentCache::addToIndexLocked(const std::string& fileName, uint64_t sizeInBytes) {
+    auto it = m_index.find(fileName);
+    if (it != m_index.end()) {
+        m_statistics.sizeInBytes -= it->second.sizeInBytes;
+        m_recency.erase(it->second.recency);
+        m_index.erase(it);
+    }
+    m_index[fileName] = {sizeInBytes, m_recency.insert(m_recency.end(), fileName)};
+    m_statistics.sizeInBytes += sizeInBytes;
+}
+
+void HTTPContentCache::removeLocked(const std::string& fileName) {
+    auto it = m_index.find(fileName);
+    if (it == m_index.end()) {
+        return;
+    }
+    m_statistics.sizeInBytes -= it->second.sizeInBytes;
+    m_recency.erase(it->second.recency);
+    m_index.erase(it);
+    unlink(getPath(fileName).c_str());
+}
+
+void HTTPContentCache::evictLocked() {
+    while (m_statistics.sizeInBytes > m_maxSizeInBytes && !m_recency.empty()) {
+        // Copy the name, since removeLocked() erases the list node holding it.
+        auto fileName = m_recency.front();
+        ACSDK_DEBUG9(LX("evict").d("file", fileName));
+        removeLocked(fileName);
+        ++m_statistics.numEvictions;
+    }
+}
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
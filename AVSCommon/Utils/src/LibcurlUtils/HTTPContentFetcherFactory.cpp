@@ -22,9 +22,14 @@ namespace avsCommon {
 namespace utils {
 namespace libcurlUtils {
 
+HTTPContentFetcherFactory::HTTPContentFetcherFactory(std::shared_ptr<HTTPContentCache> cache) :
+        m_shareHandle{CurlShareHandleWrapper::create()},
+        m_cache{cache} {
+}
+
 std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> HTTPContentFetcherFactory::create(
     const std::string& url) {
-    return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(url);
+    return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(url, m_shareHandle, m_cache);
 }
 
 }  // namespace libcurlUtils
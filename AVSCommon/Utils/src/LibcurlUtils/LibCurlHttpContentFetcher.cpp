@@ -14,6 +14,8 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 #include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
 #include <AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h>
@@ -41,12 +43,76 @@ static const std::chrono::milliseconds TIMEOUT_FOR_BLOCKING_WRITE = std::chrono:
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The HTTP status code of a successful response.
+static const long HTTP_OK = 200;
+
+/// The HTTP status code of a response to a conditional request whose cached response is still valid.
+static const long HTTP_NOT_MODIFIED = 304;
+
+/// The longest time a response without an explicit expiry time is considered fresh for.
+static const std::chrono::hours MAX_HEURISTIC_FRESHNESS(24);
+
+/**
+ * A response without an explicit expiry time is considered fresh for this fraction of the time since it was last
+ * modified, as suggested by RFC 7234.
+ */
+static const int HEURISTIC_FRESHNESS_DIVISOR = 10;
+
+/// The part of the content types of M3U and HLS playlists, such as "application/vnd.apple.mpegurl".
+static const std::string PLAYLIST_CONTENT_TYPE = "mpegurl";
+
+/// The extensions of the paths of M3U and HLS playlists.
+static const std::vector<std::string> PLAYLIST_EXTENSIONS = {".m3u8", ".m3u"};
+
+/**
+ * Checks whether a response is a playlist, which a live stream keeps changing whatever its @c Last-Modified header
+ * suggests.
+ *
+ * @param url The URL of the response.
+ * @param contentType The content type of the response, in lower case, or an empty string if it is unknown.
+ * @return Whether the response is a playlist.
+ */
+static bool isPlaylist(const std::string& url, const std::string& contentType) {
+    if (contentType.find(PLAYLIST_CONTENT_TYPE) != std::string::npos) {
+        return true;
+    }
+    auto path = url.substr(0, url.find_first_of("?#"));
+    std::transform(path.begin(), path.end(), path.begin(), ::tolower);
+    for (auto& extension : PLAYLIST_EXTENSIONS) {
+        if (path.size() >= extension.size() &&
+            path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Gets the value of a header line, without surrounding whitespace.
+ *
+ * @param line The header line, such as "ETag: "abc"\r\n".
+ * @return The value of the header.
+ */
+static std::string getHeaderValue(const std::string& line) {
+    auto separator = line.find(':');
+    if (separator == std::string::npos) {
+        return "";
+    }
+    auto begin = line.find_first_not_of(" \t", separator + 1);
+    auto end = line.find_last_not_of(" \t\r\n");
+    if (begin == std::string::npos || end == std::string::npos || end < begin) {
+        return "";
+    }
+    return line.substr(begin, end - begin + 1);
+}
+
 size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t nmemb, void* userData) {
     if (!userData) {
         ACSDK_ERROR(LX("headerCallback").d("reason", "nullUserDataPointer"));
         return 0;
     }
-    std::string line(static_cast<const char*>(data), size * nmemb);
+    std::string originalLine(static_cast<const char*>(data), size * nmemb);
+    std::string line = originalLine;
     std::transform(line.begin(), line.end(), line.begin(), ::tolower);
     if (line.find("http") == 0) {
         // To find lines like: "HTTP/1.1 200 OK"
@@ -56,6 +122,17 @@ size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t
         iss >> httpVersion >> statusCode;
         LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
         thisObject->m_lastStatusCode = statusCode;
+        // A new response begins, such as after a redirect, so forget the headers of the previous one.
+        thisObject->m_lastETag.clear();
+        thisObject->m_lastLastModified.clear();
+        thisObject->m_lastCacheControl.clear();
+    } else if (line.find("etag:") == 0) {
+        // Validators are compared byte for byte, so keep their original case.
+        static_cast<LibCurlHttpContentFetcher*>(userData)->m_lastETag = getHeaderValue(originalLine);
+    } else if (line.find("last-modified:") == 0) {
+        static_cast<LibCurlHttpContentFetcher*>(userData)->m_lastLastModified = getHeaderValue(originalLine);
+    } else if (line.find("cache-control:") == 0) {
+        static_cast<LibCurlHttpContentFetcher*>(userData)->m_lastCacheControl = getHeaderValue(line);
     } else if (line.find("content-type") == 0) {
         // To find lines like: "Content-Type: audio/x-mpegurl; charset=utf-8"
         std::istringstream iss(line);
@@ -79,23 +156,46 @@ size_t LibCurlHttpContentFetcher::bodyCallback(char* data, size_t size, size_t n
         ACSDK_ERROR(LX("bodyCallback").d("reason", "nullUserDataPointer"));
         return 0;
     }
-    LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
-    if (thisObject->m_done) {
+    return static_cast<LibCurlHttpContentFetcher*>(userData)->writeBody(data, size * nmemb);
+}
+
+void LibCurlHttpContentFetcher::satisfyPromises() {
+    if (m_bodyCallbackBegan) {
+        return;
+    }
+    m_bodyCallbackBegan = true;
+    m_startLatency =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime);
+    m_statusCodePromise.set_value(m_lastStatusCode);
+    m_contentTypePromise.set_value(m_lastContentType);
+    if (m_cacheBody && !isCacheable()) {
+        // The headers are complete, so don't keep a copy of a body which will not be stored.
+        m_cacheBody = false;
+    }
+}
+
+size_t LibCurlHttpContentFetcher::writeBody(const char* data, size_t numBytes) {
+    if (m_done) {
         // In order to properly quit when downloading live content, which block forever when performing a GET request
         return 0;
     }
-    if (!thisObject->m_bodyCallbackBegan) {
-        thisObject->m_bodyCallbackBegan = true;
-        thisObject->m_statusCodePromise.set_value(thisObject->m_lastStatusCode);
-        thisObject->m_contentTypePromise.set_value(thisObject->m_lastContentType);
+    satisfyPromises();
+    if (m_cacheBody) {
+        if (m_body.size() + numBytes > m_cache->getMaxEntrySize()) {
+            // Too large to cache, so stop keeping a copy.
+            m_cacheBody = false;
+            std::string().swap(m_body);
+        } else {
+            m_body.append(data, numBytes);
+        }
     }
-    auto streamWriter = thisObject->m_streamWriter;
+    auto streamWriter = m_streamWriter;
     size_t totalBytesWritten = 0;
 
     if (streamWriter) {
-        size_t targetNumBytes = size * nmemb;
+        size_t targetNumBytes = numBytes;
 
-        while (totalBytesWritten < targetNumBytes && !thisObject->m_done) {
+        while (totalBytesWritten < targetNumBytes && !m_done) {
             avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus =
                 avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
 
@@ -127,15 +227,107 @@ size_t LibCurlHttpContentFetcher::bodyCallback(char* data, size_t size, size_t n
     return totalBytesWritten;
 }
 
+void LibCurlHttpContentFetcher::writeCachedEntry(bool revalidated) {
+    ACSDK_DEBUG9(LX("writeCachedEntry").sensitive("url", m_url).d("revalidated", revalidated));
+    m_cacheBody = false;
+    m_lastStatusCode = HTTP_OK;
+    m_lastContentType = m_cachedEntry->getMetadata().contentType;
+    satisfyPromises();
+    m_cache->recordHit(m_startLatency, revalidated);
+    writeBody(m_cachedEntry->getData(), m_cachedEntry->getSize());
+}
+
+void LibCurlHttpContentFetcher::storeInCache(CURLcode curlReturnValue) {
+    if (!m_useCache || m_lastStatusCode != HTTP_OK || curlReturnValue != CURLE_OK || m_done) {
+        return;
+    }
+    m_cache->recordMiss(m_startLatency);
+    if (!m_cacheBody || !isCacheable()) {
+        return;
+    }
+    HTTPContentCache::Metadata metadata;
+    metadata.url = m_url;
+    metadata.contentType = m_lastContentType;
+    metadata.eTag = m_lastETag;
+    metadata.lastModified = m_lastLastModified;
+    metadata.expiry = getExpiry();
+    m_cache->put(metadata, m_body);
+}
+
+bool LibCurlHttpContentFetcher::isCacheable() {
+    if (m_lastStatusCode != HTTP_OK || m_lastCacheControl.find("no-store") != std::string::npos) {
+        return false;
+    }
+    // A response which is already stale and cannot be revalidated would never be used.
+    return !m_lastETag.empty() || !m_lastLastModified.empty() || getExpiry() > std::chrono::system_clock::now();
+}
+
+std::chrono::system_clock::time_point LibCurlHttpContentFetcher::getExpiry() {
+    auto now = std::chrono::system_clock::now();
+    if (m_lastCacheControl.find("no-cache") != std::string::npos) {
+        return now;
+    }
+    auto maxAge = m_lastCacheControl.find("max-age=");
+    if (maxAge != std::string::npos) {
+        return now + std::chrono::seconds(std::strtol(m_lastCacheControl.c_str() + maxAge + 8, nullptr, 10));
+    }
+    /*
+     * Without an explicit expiry time, a response is considered fresh for a while after it was last modified only if
+     * it carries a Last-Modified validator to revalidate it with afterwards, and is not a playlist.
+     */
+    auto contentType = m_lastContentType;
+    if (contentType.empty() && m_cachedEntry) {
+        // A 304 (Not Modified) response need not repeat the content type of the cached response.
+        contentType = m_cachedEntry->getMetadata().contentType;
+    }
+    if (!m_lastLastModified.empty() && !isPlaylist(m_url, contentType)) {
+        auto lastModified = curl_getdate(m_lastLastModified.c_str(), nullptr);
+        auto age = std::chrono::seconds(std::chrono::system_clock::to_time_t(now) - lastModified);
+        if (lastModified > 0 && age.count() > 0) {
+            return now + std::min<std::chrono::seconds>(age / HEURISTIC_FRESHNESS_DIVISOR, MAX_HEURISTIC_FRESHNESS);
+        }
+    }
+    return now;
+}
+
 size_t LibCurlHttpContentFetcher::noopCallback(char* data, size_t size, size_t nmemb, void* userData) {
     return 0;
 }
 
-LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(const std::string& url) :
+/**
+ * Convert a time reported by libcurl in seconds to microseconds.
+ *
+ * @param seconds The time in seconds.
+ * @return The time in microseconds.
+ */
+static std::chrono::microseconds toMicroseconds(double seconds) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(seconds));
+}
+
+LibCurlHttpContentFetcher::Timings::Timings() :
+        nameLookup{0},
+        connect{0},
+        tlsHandshake{0},
+        firstByte{0},
+        total{0},
+        connectionReused{false} {
+}
+
+LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(
+    const std::string& url,
+    std::shared_ptr<CurlShareHandleWrapper> shareHandle,
+    std::shared_ptr<HTTPContentCache> cache) :
         m_url{url},
+        m_shareHandle{shareHandle},
+        m_hasTimings{false},
         m_bodyCallbackBegan{false},
         m_lastStatusCode{0},
-        m_done{false} {
+        m_cache{cache},
+        m_useCache{false},
+        m_cacheBody{false},
+        m_startLatency{0},
+        m_done{false},
+        m_writerWasCreatedLocally{false} {
     m_hasObjectBeenUsed.clear();
 }
 
@@ -145,6 +337,7 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
     if (m_hasObjectBeenUsed.test_and_set()) {
         return nullptr;
     }
+    m_startTime = std::chrono::steady_clock::now();
     if (!m_curlWrapper.setURL(m_url)) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetUrl"));
         return nullptr;
@@ -165,14 +358,15 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
         ACSDK_ERROR(LX("getContentFailed").d("reason", "enableLibCurlCookieEngineFailed"));
         return nullptr;
     }
+    if (m_shareHandle && !m_curlWrapper.setopt(CURLOPT_SHARE, m_shareHandle->getCurlHandle())) {
+        // The fetch still works without the shared caches, it is just slower.
+        ACSDK_WARN(LX("getContent").d("reason", "setShareHandleFailed"));
+    }
     auto httpStatusCodeFuture = m_statusCodePromise.get_future();
     auto contentTypeFuture = m_contentTypePromise.get_future();
 
     std::shared_ptr<avsCommon::avs::attachment::InProcessAttachment> stream = nullptr;
 
-    // This flag will remain false if the caller of getContent() passed in their own writer.
-    bool writerWasCreatedLocally = false;
-
     switch (fetchOption) {
         case FetchOptions::CONTENT_TYPE:
             /*
@@ -192,6 +386,7 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 if (curlReturnValue != CURLE_OK && curlReturnValue != CURLE_WRITE_ERROR) {
                     ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
                 }
+                recordTimings();
                 curlReturnValue =
                     curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_RESPONSE_CODE, &finalResponseCode);
                 if (curlReturnValue != CURLE_OK) {
@@ -215,7 +410,7 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 // Using the url as the identifier for the attachment
                 stream = std::make_shared<avsCommon::avs::attachment::InProcessAttachment>(m_url);
                 writer = stream->createWriter(sds::WriterPolicy::BLOCKING);
-                writerWasCreatedLocally = true;
+                m_writerWasCreatedLocally = true;
             }
 
             m_streamWriter = writer;
@@ -224,6 +419,33 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToCreateWriter"));
                 return nullptr;
             }
+            if (m_cache) {
+                m_useCache = true;
+                m_cachedEntry = m_cache->get(m_url);
+                if (m_cachedEntry && m_cachedEntry->isFresh()) {
+                    m_thread = std::thread([this]() {
+                        writeCachedEntry(false);
+                        if (m_writerWasCreatedLocally) {
+                            m_streamWriter->close();
+                        }
+                        m_done = true;
+                    });
+                    break;
+                }
+                if (m_cachedEntry && m_cachedEntry->hasValidators()) {
+                    // Ask the server to answer with 304 (Not Modified) rather than the body if the entry is valid.
+                    auto& metadata = m_cachedEntry->getMetadata();
+                    if ((!metadata.eTag.empty() && !m_curlWrapper.addHTTPHeader("If-None-Match: " + metadata.eTag)) ||
+                        (!metadata.lastModified.empty() &&
+                         !m_curlWrapper.addHTTPHeader("If-Modified-Since: " + metadata.lastModified))) {
+                        ACSDK_WARN(LX("getContent").d("reason", "addConditionalHeaderFailed"));
+                        m_cachedEntry.reset();
+                    }
+                } else {
+                    m_cachedEntry.reset();
+                }
+                m_cacheBody = true;
+            }
             if (!m_curlWrapper.setWriteCallback(bodyCallback, this)) {
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlBodyCallback"));
                 return nullptr;
@@ -232,19 +454,24 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlHeaderCallback"));
                 return nullptr;
             }
-            m_thread = std::thread([this, writerWasCreatedLocally]() {
+            m_thread = std::thread([this]() {
                 auto curlReturnValue = curl_easy_perform(m_curlWrapper.getCurlHandle());
                 if (curlReturnValue != CURLE_OK) {
                     ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
                 }
-                if (!m_bodyCallbackBegan) {
-                    m_statusCodePromise.set_value(m_lastStatusCode);
-                    m_contentTypePromise.set_value(m_lastContentType);
+                recordTimings();
+                if (m_cachedEntry && HTTP_NOT_MODIFIED == m_lastStatusCode && !m_bodyCallbackBegan) {
+                    // The server confirmed that the cached response is still valid.
+                    m_cache->refresh(m_url, getExpiry());
+                    writeCachedEntry(true);
+                } else {
+                    satisfyPromises();
+                    storeInCache(curlReturnValue);
                 }
                 /*
                  * If the writer was created locally, its job is done and can be safely closed.
                  */
-                if (writerWasCreatedLocally) {
+                if (m_writerWasCreatedLocally) {
                     m_streamWriter->close();
                 }
 
@@ -264,7 +491,66 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
         avsCommon::utils::HTTPContent{std::move(httpStatusCodeFuture), std::move(contentTypeFuture), stream});
 }
 
+bool LibCurlHttpContentFetcher::getTimings(Timings* timings) {
+    if (!timings) {
+        ACSDK_ERROR(LX("getTimingsFailed").d("reason", "nullTimings"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    if (!m_hasTimings) {
+        return false;
+    }
+    *timings = m_timings;
+    return true;
+}
+
+void LibCurlHttpContentFetcher::recordTimings() {
+    auto handle = m_curlWrapper.getCurlHandle();
+    double nameLookup = 0;
+    double connect = 0;
+    double tlsHandshake = 0;
+    double firstByte = 0;
+    double total = 0;
+    long numConnects = 0;
+    if (curl_easy_getinfo(handle, CURLINFO_NAMELOOKUP_TIME, &nameLookup) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME, &connect) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME, &tlsHandshake) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &firstByte) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &total) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &numConnects) != CURLE_OK) {
+        ACSDK_ERROR(LX("recordTimingsFailed").d("reason", "curlEasyGetInfoFailed"));
+        return;
+    }
+
+    Timings timings;
+    timings.nameLookup = toMicroseconds(nameLookup);
+    timings.connect = toMicroseconds(connect);
+    timings.tlsHandshake = toMicroseconds(tlsHandshake);
+    timings.firstByte = toMicroseconds(firstByte);
+    timings.total = toMicroseconds(total);
+    timings.connectionReused = (0 == numConnects);
+    ACSDK_DEBUG(LX("fetchTimings")
+                    .sensitive("url", m_url)
+                    .d("nameLookupUs", timings.nameLookup.count())
+                    .d("connectUs", timings.connect.count())
+                    .d("tlsHandshakeUs", timings.tlsHandshake.count())
+                    .d("firstByteUs", timings.firstByte.count())
+                    .d("totalUs", timings.total.count())
+                    .d("connectionReused", timings.connectionReused));
+
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    m_timings = timings;
+    m_hasTimings = true;
+}
+
 LibCurlHttpContentFetcher::~LibCurlHttpContentFetcher() {
+    if (m_writerWasCreatedLocally) {
+        /*
+         * Nothing will be written to the stream once this object is gone, so stop the download instead of waiting for
+         * it to finish. This matters for live streams, which never finish on their own.
+         */
+        m_done = true;
+    }
     if (m_thread.joinable()) {
         m_thread.join();
     }
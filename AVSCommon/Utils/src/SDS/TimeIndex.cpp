@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/SDS/TimeIndex.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TimeIndex");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The fewest entries a table can hold, which is what it takes to interpolate.
+static const size_t MIN_CAPACITY = 2;
+
+/**
+ * Converts a time into nanoseconds since the epoch of the clock.
+ *
+ * @param time The time.
+ * @return The nanoseconds.
+ */
+static int64_t toNanoseconds(TimeIndex::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * Converts nanoseconds since the epoch of the clock into a time.
+ *
+ * @param nanoseconds The nanoseconds.
+ * @return The time.
+ */
+static TimeIndex::Clock::time_point toTimePoint(int64_t nanoseconds) {
+    return TimeIndex::Clock::time_point(
+        std::chrono::duration_cast<TimeIndex::Clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+}
+
+std::unique_ptr<TimeIndex> TimeIndex::create(size_t capacity) {
+    if (capacity < MIN_CAPACITY) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "capacityTooSmall").d("capacity", capacity));
+        return nullptr;
+    }
+    return std::unique_ptr<TimeIndex>(new TimeIndex(capacity));
+}
+
+void TimeIndex::record(Index index, Clock::time_point time) {
+    Entry entry = {toNanoseconds(time), index};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_size > 0) {
+        const Entry& newest = at(m_size - 1);
+        if (index <= newest.index) {
+            return;
+        }
+        entry.time = std::max(entry.time, newest.time);
+    }
+    if (m_size < m_entries.size()) {
+        m_entries[(m_oldest + m_size) % m_entries.size()] = entry;
+        ++m_size;
+    } else {
+        m_entries[m_oldest] = entry;
+        m_oldest = (m_oldest + 1) % m_entries.size();
+    }
+}
+
+bool TimeIndex::getIndex(Clock::time_point time, Index* index) const {
+    if (!index) {
+        ACSDK_ERROR(LX("getIndexFailed").d("reason", "nullIndex"));
+        return false;
+    }
+    int64_t target = toNanoseconds(time);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (0 == m_size || target < at(0).time) {
+        return false;
+    }
+
+    // Find the first entry at or after the time.
+    size_t low = 0;
+    size_t high = m_size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (at(middle).time < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < m_size && at(low).time == target) {
+        *index = at(low).index;
+        return true;
+    }
+
+    // Extrapolate from the newest entry at the pace of the whole table, which is steadier than the pace of the last
+    // write alone, since the time of each write is as late as the writer was scheduled.  This only holds until the
+    // next write is due: if the writer has stopped (for example while the microphone is off), the audio captured now
+    // will be written wherever the writer resumes, so a later time is not covered.
+    if (low == m_size) {
+        const Entry& oldest = at(0);
+        const Entry& newest = at(m_size - 1);
+        *index = newest.index;
+        if (newest.time > oldest.time) {
+            int64_t writeInterval = (newest.time - oldest.time) / static_cast<int64_t>(m_size - 1);
+            if (target - newest.time > writeInterval) {
+                return false;
+            }
+            double pace = static_cast<double>(newest.index - oldest.index) / (newest.time - oldest.time);
+            *index += static_cast<Index>(pace * (target - newest.time) + 0.5);
+        }
+        return true;
+    }
+
+    // Interpolate between the entries either side.
+    const Entry& before = at(low - 1);
+    const Entry& after = at(low);
+    double pace = static_cast<double>(after.index - before.index) / (after.time - before.time);
+    *index = before.index + static_cast<Index>(pace * (target - before.time) + 0.5);
+    return true;
+}
+
+bool TimeIndex::getTime(Index index, Clock::time_point* time) const {
+    if (!time) {
+        ACSDK_ERROR(LX("getTimeFailed").d("reason", "nullTime"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (0 == m_size || index < at(0).index || index > at(m_size - 1).index) {
+        return false;
+    }
+
+    // Find the first entry at or after the index, which exists since the index is not after the newest.
+    size_t low = 0;
+    size_t high = m_size - 1;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (at(middle).index < index) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    const Entry& after = at(low);
+    if (after.index == index) {
+        *time = toTimePoint(after.time);
+        return true;
+    }
+    const Entry& before = at(low - 1);
+    double fraction = static_cast<double>(index - before.index) / (after.index - before.index);
+    *time = toTimePoint(before.time + static_cast<int64_t>(fraction * (after.time - before.time) + 0.5));
+    return true;
+}
+
+size_t TimeIndex::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+size_t TimeIndex::getCapacity() const {
+    return m_entries.size();
+}
+
+TimeIndex::TimeIndex(size_t capacity) : m_entries(capacity), m_oldest{0}, m_size{0} {
+}
+
+const TimeIndex::Entry& TimeIndex::at(size_t position) const {
+    return m_entries[(m_oldest + position) % m_entries.size()];
+}
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
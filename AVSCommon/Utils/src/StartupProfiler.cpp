@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Timing/StartupProfiler.h"
+
+#include <sstream>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+StartupProfiler::StartupProfiler() : m_origin{Clock::now()}, m_lastMark{m_origin} {
+}
+
+void StartupProfiler::markStage(const std::string& name) {
+    auto now = Clock::now();
+    Clock::time_point start;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        start = m_lastMark;
+        m_lastMark = now;
+    }
+    addStage(name, start, now);
+}
+
+std::vector<StartupProfiler::Stage> StartupProfiler::getStages() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stages;
+}
+
+std::chrono::milliseconds StartupProfiler::getElapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_origin);
+}
+
+std::string StartupProfiler::getReport() const {
+    std::ostringstream report;
+    for (const auto& stage : getStages()) {
+        report << stage.name << ": start=" << stage.start.count() << "ms duration=" << stage.duration.count()
+               << "ms\n";
+    }
+    report << "total: " << getElapsed().count() << "ms";
+    return report.str();
+}
+
+void StartupProfiler::addStage(const std::string& name, Clock::time_point start, Clock::time_point end) {
+    Stage stage{name,
+                std::chrono::duration_cast<std::chrono::milliseconds>(start - m_origin),
+                std::chrono::duration_cast<std::chrono::milliseconds>(end - start)};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stages.push_back(stage);
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
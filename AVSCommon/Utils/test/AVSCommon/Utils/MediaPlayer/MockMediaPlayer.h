@@ -99,6 +99,7 @@ public:
     MOCK_METHOD1(stop, bool(SourceId));
     MOCK_METHOD1(getOffset, std::chrono::milliseconds(SourceId));
     MOCK_METHOD0(getNumBytesBuffered, uint64_t());
+    MOCK_METHOD2(prepareNextSource, bool(const std::string& url, std::chrono::milliseconds offset));
 
     /// @name RequiresShutdown overrides
     /// @{
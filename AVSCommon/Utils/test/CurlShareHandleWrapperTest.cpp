@@ -0,0 +1,49 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CurlShareHandleWrapperTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+/**
+ * Test that the DNS and TLS session caches are shared, and the connection cache, which cannot be used by transfers on
+ * several threads at once, is not.
+ */
+TEST(CurlShareHandleWrapperTest, testSharesDnsAndTlsSessionsButNotConnections) {
+    auto shareHandle = CurlShareHandleWrapper::create();
+    ASSERT_NE(shareHandle, nullptr);
+    EXPECT_NE(shareHandle->getCurlHandle(), nullptr);
+    EXPECT_TRUE(shareHandle->isSharing(CURL_LOCK_DATA_DNS));
+    EXPECT_TRUE(shareHandle->isSharing(CURL_LOCK_DATA_SSL_SESSION));
+    EXPECT_FALSE(shareHandle->isSharing(CURL_LOCK_DATA_COOKIE));
+#if LIBCURL_VERSION_NUM >= 0x073900
+    EXPECT_FALSE(shareHandle->isSharing(CURL_LOCK_DATA_CONNECT));
+#endif
+    EXPECT_FALSE(shareHandle->isSharing(CURL_LOCK_DATA_LAST));
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/LibcurlUtils/HTTPContentCache.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+/// The size of the bodies stored by the tests.
+static const size_t BODY_SIZE = 1000;
+
+/// A size budget which fits two entries with bodies of @c BODY_SIZE, but not three.
+static const uint64_t MAX_SIZE_IN_BYTES = BODY_SIZE * 3;
+
+/// The URLs of the responses stored by the tests.
+static const std::string URL_A = "https://example.com/a.mp3";
+static const std::string URL_B = "https://example.com/b.mp3";
+static const std::string URL_C = "https://example.com/c.mp3";
+
+/// How long the responses stored by the tests are fresh for.
+static const std::chrono::hours FRESHNESS_LIFETIME(1);
+
+class HTTPContentCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char directoryTemplate[] = "/tmp/HTTPContentCacheTestXXXXXX";
+        ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+        m_directory = directoryTemplate;
+    }
+
+    void TearDown() override {
+        for (auto& fileName : listFiles()) {
+            unlink((m_directory + "/" + fileName).c_str());
+        }
+        rmdir(m_directory.c_str());
+    }
+
+    /**
+     * Creates a cache in the test directory.
+     *
+     * @param maxSizeInBytes The size budget of the cache.
+     * @return The cache.
+     */
+    std::shared_ptr<HTTPContentCache> createCache(uint64_t maxSizeInBytes = MAX_SIZE_IN_BYTES) {
+        return HTTPContentCache::create(m_directory, maxSizeInBytes, BODY_SIZE);
+    }
+
+    /**
+     * Lists the files in the test directory.
+     *
+     * @return The names of the files.
+     */
+    std::vector<std::string> listFiles() {
+        std::vector<std::string> fileNames;
+        DIR* dir = opendir(m_directory.c_str());
+        if (!dir) {
+            return fileNames;
+        }
+        while (auto dirEntry = readdir(dir)) {
+            std::string fileName = dirEntry->d_name;
+            if (fileName != "." && fileName != "..") {
+                fileNames.push_back(fileName);
+            }
+        }
+        closedir(dir);
+        return fileNames;
+    }
+
+    /**
+     * Builds the metadata of a response which is fresh for @c FRESHNESS_LIFETIME.
+     *
+     * @param url The URL of the response.
+     * @return The metadata.
+     */
+    static HTTPContentCache::Metadata makeMetadata(const std::string& url) {
+        HTTPContentCache::Metadata metadata;
+        metadata.url = url;
+        metadata.contentType = "audio/mpeg";
+        metadata.eTag = "\"1234\"";
+        metadata.expiry = std::chrono::system_clock::now() + FRESHNESS_LIFETIME;
+        return metadata;
+    }
+
+    /**
+     * Builds a body of @c BODY_SIZE bytes.
+     *
+     * @param fill The byte to fill the body with.
+     * @return The body.
+     */
+    static std::string makeBody(char fill) {
+        return std::string(BODY_SIZE, fill);
+    }
+
+    /// The directory the caches are kept in.
+    std::string m_directory;
+};
+
+/**
+ * Test that a stored response is returned intact, along with its metadata.
+ */
+TEST_F(HTTPContentCacheTest, testPutAndGet) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache->get(URL_A), nullptr);
+    ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+
+    auto entry = cache->get(URL_A);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(makeBody('a'), std::string(entry->getData(), entry->getSize()));
+    EXPECT_EQ(URL_A, entry->getMetadata().url);
+    EXPECT_EQ("audio/mpeg", entry->getMetadata().contentType);
+    EXPECT_EQ("\"1234\"", entry->getMetadata().eTag);
+    EXPECT_TRUE(entry->isFresh());
+    EXPECT_TRUE(entry->hasValidators());
+    EXPECT_EQ(1u, cache->getStatistics().numStores);
+}
+
+/**
+ * Test that the least recently used entry is evicted when the size budget is exceeded.
+ */
+TEST_F(HTTPContentCacheTest, testLeastRecentlyUsedEviction) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+    ASSERT_TRUE(cache->put(makeMetadata(URL_B), makeBody('b')));
+    EXPECT_NE(cache->get(URL_A), nullptr);
+    ASSERT_TRUE(cache->put(makeMetadata(URL_C), makeBody('c')));
+
+    EXPECT_NE(cache->get(URL_A), nullptr);
+    EXPECT_EQ(cache->get(URL_B), nullptr);
+    EXPECT_NE(cache->get(URL_C), nullptr);
+    auto statistics = cache->getStatistics();
+    EXPECT_EQ(1u, statistics.numEvictions);
+    EXPECT_LE(statistics.sizeInBytes, MAX_SIZE_IN_BYTES);
+    EXPECT_EQ(2u, listFiles().size());
+}
+
+/**
+ * Test that a body larger than the largest entry size is not stored.
+ */
+TEST_F(HTTPContentCacheTest, testTooLargeEntryNotStored) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_FALSE(cache->put(makeMetadata(URL_A), makeBody('a') + "a"));
+    EXPECT_EQ(cache->get(URL_A), nullptr);
+    EXPECT_TRUE(listFiles().empty());
+}
+
+/**
+ * Test that an entry whose body has been damaged on disk is dropped instead of being returned.
+ */
+TEST_F(HTTPContentCacheTest, testCorruptBodyDropped) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+    auto fileNames = listFiles();
+    ASSERT_EQ(1u, fileNames.size());
+
+    int fd = open((m_directory + "/" + fileNames[0]).c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    off_t fileSize = lseek(fd, 0, SEEK_END);
+    const char damage = 'x';
+    EXPECT_EQ(1, pwrite(fd, &damage, 1, fileSize - 1));
+    close(fd);
+
+    EXPECT_EQ(cache->get(URL_A), nullptr);
+    auto statistics = cache->getStatistics();
+    EXPECT_EQ(1u, statistics.numCorruptEntries);
+    EXPECT_EQ(0u, statistics.sizeInBytes);
+    EXPECT_TRUE(listFiles().empty());
+}
+
+/**
+ * Test that a truncated entry is dropped when the cache picks up the entries already in its directory.
+ */
+TEST_F(HTTPContentCacheTest, testTruncatedEntryDroppedOnLoad) {
+    {
+        auto cache = createCache();
+        ASSERT_NE(cache, nullptr);
+        ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+        ASSERT_TRUE(cache->put(makeMetadata(URL_B), makeBody('b')));
+    }
+    auto fileNames = listFiles();
+    ASSERT_EQ(2u, fileNames.size());
+    ASSERT_EQ(0, truncate((m_directory + "/" + fileNames[0]).c_str(), BODY_SIZE / 2));
+
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(1u, cache->getStatistics().numCorruptEntries);
+    EXPECT_EQ(1u, listFiles().size());
+    EXPECT_NE(cache->get(URL_A) == nullptr, cache->get(URL_B) == nullptr);
+}
+
+/**
+ * Test that entries stored by one cache are picked up by a later cache on the same directory.
+ */
+TEST_F(HTTPContentCacheTest, testEntriesPersistAcrossInstances) {
+    {
+        auto cache = createCache();
+        ASSERT_NE(cache, nullptr);
+        ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+    }
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    auto entry = cache->get(URL_A);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(makeBody('a'), std::string(entry->getData(), entry->getSize()));
+    EXPECT_GT(cache->getStatistics().sizeInBytes, BODY_SIZE);
+}
+
+/**
+ * Test that an entry file holding the response of another URL, as when two URLs hash to the same file, is a miss which
+ * leaves the file in place.
+ */
+TEST_F(HTTPContentCacheTest, testUrlMismatchIsMissWithoutRemoval) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    ASSERT_TRUE(cache->put(makeMetadata(URL_A), makeBody('a')));
+    auto fileNamesOfA = listFiles();
+    ASSERT_EQ(1u, fileNamesOfA.size());
+    ASSERT_TRUE(cache->put(makeMetadata(URL_B), makeBody('b')));
+    auto fileNames = listFiles();
+    ASSERT_EQ(2u, fileNames.size());
+    auto fileNameOfB = fileNames[0] == fileNamesOfA[0] ? fileNames[1] : fileNames[0];
+
+    // Put the response of URL_A where the response of URL_B belongs.
+    auto pathOfA = m_directory + "/" + fileNamesOfA[0];
+    auto pathOfB = m_directory + "/" + fileNameOfB;
+    ASSERT_EQ(0, unlink(pathOfB.c_str()));
+    ASSERT_EQ(0, link(pathOfA.c_str(), pathOfB.c_str()));
+
+    EXPECT_EQ(cache->get(URL_B), nullptr);
+    EXPECT_EQ(0u, cache->getStatistics().numCorruptEntries);
+    EXPECT_EQ(0, access(pathOfB.c_str(), F_OK));
+    EXPECT_NE(cache->get(URL_A), nullptr);
+}
+
+/**
+ * Test that refreshing a stale entry makes it fresh again without touching its body.
+ */
+TEST_F(HTTPContentCacheTest, testRefresh) {
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    auto metadata = makeMetadata(URL_A);
+    metadata.expiry = std::chrono::system_clock::now() - FRESHNESS_LIFETIME;
+    ASSERT_TRUE(cache->put(metadata, makeBody('a')));
+    auto entry = cache->get(URL_A);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_FALSE(entry->isFresh());
+
+    EXPECT_TRUE(cache->refresh(URL_A, std::chrono::system_clock::now() + FRESHNESS_LIFETIME));
+    entry = cache->get(URL_A);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_TRUE(entry->isFresh());
+    EXPECT_EQ(makeBody('a'), std::string(entry->getData(), entry->getSize()));
+    EXPECT_FALSE(cache->refresh(URL_B, std::chrono::system_clock::now()));
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,588 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/LibcurlUtils/HTTPContentCache.h"
+#include "AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h"
+#include "AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// The body of every response of the @c LocalHttpServer.
+static const std::string RESPONSE_BODY = "a segment of media, served by a local HTTP server";
+
+/// The number of sequential fetches made by each test.
+static const int NUM_FETCHES = 5;
+
+/// How long the @c LocalHttpServer waits for activity before checking whether it should stop.
+static const int POLL_TIMEOUT_MS = 20;
+
+/// The @c ETag of every response of the @c LocalHttpServer, when it is configured to send one.
+static const std::string RESPONSE_ETAG = "\"segment-v1\"";
+
+/// How long the @c LocalHttpServer delays its responses in the tests comparing cached and uncached fetches.
+static const std::chrono::milliseconds RESPONSE_DELAY(100);
+
+/// A @c Last-Modified date long enough ago to make a response heuristically fresh for the length of a test.
+static const std::string LONG_AGO = "Mon, 01 Jan 2018 00:00:00 GMT";
+
+/// The size budget of the caches used by the tests.
+static const uint64_t CACHE_SIZE_IN_BYTES = 0x10000;
+
+/**
+ * A minimal HTTP/1.1 server on the loopback interface, which answers every request with @c RESPONSE_BODY, keeps its
+ * connections alive, and counts the connections and requests it receives. It can be configured to send a
+ * @c Cache-Control header and @c RESPONSE_ETAG, in which case it answers matching conditional requests with
+ * 304 (Not Modified).
+ */
+class LocalHttpServer {
+public:
+    /**
+     * Constructor. Starts listening on an ephemeral port.
+     */
+    LocalHttpServer() :
+            m_listenSocket{-1},
+            m_port{0},
+            m_numConnections{0},
+            m_numRequests{0},
+            m_numNotModified{0},
+            m_sendETag{false},
+            m_contentType{"audio/aac"},
+            m_responseDelay{0},
+            m_stop{false} {
+        m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t addressLength = sizeof(address);
+        if (m_listenSocket < 0 || bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), addressLength) != 0 ||
+            listen(m_listenSocket, NUM_FETCHES) != 0 ||
+            getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+            return;
+        }
+        m_port = ntohs(address.sin_port);
+        m_thread = std::thread(&LocalHttpServer::serve, this);
+    }
+
+    /**
+     * Destructor. Stops the server and closes all of its sockets.
+     */
+    ~LocalHttpServer() {
+        m_stop = true;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        for (auto& client : m_requests) {
+            close(client.first);
+        }
+        if (m_listenSocket >= 0) {
+            close(m_listenSocket);
+        }
+    }
+
+    /**
+     * Gets the URL of a resource on the server.
+     *
+     * @param path The path of the resource.
+     * @return The URL, or an empty string if the server failed to start.
+     */
+    std::string getUrl(const std::string& path) {
+        if (0 == m_port) {
+            return "";
+        }
+        return "http://127.0.0.1:" + std::to_string(m_port) + path;
+    }
+
+    /**
+     * Gets the number of connections the server has accepted.
+     *
+     * @return The number of connections accepted.
+     */
+    int getNumConnections() {
+        return m_numConnections;
+    }
+
+    /**
+     * Gets the number of requests the server has answered.
+     *
+     * @return The number of requests answered.
+     */
+    int getNumRequests() {
+        return m_numRequests;
+    }
+
+    /**
+     * Gets the number of requests the server has answered with 304 (Not Modified).
+     *
+     * @return The number of 304 responses.
+     */
+    int getNumNotModified() {
+        return m_numNotModified;
+    }
+
+    /**
+     * Configures the caching headers of the responses.
+     *
+     * @param cacheControl The value of the @c Cache-Control header, or an empty string to send none.
+     * @param sendETag Whether to send @c RESPONSE_ETAG and honor @c If-None-Match.
+     */
+    void setCaching(const std::string& cacheControl, bool sendETag) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cacheControl = cacheControl;
+        m_sendETag = sendETag;
+    }
+
+    /**
+     * Configures the @c Last-Modified header of the responses.
+     *
+     * @param lastModified The value of the header, or an empty string to send none.
+     */
+    void setLastModified(const std::string& lastModified) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastModified = lastModified;
+    }
+
+    /**
+     * Configures the content type of the responses.
+     *
+     * @param contentType The content type.
+     */
+    void setContentType(const std::string& contentType) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_contentType = contentType;
+    }
+
+    /**
+     * Configures how long the server waits before answering each request.
+     *
+     * @param delay The delay.
+     */
+    void setResponseDelay(std::chrono::milliseconds delay) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_responseDelay = delay;
+    }
+
+private:
+    /**
+     * Serves connections until the server is stopped.
+     */
+    void serve() {
+        while (!m_stop) {
+            std::vector<pollfd> pollFds;
+            pollFds.push_back({m_listenSocket, POLLIN, 0});
+            for (auto& client : m_requests) {
+                pollFds.push_back({client.first, POLLIN, 0});
+            }
+            if (poll(pollFds.data(), pollFds.size(), POLL_TIMEOUT_MS) <= 0) {
+                continue;
+            }
+            if (pollFds[0].revents & POLLIN) {
+                int client = accept(m_listenSocket, nullptr, nullptr);
+                if (client >= 0) {
+                    ++m_numConnections;
+                    m_requests[client] = "";
+                }
+            }
+            for (size_t i = 1; i < pollFds.size(); ++i) {
+                if (pollFds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    serveClient(pollFds[i].fd);
+                }
+            }
+        }
+    }
+
+    /**
+     * Reads from a client and answers any complete requests received from it.
+     *
+     * @param client The socket of the client.
+     */
+    void serveClient(int client) {
+        char buffer[1024];
+        auto bytesRead = recv(client, buffer, sizeof(buffer), 0);
+        if (bytesRead <= 0) {
+            close(client);
+            m_requests.erase(client);
+            return;
+        }
+        auto& request = m_requests[client];
+        request.append(buffer, bytesRead);
+        size_t endOfRequest;
+        while ((endOfRequest = request.find("\r\n\r\n")) != std::string::npos) {
+            std::string headers = request.substr(0, endOfRequest);
+            request.erase(0, endOfRequest + 4);
+            std::string cacheControl;
+            bool sendETag;
+            std::string lastModified;
+            std::string contentType;
+            std::chrono::milliseconds responseDelay;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                cacheControl = m_cacheControl;
+                sendETag = m_sendETag;
+                lastModified = m_lastModified;
+                contentType = m_contentType;
+                responseDelay = m_responseDelay;
+            }
+            std::this_thread::sleep_for(responseDelay);
+            ++m_numRequests;
+            std::string cachingHeaders;
+            if (!cacheControl.empty()) {
+                cachingHeaders += "Cache-Control: " + cacheControl + "\r\n";
+            }
+            if (sendETag) {
+                cachingHeaders += "ETag: " + RESPONSE_ETAG + "\r\n";
+            }
+            if (!lastModified.empty()) {
+                cachingHeaders += "Last-Modified: " + lastModified + "\r\n";
+            }
+            std::string response;
+            if (sendETag && headers.find("If-None-Match: " + RESPONSE_ETAG) != std::string::npos) {
+                ++m_numNotModified;
+                response = "HTTP/1.1 304 Not Modified\r\n" + cachingHeaders + "\r\n";
+            } else {
+                response = "HTTP/1.1 200 OK\r\nContent-Type: " + contentType + "\r\n" + cachingHeaders +
+                           "Content-Length: " + std::to_string(RESPONSE_BODY.size()) + "\r\n\r\n" + RESPONSE_BODY;
+            }
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    /// The socket listening for connections.
+    int m_listenSocket;
+
+    /// The port the server listens on.
+    int m_port;
+
+    /// The number of connections accepted.
+    std::atomic<int> m_numConnections;
+
+    /// The number of requests answered.
+    std::atomic<int> m_numRequests;
+
+    /// The number of requests answered with 304 (Not Modified).
+    std::atomic<int> m_numNotModified;
+
+    /// Serializes access to the response configuration below.
+    std::mutex m_mutex;
+
+    /// The value of the @c Cache-Control header of the responses, or an empty string to send none.
+    std::string m_cacheControl;
+
+    /// Whether to send @c RESPONSE_ETAG and honor @c If-None-Match.
+    bool m_sendETag;
+
+    /// The value of the @c Last-Modified header of the responses, or an empty string to send none.
+    std::string m_lastModified;
+
+    /// The content type of the responses.
+    std::string m_contentType;
+
+    /// How long to wait before answering each request.
+    std::chrono::milliseconds m_responseDelay;
+
+    /// Whether the server should stop.
+    std::atomic<bool> m_stop;
+
+    /// The partially received request of each open connection, keyed by socket.
+    std::map<int, std::string> m_requests;
+
+    /// The thread serving connections.
+    std::thread m_thread;
+};
+
+/**
+ * Removes a directory along with the files in it.
+ *
+ * @param directory The directory.
+ */
+static void removeDirectory(const std::string& directory) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return;
+    }
+    while (auto dirEntry = readdir(dir)) {
+        std::string fileName = dirEntry->d_name;
+        if (fileName != "." && fileName != "..") {
+            unlink((directory + "/" + fileName).c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(directory.c_str());
+}
+
+class HTTPContentFetcherFactoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        curl_global_init(CURL_GLOBAL_ALL);
+    }
+
+    void TearDown() override {
+        curl_global_cleanup();
+        if (!m_cacheDirectory.empty()) {
+            removeDirectory(m_cacheDirectory);
+        }
+    }
+
+    /**
+     * Creates a cache in a new temporary directory, which is removed at the end of the test.
+     *
+     * @return The cache.
+     */
+    std::shared_ptr<HTTPContentCache> createCache() {
+        char directoryTemplate[] = "/tmp/HTTPContentFetcherFactoryTestXXXXXX";
+        if (!mkdtemp(directoryTemplate)) {
+            return nullptr;
+        }
+        m_cacheDirectory = directoryTemplate;
+        return HTTPContentCache::create(m_cacheDirectory, CACHE_SIZE_IN_BYTES);
+    }
+
+    /**
+     * Fetches the entire body of a URL with a fetcher of a factory.
+     *
+     * @param factory The factory to create the fetcher with.
+     * @param url The URL.
+     * @return The body, or an empty string on failure.
+     */
+    std::string fetch(HTTPContentFetcherFactory* factory, const std::string& url) {
+        auto fetcher = factory->create(url);
+        auto libCurlFetcher = dynamic_cast<LibCurlHttpContentFetcher*>(fetcher.get());
+        if (!libCurlFetcher) {
+            return "";
+        }
+        return fetch(libCurlFetcher, nullptr);
+    }
+
+    /**
+     * Fetches the entire body of a URL.
+     *
+     * @param fetcher The fetcher to fetch with.
+     * @param[out] timings The timings of the fetch, or @c nullptr to skip them. Fetches served from a cache have none.
+     * @return The body, or an empty string on failure.
+     */
+    std::string fetch(LibCurlHttpContentFetcher* fetcher, LibCurlHttpContentFetcher::Timings* timings) {
+        auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, nullptr);
+        if (!content || !(*content) || !content->dataStream) {
+            return "";
+        }
+        auto reader = content->dataStream->createReader(sds::ReaderPolicy::BLOCKING);
+        if (!reader) {
+            return "";
+        }
+        std::string body;
+        std::vector<char> buffer(RESPONSE_BODY.size());
+        auto readStatus = AttachmentReader::ReadStatus::OK;
+        while (readStatus != AttachmentReader::ReadStatus::CLOSED) {
+            auto bytesRead = reader->read(buffer.data(), buffer.size(), &readStatus);
+            body.append(buffer.data(), bytesRead);
+        }
+        if (timings && !fetcher->getTimings(timings)) {
+            return "";
+        }
+        return body;
+    }
+
+    /// The server to fetch from.
+    LocalHttpServer m_server;
+
+    /// The directory of the cache created by @c createCache, if any.
+    std::string m_cacheDirectory;
+};
+
+/**
+ * Test that the fetchers of one factory open a connection each, since the connection cache cannot be shared between
+ * transfers on different threads, while still reporting their timings.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testSharedFetchesOpenTheirOwnConnections) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    HTTPContentFetcherFactory factory;
+    for (int i = 0; i < NUM_FETCHES; ++i) {
+        auto fetcher = factory.create(m_server.getUrl("/segment" + std::to_string(i) + ".aac"));
+        auto libCurlFetcher = dynamic_cast<LibCurlHttpContentFetcher*>(fetcher.get());
+        ASSERT_NE(libCurlFetcher, nullptr);
+        LibCurlHttpContentFetcher::Timings timings;
+        EXPECT_EQ(RESPONSE_BODY, fetch(libCurlFetcher, &timings));
+        EXPECT_FALSE(timings.connectionReused);
+        EXPECT_LE(timings.firstByte, timings.total);
+    }
+    EXPECT_EQ(NUM_FETCHES, m_server.getNumConnections());
+}
+
+/**
+ * Test that fetchers which do not share their caches open a connection for every fetch.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testUnsharedFetchesOpenNewConnections) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    for (int i = 0; i < NUM_FETCHES; ++i) {
+        LibCurlHttpContentFetcher fetcher(m_server.getUrl("/segment" + std::to_string(i) + ".aac"));
+        LibCurlHttpContentFetcher::Timings timings;
+        EXPECT_EQ(RESPONSE_BODY, fetch(&fetcher, &timings));
+        EXPECT_FALSE(timings.connectionReused);
+        EXPECT_LE(timings.connect, timings.firstByte);
+    }
+    EXPECT_EQ(NUM_FETCHES, m_server.getNumConnections());
+}
+
+/**
+ * Test that a fresh cached response is served without a request to the server.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testFreshResponseServedFromCache) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setCaching("max-age=3600", false);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    auto url = m_server.getUrl("/segment.aac");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+
+    EXPECT_EQ(1, m_server.getNumRequests());
+    auto statistics = cache->getStatistics();
+    EXPECT_EQ(1u, statistics.numMisses);
+    EXPECT_EQ(1u, statistics.numHits);
+    EXPECT_EQ(0u, statistics.numRevalidations);
+}
+
+/**
+ * Test that a stale cached response is revalidated with the server, and served from the cache on a 304 response.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testStaleResponseRevalidated) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setCaching("no-cache", true);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    auto url = m_server.getUrl("/segment.aac");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+
+    EXPECT_EQ(2, m_server.getNumRequests());
+    EXPECT_EQ(1, m_server.getNumNotModified());
+    auto statistics = cache->getStatistics();
+    EXPECT_EQ(1u, statistics.numMisses);
+    EXPECT_EQ(1u, statistics.numHits);
+    EXPECT_EQ(1u, statistics.numRevalidations);
+}
+
+/**
+ * Test that a response which must not be stored is fetched from the server every time.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testNoStoreResponseNotCached) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setCaching("no-store", true);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    auto url = m_server.getUrl("/segment.aac");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+
+    EXPECT_EQ(2, m_server.getNumRequests());
+    EXPECT_EQ(0, m_server.getNumNotModified());
+    auto statistics = cache->getStatistics();
+    EXPECT_EQ(2u, statistics.numMisses);
+    EXPECT_EQ(0u, statistics.numStores);
+}
+
+/**
+ * Test that a response with a @c Last-Modified header and no explicit expiry time is served from the cache for a while.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testLastModifiedResponseHeuristicallyFresh) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setLastModified(LONG_AGO);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    auto url = m_server.getUrl("/segment.aac");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+
+    EXPECT_EQ(1, m_server.getNumRequests());
+    EXPECT_EQ(1u, cache->getStatistics().numHits);
+}
+
+/**
+ * Test that a playlist, known by its path or by its content type, is not considered fresh on the strength of its
+ * @c Last-Modified header, since a live stream keeps changing it.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testPlaylistNotHeuristicallyFresh) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setLastModified(LONG_AGO);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    auto url = m_server.getUrl("/live.m3u8?session=1");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(2, m_server.getNumRequests());
+
+    m_server.setContentType("application/vnd.apple.mpegurl");
+    url = m_server.getUrl("/live");
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(RESPONSE_BODY, fetch(&factory, url));
+    EXPECT_EQ(4, m_server.getNumRequests());
+    EXPECT_EQ(0u, cache->getStatistics().numHits);
+}
+
+/**
+ * Test that responses served from the cache start sooner than those fetched from a slow server.
+ */
+TEST_F(HTTPContentFetcherFactoryTest, testCacheHitsStartSooner) {
+    ASSERT_FALSE(m_server.getUrl("/").empty());
+    m_server.setCaching("max-age=3600", false);
+    m_server.setResponseDelay(RESPONSE_DELAY);
+    auto cache = createCache();
+    ASSERT_NE(cache, nullptr);
+    HTTPContentFetcherFactory factory(cache);
+    for (int i = 0; i < NUM_FETCHES; ++i) {
+        EXPECT_EQ(RESPONSE_BODY, fetch(&factory, m_server.getUrl("/segment" + std::to_string(i % 2) + ".aac")));
+    }
+
+    auto statistics = cache->getStatistics();
+    ASSERT_EQ(2u, statistics.numMisses);
+    ASSERT_EQ(static_cast<uint64_t>(NUM_FETCHES - 2), statistics.numHits);
+    EXPECT_GE(statistics.missStartLatency / statistics.numMisses, RESPONSE_DELAY);
+    EXPECT_LT(statistics.hitStartLatency / statistics.numHits, RESPONSE_DELAY);
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
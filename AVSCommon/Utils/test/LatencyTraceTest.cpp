@@ -0,0 +1,240 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "AVSCommon/Utils/Timing/LatencyTrace.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// The capacity of the traces used by the tests.
+static const size_t CAPACITY = 16;
+
+/// dialogRequestIds of the interactions recorded by the tests.
+static const std::string DIALOG_A = "dialog-a";
+static const std::string DIALOG_B = "dialog-b";
+
+/**
+ * Gets a time a number of milliseconds after a fixed origin.
+ *
+ * @param milliseconds The number of milliseconds.
+ * @return The time.
+ */
+static LatencyTrace::Clock::time_point at(int milliseconds) {
+    return LatencyTrace::Clock::time_point() + std::chrono::milliseconds(milliseconds);
+}
+
+/**
+ * Test that recorded events are returned in order, and that events without a dialogRequestId are dropped.
+ */
+TEST(LatencyTraceTest, testRecordAndGetEvents) {
+    LatencyTrace trace(CAPACITY);
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A, at(0));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, "", at(10));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, DIALOG_A, at(20));
+
+    auto events = trace.getEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ(LatencyTrace::Point::END_OF_SPEECH, events[0].point);
+    EXPECT_EQ(DIALOG_A, events[0].dialogRequestId);
+    EXPECT_EQ(at(0), events[0].time);
+    EXPECT_EQ(LatencyTrace::Point::DIRECTIVE_RECEIVED, events[1].point);
+    EXPECT_EQ(at(20), events[1].time);
+}
+
+/**
+ * Test that a UUID is kept in full, and that a longer dialogRequestId is truncated.
+ */
+TEST(LatencyTraceTest, testDialogRequestIdLength) {
+    LatencyTrace trace(CAPACITY);
+    const std::string uuid = "c8b2b5e5-c0d6-4fc8-a2b6-2b46e6b1e0a8";
+    const std::string longId(LatencyTrace::MAX_ID_LENGTH + 5, 'x');
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, uuid);
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, longId);
+
+    auto events = trace.getEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ(uuid, events[0].dialogRequestId);
+    EXPECT_EQ(longId.substr(0, LatencyTrace::MAX_ID_LENGTH), events[1].dialogRequestId);
+}
+
+/**
+ * Test that the oldest events are overwritten once the ring is full, and that clear() drops the events.
+ */
+TEST(LatencyTraceTest, testWrapAroundAndClear) {
+    LatencyTrace trace(CAPACITY);
+    for (size_t i = 0; i < CAPACITY * 2 + 3; ++i) {
+        trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, std::to_string(i));
+    }
+    auto events = trace.getEvents();
+    ASSERT_EQ(CAPACITY, events.size());
+    EXPECT_EQ(std::to_string(CAPACITY + 3), events.front().dialogRequestId);
+    EXPECT_EQ(std::to_string(CAPACITY * 2 + 2), events.back().dialogRequestId);
+
+    trace.clear();
+    EXPECT_TRUE(trace.getEvents().empty());
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A);
+    EXPECT_EQ(1u, trace.getEvents().size());
+}
+
+/**
+ * Test that nothing is recorded while the trace is disabled.
+ */
+TEST(LatencyTraceTest, testDisabled) {
+    LatencyTrace trace(CAPACITY);
+    trace.setEnabled(false);
+    EXPECT_FALSE(trace.isEnabled());
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A);
+    EXPECT_TRUE(trace.getEvents().empty());
+    trace.setEnabled(true);
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A);
+    EXPECT_EQ(1u, trace.getEvents().size());
+}
+
+/**
+ * Test that the histograms hold the time from the end of speech to the first time each interaction reached a point,
+ * and leave out interactions without an end of speech.
+ */
+TEST(LatencyTraceTest, testHistograms) {
+    LatencyTrace trace(CAPACITY);
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A, at(0));
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_B, at(1000));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, DIALOG_A, at(400));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, DIALOG_A, at(450));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, DIALOG_B, at(1200));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, "no-end-of-speech", at(1300));
+    trace.record(LatencyTrace::Point::FIRST_BUFFER_RENDERED, DIALOG_A, at(900));
+
+    auto histograms = trace.getHistograms();
+    ASSERT_EQ(LatencyTrace::NUM_POINTS - 1, histograms.size());
+
+    const auto& received = histograms[0];
+    EXPECT_EQ(LatencyTrace::Point::DIRECTIVE_RECEIVED, received.point);
+    EXPECT_EQ(2u, received.count);
+    EXPECT_EQ(std::chrono::milliseconds(200), received.min);
+    EXPECT_EQ(std::chrono::milliseconds(200), received.median);
+    EXPECT_EQ(std::chrono::milliseconds(400), received.p90);
+    EXPECT_EQ(std::chrono::milliseconds(400), received.max);
+    const auto& bounds = LatencyTrace::getBucketBounds();
+    ASSERT_EQ(bounds.size() + 1, received.bucketCounts.size());
+    size_t total = 0;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        auto lowerBound = i > 0 ? bounds[i - 1] : std::chrono::milliseconds::zero();
+        size_t expected = 0;
+        for (auto time : {std::chrono::milliseconds(200), std::chrono::milliseconds(400)}) {
+            if (time > lowerBound && time <= bounds[i]) {
+                ++expected;
+            }
+        }
+        EXPECT_EQ(expected, received.bucketCounts[i]);
+        total += received.bucketCounts[i];
+    }
+    EXPECT_EQ(2u, total);
+
+    const auto& rendered = histograms.back();
+    EXPECT_EQ(LatencyTrace::Point::FIRST_BUFFER_RENDERED, rendered.point);
+    EXPECT_EQ(1u, rendered.count);
+    EXPECT_EQ(std::chrono::milliseconds(900), rendered.median);
+
+    EXPECT_EQ(0u, histograms[1].count);
+}
+
+/**
+ * Test that the Chrome trace holds a row per interaction, an instant event per point and a span per step.
+ */
+TEST(LatencyTraceTest, testChromeTrace) {
+    LatencyTrace trace(CAPACITY);
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_A, at(100));
+    trace.record(LatencyTrace::Point::DIRECTIVE_RECEIVED, DIALOG_A, at(350));
+    trace.record(LatencyTrace::Point::END_OF_SPEECH, DIALOG_B, at(500));
+
+    std::ostringstream stream;
+    ASSERT_TRUE(trace.writeChromeTrace(stream));
+    rapidjson::Document document;
+    ASSERT_FALSE(document.Parse(stream.str().c_str()).HasParseError());
+    ASSERT_TRUE(document.HasMember("traceEvents"));
+    const auto& traceEvents = document["traceEvents"];
+    ASSERT_TRUE(traceEvents.IsArray());
+
+    size_t rows = 0;
+    size_t instants = 0;
+    size_t spans = 0;
+    for (const auto& traceEvent : traceEvents.GetArray()) {
+        std::string phase = traceEvent["ph"].GetString();
+        if ("M" == phase) {
+            ++rows;
+        } else if ("i" == phase) {
+            ++instants;
+        } else if ("X" == phase) {
+            ++spans;
+            EXPECT_EQ(std::string("DIRECTIVE_RECEIVED"), traceEvent["name"].GetString());
+            EXPECT_EQ(0, traceEvent["ts"].GetInt64());
+            EXPECT_EQ(250000, traceEvent["dur"].GetInt64());
+        }
+    }
+    EXPECT_EQ(2u, rows);
+    EXPECT_EQ(3u, instants);
+    EXPECT_EQ(1u, spans);
+}
+
+/**
+ * Test that events recorded concurrently from several threads are all returned intact.
+ */
+TEST(LatencyTraceTest, testConcurrentRecord) {
+    const size_t numThreads = 4;
+    const size_t eventsPerThread = 256;
+    LatencyTrace trace(numThreads * eventsPerThread);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&trace, i, eventsPerThread] {
+            auto dialogRequestId = "thread-" + std::to_string(i);
+            for (size_t j = 0; j < eventsPerThread; ++j) {
+                trace.record(LatencyTrace::Point::DIRECTIVE_DISPATCHED, dialogRequestId);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto events = trace.getEvents();
+    ASSERT_EQ(numThreads * eventsPerThread, events.size());
+    std::vector<size_t> counts(numThreads, 0);
+    for (const auto& event : events) {
+        EXPECT_EQ(LatencyTrace::Point::DIRECTIVE_DISPATCHED, event.point);
+        ASSERT_EQ(0u, event.dialogRequestId.find("thread-"));
+        ++counts[std::stoul(event.dialogRequestId.substr(7))];
+    }
+    for (auto count : counts) {
+        EXPECT_EQ(eventsPerThread, count);
+    }
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file PcmFileTest.cpp
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/PcmFile.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// The template of the test file, which mkstemp() fills in.
+static const std::string FILE_TEMPLATE = "/tmp/PcmFileTest-XXXXXX";
+
+/// The rate of the test files.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of channels of the test files.
+static const unsigned int NUM_CHANNELS = 2;
+
+/// The samples of the test files: three stereo frames.
+static const std::vector<int16_t> SAMPLES = {1, -1, 0x1234, -0x1234, 32767, -32768};
+
+/**
+ * Appends a little-endian integer to a byte string.
+ *
+ * @param bytes The byte string.
+ * @param value The integer.
+ * @param size The number of bytes in the integer.
+ */
+static void appendLittleEndian(std::string* bytes, uint32_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        bytes->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+/**
+ * Builds a WAV file of @c SAMPLES, with an odd-sized chunk the reader must skip between the format and the samples.
+ *
+ * @param formatTag The format tag of the "fmt " chunk.
+ * @param extraBytes Bytes of a partial frame to append to the samples.
+ * @return The contents of the file.
+ */
+static std::string buildWav(uint16_t formatTag, size_t extraBytes) {
+    std::string data;
+    for (auto sample : SAMPLES) {
+        appendLittleEndian(&data, static_cast<uint16_t>(sample), sizeof(int16_t));
+    }
+    data.append(extraBytes, '\0');
+
+    std::string body = "WAVE";
+    body += "fmt ";
+    appendLittleEndian(&body, 16, 4);
+    appendLittleEndian(&body, formatTag, 2);
+    appendLittleEndian(&body, NUM_CHANNELS, 2);
+    appendLittleEndian(&body, SAMPLE_RATE_HZ, 4);
+    appendLittleEndian(&body, SAMPLE_RATE_HZ * NUM_CHANNELS * sizeof(int16_t), 4);
+    appendLittleEndian(&body, NUM_CHANNELS * sizeof(int16_t), 2);
+    appendLittleEndian(&body, 16, 2);
+    body += "LIST";
+    appendLittleEndian(&body, 3, 4);
+    body += std::string("abc", 3) + '\0';
+    body += "data";
+    appendLittleEndian(&body, data.size(), 4);
+    body += data;
+
+    std::string file = "RIFF";
+    appendLittleEndian(&file, body.size(), 4);
+    return file + body;
+}
+
+/// Test harness for the PCM file readers, which writes the file they read.
+class PcmFileTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /**
+     * Replaces the contents of the test file.
+     *
+     * @param contents The contents.
+     */
+    void writeFile(const std::string& contents);
+
+    /// The path of the test file.
+    std::string m_path;
+};
+
+void PcmFileTest::SetUp() {
+    std::vector<char> path(FILE_TEMPLATE.begin(), FILE_TEMPLATE.end());
+    path.push_back('\0');
+    int fd = mkstemp(path.data());
+    ASSERT_GE(fd, 0);
+    close(fd);
+    m_path = path.data();
+}
+
+void PcmFileTest::TearDown() {
+    std::remove(m_path.c_str());
+}
+
+void PcmFileTest::writeFile(const std::string& contents) {
+    std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size());
+}
+
+/// Test that a WAV file's format is read, chunks before the samples are skipped, and a partial frame is dropped.
+TEST_F(PcmFileTest, readWavFileReportsFormat) {
+    writeFile(buildWav(1, 3));
+    unsigned int sampleRateHz = 0;
+    unsigned int numChannels = 0;
+    std::vector<int16_t> samples;
+    ASSERT_TRUE(readWavFile(m_path, &sampleRateHz, &numChannels, &samples));
+    EXPECT_EQ(SAMPLE_RATE_HZ, sampleRateHz);
+    EXPECT_EQ(NUM_CHANNELS, numChannels);
+    EXPECT_EQ(SAMPLES, samples);
+}
+
+/// Test that readWavFile() rejects a raw file, a WAV file which is not LPCM, and a missing file.
+TEST_F(PcmFileTest, readWavFileRejectsOtherFiles) {
+    unsigned int sampleRateHz = 0;
+    unsigned int numChannels = 0;
+    std::vector<int16_t> samples;
+    writeFile(std::string(64, '\0'));
+    EXPECT_FALSE(readWavFile(m_path, &sampleRateHz, &numChannels, &samples));
+    writeFile(buildWav(3, 0));
+    EXPECT_FALSE(readWavFile(m_path, &sampleRateHz, &numChannels, &samples));
+    EXPECT_FALSE(readWavFile(m_path + ".missing", &sampleRateHz, &numChannels, &samples));
+}
+
+/// Test that readPcmFile() reads a WAV file in the expected format, and rejects one in another format.
+TEST_F(PcmFileTest, readPcmFileChecksWavFormat) {
+    writeFile(buildWav(1, 0));
+    std::vector<int16_t> samples;
+    ASSERT_TRUE(readPcmFile(m_path, SAMPLE_RATE_HZ, NUM_CHANNELS, &samples));
+    EXPECT_EQ(SAMPLES, samples);
+    EXPECT_FALSE(readPcmFile(m_path, SAMPLE_RATE_HZ, 1, &samples));
+    EXPECT_FALSE(readPcmFile(m_path, 2 * SAMPLE_RATE_HZ, NUM_CHANNELS, &samples));
+}
+
+/// Test that readPcmFile() reads the whole frames of a raw file, and rejects a file without a whole frame.
+TEST_F(PcmFileTest, readPcmFileReadsRawFile) {
+    writeFile(std::string("\x01\x00\x02\x00\x03", 5));
+    std::vector<int16_t> samples;
+    ASSERT_TRUE(readPcmFile(m_path, SAMPLE_RATE_HZ, 1, &samples));
+    EXPECT_EQ(std::vector<int16_t>({1, 2}), samples);
+    EXPECT_FALSE(readPcmFile(m_path, SAMPLE_RATE_HZ, 3, &samples));
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file PcmKernelsBenchmarkTest.cpp
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/PcmKernels.h"
+#include "AVSCommon/Utils/Audio/Resampler.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// The number of samples in a frame, which is 10 ms at 16 kHz.
+static const size_t FRAME_SIZE = 160;
+
+/// The number of channels the channel kernels are timed on.
+static const size_t NUM_CHANNELS = 2;
+
+/// The number of times the benchmark runs each kernel.
+static const size_t KERNEL_ITERATIONS = 20000;
+
+/// The rate the resampler is timed converting to.
+static const unsigned int OUTPUT_RATE_HZ = 16000;
+
+/// The number of 10 ms blocks the resampler is timed on.
+static const size_t RESAMPLER_BLOCKS = 2000;
+
+/**
+ * Gets the CPU time the calling thread has used.
+ *
+ * @return The CPU time.
+ */
+static std::chrono::nanoseconds threadCpuTime() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+/**
+ * Times a kernel.
+ *
+ * @param function Runs the kernel once.
+ * @return The CPU time of a run.
+ */
+static std::chrono::nanoseconds time(const std::function<void()>& function) {
+    auto start = threadCpuTime();
+    for (size_t i = 0; i < KERNEL_ITERATIONS; ++i) {
+        function();
+    }
+    return (threadCpuTime() - start) / KERNEL_ITERATIONS;
+}
+
+/**
+ * Prints the times of a kernel.
+ *
+ * @param kernel The name of the kernel.
+ * @param scalar The CPU time of a run of the scalar kernel.
+ * @param vectorized The CPU time of a run of the vectorized kernel.
+ */
+static void report(const std::string& kernel, std::chrono::nanoseconds scalar, std::chrono::nanoseconds vectorized) {
+    std::cout << kernel << ": scalar " << scalar.count() << " ns, " << kernels::getInstructionSet() << " "
+              << vectorized.count() << " ns per frame" << std::endl;
+}
+
+/// Times the vectorized float kernels against the scalar kernels on frames of the default size.
+TEST(PcmKernelsBenchmarkTest, floatKernelSpeedup) {
+    std::vector<float> a(FRAME_SIZE, 1000.0f);
+    std::vector<float> b(FRAME_SIZE, -500.0f);
+    std::vector<int16_t> samples(FRAME_SIZE);
+    volatile float sink = 0.0f;
+
+    report(
+        "accumulateScaled",
+        time([&] { kernels::scalar::accumulateScaled(a.data(), b.data(), 1e-6f, FRAME_SIZE); }),
+        time([&] { kernels::accumulateScaled(a.data(), b.data(), 1e-6f, FRAME_SIZE); }));
+    report(
+        "applyGainRamp",
+        time([&] { kernels::scalar::applyGainRamp(a.data(), FRAME_SIZE, 1.0f, 1.0f); }),
+        time([&] { kernels::applyGainRamp(a.data(), FRAME_SIZE, 1.0f, 1.0f); }));
+    report(
+        "sumOfSquares(float)",
+        time([&] { sink = sink + kernels::scalar::sumOfSquares(a.data(), FRAME_SIZE); }),
+        time([&] { sink = sink + kernels::sumOfSquares(a.data(), FRAME_SIZE); }));
+    report(
+        "dotProduct",
+        time([&] { sink = sink + kernels::scalar::dotProduct(a.data(), b.data(), FRAME_SIZE); }),
+        time([&] { sink = sink + kernels::dotProduct(a.data(), b.data(), FRAME_SIZE); }));
+    report(
+        "floatToInt16",
+        time([&] { kernels::scalar::floatToInt16(a.data(), samples.data(), FRAME_SIZE); }),
+        time([&] { kernels::floatToInt16(a.data(), samples.data(), FRAME_SIZE); }));
+}
+
+/// Times the vectorized 16-bit kernels against the scalar kernels on frames of the default size.
+TEST(PcmKernelsBenchmarkTest, int16KernelSpeedup) {
+    std::vector<int16_t> samples(FRAME_SIZE * NUM_CHANNELS);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int16_t>((i * 7919) % 20000 - 10000);
+    }
+    std::vector<int16_t> output(FRAME_SIZE * NUM_CHANNELS);
+    std::vector<float> floats(FRAME_SIZE);
+    volatile uint64_t sink = 0;
+
+    report(
+        "int16ToFloat",
+        time([&] { kernels::scalar::int16ToFloat(samples.data(), floats.data(), FRAME_SIZE); }),
+        time([&] { kernels::int16ToFloat(samples.data(), floats.data(), FRAME_SIZE); }));
+    report(
+        "byteswap16",
+        time([&] { kernels::scalar::byteswap16(samples.data(), output.data(), FRAME_SIZE); }),
+        time([&] { kernels::byteswap16(samples.data(), output.data(), FRAME_SIZE); }));
+    report(
+        "deinterleaveToFloat(2 channels)",
+        time([&] { kernels::scalar::deinterleaveToFloat(samples.data(), NUM_CHANNELS, 1, floats.data(), FRAME_SIZE); }),
+        time([&] { kernels::deinterleaveToFloat(samples.data(), NUM_CHANNELS, 1, floats.data(), FRAME_SIZE); }));
+    report(
+        "downmixToMono(2 channels)",
+        time([&] { kernels::scalar::downmixToMono(samples.data(), NUM_CHANNELS, output.data(), FRAME_SIZE); }),
+        time([&] { kernels::downmixToMono(samples.data(), NUM_CHANNELS, output.data(), FRAME_SIZE); }));
+    report(
+        "applyGain",
+        time([&] { kernels::scalar::applyGain(output.data(), FRAME_SIZE, 1.0f); }),
+        time([&] { kernels::applyGain(output.data(), FRAME_SIZE, 1.0f); }));
+    report(
+        "sumOfSquares(int16)",
+        time([&] { sink = sink + kernels::scalar::sumOfSquares(samples.data(), FRAME_SIZE); }),
+        time([&] { sink = sink + kernels::sumOfSquares(samples.data(), FRAME_SIZE); }));
+    report(
+        "peakMagnitude",
+        time([&] { sink = sink + kernels::scalar::peakMagnitude(samples.data(), FRAME_SIZE); }),
+        time([&] { sink = sink + kernels::peakMagnitude(samples.data(), FRAME_SIZE); }));
+    report(
+        "countSignChanges",
+        time([&] { sink = sink + kernels::scalar::countSignChanges(samples.data(), FRAME_SIZE, 0); }),
+        time([&] { sink = sink + kernels::countSignChanges(samples.data(), FRAME_SIZE, 0); }));
+}
+
+/// Times the resampler converting 10 ms blocks of capture rates to 16 kHz.
+TEST(PcmKernelsBenchmarkTest, resamplerCpuPerBlock) {
+    for (unsigned int rateHz : {48000u, 44100u}) {
+        auto resampler = Resampler::create(rateHz, OUTPUT_RATE_HZ);
+        ASSERT_TRUE(resampler);
+        std::vector<int16_t> input(rateHz / 100);
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] = static_cast<int16_t>((i * 7919) % 20000 - 10000);
+        }
+        std::vector<int16_t> output(resampler->getMaxOutputSize(input.size()));
+
+        size_t numOutput = 0;
+        auto start = threadCpuTime();
+        for (size_t block = 0; block < RESAMPLER_BLOCKS; ++block) {
+            numOutput += resampler->process(input.data(), input.size(), output.data());
+        }
+        auto perBlock = (threadCpuTime() - start) / RESAMPLER_BLOCKS;
+        EXPECT_NEAR(RESAMPLER_BLOCKS * OUTPUT_RATE_HZ / 100, numOutput, 1);
+        std::cout << "Resampler " << rateHz << " Hz to " << OUTPUT_RATE_HZ << " Hz: " << perBlock.count() / 1000
+                  << " us per 10 ms block (" << kernels::getInstructionSet() << ")" << std::endl;
+    }
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file PcmKernelsTest.cpp
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/PcmKernels.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// The lengths the kernels are tested on, which cover no samples, a partial vector, whole vectors and a remainder.
+static const std::vector<size_t> LENGTHS = {0, 1, 7, 8, 9, 160, 161};
+
+/**
+ * Generates random 16-bit samples over the whole range.
+ *
+ * @param generator The generator.
+ * @param length The number of samples.
+ * @return The samples.
+ */
+static std::vector<int16_t> randomSamples(std::mt19937* generator, size_t length) {
+    std::uniform_int_distribution<int> distribution(
+        std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max());
+    std::vector<int16_t> samples(length);
+    for (auto& sample : samples) {
+        sample = static_cast<int16_t>(distribution(*generator));
+    }
+    return samples;
+}
+
+/// Test that the vectorized float kernels match the scalar kernels, whatever the length of the signal.
+TEST(PcmKernelsTest, floatKernelsMatchScalar) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-40000.0f, 40000.0f);
+    for (size_t length : LENGTHS) {
+        std::vector<float> a(length);
+        std::vector<float> b(length);
+        for (size_t i = 0; i < length; ++i) {
+            a[i] = distribution(generator);
+            b[i] = distribution(generator);
+        }
+
+        auto vectorized = a;
+        auto reference = a;
+        kernels::accumulateScaled(vectorized.data(), b.data(), 0.25f, length);
+        kernels::scalar::accumulateScaled(reference.data(), b.data(), 0.25f, length);
+        for (size_t i = 0; i < length; ++i) {
+            EXPECT_NEAR(reference[i], vectorized[i], 0.01f);
+        }
+
+        vectorized = a;
+        reference = a;
+        kernels::applyGainRamp(vectorized.data(), length, 0.5f, 2.0f);
+        kernels::scalar::applyGainRamp(reference.data(), length, 0.5f, 2.0f);
+        for (size_t i = 0; i < length; ++i) {
+            EXPECT_NEAR(reference[i], vectorized[i], 0.05f);
+        }
+
+        EXPECT_NEAR(
+            kernels::scalar::sumOfSquares(a.data(), length),
+            kernels::sumOfSquares(a.data(), length),
+            1e-4 * kernels::scalar::sumOfSquares(a.data(), length));
+        auto product = kernels::scalar::dotProduct(a.data(), b.data(), length);
+        EXPECT_NEAR(product, kernels::dotProduct(a.data(), b.data(), length), 1e-4 * std::abs(product) + 1.0f);
+
+        std::vector<int16_t> vectorizedSamples(length);
+        std::vector<int16_t> referenceSamples(length);
+        kernels::floatToInt16(a.data(), vectorizedSamples.data(), length);
+        kernels::scalar::floatToInt16(a.data(), referenceSamples.data(), length);
+        EXPECT_EQ(referenceSamples, vectorizedSamples);
+    }
+}
+
+/// Test that the vectorized 16-bit kernels match the scalar kernels exactly, whatever the length of the signal.
+TEST(PcmKernelsTest, int16KernelsMatchScalar) {
+    std::mt19937 generator(2);
+    for (size_t length : LENGTHS) {
+        auto samples = randomSamples(&generator, length);
+
+        std::vector<float> vectorizedFloats(length);
+        std::vector<float> referenceFloats(length);
+        kernels::int16ToFloat(samples.data(), vectorizedFloats.data(), length);
+        kernels::scalar::int16ToFloat(samples.data(), referenceFloats.data(), length);
+        EXPECT_EQ(referenceFloats, vectorizedFloats);
+
+        std::vector<int16_t> vectorized(length);
+        std::vector<int16_t> reference(length);
+        kernels::byteswap16(samples.data(), vectorized.data(), length);
+        kernels::scalar::byteswap16(samples.data(), reference.data(), length);
+        EXPECT_EQ(reference, vectorized);
+
+        for (float gain : {0.3f, 1.0f, 4.0f}) {
+            vectorized = samples;
+            reference = samples;
+            kernels::applyGain(vectorized.data(), length, gain);
+            kernels::scalar::applyGain(reference.data(), length, gain);
+            EXPECT_EQ(reference, vectorized);
+        }
+
+        EXPECT_EQ(kernels::scalar::sumOfSquares(samples.data(), length), kernels::sumOfSquares(samples.data(), length));
+        EXPECT_EQ(
+            kernels::scalar::peakMagnitude(samples.data(), length), kernels::peakMagnitude(samples.data(), length));
+        for (int16_t previous : {-1, 0, 1}) {
+            EXPECT_EQ(
+                kernels::scalar::countSignChanges(samples.data(), length, previous),
+                kernels::countSignChanges(samples.data(), length, previous));
+        }
+    }
+}
+
+/// Test that the vectorized channel kernels match the scalar kernels for every channel count they handle.
+TEST(PcmKernelsTest, channelKernelsMatchScalar) {
+    std::mt19937 generator(3);
+    for (size_t numChannels : {1, 2, 3, 4}) {
+        for (size_t numFrames : LENGTHS) {
+            auto frames = randomSamples(&generator, numChannels * numFrames);
+
+            std::vector<int16_t> vectorized(numFrames);
+            std::vector<int16_t> reference(numFrames);
+            kernels::downmixToMono(frames.data(), numChannels, vectorized.data(), numFrames);
+            kernels::scalar::downmixToMono(frames.data(), numChannels, reference.data(), numFrames);
+            EXPECT_EQ(reference, vectorized);
+
+            for (size_t channel = 0; channel < numChannels; ++channel) {
+                std::vector<float> vectorizedFloats(numFrames);
+                std::vector<float> referenceFloats(numFrames);
+                kernels::deinterleaveToFloat(frames.data(), numChannels, channel, vectorizedFloats.data(), numFrames);
+                kernels::scalar::deinterleaveToFloat(
+                    frames.data(), numChannels, channel, referenceFloats.data(), numFrames);
+                EXPECT_EQ(referenceFloats, vectorizedFloats);
+            }
+        }
+    }
+}
+
+/// Test that conversion to 16-bit samples rounds half away from zero and saturates.
+TEST(PcmKernelsTest, floatToInt16RoundsAndSaturates) {
+    std::vector<float> input{0.4f, 0.5f, -0.5f, -1.6f, 40000.0f, -40000.0f, 32767.4f, -32768.0f};
+    std::vector<int16_t> expected{0, 1, -1, -2, 32767, -32768, 32767, -32768};
+    std::vector<int16_t> output(input.size());
+    kernels::floatToInt16(input.data(), output.data(), input.size());
+    EXPECT_EQ(expected, output);
+}
+
+/// Test that swapping bytes in place twice gives back the samples, and swaps the bytes of each sample.
+TEST(PcmKernelsTest, byteswapInPlaceRoundTrips) {
+    std::mt19937 generator(4);
+    auto samples = randomSamples(&generator, 161);
+    samples[0] = 0x1234;
+    auto swapped = samples;
+    kernels::byteswap16(swapped.data(), swapped.data(), swapped.size());
+    EXPECT_EQ(0x3412, swapped[0]);
+    kernels::byteswap16(swapped.data(), swapped.data(), swapped.size());
+    EXPECT_EQ(samples, swapped);
+}
+
+/// Test that mixing down takes the mean of the channels rounded down, without overflowing.
+TEST(PcmKernelsTest, downmixRoundsDown) {
+    std::vector<int16_t> frames{1, 2, -1, -2, 32767, 32767, -32768, -32768, 32767, -32768};
+    std::vector<int16_t> expected{1, -2, 32767, -32768, -1};
+    std::vector<int16_t> output(expected.size());
+    kernels::downmixToMono(frames.data(), 2, output.data(), output.size());
+    EXPECT_EQ(expected, output);
+}
+
+/// Test that gains saturate at the 16-bit range.
+TEST(PcmKernelsTest, applyGainSaturates) {
+    std::vector<int16_t> samples{100, -100, 20000, -20000, 1};
+    std::vector<int16_t> expected{200, -200, 32767, -32768, 2};
+    kernels::applyGain(samples.data(), samples.size(), 2.0f);
+    EXPECT_EQ(expected, samples);
+}
+
+/// Test the energy of the loudest samples, whose magnitude does not fit in 16 bits.
+TEST(PcmKernelsTest, energyOfFullScaleSamples) {
+    std::vector<int16_t> samples(161, -32768);
+    EXPECT_EQ(32768u, kernels::peakMagnitude(samples.data(), samples.size()));
+    EXPECT_EQ(161ull * 32768 * 32768, kernels::sumOfSquares(samples.data(), samples.size()));
+    EXPECT_EQ(0u, kernels::peakMagnitude(samples.data(), 0));
+}
+
+/// Test that sign changes are counted over more samples than a 16-bit count per lane can hold.
+TEST(PcmKernelsTest, countSignChangesOfLongSignal) {
+    std::vector<int16_t> samples(300000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = (i % 2) ? -1 : 1;
+    }
+    EXPECT_EQ(samples.size() - 1, kernels::countSignChanges(samples.data(), samples.size(), 1));
+    EXPECT_EQ(samples.size(), kernels::countSignChanges(samples.data(), samples.size(), -1));
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ResamplerTest.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/Resampler.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// The rate the resampler converts to.
+static const unsigned int OUTPUT_RATE_HZ = 16000;
+
+/// The rates the resampler is tested from.
+static const std::vector<unsigned int> INPUT_RATES_HZ = {48000, 44100};
+
+/// The amplitude of the test tones.
+static const double AMPLITUDE = 10000.0;
+
+/// A tone well inside the passband.
+static const double PASSBAND_FREQUENCY_HZ = 1000.0;
+
+/// A tone above the output's Nyquist frequency, which must not alias into the output.
+static const double STOPBAND_FREQUENCY_HZ = 10000.0;
+
+/// The least the stopband tone must be attenuated by.
+static const double MIN_STOPBAND_ATTENUATION_DB = 40.0;
+
+/// The number of output samples skipped before measuring, while the filter fills.
+static const size_t SETTLING_SAMPLES = 200;
+
+/**
+ * Generates one second of a tone.
+ *
+ * @param rateHz The sample rate.
+ * @param frequencyHz The frequency of the tone.
+ * @return The samples.
+ */
+static std::vector<int16_t> tone(unsigned int rateHz, double frequencyHz) {
+    const double pi = std::acos(-1.0);
+    std::vector<int16_t> samples(rateHz);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int16_t>(std::lround(AMPLITUDE * std::sin(2.0 * pi * frequencyHz * i / rateHz)));
+    }
+    return samples;
+}
+
+/**
+ * Resamples a signal in blocks.
+ *
+ * @param resampler The resampler.
+ * @param input The signal.
+ * @param blockSize The number of samples passed at a time.
+ * @return The resampled signal.
+ */
+static std::vector<int16_t> resample(Resampler* resampler, const std::vector<int16_t>& input, size_t blockSize) {
+    std::vector<int16_t> output;
+    std::vector<int16_t> block;
+    for (size_t offset = 0; offset < input.size(); offset += blockSize) {
+        auto numSamples = std::min(blockSize, input.size() - offset);
+        block.resize(resampler->getMaxOutputSize(numSamples));
+        auto numOutput = resampler->process(input.data() + offset, numSamples, block.data());
+        EXPECT_LE(numOutput, block.size());
+        output.insert(output.end(), block.begin(), block.begin() + numOutput);
+    }
+    return output;
+}
+
+/**
+ * Computes the RMS level of a signal once the filter has settled.
+ *
+ * @param samples The signal.
+ * @return The RMS level.
+ */
+static double settledLevel(const std::vector<int16_t>& samples) {
+    double sum = 0.0;
+    for (size_t i = SETTLING_SAMPLES; i < samples.size(); ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return std::sqrt(sum / (samples.size() - SETTLING_SAMPLES));
+}
+
+/// Test that create() rejects rates of zero, and a conversion to the same rate.
+TEST(ResamplerTest, createWithInvalidRates) {
+    EXPECT_FALSE(Resampler::create(0, OUTPUT_RATE_HZ));
+    EXPECT_FALSE(Resampler::create(48000, 0));
+    EXPECT_FALSE(Resampler::create(OUTPUT_RATE_HZ, OUTPUT_RATE_HZ));
+    EXPECT_TRUE(Resampler::create(48000, OUTPUT_RATE_HZ));
+}
+
+/// Test that a tone in the passband keeps its level, and the output has as many samples as the rates imply.
+TEST(ResamplerTest, passbandToneKeepsItsLevel) {
+    for (auto rateHz : INPUT_RATES_HZ) {
+        auto resampler = Resampler::create(rateHz, OUTPUT_RATE_HZ);
+        ASSERT_TRUE(resampler);
+        auto output = resample(resampler.get(), tone(rateHz, PASSBAND_FREQUENCY_HZ), rateHz / 100);
+        EXPECT_NEAR(OUTPUT_RATE_HZ, output.size(), 1) << rateHz;
+        EXPECT_NEAR(AMPLITUDE / std::sqrt(2.0), settledLevel(output), 0.02 * AMPLITUDE) << rateHz;
+    }
+}
+
+/// Test that a tone above the output's Nyquist frequency is filtered out rather than aliased.
+TEST(ResamplerTest, stopbandToneIsAttenuated) {
+    for (auto rateHz : INPUT_RATES_HZ) {
+        auto resampler = Resampler::create(rateHz, OUTPUT_RATE_HZ);
+        ASSERT_TRUE(resampler);
+        auto output = resample(resampler.get(), tone(rateHz, STOPBAND_FREQUENCY_HZ), rateHz / 100);
+        auto attenuationDb = 20.0 * std::log10(AMPLITUDE / std::sqrt(2.0) / std::max(settledLevel(output), 1.0));
+        EXPECT_GT(attenuationDb, MIN_STOPBAND_ATTENUATION_DB) << rateHz;
+    }
+}
+
+/// Test that the output does not depend on how the input is split into blocks, and reset() starts afresh.
+TEST(ResamplerTest, outputIsIndependentOfBlockSize) {
+    for (auto rateHz : INPUT_RATES_HZ) {
+        auto input = tone(rateHz, PASSBAND_FREQUENCY_HZ);
+        auto resampler = Resampler::create(rateHz, OUTPUT_RATE_HZ);
+        ASSERT_TRUE(resampler);
+        auto expected = resample(resampler.get(), input, input.size());
+        for (size_t blockSize : {1, 7, 441, 480}) {
+            auto other = Resampler::create(rateHz, OUTPUT_RATE_HZ);
+            EXPECT_EQ(expected, resample(other.get(), input, blockSize)) << rateHz << " " << blockSize;
+        }
+        resampler->reset();
+        EXPECT_EQ(expected, resample(resampler.get(), input, rateHz / 100)) << rateHz;
+    }
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
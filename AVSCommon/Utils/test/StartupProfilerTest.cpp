@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Timing/StartupProfiler.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// A short time for a stage to take.
+static const std::chrono::milliseconds SHORT_DELAY{20};
+
+/// Test that sequential stages follow each other.
+TEST(StartupProfilerTest, testMarkStage) {
+    StartupProfiler profiler;
+    std::this_thread::sleep_for(SHORT_DELAY);
+    profiler.markStage("first");
+    std::this_thread::sleep_for(SHORT_DELAY);
+    profiler.markStage("second");
+
+    auto stages = profiler.getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    EXPECT_EQ(stages[0].name, "first");
+    EXPECT_EQ(stages[0].start.count(), 0);
+    EXPECT_GE(stages[0].duration, SHORT_DELAY);
+    EXPECT_EQ(stages[1].name, "second");
+    EXPECT_GE(stages[1].start, stages[0].start + stages[0].duration);
+    EXPECT_GE(stages[1].duration, SHORT_DELAY);
+}
+
+/// Test that measured stages return the result of the function and do not affect sequential stages.
+TEST(StartupProfilerTest, testMeasureStage) {
+    StartupProfiler profiler;
+    auto result = profiler.measureStage("measured", [] {
+        std::this_thread::sleep_for(SHORT_DELAY);
+        return 42;
+    });
+    EXPECT_EQ(result, 42);
+    profiler.measureStage("void", [] {});
+    profiler.markStage("sequential");
+
+    auto stages = profiler.getStages();
+    ASSERT_EQ(stages.size(), 3u);
+    EXPECT_EQ(stages[0].name, "measured");
+    EXPECT_GE(stages[0].duration, SHORT_DELAY);
+    EXPECT_EQ(stages[1].name, "void");
+    EXPECT_EQ(stages[2].name, "sequential");
+    EXPECT_EQ(stages[2].start.count(), 0);
+    EXPECT_GE(stages[2].duration, SHORT_DELAY);
+}
+
+/// Test that the report contains every stage.
+TEST(StartupProfilerTest, testReport) {
+    StartupProfiler profiler;
+    profiler.markStage("first");
+    profiler.measureStage("second", [] {});
+
+    auto report = profiler.getReport();
+    EXPECT_NE(report.find("first: "), std::string::npos);
+    EXPECT_NE(report.find("second: "), std::string::npos);
+    EXPECT_NE(report.find("total: "), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
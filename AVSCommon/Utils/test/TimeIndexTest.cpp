@@ -0,0 +1,309 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file TimeIndexTest.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+#include "AVSCommon/Utils/SDS/TimeIndex.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+namespace test {
+
+using Clock = TimeIndex::Clock;
+using Index = TimeIndex::Index;
+
+/// The sample rate of the simulated microphone.
+static const int64_t SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples the simulated microphone writes at a time, which is 10ms of audio.
+static const Index SAMPLES_PER_WRITE = 160;
+
+/// The longest the simulated writer is delayed after a chunk of audio has been captured.
+static const std::chrono::microseconds MAX_JITTER(3000);
+
+/// How much faster the simulated microphone's clock runs than @c Clock, in parts per million.
+static const double DRIFT_PPM = 100.0;
+
+/// An arbitrary time at which the simulated microphone starts.
+static const Clock::time_point START = Clock::time_point() + std::chrono::hours(1);
+
+/**
+ * Gets the time a sample of the simulated microphone was captured, on @c Clock.
+ *
+ * @param sample The index of the sample.
+ * @return The time.
+ */
+static Clock::time_point captureTime(Index sample) {
+    double seconds = static_cast<double>(sample) / SAMPLE_RATE_HZ / (1.0 + DRIFT_PPM / 1000000.0);
+    return START + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+/// Test that create() rejects a capacity which cannot be interpolated in.
+TEST(TimeIndexTest, createWithInvalidCapacity) {
+    EXPECT_FALSE(TimeIndex::create(0));
+    EXPECT_FALSE(TimeIndex::create(1));
+    auto timeIndex = TimeIndex::create(2);
+    ASSERT_TRUE(timeIndex);
+    EXPECT_EQ(2u, timeIndex->getCapacity());
+    EXPECT_EQ(0u, timeIndex->size());
+}
+
+/// Test that lookups fail before anything is recorded and outside the recorded range.
+TEST(TimeIndexTest, lookupsOutsideTheRecordedRangeFail) {
+    auto timeIndex = TimeIndex::create(4);
+    ASSERT_TRUE(timeIndex);
+    Index index = 0;
+    Clock::time_point time;
+    EXPECT_FALSE(timeIndex->getIndex(START, &index));
+    EXPECT_FALSE(timeIndex->getTime(0, &time));
+
+    timeIndex->record(100, START);
+    timeIndex->record(200, START + std::chrono::milliseconds(10));
+    EXPECT_FALSE(timeIndex->getIndex(START - std::chrono::milliseconds(1), &index));
+    EXPECT_FALSE(timeIndex->getTime(99, &time));
+    EXPECT_FALSE(timeIndex->getTime(201, &time));
+    EXPECT_FALSE(timeIndex->getIndex(START, nullptr));
+    EXPECT_FALSE(timeIndex->getTime(100, nullptr));
+}
+
+/// Test that lookups between entries are interpolated, and lookups after the newest entry are extrapolated.
+TEST(TimeIndexTest, interpolatesAndExtrapolates) {
+    auto timeIndex = TimeIndex::create(4);
+    ASSERT_TRUE(timeIndex);
+    timeIndex->record(1000, START);
+    timeIndex->record(1160, START + std::chrono::milliseconds(10));
+
+    Index index = 0;
+    ASSERT_TRUE(timeIndex->getIndex(START, &index));
+    EXPECT_EQ(1000u, index);
+    ASSERT_TRUE(timeIndex->getIndex(START + std::chrono::milliseconds(5), &index));
+    EXPECT_EQ(1080u, index);
+    ASSERT_TRUE(timeIndex->getIndex(START + std::chrono::milliseconds(10), &index));
+    EXPECT_EQ(1160u, index);
+    ASSERT_TRUE(timeIndex->getIndex(START + std::chrono::milliseconds(15), &index));
+    EXPECT_EQ(1240u, index);
+
+    Clock::time_point time;
+    ASSERT_TRUE(timeIndex->getTime(1040, &time));
+    EXPECT_EQ(START + std::chrono::microseconds(2500), time);
+    ASSERT_TRUE(timeIndex->getTime(1160, &time));
+    EXPECT_EQ(START + std::chrono::milliseconds(10), time);
+}
+
+/**
+ * Test that a time after a gap in writes, such as while the microphone is off, is not extrapolated far past the newest
+ * entry, and that once writes resume, extrapolation past the newest entry is bounded by one write.
+ */
+TEST(TimeIndexTest, doesNotExtrapolateAcrossGapInWrites) {
+    auto timeIndex = TimeIndex::create(16);
+    ASSERT_TRUE(timeIndex);
+    for (Index write = 1; write <= 8; ++write) {
+        timeIndex->record(write * SAMPLES_PER_WRITE, START + write * std::chrono::milliseconds(10));
+    }
+    Index index = 0;
+    ASSERT_TRUE(timeIndex->getIndex(START + std::chrono::milliseconds(85), &index));
+    EXPECT_EQ(static_cast<Index>(8 * SAMPLES_PER_WRITE + SAMPLES_PER_WRITE / 2), index);
+    EXPECT_FALSE(timeIndex->getIndex(START + std::chrono::milliseconds(95), &index));
+    EXPECT_FALSE(timeIndex->getIndex(START + std::chrono::seconds(60), &index));
+
+    // The writer resumes a minute later.
+    const Clock::time_point resumed = START + std::chrono::seconds(60);
+    for (Index write = 9; write <= 10; ++write) {
+        timeIndex->record(write * SAMPLES_PER_WRITE, resumed + (write - 8) * std::chrono::milliseconds(10));
+    }
+    const Clock::time_point newest = resumed + std::chrono::milliseconds(20);
+    for (auto elapsed : {std::chrono::milliseconds(5), std::chrono::milliseconds(10), std::chrono::milliseconds(500)}) {
+        if (timeIndex->getIndex(newest + elapsed, &index)) {
+            EXPECT_GE(index, 10 * SAMPLES_PER_WRITE);
+            EXPECT_LE(index, 11 * SAMPLES_PER_WRITE) << "elapsed=" << elapsed.count() << "ms";
+        }
+    }
+    EXPECT_FALSE(timeIndex->getIndex(newest + std::chrono::seconds(60), &index));
+}
+
+/// Test that the oldest entries are replaced once the table is full, and that out of order entries are ignored.
+TEST(TimeIndexTest, replacesOldestEntriesAndIgnoresStaleOnes) {
+    auto timeIndex = TimeIndex::create(3);
+    ASSERT_TRUE(timeIndex);
+    for (Index i = 1; i <= 5; ++i) {
+        timeIndex->record(i * 100, START + i * std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(3u, timeIndex->size());
+    Clock::time_point time;
+    EXPECT_FALSE(timeIndex->getTime(299, &time));
+    ASSERT_TRUE(timeIndex->getTime(300, &time));
+    EXPECT_EQ(START + std::chrono::milliseconds(30), time);
+
+    // An index which does not advance is ignored, and a time which goes backwards is clamped.
+    timeIndex->record(500, START + std::chrono::milliseconds(60));
+    timeIndex->record(600, START);
+    EXPECT_EQ(3u, timeIndex->size());
+    ASSERT_TRUE(timeIndex->getTime(600, &time));
+    EXPECT_EQ(START + std::chrono::milliseconds(50), time);
+}
+
+/**
+ * Test that, over an hour of simulated capture with scheduling jitter and a drifting microphone clock, the index of a
+ * sample found by its capture time is never off by more than the jitter, and that the error does not grow with time.
+ */
+TEST(TimeIndexTest, errorIsBoundedByJitterWithoutDrift) {
+    const size_t capacity = 64;
+    const Index writes = 60 * 60 * 100;
+    const Index maxError = SAMPLE_RATE_HZ * MAX_JITTER.count() / 1000000 + 1;
+    auto timeIndex = TimeIndex::create(capacity);
+    ASSERT_TRUE(timeIndex);
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int64_t> jitter(0, MAX_JITTER.count());
+    std::uniform_int_distribution<Index> position(0, (capacity - 2) * SAMPLES_PER_WRITE);
+    Index worstFirstMinute = 0;
+    Index worstLastMinute = 0;
+    for (Index write = 1; write <= writes; ++write) {
+        Index end = write * SAMPLES_PER_WRITE;
+        timeIndex->record(end, captureTime(end) + std::chrono::microseconds(jitter(generator)));
+        if (write < capacity) {
+            continue;
+        }
+
+        // Look up a sample the table still covers, and one captured since the last write.
+        Index sample = end - (capacity - 2) * SAMPLES_PER_WRITE + position(generator);
+        Index recent = end + position(generator) % SAMPLES_PER_WRITE;
+        for (Index expected : {sample, recent}) {
+            Index index = 0;
+            ASSERT_TRUE(timeIndex->getIndex(captureTime(expected), &index));
+            Index error = index > expected ? index - expected : expected - index;
+            ASSERT_LE(error, maxError) << "write=" << write << " expected=" << expected;
+            if (write < 60 * 100) {
+                worstFirstMinute = std::max(worstFirstMinute, error);
+            } else if (write > writes - 60 * 100) {
+                worstLastMinute = std::max(worstLastMinute, error);
+            }
+        }
+    }
+    EXPECT_LE(worstLastMinute, worstFirstMinute + 1);
+    std::cout << "Worst error over the first minute: " << worstFirstMinute
+              << " samples, over the last minute: " << worstLastMinute << " samples" << std::endl;
+}
+
+/// Test that mapping an index to a time and back gives the same index.
+TEST(TimeIndexTest, roundTrip) {
+    auto timeIndex = TimeIndex::create(16);
+    ASSERT_TRUE(timeIndex);
+    for (Index write = 1; write <= 16; ++write) {
+        timeIndex->record(write * SAMPLES_PER_WRITE, captureTime(write * SAMPLES_PER_WRITE));
+    }
+    for (Index sample = SAMPLES_PER_WRITE; sample <= 16 * SAMPLES_PER_WRITE; sample += 7) {
+        Clock::time_point time;
+        Index index = 0;
+        ASSERT_TRUE(timeIndex->getTime(sample, &time));
+        ASSERT_TRUE(timeIndex->getIndex(time, &index));
+        EXPECT_EQ(sample, index);
+    }
+}
+
+/// Test that a stream's writer records its writes in the stream's time index.
+TEST(TimeIndexTest, writerRecordsWrites) {
+    const size_t words = 1000;
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(InProcessSDS::calculateBufferSize(words, 2, 1));
+    std::shared_ptr<InProcessSDS> stream = InProcessSDS::create(buffer, 2, 1);
+    ASSERT_TRUE(stream);
+    EXPECT_FALSE(stream->getTimeIndex());
+    EXPECT_FALSE(stream->enableTimeIndex(1));
+    ASSERT_TRUE(stream->enableTimeIndex(8));
+    auto timeIndex = stream->getTimeIndex();
+    ASSERT_TRUE(timeIndex);
+
+    auto writer = stream->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+    std::vector<int16_t> samples(SAMPLES_PER_WRITE);
+    auto before = Clock::now();
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+    auto after = Clock::now();
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+    EXPECT_EQ(2u, timeIndex->size());
+
+    Clock::time_point time;
+    ASSERT_TRUE(timeIndex->getTime(SAMPLES_PER_WRITE, &time));
+    EXPECT_LE(before, time);
+    EXPECT_GE(after, time);
+    // The writes are back to back, so a later time may already be more than a write interval after the last.
+    Index index = 0;
+    ASSERT_TRUE(timeIndex->getTime(2 * SAMPLES_PER_WRITE, &time));
+    ASSERT_TRUE(timeIndex->getIndex(time, &index));
+    EXPECT_EQ(2 * SAMPLES_PER_WRITE, index);
+}
+
+/// Measure what the time index adds to each write, and what a lookup costs.
+TEST(TimeIndexTest, overhead) {
+    const size_t words = 16000;
+    const int writes = 200000;
+    std::vector<int16_t> samples(SAMPLES_PER_WRITE);
+    double nanosecondsPerWrite[2];
+    for (int indexed = 0; indexed < 2; ++indexed) {
+        auto buffer = std::make_shared<InProcessSDS::Buffer>(InProcessSDS::calculateBufferSize(words, 2, 1));
+        std::shared_ptr<InProcessSDS> stream = InProcessSDS::create(buffer, 2, 1);
+        ASSERT_TRUE(stream);
+        if (indexed) {
+            ASSERT_TRUE(stream->enableTimeIndex(1000));
+        }
+        auto writer = stream->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE);
+        ASSERT_TRUE(writer);
+        auto start = Clock::now();
+        for (int i = 0; i < writes; ++i) {
+            writer->write(samples.data(), samples.size());
+        }
+        nanosecondsPerWrite[indexed] =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() /
+            static_cast<double>(writes);
+    }
+
+    auto timeIndex = TimeIndex::create(1000);
+    ASSERT_TRUE(timeIndex);
+    for (Index write = 1; write <= 1000; ++write) {
+        timeIndex->record(write * SAMPLES_PER_WRITE, captureTime(write * SAMPLES_PER_WRITE));
+    }
+    const int lookups = 200000;
+    Index sum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        Index index = 0;
+        timeIndex->getIndex(captureTime(SAMPLES_PER_WRITE + (i % 1000) * 157), &index);
+        sum += index;
+    }
+    double nanosecondsPerLookup =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() /
+        static_cast<double>(lookups);
+    EXPECT_GT(sum, 0u);
+    std::cout << "Write of " << SAMPLES_PER_WRITE << " samples: " << nanosecondsPerWrite[0] << " ns, "
+              << nanosecondsPerWrite[1] << " ns with a time index; lookup in 1000 entries: " << nanosecondsPerLookup
+              << " ns" << std::endl;
+}
+
+}  // namespace test
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -22,6 +22,8 @@
 #include <AFML/AudioActivityTracker.h>
 #include <AFML/FocusManager.h>
 #include <AFML/VisualActivityTracker.h>
+#include <AIP/AudioEncoder.h>
+#include <AIP/EndOfSpeechDetector.h>
 #include <AIP/AudioInputProcessor.h>
 #include <AIP/AudioProvider.h>
 #include <Alerts/AlertsCapabilityAgent.h>
@@ -41,6 +43,7 @@
 #include <AVSCommon/SDKInterfaces/TemplateRuntimeObserverInterface.h>
 #include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
+#include <AVSCommon/Utils/Timing/StartupProfiler.h>
 #include <CertifiedSender/CertifiedSender.h>
 #include <CertifiedSender/SQLiteMessageStorage.h>
 #include <ExternalMediaPlayer/ExternalMediaPlayer.h>
@@ -98,6 +101,8 @@ public:
      * @param firmwareVersion The firmware version to report to @c AVS or @c INVALID_FIRMWARE_VERSION.
      * @param sendSoftwareInfoOnConnected Whether to send SoftwareInfo upon connecting to @c AVS.
      * @param softwareInfoSenderObserver Object to receive notifications about sending SoftwareInfo.
+     * @param audioEncoder An optional stage to encode the audio of Recognize events before it is uploaded.
+     * @param endOfSpeechDetector An optional stage to end the upload of Recognize events when the user stops speaking.
      * @return A @c std::unique_ptr to a DefaultClient if all went well or @c nullptr otherwise.
      *
      * TODO: ACSDK-384 Remove the requirement of clients having to wait for authorization before making the connect()
@@ -132,7 +137,9 @@ public:
             avsCommon::sdkInterfaces::softwareInfo::INVALID_FIRMWARE_VERSION,
         bool sendSoftwareInfoOnConnected = false,
         std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver =
-            nullptr);
+            nullptr,
+        std::shared_ptr<capabilityAgents::aip::AudioEncoder> audioEncoder = nullptr,
+        std::shared_ptr<capabilityAgents::aip::EndOfSpeechDetector> endOfSpeechDetector = nullptr);
 
     /**
      * Connects the client to AVS. Note that users should first wait for the authorization state to be set to REFRESHED
@@ -339,6 +346,13 @@ public:
      */
     std::shared_ptr<registrationManager::RegistrationManager> getRegistrationManager();
 
+    /**
+     * Get a report of how long each stage of @c initialize() took.
+     *
+     * @return A human readable report with one line per stage.
+     */
+    std::string getStartupReport() const;
+
     /**
      * Update the firmware version.
      *
@@ -436,6 +450,8 @@ private:
      * @param firmwareVersion The firmware version to report to @c AVS or @c INVALID_FIRMWARE_VERSION.
      * @param sendSoftwareInfoOnConnected Whether to send SoftwareInfo upon connecting to @c AVS.
      * @param softwareInfoSenderObserver Object to receive notifications about sending SoftwareInfo.
+     * @param audioEncoder An optional stage to encode the audio of Recognize events before it is uploaded.
+     * @param endOfSpeechDetector An optional stage to end the upload of Recognize events when the user stops speaking.
      * @return Whether the SDK was initialized properly.
      */
     bool initialize(
@@ -464,7 +480,9 @@ private:
         bool isGuiSupported,
         avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
         bool sendSoftwareInfoOnConnected,
-        std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver);
+        std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+        std::shared_ptr<capabilityAgents::aip::AudioEncoder> audioEncoder,
+        std::shared_ptr<capabilityAgents::aip::EndOfSpeechDetector> endOfSpeechDetector);
 
     /// The directive sequencer.
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
@@ -537,6 +555,9 @@ private:
 
     /// The RegistrationManager used to control customer registration.
     std::shared_ptr<registrationManager::RegistrationManager> m_registrationManager;
+
+    /// Records how long each stage of @c initialize() takes.
+    avsCommon::utils::timing::StartupProfiler m_startupProfiler;
 };
 
 }  // namespace defaultClient
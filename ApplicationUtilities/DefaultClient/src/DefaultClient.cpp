@@ -25,6 +25,8 @@
 #include <System/EndpointHandler.h>
 #include <System/UserInactivityMonitor.h>
 
+#include <future>
+
 namespace alexaClientSDK {
 namespace defaultClient {
 
@@ -64,7 +66,9 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
     bool isGuiSupported,
     avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
     bool sendSoftwareInfoOnConnected,
-    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver) {
+    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+    std::shared_ptr<capabilityAgents::aip::AudioEncoder> audioEncoder,
+    std::shared_ptr<capabilityAgents::aip::EndOfSpeechDetector> endOfSpeechDetector) {
     std::unique_ptr<DefaultClient> defaultClient(new DefaultClient());
     if (!defaultClient->initialize(
             externalMusicProviderMediaPlayers,
@@ -89,7 +93,9 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
             isGuiSupported,
             firmwareVersion,
             sendSoftwareInfoOnConnected,
-            softwareInfoSenderObserver)) {
+            softwareInfoSenderObserver,
+            audioEncoder,
+            endOfSpeechDetector)) {
         return nullptr;
     }
 
@@ -122,7 +128,9 @@ bool DefaultClient::initialize(
     bool isGuiSupported,
     avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
     bool sendSoftwareInfoOnConnected,
-    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver) {
+    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+    std::shared_ptr<capabilityAgents::aip::AudioEncoder> audioEncoder,
+    std::shared_ptr<capabilityAgents::aip::EndOfSpeechDetector> endOfSpeechDetector) {
     if (!audioFactory) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "nullAudioFactory"));
         return false;
@@ -189,18 +197,7 @@ bool DefaultClient::initialize(
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateConnectionManager"));
         return false;
     }
-
-    /*
-     * Creating our certified sender - this component guarantees that messages given to it (expected to be JSON
-     * formatted AVS Events) will be sent to AVS.  This nicely decouples strict message sending from components which
-     * require an Event be sent, even in conditions when there is no active AVS connection.
-     */
-    m_certifiedSender = certifiedSender::CertifiedSender::create(
-        m_connectionManager, m_connectionManager, messageStorage, customerDataManager);
-    if (!m_certifiedSender) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateCertifiedSender"));
-        return false;
-    }
+    m_startupProfiler.markStage("connectionManager");
 
     /*
      * Creating the Exception Sender - This component helps the SDK send exceptions when it is unable to handle a
@@ -232,6 +229,7 @@ bool DefaultClient::initialize(
         std::make_shared<adsl::MessageInterpreter>(m_exceptionSender, m_directiveSequencer, attachmentManager);
 
     m_connectionManager->addMessageObserver(messageInterpreter);
+    m_startupProfiler.markStage("directiveSequencer");
 
     /*
      * Creating the Registration Manager - This component is responsible for implementing any customer registration
@@ -266,6 +264,76 @@ bool DefaultClient::initialize(
      */
     m_audioFocusManager =
         std::make_shared<afml::FocusManager>(afml::FocusManager::DEFAULT_AUDIO_CHANNELS, m_audioActivityTracker);
+    m_startupProfiler.markStage("focusManager");
+
+    /*
+     * The components below open their storage (and migrate it if needed) when they are created, which makes them the
+     * slowest part of initialization.  They do not depend on each other (except for the Alerts Capability Agent,
+     * which needs the Certified Sender), nor on any of the components created after them, so they are created
+     * concurrently with the rest of the initialization and collected before they are first used.
+     */
+
+    /*
+     * Creating our certified sender - this component guarantees that messages given to it (expected to be JSON
+     * formatted AVS Events) will be sent to AVS.  This nicely decouples strict message sending from components which
+     * require an Event be sent, even in conditions when there is no active AVS connection.
+     *
+     * Creating the Alerts Capability Agent - This component is the Capability Agent that implements the Alerts
+     * interface of AVS.
+     */
+    auto alertsFuture = std::async(std::launch::async, [&] {
+        m_certifiedSender = m_startupProfiler.measureStage("certifiedSender", [&] {
+            return certifiedSender::CertifiedSender::create(
+                m_connectionManager, m_connectionManager, messageStorage, customerDataManager);
+        });
+        if (!m_certifiedSender) {
+            return;
+        }
+        m_alertsCapabilityAgent = m_startupProfiler.measureStage("alertsCapabilityAgent", [&] {
+            return capabilityAgents::alerts::AlertsCapabilityAgent::create(
+                m_connectionManager,
+                m_certifiedSender,
+                m_audioFocusManager,
+                contextManager,
+                m_exceptionSender,
+                alertStorage,
+                audioFactory->alerts(),
+                capabilityAgents::alerts::renderer::Renderer::create(alertsMediaPlayer),
+                customerDataManager);
+        });
+    });
+
+    /*
+     * Creating the Notifications Capability Agent - This component is the Capability Agent that implements the
+     * Notifications interface of AVS.
+     */
+    auto notificationsFuture = std::async(std::launch::async, [&] {
+        m_notificationsCapabilityAgent = m_startupProfiler.measureStage("notificationsCapabilityAgent", [&] {
+            return capabilityAgents::notifications::NotificationsCapabilityAgent::create(
+                notificationsStorage,
+                capabilityAgents::notifications::NotificationRenderer::create(notificationsMediaPlayer),
+                contextManager,
+                m_exceptionSender,
+                audioFactory->notifications(),
+                customerDataManager);
+        });
+    });
+
+    /*
+     * Creating the Setting object - This component implements the Setting interface of AVS.
+     */
+    std::shared_ptr<capabilityAgents::settings::SettingsUpdatedEventSender> settingsUpdatedEventSender;
+    auto settingsFuture = std::async(std::launch::async, [&] {
+        settingsUpdatedEventSender =
+            alexaClientSDK::capabilityAgents::settings::SettingsUpdatedEventSender::create(m_connectionManager);
+        if (!settingsUpdatedEventSender) {
+            return;
+        }
+        m_settings = m_startupProfiler.measureStage("settings", [&] {
+            return capabilityAgents::settings::Settings::create(
+                settingsStorage, {settingsUpdatedEventSender}, customerDataManager);
+        });
+    });
 
     /*
      * Creating the User Inactivity Monitor - This component is responsibly for updating AVS of user inactivity as
@@ -289,7 +357,10 @@ bool DefaultClient::initialize(
         m_audioFocusManager,
         m_dialogUXStateAggregator,
         m_exceptionSender,
-        userInactivityMonitor);
+        userInactivityMonitor,
+        capabilityAgents::aip::AudioProvider::null(),
+        audioEncoder,
+        endOfSpeechDetector);
     if (!m_audioInputProcessor) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioInputProcessor"));
         return false;
@@ -352,20 +423,13 @@ bool DefaultClient::initialize(
         return false;
     }
 
-    /*
-     * Creating the Alerts Capability Agent - This component is the Capability Agent that implements the Alerts
-     * interface of AVS.
-     */
-    m_alertsCapabilityAgent = capabilityAgents::alerts::AlertsCapabilityAgent::create(
-        m_connectionManager,
-        m_certifiedSender,
-        m_audioFocusManager,
-        contextManager,
-        m_exceptionSender,
-        alertStorage,
-        audioFactory->alerts(),
-        capabilityAgents::alerts::renderer::Renderer::create(alertsMediaPlayer),
-        customerDataManager);
+    m_startupProfiler.markStage("audioPlayer");
+
+    alertsFuture.wait();
+    if (!m_certifiedSender) {
+        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateCertifiedSender"));
+        return false;
+    }
     if (!m_alertsCapabilityAgent) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAlertsCapabilityAgent"));
         return false;
@@ -375,39 +439,22 @@ bool DefaultClient::initialize(
 
     addConnectionObserver(m_dialogUXStateAggregator);
 
-    /*
-     * Creating the Notifications Capability Agent - This component is the Capability Agent that implements the
-     * Notifications interface of AVS.
-     */
-    m_notificationsCapabilityAgent = capabilityAgents::notifications::NotificationsCapabilityAgent::create(
-        notificationsStorage,
-        capabilityAgents::notifications::NotificationRenderer::create(notificationsMediaPlayer),
-        contextManager,
-        m_exceptionSender,
-        audioFactory->notifications(),
-        customerDataManager);
+    notificationsFuture.wait();
     if (!m_notificationsCapabilityAgent) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateNotificationsCapabilityAgent"));
         return false;
     }
 
-    std::shared_ptr<capabilityAgents::settings::SettingsUpdatedEventSender> settingsUpdatedEventSender =
-        alexaClientSDK::capabilityAgents::settings::SettingsUpdatedEventSender::create(m_connectionManager);
+    settingsFuture.wait();
     if (!settingsUpdatedEventSender) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObserver"));
         return false;
     }
-
-    /*
-     * Creating the Setting object - This component implements the Setting interface of AVS.
-     */
-    m_settings = capabilityAgents::settings::Settings::create(
-        settingsStorage, {settingsUpdatedEventSender}, customerDataManager);
-
     if (!m_settings) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObject"));
         return false;
     }
+    m_startupProfiler.markStage("storageBackedCapabilityAgents");
 
     std::vector<std::shared_ptr<avsCommon::sdkInterfaces::SpeakerInterface>> allSpeakers = {
         speakSpeaker, audioSpeaker, alertsSpeaker, notificationsSpeaker};
@@ -575,6 +622,16 @@ bool DefaultClient::initialize(
                         .d("directiveHandler", "NotificationsCapabilityAgent"));
         return false;
     }
+    m_startupProfiler.markStage("directiveHandlerRegistration");
+
+    for (const auto& stage : m_startupProfiler.getStages()) {
+        ACSDK_INFO(LX("startupStage")
+                       .d("name", stage.name)
+                       .d("startMs", stage.start.count())
+                       .d("durationMs", stage.duration.count()));
+    }
+    ACSDK_INFO(LX("initialized").d("elapsedMs", m_startupProfiler.getElapsed().count()));
+
     return true;
 }
 
@@ -705,6 +762,10 @@ std::shared_ptr<registrationManager::RegistrationManager> DefaultClient::getRegi
     return m_registrationManager;
 }
 
+std::string DefaultClient::getStartupReport() const {
+    return m_startupProfiler.getReport();
+}
+
 void DefaultClient::addSpeakerManagerObserver(
     std::shared_ptr<avsCommon::sdkInterfaces::SpeakerManagerObserverInterface> observer) {
     m_speakerManager->addSpeakerManagerObserver(observer);
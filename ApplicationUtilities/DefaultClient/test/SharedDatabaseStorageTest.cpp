@@ -0,0 +1,181 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SharedDatabaseStorageTest.cpp
+
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <Alerts/Storage/SQLiteAlertStorage.h>
+#include <AVSCommon/SDKInterfaces/Audio/AlertsAudioFactoryInterface.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <CertifiedSender/SQLiteMessageStorage.h>
+#include <Notifications/SQLiteNotificationsStorage.h>
+#include <Settings/SQLiteSettingStorage.h>
+
+namespace alexaClientSDK {
+namespace defaultClient {
+namespace test {
+
+using namespace avsCommon::sdkInterfaces::audio;
+using namespace avsCommon::utils::configuration;
+
+/// The template of the database file, which mkstemp() fills in.
+static const std::string DB_FILE_TEMPLATE = "/tmp/SharedDatabaseStorageTest-XXXXXX";
+
+/// The number of stores sharing the database file.
+static const int NUM_STORES = 4;
+
+/// Audio factories for the alerts, which the alert storage requires but this test never plays.
+class TestAlertsAudioFactory : public AlertsAudioFactoryInterface {
+public:
+    std::function<std::unique_ptr<std::istream>()> alarmDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> alarmShort() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> timerDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> timerShort() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> reminderDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> reminderShort() const override {
+        return audio;
+    }
+
+private:
+    /// Produces the audio of every alert.
+    static std::unique_ptr<std::istream> audio() {
+        return std::unique_ptr<std::stringstream>(new std::stringstream("audio"));
+    }
+};
+
+/// Test harness for the SQLite stores which @c DefaultClient creates concurrently on one database file.
+class SharedDatabaseStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// The path of the test database.
+    std::string m_dbFilePath;
+};
+
+void SharedDatabaseStorageTest::SetUp() {
+    std::vector<char> path(DB_FILE_TEMPLATE.begin(), DB_FILE_TEMPLATE.end());
+    path.push_back('\0');
+    int fd = mkstemp(path.data());
+    ASSERT_GE(fd, 0);
+    close(fd);
+    m_dbFilePath = path.data();
+    // The stores create the database, so only the unique name is kept.
+    std::remove(m_dbFilePath.c_str());
+
+    std::stringstream config;
+    config << "{"
+           << "\"alertsCapabilityAgent\":{\"databaseFilePath\":\"" << m_dbFilePath << "\"},"
+           << "\"certifiedSender\":{\"databaseFilePath\":\"" << m_dbFilePath << "\"},"
+           << "\"notifications\":{\"databaseFilePath\":\"" << m_dbFilePath << "\"},"
+           << "\"settings\":{\"databaseFilePath\":\"" << m_dbFilePath << "\"}"
+           << "}";
+    ConfigurationNode::uninitialize();
+    ASSERT_TRUE(ConfigurationNode::initialize({&config}));
+}
+
+void SharedDatabaseStorageTest::TearDown() {
+    ConfigurationNode::uninitialize();
+    std::remove(m_dbFilePath.c_str());
+}
+
+/**
+ * Test that the four stores sharing a database file can each open it, or create it if it is missing, concurrently
+ * on a fresh path, as they do when @c DefaultClient starts for the first time.
+ */
+TEST_F(SharedDatabaseStorageTest, concurrentOpenOrCreateOnFreshPath) {
+    auto audioFactory = std::make_shared<TestAlertsAudioFactory>();
+    auto alertStorage = capabilityAgents::alerts::storage::SQLiteAlertStorage::create(
+        ConfigurationNode::getRoot(), audioFactory);
+    auto messageStorage = certifiedSender::SQLiteMessageStorage::create(ConfigurationNode::getRoot());
+    auto notificationsStorage =
+        capabilityAgents::notifications::SQLiteNotificationsStorage::create(ConfigurationNode::getRoot());
+    auto settingStorage = capabilityAgents::settings::SQLiteSettingStorage::create(ConfigurationNode::getRoot());
+    ASSERT_TRUE(alertStorage && messageStorage && notificationsStorage && settingStorage);
+
+    std::atomic<int> numOpened{0};
+    std::vector<std::thread> threads;
+    std::vector<char> succeeded(NUM_STORES, false);
+    auto openOrCreate = [&numOpened, &succeeded](
+                            size_t index, std::function<bool()> open, std::function<bool()> createDatabase) {
+        bool opened = open();
+        // Hold back the creation until every store has tried to open, so that all but one find the file created
+        // by another store when they create it.
+        ++numOpened;
+        while (numOpened < NUM_STORES) {
+            std::this_thread::yield();
+        }
+        succeeded[index] = opened || createDatabase();
+    };
+    threads.emplace_back(
+        openOrCreate,
+        0,
+        [&alertStorage] { return alertStorage->open(); },
+        [&alertStorage] { return alertStorage->createDatabase(); });
+    threads.emplace_back(
+        openOrCreate,
+        1,
+        [&messageStorage] { return messageStorage->open(); },
+        [&messageStorage] { return messageStorage->createDatabase(); });
+    threads.emplace_back(
+        openOrCreate,
+        2,
+        [&notificationsStorage] { return notificationsStorage->open(); },
+        [&notificationsStorage] { return notificationsStorage->createDatabase(); });
+    threads.emplace_back(
+        openOrCreate,
+        3,
+        [&settingStorage] { return settingStorage->open(); },
+        [&settingStorage] { return settingStorage->createDatabase(); });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(succeeded[0]) << "alert storage";
+    EXPECT_TRUE(succeeded[1]) << "message storage";
+    EXPECT_TRUE(succeeded[2]) << "notifications storage";
+    EXPECT_TRUE(succeeded[3]) << "setting storage";
+
+    alertStorage->close();
+    messageStorage->close();
+    notificationsStorage->close();
+    settingStorage->close();
+}
+
+}  // namespace test
+}  // namespace defaultClient
+}  // namespace alexaClientSDK
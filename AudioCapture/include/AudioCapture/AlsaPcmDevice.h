@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_ALSAPCMDEVICE_H_
+#define ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_ALSAPCMDEVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "AudioCapture/PcmDeviceInterface.h"
+
+/// The ALSA PCM handle, as declared by <alsa/asoundlib.h>.
+typedef struct _snd_pcm snd_pcm_t;
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/**
+ * A @c PcmDeviceInterface over an ALSA capture PCM opened for mmap access, so that frames are read straight out of the
+ * buffer the sound card's DMA writes to.  Timestamps are taken by ALSA on @c CLOCK_MONOTONIC, the clock which
+ * @c std::chrono::steady_clock reads on Linux.
+ */
+class AlsaPcmDevice : public PcmDeviceInterface {
+public:
+    /**
+     * Opens an ALSA capture PCM.
+     *
+     * @param name The name of the PCM, such as "default" or "hw:0,0".
+     * @param config The settings to ask for.  The rate and channels must be supported exactly; the period and buffer
+     *     sizes are rounded to what the hardware supports, which @c getConfig() reports.
+     * @return The device, or @c nullptr if the PCM could not be opened or does not support the settings.
+     */
+    static std::unique_ptr<AlsaPcmDevice> create(const std::string& name, const Config& config);
+
+    /// Destructor.  Closes the PCM.
+    ~AlsaPcmDevice() override;
+
+    /// @name PcmDeviceInterface Functions
+    /// @{
+    Config getConfig() const override;
+    bool start() override;
+    bool stop() override;
+    int wait(std::chrono::milliseconds timeout) override;
+    ssize_t available(std::chrono::steady_clock::time_point* timestamp) override;
+    ssize_t mmapBegin(const int16_t** frames, size_t maxFrames) override;
+    ssize_t mmapCommit(size_t frames) override;
+    bool recover(int error) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param pcm The PCM, which the device closes.
+     * @param config The settings the PCM runs at.
+     */
+    AlsaPcmDevice(snd_pcm_t* pcm, const Config& config);
+
+    /// The PCM.
+    snd_pcm_t* m_pcm;
+
+    /// The settings the PCM runs at.
+    const Config m_config;
+
+    /// The offset in the ring buffer of the frames got by the last @c mmapBegin(), which @c mmapCommit() hands back.
+    unsigned long m_mmapOffset;
+};
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_ALSAPCMDEVICE_H_
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEAUDIOSOURCE_H_
+#define ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEAUDIOSOURCE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/**
+ * Streams a recording into an @c AudioInputStream in place of a microphone, so that the audio path can be driven from
+ * recorded audio for load and regression tests.  The file holds interleaved 16-bit little-endian samples, either raw or
+ * in a WAV file.
+ *
+ * The file is written in chunks, paced at a multiple of real time or as fast as the writer can go, and may be played
+ * several times over with silence between plays.  Dropouts can be injected, in which a stretch of audio takes its time
+ * but is lost rather than written, as when capture stalls.
+ *
+ * Like a microphone, the source never waits for readers: a reader which falls more than the stream's worth of audio
+ * behind is overrun.  Each word of the stream is one frame, holding a sample of every channel.
+ */
+class FileAudioSource {
+public:
+    /// The settings of a source.
+    struct Config {
+        /// Constructor, which sets the defaults: 16 kHz mono, played once in real time, in 10 ms chunks.
+        Config();
+
+        /// The rate of the samples.  If the file is a WAV file, its rate must match.
+        unsigned int sampleRateHz;
+        /// The number of channels.  If the file is a WAV file, its channels must match.
+        unsigned int numChannels;
+        /// How many times faster than real time to write the audio, or 0 to write it as fast as possible.
+        double speed;
+        /// The number of times to play the file, or 0 to play it until the source is stopped.
+        unsigned int loops;
+        /// The amount of audio written at a time.
+        std::chrono::milliseconds chunkDuration;
+        /// The silence written after each play of the file.
+        std::chrono::milliseconds gapDuration;
+        /// The amount of audio between dropouts, or 0 for no dropouts.
+        std::chrono::milliseconds dropoutInterval;
+        /// The amount of audio each dropout loses.
+        std::chrono::milliseconds dropoutDuration;
+    };
+
+    /// What the source has written.
+    struct Statistics {
+        /// The number of words written to the stream, including silence.
+        uint64_t wordsWritten;
+        /// The number of times words were written to the stream.
+        uint64_t writes;
+        /// The number of plays of the file which have been written.
+        uint64_t loopsCompleted;
+        /// The number of dropouts.
+        uint64_t dropouts;
+        /// The number of words lost to dropouts.
+        uint64_t wordsDropped;
+    };
+
+    /**
+     * Notified on the source's thread when a play of the file is about to be written.
+     *
+     * @param loop The number of plays already written.
+     * @param begin The index in the stream the play begins at.
+     */
+    using LoopObserver = std::function<void(uint64_t loop, avsCommon::avs::AudioInputStream::Index begin)>;
+
+    /**
+     * Creates a @c FileAudioSource.
+     *
+     * @param path The path of the file.
+     * @param stream The stream to write, whose words must hold one 16-bit sample of each channel.
+     * @param config The settings of the source.
+     * @param observer Notified as each play of the file begins, or @c nullptr.
+     * @return The source, or @c nullptr if the file cannot be read, the settings are invalid, or the stream is invalid
+     *     or already has a writer.
+     */
+    static std::unique_ptr<FileAudioSource> create(
+        const std::string& path,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        const Config& config = Config(),
+        LoopObserver observer = nullptr);
+
+    /// Destructor.  Stops streaming.
+    ~FileAudioSource();
+
+    /**
+     * Starts streaming the file from its beginning.
+     *
+     * @return Whether streaming started, or was already started.
+     */
+    bool startStreamingMicrophoneData();
+
+    /**
+     * Stops streaming the file.
+     *
+     * @return Whether streaming stopped, or was already stopped.
+     */
+    bool stopStreamingMicrophoneData();
+
+    /**
+     * Checks whether the source is streaming.  Streaming stops by itself once every play of the file is written.
+     *
+     * @return Whether the source is streaming.
+     */
+    bool isStreaming() const;
+
+    /**
+     * Waits for streaming to stop.
+     *
+     * @param timeout How long to wait.
+     * @return Whether streaming stopped before the timeout.
+     */
+    bool waitUntilFinished(std::chrono::milliseconds timeout);
+
+    /**
+     * Gets the index in the stream the next word will be written at.
+     *
+     * @return The index.
+     */
+    avsCommon::avs::AudioInputStream::Index tell() const;
+
+    /**
+     * Gets the format of the stream.
+     *
+     * @return The format.
+     */
+    avsCommon::utils::AudioFormat getAudioFormat() const;
+
+    /**
+     * Gets what the source has written since it was created.
+     *
+     * @return The statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param samples The samples of the file.
+     * @param writer The writer of the stream.
+     * @param config The settings of the source.
+     * @param observer Notified as each play of the file begins, or @c nullptr.
+     */
+    FileAudioSource(
+        std::vector<int16_t> samples,
+        std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> writer,
+        const Config& config,
+        LoopObserver observer);
+
+    /// The loop of the streaming thread.
+    void streamLoop();
+
+    /**
+     * Writes frames to the stream a chunk at a time, paced and with dropouts as configured.
+     *
+     * @param frames The frames, or @c nullptr to write silence.
+     * @param numFrames The number of frames.
+     * @return Whether every frame was written or dropped before the source was stopped.
+     */
+    bool writeFrames(const int16_t* frames, size_t numFrames);
+
+    /// The samples of the file.
+    const std::vector<int16_t> m_samples;
+
+    /// The writer of the stream.
+    std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// The settings of the source.
+    const Config m_config;
+
+    /// Notified as each play of the file begins.
+    const LoopObserver m_observer;
+
+    /// A chunk of silence.
+    const std::vector<int16_t> m_silence;
+
+    /// The number of frames written or dropped since streaming started, which sets the pace.
+    uint64_t m_framesPlayed;
+
+    /// The number of frames written since the last dropout.
+    uint64_t m_framesSinceDropout;
+
+    /// The number of frames the current dropout has yet to lose.
+    uint64_t m_framesToDrop;
+
+    /// When streaming started.
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /// The index in the stream the next word will be written at.
+    std::atomic<avsCommon::avs::AudioInputStream::Index> m_writeIndex;
+
+    /// Serializes starting and stopping.
+    std::mutex m_startStopMutex;
+
+    /// Serializes access to the members below, and to @c m_statistics.
+    mutable std::mutex m_mutex;
+
+    /// Notified when the source stops or is asked to stop.
+    std::condition_variable m_stateChanged;
+
+    /// What the source has written.
+    Statistics m_statistics;
+
+    /// Whether the source is streaming.
+    bool m_streaming;
+
+    /// Whether the streaming thread should stop.
+    bool m_stopRequested;
+
+    /// The streaming thread.
+    std::thread m_thread;
+};
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEAUDIOSOURCE_H_
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEPCMDEVICE_H_
+#define ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEPCMDEVICE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AudioCapture/PcmDeviceInterface.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/**
+ * A @c PcmDeviceInterface which plays a file as if it were being captured, so that capture can be run without a sound
+ * card.  The file holds interleaved 16-bit little-endian samples, either raw or in a WAV file, and is looped.
+ *
+ * Like a sound card, the device makes a period of frames available each period in real time after @c start(), into a
+ * ring buffer of its own.  If the reader lets more than the ring buffer's worth of frames pile up, the device fails
+ * with @c -EPIPE until it is recovered, as ALSA does on an xrun.
+ */
+class FilePcmDevice : public PcmDeviceInterface {
+public:
+    /**
+     * Creates a @c FilePcmDevice.
+     *
+     * @param path The path of the file.
+     * @param config The settings of the device.  If the file is a WAV file, its rate and channels must match.
+     * @return The device, or @c nullptr if the file cannot be read or the settings are invalid.
+     */
+    static std::unique_ptr<FilePcmDevice> create(const std::string& path, const Config& config);
+
+    /**
+     * Makes the device fail with an xrun the next time it is waited on or asked what is available, as if the reader
+     * had fallen behind.
+     */
+    void injectXrun();
+
+    /**
+     * Makes the device fail with @c -ESTRPIPE the next time it is waited on or asked what is available, as if the
+     * system had been suspended.
+     */
+    void injectSuspend();
+
+    /// @name PcmDeviceInterface Functions
+    /// @{
+    Config getConfig() const override;
+    bool start() override;
+    bool stop() override;
+    int wait(std::chrono::milliseconds timeout) override;
+    ssize_t available(std::chrono::steady_clock::time_point* timestamp) override;
+    ssize_t mmapBegin(const int16_t** frames, size_t maxFrames) override;
+    ssize_t mmapCommit(size_t frames) override;
+    bool recover(int error) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param samples The samples of the file.
+     * @param config The settings of the device.
+     */
+    FilePcmDevice(std::vector<int16_t> samples, const Config& config);
+
+    /**
+     * Captures the periods which are due into the ring buffer.
+     *
+     * @return 0, @c -EPIPE if the ring buffer overflowed, or @c -ESTRPIPE if the device was suspended.
+     */
+    int capture();
+
+    /**
+     * Gets when a frame is captured.
+     *
+     * @param frame The number of frames captured since @c start() before the frame.
+     * @return The time.
+     */
+    std::chrono::steady_clock::time_point frameTime(uint64_t frame) const;
+
+    /// The samples of the file.
+    const std::vector<int16_t> m_samples;
+
+    /// The settings of the device.
+    const Config m_config;
+
+    /// The ring buffer.
+    std::vector<int16_t> m_ring;
+
+    /// Whether the device is capturing.
+    bool m_running;
+
+    /// The error the device fails with until it is recovered, or 0 if it has not failed.
+    int m_error;
+
+    /// The error injected for the device to fail with next, or 0 if none has been.
+    std::atomic<int> m_injectedError;
+
+    /// When capture started.
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /// The number of frames captured since capture started.
+    uint64_t m_captured;
+
+    /// The number of frames read since capture started.
+    uint64_t m_read;
+
+    /// The position in @c m_samples of the next frame to capture, in frames.
+    size_t m_filePosition;
+};
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_FILEPCMDEVICE_H_
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMCAPTURE_H_
+#define ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMCAPTURE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "AudioCapture/PcmDeviceInterface.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/**
+ * Captures a @c PcmDeviceInterface into an @c AudioInputStream, as the microphone of the SDK.  Each period is copied
+ * once, from the device's mapped ring buffer straight into the stream, on a thread which wakes when the device has a
+ * period ready; there is no intermediate buffer and no callback thread.
+ *
+ * Each word of the stream is one frame, holding a 16-bit sample of every channel.  If the capture thread falls so far
+ * behind that the device's ring buffer overflows, the device is recovered and capture carries on; the audio lost is not
+ * written, so it is missing from the stream.
+ */
+class PcmCapture {
+public:
+    /// What capture has done, and how long audio took to reach the stream.
+    struct Statistics {
+        /// The number of frames written to the stream.
+        uint64_t framesCaptured;
+        /// The number of times frames were written to the stream.
+        uint64_t writes;
+        /// The number of times the device's ring buffer overflowed, or the device was suspended.
+        uint64_t xruns;
+        /// The total, over every write, of the time from when the newest frame written was captured to the write.
+        std::chrono::nanoseconds totalLatency;
+        /// The longest time from when a frame was captured to when it was written.
+        std::chrono::nanoseconds maxLatency;
+    };
+
+    /**
+     * Creates a @c PcmCapture.
+     *
+     * @param device The device to capture.
+     * @param stream The stream to write, whose words must hold one 16-bit sample of each of the device's channels.
+     * @return The capture, or @c nullptr if the device or stream is invalid or the stream already has a writer.
+     */
+    static std::unique_ptr<PcmCapture> create(
+        std::shared_ptr<PcmDeviceInterface> device,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream);
+
+    /// Destructor.  Stops capturing.
+    ~PcmCapture();
+
+    /**
+     * Starts capturing into the stream.
+     *
+     * @return Whether capture started, or was already started.
+     */
+    bool startStreamingMicrophoneData();
+
+    /**
+     * Stops capturing into the stream.
+     *
+     * @return Whether capture stopped, or was already stopped.
+     */
+    bool stopStreamingMicrophoneData();
+
+    /**
+     * Checks whether capture is started.  Capture stops by itself if the device fails and cannot be recovered.
+     *
+     * @return Whether capture is started.
+     */
+    bool isStreaming() const;
+
+    /**
+     * Gets the format of the stream.
+     *
+     * @return The format.
+     */
+    avsCommon::utils::AudioFormat getAudioFormat() const;
+
+    /**
+     * Gets what capture has done since the capture was created.
+     *
+     * @return The statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param device The device to capture.
+     * @param writer The writer of the stream.
+     */
+    PcmCapture(
+        std::shared_ptr<PcmDeviceInterface> device,
+        std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> writer);
+
+    /// The loop of the capture thread.
+    void captureLoop();
+
+    /**
+     * Copies the frames which are available from the device into the stream.
+     *
+     * @return 0, or the negative errno the device failed with.
+     */
+    int transfer();
+
+    /**
+     * Recovers the device after it failed.
+     *
+     * @param error The negative errno the device failed with.
+     * @return Whether the device recovered.
+     */
+    bool recover(int error);
+
+    /// The device.
+    const std::shared_ptr<PcmDeviceInterface> m_device;
+
+    /// The writer of the stream.
+    std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// Serializes starting and stopping.
+    std::mutex m_startStopMutex;
+
+    /// Serializes access to @c m_statistics.
+    mutable std::mutex m_statisticsMutex;
+
+    /// What capture has done.
+    Statistics m_statistics;
+
+    /// Whether capture is started.
+    std::atomic<bool> m_streaming;
+
+    /// Whether the capture thread should stop.
+    std::atomic<bool> m_stopRequested;
+
+    /// The capture thread.
+    std::thread m_thread;
+};
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMCAPTURE_H_
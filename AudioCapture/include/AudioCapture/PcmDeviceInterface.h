@@ -0,0 +1,123 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMDEVICEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMDEVICEINTERFACE_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/**
+ * A capture device whose ring buffer is mapped into memory, as ALSA's mmap access gives.  Audio is read in place: the
+ * reader asks for the frames it can read with @c mmapBegin(), copies them out, and hands them back with
+ * @c mmapCommit(), so nothing is copied between the device's ring buffer and the reader's destination.
+ *
+ * Frames are interleaved 16-bit little-endian samples, one per channel.  Functions which can fail return a negative
+ * errno as ALSA does: @c -EPIPE if the reader fell so far behind that the ring buffer overflowed (an xrun), and
+ * @c -ESTRPIPE if the device was suspended.  Both are cleared with @c recover().
+ *
+ * A device is used from one thread at a time.
+ */
+class PcmDeviceInterface {
+public:
+    /// The settings of a device.
+    struct Config {
+        /// The sample rate.
+        unsigned int sampleRateHz;
+        /// The number of channels in a frame.
+        unsigned int numChannels;
+        /// The number of frames the device makes available at a time.
+        size_t periodFrames;
+        /// The number of frames the ring buffer holds, which should be a multiple of @c periodFrames.
+        size_t bufferFrames;
+    };
+
+    /// Destructor.
+    virtual ~PcmDeviceInterface() = default;
+
+    /**
+     * Gets the settings the device runs at, which may differ from those it was asked for where the hardware rounds
+     * the period and buffer sizes.
+     *
+     * @return The settings.
+     */
+    virtual Config getConfig() const = 0;
+
+    /**
+     * Starts capturing.
+     *
+     * @return Whether capture started.
+     */
+    virtual bool start() = 0;
+
+    /**
+     * Stops capturing, dropping any frames which have not been read.
+     *
+     * @return Whether capture stopped.
+     */
+    virtual bool stop() = 0;
+
+    /**
+     * Waits until at least a period of frames can be read.
+     *
+     * @param timeout How long to wait.
+     * @return 1 if a period can be read, 0 on timeout, or a negative errno.
+     */
+    virtual int wait(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * Gets the number of frames which can be read.
+     *
+     * @param[out] timestamp When the newest of the frames was captured, on @c std::chrono::steady_clock.
+     * @return The number of frames, or a negative errno.
+     */
+    virtual ssize_t available(std::chrono::steady_clock::time_point* timestamp) = 0;
+
+    /**
+     * Gets the oldest frames which can be read, in place in the ring buffer.  There may be fewer than are available,
+     * where they wrap around the end of the ring buffer.
+     *
+     * @param[out] frames The frames.
+     * @param maxFrames The most frames to get.
+     * @return The number of frames at @c frames, or a negative errno.
+     */
+    virtual ssize_t mmapBegin(const int16_t** frames, size_t maxFrames) = 0;
+
+    /**
+     * Hands back frames got by @c mmapBegin(), so that the device can capture into them again.
+     *
+     * @param frames The number of frames read, which is at most the number @c mmapBegin() returned.
+     * @return The number of frames handed back, or a negative errno.
+     */
+    virtual ssize_t mmapCommit(size_t frames) = 0;
+
+    /**
+     * Recovers from an xrun or a suspend, and restarts capture.  The frames which were lost are not made up.
+     *
+     * @param error The negative errno the device failed with.
+     * @return Whether the device recovered.
+     */
+    virtual bool recover(int error) = 0;
+};
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOCAPTURE_INCLUDE_AUDIOCAPTURE_PCMDEVICEINTERFACE_H_
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <alsa/asoundlib.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioCapture/AlsaPcmDevice.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AlsaPcmDevice");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * Logs a failed ALSA call.
+ *
+ * @param result The result of the call.
+ * @param call The name of the call.
+ * @return Whether the call succeeded.
+ */
+static bool succeeded(int result, const char* call) {
+    if (result < 0) {
+        ACSDK_ERROR(LX("alsaCallFailed").d("call", call).d("error", snd_strerror(result)));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Configures a PCM for mmap capture.
+ *
+ * @param pcm The PCM.
+ * @param config The settings to ask for.
+ * @param[out] actual The settings the PCM runs at.
+ * @return Whether the PCM supports the settings.
+ */
+static bool configure(snd_pcm_t* pcm, const PcmDeviceInterface::Config& config, PcmDeviceInterface::Config* actual) {
+    snd_pcm_hw_params_t* hwParams;
+    snd_pcm_hw_params_alloca(&hwParams);
+    snd_pcm_uframes_t periodFrames = config.periodFrames;
+    snd_pcm_uframes_t bufferFrames = config.bufferFrames;
+    if (!succeeded(snd_pcm_hw_params_any(pcm, hwParams), "snd_pcm_hw_params_any") ||
+        !succeeded(
+            snd_pcm_hw_params_set_access(pcm, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED),
+            "snd_pcm_hw_params_set_access") ||
+        !succeeded(
+            snd_pcm_hw_params_set_format(pcm, hwParams, SND_PCM_FORMAT_S16_LE), "snd_pcm_hw_params_set_format") ||
+        !succeeded(
+            snd_pcm_hw_params_set_channels(pcm, hwParams, config.numChannels), "snd_pcm_hw_params_set_channels") ||
+        !succeeded(snd_pcm_hw_params_set_rate(pcm, hwParams, config.sampleRateHz, 0), "snd_pcm_hw_params_set_rate") ||
+        !succeeded(
+            snd_pcm_hw_params_set_period_size_near(pcm, hwParams, &periodFrames, nullptr),
+            "snd_pcm_hw_params_set_period_size_near") ||
+        !succeeded(
+            snd_pcm_hw_params_set_buffer_size_near(pcm, hwParams, &bufferFrames),
+            "snd_pcm_hw_params_set_buffer_size_near") ||
+        !succeeded(snd_pcm_hw_params(pcm, hwParams), "snd_pcm_hw_params")) {
+        return false;
+    }
+
+    // Wake the reader a period at a time, and timestamp each update on the monotonic clock.
+    snd_pcm_sw_params_t* swParams;
+    snd_pcm_sw_params_alloca(&swParams);
+    if (!succeeded(snd_pcm_sw_params_current(pcm, swParams), "snd_pcm_sw_params_current") ||
+        !succeeded(
+            snd_pcm_sw_params_set_avail_min(pcm, swParams, periodFrames), "snd_pcm_sw_params_set_avail_min") ||
+        !succeeded(
+            snd_pcm_sw_params_set_tstamp_mode(pcm, swParams, SND_PCM_TSTAMP_ENABLE),
+            "snd_pcm_sw_params_set_tstamp_mode") ||
+        !succeeded(
+            snd_pcm_sw_params_set_tstamp_type(pcm, swParams, SND_PCM_TSTAMP_TYPE_MONOTONIC),
+            "snd_pcm_sw_params_set_tstamp_type") ||
+        !succeeded(snd_pcm_sw_params(pcm, swParams), "snd_pcm_sw_params")) {
+        return false;
+    }
+
+    *actual = config;
+    actual->periodFrames = periodFrames;
+    actual->bufferFrames = bufferFrames;
+    return true;
+}
+
+std::unique_ptr<AlsaPcmDevice> AlsaPcmDevice::create(const std::string& name, const Config& config) {
+    snd_pcm_t* pcm = nullptr;
+    if (!succeeded(snd_pcm_open(&pcm, name.c_str(), SND_PCM_STREAM_CAPTURE, 0), "snd_pcm_open")) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "openFailed").d("name", name));
+        return nullptr;
+    }
+    Config actual;
+    if (!configure(pcm, config, &actual)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedConfig")
+                        .d("name", name)
+                        .d("sampleRateHz", config.sampleRateHz)
+                        .d("numChannels", config.numChannels)
+                        .d("periodFrames", config.periodFrames)
+                        .d("bufferFrames", config.bufferFrames));
+        snd_pcm_close(pcm);
+        return nullptr;
+    }
+    ACSDK_INFO(LX("create")
+                   .d("name", name)
+                   .d("periodFrames", actual.periodFrames)
+                   .d("bufferFrames", actual.bufferFrames));
+    return std::unique_ptr<AlsaPcmDevice>(new AlsaPcmDevice(pcm, actual));
+}
+
+AlsaPcmDevice::~AlsaPcmDevice() {
+    snd_pcm_close(m_pcm);
+}
+
+PcmDeviceInterface::Config AlsaPcmDevice::getConfig() const {
+    return m_config;
+}
+
+bool AlsaPcmDevice::start() {
+    return succeeded(snd_pcm_prepare(m_pcm), "snd_pcm_prepare") && succeeded(snd_pcm_start(m_pcm), "snd_pcm_start");
+}
+
+bool AlsaPcmDevice::stop() {
+    return succeeded(snd_pcm_drop(m_pcm), "snd_pcm_drop");
+}
+
+int AlsaPcmDevice::wait(std::chrono::milliseconds timeout) {
+    return snd_pcm_wait(m_pcm, static_cast<int>(timeout.count()));
+}
+
+ssize_t AlsaPcmDevice::available(std::chrono::steady_clock::time_point* timestamp) {
+    auto frames = snd_pcm_avail_update(m_pcm);
+    if (frames < 0 || !timestamp) {
+        return frames;
+    }
+    snd_pcm_uframes_t timestampedFrames;
+    snd_htimestamp_t time;
+    if (0 == snd_pcm_htimestamp(m_pcm, &timestampedFrames, &time)) {
+        auto sinceEpoch = std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+        *timestamp = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(sinceEpoch));
+    } else {
+        *timestamp = std::chrono::steady_clock::now();
+    }
+    return frames;
+}
+
+ssize_t AlsaPcmDevice::mmapBegin(const int16_t** frames, size_t maxFrames) {
+    if (!frames) {
+        return -EINVAL;
+    }
+    const snd_pcm_channel_area_t* areas;
+    snd_pcm_uframes_t offset;
+    snd_pcm_uframes_t count = maxFrames;
+    auto result = snd_pcm_mmap_begin(m_pcm, &areas, &offset, &count);
+    if (result < 0) {
+        return result;
+    }
+    // With interleaved access every channel's area is the same buffer, starting at the first channel's samples.
+    m_mmapOffset = offset;
+    *frames = reinterpret_cast<const int16_t*>(
+        static_cast<const char*>(areas[0].addr) + areas[0].first / 8 + offset * areas[0].step / 8);
+    return count;
+}
+
+ssize_t AlsaPcmDevice::mmapCommit(size_t frames) {
+    return snd_pcm_mmap_commit(m_pcm, m_mmapOffset, frames);
+}
+
+bool AlsaPcmDevice::recover(int error) {
+    static const int silent = 1;
+    if (!succeeded(snd_pcm_recover(m_pcm, error, silent), "snd_pcm_recover")) {
+        return false;
+    }
+    /*
+     * An xrun, or a suspend the hardware cannot resume from, leaves the PCM prepared, and capture has to be started
+     * again. A resumed PCM is already running, and starting it again would fail.
+     */
+    if (SND_PCM_STATE_PREPARED == snd_pcm_state(m_pcm)) {
+        return succeeded(snd_pcm_start(m_pcm), "snd_pcm_start");
+    }
+    return true;
+}
+
+AlsaPcmDevice::AlsaPcmDevice(snd_pcm_t* pcm, const Config& config) : m_pcm{pcm}, m_config(config), m_mmapOffset{0} {
+}
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
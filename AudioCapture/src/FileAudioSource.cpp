@@ -0,0 +1,278 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioCapture/FileAudioSource.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("FileAudioSource");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of milliseconds in a second.
+static const unsigned int MILLISECONDS_PER_SECOND = 1000;
+
+/**
+ * Converts a duration to a number of frames.
+ *
+ * @param duration The duration.
+ * @param sampleRateHz The rate of the frames.
+ * @return The number of frames.
+ */
+static uint64_t toFrames(std::chrono::milliseconds duration, unsigned int sampleRateHz) {
+    return static_cast<uint64_t>(duration.count()) * sampleRateHz / MILLISECONDS_PER_SECOND;
+}
+
+FileAudioSource::Config::Config() :
+        sampleRateHz{16000},
+        numChannels{1},
+        speed{1.0},
+        loops{1},
+        chunkDuration{10},
+        gapDuration{0},
+        dropoutInterval{0},
+        dropoutDuration{0} {
+}
+
+std::unique_ptr<FileAudioSource> FileAudioSource::create(
+    const std::string& path,
+    std::shared_ptr<AudioInputStream> stream,
+    const Config& config,
+    LoopObserver observer) {
+    if (0 == config.sampleRateHz || 0 == config.numChannels || config.speed < 0.0 ||
+        0 == toFrames(config.chunkDuration, config.sampleRateHz) || config.gapDuration.count() < 0 ||
+        config.dropoutInterval.count() < 0 || config.dropoutDuration.count() < 0) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidConfig")
+                        .d("sampleRateHz", config.sampleRateHz)
+                        .d("numChannels", config.numChannels)
+                        .d("speed", config.speed)
+                        .d("chunkDurationMs", config.chunkDuration.count()));
+        return nullptr;
+    }
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (stream->getWordSize() != config.numChannels * sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "wordSizeMismatch")
+                        .d("wordSize", stream->getWordSize())
+                        .d("numChannels", config.numChannels));
+        return nullptr;
+    }
+    std::vector<int16_t> samples;
+    if (!audio::readPcmFile(path, config.sampleRateHz, config.numChannels, &samples)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "readFileFailed").d("path", path));
+        return nullptr;
+    }
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+    return std::unique_ptr<FileAudioSource>(
+        new FileAudioSource(std::move(samples), std::move(writer), config, std::move(observer)));
+}
+
+FileAudioSource::~FileAudioSource() {
+    stopStreamingMicrophoneData();
+    m_writer->close();
+}
+
+bool FileAudioSource::startStreamingMicrophoneData() {
+    std::lock_guard<std::mutex> startStopLock{m_startStopMutex};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_streaming) {
+            return true;
+        }
+    }
+    // The thread may have stopped by itself after writing every play of the file.
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_framesPlayed = 0;
+    m_framesSinceDropout = 0;
+    m_framesToDrop = 0;
+    m_startTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_streaming = true;
+        m_stopRequested = false;
+    }
+    m_thread = std::thread(&FileAudioSource::streamLoop, this);
+    return true;
+}
+
+bool FileAudioSource::stopStreamingMicrophoneData() {
+    std::lock_guard<std::mutex> startStopLock{m_startStopMutex};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stopRequested = true;
+    }
+    m_stateChanged.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    return true;
+}
+
+bool FileAudioSource::isStreaming() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_streaming;
+}
+
+bool FileAudioSource::waitUntilFinished(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_stateChanged.wait_for(lock, timeout, [this] { return !m_streaming; });
+}
+
+AudioInputStream::Index FileAudioSource::tell() const {
+    return m_writeIndex;
+}
+
+AudioFormat FileAudioSource::getAudioFormat() const {
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = m_config.sampleRateHz;
+    format.sampleSizeInBits = sizeof(int16_t) * CHAR_BIT;
+    format.numChannels = m_config.numChannels;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    return format;
+}
+
+FileAudioSource::Statistics FileAudioSource::getStatistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+FileAudioSource::FileAudioSource(
+    std::vector<int16_t> samples,
+    std::unique_ptr<AudioInputStream::Writer> writer,
+    const Config& config,
+    LoopObserver observer) :
+        m_samples(std::move(samples)),
+        m_writer{std::move(writer)},
+        m_config(config),
+        m_observer{std::move(observer)},
+        m_silence(toFrames(config.chunkDuration, config.sampleRateHz) * config.numChannels, 0),
+        m_framesPlayed{0},
+        m_framesSinceDropout{0},
+        m_framesToDrop{0},
+        m_writeIndex{m_writer->tell()},
+        m_statistics(),
+        m_streaming{false},
+        m_stopRequested{false} {
+}
+
+void FileAudioSource::streamLoop() {
+    ACSDK_DEBUG(LX("streamLoop").d("event", "started").d("speed", m_config.speed).d("loops", m_config.loops));
+    const size_t fileFrames = m_samples.size() / m_config.numChannels;
+    const size_t gapFrames = toFrames(m_config.gapDuration, m_config.sampleRateHz);
+    for (uint64_t loop = 0; 0 == m_config.loops || loop < m_config.loops; ++loop) {
+        if (m_observer) {
+            m_observer(loop, m_writeIndex);
+        }
+        if (!writeFrames(m_samples.data(), fileFrames) || !writeFrames(nullptr, gapFrames)) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_statistics.loopsCompleted;
+    }
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_streaming = false;
+    }
+    m_stateChanged.notify_all();
+    ACSDK_DEBUG(LX("streamLoop").d("event", "stopped"));
+}
+
+bool FileAudioSource::writeFrames(const int16_t* frames, size_t numFrames) {
+    const uint64_t chunkFrames = toFrames(m_config.chunkDuration, m_config.sampleRateHz);
+    const uint64_t dropoutIntervalFrames = toFrames(m_config.dropoutInterval, m_config.sampleRateHz);
+    const uint64_t dropoutFrames = toFrames(m_config.dropoutDuration, m_config.sampleRateHz);
+    const double framesPerSecond = m_config.sampleRateHz * m_config.speed;
+
+    size_t offset = 0;
+    while (offset < numFrames) {
+        if (dropoutIntervalFrames > 0 && dropoutFrames > 0 && 0 == m_framesToDrop &&
+            m_framesSinceDropout >= dropoutIntervalFrames) {
+            m_framesToDrop = dropoutFrames;
+            m_framesSinceDropout = 0;
+            std::lock_guard<std::mutex> lock{m_mutex};
+            ++m_statistics.dropouts;
+        }
+
+        size_t count = 0;
+        if (m_framesToDrop > 0) {
+            count = std::min<uint64_t>(numFrames - offset, m_framesToDrop);
+            m_framesToDrop -= count;
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_statistics.wordsDropped += count;
+        } else {
+            uint64_t limit = chunkFrames;
+            if (dropoutIntervalFrames > 0 && dropoutFrames > 0) {
+                limit = std::min(limit, dropoutIntervalFrames - m_framesSinceDropout);
+            }
+            count = std::min<uint64_t>(numFrames - offset, limit);
+            const int16_t* source = frames ? frames + offset * m_config.numChannels : m_silence.data();
+            auto written = m_writer->write(source, count);
+            if (written < 0) {
+                ACSDK_ERROR(LX("writeFramesFailed").d("reason", "writeFailed").d("error", written));
+                return false;
+            }
+            m_writeIndex = m_writer->tell();
+            m_framesSinceDropout += count;
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_statistics.wordsWritten += written;
+            ++m_statistics.writes;
+        }
+        offset += count;
+        m_framesPlayed += count;
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (m_config.speed > 0.0) {
+            auto due = m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                         std::chrono::duration<double>(m_framesPlayed / framesPerSecond));
+            m_stateChanged.wait_until(lock, due, [this] { return m_stopRequested; });
+        }
+        if (m_stopRequested) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
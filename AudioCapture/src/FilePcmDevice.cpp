@@ -0,0 +1,201 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioCapture/FilePcmDevice.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("FilePcmDevice");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::unique_ptr<FilePcmDevice> FilePcmDevice::create(const std::string& path, const Config& config) {
+    if (0 == config.sampleRateHz || 0 == config.numChannels || 0 == config.periodFrames ||
+        config.bufferFrames < config.periodFrames) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidConfig")
+                        .d("sampleRateHz", config.sampleRateHz)
+                        .d("numChannels", config.numChannels)
+                        .d("periodFrames", config.periodFrames)
+                        .d("bufferFrames", config.bufferFrames));
+        return nullptr;
+    }
+    std::vector<int16_t> samples;
+    if (!avsCommon::utils::audio::readPcmFile(path, config.sampleRateHz, config.numChannels, &samples)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "readFileFailed").d("path", path));
+        return nullptr;
+    }
+    return std::unique_ptr<FilePcmDevice>(new FilePcmDevice(std::move(samples), config));
+}
+
+void FilePcmDevice::injectXrun() {
+    m_injectedError = -EPIPE;
+}
+
+void FilePcmDevice::injectSuspend() {
+    m_injectedError = -ESTRPIPE;
+}
+
+PcmDeviceInterface::Config FilePcmDevice::getConfig() const {
+    return m_config;
+}
+
+bool FilePcmDevice::start() {
+    m_running = true;
+    m_error = 0;
+    m_startTime = std::chrono::steady_clock::now();
+    m_captured = 0;
+    m_read = 0;
+    return true;
+}
+
+bool FilePcmDevice::stop() {
+    m_running = false;
+    m_error = 0;
+    return true;
+}
+
+int FilePcmDevice::wait(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto result = capture();
+        if (result < 0) {
+            return result;
+        }
+        if (m_captured - m_read >= m_config.periodFrames) {
+            return 1;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return 0;
+        }
+        std::this_thread::sleep_until(std::min(deadline, frameTime(m_captured + m_config.periodFrames)));
+    }
+}
+
+ssize_t FilePcmDevice::available(std::chrono::steady_clock::time_point* timestamp) {
+    auto result = capture();
+    if (result < 0) {
+        return result;
+    }
+    if (timestamp) {
+        *timestamp = frameTime(m_captured);
+    }
+    return m_captured - m_read;
+}
+
+ssize_t FilePcmDevice::mmapBegin(const int16_t** frames, size_t maxFrames) {
+    if (!m_running) {
+        return -EBADFD;
+    }
+    if (m_error < 0) {
+        return m_error;
+    }
+    if (!frames) {
+        return -EINVAL;
+    }
+    size_t offset = m_read % m_config.bufferFrames;
+    size_t count = std::min<uint64_t>({m_captured - m_read, maxFrames, m_config.bufferFrames - offset});
+    *frames = &m_ring[offset * m_config.numChannels];
+    return count;
+}
+
+ssize_t FilePcmDevice::mmapCommit(size_t frames) {
+    if (!m_running) {
+        return -EBADFD;
+    }
+    if (frames > m_captured - m_read) {
+        return -EINVAL;
+    }
+    m_read += frames;
+    return frames;
+}
+
+bool FilePcmDevice::recover(int error) {
+    if (-EPIPE != error && -ESTRPIPE != error) {
+        ACSDK_ERROR(LX("recoverFailed").d("reason", "unrecoverableError").d("error", error));
+        return false;
+    }
+    return start();
+}
+
+FilePcmDevice::FilePcmDevice(std::vector<int16_t> samples, const Config& config) :
+        m_samples(std::move(samples)),
+        m_config(config),
+        m_ring(config.bufferFrames * config.numChannels),
+        m_running{false},
+        m_error{0},
+        m_injectedError{0},
+        m_captured{0},
+        m_read{0},
+        m_filePosition{0} {
+}
+
+int FilePcmDevice::capture() {
+    if (!m_running) {
+        return -EBADFD;
+    }
+    auto injectedError = m_injectedError.exchange(0);
+    if (injectedError < 0) {
+        m_error = injectedError;
+    }
+    if (m_error < 0) {
+        return m_error;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime);
+    uint64_t periods = elapsed.count() * m_config.sampleRateHz / 1000000000 / m_config.periodFrames;
+    uint64_t due = periods * m_config.periodFrames;
+    if (due - m_read > m_config.bufferFrames) {
+        m_error = -EPIPE;
+        return m_error;
+    }
+
+    size_t numFrames = m_samples.size() / m_config.numChannels;
+    while (m_captured < due) {
+        size_t offset = m_captured % m_config.bufferFrames;
+        size_t count = std::min<uint64_t>(
+            {due - m_captured, m_config.bufferFrames - offset, numFrames - m_filePosition});
+        std::copy_n(
+            &m_samples[m_filePosition * m_config.numChannels],
+            count * m_config.numChannels,
+            &m_ring[offset * m_config.numChannels]);
+        m_captured += count;
+        m_filePosition = (m_filePosition + count) % numFrames;
+    }
+    return 0;
+}
+
+std::chrono::steady_clock::time_point FilePcmDevice::frameTime(uint64_t frame) const {
+    return m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                             std::chrono::nanoseconds(frame * 1000000000 / m_config.sampleRateHz));
+}
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cerrno>
+#include <climits>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioCapture/PcmCapture.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PcmCapture");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// How long the capture thread waits for the device before checking whether it should stop.
+static const std::chrono::milliseconds WAIT_TIMEOUT(100);
+
+std::unique_ptr<PcmCapture> PcmCapture::create(
+    std::shared_ptr<PcmDeviceInterface> device,
+    std::shared_ptr<AudioInputStream> stream) {
+    if (!device) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullDevice"));
+        return nullptr;
+    }
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    auto config = device->getConfig();
+    if (stream->getWordSize() != config.numChannels * sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "wordSizeMismatch")
+                        .d("wordSize", stream->getWordSize())
+                        .d("numChannels", config.numChannels));
+        return nullptr;
+    }
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+    return std::unique_ptr<PcmCapture>(new PcmCapture(device, std::move(writer)));
+}
+
+PcmCapture::~PcmCapture() {
+    stopStreamingMicrophoneData();
+    m_writer->close();
+}
+
+bool PcmCapture::startStreamingMicrophoneData() {
+    std::lock_guard<std::mutex> lock{m_startStopMutex};
+    if (m_streaming) {
+        return true;
+    }
+    // The thread may have stopped by itself after the device failed.
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (!m_device->start()) {
+        ACSDK_ERROR(LX("startStreamingMicrophoneDataFailed").d("reason", "deviceStartFailed"));
+        return false;
+    }
+    m_stopRequested = false;
+    m_streaming = true;
+    m_thread = std::thread(&PcmCapture::captureLoop, this);
+    return true;
+}
+
+bool PcmCapture::stopStreamingMicrophoneData() {
+    std::lock_guard<std::mutex> lock{m_startStopMutex};
+    m_stopRequested = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (!m_streaming) {
+        return true;
+    }
+    m_streaming = false;
+    if (!m_device->stop()) {
+        ACSDK_ERROR(LX("stopStreamingMicrophoneDataFailed").d("reason", "deviceStopFailed"));
+        return false;
+    }
+    return true;
+}
+
+bool PcmCapture::isStreaming() const {
+    return m_streaming;
+}
+
+AudioFormat PcmCapture::getAudioFormat() const {
+    auto config = m_device->getConfig();
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = config.sampleRateHz;
+    format.sampleSizeInBits = sizeof(int16_t) * CHAR_BIT;
+    format.numChannels = config.numChannels;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    return format;
+}
+
+PcmCapture::Statistics PcmCapture::getStatistics() const {
+    std::lock_guard<std::mutex> lock{m_statisticsMutex};
+    return m_statistics;
+}
+
+PcmCapture::PcmCapture(std::shared_ptr<PcmDeviceInterface> device, std::unique_ptr<AudioInputStream::Writer> writer) :
+        m_device{device},
+        m_writer{std::move(writer)},
+        m_statistics{0, 0, 0, std::chrono::nanoseconds::zero(), std::chrono::nanoseconds::zero()},
+        m_streaming{false},
+        m_stopRequested{false} {
+}
+
+void PcmCapture::captureLoop() {
+    while (!m_stopRequested) {
+        auto result = m_device->wait(WAIT_TIMEOUT);
+        if (0 == result) {
+            continue;
+        }
+        if (result > 0) {
+            result = transfer();
+        }
+        if (result < 0 && !recover(result)) {
+            m_device->stop();
+            m_streaming = false;
+            return;
+        }
+    }
+}
+
+int PcmCapture::transfer() {
+    std::chrono::steady_clock::time_point timestamp;
+    auto available = m_device->available(&timestamp);
+    if (available < 0) {
+        return available;
+    }
+
+    size_t remaining = available;
+    while (remaining > 0) {
+        const int16_t* frames = nullptr;
+        auto count = m_device->mmapBegin(&frames, remaining);
+        if (count <= 0) {
+            return count;
+        }
+        auto written = m_writer->write(frames, count);
+        auto committed = m_device->mmapCommit(count);
+        if (written != count) {
+            ACSDK_ERROR(LX("transferFailed").d("reason", "writeFailed").d("result", written));
+            return -EIO;
+        }
+        if (committed < 0) {
+            return committed;
+        }
+        remaining -= count;
+    }
+
+    // The newest frame written is the newest the device had captured when it was asked what was available.
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - timestamp);
+    std::lock_guard<std::mutex> lock{m_statisticsMutex};
+    m_statistics.framesCaptured += available;
+    ++m_statistics.writes;
+    m_statistics.totalLatency += latency;
+    if (latency > m_statistics.maxLatency) {
+        m_statistics.maxLatency = latency;
+    }
+    return 0;
+}
+
+bool PcmCapture::recover(int error) {
+    if (-EPIPE == error || -ESTRPIPE == error) {
+        ACSDK_WARN(LX("recover").d("reason", -EPIPE == error ? "overrun" : "suspended"));
+        std::lock_guard<std::mutex> lock{m_statisticsMutex};
+        ++m_statistics.xruns;
+    }
+    if (!m_device->recover(error)) {
+        ACSDK_ERROR(LX("recoverFailed").d("error", error));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file FileAudioSourceTest.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCapture/FileAudioSource.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+namespace test {
+
+using namespace avsCommon::avs;
+
+/// The path of the file the tests play.
+static const std::string PATH = "FileAudioSourceTest.pcm";
+
+/// The number of frames in the file: 100 ms at 16 kHz.
+static const size_t FILE_FRAMES = 1600;
+
+/// The number of frames the stream holds.
+static const size_t STREAM_FRAMES = 64000;
+
+/// How long to wait for streaming to finish.
+static const std::chrono::seconds TIMEOUT(5);
+
+/**
+ * Creates a mono @c AudioInputStream.
+ *
+ * @param wordSize The size of a word.
+ * @return The stream.
+ */
+static std::shared_ptr<AudioInputStream> createStream(size_t wordSize = sizeof(int16_t)) {
+    auto bufferSize = AudioInputStream::calculateBufferSize(STREAM_FRAMES, wordSize, 1);
+    return AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), wordSize, 1);
+}
+
+/**
+ * Reads every word written to a stream so far.
+ *
+ * @param reader The reader, which is left at the writer.
+ * @param count The number of words to read.
+ * @return The words.
+ */
+static std::vector<int16_t> readWords(AudioInputStream::Reader* reader, size_t count) {
+    std::vector<int16_t> words(count);
+    size_t read = 0;
+    while (read < count) {
+        auto result = reader->read(&words[read], count - read, TIMEOUT);
+        if (result <= 0) {
+            break;
+        }
+        read += result;
+    }
+    words.resize(read);
+    return words;
+}
+
+/// Test harness for @c FileAudioSource.
+class FileAudioSourceTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// The stream written to.
+    std::shared_ptr<AudioInputStream> m_stream;
+};
+
+void FileAudioSourceTest::SetUp() {
+    // The samples of the file count up from 1, so that they can be told apart from silence.
+    std::ofstream file(PATH, std::ios::binary);
+    for (size_t i = 0; i < FILE_FRAMES; ++i) {
+        uint16_t sample = static_cast<uint16_t>(i + 1);
+        file.put(static_cast<char>(sample & 0xff));
+        file.put(static_cast<char>((sample >> 8) & 0xff));
+    }
+    file.close();
+    m_stream = createStream();
+    ASSERT_TRUE(m_stream);
+}
+
+void FileAudioSourceTest::TearDown() {
+    std::remove(PATH.c_str());
+}
+
+/// Test that create() rejects invalid settings, missing files, and invalid streams.
+TEST_F(FileAudioSourceTest, createWithInvalidArguments) {
+    FileAudioSource::Config config;
+    EXPECT_FALSE(FileAudioSource::create("missing.pcm", m_stream, config));
+    EXPECT_FALSE(FileAudioSource::create(PATH, nullptr, config));
+    EXPECT_FALSE(FileAudioSource::create(PATH, createStream(2 * sizeof(int16_t)), config));
+    config.speed = -1.0;
+    EXPECT_FALSE(FileAudioSource::create(PATH, m_stream, config));
+    config = FileAudioSource::Config();
+    config.chunkDuration = std::chrono::milliseconds(0);
+    EXPECT_FALSE(FileAudioSource::create(PATH, m_stream, config));
+
+    config = FileAudioSource::Config();
+    auto source = FileAudioSource::create(PATH, m_stream, config);
+    ASSERT_TRUE(source);
+    EXPECT_FALSE(FileAudioSource::create(PATH, m_stream, config));
+    EXPECT_EQ(16000u, source->getAudioFormat().sampleRateHz);
+    EXPECT_EQ(1u, source->getAudioFormat().numChannels);
+}
+
+/// Test that the file is played the number of times asked for, with silence between plays, at a multiple of real time.
+TEST_F(FileAudioSourceTest, playsLoopsWithGapsAtSpeed) {
+    FileAudioSource::Config config;
+    config.speed = 10.0;
+    config.loops = 3;
+    config.gapDuration = std::chrono::milliseconds(50);
+    std::mutex mutex;
+    std::vector<AudioInputStream::Index> loopBegins;
+    auto source = FileAudioSource::create(PATH, m_stream, config, [&](uint64_t loop, AudioInputStream::Index begin) {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(loopBegins.size(), loop);
+        loopBegins.push_back(begin);
+    });
+    ASSERT_TRUE(source);
+    auto reader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    ASSERT_TRUE(reader);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(source->startStreamingMicrophoneData());
+    ASSERT_TRUE(source->waitUntilFinished(TIMEOUT));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(source->isStreaming());
+
+    // Three plays of 100 ms and three gaps of 50 ms, at ten times real time.
+    const size_t gapFrames = 800;
+    const size_t loopFrames = FILE_FRAMES + gapFrames;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(45));
+    EXPECT_EQ(std::vector<AudioInputStream::Index>({0, loopFrames, 2 * loopFrames}), loopBegins);
+    EXPECT_EQ(3 * loopFrames, source->tell());
+
+    auto words = readWords(reader.get(), 3 * loopFrames);
+    ASSERT_EQ(3 * loopFrames, words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+        size_t position = i % loopFrames;
+        int16_t expected = position < FILE_FRAMES ? static_cast<int16_t>(position + 1) : 0;
+        ASSERT_EQ(expected, words[i]) << "i=" << i;
+    }
+
+    auto statistics = source->getStatistics();
+    EXPECT_EQ(3 * loopFrames, statistics.wordsWritten);
+    EXPECT_EQ(3u, statistics.loopsCompleted);
+    EXPECT_EQ(0u, statistics.dropouts);
+}
+
+/// Test that an unthrottled source writes much faster than real time.
+TEST_F(FileAudioSourceTest, unthrottledIsFasterThanRealTime) {
+    FileAudioSource::Config config;
+    config.speed = 0.0;
+    config.loops = 50;
+    auto source = FileAudioSource::create(PATH, m_stream, config);
+    ASSERT_TRUE(source);
+
+    // Fifty plays of 100 ms is five seconds of audio.
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(source->startStreamingMicrophoneData());
+    ASSERT_TRUE(source->waitUntilFinished(TIMEOUT));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+    EXPECT_EQ(50u, source->getStatistics().loopsCompleted);
+    EXPECT_EQ(50 * FILE_FRAMES, source->getStatistics().wordsWritten);
+}
+
+/// Test that a dropout loses its audio, rather than writing it.
+TEST_F(FileAudioSourceTest, injectsDropouts) {
+    FileAudioSource::Config config;
+    config.speed = 0.0;
+    config.dropoutInterval = std::chrono::milliseconds(50);
+    config.dropoutDuration = std::chrono::milliseconds(20);
+    auto source = FileAudioSource::create(PATH, m_stream, config);
+    ASSERT_TRUE(source);
+    auto reader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    ASSERT_TRUE(reader);
+    ASSERT_TRUE(source->startStreamingMicrophoneData());
+    ASSERT_TRUE(source->waitUntilFinished(TIMEOUT));
+
+    // 50 ms is written, the next 20 ms is lost, and the remaining 30 ms is written.
+    const size_t intervalFrames = 800;
+    const size_t dropoutFrames = 320;
+    auto statistics = source->getStatistics();
+    EXPECT_EQ(1u, statistics.dropouts);
+    EXPECT_EQ(dropoutFrames, statistics.wordsDropped);
+    ASSERT_EQ(FILE_FRAMES - dropoutFrames, statistics.wordsWritten);
+
+    auto words = readWords(reader.get(), FILE_FRAMES - dropoutFrames);
+    ASSERT_EQ(FILE_FRAMES - dropoutFrames, words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+        size_t position = i < intervalFrames ? i : i + dropoutFrames;
+        ASSERT_EQ(static_cast<int16_t>(position + 1), words[i]) << "i=" << i;
+    }
+}
+
+/// Test that a source which loops forever plays until it is stopped, and can be started again.
+TEST_F(FileAudioSourceTest, loopsUntilStopped) {
+    FileAudioSource::Config config;
+    config.speed = 0.0;
+    config.loops = 0;
+    auto source = FileAudioSource::create(PATH, m_stream, config);
+    ASSERT_TRUE(source);
+    ASSERT_TRUE(source->startStreamingMicrophoneData());
+    EXPECT_FALSE(source->waitUntilFinished(std::chrono::milliseconds(100)));
+    EXPECT_TRUE(source->isStreaming());
+    EXPECT_TRUE(source->stopStreamingMicrophoneData());
+    EXPECT_FALSE(source->isStreaming());
+    auto loopsCompleted = source->getStatistics().loopsCompleted;
+    EXPECT_GT(loopsCompleted, 1u);
+
+    ASSERT_TRUE(source->startStreamingMicrophoneData());
+    EXPECT_TRUE(source->isStreaming());
+    EXPECT_TRUE(source->stopStreamingMicrophoneData());
+    EXPECT_GE(source->getStatistics().loopsCompleted, loopsCompleted);
+}
+
+}  // namespace test
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file FilePcmDeviceTest.cpp
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCapture/FilePcmDevice.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+namespace test {
+
+/// The path of the file the tests play.
+static const std::string PATH = "FilePcmDeviceTest.pcm";
+
+/// The number of frames in the file.
+static const size_t FILE_FRAMES = 1000;
+
+/// How long to wait for a period.
+static const std::chrono::milliseconds TIMEOUT(1000);
+
+/**
+ * Writes a little-endian integer to a stream.
+ *
+ * @param stream The stream.
+ * @param value The integer.
+ * @param size The number of bytes in the integer.
+ */
+static void writeLittleEndian(std::ostream& stream, uint32_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+/**
+ * Writes a file of frames whose samples count up from 0, channel by channel.
+ *
+ * @param config The rate and channels of the file.
+ * @param wav Whether to write a WAV header.
+ */
+static void writeFile(const PcmDeviceInterface::Config& config, bool wav) {
+    std::ofstream file(PATH, std::ios::binary);
+    size_t dataSize = FILE_FRAMES * config.numChannels * sizeof(int16_t);
+    if (wav) {
+        file.write("RIFF", 4);
+        writeLittleEndian(file, 36 + dataSize, 4);
+        file.write("WAVEfmt ", 8);
+        writeLittleEndian(file, 16, 4);
+        writeLittleEndian(file, 1, 2);
+        writeLittleEndian(file, config.numChannels, 2);
+        writeLittleEndian(file, config.sampleRateHz, 4);
+        writeLittleEndian(file, config.sampleRateHz * config.numChannels * sizeof(int16_t), 4);
+        writeLittleEndian(file, config.numChannels * sizeof(int16_t), 2);
+        writeLittleEndian(file, 16, 2);
+        file.write("data", 4);
+        writeLittleEndian(file, dataSize, 4);
+    }
+    for (size_t i = 0; i < FILE_FRAMES * config.numChannels; ++i) {
+        writeLittleEndian(file, static_cast<uint16_t>(i), sizeof(int16_t));
+    }
+}
+
+/// Test harness for @c FilePcmDevice.
+class FilePcmDeviceTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// The settings of the device: 16 kHz stereo, 10ms periods and a 40ms ring buffer.
+    PcmDeviceInterface::Config m_config;
+};
+
+void FilePcmDeviceTest::SetUp() {
+    m_config = {16000, 2, 160, 640};
+}
+
+void FilePcmDeviceTest::TearDown() {
+    std::remove(PATH.c_str());
+}
+
+/// Test that create() rejects invalid settings, missing and empty files, and WAV files in another format.
+TEST_F(FilePcmDeviceTest, createWithInvalidArguments) {
+    EXPECT_FALSE(FilePcmDevice::create(PATH, m_config));
+    writeFile(m_config, false);
+    auto config = m_config;
+    config.numChannels = 0;
+    EXPECT_FALSE(FilePcmDevice::create(PATH, config));
+    config = m_config;
+    config.bufferFrames = config.periodFrames - 1;
+    EXPECT_FALSE(FilePcmDevice::create(PATH, config));
+
+    std::ofstream(PATH, std::ios::binary | std::ios::trunc);
+    EXPECT_FALSE(FilePcmDevice::create(PATH, m_config));
+
+    writeFile(m_config, true);
+    EXPECT_TRUE(FilePcmDevice::create(PATH, m_config));
+    config = m_config;
+    config.sampleRateHz = 48000;
+    EXPECT_FALSE(FilePcmDevice::create(PATH, config));
+}
+
+/// Test that a period becomes available each period, timestamped when it was captured, and holds the file's frames.
+TEST_F(FilePcmDeviceTest, makesPeriodsAvailableInRealTime) {
+    writeFile(m_config, true);
+    auto device = FilePcmDevice::create(PATH, m_config);
+    ASSERT_TRUE(device);
+    EXPECT_EQ(-EBADFD, device->wait(TIMEOUT));
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(device->start());
+    ASSERT_EQ(1, device->wait(TIMEOUT));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(10));
+
+    std::chrono::steady_clock::time_point timestamp;
+    auto available = device->available(&timestamp);
+    ASSERT_GE(available, static_cast<ssize_t>(m_config.periodFrames));
+    EXPECT_EQ(0, available % static_cast<ssize_t>(m_config.periodFrames));
+    EXPECT_LE(timestamp, std::chrono::steady_clock::now());
+    EXPECT_GE(timestamp, start + std::chrono::milliseconds(10));
+
+    const int16_t* frames = nullptr;
+    ASSERT_EQ(static_cast<ssize_t>(m_config.periodFrames), device->mmapBegin(&frames, m_config.periodFrames));
+    for (size_t i = 0; i < m_config.periodFrames * m_config.numChannels; ++i) {
+        ASSERT_EQ(static_cast<int16_t>(i), frames[i]);
+    }
+    EXPECT_EQ(-EINVAL, device->mmapCommit(available + 1));
+    EXPECT_EQ(static_cast<ssize_t>(m_config.periodFrames), device->mmapCommit(m_config.periodFrames));
+    EXPECT_EQ(available - static_cast<ssize_t>(m_config.periodFrames), device->available(&timestamp));
+}
+
+/// Test that frames wrap around the ring buffer and the file.
+TEST_F(FilePcmDeviceTest, wrapsAroundRingBufferAndFile) {
+    writeFile(m_config, false);
+    auto device = FilePcmDevice::create(PATH, m_config);
+    ASSERT_TRUE(device);
+    ASSERT_TRUE(device->start());
+
+    size_t read = 0;
+    const size_t total = FILE_FRAMES * 2;
+    while (read < total) {
+        ASSERT_EQ(1, device->wait(TIMEOUT));
+        const int16_t* frames = nullptr;
+        auto count = device->mmapBegin(&frames, total - read);
+        ASSERT_GT(count, 0);
+        ASSERT_LE(static_cast<size_t>(count), m_config.bufferFrames - read % m_config.bufferFrames);
+        for (ssize_t frame = 0; frame < count; ++frame) {
+            size_t filePosition = (read + frame) % FILE_FRAMES;
+            ASSERT_EQ(static_cast<int16_t>(filePosition * m_config.numChannels), frames[frame * m_config.numChannels]);
+        }
+        ASSERT_EQ(count, device->mmapCommit(count));
+        read += count;
+    }
+}
+
+/// Test that the device fails with an xrun if it is not read in time or one is injected, until it is recovered.
+TEST_F(FilePcmDeviceTest, xrunsUntilRecovered) {
+    writeFile(m_config, false);
+    auto device = FilePcmDevice::create(PATH, m_config);
+    ASSERT_TRUE(device);
+    ASSERT_TRUE(device->start());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::chrono::steady_clock::time_point timestamp;
+    EXPECT_EQ(-EPIPE, device->available(&timestamp));
+    EXPECT_EQ(-EPIPE, device->wait(TIMEOUT));
+    const int16_t* frames = nullptr;
+    EXPECT_EQ(-EPIPE, device->mmapBegin(&frames, m_config.periodFrames));
+    EXPECT_FALSE(device->recover(-EIO));
+    ASSERT_TRUE(device->recover(-EPIPE));
+    EXPECT_EQ(1, device->wait(TIMEOUT));
+
+    device->injectXrun();
+    EXPECT_EQ(-EPIPE, device->wait(TIMEOUT));
+    ASSERT_TRUE(device->recover(-EPIPE));
+    EXPECT_EQ(1, device->wait(TIMEOUT));
+}
+
+}  // namespace test
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file PcmCaptureTest.cpp
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCapture/FilePcmDevice.h"
+#include "AudioCapture/PcmCapture.h"
+
+namespace alexaClientSDK {
+namespace audioCapture {
+namespace test {
+
+using namespace avsCommon::avs;
+
+/// The path of the file the tests capture.
+static const std::string PATH = "PcmCaptureTest.pcm";
+
+/// The number of frames in the file.
+static const size_t FILE_FRAMES = 1600;
+
+/// The number of channels captured.
+static const unsigned int NUM_CHANNELS = 2;
+
+/// The number of frames the stream holds.
+static const size_t STREAM_FRAMES = 16000;
+
+/// How long to wait for captured audio.
+static const std::chrono::seconds TIMEOUT(2);
+
+/**
+ * Creates an @c AudioInputStream.
+ *
+ * @param wordSize The size of a word.
+ * @return The stream.
+ */
+static std::shared_ptr<AudioInputStream> createStream(size_t wordSize) {
+    auto bufferSize = AudioInputStream::calculateBufferSize(STREAM_FRAMES, wordSize, 1);
+    return AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), wordSize, 1);
+}
+
+/**
+ * Waits for capture's statistics to satisfy a predicate.
+ *
+ * @param capture The capture.
+ * @param predicate The predicate.
+ * @return Whether the predicate was satisfied before @c TIMEOUT.
+ */
+static bool waitForStatistics(
+    const PcmCapture& capture,
+    std::function<bool(const PcmCapture::Statistics&)> predicate) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!predicate(capture.getStatistics())) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+/// A device which fails in a way it cannot recover from.
+class BrokenPcmDevice : public PcmDeviceInterface {
+public:
+    Config getConfig() const override {
+        return {16000, NUM_CHANNELS, 160, 640};
+    }
+    bool start() override {
+        return true;
+    }
+    bool stop() override {
+        return true;
+    }
+    int wait(std::chrono::milliseconds timeout) override {
+        return -EIO;
+    }
+    ssize_t available(std::chrono::steady_clock::time_point* timestamp) override {
+        return -EIO;
+    }
+    ssize_t mmapBegin(const int16_t** frames, size_t maxFrames) override {
+        return -EIO;
+    }
+    ssize_t mmapCommit(size_t frames) override {
+        return -EIO;
+    }
+    bool recover(int error) override {
+        return false;
+    }
+};
+
+/// Test harness for @c PcmCapture.
+class PcmCaptureTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// The device, which plays a file whose samples count up from 0.
+    std::shared_ptr<FilePcmDevice> m_device;
+
+    /// The stream captured into.
+    std::shared_ptr<AudioInputStream> m_stream;
+};
+
+void PcmCaptureTest::SetUp() {
+    {
+        std::ofstream file(PATH, std::ios::binary);
+        for (size_t i = 0; i < FILE_FRAMES * NUM_CHANNELS; ++i) {
+            int16_t sample = static_cast<int16_t>(i);
+            file.put(static_cast<char>(sample & 0xff));
+            file.put(static_cast<char>((sample >> 8) & 0xff));
+        }
+    }
+    m_device = FilePcmDevice::create(PATH, {16000, NUM_CHANNELS, 160, 640});
+    ASSERT_TRUE(m_device);
+    m_stream = createStream(NUM_CHANNELS * sizeof(int16_t));
+    ASSERT_TRUE(m_stream);
+}
+
+void PcmCaptureTest::TearDown() {
+    std::remove(PATH.c_str());
+}
+
+/// Test that create() rejects missing devices and streams, streams of another word size, and streams with a writer.
+TEST_F(PcmCaptureTest, createWithInvalidArguments) {
+    EXPECT_FALSE(PcmCapture::create(nullptr, m_stream));
+    EXPECT_FALSE(PcmCapture::create(m_device, nullptr));
+    EXPECT_FALSE(PcmCapture::create(m_device, createStream(sizeof(int16_t))));
+    auto writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+    EXPECT_FALSE(PcmCapture::create(m_device, m_stream));
+}
+
+/// Test that the device's frames are written to the stream as they were captured, and the latency is measured.
+TEST_F(PcmCaptureTest, capturesDeviceIntoStream) {
+    auto capture = PcmCapture::create(m_device, m_stream);
+    ASSERT_TRUE(capture);
+    EXPECT_EQ(NUM_CHANNELS, capture->getAudioFormat().numChannels);
+    EXPECT_EQ(16000u, capture->getAudioFormat().sampleRateHz);
+    auto reader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    ASSERT_TRUE(reader);
+    EXPECT_FALSE(capture->isStreaming());
+    ASSERT_TRUE(capture->startStreamingMicrophoneData());
+    EXPECT_TRUE(capture->isStreaming());
+
+    // Read the file through twice, to see it loop.
+    std::vector<int16_t> frames(FILE_FRAMES * 2 * NUM_CHANNELS);
+    size_t read = 0;
+    while (read < FILE_FRAMES * 2) {
+        auto words = reader->read(&frames[read * NUM_CHANNELS], FILE_FRAMES * 2 - read, TIMEOUT);
+        ASSERT_GT(words, 0);
+        read += words;
+    }
+    for (size_t i = 0; i < frames.size(); ++i) {
+        ASSERT_EQ(static_cast<int16_t>(i % (FILE_FRAMES * NUM_CHANNELS)), frames[i]) << "i=" << i;
+    }
+    ASSERT_TRUE(capture->stopStreamingMicrophoneData());
+    EXPECT_FALSE(capture->isStreaming());
+
+    auto statistics = capture->getStatistics();
+    EXPECT_GE(statistics.framesCaptured, FILE_FRAMES * 2);
+    EXPECT_GT(statistics.writes, 0u);
+    EXPECT_EQ(0u, statistics.xruns);
+    EXPECT_GT(statistics.maxLatency.count(), 0);
+    EXPECT_GE(statistics.maxLatency, statistics.totalLatency / statistics.writes);
+    std::cout << "Capture to stream latency: mean " << statistics.totalLatency.count() / statistics.writes / 1000.0
+              << " us, max " << statistics.maxLatency.count() / 1000.0 << " us over " << statistics.writes
+              << " writes" << std::endl;
+}
+
+/// Test that capture recovers from an xrun and carries on.
+TEST_F(PcmCaptureTest, recoversFromXrun) {
+    auto capture = PcmCapture::create(m_device, m_stream);
+    ASSERT_TRUE(capture);
+    ASSERT_TRUE(capture->startStreamingMicrophoneData());
+    ASSERT_TRUE(waitForStatistics(*capture, [](const PcmCapture::Statistics& s) { return s.writes > 0; }));
+
+    m_device->injectXrun();
+    ASSERT_TRUE(waitForStatistics(*capture, [](const PcmCapture::Statistics& s) { return s.xruns > 0; }));
+    auto framesCaptured = capture->getStatistics().framesCaptured;
+    ASSERT_TRUE(waitForStatistics(
+        *capture, [framesCaptured](const PcmCapture::Statistics& s) { return s.framesCaptured > framesCaptured; }));
+    EXPECT_TRUE(capture->isStreaming());
+    EXPECT_EQ(1u, capture->getStatistics().xruns);
+}
+
+/// Test that capture recovers from a suspend of the device and carries on, counting the lost audio as an xrun.
+TEST_F(PcmCaptureTest, recoversFromSuspend) {
+    auto capture = PcmCapture::create(m_device, m_stream);
+    ASSERT_TRUE(capture);
+    ASSERT_TRUE(capture->startStreamingMicrophoneData());
+    ASSERT_TRUE(waitForStatistics(*capture, [](const PcmCapture::Statistics& s) { return s.writes > 0; }));
+
+    m_device->injectSuspend();
+    ASSERT_TRUE(waitForStatistics(*capture, [](const PcmCapture::Statistics& s) { return s.xruns > 0; }));
+    auto framesCaptured = capture->getStatistics().framesCaptured;
+    ASSERT_TRUE(waitForStatistics(
+        *capture, [framesCaptured](const PcmCapture::Statistics& s) { return s.framesCaptured > framesCaptured; }));
+    EXPECT_TRUE(capture->isStreaming());
+    EXPECT_EQ(1u, capture->getStatistics().xruns);
+}
+
+/// Test that capture stops by itself if the device cannot be recovered, and can be started again.
+TEST_F(PcmCaptureTest, stopsWhenDeviceCannotRecover) {
+    auto capture = PcmCapture::create(std::make_shared<BrokenPcmDevice>(), m_stream);
+    ASSERT_TRUE(capture);
+    ASSERT_TRUE(capture->startStreamingMicrophoneData());
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (capture->isStreaming() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_FALSE(capture->isStreaming());
+    EXPECT_EQ(0u, capture->getStatistics().xruns);
+    EXPECT_TRUE(capture->startStreamingMicrophoneData());
+    EXPECT_TRUE(capture->stopStreamingMicrophoneData());
+}
+
+}  // namespace test
+}  // namespace audioCapture
+}  // namespace alexaClientSDK
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUDIOFRONTEND_H_
+#define ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUDIOFRONTEND_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "AudioFrontend/FrontendProcessor.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/**
+ * A pipeline stage which reads interleaved microphone array audio from one @c AudioInputStream, runs it through a
+ * @c FrontendProcessor, and writes mono audio to another @c AudioInputStream.  The mono stream is the one to give to
+ * the keyword detector, @c AudioInputProcessor and ESP, which only accept one channel.
+ *
+ * Each word of the array stream is one frame holding a 16-bit sample of every channel, so that indices in both streams
+ * count the same frames.  The stage processes audio on a thread of its own from creation until destruction.
+ */
+class AudioFrontend {
+public:
+    /// The work done by the stage.
+    struct Statistics {
+        /// The number of frames processed, each of which holds one sample per channel.
+        uint64_t framesProcessed;
+        /// The total time spent processing.
+        std::chrono::nanoseconds processingTime;
+        /// The longest time spent processing one read, which holds at most one @c frameDuration of audio.
+        std::chrono::nanoseconds maxBlockProcessingTime;
+        /// The number of times the stage fell behind the microphones and skipped audio.
+        uint64_t overruns;
+    };
+
+    /**
+     * Creates an @c AudioFrontend, which starts processing at once.
+     *
+     * @param input The microphone array stream, whose words hold one 16-bit sample per channel.
+     * @param inputFormat The format of @c input, which must be 16 kHz interleaved little-endian LPCM with one channel
+     *     per delay in @c config.
+     * @param output The mono stream to write, whose words are 16-bit samples.
+     * @param config The settings of the signal chain.
+     * @return The stage, or @c nullptr if the streams or settings are invalid.
+     */
+    static std::unique_ptr<AudioFrontend> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> input,
+        const avsCommon::utils::AudioFormat& inputFormat,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> output,
+        const FrontendProcessor::Config& config);
+
+    /// Destructor.  Stops processing.
+    ~AudioFrontend();
+
+    /**
+     * Gets the format of the mono stream.
+     *
+     * @return The format.
+     */
+    avsCommon::utils::AudioFormat getOutputFormat() const;
+
+    /**
+     * Gets the work done since the stage was created.
+     *
+     * @return The statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param reader The reader of the microphone array stream.
+     * @param writer The writer of the mono stream.
+     * @param outputFormat The format of the mono stream.
+     * @param processor The signal chain.
+     */
+    AudioFrontend(
+        std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> writer,
+        const avsCommon::utils::AudioFormat& outputFormat,
+        std::unique_ptr<FrontendProcessor> processor);
+
+    /// The loop of the processing thread.
+    void processingLoop();
+
+    /// The reader of the microphone array stream.
+    std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
+
+    /// The writer of the mono stream.
+    std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// The format of the mono stream.
+    const avsCommon::utils::AudioFormat m_outputFormat;
+
+    /// The signal chain.
+    std::unique_ptr<FrontendProcessor> m_processor;
+
+    /// Serializes access to @c m_statistics.
+    mutable std::mutex m_mutex;
+
+    /// The work done by the stage.
+    Statistics m_statistics;
+
+    /// Whether the processing thread should stop.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The processing thread.
+    std::thread m_thread;
+};
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUDIOFRONTEND_H_
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUTOMATICGAINCONTROL_H_
+#define ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUTOMATICGAINCONTROL_H_
+
+#include <cstddef>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/**
+ * An automatic gain control, which brings speech to a steady level for the keyword detector and the cloud.
+ *
+ * The level of each frame is tracked with an envelope which rises at once and decays slowly.  The gain drops at once
+ * when the envelope rises above the target, and climbs slowly when it falls below, up to a maximum.  While the
+ * envelope is below the noise gate the gain is held, so that silence is not amplified.  The gain ramps across each
+ * frame to avoid clicks.
+ */
+class AutomaticGainControl {
+public:
+    /**
+     * Creates an @c AutomaticGainControl.
+     *
+     * @param targetLevelDbfs The RMS level to bring speech to, in dB relative to full scale.
+     * @param maxGainDb The largest gain applied, in dB.
+     * @param noiseGateDbfs The RMS level below which the gain is held, in dB relative to full scale.
+     * @return The gain control, or @c nullptr if the levels are not below full scale or the maximum gain is negative.
+     */
+    static std::unique_ptr<AutomaticGainControl> create(float targetLevelDbfs, float maxGainDb, float noiseGateDbfs);
+
+    /**
+     * Applies the gain to a frame of audio in place, and updates the gain for the next frame.
+     *
+     * @param data The samples, at 16-bit scale.
+     * @param numSamples The number of samples.
+     */
+    void process(float* data, size_t numSamples);
+
+    /**
+     * Gets the gain the next frame starts with.
+     *
+     * @return The linear gain.
+     */
+    float getGain() const;
+
+    /// Returns to unity gain.
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param targetLevel The linear target level.
+     * @param maxGain The linear maximum gain.
+     * @param noiseGate The linear noise gate level.
+     */
+    AutomaticGainControl(float targetLevel, float maxGain, float noiseGate);
+
+    /// The RMS level to bring speech to.
+    const float m_targetLevel;
+
+    /// The largest gain.
+    const float m_maxGain;
+
+    /// The level below which the gain is held.
+    const float m_noiseGate;
+
+    /// The envelope of the frame levels.
+    float m_envelope;
+
+    /// The gain the next frame starts with.
+    float m_gain;
+};
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_AUTOMATICGAINCONTROL_H_
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_DELAYANDSUMBEAMFORMER_H_
+#define ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_DELAYANDSUMBEAMFORMER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/**
+ * A delay-and-sum beamformer, which steers a microphone array toward a talker by delaying each channel so that sound
+ * from the talker lines up across the channels, then averaging the channels.
+ *
+ * The delays are whole samples.  At 16 kHz a sample is about 21 mm of sound travel, which is fine enough for the
+ * spacing of the arrays on our boards.
+ */
+class DelayAndSumBeamformer {
+public:
+    /// The speed of sound used to compute delays, in meters per second.
+    static constexpr float SPEED_OF_SOUND = 343.0f;
+
+    /**
+     * Computes the delays which steer a uniform linear array.
+     *
+     * @param numMicrophones The number of microphones.
+     * @param spacingInMillimeters The distance between neighbouring microphones.
+     * @param steeringAngleInDegrees The direction of the talker, from broadside (0) toward the last microphone (90).
+     * @param sampleRateHz The sample rate.
+     * @return The delay of each channel, the smallest of which is zero.
+     */
+    static std::vector<unsigned int> computeLinearArrayDelays(
+        size_t numMicrophones,
+        float spacingInMillimeters,
+        float steeringAngleInDegrees,
+        unsigned int sampleRateHz);
+
+    /**
+     * Creates a @c DelayAndSumBeamformer.
+     *
+     * @param delaysInSamples The delay of each channel.  There must be at least one channel.
+     * @param maxFramesPerCall The largest number of frames passed to @c process().
+     * @return The beamformer, or @c nullptr if the arguments are invalid.
+     */
+    static std::unique_ptr<DelayAndSumBeamformer> create(
+        const std::vector<unsigned int>& delaysInSamples,
+        size_t maxFramesPerCall);
+
+    /**
+     * Gets the number of channels.
+     *
+     * @return The number of channels.
+     */
+    size_t getNumChannels() const;
+
+    /**
+     * Beamforms a block of audio.  Each call continues the signal of the previous one.
+     *
+     * @param input The interleaved 16-bit samples of @c numFrames frames.
+     * @param numFrames The number of frames, which is at most the @c maxFramesPerCall given to @c create().
+     * @param[out] output The @c numFrames mono samples.
+     */
+    void process(const int16_t* input, size_t numFrames, float* output);
+
+    /// Forgets the previous signal, as if the microphones had been silent.
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param delaysInSamples The delay of each channel.
+     * @param maxFramesPerCall The largest number of frames passed to @c process().
+     */
+    DelayAndSumBeamformer(const std::vector<unsigned int>& delaysInSamples, size_t maxFramesPerCall);
+
+    /// The delay of each channel.
+    const std::vector<unsigned int> m_delays;
+
+    /// The largest delay, which is how much of the previous signal each channel keeps.
+    const unsigned int m_maxDelay;
+
+    /// The largest number of frames passed to @c process().
+    const size_t m_maxFramesPerCall;
+
+    /// The signal of each channel, starting with the last @c m_maxDelay samples of the previous call.
+    std::vector<std::vector<float>> m_channels;
+};
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_DELAYANDSUMBEAMFORMER_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_FRONTENDPROCESSOR_H_
+#define ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_FRONTENDPROCESSOR_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AudioFrontend/AutomaticGainControl.h"
+#include "AudioFrontend/DelayAndSumBeamformer.h"
+#include "AudioFrontend/HighPassFilter.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/**
+ * The signal chain of the audio front end, which turns interleaved microphone array audio into mono audio: a
+ * @c DelayAndSumBeamformer, then a @c HighPassFilter, then an @c AutomaticGainControl.
+ *
+ * This class does no I/O and holds no threads, so that it can be driven by @c AudioFrontend or directly by tests and
+ * benchmarks.  It is not thread safe.
+ */
+class FrontendProcessor {
+public:
+    /// The settings of the signal chain.
+    struct Config {
+        /// Constructor, with the default settings and no channels.
+        Config();
+
+        /// The delay of each microphone channel, in samples.  @see DelayAndSumBeamformer::computeLinearArrayDelays
+        std::vector<unsigned int> delaysInSamples;
+
+        /// The cutoff of the high-pass filter, or zero to leave the filter out.
+        unsigned int highPassCutoffHz;
+
+        /// Whether to apply the automatic gain control.
+        bool agcEnabled;
+
+        /// The level the automatic gain control brings speech to, in dB relative to full scale.
+        float agcTargetLevelDbfs;
+
+        /// The largest gain of the automatic gain control, in dB.
+        float agcMaxGainDb;
+
+        /// The level below which the automatic gain control holds its gain, in dB relative to full scale.
+        float agcNoiseGateDbfs;
+
+        /// The duration of the frames the signal chain works on, which is also the period of the gain updates.
+        std::chrono::milliseconds frameDuration;
+    };
+
+    /**
+     * Creates a @c FrontendProcessor.
+     *
+     * @param config The settings.
+     * @param sampleRateHz The sample rate of the microphones.
+     * @return The processor, or @c nullptr if the settings are invalid.
+     */
+    static std::unique_ptr<FrontendProcessor> create(const Config& config, unsigned int sampleRateHz);
+
+    /**
+     * Gets the number of microphone channels.
+     *
+     * @return The number of channels.
+     */
+    size_t getNumChannels() const;
+
+    /**
+     * Gets the number of samples in a frame.
+     *
+     * @return The number of samples.
+     */
+    size_t getFrameSizeInSamples() const;
+
+    /**
+     * Processes a block of audio.  Each call continues the signal of the previous one.
+     *
+     * @param input The interleaved 16-bit samples of @c numFrames frames.
+     * @param numFrames The number of frames, of any size.
+     * @param[out] output The @c numFrames mono 16-bit samples.
+     */
+    void process(const int16_t* input, size_t numFrames, int16_t* output);
+
+    /// Forgets the previous signal, and returns the gain control to unity gain.
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param frameSize The number of samples in a frame.
+     * @param beamformer The beamformer.
+     * @param highPassFilter The high-pass filter, or @c nullptr to leave it out.
+     * @param agc The automatic gain control, or @c nullptr to leave it out.
+     */
+    FrontendProcessor(
+        size_t frameSize,
+        std::unique_ptr<DelayAndSumBeamformer> beamformer,
+        std::unique_ptr<HighPassFilter> highPassFilter,
+        std::unique_ptr<AutomaticGainControl> agc);
+
+    /// The number of samples in a frame.
+    const size_t m_frameSize;
+
+    /// The beamformer.
+    std::unique_ptr<DelayAndSumBeamformer> m_beamformer;
+
+    /// The high-pass filter, if any.
+    std::unique_ptr<HighPassFilter> m_highPassFilter;
+
+    /// The automatic gain control, if any.
+    std::unique_ptr<AutomaticGainControl> m_agc;
+
+    /// The frame being processed.
+    std::vector<float> m_frame;
+};
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_FRONTENDPROCESSOR_H_
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_HIGHPASSFILTER_H_
+#define ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_HIGHPASSFILTER_H_
+
+#include <cstddef>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/**
+ * A second order Butterworth high-pass filter, which removes DC offset, handling noise and low rumble below the voice
+ * band.
+ */
+class HighPassFilter {
+public:
+    /**
+     * Creates a @c HighPassFilter.
+     *
+     * @param cutoffHz The frequency at which the filter attenuates by 3 dB.
+     * @param sampleRateHz The sample rate.
+     * @return The filter, or @c nullptr if the cutoff is not between zero and half the sample rate.
+     */
+    static std::unique_ptr<HighPassFilter> create(unsigned int cutoffHz, unsigned int sampleRateHz);
+
+    /**
+     * Filters a block of audio in place.  Each call continues the signal of the previous one.
+     *
+     * @param data The samples.
+     * @param numSamples The number of samples.
+     */
+    void process(float* data, size_t numSamples);
+
+    /// Forgets the previous signal.
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param cutoffHz The cutoff frequency.
+     * @param sampleRateHz The sample rate.
+     */
+    HighPassFilter(unsigned int cutoffHz, unsigned int sampleRateHz);
+
+    /// The feed-forward coefficients.
+    float m_b0, m_b1, m_b2;
+
+    /// The feedback coefficients.
+    float m_a1, m_a2;
+
+    /// The state of the filter, in transposed direct form II.
+    float m_z1, m_z2;
+};
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUDIOFRONTEND_INCLUDE_AUDIOFRONTEND_HIGHPASSFILTER_H_
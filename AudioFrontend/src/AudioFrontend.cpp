@@ -0,0 +1,187 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioFrontend/AudioFrontend.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioFrontend");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The sample rate the keyword detectors and @c AudioInputProcessor expect.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The size of a sample.
+static const unsigned int SAMPLE_SIZE_IN_BITS = 16;
+
+/// How long the processing thread waits for audio before checking whether it should stop.
+static const std::chrono::milliseconds READ_TIMEOUT(100);
+
+std::unique_ptr<AudioFrontend> AudioFrontend::create(
+    std::shared_ptr<AudioInputStream> input,
+    const AudioFormat& inputFormat,
+    std::shared_ptr<AudioInputStream> output,
+    const FrontendProcessor::Config& config) {
+    if (!input || !output) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (AudioFormat::Encoding::LPCM != inputFormat.encoding ||
+        AudioFormat::Endianness::LITTLE != inputFormat.endianness ||
+        SAMPLE_SIZE_IN_BITS != inputFormat.sampleSizeInBits || SAMPLE_RATE_HZ != inputFormat.sampleRateHz ||
+        AudioFormat::Layout::INTERLEAVED != inputFormat.layout) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("encoding", inputFormat.encoding)
+                        .d("endianness", inputFormat.endianness)
+                        .d("sampleSizeInBits", inputFormat.sampleSizeInBits)
+                        .d("sampleRateHz", inputFormat.sampleRateHz));
+        return nullptr;
+    }
+    if (inputFormat.numChannels != config.delaysInSamples.size()) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "channelCountMismatch")
+                        .d("numChannels", inputFormat.numChannels)
+                        .d("numDelays", config.delaysInSamples.size()));
+        return nullptr;
+    }
+    if (input->getWordSize() != inputFormat.numChannels * sizeof(int16_t) || output->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedWordSize")
+                        .d("inputWordSize", input->getWordSize())
+                        .d("outputWordSize", output->getWordSize()));
+        return nullptr;
+    }
+
+    auto processor = FrontendProcessor::create(config, inputFormat.sampleRateHz);
+    if (!processor) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createProcessorFailed"));
+        return nullptr;
+    }
+    auto reader = input->createReader(AudioInputStream::Reader::Policy::BLOCKING, true);
+    if (!reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createReaderFailed"));
+        return nullptr;
+    }
+    auto writer = output->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+
+    auto outputFormat = inputFormat;
+    outputFormat.numChannels = 1;
+    return std::unique_ptr<AudioFrontend>(
+        new AudioFrontend(std::move(reader), std::move(writer), outputFormat, std::move(processor)));
+}
+
+AudioFrontend::~AudioFrontend() {
+    m_isShuttingDown = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+AudioFormat AudioFrontend::getOutputFormat() const {
+    return m_outputFormat;
+}
+
+AudioFrontend::Statistics AudioFrontend::getStatistics() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+AudioFrontend::AudioFrontend(
+    std::unique_ptr<AudioInputStream::Reader> reader,
+    std::unique_ptr<AudioInputStream::Writer> writer,
+    const AudioFormat& outputFormat,
+    std::unique_ptr<FrontendProcessor> processor) :
+        m_reader{std::move(reader)},
+        m_writer{std::move(writer)},
+        m_outputFormat(outputFormat),
+        m_processor{std::move(processor)},
+        m_statistics{0, std::chrono::nanoseconds::zero(), std::chrono::nanoseconds::zero(), 0},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&AudioFrontend::processingLoop, this);
+}
+
+void AudioFrontend::processingLoop() {
+    auto frameSize = m_processor->getFrameSizeInSamples();
+    std::vector<int16_t> input(frameSize * m_processor->getNumChannels());
+    std::vector<int16_t> output(frameSize);
+
+    while (!m_isShuttingDown) {
+        auto words = m_reader->read(input.data(), frameSize, READ_TIMEOUT);
+        if (words > 0) {
+            auto start = std::chrono::steady_clock::now();
+            m_processor->process(input.data(), words, output.data());
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_statistics.framesProcessed += words;
+                m_statistics.processingTime += elapsed;
+                if (elapsed > m_statistics.maxBlockProcessingTime) {
+                    m_statistics.maxBlockProcessingTime = elapsed;
+                }
+            }
+            auto written = m_writer->write(output.data(), words);
+            if (written != words) {
+                ACSDK_ERROR(LX("processingLoopFailed").d("reason", "writeFailed").d("result", written));
+                break;
+            }
+            continue;
+        }
+        switch (words) {
+            case AudioInputStream::Reader::Error::TIMEDOUT:
+                continue;
+            case AudioInputStream::Reader::Error::OVERRUN:
+                ACSDK_ERROR(LX("processingLoopFailed").d("reason", "streamOverrun"));
+                {
+                    std::lock_guard<std::mutex> lock{m_mutex};
+                    ++m_statistics.overruns;
+                }
+                m_reader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+                m_processor->reset();
+                continue;
+            case AudioInputStream::Reader::Error::CLOSED:
+                ACSDK_INFO(LX("processingLoop").d("reason", "streamClosed"));
+                break;
+            default:
+                ACSDK_ERROR(LX("processingLoopFailed").d("reason", "unexpectedError").d("error", words));
+                break;
+        }
+        break;
+    }
+    m_reader->close();
+    m_writer->close();
+}
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioFrontend/AutomaticGainControl.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+namespace kernels = avsCommon::utils::audio::kernels;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AutomaticGainControl");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The level of a full scale 16-bit sample.
+static const float FULL_SCALE = 32768.0f;
+
+/// The share of the envelope kept each frame while the level is below it.
+static const float ENVELOPE_RELEASE = 0.95f;
+
+/// The share of the distance to the desired gain covered each frame while the gain climbs.
+static const float GAIN_CLIMB_RATE = 0.05f;
+
+/**
+ * Converts decibels to a linear factor.
+ *
+ * @param decibels The decibels.
+ * @return The factor.
+ */
+static float fromDecibels(float decibels) {
+    return std::pow(10.0f, decibels / 20.0f);
+}
+
+std::unique_ptr<AutomaticGainControl> AutomaticGainControl::create(
+    float targetLevelDbfs,
+    float maxGainDb,
+    float noiseGateDbfs) {
+    if (targetLevelDbfs >= 0.0f || noiseGateDbfs >= 0.0f || maxGainDb < 0.0f) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidLevels")
+                        .d("targetLevelDbfs", targetLevelDbfs)
+                        .d("maxGainDb", maxGainDb)
+                        .d("noiseGateDbfs", noiseGateDbfs));
+        return nullptr;
+    }
+    return std::unique_ptr<AutomaticGainControl>(new AutomaticGainControl(
+        FULL_SCALE * fromDecibels(targetLevelDbfs), fromDecibels(maxGainDb), FULL_SCALE * fromDecibels(noiseGateDbfs)));
+}
+
+void AutomaticGainControl::process(float* data, size_t numSamples) {
+    if (0 == numSamples) {
+        return;
+    }
+    float level = std::sqrt(kernels::sumOfSquares(data, numSamples) / numSamples);
+    if (level > m_envelope) {
+        m_envelope = level;
+    } else {
+        m_envelope = ENVELOPE_RELEASE * m_envelope + (1.0f - ENVELOPE_RELEASE) * level;
+    }
+
+    float gain = m_gain;
+    if (m_envelope >= m_noiseGate) {
+        float desired = std::min(m_targetLevel / m_envelope, m_maxGain);
+        if (desired < gain) {
+            gain = desired;
+        } else {
+            gain += GAIN_CLIMB_RATE * (desired - gain);
+        }
+    }
+    kernels::applyGainRamp(data, numSamples, m_gain, gain);
+    m_gain = gain;
+}
+
+float AutomaticGainControl::getGain() const {
+    return m_gain;
+}
+
+void AutomaticGainControl::reset() {
+    m_envelope = 0.0f;
+    m_gain = 1.0f;
+}
+
+AutomaticGainControl::AutomaticGainControl(float targetLevel, float maxGain, float noiseGate) :
+        m_targetLevel{targetLevel},
+        m_maxGain{maxGain},
+        m_noiseGate{noiseGate},
+        m_envelope{0.0f},
+        m_gain{1.0f} {
+}
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioFrontend/DelayAndSumBeamformer.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+namespace kernels = avsCommon::utils::audio::kernels;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DelayAndSumBeamformer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The largest delay accepted, which is far longer than sound takes to cross any microphone array.
+static const unsigned int MAX_DELAY_IN_SAMPLES = 1024;
+
+/// The number of degrees in half a turn.
+static const float HALF_TURN_IN_DEGREES = 180.0f;
+
+constexpr float DelayAndSumBeamformer::SPEED_OF_SOUND;
+
+std::vector<unsigned int> DelayAndSumBeamformer::computeLinearArrayDelays(
+    size_t numMicrophones,
+    float spacingInMillimeters,
+    float steeringAngleInDegrees,
+    unsigned int sampleRateHz) {
+    // Sound from the steering direction reaches microphone i this many samples after it reaches microphone 0.
+    float pi = std::acos(-1.0f);
+    float step = -spacingInMillimeters / 1000.0f * std::sin(steeringAngleInDegrees * pi / HALF_TURN_IN_DEGREES) /
+                 SPEED_OF_SOUND * sampleRateHz;
+    std::vector<float> arrivals(numMicrophones);
+    for (size_t i = 0; i < numMicrophones; ++i) {
+        arrivals[i] = step * i;
+    }
+    std::vector<unsigned int> delays(numMicrophones);
+    if (numMicrophones > 0) {
+        float latest = *std::max_element(arrivals.begin(), arrivals.end());
+        for (size_t i = 0; i < numMicrophones; ++i) {
+            delays[i] = static_cast<unsigned int>(std::lround(latest - arrivals[i]));
+        }
+    }
+    return delays;
+}
+
+std::unique_ptr<DelayAndSumBeamformer> DelayAndSumBeamformer::create(
+    const std::vector<unsigned int>& delaysInSamples,
+    size_t maxFramesPerCall) {
+    if (delaysInSamples.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noChannels"));
+        return nullptr;
+    }
+    if (0 == maxFramesPerCall) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxFramesPerCall"));
+        return nullptr;
+    }
+    auto maxDelay = *std::max_element(delaysInSamples.begin(), delaysInSamples.end());
+    if (maxDelay > MAX_DELAY_IN_SAMPLES) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "delayTooLong").d("delay", maxDelay));
+        return nullptr;
+    }
+    return std::unique_ptr<DelayAndSumBeamformer>(new DelayAndSumBeamformer(delaysInSamples, maxFramesPerCall));
+}
+
+size_t DelayAndSumBeamformer::getNumChannels() const {
+    return m_delays.size();
+}
+
+void DelayAndSumBeamformer::process(const int16_t* input, size_t numFrames, float* output) {
+    numFrames = std::min(numFrames, m_maxFramesPerCall);
+    auto numChannels = m_delays.size();
+    float weight = 1.0f / numChannels;
+
+    std::fill(output, output + numFrames, 0.0f);
+    for (size_t channel = 0; channel < numChannels; ++channel) {
+        auto& samples = m_channels[channel];
+        kernels::deinterleaveToFloat(input, numChannels, channel, samples.data() + m_maxDelay, numFrames);
+        kernels::accumulateScaled(output, samples.data() + m_maxDelay - m_delays[channel], weight, numFrames);
+        std::copy(samples.begin() + numFrames, samples.begin() + numFrames + m_maxDelay, samples.begin());
+    }
+}
+
+void DelayAndSumBeamformer::reset() {
+    for (auto& samples : m_channels) {
+        std::fill(samples.begin(), samples.end(), 0.0f);
+    }
+}
+
+DelayAndSumBeamformer::DelayAndSumBeamformer(
+    const std::vector<unsigned int>& delaysInSamples,
+    size_t maxFramesPerCall) :
+        m_delays{delaysInSamples},
+        m_maxDelay{*std::max_element(delaysInSamples.begin(), delaysInSamples.end())},
+        m_maxFramesPerCall{maxFramesPerCall},
+        m_channels(delaysInSamples.size(), std::vector<float>(m_maxDelay + maxFramesPerCall, 0.0f)) {
+}
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
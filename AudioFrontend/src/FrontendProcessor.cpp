@@ -0,0 +1,145 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioFrontend/FrontendProcessor.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+namespace kernels = avsCommon::utils::audio::kernels;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("FrontendProcessor");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The default cutoff of the high-pass filter, below the fundamental of most voices.
+static const unsigned int DEFAULT_HIGH_PASS_CUTOFF_HZ = 80;
+
+/// The default level the automatic gain control brings speech to.
+static const float DEFAULT_AGC_TARGET_LEVEL_DBFS = -20.0f;
+
+/// The default largest gain of the automatic gain control.
+static const float DEFAULT_AGC_MAX_GAIN_DB = 24.0f;
+
+/// The default noise gate of the automatic gain control.
+static const float DEFAULT_AGC_NOISE_GATE_DBFS = -55.0f;
+
+/// The default frame duration, which matches the 10 ms frames keyword engines commonly read.
+static const std::chrono::milliseconds DEFAULT_FRAME_DURATION(10);
+
+FrontendProcessor::Config::Config() :
+        highPassCutoffHz{DEFAULT_HIGH_PASS_CUTOFF_HZ},
+        agcEnabled{true},
+        agcTargetLevelDbfs{DEFAULT_AGC_TARGET_LEVEL_DBFS},
+        agcMaxGainDb{DEFAULT_AGC_MAX_GAIN_DB},
+        agcNoiseGateDbfs{DEFAULT_AGC_NOISE_GATE_DBFS},
+        frameDuration{DEFAULT_FRAME_DURATION} {
+}
+
+std::unique_ptr<FrontendProcessor> FrontendProcessor::create(const Config& config, unsigned int sampleRateHz) {
+    size_t frameSize = sampleRateHz * config.frameDuration.count() / 1000;
+    if (0 == frameSize) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "emptyFrame")
+                        .d("rate", sampleRateHz)
+                        .d("frameDurationMs", config.frameDuration.count()));
+        return nullptr;
+    }
+    auto beamformer = DelayAndSumBeamformer::create(config.delaysInSamples, frameSize);
+    if (!beamformer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createBeamformerFailed"));
+        return nullptr;
+    }
+    std::unique_ptr<HighPassFilter> highPassFilter;
+    if (config.highPassCutoffHz > 0) {
+        highPassFilter = HighPassFilter::create(config.highPassCutoffHz, sampleRateHz);
+        if (!highPassFilter) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createHighPassFilterFailed"));
+            return nullptr;
+        }
+    }
+    std::unique_ptr<AutomaticGainControl> agc;
+    if (config.agcEnabled) {
+        agc = AutomaticGainControl::create(config.agcTargetLevelDbfs, config.agcMaxGainDb, config.agcNoiseGateDbfs);
+        if (!agc) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createAgcFailed"));
+            return nullptr;
+        }
+    }
+    return std::unique_ptr<FrontendProcessor>(
+        new FrontendProcessor(frameSize, std::move(beamformer), std::move(highPassFilter), std::move(agc)));
+}
+
+size_t FrontendProcessor::getNumChannels() const {
+    return m_beamformer->getNumChannels();
+}
+
+size_t FrontendProcessor::getFrameSizeInSamples() const {
+    return m_frameSize;
+}
+
+void FrontendProcessor::process(const int16_t* input, size_t numFrames, int16_t* output) {
+    auto numChannels = m_beamformer->getNumChannels();
+    while (numFrames > 0) {
+        auto count = std::min(numFrames, m_frameSize);
+        m_beamformer->process(input, count, m_frame.data());
+        if (m_highPassFilter) {
+            m_highPassFilter->process(m_frame.data(), count);
+        }
+        if (m_agc) {
+            m_agc->process(m_frame.data(), count);
+        }
+        kernels::floatToInt16(m_frame.data(), output, count);
+        input += count * numChannels;
+        output += count;
+        numFrames -= count;
+    }
+}
+
+void FrontendProcessor::reset() {
+    m_beamformer->reset();
+    if (m_highPassFilter) {
+        m_highPassFilter->reset();
+    }
+    if (m_agc) {
+        m_agc->reset();
+    }
+}
+
+FrontendProcessor::FrontendProcessor(
+    size_t frameSize,
+    std::unique_ptr<DelayAndSumBeamformer> beamformer,
+    std::unique_ptr<HighPassFilter> highPassFilter,
+    std::unique_ptr<AutomaticGainControl> agc) :
+        m_frameSize{frameSize},
+        m_beamformer{std::move(beamformer)},
+        m_highPassFilter{std::move(highPassFilter)},
+        m_agc{std::move(agc)},
+        m_frame(frameSize) {
+}
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
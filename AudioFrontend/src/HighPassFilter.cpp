@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cmath>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AudioFrontend/HighPassFilter.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("HighPassFilter");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::unique_ptr<HighPassFilter> HighPassFilter::create(unsigned int cutoffHz, unsigned int sampleRateHz) {
+    if (0 == cutoffHz || cutoffHz * 2 >= sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidCutoff").d("cutoffHz", cutoffHz).d("rate", sampleRateHz));
+        return nullptr;
+    }
+    return std::unique_ptr<HighPassFilter>(new HighPassFilter(cutoffHz, sampleRateHz));
+}
+
+void HighPassFilter::process(float* data, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        float in = data[i];
+        float out = m_b0 * in + m_z1;
+        m_z1 = m_b1 * in - m_a1 * out + m_z2;
+        m_z2 = m_b2 * in - m_a2 * out;
+        data[i] = out;
+    }
+}
+
+void HighPassFilter::reset() {
+    m_z1 = 0.0f;
+    m_z2 = 0.0f;
+}
+
+HighPassFilter::HighPassFilter(unsigned int cutoffHz, unsigned int sampleRateHz) : m_z1{0.0f}, m_z2{0.0f} {
+    // The high-pass biquad of the Audio EQ Cookbook, with the Q of a Butterworth filter.
+    double omega = 2.0 * std::acos(-1.0) * cutoffHz / sampleRateHz;
+    double alpha = std::sin(omega) / (2.0 * std::sqrt(0.5));
+    double cosine = std::cos(omega);
+    double a0 = 1.0 + alpha;
+    m_b0 = static_cast<float>((1.0 + cosine) / 2.0 / a0);
+    m_b1 = static_cast<float>(-(1.0 + cosine) / a0);
+    m_b2 = m_b0;
+    m_a1 = static_cast<float>(-2.0 * cosine / a0);
+    m_a2 = static_cast<float>((1.0 - alpha) / a0);
+}
+
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
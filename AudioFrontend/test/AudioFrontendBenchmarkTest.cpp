@@ -0,0 +1,199 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioFrontendBenchmarkTest.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+
+#include "AudioFrontend/FrontendProcessor.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+namespace test {
+
+namespace audio = avsCommon::utils::audio;
+namespace kernels = avsCommon::utils::audio::kernels;
+
+/// The path to the inputs folder, which is passed on the command line.
+std::string inputsDirPath;
+
+/// The recordings to run through the front end.  Mono recordings are turned into microphone array recordings.
+static const std::vector<std::string> RECORDINGS = {"/four_alexa.wav", "/alexa_stop_alexa_joke.wav"};
+
+/// The sample rate of the recordings.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of microphones of the simulated array.
+static const size_t NUM_SIMULATED_MICROPHONES = 4;
+
+/// The spacing of the simulated array.
+static const float SIMULATED_SPACING_MM = 35.0f;
+
+/// The direction of the talker in front of the simulated array.
+static const float SIMULATED_ANGLE_DEGREES = 60.0f;
+
+/// The RMS level of the independent noise of each simulated microphone.
+static const float SIMULATED_NOISE_LEVEL = 300.0f;
+
+/**
+ * The share of each frame's duration the front end may spend processing it.  The boards we ship on give the whole
+ * audio front end about a tenth of a core.
+ */
+static const double CPU_BUDGET_SHARE = 0.1;
+
+/// A recording read from a WAV file.
+struct Recording {
+    /// The number of channels.
+    size_t numChannels;
+    /// The sample rate.
+    unsigned int sampleRateHz;
+    /// The interleaved samples.
+    std::vector<int16_t> samples;
+};
+
+/**
+ * Reads a 16-bit PCM WAV file, of any number of channels.
+ *
+ * @param path The path of the file.
+ * @param[out] recording The recording.
+ * @return Whether the file was read.
+ */
+static bool readWav(const std::string& path, Recording* recording) {
+    unsigned int numChannels = 0;
+    if (!audio::readWavFile(path, &recording->sampleRateHz, &numChannels, &recording->samples)) {
+        return false;
+    }
+    recording->numChannels = numChannels;
+    return true;
+}
+
+/**
+ * Turns a mono recording into the recording of a linear microphone array with the talker off to one side, by delaying
+ * the recording to each microphone and adding noise which is independent between the microphones.
+ *
+ * @param mono The mono recording.
+ * @return The array recording.
+ */
+static Recording simulateArray(const Recording& mono) {
+    auto delays = DelayAndSumBeamformer::computeLinearArrayDelays(
+        NUM_SIMULATED_MICROPHONES, SIMULATED_SPACING_MM, SIMULATED_ANGLE_DEGREES, mono.sampleRateHz);
+    auto maxDelay = *std::max_element(delays.begin(), delays.end());
+    std::mt19937 generator(0);
+    std::normal_distribution<float> noise(0.0f, SIMULATED_NOISE_LEVEL);
+
+    Recording array{NUM_SIMULATED_MICROPHONES, mono.sampleRateHz, {}};
+    auto numFrames = mono.samples.size();
+    array.samples.resize(numFrames * NUM_SIMULATED_MICROPHONES);
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        for (size_t channel = 0; channel < NUM_SIMULATED_MICROPHONES; ++channel) {
+            // The beamformer delays microphone i by delays[i], so sound reaches it (maxDelay - delays[i]) late.
+            size_t lag = maxDelay - delays[channel];
+            float sample = (frame >= lag ? mono.samples[frame - lag] : 0) + noise(generator);
+            sample = std::min(std::max(sample, -32768.0f), 32767.0f);
+            array.samples[frame * NUM_SIMULATED_MICROPHONES + channel] = static_cast<int16_t>(sample);
+        }
+    }
+    return array;
+}
+
+/**
+ * Gets the CPU time used by the calling thread.
+ *
+ * @return The CPU time.
+ */
+static std::chrono::nanoseconds threadCpuTime() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+/**
+ * Runs each recording through the signal chain one frame at a time, and reports the CPU time spent per frame against
+ * the budget.  The time depends on the machine and its load, so it is only reported, and does not fail the test.
+ */
+TEST(AudioFrontendBenchmarkTest, perFrameCpuBudget) {
+    std::cout << "Instruction set: " << kernels::getInstructionSet() << std::endl;
+    for (const auto& name : RECORDINGS) {
+        Recording recording;
+        ASSERT_TRUE(readWav(inputsDirPath + name, &recording)) << "Unable to read " << inputsDirPath + name;
+        ASSERT_EQ(SAMPLE_RATE_HZ, recording.sampleRateHz);
+
+        FrontendProcessor::Config config;
+        if (1 == recording.numChannels) {
+            recording = simulateArray(recording);
+            config.delaysInSamples = DelayAndSumBeamformer::computeLinearArrayDelays(
+                NUM_SIMULATED_MICROPHONES, SIMULATED_SPACING_MM, SIMULATED_ANGLE_DEGREES, SAMPLE_RATE_HZ);
+        } else {
+            config.delaysInSamples = std::vector<unsigned int>(recording.numChannels, 0);
+        }
+        auto processor = FrontendProcessor::create(config, SAMPLE_RATE_HZ);
+        ASSERT_TRUE(processor);
+
+        auto frameSize = processor->getFrameSizeInSamples();
+        auto numFrames = recording.samples.size() / recording.numChannels / frameSize;
+        std::vector<int16_t> output(frameSize);
+        std::vector<std::chrono::nanoseconds> times;
+        times.reserve(numFrames);
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            auto start = threadCpuTime();
+            processor->process(
+                recording.samples.data() + frame * frameSize * recording.numChannels, frameSize, output.data());
+            times.push_back(threadCpuTime() - start);
+        }
+        ASSERT_FALSE(times.empty());
+
+        std::sort(times.begin(), times.end());
+        std::chrono::nanoseconds total(0);
+        for (auto time : times) {
+            total += time;
+        }
+        auto mean = total / times.size();
+        auto p99 = times[times.size() * 99 / 100];
+        auto budget = std::chrono::duration_cast<std::chrono::nanoseconds>(config.frameDuration) * CPU_BUDGET_SHARE;
+        std::cout << name << ": " << recording.numChannels << " channels, " << times.size() << " frames of "
+                  << config.frameDuration.count() << " ms, CPU per frame mean "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(mean).count() << " us, p99 "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(p99).count() << " us, max "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(times.back()).count() << " us, "
+                  << 100.0 * mean.count() / budget.count() << "% of the budget" << std::endl;
+    }
+}
+
+}  // namespace test
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::audioFrontend::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
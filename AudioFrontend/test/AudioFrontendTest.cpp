@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioFrontendTest.cpp
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioFrontend/AudioFrontend.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// The number of microphones of the tests.
+static const size_t NUM_CHANNELS = 2;
+
+/// The number of frames the streams hold.
+static const size_t STREAM_SIZE = 16000;
+
+/// The number of readers of the streams.
+static const size_t MAX_READERS = 2;
+
+/// How long to wait for processed audio.
+static const std::chrono::seconds TIMEOUT(2);
+
+/**
+ * Creates an @c AudioInputStream.
+ *
+ * @param wordSize The size of a word.
+ * @return The stream.
+ */
+static std::shared_ptr<AudioInputStream> createStream(size_t wordSize) {
+    auto bufferSize = AudioInputStream::calculateBufferSize(STREAM_SIZE, wordSize, MAX_READERS);
+    return AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), wordSize, MAX_READERS);
+}
+
+/// Test harness for @c AudioFrontend.
+class AudioFrontendTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /// The microphone array stream.
+    std::shared_ptr<AudioInputStream> m_input;
+
+    /// The mono stream.
+    std::shared_ptr<AudioInputStream> m_output;
+
+    /// The format of the microphone array stream.
+    AudioFormat m_format;
+
+    /// The settings of the signal chain, which pass audio from broadside through unchanged.
+    FrontendProcessor::Config m_config;
+};
+
+void AudioFrontendTest::SetUp() {
+    m_input = createStream(NUM_CHANNELS * sizeof(int16_t));
+    m_output = createStream(sizeof(int16_t));
+    ASSERT_TRUE(m_input);
+    ASSERT_TRUE(m_output);
+    m_format = {AudioFormat::Encoding::LPCM,
+                AudioFormat::Endianness::LITTLE,
+                16000,
+                16,
+                NUM_CHANNELS,
+                false,
+                AudioFormat::Layout::INTERLEAVED};
+    m_config.delaysInSamples = std::vector<unsigned int>(NUM_CHANNELS, 0);
+    m_config.highPassCutoffHz = 0;
+    m_config.agcEnabled = false;
+}
+
+/// Test that create() rejects missing streams, mismatched channel counts and word sizes, and unsupported rates.
+TEST_F(AudioFrontendTest, createWithInvalidArguments) {
+    EXPECT_FALSE(AudioFrontend::create(nullptr, m_format, m_output, m_config));
+    EXPECT_FALSE(AudioFrontend::create(m_input, m_format, nullptr, m_config));
+
+    auto config = m_config;
+    config.delaysInSamples.push_back(0);
+    EXPECT_FALSE(AudioFrontend::create(m_input, m_format, m_output, config));
+
+    EXPECT_FALSE(AudioFrontend::create(m_input, m_format, createStream(NUM_CHANNELS * sizeof(int16_t)), m_config));
+
+    auto format = m_format;
+    format.sampleRateHz = 48000;
+    EXPECT_FALSE(AudioFrontend::create(m_input, format, m_output, m_config));
+}
+
+/// Test that the stage writes one mono sample per frame of the array stream, and closes the mono stream after.
+TEST_F(AudioFrontendTest, processesArrayStreamIntoMonoStream) {
+    auto frontend = AudioFrontend::create(m_input, m_format, m_output, m_config);
+    ASSERT_TRUE(frontend);
+    EXPECT_EQ(1u, frontend->getOutputFormat().numChannels);
+    EXPECT_EQ(16000u, frontend->getOutputFormat().sampleRateHz);
+
+    auto reader = m_output->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    ASSERT_TRUE(reader);
+    auto writer = m_input->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+
+    const size_t numFrames = 1000;
+    std::vector<int16_t> input(numFrames * NUM_CHANNELS);
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        input[frame * NUM_CHANNELS] = static_cast<int16_t>(frame);
+        input[frame * NUM_CHANNELS + 1] = static_cast<int16_t>(frame + 2);
+    }
+    ASSERT_EQ(static_cast<ssize_t>(numFrames), writer->write(input.data(), numFrames));
+
+    std::vector<int16_t> output(numFrames);
+    size_t numRead = 0;
+    while (numRead < numFrames) {
+        auto result = reader->read(output.data() + numRead, numFrames - numRead, TIMEOUT);
+        ASSERT_GT(result, 0);
+        numRead += result;
+    }
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        ASSERT_EQ(static_cast<int16_t>(frame + 1), output[frame]) << "frame=" << frame;
+    }
+    EXPECT_EQ(numFrames, frontend->getStatistics().framesProcessed);
+    EXPECT_EQ(0u, frontend->getStatistics().overruns);
+
+    writer->close();
+    int16_t sample;
+    EXPECT_EQ(AudioInputStream::Reader::Error::CLOSED, reader->read(&sample, 1, TIMEOUT));
+}
+
+}  // namespace test
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
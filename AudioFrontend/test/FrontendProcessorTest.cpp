@@ -0,0 +1,201 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file FrontendProcessorTest.cpp
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioFrontend/FrontendProcessor.h"
+
+namespace alexaClientSDK {
+namespace audioFrontend {
+namespace test {
+
+/// The sample rate of the tests.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The spacing of a linear array whose neighbouring microphones are one sample apart at 16 kHz.
+static const float ONE_SAMPLE_SPACING_MM = DelayAndSumBeamformer::SPEED_OF_SOUND * 1000.0f / SAMPLE_RATE_HZ;
+
+/// The number of samples the tests process.
+static const size_t NUM_SAMPLES = 16000;
+
+/// The number of frames the beamformer tests pass to each call.
+static const size_t BLOCK_SIZE = 160;
+
+/**
+ * Computes the RMS level of a signal.
+ *
+ * @param samples The signal.
+ * @return The level.
+ */
+template <typename Sample>
+static double rms(const std::vector<Sample>& samples) {
+    double sum = 0;
+    for (auto sample : samples) {
+        sum += static_cast<double>(sample) * sample;
+    }
+    return std::sqrt(sum / samples.size());
+}
+
+/**
+ * Generates a sine wave.
+ *
+ * @param frequencyHz The frequency.
+ * @param amplitude The amplitude.
+ * @param numSamples The number of samples.
+ * @return The samples.
+ */
+static std::vector<float> sine(float frequencyHz, float amplitude, size_t numSamples) {
+    std::vector<float> samples(numSamples);
+    double pi = std::acos(-1.0);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = static_cast<float>(amplitude * std::sin(2.0 * pi * frequencyHz * i / SAMPLE_RATE_HZ));
+    }
+    return samples;
+}
+
+/// Test the delays of a linear array steered to broadside and to each end.
+TEST(FrontendProcessorTest, linearArrayDelays) {
+    auto broadside = DelayAndSumBeamformer::computeLinearArrayDelays(4, ONE_SAMPLE_SPACING_MM, 0.0f, SAMPLE_RATE_HZ);
+    EXPECT_EQ(std::vector<unsigned int>({0, 0, 0, 0}), broadside);
+    auto endFire = DelayAndSumBeamformer::computeLinearArrayDelays(4, ONE_SAMPLE_SPACING_MM, 90.0f, SAMPLE_RATE_HZ);
+    EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3}), endFire);
+    auto otherEnd = DelayAndSumBeamformer::computeLinearArrayDelays(4, ONE_SAMPLE_SPACING_MM, -90.0f, SAMPLE_RATE_HZ);
+    EXPECT_EQ(std::vector<unsigned int>({3, 2, 1, 0}), otherEnd);
+}
+
+/**
+ * Test that the beamformer lines up a signal arriving from the steering direction across blocks, and averages down
+ * noise which is independent between the microphones.
+ */
+TEST(FrontendProcessorTest, beamformerAlignsSignalAndReducesNoise) {
+    const size_t numChannels = 4;
+    auto delays = DelayAndSumBeamformer::computeLinearArrayDelays(numChannels, ONE_SAMPLE_SPACING_MM, 90.0f, 16000);
+    auto beamformer = DelayAndSumBeamformer::create(delays, BLOCK_SIZE);
+    ASSERT_TRUE(beamformer);
+    EXPECT_EQ(numChannels, beamformer->getNumChannels());
+
+    // The talker is beyond the last microphone, so sound reaches microphone i (3 - i) samples after the last one.
+    std::mt19937 generator(2);
+    std::uniform_int_distribution<int> distribution(-10000, 10000);
+    std::vector<int16_t> signal(NUM_SAMPLES);
+    for (auto& sample : signal) {
+        sample = static_cast<int16_t>(distribution(generator));
+    }
+    std::vector<int16_t> input(NUM_SAMPLES * numChannels, 0);
+    for (size_t frame = 0; frame < NUM_SAMPLES; ++frame) {
+        for (size_t channel = 0; channel < numChannels; ++channel) {
+            size_t lag = numChannels - 1 - channel;
+            input[frame * numChannels + channel] = frame >= lag ? signal[frame - lag] : 0;
+        }
+    }
+    std::vector<float> output(NUM_SAMPLES);
+    for (size_t frame = 0; frame < NUM_SAMPLES; frame += BLOCK_SIZE) {
+        beamformer->process(input.data() + frame * numChannels, BLOCK_SIZE, output.data() + frame);
+    }
+    for (size_t frame = numChannels - 1; frame < NUM_SAMPLES; ++frame) {
+        ASSERT_NEAR(signal[frame - (numChannels - 1)], output[frame], 0.01f) << "frame=" << frame;
+    }
+
+    // Independent noise on each microphone loses three quarters of its power.
+    for (auto& sample : input) {
+        sample = static_cast<int16_t>(distribution(generator));
+    }
+    beamformer->reset();
+    for (size_t frame = 0; frame < NUM_SAMPLES; frame += BLOCK_SIZE) {
+        beamformer->process(input.data() + frame * numChannels, BLOCK_SIZE, output.data() + frame);
+    }
+    double gainDb = 20.0 * std::log10(rms(output) / rms(input));
+    EXPECT_NEAR(-6.0, gainDb, 0.5);
+}
+
+/// Test that the high-pass filter removes DC and passes the voice band.
+TEST(FrontendProcessorTest, highPassFilter) {
+    auto filter = HighPassFilter::create(80, SAMPLE_RATE_HZ);
+    ASSERT_TRUE(filter);
+    EXPECT_FALSE(HighPassFilter::create(0, SAMPLE_RATE_HZ));
+    EXPECT_FALSE(HighPassFilter::create(SAMPLE_RATE_HZ / 2, SAMPLE_RATE_HZ));
+
+    std::vector<float> dc(NUM_SAMPLES, 1000.0f);
+    filter->process(dc.data(), dc.size());
+    EXPECT_NEAR(0.0f, dc.back(), 1.0f);
+
+    filter->reset();
+    auto tone = sine(1000.0f, 1000.0f, NUM_SAMPLES);
+    filter->process(tone.data(), tone.size());
+    std::vector<float> settled(tone.begin() + NUM_SAMPLES / 2, tone.end());
+    EXPECT_NEAR(1000.0 / std::sqrt(2.0), rms(settled), 10.0);
+}
+
+/// Test that the gain control raises quiet speech toward the target, cuts loud speech, and holds its gain in silence.
+TEST(FrontendProcessorTest, automaticGainControl) {
+    const size_t frameSize = 160;
+    auto agc = AutomaticGainControl::create(-20.0f, 24.0f, -55.0f);
+    ASSERT_TRUE(agc);
+    EXPECT_FALSE(AutomaticGainControl::create(0.0f, 24.0f, -55.0f));
+
+    // -40 dBFS RMS, which needs 20 dB of gain.
+    auto quiet = sine(500.0f, 32768.0f * 0.01f * std::sqrt(2.0f), NUM_SAMPLES * 3);
+    for (size_t i = 0; i + frameSize <= quiet.size(); i += frameSize) {
+        agc->process(quiet.data() + i, frameSize);
+    }
+    EXPECT_NEAR(20.0, 20.0 * std::log10(agc->getGain()), 1.0);
+
+    // -6 dBFS RMS, which needs 14 dB of attenuation, within a frame.
+    auto loud = sine(500.0f, 32768.0f * 0.5f * std::sqrt(2.0f), frameSize * 2);
+    agc->process(loud.data(), frameSize);
+    EXPECT_NEAR(-14.0, 20.0 * std::log10(agc->getGain()), 1.0);
+
+    // Silence below the noise gate.
+    agc->reset();
+    std::vector<float> silence(frameSize, 1.0f);
+    for (int i = 0; i < 100; ++i) {
+        agc->process(silence.data(), frameSize);
+    }
+    EXPECT_EQ(1.0f, agc->getGain());
+}
+
+/// Test that the signal chain turns interleaved audio of any block size into the same number of mono samples.
+TEST(FrontendProcessorTest, processorOutputsMono) {
+    FrontendProcessor::Config config;
+    config.delaysInSamples = {0, 1};
+    auto processor = FrontendProcessor::create(config, SAMPLE_RATE_HZ);
+    ASSERT_TRUE(processor);
+    EXPECT_EQ(2u, processor->getNumChannels());
+    EXPECT_EQ(160u, processor->getFrameSizeInSamples());
+
+    auto tone = sine(300.0f, 3000.0f, 1000);
+    std::vector<int16_t> input(tone.size() * 2);
+    for (size_t i = 0; i < tone.size(); ++i) {
+        input[2 * i] = static_cast<int16_t>(tone[i]);
+        input[2 * i + 1] = static_cast<int16_t>(tone[i]);
+    }
+    std::vector<int16_t> output(tone.size() + 1, 12345);
+    processor->process(input.data(), tone.size(), output.data());
+    EXPECT_EQ(12345, output.back());
+    EXPECT_GT(rms(std::vector<int16_t>(output.begin() + 500, output.end() - 1)), 1000.0);
+
+    config.delaysInSamples.clear();
+    EXPECT_FALSE(FrontendProcessor::create(config, SAMPLE_RATE_HZ));
+}
+
+}  // namespace test
+}  // namespace audioFrontend
+}  // namespace alexaClientSDK
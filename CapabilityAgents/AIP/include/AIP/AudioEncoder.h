@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "AIP/AudioEncoderInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * A stage which encodes the LPCM audio of a Recognize event before it is uploaded.
+ *
+ * When encoding starts, a thread reads the LPCM stream with a reader of its own, and writes the encoded audio to a new
+ * stream, which @c AudioInputProcessor uploads in place of the LPCM stream.  Each word of the encoded stream is one
+ * frame from the @c AudioEncoderInterface, so the stream holds the fixed size frames back to back.  Other readers of
+ * the LPCM stream, such as keyword detectors, are not affected.
+ *
+ * This class is thread safe.
+ */
+class AudioEncoder {
+public:
+    /// The amounts of audio encoded.
+    struct Statistics {
+        /// The number of bytes of LPCM audio read.
+        uint64_t bytesRead;
+        /// The number of bytes of encoded audio written.
+        uint64_t bytesWritten;
+    };
+
+    /**
+     * Creates an @c AudioEncoder.
+     *
+     * @param encoder The codec to encode with.
+     * @return The @c AudioEncoder, or @c nullptr if the codec is missing or its formats are not supported.
+     */
+    static std::shared_ptr<AudioEncoder> create(std::shared_ptr<AudioEncoderInterface> encoder);
+
+    /// Destructor.  Stops encoding.
+    ~AudioEncoder();
+
+    /**
+     * Checks whether audio of a format can be encoded.
+     *
+     * @param format The format.
+     * @return Whether the format is the input format of the codec.
+     */
+    bool canEncode(const avsCommon::utils::AudioFormat& format) const;
+
+    /**
+     * Gets the format of the encoded streams.
+     *
+     * @return The output format of the codec.
+     */
+    avsCommon::utils::AudioFormat getOutputFormat() const;
+
+    /**
+     * Starts encoding a stream, stopping the encoding of any previous stream.
+     *
+     * @param input The LPCM stream.
+     * @param begin The index of the first sample to encode, or @c AudioInputProcessor::INVALID_INDEX to start with the
+     *     next sample written.
+     * @return The encoded stream, whose first frame is at index zero, or @c nullptr if encoding could not start.
+     */
+    std::shared_ptr<avsCommon::avs::AudioInputStream> startEncoding(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> input,
+        avsCommon::avs::AudioInputStream::Index begin);
+
+    /**
+     * Stops encoding, and closes the encoded stream.  Does nothing if no stream is being encoded.
+     *
+     * @param stopImmediately Whether to stop right away.  If @c false, the samples already written to the LPCM stream
+     *     are encoded before this returns, with the last frame padded with silence.
+     */
+    void stopEncoding(bool stopImmediately);
+
+    /**
+     * Gets the amounts of audio encoded since this object was created.
+     *
+     * @return The statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param encoder The codec to encode with.
+     */
+    AudioEncoder(std::shared_ptr<AudioEncoderInterface> encoder);
+
+    /**
+     * Stops encoding.  @c m_controlMutex must be held when this is called.
+     *
+     * @param stopImmediately Whether to stop without encoding the rest of the samples.
+     */
+    void stopEncodingLocked(bool stopImmediately);
+
+    /**
+     * The loop of the encoding thread.
+     *
+     * @param reader The reader of the LPCM stream.
+     * @param writer The writer of the encoded stream.
+     */
+    void encodingLoop(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> writer);
+
+    /**
+     * Encodes a frame and writes it to the encoded stream.
+     *
+     * @param samples The samples of the frame.
+     * @param writer The writer of the encoded stream.
+     * @return Whether the frame was written.
+     */
+    bool writeFrame(const int16_t* samples, std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> writer);
+
+    /// The codec.
+    const std::shared_ptr<AudioEncoderInterface> m_encoder;
+
+    /// The input format of the codec.
+    const avsCommon::utils::AudioFormat m_inputFormat;
+
+    /// The output format of the codec.
+    const avsCommon::utils::AudioFormat m_outputFormat;
+
+    /// A buffer for one encoded frame, only used by the encoding thread.
+    std::vector<uint8_t> m_frame;
+
+    /// Serializes calls to @c startEncoding() and @c stopEncoding().
+    std::mutex m_controlMutex;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The reader of the LPCM stream being encoded, which is closed to stop the encoding thread.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
+
+    /// Whether the encoding thread should stop without encoding the rest of the samples it was given.
+    bool m_stopImmediately;
+
+    /// The amounts of audio encoded.
+    Statistics m_statistics;
+
+    /// The encoding thread.
+    std::thread m_thread;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
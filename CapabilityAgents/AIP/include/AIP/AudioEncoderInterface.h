@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODERINTERFACE_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODERINTERFACE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An interface to a codec which encodes fixed size frames of LPCM audio into fixed size frames of encoded audio, as
+ * used by an @c AudioEncoder.
+ *
+ * The methods of this interface are only called by one thread at a time.
+ */
+class AudioEncoderInterface {
+public:
+    /// Destructor.
+    virtual ~AudioEncoderInterface() = default;
+
+    /**
+     * Gets the format of the audio this codec encodes, which must be 16-bit LPCM.
+     *
+     * @return The input format.
+     */
+    virtual avsCommon::utils::AudioFormat getInputFormat() = 0;
+
+    /**
+     * Gets the format of the encoded audio, which must be one @c AudioInputProcessor accepts.
+     *
+     * @return The output format.
+     */
+    virtual avsCommon::utils::AudioFormat getOutputFormat() = 0;
+
+    /**
+     * Gets the number of samples in a frame of input audio.
+     *
+     * @return The number of samples.
+     */
+    virtual size_t getInputFrameSizeInSamples() = 0;
+
+    /**
+     * Gets the size of a frame of encoded audio.
+     *
+     * @return The number of bytes.
+     */
+    virtual size_t getOutputFrameSizeInBytes() = 0;
+
+    /**
+     * Resets the state of the codec before a new stream is encoded.
+     *
+     * @return Whether the codec is ready.
+     */
+    virtual bool start() = 0;
+
+    /**
+     * Encodes a frame of audio.
+     *
+     * @param samples The @c getInputFrameSizeInSamples() samples of the frame.
+     * @param[out] frame The buffer of @c getOutputFrameSizeInBytes() bytes to write the encoded frame to.
+     * @return Whether the frame was encoded.
+     */
+    virtual bool encode(const int16_t* samples, uint8_t* frame) = 0;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODERINTERFACE_H_
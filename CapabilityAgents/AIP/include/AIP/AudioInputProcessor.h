@@ -16,6 +16,7 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOINPUTPROCESSOR_H_
 #define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOINPUTPROCESSOR_H_
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 
@@ -36,7 +37,9 @@
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
+#include "AudioEncoder.h"
 #include "AudioProvider.h"
+#include "EndOfSpeechDetector.h"
 #include "ESPData.h"
 #include "Initiator.h"
 
@@ -69,6 +72,28 @@ public:
     /// A reserved @c Index value which is considered invalid.
     static const auto INVALID_INDEX = std::numeric_limits<avsCommon::avs::AudioInputStream::Index>::max();
 
+    /**
+     * How much of the audio around a wake word the Recognize events of @c Initiator::WAKEWORD upload, which trades
+     * the cloud's verification of the keyword against the bytes uploaded.  Both settings apply to the keyword indices
+     * passed to @c recognize(), and neither applies if the indices are not passed.
+     */
+    struct WakewordUploadConfig {
+        /// Constructor, which sets the defaults: 500 ms of pre-roll before the keyword.
+        WakewordUploadConfig();
+
+        /**
+         * The audio before the keyword to upload, so that the cloud can verify the keyword.  The keyword's indices
+         * are only sent if the stream holds this much audio before the keyword.
+         */
+        std::chrono::milliseconds preroll;
+
+        /**
+         * Whether to upload only the audio after the keyword, which leaves the cloud nothing to verify.  The
+         * initiator then carries no keyword indices, and @c preroll is ignored.
+         */
+        bool uploadFromKeywordEnd;
+    };
+
     /**
      * Creates a new @c AudioInputProcessor instance.
      *
@@ -82,6 +107,11 @@ public:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c avsCommon::AudioProvider::alwaysReadable).  This parameter is optional and
      *     defaults to an invalid @c avsCommon::AudioProvider.
+     * @param audioEncoder An optional @c AudioEncoder which encodes the audio of Recognize events before it is
+     *     uploaded, when the audio is in a format the encoder accepts.
+     * @param endOfSpeechDetector An optional @c EndOfSpeechDetector which ends the upload of near and far field
+     *     Recognize events when the user stops speaking, rather than when the StopCapture directive arrives.
+     * @param wakewordUploadConfig How much of the audio around a wake word to upload.
      * @return A @c std::shared_ptr to the new @c AudioInputProcessor instance.
      */
     static std::shared_ptr<AudioInputProcessor> create(
@@ -92,7 +122,10 @@ public:
         std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider = AudioProvider::null());
+        AudioProvider defaultAudioProvider = AudioProvider::null(),
+        std::shared_ptr<AudioEncoder> audioEncoder = nullptr,
+        std::shared_ptr<EndOfSpeechDetector> endOfSpeechDetector = nullptr,
+        const WakewordUploadConfig& wakewordUploadConfig = WakewordUploadConfig());
 
     /**
      * Adds an observer to be notified of AudioInputProcessor state changes.
@@ -230,6 +263,9 @@ private:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c AudioProvider::alwaysReadable).  This parameter is optional, and ignored if set
      *     to @c AudioProvider::null().
+     * @param audioEncoder The @c AudioEncoder for the audio of Recognize events, or @c nullptr.
+     * @param endOfSpeechDetector The @c EndOfSpeechDetector for Recognize events, or @c nullptr.
+     * @param wakewordUploadConfig How much of the audio around a wake word to upload.
      *
      * @note This constructor is private so that users are forced to use the @c create() factory function.  The primary
      *     reason for this is to ensure that a @c std::shared_ptr to the instance exists, which is a requirement for
@@ -242,7 +278,10 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider);
+        AudioProvider defaultAudioProvider,
+        std::shared_ptr<AudioEncoder> audioEncoder,
+        std::shared_ptr<EndOfSpeechDetector> endOfSpeechDetector,
+        const WakewordUploadConfig& wakewordUploadConfig);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -337,13 +376,17 @@ private:
      *     empty string.  This parameter is ignored if initiator is not @c WAKEWORD.  The only value currently
      *     accepted by AVS for keyword is "ALEXA".  See
      *     https://developer.amazon.com/public/solutions/alexa/alexa-voice-service/reference/context#recognizerstate
+     * @param keywordEnd The @c Index in @c audioProvider.stream where the wakeword ends, which the end of speech is
+     *     looked for after.  This parameter is optional, and defaults to @c INVALID_INDEX, in which case the end of
+     *     speech is looked for from @c begin.
      * @return @c true if the Recognize Event was started successfully, else @c false.
      */
     bool executeRecognize(
         AudioProvider provider,
         const std::string& initiatorJson,
         avsCommon::avs::AudioInputStream::Index begin = INVALID_INDEX,
-        const std::string& keyword = "");
+        const std::string& keyword = "",
+        avsCommon::avs::AudioInputStream::Index keywordEnd = INVALID_INDEX);
 
     /**
      * This function receives the full system context from @c ContextManager.  Context requests are initiated by
@@ -392,6 +435,20 @@ private:
      */
     bool executeStopCapture(bool stopImmediately = false, std::shared_ptr<DirectiveInfo> info = nullptr);
 
+    /**
+     * This function is called when @c m_endOfSpeechDetector finds the end of the user's speech, and stops the capture
+     * the same way a StopCapture directive would, as long as the Recognize event it was looking at is still being
+     * captured.
+     *
+     * @param reader The attachment reader of the Recognize event the end of speech was found in.
+     * @param reason Why detection ended.
+     * @param index The @c Index in the stream where detection ended.
+     */
+    void executeOnEndOfSpeechDetected(
+        std::weak_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> reader,
+        EndOfSpeechDetector::Reason reason,
+        avsCommon::avs::AudioInputStream::Index index);
+
     /**
      * This function forces the @c AudioInputProcessor back to the @c IDLE state.  This function can be called in any
      * state, and will end any Event which is currently in progress.
@@ -495,6 +552,15 @@ private:
      */
     AudioProvider m_defaultAudioProvider;
 
+    /// The encoder for the audio of Recognize events, or @c nullptr if the audio is uploaded as provided.
+    std::shared_ptr<AudioEncoder> m_audioEncoder;
+
+    /// The detector which ends near and far field Recognize events locally, or @c nullptr to wait for StopCapture.
+    std::shared_ptr<EndOfSpeechDetector> m_endOfSpeechDetector;
+
+    /// How much of the audio around a wake word to upload.
+    const WakewordUploadConfig m_wakewordUploadConfig;
+
     /**
      * The last @c AudioProvider used in an @c executeRecognize(); will be used for ExpectSpeech directives
      * if it is capable of streaming on demand (@c AudioProvider::alwaysReadable).
@@ -541,6 +607,12 @@ private:
      */
     std::shared_ptr<avsCommon::avs::MessageRequest> m_recognizeRequest;
 
+    /**
+     * The dialogRequestId of the current Recognize event, which the end of speech is traced under.  This string is set
+     * by a call to @c executeOnContextAvailable(), and cleared by @c executeResetState().
+     */
+    std::string m_dialogRequestId;
+
     /// The current state of the @c AudioInputProcessor.
     ObserverInterface::State m_state;
 
@@ -566,6 +638,13 @@ private:
      */
     std::function<void()> m_deferredStopCapture;
 
+    /**
+     * This flag is set when @c m_endOfSpeechDetector stops the capture of a Recognize event, so that the StopCapture
+     * directive which AVS still sends for it completes instead of failing.  It is cleared by the next call to
+     * @c executeRecognize() and by @c executeResetState().
+     */
+    bool m_stoppedCaptureLocally;
+
     /// This flag indicates whether the initial dialog UX State has been received.
     bool m_initialDialogUXStateReceived;
 
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDOFSPEECHDETECTOR_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDOFSPEECHDETECTOR_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "AIP/VoiceActivityDetectorInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * A stage which finds the end of an utterance in the audio of a Recognize event, so that @c AudioInputProcessor can
+ * finish the upload without waiting for a StopCapture directive.
+ *
+ * When detection starts, a thread reads the stream with a reader of its own and classifies each frame with a
+ * @c VoiceActivityDetectorInterface.  Once speech has lasted @c Config::minimumSpeechDuration, the first
+ * @c Config::hangover of silence after it ends the utterance.  If speech does not begin within
+ * @c Config::noSpeechTimeout, detection gives up.  Either way the callback is called once, from the detection thread,
+ * and the thread exits.  Durations are counted in audio, so a backlog of buffered audio is classified as fast as it
+ * can be read.
+ *
+ * This class is thread safe.
+ */
+class EndOfSpeechDetector {
+public:
+    /// The settings of the detector.
+    struct Config {
+        /// Constructor, which sets the defaults.
+        Config();
+
+        /// How long speech must last before silence can end it, which keeps clicks and pops from counting as speech.
+        std::chrono::milliseconds minimumSpeechDuration;
+
+        /// How much silence after speech ends the utterance.
+        std::chrono::milliseconds hangover;
+
+        /// How long to wait for speech to begin before giving up.
+        std::chrono::milliseconds noSpeechTimeout;
+    };
+
+    /// Why detection ended.
+    enum class Reason {
+        /// Speech was followed by @c Config::hangover of silence.
+        END_OF_SPEECH,
+        /// Speech did not begin within @c Config::noSpeechTimeout.
+        NO_SPEECH_TIMEOUT
+    };
+
+    /**
+     * The function called when detection ends.
+     *
+     * @param reason Why detection ended.
+     * @param index The index in the stream of the sample after the last one classified.
+     */
+    using Callback = std::function<void(Reason reason, avsCommon::avs::AudioInputStream::Index index)>;
+
+    /**
+     * Creates an @c EndOfSpeechDetector.
+     *
+     * @param voiceActivityDetector The detector to classify frames with.
+     * @param config The settings of the detector.
+     * @return The @c EndOfSpeechDetector, or @c nullptr if the detector is missing or the settings are invalid.
+     */
+    static std::shared_ptr<EndOfSpeechDetector> create(
+        std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+        const Config& config = Config());
+
+    /// Destructor.  Stops detection.
+    ~EndOfSpeechDetector();
+
+    /**
+     * Checks whether the end of speech can be detected in audio of a format.
+     *
+     * @param format The format.
+     * @return Whether the format is 16 kHz, 16-bit, little-endian mono LPCM.
+     */
+    bool canDetect(const avsCommon::utils::AudioFormat& format) const;
+
+    /**
+     * Starts looking for the end of speech in a stream, stopping any previous detection.
+     *
+     * @param stream The stream.
+     * @param begin The index of the first sample to classify, or @c AudioInputProcessor::INVALID_INDEX to start with
+     *     the next sample written.
+     * @param callback The function to call when detection ends.
+     * @return Whether detection started.
+     */
+    bool start(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::avs::AudioInputStream::Index begin,
+        Callback callback);
+
+    /**
+     * Stops detection without calling the callback, if it has not been called already.  Does nothing if detection is
+     * not running.
+     */
+    void stop();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param voiceActivityDetector The detector to classify frames with.
+     * @param config The settings of the detector.
+     */
+    EndOfSpeechDetector(
+        std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+        const Config& config);
+
+    /**
+     * Stops detection.  @c m_controlMutex must be held when this is called.
+     */
+    void stopLocked();
+
+    /**
+     * The loop of the detection thread.
+     *
+     * @param reader The reader of the stream.
+     * @param callback The function to call when detection ends.
+     */
+    void detectionLoop(std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader, Callback callback);
+
+    /// The detector which classifies frames.
+    const std::shared_ptr<VoiceActivityDetectorInterface> m_voiceActivityDetector;
+
+    /// The number of samples in a frame of @c m_voiceActivityDetector.
+    const size_t m_frameSize;
+
+    /// The number of voiced frames in a row which begin speech.
+    const size_t m_minimumSpeechFrames;
+
+    /// The number of silent frames in a row which end speech.
+    const size_t m_hangoverFrames;
+
+    /// The number of frames to classify before giving up on speech beginning.
+    const size_t m_noSpeechTimeoutFrames;
+
+    /// Serializes calls to @c start() and @c stop().
+    std::mutex m_controlMutex;
+
+    /// Serializes access to @c m_reader.
+    std::mutex m_mutex;
+
+    /// The reader of the stream being classified, which is closed to stop the detection thread.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
+
+    /// The detection thread.
+    std::thread m_thread;
+};
+
+/**
+ * Write a @c EndOfSpeechDetector::Reason value to an @c ostream.
+ *
+ * @param stream The stream to write the value to.
+ * @param reason The value to write to the @c ostream.
+ * @return The @c ostream that was passed in and written to.
+ */
+inline std::ostream& operator<<(std::ostream& stream, EndOfSpeechDetector::Reason reason) {
+    switch (reason) {
+        case EndOfSpeechDetector::Reason::END_OF_SPEECH:
+            return stream << "END_OF_SPEECH";
+        case EndOfSpeechDetector::Reason::NO_SPEECH_TIMEOUT:
+            return stream << "NO_SPEECH_TIMEOUT";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDOFSPEECHDETECTOR_H_
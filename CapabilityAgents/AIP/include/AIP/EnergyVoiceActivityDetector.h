@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENERGYVOICEACTIVITYDETECTOR_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENERGYVOICEACTIVITYDETECTOR_H_
+
+#include <chrono>
+#include <memory>
+
+#include "AIP/VoiceActivityDetectorInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * A voice activity detector which compares the energy of each frame against an estimate of the noise floor, and uses
+ * the zero-crossing rate of the frame to keep quiet fricatives, such as a trailing "s", from being taken for silence.
+ *
+ * The noise floor falls quickly to the level of quiet frames and rises slowly, so it follows changes in the room
+ * without being pulled up by speech.  The sample loops are vectorized with SSE2 on x86 and NEON on ARM.
+ */
+class EnergyVoiceActivityDetector : public VoiceActivityDetectorInterface {
+public:
+    /// The settings of the detector.
+    struct Config {
+        /// Constructor, which sets the defaults.
+        Config();
+
+        /// The duration of a frame.
+        std::chrono::milliseconds frameDuration;
+
+        /// How far above the noise floor a frame must be to be speech.
+        float speechThresholdDb;
+
+        /// The level below which a frame is never speech, however quiet the noise floor is.
+        float minimumSpeechLevelDbfs;
+
+        /**
+         * The share of neighbouring samples with opposite signs above which a frame is taken for a fricative, which
+         * only needs to be half of @c speechThresholdDb above the noise floor to be speech.
+         */
+        float fricativeZeroCrossingRate;
+
+        /// The noise floor assumed before any audio is classified.
+        float initialNoiseFloorDbfs;
+
+        /// How fast the noise floor may rise.
+        float noiseFloorRiseDbPerSecond;
+    };
+
+    /**
+     * Creates an @c EnergyVoiceActivityDetector.
+     *
+     * @param config The settings of the detector.
+     * @return The detector, or @c nullptr if the settings are invalid.
+     */
+    static std::unique_ptr<EnergyVoiceActivityDetector> create(const Config& config = Config());
+
+    /**
+     * Gets the name of the instruction set the sample loops were compiled for.
+     *
+     * @return "SSE2", "NEON" or "scalar".
+     */
+    static const char* getInstructionSet();
+
+    /// @name VoiceActivityDetectorInterface Functions
+    /// @{
+    size_t getFrameSizeInSamples() override;
+    void reset() override;
+    bool isVoiced(const int16_t* samples) override;
+    /// @}
+
+    /**
+     * Gets the current estimate of the noise floor.
+     *
+     * @return The noise floor in dBFS.
+     */
+    float getNoiseFloorDbfs() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param config The settings of the detector.
+     */
+    EnergyVoiceActivityDetector(const Config& config);
+
+    /// The settings of the detector.
+    const Config m_config;
+
+    /// The number of samples in a frame.
+    const size_t m_frameSize;
+
+    /// How far the noise floor may rise each frame.
+    const float m_noiseFloorRisePerFrame;
+
+    /// The estimate of the noise floor.
+    float m_noiseFloorDbfs;
+
+    /// The last sample of the previous frame, which zero crossings at the start of a frame are counted against.
+    int16_t m_previousSample;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENERGYVOICEACTIVITYDETECTOR_H_
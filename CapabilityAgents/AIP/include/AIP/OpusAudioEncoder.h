@@ -0,0 +1,74 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSAUDIOENCODER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSAUDIOENCODER_H_
+
+#include <memory>
+
+#include "AIP/AudioEncoderInterface.h"
+
+/// The libopus encoder state.
+struct OpusEncoder;
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c AudioEncoderInterface which encodes 16 kHz LPCM audio in the OPUS format of AVS: 20 ms frames at a constant
+ * 32 kbit/s, so that each frame is 80 bytes.
+ *
+ * This class is only built when the SDK is configured with @c -DOPUS=ON.
+ */
+class OpusAudioEncoder : public AudioEncoderInterface {
+public:
+    /**
+     * Creates an @c OpusAudioEncoder.
+     *
+     * @return The encoder, or @c nullptr if libopus could not create one.
+     */
+    static std::shared_ptr<OpusAudioEncoder> create();
+
+    /// Destructor.
+    ~OpusAudioEncoder() override;
+
+    /// @name AudioEncoderInterface methods
+    /// @{
+    avsCommon::utils::AudioFormat getInputFormat() override;
+    avsCommon::utils::AudioFormat getOutputFormat() override;
+    size_t getInputFrameSizeInSamples() override;
+    size_t getOutputFrameSizeInBytes() override;
+    bool start() override;
+    bool encode(const int16_t* samples, uint8_t* frame) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param encoder The libopus encoder, which this object takes over.
+     */
+    OpusAudioEncoder(::OpusEncoder* encoder);
+
+    /// The libopus encoder.
+    ::OpusEncoder* m_encoder;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSAUDIOENCODER_H_
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_VOICEACTIVITYDETECTORINTERFACE_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_VOICEACTIVITYDETECTORINTERFACE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An interface to a voice activity detector, which classifies fixed size frames of 16 kHz, 16-bit mono LPCM audio as
+ * speech or not, as used by an @c EndOfSpeechDetector.
+ *
+ * The methods of this interface are only called by one thread at a time.
+ */
+class VoiceActivityDetectorInterface {
+public:
+    /// Destructor.
+    virtual ~VoiceActivityDetectorInterface() = default;
+
+    /**
+     * Gets the number of samples in a frame.
+     *
+     * @return The number of samples.
+     */
+    virtual size_t getFrameSizeInSamples() = 0;
+
+    /// Resets the state of the detector before a new stream is classified.
+    virtual void reset() = 0;
+
+    /**
+     * Classifies a frame.
+     *
+     * @param samples The @c getFrameSizeInSamples() samples of the frame.
+     * @return Whether the frame holds speech.
+     */
+    virtual bool isVoiced(const int16_t* samples) = 0;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_VOICEACTIVITYDETECTORINTERFACE_H_
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_LOCALAVS_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_LOCALAVS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/SDKInterfaces/DirectiveSequencerInterface.h>
+#include <AVSCommon/SDKInterfaces/MessageObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace soak {
+
+/**
+ * A stand-in for AVS, which answers events in process so that Recognize can be driven without a connection.
+ *
+ * Events are handled one at a time, in the order they were sent, as the events of one connection are.  The audio of a
+ * @c Recognize event is read as it is captured, like an upload.  Once it has read the utterance's worth of audio after
+ * the keyword, or from the start if the initiator has no keyword indices, the stand-in sends @c StopCapture for the
+ * dialog request to the directive sequencer, and carries on reading until the client closes the audio.  Other events
+ * are completed as soon as they are handled.
+ */
+class LocalAVS : public avsCommon::sdkInterfaces::MessageSenderInterface {
+public:
+    /// The settings of the stand-in.
+    struct Config {
+        /// Constructor, which sets the defaults.
+        Config();
+
+        /// The amount of a Recognize event's audio after the keyword to read before sending StopCapture.
+        std::chrono::milliseconds utteranceDuration;
+        /// How long to wait for more audio when none is ready.
+        std::chrono::milliseconds pollInterval;
+    };
+
+    /// What happened to a Recognize event.
+    struct Upload {
+        /// The dialog request of the event.
+        std::string dialogRequestId;
+        /// The number of bytes of audio read.
+        uint64_t bytes;
+        /// The number of bytes of audio before the end of the keyword, according to the initiator.
+        uint64_t keywordEndBytes;
+        /// Whether the audio was overrun before it was all read.
+        bool overrun;
+        /// When the event was sent.
+        std::chrono::steady_clock::time_point sendTime;
+        /// When StopCapture was sent, or the epoch if it was not.
+        std::chrono::steady_clock::time_point stopCaptureTime;
+        /// When the audio was closed.
+        std::chrono::steady_clock::time_point endTime;
+    };
+
+    /**
+     * Creates a @c LocalAVS.
+     *
+     * @param directiveSequencer The sequencer to send directives to.
+     * @param format The format of the audio uploaded, which must be 16-bit linear PCM.
+     * @param config The settings of the stand-in.
+     * @return The stand-in, or @c nullptr if the arguments are invalid.
+     */
+    static std::shared_ptr<LocalAVS> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
+        const avsCommon::utils::AudioFormat& format,
+        const Config& config = Config());
+
+    /// Destructor.  Stops handling events.
+    ~LocalAVS();
+
+    /**
+     * Adds an observer to be notified of the directives sent, as the connection to AVS notifies them.
+     *
+     * @param observer The observer.
+     */
+    void addMessageObserver(std::shared_ptr<avsCommon::sdkInterfaces::MessageObserverInterface> observer);
+
+    /// @name MessageSenderInterface Functions
+    /// @{
+    void sendMessage(std::shared_ptr<avsCommon::avs::MessageRequest> request) override;
+    /// @}
+
+    /**
+     * Gets what happened to the Recognize events handled so far.
+     *
+     * @return The uploads, in the order they were sent.
+     */
+    std::vector<Upload> getUploads() const;
+
+    /**
+     * Gets the number of events handled so far, including Recognize events.
+     *
+     * @return The number of events.
+     */
+    uint64_t getEventCount() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param directiveSequencer The sequencer to send directives to.
+     * @param bytesPerSample The number of bytes of a sample of every channel of the audio uploaded.
+     * @param sampleRateHz The sample rate of the audio uploaded.
+     * @param config The settings of the stand-in.
+     */
+    LocalAVS(
+        std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
+        uint64_t bytesPerSample,
+        uint64_t sampleRateHz,
+        const Config& config);
+
+    /**
+     * Handles an event.
+     *
+     * @param request The event.
+     * @param sendTime When the event was sent.
+     */
+    void handleEvent(
+        std::shared_ptr<avsCommon::avs::MessageRequest> request,
+        std::chrono::steady_clock::time_point sendTime);
+
+    /**
+     * Sends a StopCapture directive.
+     *
+     * @param dialogRequestId The dialog request of the directive.
+     */
+    void sendStopCapture(const std::string& dialogRequestId);
+
+    /// The sequencer to send directives to.
+    const std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
+
+    /// The number of bytes of a sample of every channel of the audio uploaded.
+    const uint64_t m_bytesPerSample;
+
+    /// The sample rate of the audio uploaded.
+    const uint64_t m_sampleRateHz;
+
+    /// The settings of the stand-in.
+    const Config m_config;
+
+    /// Whether the stand-in is shutting down, which ends any upload being read.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The observers of the directives sent.
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::MessageObserverInterface>> m_observers;
+
+    /// What happened to the Recognize events handled so far.
+    std::vector<Upload> m_uploads;
+
+    /// The number of events handled so far.
+    uint64_t m_eventCount;
+
+    /// Handles the events in order, declared last so that it is shut down before the members it uses are destroyed.
+    avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace soak
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_LOCALAVS_H_
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_RECOGNIZEDRIVER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_RECOGNIZEDRIVER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AIP/AudioInputProcessor.h>
+#include <AudioCapture/FileAudioSource.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/AVS/DialogUXStateAggregator.h>
+#include <AVSCommon/SDKInterfaces/DirectiveSequencerInterface.h>
+
+#include "AIPSoak/LocalAVS.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace soak {
+
+/**
+ * Drives Recognize interactions through a complete @c AudioInputProcessor, fed by a @c FileAudioSource and answered
+ * by a @c LocalAVS, to soak the capture and upload path without a microphone or a connection.
+ *
+ * Each play of the file is one utterance.  As a play begins, the driver starts an interaction at its beginning, either
+ * with a tap or, once the keyword has been written, with a wake word detection at the keyword's indices.  The
+ * stand-in ends the upload with StopCapture, and the interaction completes when the processor returns to @c IDLE.
+ * Plays which begin while an interaction is still going on are skipped, as a user's speech would be.
+ */
+class RecognizeDriver {
+public:
+    /// How the driver starts interactions.
+    enum class Mode {
+        /// Start each interaction with a tap at the beginning of the play.
+        TAP,
+        /// Start each interaction with a wake word detection in the play.
+        WAKEWORD
+    };
+
+    /// The settings of a driver.
+    struct Config {
+        /// Constructor, which sets the defaults: ten tap interactions, written ten times faster than real time.
+        Config();
+
+        /// How interactions are started.
+        Mode mode;
+        /// The number of interactions to start.
+        unsigned int interactions;
+        /// Where the keyword begins in the file, for @c Mode::WAKEWORD.
+        std::chrono::milliseconds keywordBegin;
+        /// Where the keyword ends in the file, for @c Mode::WAKEWORD.
+        std::chrono::milliseconds keywordEnd;
+        /// The keyword detected, for @c Mode::WAKEWORD.
+        std::string keyword;
+        /// How much of the audio around the keyword is uploaded, for @c Mode::WAKEWORD.
+        AudioInputProcessor::WakewordUploadConfig wakewordUpload;
+        /// The amount of audio the stream holds.
+        std::chrono::milliseconds bufferDuration;
+        /// How long to wait for a play to begin, or for an interaction to complete, before giving up.
+        std::chrono::milliseconds interactionTimeout;
+        /// How long the dialog stays in @c THINKING after an upload before going back to @c IDLE.
+        std::chrono::milliseconds thinkingTimeout;
+        /// The settings of the audio source.  The number of loops is ignored: the file plays until the run ends.
+        audioCapture::FileAudioSource::Config source;
+        /// The settings of the stand-in for AVS.
+        LocalAVS::Config avs;
+    };
+
+    /// What happened during a run.
+    struct Report {
+        /// The number of interactions started.
+        uint64_t attempted;
+        /// The number of interactions which returned to @c IDLE after uploading audio.
+        uint64_t completed;
+        /// The number of interactions which were refused, timed out, or did not upload.
+        uint64_t failed;
+        /// The number of plays which began while an interaction was going on.
+        uint64_t skipped;
+        /// The number of Recognize events uploaded.
+        uint64_t uploads;
+        /// The number of bytes of audio uploaded.
+        uint64_t bytesUploaded;
+        /// The number of uploads whose audio was overrun.
+        uint64_t overruns;
+        /// The total time from starting an interaction to sending its Recognize event.
+        std::chrono::microseconds totalSendLatency;
+        /// The longest time from starting an interaction to sending its Recognize event.
+        std::chrono::microseconds maxSendLatency;
+        /// The total time from sending a Recognize event to the end of its audio.
+        std::chrono::microseconds totalUploadDuration;
+        /// The total time from starting an interaction to the stand-in reading the whole utterance.
+        std::chrono::microseconds totalStopCaptureLatency;
+        /// The amount of audio the source played during the run, including silence and dropouts.
+        std::chrono::milliseconds audioDuration;
+        /// How long the run took.
+        std::chrono::microseconds wallTime;
+        /// The processor time the process used during the run.
+        std::chrono::microseconds cpuTime;
+        /// The resident set size of the process when the run started, in kilobytes.
+        uint64_t residentStartKb;
+        /// The resident set size of the process when the run ended, in kilobytes.
+        uint64_t residentEndKb;
+        /// What the audio source wrote during the run.
+        audioCapture::FileAudioSource::Statistics source;
+    };
+
+    /**
+     * Creates a @c RecognizeDriver, with the processor and the stand-in it drives.
+     *
+     * @param path The path of the WAV or raw PCM file to play.
+     * @param config The settings of the driver.
+     * @return The driver, or @c nullptr if the file cannot be read or the settings are invalid.
+     */
+    static std::unique_ptr<RecognizeDriver> create(const std::string& path, const Config& config = Config());
+
+    /// Destructor.  Shuts down the processor and stops the audio source.
+    ~RecognizeDriver();
+
+    /**
+     * Plays the file and starts interactions until the configured number have been started.
+     *
+     * @return What happened during the run.
+     */
+    Report run();
+
+private:
+    /// Follows the processor's state for the driver.
+    class StateObserver;
+
+    /**
+     * Constructor.
+     *
+     * @param config The settings of the driver.
+     */
+    RecognizeDriver(const Config& config);
+
+    /**
+     * Creates the stream, the audio source, and the processor and the components it needs.
+     *
+     * @param path The path of the file to play.
+     * @return Whether everything was created.
+     */
+    bool init(const std::string& path);
+
+    /**
+     * Called on the source's thread as a play of the file begins.
+     *
+     * @param begin The index in the stream the play begins at.
+     */
+    void onLoopBegin(avsCommon::avs::AudioInputStream::Index begin);
+
+    /**
+     * Waits for the next play of the file to begin.
+     *
+     * @param[out] begin The index in the stream the play begins at.
+     * @param[out] skipped The number of plays which began before it and were not waited for.
+     * @return Whether a play began before the interaction timeout.
+     */
+    bool waitForLoopBegin(avsCommon::avs::AudioInputStream::Index* begin, uint64_t* skipped);
+
+    /**
+     * Starts an interaction on a play of the file and waits for it to complete.
+     *
+     * @param begin The index in the stream the play begins at.
+     * @param report The report to add the interaction to.
+     */
+    void interact(avsCommon::avs::AudioInputStream::Index begin, Report* report);
+
+    /// The settings of the driver.
+    const Config m_config;
+
+    /// The stream the source writes and the processor reads.
+    std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The audio source.
+    std::unique_ptr<audioCapture::FileAudioSource> m_source;
+
+    /// The format of the stream.
+    avsCommon::utils::AudioFormat m_format;
+
+    /// The sequencer the stand-in sends directives to.
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
+
+    /// The stand-in for AVS.
+    std::shared_ptr<LocalAVS> m_avs;
+
+    /// Aggregates the dialog state for the processor.
+    std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> m_dialogUXStateAggregator;
+
+    /// Follows the processor's state.
+    std::shared_ptr<StateObserver> m_stateObserver;
+
+    /// The processor.
+    std::shared_ptr<AudioInputProcessor> m_audioInputProcessor;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a play of the file begins.
+    std::condition_variable m_loopBegan;
+
+    /// The indexes of the plays which have begun and not been waited for.
+    std::deque<avsCommon::avs::AudioInputStream::Index> m_loopBegins;
+};
+
+}  // namespace soak
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_SOAK_INCLUDE_AIPSOAK_RECOGNIZEDRIVER_H_
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <thread>
+
+#include <rapidjson/document.h>
+
+#include <AVSCommon/AVS/AVSDirective.h>
+#include <AVSCommon/AVS/AVSMessageHeader.h>
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/Utils/JSON/JSONUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
+
+#include "AIPSoak/LocalAVS.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace soak {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::json::jsonUtils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LocalAVS");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The namespace of the speech recognizer's messages.
+static const std::string SPEECH_RECOGNIZER_NAMESPACE = "SpeechRecognizer";
+
+/// The name of the event which uploads audio.
+static const std::string RECOGNIZE_NAME = "Recognize";
+
+/// The name of the directive which ends an upload.
+static const std::string STOP_CAPTURE_NAME = "StopCapture";
+
+/// The default amount of a Recognize event's audio to read before sending StopCapture.
+static const std::chrono::milliseconds DEFAULT_UTTERANCE_DURATION(2000);
+
+/// The default time to wait for more audio when none is ready.
+static const std::chrono::milliseconds DEFAULT_POLL_INTERVAL(5);
+
+/// The number of bytes read from an upload at a time.
+static const size_t READ_SIZE_IN_BYTES = 3200;
+
+LocalAVS::Config::Config() : utteranceDuration{DEFAULT_UTTERANCE_DURATION}, pollInterval{DEFAULT_POLL_INTERVAL} {
+}
+
+std::shared_ptr<LocalAVS> LocalAVS::create(
+    std::shared_ptr<DirectiveSequencerInterface> directiveSequencer,
+    const avsCommon::utils::AudioFormat& format,
+    const Config& config) {
+    if (!directiveSequencer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullDirectiveSequencer"));
+        return nullptr;
+    }
+    if (avsCommon::utils::AudioFormat::Encoding::LPCM != format.encoding || format.sampleSizeInBits != 16 ||
+        0 == format.numChannels || 0 == format.sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedFormat"));
+        return nullptr;
+    }
+    if (config.pollInterval <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidPollInterval"));
+        return nullptr;
+    }
+    uint64_t bytesPerSample = format.numChannels * format.sampleSizeInBits / 8;
+    return std::shared_ptr<LocalAVS>(new LocalAVS(directiveSequencer, bytesPerSample, format.sampleRateHz, config));
+}
+
+LocalAVS::~LocalAVS() {
+    m_isShuttingDown = true;
+    m_executor.shutdown();
+}
+
+void LocalAVS::addMessageObserver(std::shared_ptr<MessageObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("addMessageObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_observers.insert(observer);
+}
+
+void LocalAVS::sendMessage(std::shared_ptr<MessageRequest> request) {
+    if (!request) {
+        ACSDK_ERROR(LX("sendMessageFailed").d("reason", "nullRequest"));
+        return;
+    }
+    auto sendTime = std::chrono::steady_clock::now();
+    m_executor.submit([this, request, sendTime]() { handleEvent(request, sendTime); });
+}
+
+std::vector<LocalAVS::Upload> LocalAVS::getUploads() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_uploads;
+}
+
+uint64_t LocalAVS::getEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_eventCount;
+}
+
+LocalAVS::LocalAVS(
+    std::shared_ptr<DirectiveSequencerInterface> directiveSequencer,
+    uint64_t bytesPerSample,
+    uint64_t sampleRateHz,
+    const Config& config) :
+        m_directiveSequencer{directiveSequencer},
+        m_bytesPerSample{bytesPerSample},
+        m_sampleRateHz{sampleRateHz},
+        m_config(config),
+        m_isShuttingDown{false},
+        m_eventCount{0} {
+}
+
+void LocalAVS::handleEvent(std::shared_ptr<MessageRequest> request, std::chrono::steady_clock::time_point sendTime) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_eventCount;
+    }
+
+    rapidjson::Document document;
+    document.Parse(request->getJsonContent());
+    rapidjson::Value::ConstMemberIterator event;
+    rapidjson::Value::ConstMemberIterator header;
+    std::string avsNamespace;
+    std::string name;
+    std::string dialogRequestId;
+    if (document.HasParseError() || !findNode(document, "event", &event) ||
+        !findNode(event->value, "header", &header) || !retrieveValue(header->value, "namespace", &avsNamespace) ||
+        !retrieveValue(header->value, "name", &name)) {
+        ACSDK_ERROR(LX("handleEventFailed").d("reason", "invalidEvent"));
+        request->sendCompleted(MessageRequestObserverInterface::Status::PROTOCOL_ERROR);
+        return;
+    }
+    // Only events which start a dialog have one.
+    retrieveValue(header->value, "dialogRequestId", &dialogRequestId);
+
+    // The utterance follows the keyword, if the initiator says where the keyword ends.
+    int64_t keywordEndSamples = 0;
+    const rapidjson::Value* indices = &event->value;
+    for (auto key : {"payload", "initiator", "payload", "wakeWordIndices"}) {
+        auto member = indices->FindMember(key);
+        if (member == indices->MemberEnd()) {
+            indices = nullptr;
+            break;
+        }
+        indices = &member->value;
+    }
+    if (indices) {
+        retrieveValue(*indices, "endIndexInSamples", &keywordEndSamples);
+    }
+
+    auto reader = request->getAttachmentReader();
+    if (SPEECH_RECOGNIZER_NAMESPACE != avsNamespace || RECOGNIZE_NAME != name || !reader) {
+        request->sendCompleted(MessageRequestObserverInterface::Status::SUCCESS);
+        return;
+    }
+
+    Upload upload;
+    upload.dialogRequestId = dialogRequestId;
+    upload.bytes = 0;
+    upload.keywordEndBytes = keywordEndSamples * m_bytesPerSample;
+    upload.overrun = false;
+    upload.sendTime = sendTime;
+
+    uint64_t utteranceBytes =
+        upload.keywordEndBytes + m_sampleRateHz * m_config.utteranceDuration.count() / 1000 * m_bytesPerSample;
+    bool hasStoppedCapture = false;
+    char buffer[READ_SIZE_IN_BYTES];
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (!m_isShuttingDown) {
+        upload.bytes += reader->read(buffer, sizeof(buffer), &status);
+        if (!hasStoppedCapture && upload.bytes >= utteranceBytes) {
+            hasStoppedCapture = true;
+            upload.stopCaptureTime = std::chrono::steady_clock::now();
+            sendStopCapture(dialogRequestId);
+        }
+        if (AttachmentReader::ReadStatus::OK_WOULDBLOCK == status) {
+            std::this_thread::sleep_for(m_config.pollInterval);
+        } else if (AttachmentReader::ReadStatus::OK != status && AttachmentReader::ReadStatus::OK_TIMEDOUT != status) {
+            break;
+        }
+    }
+    upload.endTime = std::chrono::steady_clock::now();
+    upload.overrun = AttachmentReader::ReadStatus::ERROR_OVERRUN == status;
+    if (upload.overrun) {
+        ACSDK_WARN(LX("handleEvent").d("event", "uploadOverrun").d("dialogRequestId", dialogRequestId));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_uploads.push_back(upload);
+    }
+    request->sendCompleted(
+        upload.overrun ? MessageRequestObserverInterface::Status::INTERNAL_ERROR
+                       : MessageRequestObserverInterface::Status::SUCCESS);
+}
+
+void LocalAVS::sendStopCapture(const std::string& dialogRequestId) {
+    auto messageId = avsCommon::utils::uuidGeneration::generateUUID();
+    auto header =
+        std::make_shared<AVSMessageHeader>(SPEECH_RECOGNIZER_NAMESPACE, STOP_CAPTURE_NAME, messageId, dialogRequestId);
+    std::string unparsedDirective = "{\"directive\":{\"header\":{\"namespace\":\"" + SPEECH_RECOGNIZER_NAMESPACE +
+                                    "\",\"name\":\"" + STOP_CAPTURE_NAME + "\",\"messageId\":\"" + messageId +
+                                    "\",\"dialogRequestId\":\"" + dialogRequestId + "\"},\"payload\":{}}}";
+    auto attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    auto directive = AVSDirective::create(unparsedDirective, header, "{}", attachmentManager, "");
+    if (!directive) {
+        ACSDK_ERROR(LX("sendStopCaptureFailed").d("reason", "createDirectiveFailed"));
+        return;
+    }
+
+    std::unordered_set<std::shared_ptr<MessageObserverInterface>> observers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        observers = m_observers;
+    }
+    for (auto& observer : observers) {
+        observer->receive("", unparsedDirective);
+    }
+    m_directiveSequencer->onDirective(std::move(directive));
+}
+
+}  // namespace soak
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
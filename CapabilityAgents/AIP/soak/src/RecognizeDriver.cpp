@@ -0,0 +1,441 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <ADSL/DirectiveSequencer.h>
+#include <AFML/FocusManager.h>
+#include <ContextManager/ContextManager.h>
+#include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
+#include <AVSCommon/SDKInterfaces/FocusManagerObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/UserActivityNotifierInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIPSoak/RecognizeDriver.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace soak {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace audioCapture;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("RecognizeDriver");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The default number of interactions to start.
+static const unsigned int DEFAULT_INTERACTIONS = 10;
+
+/// The default keyword.
+static const std::string DEFAULT_KEYWORD = "ALEXA";
+
+/// The default amount of audio the stream holds.
+static const std::chrono::milliseconds DEFAULT_BUFFER_DURATION(10000);
+
+/// The default time to wait for a play to begin or an interaction to complete.
+static const std::chrono::milliseconds DEFAULT_INTERACTION_TIMEOUT(30000);
+
+/// The default time the dialog stays in @c THINKING.
+static const std::chrono::milliseconds DEFAULT_THINKING_TIMEOUT(100);
+
+/// The default speed the file is written at.
+static const double DEFAULT_SPEED = 10.0;
+
+/// The number of readers the stream allows: the processor's and a spare for an encoder.
+static const size_t MAX_READERS = 2;
+
+/// How often to check whether the keyword has been written.
+static const std::chrono::milliseconds KEYWORD_POLL_INTERVAL(1);
+
+/// An exception sender which logs the exceptions, since there is no AVS to send them to.
+class LoggingExceptionSender : public ExceptionEncounteredSenderInterface {
+public:
+    void sendExceptionEncountered(
+        const std::string& unparsedDirective,
+        ExceptionErrorType error,
+        const std::string& errorDescription) override {
+        ACSDK_ERROR(LX("exceptionEncountered").d("description", errorDescription));
+    }
+};
+
+/// A user activity notifier which does nothing, since there is no AVS to tell.
+class NullUserActivityNotifier : public UserActivityNotifierInterface {
+public:
+    void onUserActive() override {
+    }
+};
+
+class RecognizeDriver::StateObserver
+        : public AudioInputProcessorObserverInterface
+        , public FocusManagerObserverInterface {
+public:
+    /// Constructor.
+    StateObserver() : m_state{State::IDLE}, m_idleCount{0}, m_dialogFocus{FocusState::NONE} {
+    }
+
+    void onStateChanged(State state) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = state;
+        if (State::IDLE == state) {
+            ++m_idleCount;
+        }
+        m_changed.notify_all();
+    }
+
+    void onFocusChanged(const std::string& channelName, FocusState newFocus) override {
+        if (FocusManagerInterface::DIALOG_CHANNEL_NAME != channelName) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dialogFocus = newFocus;
+        m_changed.notify_all();
+    }
+
+    /**
+     * Gets the processor's state.
+     *
+     * @return The state.
+     */
+    State getState() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_state;
+    }
+
+    /**
+     * Gets the number of times the processor has gone back to @c IDLE.
+     *
+     * @return The number of times.
+     */
+    uint64_t getIdleCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idleCount;
+    }
+
+    /**
+     * Waits for the processor to go back to @c IDLE and give up the dialog channel.  The processor releases the
+     * channel after it goes back to @c IDLE, and an interaction started before the release completes loses the
+     * channel to it.
+     *
+     * @param idleCount The number of times it had gone back to @c IDLE before.
+     * @param timeout How long to wait.
+     * @return Whether it went back to @c IDLE before the timeout.
+     */
+    bool waitForIdle(uint64_t idleCount, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, timeout, [this, idleCount] {
+            return m_idleCount > idleCount && FocusState::NONE == m_dialogFocus;
+        });
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the state or the focus changes.
+    std::condition_variable m_changed;
+
+    /// The processor's state.
+    State m_state;
+
+    /// The number of times the processor has gone back to @c IDLE.
+    uint64_t m_idleCount;
+
+    /// The focus of the dialog channel.
+    FocusState m_dialogFocus;
+};
+
+/**
+ * Gets the processor time the process has used.
+ *
+ * @return The time.
+ */
+static std::chrono::microseconds getCpuTime() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/**
+ * Gets the resident set size of the process.
+ *
+ * @return The size in kilobytes, or 0 if it is not known.
+ */
+static uint64_t getResidentKb() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t sizePages = 0;
+    uint64_t residentPages = 0;
+    if (!(statm >> sizePages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+RecognizeDriver::Config::Config() :
+        mode{Mode::TAP},
+        interactions{DEFAULT_INTERACTIONS},
+        keywordBegin{0},
+        keywordEnd{0},
+        keyword{DEFAULT_KEYWORD},
+        bufferDuration{DEFAULT_BUFFER_DURATION},
+        interactionTimeout{DEFAULT_INTERACTION_TIMEOUT},
+        thinkingTimeout{DEFAULT_THINKING_TIMEOUT} {
+    source.speed = DEFAULT_SPEED;
+}
+
+std::unique_ptr<RecognizeDriver> RecognizeDriver::create(const std::string& path, const Config& config) {
+    if (0 == config.interactions) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noInteractions"));
+        return nullptr;
+    }
+    if (Mode::WAKEWORD == config.mode &&
+        (config.keywordBegin < std::chrono::milliseconds::zero() || config.keywordEnd <= config.keywordBegin)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidKeyword")
+                        .d("begin", config.keywordBegin.count())
+                        .d("end", config.keywordEnd.count()));
+        return nullptr;
+    }
+    if (config.bufferDuration <= std::chrono::milliseconds::zero() || 0 == config.source.sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidBuffer"));
+        return nullptr;
+    }
+
+    std::unique_ptr<RecognizeDriver> driver(new RecognizeDriver(config));
+    if (!driver->init(path)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initFailed").d("path", path));
+        return nullptr;
+    }
+    return driver;
+}
+
+RecognizeDriver::~RecognizeDriver() {
+    if (m_source) {
+        m_source->stopStreamingMicrophoneData();
+    }
+    if (m_audioInputProcessor) {
+        m_dialogUXStateAggregator->removeObserver(m_audioInputProcessor);
+        m_audioInputProcessor->shutdown();
+    }
+    if (m_directiveSequencer) {
+        m_directiveSequencer->shutdown();
+    }
+}
+
+RecognizeDriver::Report RecognizeDriver::run() {
+    Report report = Report();
+    auto wallStart = std::chrono::steady_clock::now();
+    auto cpuStart = getCpuTime();
+    report.residentStartKb = getResidentKb();
+    auto sourceStart = m_source->getStatistics();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loopBegins.clear();
+    }
+    if (!m_source->startStreamingMicrophoneData()) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "startSourceFailed"));
+        return report;
+    }
+
+    while (report.attempted < m_config.interactions) {
+        AudioInputStream::Index begin;
+        uint64_t skipped;
+        if (!waitForLoopBegin(&begin, &skipped)) {
+            ACSDK_ERROR(LX("runFailed").d("reason", "noLoopBegan"));
+            break;
+        }
+        report.skipped += skipped;
+        if (AudioInputProcessorObserverInterface::State::IDLE != m_stateObserver->getState()) {
+            ++report.skipped;
+            continue;
+        }
+        interact(begin, &report);
+    }
+    m_source->stopStreamingMicrophoneData();
+
+    report.wallTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wallStart);
+    report.cpuTime = getCpuTime() - cpuStart;
+    report.residentEndKb = getResidentKb();
+    // The source's statistics add up over its lifetime, so take those from before the run away.
+    report.source = m_source->getStatistics();
+    report.source.wordsWritten -= sourceStart.wordsWritten;
+    report.source.writes -= sourceStart.writes;
+    report.source.loopsCompleted -= sourceStart.loopsCompleted;
+    report.source.dropouts -= sourceStart.dropouts;
+    report.source.wordsDropped -= sourceStart.wordsDropped;
+    report.audioDuration = std::chrono::milliseconds(
+        (report.source.wordsWritten + report.source.wordsDropped) * 1000 / m_format.sampleRateHz);
+    return report;
+}
+
+RecognizeDriver::RecognizeDriver(const Config& config) : m_config(config) {
+}
+
+bool RecognizeDriver::init(const std::string& path) {
+    auto wordSize = m_config.source.numChannels * sizeof(int16_t);
+    auto words = static_cast<size_t>(m_config.source.sampleRateHz * m_config.bufferDuration.count() / 1000);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(
+        AudioInputStream::calculateBufferSize(words, wordSize, MAX_READERS));
+    m_stream = AudioInputStream::create(buffer, wordSize, MAX_READERS);
+    if (!m_stream) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamFailed"));
+        return false;
+    }
+
+    auto sourceConfig = m_config.source;
+    sourceConfig.loops = 0;
+    m_source = FileAudioSource::create(
+        path, m_stream, sourceConfig, [this](uint64_t loop, AudioInputStream::Index begin) { onLoopBegin(begin); });
+    if (!m_source) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createSourceFailed"));
+        return false;
+    }
+    m_format = m_source->getAudioFormat();
+
+    m_directiveSequencer = adsl::DirectiveSequencer::create(std::make_shared<LoggingExceptionSender>());
+    m_avs = LocalAVS::create(m_directiveSequencer, m_format, m_config.avs);
+    auto contextManager = contextManager::ContextManager::create();
+    if (!m_directiveSequencer || !m_avs || !contextManager) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createComponentsFailed"));
+        return false;
+    }
+    auto focusManager = std::make_shared<afml::FocusManager>(afml::FocusManager::DEFAULT_AUDIO_CHANNELS);
+    m_stateObserver = std::make_shared<StateObserver>();
+    focusManager->addObserver(m_stateObserver);
+    m_dialogUXStateAggregator = std::make_shared<DialogUXStateAggregator>(m_config.thinkingTimeout);
+    m_avs->addMessageObserver(m_dialogUXStateAggregator);
+
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_directiveSequencer,
+        m_avs,
+        contextManager,
+        focusManager,
+        m_dialogUXStateAggregator,
+        std::make_shared<LoggingExceptionSender>(),
+        std::make_shared<NullUserActivityNotifier>(),
+        AudioProvider::null(),
+        nullptr,
+        nullptr,
+        m_config.wakewordUpload);
+    if (!m_audioInputProcessor || !m_directiveSequencer->addDirectiveHandler(m_audioInputProcessor)) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createAudioInputProcessorFailed"));
+        return false;
+    }
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor->addObserver(m_stateObserver);
+    m_dialogUXStateAggregator->addObserver(m_audioInputProcessor);
+    return true;
+}
+
+void RecognizeDriver::onLoopBegin(AudioInputStream::Index begin) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loopBegins.push_back(begin);
+    m_loopBegan.notify_all();
+}
+
+bool RecognizeDriver::waitForLoopBegin(AudioInputStream::Index* begin, uint64_t* skipped) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_loopBegan.wait_for(lock, m_config.interactionTimeout, [this] { return !m_loopBegins.empty(); })) {
+        return false;
+    }
+    // Plays which began while the last interaction was going on are skipped, so the interaction starts on the latest.
+    *skipped = m_loopBegins.size() - 1;
+    *begin = m_loopBegins.back();
+    m_loopBegins.clear();
+    return true;
+}
+
+void RecognizeDriver::interact(AudioInputStream::Index begin, Report* report) {
+    auto idleCount = m_stateObserver->getIdleCount();
+    auto uploadCount = m_avs->getUploads().size();
+    AudioProvider provider(m_stream, m_format, ASRProfile::NEAR_FIELD, false, true, true);
+
+    std::future<bool> result;
+    std::chrono::steady_clock::time_point start;
+    if (Mode::TAP == m_config.mode) {
+        start = std::chrono::steady_clock::now();
+        result = m_audioInputProcessor->recognize(provider, Initiator::TAP, begin);
+    } else {
+        auto keywordBegin = begin + m_config.keywordBegin.count() * m_format.sampleRateHz / 1000;
+        auto keywordEnd = begin + m_config.keywordEnd.count() * m_format.sampleRateHz / 1000;
+        // A detector reports the keyword once its end has been captured.
+        auto deadline = std::chrono::steady_clock::now() + m_config.interactionTimeout;
+        while (m_source->tell() < keywordEnd && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(KEYWORD_POLL_INTERVAL);
+        }
+        start = std::chrono::steady_clock::now();
+        result =
+            m_audioInputProcessor->recognize(provider, Initiator::WAKEWORD, keywordBegin, keywordEnd, m_config.keyword);
+    }
+    ++report->attempted;
+
+    if (!result.valid() || !result.get()) {
+        ACSDK_ERROR(LX("interactFailed").d("reason", "recognizeFailed").d("begin", begin));
+        ++report->failed;
+        return;
+    }
+    if (!m_stateObserver->waitForIdle(idleCount, m_config.interactionTimeout)) {
+        ACSDK_ERROR(LX("interactFailed").d("reason", "interactionTimedOut").d("begin", begin));
+        ++report->failed;
+        m_audioInputProcessor->resetState().wait();
+        return;
+    }
+
+    auto uploads = m_avs->getUploads();
+    if (uploads.size() == uploadCount) {
+        ACSDK_ERROR(LX("interactFailed").d("reason", "nothingUploaded").d("begin", begin));
+        ++report->failed;
+        return;
+    }
+    const auto& upload = uploads.back();
+    ++report->uploads;
+    report->bytesUploaded += upload.bytes;
+    auto sendLatency = std::chrono::duration_cast<std::chrono::microseconds>(upload.sendTime - start);
+    report->totalSendLatency += sendLatency;
+    report->maxSendLatency = std::max(report->maxSendLatency, sendLatency);
+    report->totalUploadDuration +=
+        std::chrono::duration_cast<std::chrono::microseconds>(upload.endTime - upload.sendTime);
+    report->totalStopCaptureLatency +=
+        std::chrono::duration_cast<std::chrono::microseconds>(upload.stopCaptureTime - start);
+    if (upload.overrun) {
+        ++report->overruns;
+        ++report->failed;
+    } else {
+        ++report->completed;
+    }
+}
+
+}  // namespace soak
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
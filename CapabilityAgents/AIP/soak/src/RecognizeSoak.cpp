@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file RecognizeSoak.cpp
+///
+/// Plays a recording into the audio input processor over and over, and reports how the capture and upload held up.
+/// Run with no arguments for usage.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "AIPSoak/RecognizeDriver.h"
+
+using namespace alexaClientSDK::capabilityAgents::aip::soak;
+
+/// The settings of the soak which are not settings of the driver.
+struct Options {
+    /// The number of times to run the driver.
+    unsigned int rounds = 1;
+    /// The recording to play.
+    std::string path;
+};
+
+/**
+ * Prints how to run the soak.
+ *
+ * @param program The name of the program.
+ */
+static void printUsage(const std::string& program) {
+    std::cerr << "USAGE: " << program << " [options] <file>\n"
+              << "  --mode <tap|wakeword>   how interactions are started (default tap)\n"
+              << "  --interactions <count>  interactions per round (default 10)\n"
+              << "  --rounds <count>        rounds to run, to watch for growth (default 1)\n"
+              << "  --keyword-begin <ms>    where the keyword begins in the file, for wakeword\n"
+              << "  --keyword-end <ms>      where the keyword ends in the file, for wakeword\n"
+              << "  --preroll <ms>          audio uploaded before the keyword, for wakeword (default 500)\n"
+              << "  --upload-from <where>   keyword-begin, or keyword-end to trim the keyword (default keyword-begin)\n"
+              << "  --speed <multiple>      multiple of real time to play at, or 0 for unthrottled (default 10)\n"
+              << "  --rate <hz>             sample rate of a raw file (default 16000)\n"
+              << "  --gap <ms>              silence after each play of the file (default 0)\n"
+              << "  --dropout-interval <ms> audio between dropouts, or 0 for none (default 0)\n"
+              << "  --dropout <ms>          audio each dropout loses (default 0)\n"
+              << "  --utterance <ms>        audio after the keyword uploaded before StopCapture (default 2000)\n"
+              << "  --thinking <ms>         time spent thinking after each upload (default 100)\n"
+              << "  --buffer <ms>           audio the stream holds (default 10000)\n"
+              << "The file is a 16-bit mono WAV file, or raw little-endian PCM." << std::endl;
+}
+
+/**
+ * Parses the command line.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param[out] config The settings of the driver.
+ * @param[out] options The other settings.
+ * @return Whether the command line is valid.
+ */
+static bool parseArguments(int argc, char** argv, RecognizeDriver::Config* config, Options* options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument.compare(0, 2, "--") != 0) {
+            options->path = argument;
+        } else if (i + 1 >= argc) {
+            std::cerr << "Missing value of " << argument << std::endl;
+            return false;
+        } else {
+            std::string value = argv[++i];
+            if ("--mode" == argument) {
+                if ("tap" == value) {
+                    config->mode = RecognizeDriver::Mode::TAP;
+                } else if ("wakeword" == value) {
+                    config->mode = RecognizeDriver::Mode::WAKEWORD;
+                } else {
+                    std::cerr << "Unknown mode " << value << std::endl;
+                    return false;
+                }
+            } else if ("--interactions" == argument) {
+                config->interactions = std::atoi(value.c_str());
+            } else if ("--rounds" == argument) {
+                options->rounds = std::atoi(value.c_str());
+            } else if ("--keyword-begin" == argument) {
+                config->keywordBegin = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--keyword-end" == argument) {
+                config->keywordEnd = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--preroll" == argument) {
+                config->wakewordUpload.preroll = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--upload-from" == argument) {
+                if ("keyword-begin" == value) {
+                    config->wakewordUpload.uploadFromKeywordEnd = false;
+                } else if ("keyword-end" == value) {
+                    config->wakewordUpload.uploadFromKeywordEnd = true;
+                } else {
+                    std::cerr << "Unknown upload start " << value << std::endl;
+                    return false;
+                }
+            } else if ("--speed" == argument) {
+                config->source.speed = std::atof(value.c_str());
+            } else if ("--rate" == argument) {
+                config->source.sampleRateHz = std::atoi(value.c_str());
+            } else if ("--gap" == argument) {
+                config->source.gapDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--dropout-interval" == argument) {
+                config->source.dropoutInterval = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--dropout" == argument) {
+                config->source.dropoutDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--utterance" == argument) {
+                config->avs.utteranceDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--thinking" == argument) {
+                config->thinkingTimeout = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--buffer" == argument) {
+                config->bufferDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return false;
+            }
+        }
+    }
+    return !options->path.empty() && options->rounds > 0;
+}
+
+/**
+ * Prints what a round measured.
+ *
+ * @param report What the round measured.
+ */
+static void printReport(const RecognizeDriver::Report& report) {
+    auto wallSeconds = report.wallTime.count() / 1000000.0;
+    std::cout << "  Interactions: " << report.attempted << " (" << report.completed << " completed, " << report.failed
+              << " failed), " << report.skipped << " plays skipped\n"
+              << "  Uploads: " << report.uploads << ", " << report.bytesUploaded << " bytes, " << report.overruns
+              << " overrun\n";
+    if (report.uploads > 0) {
+        std::cout << "  Recognize to event sent: mean " << report.totalSendLatency.count() / report.uploads / 1000.0
+                  << " ms, max " << report.maxSendLatency.count() / 1000.0 << " ms\n"
+                  << "  Recognize to StopCapture: mean "
+                  << report.totalStopCaptureLatency.count() / report.uploads / 1000.0 << " ms\n"
+                  << "  Event sent to audio closed: mean "
+                  << report.totalUploadDuration.count() / report.uploads / 1000.0 << " ms\n"
+                  << "  Bytes per upload: mean " << report.bytesUploaded / report.uploads << "\n";
+    }
+    std::cout << "  Source: " << report.source.loopsCompleted << " plays, " << report.source.writes << " writes, "
+              << report.source.dropouts << " dropouts\n"
+              << "  Audio: " << report.audioDuration.count() / 1000.0 << " s, played in " << wallSeconds << " s\n"
+              << "  CPU: " << report.cpuTime.count() / 1000000.0 << " s";
+    if (report.wallTime.count() > 0) {
+        std::cout << " (" << 100.0 * report.cpuTime.count() / report.wallTime.count() << "% of a core)";
+    }
+    std::cout << "\n  Resident: " << report.residentStartKb << " kB before, " << report.residentEndKb << " kB after"
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    RecognizeDriver::Config config;
+    Options options;
+    if (!parseArguments(argc, argv, &config, &options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    auto driver = RecognizeDriver::create(options.path, config);
+    if (!driver) {
+        std::cerr << "Unable to play " << options.path << " with these settings" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int result = EXIT_SUCCESS;
+    for (unsigned int round = 1; round <= options.rounds; ++round) {
+        std::cout << "Round " << round << ":" << std::endl;
+        auto report = driver->run();
+        printReport(report);
+        if (report.failed > 0 || report.overruns > 0) {
+            result = EXIT_FAILURE;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file RecognizeDriverTest.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AIPSoak/RecognizeDriver.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace soak {
+namespace test {
+
+/// The path of the file the tests play.
+static const std::string PATH = "RecognizeDriverTest.pcm";
+
+/// The number of frames in the file: 1 s at 16 kHz.
+static const size_t FILE_FRAMES = 16000;
+
+/// The number of bytes in a second of the file.
+static const uint64_t BYTES_PER_SECOND = 32000;
+
+/// The audio after the keyword uploaded before StopCapture.
+static const std::chrono::milliseconds UTTERANCE_DURATION(400);
+
+/// Where the keyword begins in the file.
+static const std::chrono::milliseconds KEYWORD_BEGIN(200);
+
+/// Where the keyword ends in the file.
+static const std::chrono::milliseconds KEYWORD_END(500);
+
+/// The number of interactions the tests start.
+static const unsigned int INTERACTIONS = 3;
+
+/// Test harness for @c RecognizeDriver.
+class RecognizeDriverTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// The settings of the driver.
+    RecognizeDriver::Config m_config;
+};
+
+void RecognizeDriverTest::SetUp() {
+    std::ofstream file(PATH, std::ios::binary);
+    for (size_t i = 0; i < FILE_FRAMES; ++i) {
+        uint16_t sample = static_cast<uint16_t>(i % 256);
+        file.put(static_cast<char>(sample & 0xff));
+        file.put(static_cast<char>((sample >> 8) & 0xff));
+    }
+    file.close();
+
+    m_config.interactions = INTERACTIONS;
+    m_config.thinkingTimeout = std::chrono::milliseconds(20);
+    m_config.interactionTimeout = std::chrono::milliseconds(5000);
+    m_config.avs.utteranceDuration = UTTERANCE_DURATION;
+    m_config.source.speed = 10.0;
+}
+
+void RecognizeDriverTest::TearDown() {
+    std::remove(PATH.c_str());
+}
+
+/**
+ * Checks that every interaction of a run uploaded at least the utterance, without overruns.
+ *
+ * @param report What happened during the run.
+ */
+static void expectCompleted(const RecognizeDriver::Report& report) {
+    EXPECT_EQ(INTERACTIONS, report.attempted);
+    EXPECT_EQ(INTERACTIONS, report.completed);
+    EXPECT_EQ(0u, report.failed);
+    EXPECT_EQ(INTERACTIONS, report.uploads);
+    EXPECT_EQ(0u, report.overruns);
+    EXPECT_GE(report.bytesUploaded, INTERACTIONS * BYTES_PER_SECOND * UTTERANCE_DURATION.count() / 1000);
+    EXPECT_GE(report.maxSendLatency.count(), 0);
+    EXPECT_GE(report.source.loopsCompleted, INTERACTIONS - 1);
+    EXPECT_GT(report.audioDuration, std::chrono::milliseconds::zero());
+}
+
+/// Test that create() rejects missing files and invalid settings.
+TEST_F(RecognizeDriverTest, createWithInvalidArguments) {
+    EXPECT_FALSE(RecognizeDriver::create("missing.pcm", m_config));
+    auto config = m_config;
+    config.interactions = 0;
+    EXPECT_FALSE(RecognizeDriver::create(PATH, config));
+    config = m_config;
+    config.mode = RecognizeDriver::Mode::WAKEWORD;
+    config.keywordBegin = std::chrono::milliseconds(500);
+    config.keywordEnd = std::chrono::milliseconds(200);
+    EXPECT_FALSE(RecognizeDriver::create(PATH, config));
+}
+
+/// Test that tap interactions upload each play until StopCapture and return to idle.
+TEST_F(RecognizeDriverTest, tapInteractions) {
+    auto driver = RecognizeDriver::create(PATH, m_config);
+    ASSERT_TRUE(driver);
+    expectCompleted(driver->run());
+}
+
+/// Test that wake word interactions upload from the keyword, and that a driver can run again.
+TEST_F(RecognizeDriverTest, wakewordInteractions) {
+    m_config.mode = RecognizeDriver::Mode::WAKEWORD;
+    m_config.keywordBegin = KEYWORD_BEGIN;
+    m_config.keywordEnd = KEYWORD_END;
+    auto driver = RecognizeDriver::create(PATH, m_config);
+    ASSERT_TRUE(driver);
+    for (int run = 0; run < 2; ++run) {
+        auto report = driver->run();
+        expectCompleted(report);
+        auto keywordBytes = BYTES_PER_SECOND * (KEYWORD_END - KEYWORD_BEGIN).count() / 1000;
+        EXPECT_GE(report.bytesUploaded, INTERACTIONS * keywordBytes);
+    }
+}
+
+/// Test that wake word interactions which upload from the keyword end send less than those which upload the keyword.
+TEST_F(RecognizeDriverTest, wakewordInteractionsFromKeywordEnd) {
+    m_config.mode = RecognizeDriver::Mode::WAKEWORD;
+    m_config.keywordBegin = KEYWORD_BEGIN;
+    m_config.keywordEnd = KEYWORD_END;
+    auto driver = RecognizeDriver::create(PATH, m_config);
+    ASSERT_TRUE(driver);
+    auto withKeyword = driver->run();
+    expectCompleted(withKeyword);
+
+    m_config.wakewordUpload.uploadFromKeywordEnd = true;
+    driver = RecognizeDriver::create(PATH, m_config);
+    ASSERT_TRUE(driver);
+    auto fromKeywordEnd = driver->run();
+    expectCompleted(fromKeywordEnd);
+    EXPECT_LT(fromKeywordEnd.bytesUploaded, withKeyword.bytesUploaded);
+}
+
+}  // namespace test
+}  // namespace soak
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/AudioEncoder.h"
+#include "AIP/AudioInputProcessor.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioEncoder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// How much encoded audio an encoded stream holds before the oldest frames are overwritten.
+static const std::chrono::seconds ENCODED_STREAM_DURATION(10);
+
+/// The number of readers of an encoded stream, which is only read by @c AudioInputProcessor.
+static const size_t ENCODED_STREAM_MAX_READERS = 1;
+
+/// How long the encoding thread waits for samples before checking whether it was stopped.
+static const std::chrono::milliseconds READ_TIMEOUT(20);
+
+/**
+ * Checks whether two formats are the same.
+ *
+ * @param lhs A format.
+ * @param rhs Another format.
+ * @return Whether the formats are the same.
+ */
+static bool isSameFormat(const AudioFormat& lhs, const AudioFormat& rhs) {
+    return lhs.encoding == rhs.encoding && lhs.endianness == rhs.endianness && lhs.sampleRateHz == rhs.sampleRateHz &&
+           lhs.sampleSizeInBits == rhs.sampleSizeInBits && lhs.numChannels == rhs.numChannels;
+}
+
+std::shared_ptr<AudioEncoder> AudioEncoder::create(std::shared_ptr<AudioEncoderInterface> encoder) {
+    if (!encoder) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullEncoder"));
+        return nullptr;
+    }
+    auto inputFormat = encoder->getInputFormat();
+    if (AudioFormat::Encoding::LPCM != inputFormat.encoding || 16 != inputFormat.sampleSizeInBits ||
+        1 != inputFormat.numChannels || 0 == inputFormat.sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedInputFormat").d("encoding", inputFormat.encoding));
+        return nullptr;
+    }
+    if (0 == encoder->getInputFrameSizeInSamples() || 0 == encoder->getOutputFrameSizeInBytes()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize"));
+        return nullptr;
+    }
+    return std::shared_ptr<AudioEncoder>(new AudioEncoder(encoder));
+}
+
+AudioEncoder::~AudioEncoder() {
+    stopEncoding(true);
+}
+
+bool AudioEncoder::canEncode(const AudioFormat& format) const {
+    return isSameFormat(m_inputFormat, format);
+}
+
+AudioFormat AudioEncoder::getOutputFormat() const {
+    return m_outputFormat;
+}
+
+std::shared_ptr<AudioInputStream> AudioEncoder::startEncoding(
+    std::shared_ptr<AudioInputStream> input,
+    AudioInputStream::Index begin) {
+    if (!input) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "nullInput"));
+        return nullptr;
+    }
+    if (sizeof(int16_t) != input->getWordSize()) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "unsupportedWordSize").d("wordSize", input->getWordSize()));
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> controlLock(m_controlMutex);
+    stopEncodingLocked(true);
+
+    bool startWithNewData = AudioInputProcessor::INVALID_INDEX == begin;
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        input->createReader(AudioInputStream::Reader::Policy::BLOCKING, startWithNewData);
+    if (!reader) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "createReaderFailed"));
+        return nullptr;
+    }
+    if (!startWithNewData && !reader->seek(begin)) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "seekFailed").d("begin", begin));
+        return nullptr;
+    }
+    if (!m_encoder->start()) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "startEncoderFailed"));
+        return nullptr;
+    }
+
+    auto frameSize = m_encoder->getOutputFrameSizeInBytes();
+    auto numFrames = ENCODED_STREAM_DURATION.count() * m_inputFormat.sampleRateHz /
+                     m_encoder->getInputFrameSizeInSamples();
+    auto bufferSize = AudioInputStream::calculateBufferSize(numFrames, frameSize, ENCODED_STREAM_MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    std::shared_ptr<AudioInputStream> output = AudioInputStream::create(buffer, frameSize, ENCODED_STREAM_MAX_READERS);
+    if (!output) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "createStreamFailed"));
+        return nullptr;
+    }
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        output->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reader = reader;
+        m_stopImmediately = false;
+    }
+    m_thread = std::thread(&AudioEncoder::encodingLoop, this, reader, writer);
+    return output;
+}
+
+void AudioEncoder::stopEncoding(bool stopImmediately) {
+    std::lock_guard<std::mutex> controlLock(m_controlMutex);
+    stopEncodingLocked(stopImmediately);
+}
+
+AudioEncoder::Statistics AudioEncoder::getStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+AudioEncoder::AudioEncoder(std::shared_ptr<AudioEncoderInterface> encoder) :
+        m_encoder{encoder},
+        m_inputFormat(encoder->getInputFormat()),
+        m_outputFormat(encoder->getOutputFormat()),
+        m_frame(encoder->getOutputFrameSizeInBytes()),
+        m_stopImmediately{false},
+        m_statistics{0, 0} {
+}
+
+void AudioEncoder::stopEncodingLocked(bool stopImmediately) {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopImmediately = stopImmediately;
+        if (stopImmediately) {
+            m_reader->close();
+        } else {
+            // The encoding thread reads up to what has been written so far, then sees the reader closed.
+            m_reader->close(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+        }
+    }
+    m_thread.join();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reader.reset();
+}
+
+void AudioEncoder::encodingLoop(
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    std::shared_ptr<AudioInputStream::Writer> writer) {
+    auto frameSize = m_encoder->getInputFrameSizeInSamples();
+    std::vector<int16_t> samples(frameSize);
+    size_t numSamples = 0;
+    bool encodeRest = true;
+
+    while (true) {
+        auto result = reader->read(samples.data() + numSamples, frameSize - numSamples, READ_TIMEOUT);
+        if (result > 0) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_statistics.bytesRead += result * sizeof(int16_t);
+            }
+            numSamples += result;
+            if (frameSize == numSamples) {
+                if (!writeFrame(samples.data(), writer)) {
+                    encodeRest = false;
+                    break;
+                }
+                numSamples = 0;
+            }
+        } else if (AudioInputStream::Reader::Error::TIMEDOUT == result) {
+            continue;
+        } else if (AudioInputStream::Reader::Error::CLOSED == result) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            encodeRest = !m_stopImmediately;
+            break;
+        } else {
+            ACSDK_ERROR(LX("encodingLoopFailed").d("reason", "readFailed").d("error", result));
+            encodeRest = false;
+            break;
+        }
+    }
+
+    if (encodeRest && numSamples > 0) {
+        std::fill(samples.begin() + numSamples, samples.end(), 0);
+        writeFrame(samples.data(), writer);
+    }
+    writer->close();
+}
+
+bool AudioEncoder::writeFrame(const int16_t* samples, std::shared_ptr<AudioInputStream::Writer> writer) {
+    if (!m_encoder->encode(samples, m_frame.data())) {
+        ACSDK_ERROR(LX("writeFrameFailed").d("reason", "encodeFailed"));
+        return false;
+    }
+    auto result = writer->write(m_frame.data(), 1);
+    if (result <= 0) {
+        ACSDK_ERROR(LX("writeFrameFailed").d("reason", "writeFailed").d("error", result));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.bytesWritten += m_frame.size();
+    return true;
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -21,6 +21,7 @@
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 #include <AVSCommon/Utils/Metrics.h>
+#include <AVSCommon/Utils/Timing/LatencyTrace.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
 
 #include "AIP/AudioInputProcessor.h"
@@ -59,6 +60,14 @@ static const avsCommon::avs::NamespaceAndName RECOGNIZER_STATE{NAMESPACE, "Recog
 /// The field identifying the initiator.
 static const std::string INITIATOR_KEY = "initiator";
 
+/// The default audio uploaded before a wake word, which is enough for the cloud to verify it.
+static const std::chrono::milliseconds DEFAULT_WAKEWORD_PREROLL(500);
+
+AudioInputProcessor::WakewordUploadConfig::WakewordUploadConfig() :
+        preroll{DEFAULT_WAKEWORD_PREROLL},
+        uploadFromKeywordEnd{false} {
+}
+
 std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
@@ -67,7 +76,10 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) {
+    AudioProvider defaultAudioProvider,
+    std::shared_ptr<AudioEncoder> audioEncoder,
+    std::shared_ptr<EndOfSpeechDetector> endOfSpeechDetector,
+    const WakewordUploadConfig& wakewordUploadConfig) {
     if (!directiveSequencer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullDirectiveSequencer"));
         return nullptr;
@@ -89,6 +101,9 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     } else if (!userActivityNotifier) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullUserActivityNotifier"));
         return nullptr;
+    } else if (wakewordUploadConfig.preroll < std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "negativePreroll"));
+        return nullptr;
     }
 
     auto aip = std::shared_ptr<AudioInputProcessor>(new AudioInputProcessor(
@@ -98,7 +113,10 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
         focusManager,
         exceptionEncounteredSender,
         userActivityNotifier,
-        defaultAudioProvider));
+        defaultAudioProvider,
+        audioEncoder,
+        endOfSpeechDetector,
+        wakewordUploadConfig));
 
     if (aip) {
         contextManager->setStateProvider(RECOGNIZER_STATE, aip);
@@ -143,6 +161,7 @@ std::future<bool> AudioInputProcessor::recognize(
     // If no begin index was provided, grab the current index ASAP so that we can start streaming from the time this
     // call was made.
     if (audioProvider.stream && INVALID_INDEX == begin) {
+        auto requestTime = avsCommon::utils::sds::TimeIndex::Clock::now();
         static const bool startWithNewData = true;
         auto reader = audioProvider.stream->createReader(
             avsCommon::avs::AudioInputStream::Reader::Policy::NONBLOCKING, startWithNewData);
@@ -153,6 +172,15 @@ std::future<bool> AudioInputProcessor::recognize(
             return ret.get_future();
         }
         begin = reader->tell();
+
+        // If the stream keeps a time index, it gives the index of the audio captured when this call was made, which
+        // is before the writer's cursor if the writer has since written more.  An index past the cursor is a guess at
+        // audio not yet written, which would skip audio if the writer resumes after a gap, so the cursor is used.
+        auto timeIndex = audioProvider.stream->getTimeIndex();
+        avsCommon::avs::AudioInputStream::Index requestIndex = INVALID_INDEX;
+        if (timeIndex && timeIndex->getIndex(requestTime, &requestIndex) && requestIndex < begin) {
+            begin = requestIndex;
+        }
     }
 
     if (!espData.isEmpty()) {
@@ -245,7 +273,10 @@ AudioInputProcessor::AudioInputProcessor(
     std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) :
+    AudioProvider defaultAudioProvider,
+    std::shared_ptr<AudioEncoder> audioEncoder,
+    std::shared_ptr<EndOfSpeechDetector> endOfSpeechDetector,
+    const WakewordUploadConfig& wakewordUploadConfig) :
         CapabilityAgent{NAMESPACE, exceptionEncounteredSender},
         RequiresShutdown{"AudioInputProcessor"},
         m_directiveSequencer{directiveSequencer},
@@ -254,10 +285,14 @@ AudioInputProcessor::AudioInputProcessor(
         m_focusManager{focusManager},
         m_userActivityNotifier{userActivityNotifier},
         m_defaultAudioProvider{defaultAudioProvider},
+        m_audioEncoder{audioEncoder},
+        m_endOfSpeechDetector{endOfSpeechDetector},
+        m_wakewordUploadConfig(wakewordUploadConfig),
         m_lastAudioProvider{AudioProvider::null()},
         m_state{ObserverInterface::State::IDLE},
         m_focusState{avsCommon::avs::FocusState::NONE},
         m_preparingToSend{false},
+        m_stoppedCaptureLocally{false},
         m_initialDialogUXStateReceived{false},
         m_precedingExpectSpeechInitiator{nullptr} {
 }
@@ -343,13 +378,14 @@ bool AudioInputProcessor::executeRecognize(
         return false;
     }
 
-    // 500ms preroll.
-    avsCommon::avs::AudioInputStream::Index preroll = provider.format.sampleRateHz / 2;
+    // The audio before the keyword which is uploaded for the cloud to verify it.
+    avsCommon::avs::AudioInputStream::Index preroll =
+        provider.format.sampleRateHz * m_wakewordUploadConfig.preroll.count() / 1000;
+    bool hasKeywordIndices = Initiator::WAKEWORD == initiator && begin != INVALID_INDEX && end != INVALID_INDEX;
 
     // Check if we have everything we need to enable false wakeword detection.
-    // TODO: Consider relaxing the hard requirement for a full 500ms preroll - ACSDK-276.
-    bool falseWakewordDetection =
-        Initiator::WAKEWORD == initiator && begin != INVALID_INDEX && begin >= preroll && end != INVALID_INDEX;
+    // TODO: Consider relaxing the hard requirement for a full preroll - ACSDK-276.
+    bool falseWakewordDetection = hasKeywordIndices && !m_wakewordUploadConfig.uploadFromKeywordEnd && begin >= preroll;
 
     // If we will be enabling false wakeword detection, add preroll and build the initiator payload.
     std::ostringstream initiatorPayloadJson;
@@ -363,6 +399,9 @@ bool AudioInputProcessor::executeRecognize(
                 << R"(})";
         // clang-format on
         begin -= preroll;
+    } else if (hasKeywordIndices && m_wakewordUploadConfig.uploadFromKeywordEnd) {
+        // The keyword is not in the upload, so there are no indices for the cloud to verify it at.
+        begin = end;
     }
 
     // Build the initiator json.
@@ -377,45 +416,51 @@ bool AudioInputProcessor::executeRecognize(
                R"(})";
     // clang-format on
 
-    return executeRecognize(provider, initiatorJson.str(), begin, keyword);
+    return executeRecognize(
+        provider, initiatorJson.str(), begin, keyword, Initiator::WAKEWORD == initiator ? end : INVALID_INDEX);
 }
 
 bool AudioInputProcessor::executeRecognize(
     AudioProvider provider,
     const std::string& initiatorJson,
     avsCommon::avs::AudioInputStream::Index begin,
-    const std::string& keyword) {
+    const std::string& keyword,
+    avsCommon::avs::AudioInputStream::Index keywordEnd) {
     if (!provider.stream) {
         ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "nullAudioInputStream"));
         return false;
     }
 
+    // Audio which the encoder accepts is uploaded in the format of the encoder.
+    bool encode = m_audioEncoder && m_audioEncoder->canEncode(provider.format);
+    auto format = encode ? m_audioEncoder->getOutputFormat() : provider.format;
+
     std::unordered_map<int, std::string> mapSampleRatesAVSEncoding = {{32000, "OPUS"}};
     std::string avsEncodingFormat;
     std::unordered_map<int, std::string>::iterator itSampleRateAVSEncoding;
 
-    switch (provider.format.encoding) {
+    switch (format.encoding) {
         case avsCommon::utils::AudioFormat::Encoding::LPCM:
-            if (provider.format.sampleRateHz != 16000) {
+            if (format.sampleRateHz != 16000) {
                 ACSDK_ERROR(LX("executeRecognizeFailed")
                                 .d("reason", "unsupportedSampleRateForPCM")
-                                .d("sampleRate", provider.format.sampleRateHz));
+                                .d("sampleRate", format.sampleRateHz));
                 return false;
-            } else if (provider.format.sampleSizeInBits != 16) {
+            } else if (format.sampleSizeInBits != 16) {
                 ACSDK_ERROR(LX("executeRecognizeFailed")
                                 .d("reason", "unsupportedSampleSize")
-                                .d("sampleSize", provider.format.sampleSizeInBits));
+                                .d("sampleSize", format.sampleSizeInBits));
                 return false;
             }
 
             avsEncodingFormat = "AUDIO_L16_RATE_16000_CHANNELS_1";
             break;
         case avsCommon::utils::AudioFormat::Encoding::OPUS:
-            itSampleRateAVSEncoding = mapSampleRatesAVSEncoding.find(provider.format.sampleRateHz);
+            itSampleRateAVSEncoding = mapSampleRatesAVSEncoding.find(format.sampleRateHz);
             if (itSampleRateAVSEncoding == mapSampleRatesAVSEncoding.end()) {
                 ACSDK_ERROR(LX("executeRecognizeFailed")
                                 .d("reason", "unsupportedSampleRateForOPUS")
-                                .d("sampleRate", provider.format.sampleRateHz));
+                                .d("sampleRate", format.sampleRateHz));
                 return false;
             }
 
@@ -424,19 +469,19 @@ bool AudioInputProcessor::executeRecognize(
         default:
             ACSDK_ERROR(LX("executeRecognizeFailed")
                             .d("reason", "unsupportedEncoding")
-                            .d("encoding", provider.format.encoding));
+                            .d("encoding", format.encoding));
             return false;
     }
 
-    if (provider.format.endianness != avsCommon::utils::AudioFormat::Endianness::LITTLE) {
+    if (format.endianness != avsCommon::utils::AudioFormat::Endianness::LITTLE) {
         ACSDK_ERROR(LX("executeRecognizeFailed")
                         .d("reason", "unsupportedEndianness")
-                        .d("endianness", provider.format.endianness));
+                        .d("endianness", format.endianness));
         return false;
-    } else if (provider.format.numChannels != 1) {
+    } else if (format.numChannels != 1) {
         ACSDK_ERROR(LX("executeRecognizeFailed")
                         .d("reason", "unsupportedNumChannels")
-                        .d("channels", provider.format.numChannels));
+                        .d("channels", format.numChannels));
         return false;
     }
 
@@ -489,17 +534,29 @@ bool AudioInputProcessor::executeRecognize(
     // clang-format on
 
     // Set up an attachment reader for the event.
+    auto stream = provider.stream;
     avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeIndex offset = 0;
     avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference reference =
         avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::BEFORE_WRITER;
-    if (INVALID_INDEX != begin) {
+    if (encode) {
+        // The encoded stream starts with the frame holding the sample at begin.
+        stream = m_audioEncoder->startEncoding(provider.stream, begin);
+        if (!stream) {
+            ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to start encoding"));
+            return false;
+        }
+        reference = avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE;
+    } else if (INVALID_INDEX != begin) {
         offset = begin;
         reference = avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE;
     }
     m_reader = avsCommon::avs::attachment::InProcessAttachmentReader::create(
-        sds::ReaderPolicy::NONBLOCKING, provider.stream, offset, reference);
+        sds::ReaderPolicy::NONBLOCKING, stream, offset, reference);
     if (!m_reader) {
         ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to create attachment reader"));
+        if (encode) {
+            m_audioEncoder->stopEncoding(true);
+        }
         return false;
     }
 
@@ -510,6 +567,22 @@ bool AudioInputProcessor::executeRecognize(
     // Note that we're preparing to send a Recognize event.
     m_preparingToSend = true;
 
+    // Look for the end of speech after the wakeword, so that the upload can end without waiting for StopCapture.
+    m_stoppedCaptureLocally = false;
+    if (m_endOfSpeechDetector &&
+        (ASRProfile::NEAR_FIELD == provider.profile || ASRProfile::FAR_FIELD == provider.profile) &&
+        m_endOfSpeechDetector->canDetect(provider.format)) {
+        std::weak_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> reader = m_reader;
+        auto detectFrom = INVALID_INDEX != keywordEnd ? keywordEnd : begin;
+        auto callback = [this, reader](
+                            EndOfSpeechDetector::Reason reason, avsCommon::avs::AudioInputStream::Index index) {
+            m_executor.submit([this, reader, reason, index]() { executeOnEndOfSpeechDetected(reader, reason, index); });
+        };
+        if (!m_endOfSpeechDetector->start(provider.stream, detectFrom, callback)) {
+            ACSDK_WARN(LX("executeRecognize").d("reason", "endOfSpeechDetectionFailedToStart"));
+        }
+    }
+
     // Stop the ExpectSpeech timer so we don't get a timeout.
     m_expectingSpeechTimer.stop();
 
@@ -569,6 +642,7 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
     // Assemble the MessageRequest.  It will be sent by executeOnFocusChanged when we acquire the channel.
     auto dialogRequestId = avsCommon::utils::uuidGeneration::generateUUID();
     m_directiveSequencer->setDialogRequestId(dialogRequestId);
+    m_dialogRequestId = dialogRequestId;
     if (!m_espPayload.empty()) {
         auto msgIdAndESPJsonEvent =
             buildJsonEventString("ReportEchoSpatialPerceptionData", dialogRequestId, m_espPayload);
@@ -620,6 +694,15 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
         ACSDK_DEBUG(LX("stopCaptureIgnored").d("reason", "isCancelled"));
         return true;
     }
+    if (m_state != ObserverInterface::State::RECOGNIZING && m_stoppedCaptureLocally && info) {
+        // The capture already ended when the end of speech was detected locally.
+        ACSDK_DEBUG(LX("stopCaptureIgnored").d("reason", "stoppedCaptureLocally"));
+        if (info->result) {
+            info->result->setCompleted();
+        }
+        removeDirective(info);
+        return true;
+    }
     if (m_state != ObserverInterface::State::RECOGNIZING) {
         static const char* errorMessage = "StopCapture only allowed in RECOGNIZING state.";
         if (info) {
@@ -634,9 +717,21 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
                         .d("state", m_state));
         return false;
     }
+    // The end of speech is traced from now, even if the Recognize event has not been sent yet.
+    auto endOfSpeechTime = timing::LatencyTrace::Clock::now();
+
     // Create a lambda to do the StopCapture.
     std::function<void()> stopCapture = [=] {
         ACSDK_DEBUG(LX("stopCapture").d("stopImmediately", stopImmediately));
+        timing::LatencyTrace::getInstance().record(
+            timing::LatencyTrace::Point::END_OF_SPEECH, m_dialogRequestId, endOfSpeechTime);
+        if (m_endOfSpeechDetector) {
+            m_endOfSpeechDetector->stop();
+        }
+        if (m_audioEncoder) {
+            // Encode the audio captured so far, so that draining the reader below uploads all of it.
+            m_audioEncoder->stopEncoding(stopImmediately);
+        }
         if (stopImmediately) {
             m_reader->close(avsCommon::avs::attachment::AttachmentReader::ClosePoint::IMMEDIATELY);
         } else {
@@ -666,18 +761,39 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
     return true;
 }
 
+void AudioInputProcessor::executeOnEndOfSpeechDetected(
+    std::weak_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> reader,
+    EndOfSpeechDetector::Reason reason,
+    avsCommon::avs::AudioInputStream::Index index) {
+    if (m_state != ObserverInterface::State::RECOGNIZING || !m_reader || reader.lock() != m_reader) {
+        ACSDK_DEBUG(LX("endOfSpeechIgnored").d("reason", "recognizeEnded"));
+        return;
+    }
+    ACSDK_DEBUG(LX("executeOnEndOfSpeechDetected").d("reason", reason).d("index", index));
+    m_stoppedCaptureLocally = true;
+    executeStopCapture();
+}
+
 void AudioInputProcessor::executeResetState() {
     // Irrespective of current state, clean up and go back to idle.
     m_expectingSpeechTimer.stop();
     m_precedingExpectSpeechInitiator.reset();
+    if (m_endOfSpeechDetector) {
+        m_endOfSpeechDetector->stop();
+    }
+    if (m_audioEncoder) {
+        m_audioEncoder->stopEncoding(true);
+    }
     if (m_reader) {
         m_reader->close();
     }
     m_reader.reset();
     m_recognizeRequest.reset();
     m_espRequest.reset();
+    m_dialogRequestId.clear();
     m_preparingToSend = false;
     m_deferredStopCapture = nullptr;
+    m_stoppedCaptureLocally = false;
     if (m_focusState != avsCommon::avs::FocusState::NONE) {
         m_focusManager->releaseChannel(CHANNEL_NAME, shared_from_this());
     }
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/AudioInputProcessor.h"
+#include "AIP/EndOfSpeechDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EndOfSpeechDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The sample rate of the audio the detector classifies.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// How long the detection thread waits for samples before checking whether it was stopped.
+static const std::chrono::milliseconds READ_TIMEOUT(20);
+
+/**
+ * Converts a duration into a number of frames, rounding up.
+ *
+ * @param duration The duration.
+ * @param frameSize The number of samples in a frame.
+ * @return The number of frames.
+ */
+static size_t toFrames(std::chrono::milliseconds duration, size_t frameSize) {
+    auto numSamples = static_cast<size_t>(duration.count()) * SAMPLE_RATE_HZ / 1000;
+    return (numSamples + frameSize - 1) / frameSize;
+}
+
+EndOfSpeechDetector::Config::Config() : minimumSpeechDuration{100}, hangover{600}, noSpeechTimeout{8000} {
+}
+
+std::shared_ptr<EndOfSpeechDetector> EndOfSpeechDetector::create(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    const Config& config) {
+    if (!voiceActivityDetector) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullVoiceActivityDetector"));
+        return nullptr;
+    }
+    if (0 == voiceActivityDetector->getFrameSizeInSamples()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize"));
+        return nullptr;
+    }
+    if (config.minimumSpeechDuration.count() < 0 || config.noSpeechTimeout.count() < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "negativeDuration"));
+        return nullptr;
+    }
+    if (config.hangover.count() <= 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidHangover").d("ms", config.hangover.count()));
+        return nullptr;
+    }
+    return std::shared_ptr<EndOfSpeechDetector>(new EndOfSpeechDetector(voiceActivityDetector, config));
+}
+
+EndOfSpeechDetector::~EndOfSpeechDetector() {
+    stop();
+}
+
+bool EndOfSpeechDetector::canDetect(const AudioFormat& format) const {
+    return AudioFormat::Encoding::LPCM == format.encoding && AudioFormat::Endianness::LITTLE == format.endianness &&
+           SAMPLE_RATE_HZ == format.sampleRateHz && 16 == format.sampleSizeInBits && 1 == format.numChannels;
+}
+
+bool EndOfSpeechDetector::start(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioInputStream::Index begin,
+    Callback callback) {
+    if (!stream) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "nullStream"));
+        return false;
+    }
+    if (!callback) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "nullCallback"));
+        return false;
+    }
+    if (sizeof(int16_t) != stream->getWordSize()) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "unsupportedWordSize").d("wordSize", stream->getWordSize()));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> controlLock(m_controlMutex);
+    stopLocked();
+
+    bool startWithNewData = AudioInputProcessor::INVALID_INDEX == begin;
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::BLOCKING, startWithNewData);
+    if (!reader) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "createReaderFailed"));
+        return false;
+    }
+    if (!startWithNewData && !reader->seek(begin)) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "seekFailed").d("begin", begin));
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reader = reader;
+    }
+    m_thread = std::thread(&EndOfSpeechDetector::detectionLoop, this, reader, callback);
+    return true;
+}
+
+void EndOfSpeechDetector::stop() {
+    std::lock_guard<std::mutex> controlLock(m_controlMutex);
+    stopLocked();
+}
+
+EndOfSpeechDetector::EndOfSpeechDetector(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    const Config& config) :
+        m_voiceActivityDetector{voiceActivityDetector},
+        m_frameSize{voiceActivityDetector->getFrameSizeInSamples()},
+        m_minimumSpeechFrames{std::max<size_t>(1, toFrames(config.minimumSpeechDuration, m_frameSize))},
+        m_hangoverFrames{toFrames(config.hangover, m_frameSize)},
+        m_noSpeechTimeoutFrames{toFrames(config.noSpeechTimeout, m_frameSize)} {
+}
+
+void EndOfSpeechDetector::stopLocked() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reader->close();
+    }
+    m_thread.join();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reader.reset();
+}
+
+void EndOfSpeechDetector::detectionLoop(std::shared_ptr<AudioInputStream::Reader> reader, Callback callback) {
+    m_voiceActivityDetector->reset();
+    std::vector<int16_t> frame(m_frameSize);
+    size_t numSamples = 0;
+    size_t numFrames = 0;
+    size_t voicedFrames = 0;
+    size_t silentFrames = 0;
+    bool speechBegan = false;
+
+    while (true) {
+        auto result = reader->read(frame.data() + numSamples, m_frameSize - numSamples, READ_TIMEOUT);
+        if (result > 0) {
+            numSamples += result;
+            if (numSamples < m_frameSize) {
+                continue;
+            }
+            numSamples = 0;
+            ++numFrames;
+            if (m_voiceActivityDetector->isVoiced(frame.data())) {
+                silentFrames = 0;
+                if (!speechBegan && ++voicedFrames >= m_minimumSpeechFrames) {
+                    speechBegan = true;
+                }
+            } else {
+                voicedFrames = 0;
+                if (speechBegan && ++silentFrames >= m_hangoverFrames) {
+                    ACSDK_DEBUG(LX("endOfSpeech").d("index", reader->tell()));
+                    callback(Reason::END_OF_SPEECH, reader->tell());
+                    return;
+                }
+            }
+            if (!speechBegan && m_noSpeechTimeoutFrames > 0 && numFrames >= m_noSpeechTimeoutFrames) {
+                ACSDK_DEBUG(LX("noSpeechTimeout").d("index", reader->tell()));
+                callback(Reason::NO_SPEECH_TIMEOUT, reader->tell());
+                return;
+            }
+        } else if (AudioInputStream::Reader::Error::TIMEDOUT == result) {
+            continue;
+        } else if (AudioInputStream::Reader::Error::CLOSED == result) {
+            return;
+        } else {
+            ACSDK_ERROR(LX("detectionLoopFailed").d("reason", "readFailed").d("error", result));
+            return;
+        }
+    }
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/EnergyVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+namespace kernels = avsCommon::utils::audio::kernels;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EnergyVoiceActivityDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The sample rate of the audio the detector classifies.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The longest frame accepted, beyond which a frame would blur the start and end of speech.
+static const std::chrono::milliseconds MAX_FRAME_DURATION(1000);
+
+/// The power of a full scale square wave, which is 0 dBFS.
+static const double FULL_SCALE_POWER = 32768.0 * 32768.0;
+
+/// A power far below any microphone's noise, which keeps the level of digital silence finite.
+static const double MIN_POWER = 1e-10;
+
+/// The share of the distance to the level of a quieter frame that the noise floor falls each frame.
+static const float NOISE_FLOOR_FALL_RATE = 0.2f;
+
+EnergyVoiceActivityDetector::Config::Config() :
+        frameDuration{10},
+        speechThresholdDb{12.0f},
+        minimumSpeechLevelDbfs{-55.0f},
+        fricativeZeroCrossingRate{0.3f},
+        initialNoiseFloorDbfs{-60.0f},
+        noiseFloorRiseDbPerSecond{3.0f} {
+}
+
+std::unique_ptr<EnergyVoiceActivityDetector> EnergyVoiceActivityDetector::create(const Config& config) {
+    if (config.frameDuration.count() <= 0 || config.frameDuration > MAX_FRAME_DURATION) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameDuration").d("ms", config.frameDuration.count()));
+        return nullptr;
+    }
+    if (config.speechThresholdDb <= 0.0f) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidSpeechThreshold").d("dB", config.speechThresholdDb));
+        return nullptr;
+    }
+    if (config.fricativeZeroCrossingRate <= 0.0f || config.fricativeZeroCrossingRate > 1.0f) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidFricativeZeroCrossingRate")
+                        .d("rate", config.fricativeZeroCrossingRate));
+        return nullptr;
+    }
+    if (config.noiseFloorRiseDbPerSecond < 0.0f) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidNoiseFloorRise").d("dB", config.noiseFloorRiseDbPerSecond));
+        return nullptr;
+    }
+    return std::unique_ptr<EnergyVoiceActivityDetector>(new EnergyVoiceActivityDetector(config));
+}
+
+const char* EnergyVoiceActivityDetector::getInstructionSet() {
+    return kernels::getInstructionSet();
+}
+
+size_t EnergyVoiceActivityDetector::getFrameSizeInSamples() {
+    return m_frameSize;
+}
+
+void EnergyVoiceActivityDetector::reset() {
+    m_noiseFloorDbfs = m_config.initialNoiseFloorDbfs;
+    m_previousSample = 0;
+}
+
+bool EnergyVoiceActivityDetector::isVoiced(const int16_t* samples) {
+    auto sumOfSquares = kernels::sumOfSquares(samples, m_frameSize);
+    auto numCrossings = kernels::countSignChanges(samples, m_frameSize, m_previousSample);
+    m_previousSample = samples[m_frameSize - 1];
+
+    auto power = static_cast<double>(sumOfSquares) / m_frameSize / FULL_SCALE_POWER;
+    auto levelDbfs = static_cast<float>(10.0 * std::log10(power + MIN_POWER));
+    auto zeroCrossingRate = static_cast<float>(numCrossings) / m_frameSize;
+    auto aboveNoiseFloor = levelDbfs - m_noiseFloorDbfs;
+
+    bool voiced = levelDbfs >= m_config.minimumSpeechLevelDbfs &&
+                  (aboveNoiseFloor >= m_config.speechThresholdDb ||
+                   (zeroCrossingRate >= m_config.fricativeZeroCrossingRate &&
+                    aboveNoiseFloor >= m_config.speechThresholdDb / 2));
+
+    if (aboveNoiseFloor < 0.0f) {
+        m_noiseFloorDbfs += NOISE_FLOOR_FALL_RATE * aboveNoiseFloor;
+    } else {
+        m_noiseFloorDbfs += std::min(aboveNoiseFloor, m_noiseFloorRisePerFrame);
+    }
+    return voiced;
+}
+
+float EnergyVoiceActivityDetector::getNoiseFloorDbfs() const {
+    return m_noiseFloorDbfs;
+}
+
+EnergyVoiceActivityDetector::EnergyVoiceActivityDetector(const Config& config) :
+        m_config(config),
+        m_frameSize{static_cast<size_t>(SAMPLE_RATE_HZ * config.frameDuration.count() / 1000)},
+        m_noiseFloorRisePerFrame{config.noiseFloorRiseDbPerSecond * config.frameDuration.count() / 1000.0f},
+        m_noiseFloorDbfs{config.initialNoiseFloorDbfs},
+        m_previousSample{0} {
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <opus.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/OpusAudioEncoder.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OpusAudioEncoder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The sample rate of the audio which is encoded.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The bit rate of the encoded audio.
+static const int BIT_RATE = 32000;
+
+/// The number of samples in a 20 ms frame.
+static const size_t FRAME_SIZE_IN_SAMPLES = SAMPLE_RATE_HZ / 50;
+
+/// The size of a frame at a constant @c BIT_RATE.
+static const size_t FRAME_SIZE_IN_BYTES = BIT_RATE / 8 / 50;
+
+/**
+ * The sample rate by which @c AudioInputProcessor recognizes the OPUS format of AVS.  The format names the bit rate
+ * rather than the 16 kHz the audio is sampled at.
+ */
+static const unsigned int AVS_OPUS_FORMAT_RATE = 32000;
+
+std::shared_ptr<OpusAudioEncoder> OpusAudioEncoder::create() {
+    int error = OPUS_OK;
+    auto encoder = opus_encoder_create(SAMPLE_RATE_HZ, 1, OPUS_APPLICATION_VOIP, &error);
+    if (OPUS_OK != error || !encoder) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createEncoderFailed").d("error", opus_strerror(error)));
+        return nullptr;
+    }
+    // Hard CBR, so that every frame is FRAME_SIZE_IN_BYTES long.
+    if (OPUS_OK != opus_encoder_ctl(encoder, OPUS_SET_BITRATE(BIT_RATE)) ||
+        OPUS_OK != opus_encoder_ctl(encoder, OPUS_SET_VBR(0)) ||
+        OPUS_OK != opus_encoder_ctl(encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE))) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "configureEncoderFailed"));
+        opus_encoder_destroy(encoder);
+        return nullptr;
+    }
+    return std::shared_ptr<OpusAudioEncoder>(new OpusAudioEncoder(encoder));
+}
+
+OpusAudioEncoder::~OpusAudioEncoder() {
+    opus_encoder_destroy(m_encoder);
+}
+
+AudioFormat OpusAudioEncoder::getInputFormat() {
+    return {AudioFormat::Encoding::LPCM, AudioFormat::Endianness::LITTLE, SAMPLE_RATE_HZ, 16, 1};
+}
+
+AudioFormat OpusAudioEncoder::getOutputFormat() {
+    return {AudioFormat::Encoding::OPUS, AudioFormat::Endianness::LITTLE, AVS_OPUS_FORMAT_RATE, 16, 1};
+}
+
+size_t OpusAudioEncoder::getInputFrameSizeInSamples() {
+    return FRAME_SIZE_IN_SAMPLES;
+}
+
+size_t OpusAudioEncoder::getOutputFrameSizeInBytes() {
+    return FRAME_SIZE_IN_BYTES;
+}
+
+bool OpusAudioEncoder::start() {
+    auto error = opus_encoder_ctl(m_encoder, OPUS_RESET_STATE);
+    if (OPUS_OK != error) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "resetStateFailed").d("error", opus_strerror(error)));
+        return false;
+    }
+    return true;
+}
+
+bool OpusAudioEncoder::encode(const int16_t* samples, uint8_t* frame) {
+    auto result = opus_encode(m_encoder, samples, FRAME_SIZE_IN_SAMPLES, frame, FRAME_SIZE_IN_BYTES);
+    if (result < 0) {
+        ACSDK_ERROR(LX("encodeFailed").d("error", opus_strerror(result)));
+        return false;
+    }
+    if (FRAME_SIZE_IN_BYTES != static_cast<size_t>(result)) {
+        ACSDK_ERROR(LX("encodeFailed").d("reason", "unexpectedFrameSize").d("size", result));
+        return false;
+    }
+    return true;
+}
+
+OpusAudioEncoder::OpusAudioEncoder(::OpusEncoder* encoder) : m_encoder{encoder} {
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
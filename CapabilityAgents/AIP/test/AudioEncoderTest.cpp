@@ -0,0 +1,260 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioEncoderTest.cpp
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AIP/AudioEncoder.h"
+#include "AIP/AudioInputProcessor.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// The number of samples in a frame of the fake codec.
+static const size_t INPUT_FRAME_SIZE = 4;
+
+/// The number of bytes in an encoded frame of the fake codec.
+static const size_t OUTPUT_FRAME_SIZE = 2;
+
+/// The number of samples the input stream holds.
+static const size_t INPUT_STREAM_SIZE = 1024;
+
+/// The number of readers of the input stream.
+static const size_t INPUT_STREAM_MAX_READERS = 3;
+
+/// How long to wait for an encoded frame.
+static const std::chrono::seconds TIMEOUT(2);
+
+/// The format the fake codec encodes.
+static const AudioFormat INPUT_FORMAT{AudioFormat::Encoding::LPCM,
+                                      AudioFormat::Endianness::LITTLE,
+                                      16000,
+                                      16,
+                                      1,
+                                      false,
+                                      AudioFormat::Layout::INTERLEAVED};
+
+/// The format the fake codec encodes to.
+static const AudioFormat OUTPUT_FORMAT{AudioFormat::Encoding::OPUS,
+                                       AudioFormat::Endianness::LITTLE,
+                                       32000,
+                                       16,
+                                       1,
+                                       false,
+                                       AudioFormat::Layout::INTERLEAVED};
+
+/**
+ * A codec which encodes a frame as the low bytes of its first and last samples, so that tests can tell which samples
+ * went into each frame.
+ */
+class FakeEncoder : public AudioEncoderInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param inputFormat The format to encode.
+     */
+    FakeEncoder(const AudioFormat& inputFormat = INPUT_FORMAT) : m_inputFormat(inputFormat), m_numStarts{0} {
+    }
+
+    AudioFormat getInputFormat() override {
+        return m_inputFormat;
+    }
+
+    AudioFormat getOutputFormat() override {
+        return OUTPUT_FORMAT;
+    }
+
+    size_t getInputFrameSizeInSamples() override {
+        return INPUT_FRAME_SIZE;
+    }
+
+    size_t getOutputFrameSizeInBytes() override {
+        return OUTPUT_FRAME_SIZE;
+    }
+
+    bool start() override {
+        ++m_numStarts;
+        return true;
+    }
+
+    bool encode(const int16_t* samples, uint8_t* frame) override {
+        frame[0] = static_cast<uint8_t>(samples[0]);
+        frame[1] = static_cast<uint8_t>(samples[INPUT_FRAME_SIZE - 1]);
+        return true;
+    }
+
+    /// The format to encode.
+    const AudioFormat m_inputFormat;
+
+    /// The number of calls to @c start().
+    int m_numStarts;
+};
+
+/// Test harness for @c AudioEncoder.
+class AudioEncoderTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /**
+     * Writes the samples 1, 2, ... @c numSamples to the input stream.
+     *
+     * @param numSamples The number of samples.
+     */
+    void writeSamples(size_t numSamples);
+
+    /**
+     * Reads all the frames of an encoded stream, until it is closed.
+     *
+     * @param stream The encoded stream.
+     * @return The bytes of the frames.
+     */
+    std::vector<uint8_t> readFrames(std::shared_ptr<AudioInputStream> stream);
+
+    /// The fake codec.
+    std::shared_ptr<FakeEncoder> m_codec;
+
+    /// The encoder under test.
+    std::shared_ptr<AudioEncoder> m_encoder;
+
+    /// The LPCM stream.
+    std::shared_ptr<AudioInputStream> m_input;
+
+    /// The writer of the LPCM stream.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+};
+
+void AudioEncoderTest::SetUp() {
+    m_codec = std::make_shared<FakeEncoder>();
+    m_encoder = AudioEncoder::create(m_codec);
+    ASSERT_TRUE(m_encoder);
+    auto bufferSize =
+        AudioInputStream::calculateBufferSize(INPUT_STREAM_SIZE, sizeof(int16_t), INPUT_STREAM_MAX_READERS);
+    m_input = AudioInputStream::create(
+        std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), INPUT_STREAM_MAX_READERS);
+    ASSERT_TRUE(m_input);
+    m_writer = m_input->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(m_writer);
+}
+
+void AudioEncoderTest::writeSamples(size_t numSamples) {
+    std::vector<int16_t> samples(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = static_cast<int16_t>(i + 1);
+    }
+    ASSERT_EQ(static_cast<ssize_t>(numSamples), m_writer->write(samples.data(), numSamples));
+}
+
+std::vector<uint8_t> AudioEncoderTest::readFrames(std::shared_ptr<AudioInputStream> stream) {
+    std::vector<uint8_t> frames;
+    auto reader = stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!reader || !reader->seek(0, AudioInputStream::Reader::Reference::ABSOLUTE)) {
+        return frames;
+    }
+    std::vector<uint8_t> frame(OUTPUT_FRAME_SIZE);
+    while (reader->read(frame.data(), 1, TIMEOUT) == 1) {
+        frames.insert(frames.end(), frame.begin(), frame.end());
+    }
+    return frames;
+}
+
+/// Test that create() rejects a missing codec, and a codec which does not encode 16-bit mono LPCM.
+TEST_F(AudioEncoderTest, createWithInvalidCodec) {
+    EXPECT_FALSE(AudioEncoder::create(nullptr));
+    auto stereo = INPUT_FORMAT;
+    stereo.numChannels = 2;
+    EXPECT_FALSE(AudioEncoder::create(std::make_shared<FakeEncoder>(stereo)));
+}
+
+/// Test that only the input format of the codec can be encoded, and that the output format is the codec's.
+TEST_F(AudioEncoderTest, formats) {
+    EXPECT_TRUE(m_encoder->canEncode(INPUT_FORMAT));
+    auto otherRate = INPUT_FORMAT;
+    otherRate.sampleRateHz = 8000;
+    EXPECT_FALSE(m_encoder->canEncode(otherRate));
+    EXPECT_EQ(AudioFormat::Encoding::OPUS, m_encoder->getOutputFormat().encoding);
+    EXPECT_EQ(OUTPUT_FORMAT.sampleRateHz, m_encoder->getOutputFormat().sampleRateHz);
+}
+
+/// Test that stopping without @c stopImmediately encodes every sample written, padding the last frame with silence.
+TEST_F(AudioEncoderTest, drainOnStop) {
+    writeSamples(10);
+    auto output = m_encoder->startEncoding(m_input, 0);
+    ASSERT_TRUE(output);
+    EXPECT_EQ(OUTPUT_FRAME_SIZE, output->getWordSize());
+    m_encoder->stopEncoding(false);
+
+    std::vector<uint8_t> expected{1, 4, 5, 8, 9, 0};
+    EXPECT_EQ(expected, readFrames(output));
+    auto statistics = m_encoder->getStatistics();
+    EXPECT_EQ(10 * sizeof(int16_t), statistics.bytesRead);
+    EXPECT_EQ(expected.size(), statistics.bytesWritten);
+}
+
+/// Test that stopping immediately does not encode a partial frame.
+TEST_F(AudioEncoderTest, stopImmediately) {
+    writeSamples(2);
+    auto output = m_encoder->startEncoding(m_input, 0);
+    ASSERT_TRUE(output);
+    m_encoder->stopEncoding(true);
+    EXPECT_TRUE(readFrames(output).empty());
+    EXPECT_EQ(0u, m_encoder->getStatistics().bytesWritten);
+}
+
+/// Test that encoding starts at the given index, and does not take samples from other readers of the LPCM stream.
+TEST_F(AudioEncoderTest, otherReadersUnaffected) {
+    auto pcmReader = m_input->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_TRUE(pcmReader);
+    writeSamples(8);
+    auto output = m_encoder->startEncoding(m_input, 4);
+    ASSERT_TRUE(output);
+    m_encoder->stopEncoding(false);
+
+    std::vector<uint8_t> expected{5, 8};
+    EXPECT_EQ(expected, readFrames(output));
+    std::vector<int16_t> samples(8);
+    EXPECT_EQ(8, pcmReader->read(samples.data(), samples.size()));
+    EXPECT_EQ(1, samples.front());
+    EXPECT_EQ(8, samples.back());
+}
+
+/// Test that starting a new stream stops the previous one and restarts the codec.
+TEST_F(AudioEncoderTest, restart) {
+    auto first = m_encoder->startEncoding(m_input, AudioInputProcessor::INVALID_INDEX);
+    ASSERT_TRUE(first);
+    writeSamples(4);
+    auto second = m_encoder->startEncoding(m_input, 0);
+    ASSERT_TRUE(second);
+    m_encoder->stopEncoding(false);
+
+    EXPECT_EQ(2, m_codec->m_numStarts);
+    std::vector<uint8_t> expected{1, 4};
+    EXPECT_EQ(expected, readFrames(second));
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -39,6 +39,7 @@
 #include <AVSCommon/Utils/Memory/Memory.h>
 
 #include "AIP/AudioInputProcessor.h"
+#include "AIP/EndOfSpeechDetector.h"
 #include "MockObserver.h"
 
 using namespace testing;
@@ -263,7 +264,9 @@ public:
         avsCommon::avs::AudioInputStream::Index keywordEnd = AudioInputProcessor::INVALID_INDEX,
         std::string keyword = "",
         std::shared_ptr<std::string> avsInitiator = nullptr,
-        const ESPData& espData = ESPData::EMPTY_ESP_DATA);
+        const ESPData& espData = ESPData::EMPTY_ESP_DATA,
+        const AudioInputProcessor::WakewordUploadConfig& wakewordUploadConfig =
+            AudioInputProcessor::WakewordUploadConfig());
 
     /**
      * This function sends a recognize event using the provided @c AudioInputProcessor and the recognize parameters
@@ -337,6 +340,9 @@ private:
     /// The ESP data for this ReportEchoSpatialPerceptionData event.
     const ESPData m_espData;
 
+    /// How much of the audio around a wake word the @c AudioInputProcessor uploads.
+    const AudioInputProcessor::WakewordUploadConfig m_wakewordUploadConfig;
+
     /// The attachment reader saved by a call to @c verifyMessage().
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
 };
@@ -348,14 +354,16 @@ RecognizeEvent::RecognizeEvent(
     avsCommon::avs::AudioInputStream::Index keywordEnd,
     std::string keyword,
     std::shared_ptr<std::string> avsInitiator,
-    const ESPData& espData) :
+    const ESPData& espData,
+    const AudioInputProcessor::WakewordUploadConfig& wakewordUploadConfig) :
         m_audioProvider{audioProvider},
         m_initiator{initiator},
         m_begin{begin},
         m_keywordEnd{keywordEnd},
         m_keyword{keyword},
         m_avsInitiator{avsInitiator},
-        m_espData{espData} {
+        m_espData{espData},
+        m_wakewordUploadConfig(wakewordUploadConfig) {
 }
 
 std::future<bool> RecognizeEvent::send(std::shared_ptr<AudioInputProcessor> audioInputProcessor) {
@@ -433,6 +441,9 @@ void RecognizeEvent::verifyMessage(
 
     EXPECT_EQ(getJsonString(payload->value, ASR_PROFILE_KEY), profile.str());
 
+    // The index of the pattern the upload starts at.
+    avsCommon::avs::AudioInputStream::Index uploadBegin = 0;
+
     EXPECT_FALSE(
         AUDIO_FORMAT_VALUES.find(getJsonString(payload->value, AUDIO_FORMAT_KEY)) == AUDIO_FORMAT_VALUES.end());
     auto initiator = payload->value.FindMember(RECOGNIZE_INITIATOR_KEY);
@@ -449,20 +460,40 @@ void RecognizeEvent::verifyMessage(
 
         if (m_initiator == Initiator::WAKEWORD && m_begin != AudioInputProcessor::INVALID_INDEX &&
             m_keywordEnd != AudioInputProcessor::INVALID_INDEX) {
+            avsCommon::avs::AudioInputStream::Index preroll =
+                m_audioProvider.format.sampleRateHz * m_wakewordUploadConfig.preroll.count() / 1000;
             auto wakeWordIndices = initiatorPayload->value.FindMember(WAKE_WORD_INDICES_KEY);
-            EXPECT_NE(wakeWordIndices, initiatorPayload->value.MemberEnd());
-
-            if (wakeWordIndices != initiatorPayload->value.MemberEnd()) {
-                EXPECT_EQ(getJsonInt64(wakeWordIndices->value, START_INDEX_KEY), static_cast<int64_t>(m_begin));
-                EXPECT_EQ(getJsonInt64(wakeWordIndices->value, END_INDEX_KEY), static_cast<int64_t>(m_keywordEnd));
+            if (m_wakewordUploadConfig.uploadFromKeywordEnd) {
+                // The upload starts at the end of the keyword, which the cloud is not asked to verify.
+                EXPECT_EQ(wakeWordIndices, initiatorPayload->value.MemberEnd());
+                uploadBegin = m_keywordEnd;
+            } else if (m_begin >= preroll) {
+                // The upload starts with the preroll before the keyword.
+                EXPECT_NE(wakeWordIndices, initiatorPayload->value.MemberEnd());
+                if (wakeWordIndices != initiatorPayload->value.MemberEnd()) {
+                    EXPECT_EQ(
+                        getJsonInt64(wakeWordIndices->value, START_INDEX_KEY), static_cast<int64_t>(preroll));
+                    EXPECT_EQ(
+                        getJsonInt64(wakeWordIndices->value, END_INDEX_KEY),
+                        static_cast<int64_t>(preroll + m_keywordEnd - m_begin));
+                }
+                uploadBegin = m_begin - preroll;
+            } else {
+                // Without the full preroll, the upload starts at the keyword, which the cloud is not asked to verify.
+                EXPECT_EQ(wakeWordIndices, initiatorPayload->value.MemberEnd());
+                uploadBegin = m_begin;
             }
+        } else if (m_begin != AudioInputProcessor::INVALID_INDEX) {
+            uploadBegin = m_begin;
         }
     }
 
     m_reader = request->getAttachmentReader();
     EXPECT_NE(m_reader, nullptr);
 
-    std::vector<Sample> samples(PATTERN_WORDS);
+    ASSERT_LT(uploadBegin, pattern.size());
+    std::vector<Sample> expected(pattern.begin() + uploadBegin, pattern.end());
+    std::vector<Sample> samples(expected.size());
     size_t samplesRead = 0;
     auto t0 = std::chrono::steady_clock::now();
     do {
@@ -479,7 +510,7 @@ void RecognizeEvent::verifyMessage(
         samplesRead += bytesRead / 2;
     } while (samplesRead < samples.size() && t0 - std::chrono::steady_clock::now() < TEST_TIMEOUT);
     EXPECT_EQ(samplesRead, samples.size());
-    EXPECT_EQ(samples, pattern);
+    EXPECT_EQ(samples, expected);
 }
 
 std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> RecognizeEvent::getReader() {
@@ -514,6 +545,21 @@ void TestDialogUXStateObserver::onDialogUXStateChanged(DialogUXState newState) {
     }
 }
 
+/// A voice activity detector which takes 10 ms frames whose first sample is not zero for speech.
+class FakeVoiceActivityDetector : public VoiceActivityDetectorInterface {
+public:
+    size_t getFrameSizeInSamples() override {
+        return SAMPLE_RATE_HZ / 100;
+    }
+
+    void reset() override {
+    }
+
+    bool isVoiced(const int16_t* samples) override {
+        return samples[0] != 0;
+    }
+};
+
 /// Test harness for @c AudioInputProcessor class.
 class AudioInputProcessorTest : public ::testing::Test {
 public:
@@ -666,6 +712,14 @@ protected:
      */
     void makeDefaultAudioProviderNotAlwaysReadable();
 
+    /**
+     * This function replaces @c m_audioInputProcessor with a new one which uploads the audio around a wake word as
+     * configured, and records the configuration for verifying its Recognize events.
+     *
+     * @param config How much of the audio around a wake word to upload.
+     */
+    void setWakewordUploadConfig(const AudioInputProcessor::WakewordUploadConfig& config);
+
     /**
      * Function to call @c onFocusChanged() and verify that @c AudioInputProcessor responds correctly.
      *
@@ -717,6 +771,9 @@ protected:
     std::vector<Sample> m_pattern;
 
     std::string m_dialogRequestId;
+
+    /// How much of the audio around a wake word @c m_audioInputProcessor uploads.
+    AudioInputProcessor::WakewordUploadConfig m_wakewordUploadConfig;
 };
 
 void AudioInputProcessorTest::SetUp() {
@@ -816,8 +873,8 @@ bool AudioInputProcessorTest::testRecognizeSucceeds(
     rapidjson::Writer<rapidjson::StringBuffer> contextWriter(contextBuffer);
     contextDocument.Accept(contextWriter);
     std::string contextJson = contextBuffer.GetString();
-    m_recognizeEvent =
-        std::make_shared<RecognizeEvent>(audioProvider, initiator, begin, keywordEnd, keyword, avsInitiator, espData);
+    m_recognizeEvent = std::make_shared<RecognizeEvent>(
+        audioProvider, initiator, begin, keywordEnd, keyword, avsInitiator, espData, m_wakewordUploadConfig);
     if (keyword.empty()) {
         EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this] {
             m_audioInputProcessor->provideState(STOP_CAPTURE, STATE_REQUEST_TOKEN);
@@ -1295,6 +1352,27 @@ void AudioInputProcessorTest::makeDefaultAudioProviderNotAlwaysReadable() {
     m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
 }
 
+void AudioInputProcessorTest::setWakewordUploadConfig(const AudioInputProcessor::WakewordUploadConfig& config) {
+    m_wakewordUploadConfig = config;
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        nullptr,
+        nullptr,
+        config);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+}
+
 bool AudioInputProcessorTest::testFocusChange(avsCommon::avs::FocusState state) {
     std::mutex mutex;
     std::condition_variable conditionVariable;
@@ -1567,6 +1645,59 @@ TEST_F(AudioInputProcessorTest, recognizeWakewordWithGoodBeginAndEnd) {
     EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
 }
 
+/// This function verifies that a shorter preroll uploads less of the audio before the keyword.
+TEST_F(AudioInputProcessorTest, recognizeWakewordWithShortPreroll) {
+    AudioInputProcessor::WakewordUploadConfig config;
+    config.preroll = PREROLL_MS / 4;
+    setWakewordUploadConfig(config);
+    avsCommon::avs::AudioInputStream::Index begin = PREROLL_WORDS;
+    avsCommon::avs::AudioInputStream::Index end = PREROLL_WORDS + WAKEWORD_WORDS / 4;
+    EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
+}
+
+/**
+ * This function verifies that without a full preroll before the keyword, the upload starts at the keyword and does
+ * not ask the cloud to verify it.
+ */
+TEST_F(AudioInputProcessorTest, recognizeWakewordWithoutFullPreroll) {
+    avsCommon::avs::AudioInputStream::Index begin = PREROLL_WORDS / 4;
+    avsCommon::avs::AudioInputStream::Index end = PREROLL_WORDS / 2;
+    EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
+}
+
+/**
+ * This function verifies that the upload can start from the end of the keyword, with the initiator still a wakeword
+ * but without the keyword's indices, even when there is a full preroll before the keyword.
+ */
+TEST_F(AudioInputProcessorTest, recognizeWakewordFromKeywordEnd) {
+    AudioInputProcessor::WakewordUploadConfig config;
+    config.uploadFromKeywordEnd = true;
+    setWakewordUploadConfig(config);
+    avsCommon::avs::AudioInputStream::Index begin = PREROLL_WORDS;
+    avsCommon::avs::AudioInputStream::Index end = PREROLL_WORDS + WAKEWORD_WORDS / 32;
+    EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
+}
+
+/// This function verifies that @c AudioInputProcessor::create() errors out with a negative preroll.
+TEST_F(AudioInputProcessorTest, createWithNegativePreroll) {
+    AudioInputProcessor::WakewordUploadConfig config;
+    config.preroll = std::chrono::milliseconds(-1);
+    EXPECT_EQ(
+        AudioInputProcessor::create(
+            m_mockDirectiveSequencer,
+            m_mockMessageSender,
+            m_mockContextManager,
+            m_mockFocusManager,
+            m_dialogUXStateAggregator,
+            m_mockExceptionEncounteredSender,
+            m_mockUserActivityNotifier,
+            *m_audioProvider,
+            nullptr,
+            nullptr,
+            config),
+        nullptr);
+}
+
 /// This function verifies that @c AudioInputProcessor::recognize() works with @c ASRProfile::CLOSE_TALK.
 TEST_F(AudioInputProcessorTest, recognizeCloseTalk) {
     auto audioProvider = *m_audioProvider;
@@ -1963,6 +2094,71 @@ TEST_F(AudioInputProcessorTest, recognizeOPUSWithWakeWord) {
     m_audioProvider->format.sampleRateHz = 32000;
     EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
 }
+/**
+ * This function verifies that an @c EndOfSpeechDetector stops capture once the test pattern is followed by silence,
+ * and that the StopCapture directive which arrives afterwards completes instead of failing.
+ */
+TEST_F(AudioInputProcessorTest, endOfSpeechDetectedLocally) {
+    EndOfSpeechDetector::Config config;
+    config.minimumSpeechDuration = std::chrono::milliseconds(10);
+    config.hangover = std::chrono::milliseconds(100);
+    config.noSpeechTimeout = std::chrono::milliseconds(0);
+    auto endOfSpeechDetector = EndOfSpeechDetector::create(std::make_shared<FakeVoiceActivityDetector>(), config);
+    ASSERT_NE(endOfSpeechDetector, nullptr);
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        nullptr,
+        endOfSpeechDetector);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    ASSERT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::TAP, 0));
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool done = false;
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::BUSY));
+    EXPECT_CALL(*m_mockFocusManager, releaseChannel(CHANNEL_NAME, _));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::IDLE))
+        .WillOnce(InvokeWithoutArgs([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            conditionVariable.notify_one();
+        }));
+    std::vector<Sample> silence(SAMPLE_RATE_HZ / 5, 0);
+    EXPECT_EQ(m_writer->write(silence.data(), silence.size()), static_cast<ssize_t>(silence.size()));
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&done] { return done; }));
+    }
+
+    // The cloud's StopCapture for the same dialog arrives after capture stopped locally.
+    auto avsDirective = createAVSDirective(STOP_CAPTURE, WITH_DIALOG_REQUEST_ID);
+    auto result = avsCommon::utils::memory::make_unique<avsCommon::sdkInterfaces::test::MockDirectiveHandlerResult>();
+    done = false;
+    EXPECT_CALL(*result, setFailed(_)).Times(0);
+    EXPECT_CALL(*result, setCompleted()).WillOnce(InvokeWithoutArgs([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        conditionVariable.notify_one();
+    }));
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> directiveHandler = m_audioInputProcessor;
+    directiveHandler->preHandleDirective(avsDirective, std::move(result));
+    EXPECT_TRUE(directiveHandler->handleDirective(avsDirective->getMessageId()));
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&done] { return done; }));
+}
+
 }  // namespace test
 }  // namespace aip
 }  // namespace capabilityAgents
@@ -0,0 +1,274 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EndOfSpeechDetectorTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AIP/AudioInputProcessor.h"
+#include "AIP/EndOfSpeechDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// The number of samples in a frame of the fake detector, which is 10 ms.
+static const size_t FRAME_SIZE = 160;
+
+/// The number of samples the stream holds.
+static const size_t STREAM_SIZE = 16000 * 4;
+
+/// The number of readers of the stream.
+static const size_t STREAM_MAX_READERS = 2;
+
+/// How long to wait for the callback.
+static const std::chrono::seconds TIMEOUT(2);
+
+/// How long to wait for a callback which should not come.
+static const std::chrono::milliseconds SHORT_TIMEOUT(200);
+
+/// A voice activity detector which takes frames whose first sample is not zero for speech.
+class FakeVoiceActivityDetector : public VoiceActivityDetectorInterface {
+public:
+    /// Constructor.
+    FakeVoiceActivityDetector() : m_numResets{0} {
+    }
+
+    size_t getFrameSizeInSamples() override {
+        return FRAME_SIZE;
+    }
+
+    void reset() override {
+        ++m_numResets;
+    }
+
+    bool isVoiced(const int16_t* samples) override {
+        return samples[0] != 0;
+    }
+
+    /// The number of calls to @c reset().
+    int m_numResets;
+};
+
+/// Test harness for @c EndOfSpeechDetector.
+class EndOfSpeechDetectorTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /**
+     * Writes frames the fake detector classifies as speech or silence.
+     *
+     * @param voiced Whether the frames are speech.
+     * @param numFrames The number of frames.
+     */
+    void writeFrames(bool voiced, size_t numFrames);
+
+    /**
+     * Starts detection from the start of the stream, recording the callback.
+     *
+     * @param detector The detector.
+     * @return Whether detection started.
+     */
+    bool start(std::shared_ptr<EndOfSpeechDetector> detector);
+
+    /**
+     * Waits for the callback.
+     *
+     * @param timeout How long to wait.
+     * @param numCallbacks The number of calls to wait for.
+     * @return Whether the callback was called that many times.
+     */
+    bool waitForCallback(std::chrono::milliseconds timeout, int numCallbacks = 1);
+
+    /// The fake detector.
+    std::shared_ptr<FakeVoiceActivityDetector> m_voiceActivityDetector;
+
+    /// The settings of the detector under test: 10 frames begin speech, 60 end it, and it gives up after 200.
+    EndOfSpeechDetector::Config m_config;
+
+    /// The stream.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer of the stream.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the callback is called.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of calls to the callback.
+    int m_numCallbacks;
+
+    /// The reason passed to the last callback.
+    EndOfSpeechDetector::Reason m_reason;
+
+    /// The index passed to the last callback.
+    AudioInputStream::Index m_index;
+};
+
+void EndOfSpeechDetectorTest::SetUp() {
+    m_voiceActivityDetector = std::make_shared<FakeVoiceActivityDetector>();
+    m_config.minimumSpeechDuration = std::chrono::milliseconds(100);
+    m_config.hangover = std::chrono::milliseconds(600);
+    m_config.noSpeechTimeout = std::chrono::milliseconds(2000);
+    auto bufferSize = AudioInputStream::calculateBufferSize(STREAM_SIZE, sizeof(int16_t), STREAM_MAX_READERS);
+    m_stream = AudioInputStream::create(
+        std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), STREAM_MAX_READERS);
+    ASSERT_TRUE(m_stream);
+    m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(m_writer);
+    m_numCallbacks = 0;
+    m_index = 0;
+}
+
+void EndOfSpeechDetectorTest::writeFrames(bool voiced, size_t numFrames) {
+    std::vector<int16_t> samples(FRAME_SIZE * numFrames, voiced ? 1000 : 0);
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), m_writer->write(samples.data(), samples.size()));
+}
+
+bool EndOfSpeechDetectorTest::start(std::shared_ptr<EndOfSpeechDetector> detector) {
+    return detector->start(m_stream, 0, [this](EndOfSpeechDetector::Reason reason, AudioInputStream::Index index) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_numCallbacks;
+        m_reason = reason;
+        m_index = index;
+        m_wakeTrigger.notify_all();
+    });
+}
+
+bool EndOfSpeechDetectorTest::waitForCallback(std::chrono::milliseconds timeout, int numCallbacks) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this, numCallbacks] { return m_numCallbacks >= numCallbacks; });
+}
+
+/// Test that create() rejects a missing detector and invalid durations.
+TEST_F(EndOfSpeechDetectorTest, createWithInvalidArguments) {
+    EXPECT_FALSE(EndOfSpeechDetector::create(nullptr, m_config));
+    auto config = m_config;
+    config.hangover = std::chrono::milliseconds(0);
+    EXPECT_FALSE(EndOfSpeechDetector::create(m_voiceActivityDetector, config));
+    config = m_config;
+    config.noSpeechTimeout = std::chrono::milliseconds(-1);
+    EXPECT_FALSE(EndOfSpeechDetector::create(m_voiceActivityDetector, config));
+    EXPECT_TRUE(EndOfSpeechDetector::create(m_voiceActivityDetector, m_config));
+}
+
+/// Test that only 16 kHz, 16-bit mono LPCM is accepted.
+TEST_F(EndOfSpeechDetectorTest, canDetect) {
+    auto detector = EndOfSpeechDetector::create(m_voiceActivityDetector, m_config);
+    ASSERT_TRUE(detector);
+    AudioFormat format{AudioFormat::Encoding::LPCM,
+                       AudioFormat::Endianness::LITTLE,
+                       16000,
+                       16,
+                       1,
+                       false,
+                       AudioFormat::Layout::INTERLEAVED};
+    EXPECT_TRUE(detector->canDetect(format));
+    auto other = format;
+    other.sampleRateHz = 48000;
+    EXPECT_FALSE(detector->canDetect(other));
+    other = format;
+    other.numChannels = 2;
+    EXPECT_FALSE(detector->canDetect(other));
+    other = format;
+    other.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_FALSE(detector->canDetect(other));
+}
+
+/// Test that speech ends after the hangover of silence, and a pause shorter than the hangover does not end it.
+TEST_F(EndOfSpeechDetectorTest, speechEndsAfterHangover) {
+    auto detector = EndOfSpeechDetector::create(m_voiceActivityDetector, m_config);
+    ASSERT_TRUE(detector);
+    writeFrames(false, 30);
+    writeFrames(true, 20);
+    writeFrames(false, 59);
+    writeFrames(true, 20);
+    writeFrames(false, 100);
+    ASSERT_TRUE(start(detector));
+
+    ASSERT_TRUE(waitForCallback(TIMEOUT));
+    EXPECT_EQ(EndOfSpeechDetector::Reason::END_OF_SPEECH, m_reason);
+    EXPECT_EQ((30u + 20u + 59u + 20u + 60u) * FRAME_SIZE, m_index);
+    EXPECT_EQ(1, m_voiceActivityDetector->m_numResets);
+
+    // The detector only calls back once.
+    writeFrames(true, 20);
+    writeFrames(false, 100);
+    EXPECT_FALSE(waitForCallback(SHORT_TIMEOUT, 2));
+}
+
+/// Test that audio written after detection starts is classified as it arrives.
+TEST_F(EndOfSpeechDetectorTest, detectsInLiveAudio) {
+    auto detector = EndOfSpeechDetector::create(m_voiceActivityDetector, m_config);
+    ASSERT_TRUE(detector);
+    ASSERT_TRUE(start(detector));
+    writeFrames(true, 50);
+    EXPECT_FALSE(waitForCallback(SHORT_TIMEOUT));
+    writeFrames(false, 59);
+    EXPECT_FALSE(waitForCallback(SHORT_TIMEOUT));
+    writeFrames(false, 1);
+    ASSERT_TRUE(waitForCallback(TIMEOUT));
+    EXPECT_EQ(EndOfSpeechDetector::Reason::END_OF_SPEECH, m_reason);
+    EXPECT_EQ(110u * FRAME_SIZE, m_index);
+}
+
+/// Test that bursts shorter than the minimum speech duration are not speech, and detection gives up at the timeout.
+TEST_F(EndOfSpeechDetectorTest, noSpeechTimeout) {
+    auto detector = EndOfSpeechDetector::create(m_voiceActivityDetector, m_config);
+    ASSERT_TRUE(detector);
+    for (int i = 0; i < 25; ++i) {
+        writeFrames(true, 9);
+        writeFrames(false, 1);
+    }
+    ASSERT_TRUE(start(detector));
+    ASSERT_TRUE(waitForCallback(TIMEOUT));
+    EXPECT_EQ(EndOfSpeechDetector::Reason::NO_SPEECH_TIMEOUT, m_reason);
+    EXPECT_EQ(200u * FRAME_SIZE, m_index);
+}
+
+/// Test that detection stopped before the end of speech does not call back, and that it can be started again.
+TEST_F(EndOfSpeechDetectorTest, stopAndRestart) {
+    auto detector = EndOfSpeechDetector::create(m_voiceActivityDetector, m_config);
+    ASSERT_TRUE(detector);
+    ASSERT_TRUE(start(detector));
+    writeFrames(true, 50);
+    detector->stop();
+    writeFrames(false, 100);
+    EXPECT_FALSE(waitForCallback(SHORT_TIMEOUT));
+
+    ASSERT_TRUE(start(detector));
+    ASSERT_TRUE(waitForCallback(TIMEOUT));
+    EXPECT_EQ(EndOfSpeechDetector::Reason::END_OF_SPEECH, m_reason);
+    EXPECT_EQ(110u * FRAME_SIZE, m_index);
+    EXPECT_EQ(2, m_voiceActivityDetector->m_numResets);
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
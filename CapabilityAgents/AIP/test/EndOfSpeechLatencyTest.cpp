@@ -0,0 +1,183 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EndOfSpeechLatencyTest.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+
+#include "AIP/EndOfSpeechDetector.h"
+#include "AIP/EnergyVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils::audio;
+
+/// The path to the inputs folder, which is passed on the command line.
+std::string inputsDirPath;
+
+/// The sample rate of the recordings.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of bytes uploaded per millisecond of 16 kHz, 16-bit mono LPCM.
+static const size_t BYTES_PER_MILLISECOND = SAMPLE_RATE_HZ / 1000 * sizeof(int16_t);
+
+/// How much of the recording before each utterance is classified, so the detector sees the room first.
+static const std::chrono::milliseconds LEAD_IN(200);
+
+/// How much room noise follows each utterance.
+static const std::chrono::milliseconds TRAIL(3000);
+
+/// The RMS level of the room noise which follows each utterance, which is that of the recordings.
+static const float ROOM_NOISE_DBFS = -70.0f;
+
+/// How long to wait for the detector.
+static const std::chrono::seconds TIMEOUT(5);
+
+/// How much earlier than the hangover after the labelled end of an utterance the detector may end it.
+static const std::chrono::milliseconds EARLY_TOLERANCE(100);
+
+/// How much later than the hangover after the labelled end of an utterance the detector may end it.
+static const std::chrono::milliseconds LATE_TOLERANCE(300);
+
+/// An utterance in a recording, labelled by hand.
+struct Utterance {
+    /// The recording.
+    std::string recording;
+    /// Where the utterance begins, in milliseconds.
+    int beginMs;
+    /// Where the utterance ends, in milliseconds.
+    int endMs;
+};
+
+/// The utterances of the recordings in the inputs folder.
+static const std::vector<Utterance> UTTERANCES = {{"/alexa_stop_alexa_joke.wav", 640, 1790},
+                                                  {"/alexa_stop_alexa_joke.wav", 2530, 3990},
+                                                  {"/four_alexa.wav", 430, 1180},
+                                                  {"/four_alexa.wav", 1600, 3050},
+                                                  {"/four_alexa.wav", 3810, 4380},
+                                                  {"/four_alexa.wav", 4990, 5930}};
+
+/**
+ * Converts a duration into a number of samples.
+ *
+ * @param duration The duration.
+ * @return The number of samples.
+ */
+static size_t toSamples(std::chrono::milliseconds duration) {
+    return static_cast<size_t>(duration.count()) * SAMPLE_RATE_HZ / 1000;
+}
+
+/**
+ * Runs each labelled utterance, followed by room noise, through an @c EndOfSpeechDetector with the default settings
+ * and an @c EnergyVoiceActivityDetector, and reports how long after the labelled end of the utterance the detector
+ * ended it, which is how much audio is uploaded after the talker stops.
+ */
+TEST(EndOfSpeechLatencyTest, delayAfterEndOfUtterance) {
+    EndOfSpeechDetector::Config config;
+    std::cout << "Instruction set: " << EnergyVoiceActivityDetector::getInstructionSet()
+              << ", hangover: " << config.hangover.count() << " ms" << std::endl;
+    std::mt19937 generator(0);
+    std::normal_distribution<float> noise(0.0f, 32768.0f * std::pow(10.0f, ROOM_NOISE_DBFS / 20.0f));
+    std::chrono::milliseconds totalDelay(0);
+    std::chrono::milliseconds maxDelay(0);
+
+    for (const auto& utterance : UTTERANCES) {
+        std::vector<int16_t> recording;
+        ASSERT_TRUE(readPcmFile(inputsDirPath + utterance.recording, SAMPLE_RATE_HZ, 1, &recording))
+            << "Unable to read " << inputsDirPath + utterance.recording;
+        auto begin = toSamples(std::chrono::milliseconds(utterance.beginMs) - LEAD_IN);
+        auto end = toSamples(std::chrono::milliseconds(utterance.endMs));
+        ASSERT_LE(end, recording.size());
+        std::vector<int16_t> samples(recording.begin() + begin, recording.begin() + end);
+        for (size_t i = 0; i < toSamples(TRAIL); ++i) {
+            samples.push_back(static_cast<int16_t>(noise(generator)));
+        }
+
+        auto bufferSize = AudioInputStream::calculateBufferSize(samples.size(), sizeof(int16_t), 1);
+        std::shared_ptr<AudioInputStream> stream =
+            AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+        ASSERT_TRUE(stream);
+        auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+        ASSERT_TRUE(writer);
+        ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+
+        auto detector = EndOfSpeechDetector::create(EnergyVoiceActivityDetector::create(), config);
+        ASSERT_TRUE(detector);
+        std::mutex mutex;
+        std::condition_variable wakeTrigger;
+        bool detected = false;
+        EndOfSpeechDetector::Reason detectedReason = EndOfSpeechDetector::Reason::NO_SPEECH_TIMEOUT;
+        AudioInputStream::Index detectedIndex = 0;
+        ASSERT_TRUE(detector->start(stream, 0, [&](EndOfSpeechDetector::Reason reason, AudioInputStream::Index index) {
+            std::lock_guard<std::mutex> lock(mutex);
+            detected = true;
+            detectedReason = reason;
+            detectedIndex = index;
+            wakeTrigger.notify_all();
+        }));
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ASSERT_TRUE(wakeTrigger.wait_for(lock, TIMEOUT, [&detected] { return detected; }));
+        }
+        detector->stop();
+
+        EXPECT_EQ(EndOfSpeechDetector::Reason::END_OF_SPEECH, detectedReason) << utterance.recording;
+        std::chrono::milliseconds delay(
+            static_cast<int>((static_cast<int64_t>(detectedIndex) - static_cast<int64_t>(end - begin)) * 1000 /
+                             static_cast<int64_t>(SAMPLE_RATE_HZ)));
+        std::cout << utterance.recording << " [" << utterance.beginMs << ", " << utterance.endMs
+                  << "] ms: ended " << delay.count() << " ms after the utterance, "
+                  << delay.count() * static_cast<int64_t>(BYTES_PER_MILLISECOND) << " bytes uploaded after it"
+                  << std::endl;
+        EXPECT_GE(delay, config.hangover - EARLY_TOLERANCE) << utterance.recording;
+        EXPECT_LE(delay, config.hangover + LATE_TOLERANCE) << utterance.recording;
+        totalDelay += delay;
+        maxDelay = std::max(maxDelay, delay);
+    }
+    std::cout << "Delay after the end of an utterance: mean " << totalDelay.count() / UTTERANCES.size()
+              << " ms, max " << maxDelay.count() << " ms" << std::endl;
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::capabilityAgents::aip::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EnergyVoiceActivityDetectorTest.cpp
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AIP/EnergyVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+/// The sample rate of the tests.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of frames in a second.
+static const int FRAMES_PER_SECOND = 100;
+
+/// Test harness for @c EnergyVoiceActivityDetector, which generates frames of test signals.
+class EnergyVoiceActivityDetectorTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /**
+     * Generates a frame of white noise.
+     *
+     * @param levelDbfs The RMS level of the noise.
+     * @return The frame.
+     */
+    std::vector<int16_t> noise(float levelDbfs);
+
+    /**
+     * Generates a frame of a tone, continuing the phase of the previous frame.
+     *
+     * @param frequencyHz The frequency of the tone.
+     * @param levelDbfs The RMS level of the tone.
+     * @return The frame.
+     */
+    std::vector<int16_t> tone(float frequencyHz, float levelDbfs);
+
+    /**
+     * Classifies frames of white noise.
+     *
+     * @param levelDbfs The RMS level of the noise.
+     * @param numFrames The number of frames.
+     * @return The number of frames classified as speech.
+     */
+    int classifyNoise(float levelDbfs, int numFrames);
+
+    /// The detector under test.
+    std::unique_ptr<EnergyVoiceActivityDetector> m_detector;
+
+    /// The generator of the noise.
+    std::mt19937 m_generator;
+
+    /// The number of samples of tone generated so far.
+    size_t m_toneSamples;
+};
+
+void EnergyVoiceActivityDetectorTest::SetUp() {
+    m_detector = EnergyVoiceActivityDetector::create();
+    ASSERT_TRUE(m_detector);
+    m_generator.seed(3);
+    m_toneSamples = 0;
+}
+
+std::vector<int16_t> EnergyVoiceActivityDetectorTest::noise(float levelDbfs) {
+    std::normal_distribution<float> distribution(0.0f, 32768.0f * std::pow(10.0f, levelDbfs / 20.0f));
+    std::vector<int16_t> frame(m_detector->getFrameSizeInSamples());
+    for (auto& sample : frame) {
+        sample = static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, distribution(m_generator))));
+    }
+    return frame;
+}
+
+std::vector<int16_t> EnergyVoiceActivityDetectorTest::tone(float frequencyHz, float levelDbfs) {
+    double amplitude = 32768.0 * std::sqrt(2.0) * std::pow(10.0, levelDbfs / 20.0);
+    double pi = std::acos(-1.0);
+    std::vector<int16_t> frame(m_detector->getFrameSizeInSamples());
+    for (auto& sample : frame) {
+        sample = static_cast<int16_t>(amplitude * std::sin(2.0 * pi * frequencyHz * m_toneSamples++ / SAMPLE_RATE_HZ));
+    }
+    return frame;
+}
+
+int EnergyVoiceActivityDetectorTest::classifyNoise(float levelDbfs, int numFrames) {
+    int numVoiced = 0;
+    for (int i = 0; i < numFrames; ++i) {
+        numVoiced += m_detector->isVoiced(noise(levelDbfs).data());
+    }
+    return numVoiced;
+}
+
+/// Test that create() rejects invalid settings, and that the default frame is 10 ms.
+TEST_F(EnergyVoiceActivityDetectorTest, create) {
+    EXPECT_EQ(160u, m_detector->getFrameSizeInSamples());
+    EnergyVoiceActivityDetector::Config config;
+    config.frameDuration = std::chrono::milliseconds(0);
+    EXPECT_FALSE(EnergyVoiceActivityDetector::create(config));
+    config = EnergyVoiceActivityDetector::Config();
+    config.speechThresholdDb = 0.0f;
+    EXPECT_FALSE(EnergyVoiceActivityDetector::create(config));
+    config = EnergyVoiceActivityDetector::Config();
+    config.fricativeZeroCrossingRate = 1.5f;
+    EXPECT_FALSE(EnergyVoiceActivityDetector::create(config));
+}
+
+/// Test that digital silence and room noise are not speech, and the noise floor settles at the level of the noise.
+TEST_F(EnergyVoiceActivityDetectorTest, silenceAndNoiseAreNotVoiced) {
+    std::vector<int16_t> silence(m_detector->getFrameSizeInSamples(), 0);
+    EXPECT_FALSE(m_detector->isVoiced(silence.data()));
+    EXPECT_EQ(0, classifyNoise(-70.0f, FRAMES_PER_SECOND));
+    EXPECT_NEAR(-70.0f, m_detector->getNoiseFloorDbfs(), 1.0f);
+}
+
+/// Test that a voiced tone well above the noise floor is speech from its first frame to its last.
+TEST_F(EnergyVoiceActivityDetectorTest, toneAboveNoiseIsVoiced) {
+    classifyNoise(-70.0f, FRAMES_PER_SECOND);
+    for (int i = 0; i < FRAMES_PER_SECOND; ++i) {
+        ASSERT_TRUE(m_detector->isVoiced(tone(200.0f, -35.0f).data())) << "frame=" << i;
+    }
+    EXPECT_FALSE(m_detector->isVoiced(noise(-70.0f).data()));
+    EXPECT_NEAR(-70.0f, m_detector->getNoiseFloorDbfs(), 4.0f);
+}
+
+/// Test that a full scale signal is measured without overflowing.
+TEST_F(EnergyVoiceActivityDetectorTest, fullScaleIsVoiced) {
+    std::vector<int16_t> frame(m_detector->getFrameSizeInSamples());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = i % 2 ? 32767 : -32768;
+    }
+    EXPECT_TRUE(m_detector->isVoiced(frame.data()));
+    std::vector<int16_t> negative(m_detector->getFrameSizeInSamples(), -32768);
+    EXPECT_TRUE(m_detector->isVoiced(negative.data()));
+}
+
+/// Test that a quiet hiss counts as speech where a quiet hum of the same level does not.
+TEST_F(EnergyVoiceActivityDetectorTest, quietFricativeIsVoiced) {
+    classifyNoise(-60.0f, FRAMES_PER_SECOND);
+    // Eight dB above the noise floor, which is less than the speech threshold but more than half of it.
+    EXPECT_FALSE(m_detector->isVoiced(tone(150.0f, -52.0f).data()));
+    EXPECT_TRUE(m_detector->isVoiced(tone(5000.0f, -52.0f).data()));
+}
+
+/// Test that the noise floor rises slowly to a louder room, after which its noise is no longer speech.
+TEST_F(EnergyVoiceActivityDetectorTest, noiseFloorFollowsLouderRoom) {
+    classifyNoise(-70.0f, FRAMES_PER_SECOND);
+    EXPECT_EQ(FRAMES_PER_SECOND, classifyNoise(-50.0f, FRAMES_PER_SECOND));
+    classifyNoise(-50.0f, FRAMES_PER_SECOND * 6);
+    EXPECT_EQ(0, classifyNoise(-50.0f, FRAMES_PER_SECOND));
+    EXPECT_NEAR(-50.0f, m_detector->getNoiseFloorDbfs(), 1.0f);
+
+    m_detector->reset();
+    EXPECT_EQ(EnergyVoiceActivityDetector::Config().initialNoiseFloorDbfs, m_detector->getNoiseFloorDbfs());
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
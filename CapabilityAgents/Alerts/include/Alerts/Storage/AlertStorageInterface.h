@@ -71,13 +71,23 @@ public:
     virtual bool store(std::shared_ptr<Alert> alert) = 0;
 
     /**
-     * Loads all alerts in the database.
+     * Loads all alerts in the database.  Implementations may defer loading the custom assets of the alerts until
+     * @c loadAssets is called.
      *
      * @param[out] alertContainer The container where alerts should be stored.
      * @return Whether the @c Alerts were successfully loaded.
      */
     virtual bool load(std::vector<std::shared_ptr<Alert>>* alertContainer) = 0;
 
+    /**
+     * Loads the custom assets of a stored @c Alert, replacing any assets it already holds.  This is called before the
+     * @c Alert is rendered.
+     *
+     * @param alert The @c Alert whose assets should be loaded.
+     * @return Whether the assets were successfully loaded.
+     */
+    virtual bool loadAssets(std::shared_ptr<Alert> alert) = 0;
+
     /**
      * Updates a database record of the @c Alert parameter.
      * The fields which are updated by this operation are the state and scheduled times of the alert.  All other fields
@@ -61,8 +61,16 @@ public:
 
     bool store(std::shared_ptr<Alert> alert) override;
 
+    /**
+     * Loads all alerts in the database, without their custom assets.
+     *
+     * @param[out] alertContainer The container where alerts should be stored.
+     * @return Whether the @c Alerts were successfully loaded.
+     */
     bool load(std::vector<std::shared_ptr<Alert>>* alertContainer) override;
 
+    bool loadAssets(std::shared_ptr<Alert> alert) override;
+
     bool modify(std::shared_ptr<Alert> alert) override;
 
     bool erase(std::shared_ptr<Alert> alert) override;
@@ -455,6 +455,13 @@ void AlertScheduler::activateNextAlertLocked() {
     m_activeAlert = *(m_scheduledAlerts.begin());
     m_scheduledAlerts.erase(m_scheduledAlerts.begin());
 
+    // Assets are only loaded from storage once the alert is actually rendered.  On failure the alert falls back to
+    // its default audio.
+    if (!m_alertStorage->loadAssets(m_activeAlert)) {
+        ACSDK_WARN(
+            LX("activateNextAlertLocked").m("Could not load alert assets.").d("token", m_activeAlert->getToken()));
+    }
+
     m_activeAlert->setFocusState(m_focusState);
     m_activeAlert->activate();
 }
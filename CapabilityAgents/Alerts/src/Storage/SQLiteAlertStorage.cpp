@@ -141,6 +141,17 @@ static const std::string CREATE_ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_SQL_STRING =
         "asset_play_order_token TEXT NOT NULL);";
 // clang-format on
 
+/// The SQL strings to create the indexes used to look up alerts by token and scheduled time, and their assets by alert.
+// clang-format off
+static const std::vector<std::string> CREATE_INDEXES_SQL_STRINGS = {
+    "CREATE INDEX IF NOT EXISTS alertsTokenIndex ON " + ALERTS_V2_TABLE_NAME + " (token);",
+    "CREATE INDEX IF NOT EXISTS alertsScheduledTimeIndex ON " + ALERTS_V2_TABLE_NAME + " (scheduled_time_unix);",
+    "CREATE INDEX IF NOT EXISTS alertAssetsAlertIdIndex ON " + ALERT_ASSETS_TABLE_NAME + " (alert_id);",
+    "CREATE INDEX IF NOT EXISTS alertAssetPlayOrderItemsAlertIdIndex ON " +
+        ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " (alert_id);"
+};
+// clang-format on
+
 struct AssetOrderItem {
     int index;
     std::string name;
@@ -361,6 +372,28 @@ static bool createAlertAssetPlayOrderItemsTable(SQLiteDatabase* db) {
     return true;
 }
 
+/**
+ * Utility function to create the indexes on the alerts tables, if they do not already exist.
+ *
+ * @param db The SQLiteDatabase object.
+ * @return Whether the indexes were successfully created.
+ */
+static bool createIndexes(SQLiteDatabase* db) {
+    if (!db) {
+        ACSDK_ERROR(LX("createIndexesFailed").m("null db"));
+        return false;
+    }
+
+    for (auto& sqlString : CREATE_INDEXES_SQL_STRINGS) {
+        if (!db->performQuery(sqlString)) {
+            ACSDK_ERROR(LX("createIndexesFailed").m("Index could not be created."));
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool SQLiteAlertStorage::createDatabase() {
     if (!m_db.initialize()) {
         ACSDK_ERROR(LX("createDatabaseFailed"));
@@ -385,6 +418,12 @@ bool SQLiteAlertStorage::createDatabase() {
         return false;
     }
 
+    if (!createIndexes(&m_db)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Indexes could not be created."));
+        close();
+        return false;
+    }
+
     return true;
 }
 
@@ -444,7 +483,26 @@ bool SQLiteAlertStorage::migrateAlertsDbFromV1ToV2() {
 }
 
 bool SQLiteAlertStorage::open() {
-    return m_db.open();
+    if (!m_db.open()) {
+        return false;
+    }
+
+    // Creates any missing tables, which is the case if the database file is shared with other components, and
+    // migrates alerts stored by older versions of the SDK.
+    if (!migrateAlertsDbFromV1ToV2()) {
+        ACSDK_ERROR(LX("openFailed").m("Alerts tables could not be set up."));
+        close();
+        return false;
+    }
+
+    // Databases created by older versions of the SDK do not have the indexes.
+    if (!createIndexes(&m_db)) {
+        ACSDK_ERROR(LX("openFailed").m("Indexes could not be created."));
+        close();
+        return false;
+    }
+
+    return true;
 }
 
 void SQLiteAlertStorage::close() {
@@ -684,8 +742,16 @@ bool SQLiteAlertStorage::store(std::shared_ptr<Alert> alert) {
     return true;
 }
 
-static bool loadAlertAssets(SQLiteDatabase* db, std::map<int, std::vector<Alert::Asset>>* alertAssetsMap) {
-    const std::string sqlString = "SELECT * FROM " + ALERT_ASSETS_TABLE_NAME + ";";
+/**
+ * Utility function to load the assets of a single alert.
+ *
+ * @param db The SQLiteDatabase object.
+ * @param alertId The database id of the alert.
+ * @param[out] assets The container where the assets should be stored.
+ * @return Whether the assets were successfully loaded.
+ */
+static bool loadAlertAssets(SQLiteDatabase* db, int alertId, std::vector<Alert::Asset>* assets) {
+    const std::string sqlString = "SELECT avs_id, url FROM " + ALERT_ASSETS_TABLE_NAME + " WHERE alert_id=?;";
 
     auto statement = db->createStatement(sqlString);
 
@@ -694,31 +760,22 @@ static bool loadAlertAssets(SQLiteDatabase* db, std::map<int, std::vector<Alert:
         return false;
     }
 
-    int alertId = 0;
-    std::string avsId;
-    std::string url;
+    int boundParam = 1;
+    if (!statement->bindIntParameter(boundParam, alertId)) {
+        ACSDK_ERROR(LX("loadAlertAssetsFailed").m("Could not bind a parameter."));
+        return false;
+    }
 
     if (!statement->step()) {
         ACSDK_ERROR(LX("loadAlertAssetsFailed").m("Could not perform step."));
         return false;
     }
 
+    const int AVS_ID_COLUMN_POSITION = 0;
+    const int URL_COLUMN_POSITION = 1;
     while (SQLITE_ROW == statement->getStepResult()) {
-        int numberColumns = statement->getColumnCount();
-
-        for (int i = 0; i < numberColumns; i++) {
-            std::string columnName = statement->getColumnName(i);
-
-            if ("alert_id" == columnName) {
-                alertId = statement->getColumnInt(i);
-            } else if ("avs_id" == columnName) {
-                avsId = statement->getColumnText(i);
-            } else if ("url" == columnName) {
-                url = statement->getColumnText(i);
-            }
-        }
-
-        (*alertAssetsMap)[alertId].push_back(Alert::Asset(avsId, url));
+        assets->push_back(Alert::Asset(
+            statement->getColumnText(AVS_ID_COLUMN_POSITION), statement->getColumnText(URL_COLUMN_POSITION)));
 
         statement->step();
     }
@@ -726,10 +783,20 @@ static bool loadAlertAssets(SQLiteDatabase* db, std::map<int, std::vector<Alert:
     return true;
 }
 
+/**
+ * Utility function to load the asset play order items of a single alert.
+ *
+ * @param db The SQLiteDatabase object.
+ * @param alertId The database id of the alert.
+ * @param[out] assetOrderItems The container where the asset play order items should be stored.
+ * @return Whether the asset play order items were successfully loaded.
+ */
 static bool loadAlertAssetPlayOrderItems(
     SQLiteDatabase* db,
-    std::map<int, std::set<AssetOrderItem, AssetOrderItemCompare>>* alertAssetOrderItemsMap) {
-    const std::string sqlString = "SELECT * FROM " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + ";";
+    int alertId,
+    std::set<AssetOrderItem, AssetOrderItemCompare>* assetOrderItems) {
+    const std::string sqlString = "SELECT asset_play_order_position, asset_play_order_token FROM " +
+                                  ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " WHERE alert_id=?;";
 
     auto statement = db->createStatement(sqlString);
 
@@ -738,31 +805,23 @@ static bool loadAlertAssetPlayOrderItems(
         return false;
     }
 
-    int alertId = 0;
-    int playOrderPosition = 0;
-    std::string playOrderToken;
+    int boundParam = 1;
+    if (!statement->bindIntParameter(boundParam, alertId)) {
+        ACSDK_ERROR(LX("loadAlertAssetPlayOrderItemsFailed").m("Could not bind a parameter."));
+        return false;
+    }
 
     if (!statement->step()) {
         ACSDK_ERROR(LX("loadAlertAssetPlayOrderItemsFailed").m("Could not perform step."));
         return false;
     }
 
+    const int POSITION_COLUMN_POSITION = 0;
+    const int TOKEN_COLUMN_POSITION = 1;
     while (SQLITE_ROW == statement->getStepResult()) {
-        int numberColumns = statement->getColumnCount();
-
-        for (int i = 0; i < numberColumns; i++) {
-            std::string columnName = statement->getColumnName(i);
-
-            if ("alert_id" == columnName) {
-                alertId = statement->getColumnInt(i);
-            } else if ("asset_play_order_position" == columnName) {
-                playOrderPosition = statement->getColumnInt(i);
-            } else if ("asset_play_order_token" == columnName) {
-                playOrderToken = statement->getColumnText(i);
-            }
-        }
-
-        (*alertAssetOrderItemsMap)[alertId].insert(AssetOrderItem{playOrderPosition, playOrderToken});
+        int playOrderPosition = statement->getColumnInt(POSITION_COLUMN_POSITION);
+        std::string playOrderToken = statement->getColumnText(TOKEN_COLUMN_POSITION);
+        assetOrderItems->insert(AssetOrderItem{playOrderPosition, playOrderToken});
 
         statement->step();
     }
@@ -869,36 +928,42 @@ bool SQLiteAlertStorage::loadHelper(int dbVersion, std::vector<std::shared_ptr<A
 
     statement->finalize();
 
-    std::map<int, std::vector<Alert::Asset>> alertAssetsMap;
-    if (!loadAlertAssets(&m_db, &alertAssetsMap)) {
-        ACSDK_ERROR(LX("loadHelperFailed").m("Could not load alert assets."));
+    return true;
+}
+
+bool SQLiteAlertStorage::load(std::vector<std::shared_ptr<Alert>>* alertContainer) {
+    return loadHelper(ALERTS_DATABASE_VERSION_TWO, alertContainer);
+}
+
+bool SQLiteAlertStorage::loadAssets(std::shared_ptr<Alert> alert) {
+    if (!alert) {
+        ACSDK_ERROR(LX("loadAssetsFailed").m("Alert parameter is nullptr."));
         return false;
     }
 
-    std::map<int, std::set<AssetOrderItem, AssetOrderItemCompare>> alertAssetOrderItemsMap;
-    if (!loadAlertAssetPlayOrderItems(&m_db, &alertAssetOrderItemsMap)) {
-        ACSDK_ERROR(LX("loadHelperFailed").m("Could not load alert asset play order items."));
+    std::vector<Alert::Asset> assets;
+    if (!loadAlertAssets(&m_db, alert->m_dbId, &assets)) {
+        ACSDK_ERROR(LX("loadAssetsFailed").m("Could not load alert assets."));
         return false;
     }
 
-    for (auto alert : *alertContainer) {
-        if (alertAssetsMap.find(alert->m_dbId) != alertAssetsMap.end()) {
-            for (auto& mapEntry : alertAssetsMap[alert->m_dbId]) {
-                alert->m_assetConfiguration.assets[mapEntry.id] = mapEntry;
-            }
-        }
-        if (alertAssetOrderItemsMap.find(alert->m_dbId) != alertAssetOrderItemsMap.end()) {
-            for (auto& mapEntry : alertAssetOrderItemsMap[alert->m_dbId]) {
-                alert->m_assetConfiguration.assetPlayOrderItems.push_back(mapEntry.name);
-            }
-        }
+    std::set<AssetOrderItem, AssetOrderItemCompare> assetOrderItems;
+    if (!loadAlertAssetPlayOrderItems(&m_db, alert->m_dbId, &assetOrderItems)) {
+        ACSDK_ERROR(LX("loadAssetsFailed").m("Could not load alert asset play order items."));
+        return false;
     }
 
-    return true;
-}
+    std::lock_guard<std::mutex> lock(alert->m_mutex);
+    alert->m_assetConfiguration.assets.clear();
+    for (auto& asset : assets) {
+        alert->m_assetConfiguration.assets[asset.id] = asset;
+    }
+    alert->m_assetConfiguration.assetPlayOrderItems.clear();
+    for (auto& item : assetOrderItems) {
+        alert->m_assetConfiguration.assetPlayOrderItems.push_back(item.name);
+    }
 
-bool SQLiteAlertStorage::load(std::vector<std::shared_ptr<Alert>>* alertContainer) {
-    return loadHelper(ALERTS_DATABASE_VERSION_TWO, alertContainer);
+    return true;
 }
 
 bool SQLiteAlertStorage::modify(std::shared_ptr<Alert> alert) {
@@ -13,6 +13,10 @@
  * permissions and limitations under the License.
  */
 
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -144,6 +148,15 @@ public:
         }
         return m_loadRetVal;
     }
+    bool loadAssets(std::shared_ptr<Alert> alert) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loadAssetsCalls.push_back({alert->getToken(), alert->getState()});
+        return m_loadRetVal;
+    }
+    std::vector<std::pair<std::string, Alert::State>> getLoadAssetsCalls() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_loadAssetsCalls;
+    }
     bool erase(const std::vector<int>& alertDbIds) {
         return m_eraseRetVal;
     }
@@ -181,6 +194,10 @@ public:
 
 private:
     std::vector<std::shared_ptr<Alert>> m_alertsInStorage;
+    /// Serializes access to @c m_loadAssetsCalls.
+    std::mutex m_mutex;
+    /// The token of each alert @c loadAssets was called for, and the state the alert was in at the time.
+    std::vector<std::pair<std::string, Alert::State>> m_loadAssetsCalls;
     bool m_createDatabaseRetVal;
     bool m_openRetVal;
     bool m_isOpenRetVal;
@@ -333,6 +350,23 @@ TEST_F(AlertSchedulerTest, updateGetFocus) {
     ASSERT_EQ(alert->getState(), Alert::State::STOPPING);
 }
 
+/**
+ * Test that the assets of an alert are loaded from storage when it is activated, before it starts rendering, and
+ * not when the alerts are loaded.
+ */
+TEST_F(AlertSchedulerTest, loadAssetsBeforeActivation) {
+    std::shared_ptr<TestAlert> alert = doSimpleTestSetup();
+    ASSERT_TRUE(m_alertStorage->getLoadAssetsCalls().empty());
+
+    m_alertScheduler->updateFocus(avsCommon::avs::FocusState::FOREGROUND);
+    auto calls = m_alertStorage->getLoadAssetsCalls();
+    ASSERT_EQ(1u, calls.size());
+    EXPECT_EQ(ALERT1_TOKEN, calls[0].first);
+    EXPECT_NE(Alert::State::ACTIVATING, calls[0].second);
+    EXPECT_NE(Alert::State::ACTIVE, calls[0].second);
+    EXPECT_EQ(Alert::State::ACTIVATING, alert->getState());
+}
+
 /**
  * Test scheduling alerts
  */
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SQLiteAlertStorageTest.cpp
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/SDKInterfaces/Audio/AlertsAudioFactoryInterface.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+
+#include "Alerts/Alarm.h"
+#include "Alerts/Storage/SQLiteAlertStorage.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace storage {
+namespace test {
+
+using namespace avsCommon::sdkInterfaces::audio;
+using namespace avsCommon::utils::configuration;
+
+/// A schedule instant in the future for alerts.
+static const std::string FUTURE_INSTANT = "2030-01-01T12:34:56+0000";
+
+/// The template of the database file, which mkstemp() fills in.
+static const std::string DB_FILE_TEMPLATE = "/tmp/SQLiteAlertStorageTest-XXXXXX";
+
+/// Audio factories for the alerts the storage loads.
+class TestAlertsAudioFactory : public AlertsAudioFactoryInterface {
+public:
+    std::function<std::unique_ptr<std::istream>()> alarmDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> alarmShort() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> timerDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> timerShort() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> reminderDefault() const override {
+        return audio;
+    }
+    std::function<std::unique_ptr<std::istream>()> reminderShort() const override {
+        return audio;
+    }
+
+private:
+    /// Produces the audio of every alert.
+    static std::unique_ptr<std::istream> audio() {
+        return std::unique_ptr<std::stringstream>(new std::stringstream("audio"));
+    }
+};
+
+/// Test harness for @c SQLiteAlertStorage.
+class SQLiteAlertStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /**
+     * Creates a storage object over the test database.
+     *
+     * @return The storage.
+     */
+    std::unique_ptr<SQLiteAlertStorage> createStorage();
+
+    /**
+     * Creates an alarm with custom assets.
+     *
+     * @param token The token of the alarm.
+     * @return The alarm.
+     */
+    std::shared_ptr<Alarm> createAlarmWithAssets(const std::string& token);
+
+    /// The path of the test database.
+    std::string m_dbFilePath;
+
+    /// The audio factories.
+    std::shared_ptr<TestAlertsAudioFactory> m_audioFactory;
+};
+
+void SQLiteAlertStorageTest::SetUp() {
+    std::vector<char> path(DB_FILE_TEMPLATE.begin(), DB_FILE_TEMPLATE.end());
+    path.push_back('\0');
+    int fd = mkstemp(path.data());
+    ASSERT_GE(fd, 0);
+    close(fd);
+    m_dbFilePath = path.data();
+    // The storage creates the database, so only the unique name is kept.
+    std::remove(m_dbFilePath.c_str());
+
+    std::stringstream config;
+    config << "{\"alertsCapabilityAgent\":{\"databaseFilePath\":\"" << m_dbFilePath << "\"}}";
+    ConfigurationNode::uninitialize();
+    ASSERT_TRUE(ConfigurationNode::initialize({&config}));
+    m_audioFactory = std::make_shared<TestAlertsAudioFactory>();
+}
+
+void SQLiteAlertStorageTest::TearDown() {
+    ConfigurationNode::uninitialize();
+    std::remove(m_dbFilePath.c_str());
+}
+
+std::unique_ptr<SQLiteAlertStorage> SQLiteAlertStorageTest::createStorage() {
+    return SQLiteAlertStorage::create(ConfigurationNode::getRoot(), m_audioFactory);
+}
+
+std::shared_ptr<Alarm> SQLiteAlertStorageTest::createAlarmWithAssets(const std::string& token) {
+    auto alarm = std::make_shared<Alarm>(m_audioFactory->alarmDefault(), m_audioFactory->alarmShort());
+    // clang-format off
+    const std::string payloadJson =
+        "{"
+            "\"token\":\"" + token + "\","
+            "\"type\":\"ALARM\","
+            "\"scheduledTime\":\"" + FUTURE_INSTANT + "\","
+            "\"assets\":["
+                "{\"assetId\":\"first\",\"url\":\"https://example.com/first.mp3\"},"
+                "{\"assetId\":\"second\",\"url\":\"https://example.com/second.mp3\"}"
+            "],"
+            "\"assetPlayOrder\":[\"second\",\"first\",\"second\"],"
+            "\"backgroundAlertAsset\":\"first\","
+            "\"loopCount\":2,"
+            "\"loopPauseInMilliSeconds\":300"
+        "}";
+    // clang-format on
+    rapidjson::Document payload;
+    payload.Parse(payloadJson);
+    std::string errorMessage;
+    EXPECT_EQ(Alert::ParseFromJsonStatus::OK, alarm->parseFromJson(payload, &errorMessage));
+    return alarm;
+}
+
+/// Test that load() leaves out the assets of the alerts, and loadAssets() reads them back for one alert.
+TEST_F(SQLiteAlertStorageTest, loadAssetsAfterReload) {
+    auto storage = createStorage();
+    ASSERT_TRUE(storage);
+    ASSERT_TRUE(storage->createDatabase());
+    auto stored = createAlarmWithAssets("token1");
+    ASSERT_TRUE(storage->store(stored));
+    ASSERT_TRUE(storage->store(createAlarmWithAssets("token2")));
+    storage.reset();
+
+    storage = createStorage();
+    ASSERT_TRUE(storage);
+    ASSERT_TRUE(storage->open());
+    std::vector<std::shared_ptr<Alert>> alerts;
+    ASSERT_TRUE(storage->load(&alerts));
+    ASSERT_EQ(2u, alerts.size());
+    std::shared_ptr<Alert> loaded;
+    for (auto& alert : alerts) {
+        EXPECT_TRUE(alert->getAssetConfiguration().assets.empty());
+        EXPECT_TRUE(alert->getAssetConfiguration().assetPlayOrderItems.empty());
+        if ("token1" == alert->getToken()) {
+            loaded = alert;
+        }
+    }
+    ASSERT_TRUE(loaded);
+
+    ASSERT_TRUE(storage->loadAssets(loaded));
+    auto expected = stored->getAssetConfiguration();
+    auto actual = loaded->getAssetConfiguration();
+    ASSERT_EQ(expected.assets.size(), actual.assets.size());
+    for (auto& asset : expected.assets) {
+        ASSERT_EQ(1u, actual.assets.count(asset.first));
+        EXPECT_EQ(asset.second.url, actual.assets[asset.first].url);
+    }
+    EXPECT_EQ(expected.assetPlayOrderItems, actual.assetPlayOrderItems);
+    EXPECT_EQ(expected.backgroundAssetId, actual.backgroundAssetId);
+    EXPECT_EQ(expected.loopCount, actual.loopCount);
+    EXPECT_EQ(expected.loopPause, actual.loopPause);
+}
+
+/// Test that loadAssets() rejects a missing alert, and gives an alert with no stored assets none.
+TEST_F(SQLiteAlertStorageTest, loadAssetsOfAlertWithoutAssets) {
+    auto storage = createStorage();
+    ASSERT_TRUE(storage);
+    ASSERT_TRUE(storage->createDatabase());
+    EXPECT_FALSE(storage->loadAssets(nullptr));
+
+    auto alarm = std::make_shared<Alarm>(m_audioFactory->alarmDefault(), m_audioFactory->alarmShort());
+    rapidjson::Document payload;
+    payload.Parse("{\"token\":\"token3\",\"type\":\"ALARM\",\"scheduledTime\":\"" + FUTURE_INSTANT + "\"}");
+    std::string errorMessage;
+    ASSERT_EQ(Alert::ParseFromJsonStatus::OK, alarm->parseFromJson(payload, &errorMessage));
+    ASSERT_TRUE(storage->store(alarm));
+    ASSERT_TRUE(storage->loadAssets(alarm));
+    EXPECT_TRUE(alarm->getAssetConfiguration().assets.empty());
+}
+
+}  // namespace test
+}  // namespace storage
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
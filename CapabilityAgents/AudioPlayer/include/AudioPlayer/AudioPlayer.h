@@ -100,6 +100,7 @@ public:
     void onPlaybackStarted(SourceId id) override;
     void onPlaybackStopped(SourceId id) override;
     void onPlaybackFinished(SourceId id) override;
+    void onPlaybackNearlyFinished(SourceId id) override;
     void onPlaybackError(SourceId id, const avsCommon::utils::mediaPlayer::ErrorType& type, std::string error) override;
     void onPlaybackPaused(SourceId id) override;
     void onPlaybackResumed(SourceId id) override;
@@ -227,6 +228,9 @@ private:
     /// @copydoc onPlaybackFinished()
     void executeOnPlaybackFinished(SourceId id);
 
+    /// @copydoc onPlaybackNearlyFinished()
+    void executeOnPlaybackNearlyFinished(SourceId id);
+
     /// Performs necessary cleanup when playback has finished/stopped.
     void handlePlaybackCompleted();
 
@@ -262,6 +266,13 @@ private:
     /// This fuction plays the next @c AudioItem in the queue.
     void playNextItem();
 
+    /**
+     * This function asks the @c MediaPlayer to prepare the next @c AudioItem in the queue, so that it starts without a
+     * gap when the current one finishes.  It does nothing until the current item is nearly finished, or if the next
+     * item is not a url or has already been prepared.
+     */
+    void prepareNextItem();
+
     /**
      * This function stops playback of the current song, and optionally starts the next queued song.
      *
@@ -461,6 +472,16 @@ private:
      */
     bool m_isStopCalled;
 
+    /**
+     * A flag which is set when the current @c AudioItem is nearly finished, and cleared when the next one starts.  It
+     * is used to send the @c PlaybackNearlyFinished event only once per item, and to decide whether to prepare the
+     * next queued item.
+     */
+    bool m_isNearlyFinished;
+
+    /// The AudioItemId of the queued @c AudioItem the @c MediaPlayer has been asked to prepare, if any.
+    std::string m_preparedAudioItemId;
+
     /// @}
 
     /**
@@ -263,6 +263,11 @@ void AudioPlayer::onPlaybackFinished(SourceId id) {
     m_executor.submit([this, id] { executeOnPlaybackFinished(id); });
 }
 
+void AudioPlayer::onPlaybackNearlyFinished(SourceId id) {
+    ACSDK_DEBUG(LX("onPlaybackNearlyFinished").d("id", id));
+    m_executor.submit([this, id] { executeOnPlaybackNearlyFinished(id); });
+}
+
 void AudioPlayer::onPlaybackError(SourceId id, const ErrorType& type, std::string error) {
     ACSDK_DEBUG(LX("onPlaybackError").d("type", type).d("error", error).d("id", id));
     m_executor.submit([this, id, type, error] { executeOnPlaybackError(id, type, error); });
@@ -349,7 +354,8 @@ AudioPlayer::AudioPlayer(
         m_initialOffset{0},
         m_sourceId{MediaPlayerInterface::ERROR},
         m_offset{std::chrono::milliseconds{std::chrono::milliseconds::zero()}},
-        m_isStopCalled{false} {
+        m_isStopCalled{false},
+        m_isNearlyFinished{false} {
 }
 
 void AudioPlayer::doShutdown() {
@@ -766,11 +772,13 @@ void AudioPlayer::executeOnPlaybackFinished(SourceId id) {
              * we are playing Audible such that after sending PlaybackNearlyFinished, AVS will send us the next item to
              * start buffering.  But since we don't actually access the url until we finish playing the current chapter,
              * by the time we open the url, the url has already expired so we got a 403 reponse. To address this
-             * problem, we are sending the PlaybackNearlyFinished event just before we send PlaybackFinished.
-             *
-             * TODO: Once MediaPlayer can notify of nearly finished, send there instead (ACSDK-417).
+             * problem, the event is sent when the MediaPlayer reports that the item is nearly finished, and the next
+             * item is prepared right away.  MediaPlayers which cannot tell, such as for sources of unknown duration,
+             * get the event just before PlaybackFinished.
              */
-            sendPlaybackNearlyFinishedEvent();
+            if (!m_isNearlyFinished) {
+                sendPlaybackNearlyFinishedEvent();
+            }
 
             sendPlaybackFinishedEvent();
             if (m_audioItems.empty()) {
@@ -794,6 +802,41 @@ void AudioPlayer::executeOnPlaybackFinished(SourceId id) {
                     .d("m_currentActivity", m_currentActivity));
 }
 
+void AudioPlayer::executeOnPlaybackNearlyFinished(SourceId id) {
+    ACSDK_DEBUG1(LX("executeOnPlaybackNearlyFinished").d("id", id));
+
+    if (id != m_sourceId) {
+        ACSDK_ERROR(LX("executeOnPlaybackNearlyFinishedFailed")
+                        .d("reason", "invalidSourceId")
+                        .d("id", id)
+                        .d("m_sourceId", m_sourceId));
+        return;
+    }
+
+    switch (m_currentActivity) {
+        case PlayerActivity::PLAYING:
+        case PlayerActivity::BUFFER_UNDERRUN:
+            if (m_isNearlyFinished) {
+                return;
+            }
+            m_isNearlyFinished = true;
+            sendPlaybackNearlyFinishedEvent();
+            prepareNextItem();
+            return;
+        case PlayerActivity::IDLE:
+        case PlayerActivity::STOPPED:
+        case PlayerActivity::PAUSED:
+        case PlayerActivity::FINISHED:
+            ACSDK_ERROR(LX("executeOnPlaybackNearlyFinishedFailed")
+                            .d("reason", "notPlaying")
+                            .d("m_currentActivity", m_currentActivity));
+            return;
+    }
+    ACSDK_ERROR(LX("executeOnPlaybackNearlyFinishedFailed")
+                    .d("reason", "unexpectedActivity")
+                    .d("m_currentActivity", m_currentActivity));
+}
+
 void AudioPlayer::cancelTimers() {
     ACSDK_DEBUG(LX("cancelTimers"));
     m_delayTimer.stop();
@@ -934,6 +977,8 @@ void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioI
         ACSDK_ERROR(LX("executePlayFailed").d("reason", "unhandledPlayBehavior").d("playBehavior", playBehavior));
         return;
     }
+    // The next item typically arrives in response to PlaybackNearlyFinished, so prepare it as soon as it does.
+    prepareNextItem();
 
     // Initiate playback if not already playing.
     switch (m_currentActivity) {
@@ -977,6 +1022,8 @@ void AudioPlayer::playNextItem() {
 
     auto item = m_audioItems.front();
     m_audioItems.pop_front();
+    m_isNearlyFinished = false;
+    m_preparedAudioItemId.clear();
     m_token = item.stream.token;
     m_audioItemId = item.id;
     m_initialOffset = item.stream.offset;
@@ -1029,6 +1076,23 @@ void AudioPlayer::playNextItem() {
     }
 }
 
+void AudioPlayer::prepareNextItem() {
+    if (!m_isNearlyFinished || m_audioItems.empty()) {
+        return;
+    }
+    auto& item = m_audioItems.front();
+    if (item.stream.reader || item.id == m_preparedAudioItemId) {
+        return;
+    }
+    ACSDK_DEBUG1(LX("prepareNextItem").d("audioItemId", item.id));
+    if (m_mediaPlayer->prepareNextSource(item.stream.url, item.stream.offset)) {
+        m_preparedAudioItemId = item.id;
+    } else {
+        // Not supported by the MediaPlayer, so the url will be fetched when the item is played.
+        ACSDK_DEBUG9(LX("prepareNextItemSkipped").d("reason", "prepareNextSourceFailed"));
+    }
+}
+
 void AudioPlayer::executeStop(bool playNextItem) {
     ACSDK_DEBUG1(LX("executeStop").d("playNextItem", playNextItem).d("m_currentActivity", m_currentActivity));
     switch (m_currentActivity) {
@@ -110,6 +110,9 @@ static const std::string FORMAT_TEST("AUDIO_MPEG");
 /// URL for testing.
 static const std::string URL_TEST("cid:Test");
 
+/// A URL which is not an attachment, for testing.
+static const std::string REMOTE_URL_TEST("https://example.com/next.mp3");
+
 /// ENQUEUE playBehavior.
 static const std::string NAME_ENQUEUE("ENQUEUE");
 
@@ -189,6 +192,29 @@ static std::string createEnqueuePayloadTest(long offsetInMilliseconds) {
     return ENQUEUE_PAYLOAD_TEST;
 }
 
+// clang-format off
+/// ENQUEUE payload of a second, remote @c AudioItem for testing.
+static const std::string ENQUEUE_REMOTE_PAYLOAD_TEST =
+"{"
+    "\"playBehavior\":\"" + NAME_ENQUEUE + "\","
+    "\"audioItem\": {"
+        "\"audioItemId\":\"" + AUDIO_ITEM_ID_2 + "\","
+        "\"stream\": {"
+            "\"url\":\"" + REMOTE_URL_TEST + "\","
+            "\"streamFormat\":\"" + FORMAT_TEST + "\","
+            "\"offsetInMilliseconds\":" + std::to_string(OFFSET_IN_MILLISECONDS_TEST) + ","
+            "\"expiryTime\":\"" + EXPIRY_TEST + "\","
+            "\"progressReport\": {"
+                "\"progressReportDelayInMilliseconds\":" + std::to_string(PROGRESS_REPORT_DELAY) + ","
+                "\"progressReportIntervalInMilliseconds\":" + std::to_string(PROGRESS_REPORT_INTERVAL) +
+            "},"
+            "\"token\":\"" + TOKEN_TEST + "\","
+            "\"expectedPreviousToken\":\"\""
+        "}"
+    "}"
+"}";
+// clang-format on
+
 // clang-format off
 static const std::string REPLACE_ALL_PAYLOAD_TEST =
 "{"
@@ -1093,6 +1119,85 @@ TEST_F(AudioPlayerTest, testOnPlaybackFinished) {
     ASSERT_TRUE(result);
 }
 
+/**
+ * Test that @c onPlaybackNearlyFinished sends a single PLAYBACK_NEARLY_FINISHED_NAME message, and that the next
+ * remote @c AudioItem is prepared as soon as it is queued.
+ */
+
+TEST_F(AudioPlayerTest, testOnPlaybackNearlyFinishedPreparesNextItem) {
+    m_expectedMessages.insert({PLAYBACK_NEARLY_FINISHED_NAME, 0});
+    m_expectedMessages.insert({PLAYBACK_FINISHED_NAME, 0});
+
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke([this](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            verifyMessageMap(request, &m_expectedMessages);
+            m_messageSentTrigger.notify_one();
+        }));
+
+    std::promise<void> preparedPromise;
+    auto preparedFuture = preparedPromise.get_future();
+    EXPECT_CALL(
+        *(m_mockMediaPlayer.get()),
+        prepareNextSource(REMOTE_URL_TEST, std::chrono::milliseconds(OFFSET_IN_MILLISECONDS_TEST)))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([&preparedPromise] {
+            preparedPromise.set_value();
+            return true;
+        }));
+
+    sendPlayDirective();
+    auto sourceId = m_mockMediaPlayer->getCurrentSourceId();
+    m_audioPlayer->onPlaybackNearlyFinished(sourceId);
+    m_audioPlayer->onPlaybackNearlyFinished(sourceId);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ASSERT_TRUE(m_messageSentTrigger.wait_for(
+            lock, WAIT_TIMEOUT, [this] { return m_expectedMessages[PLAYBACK_NEARLY_FINISHED_NAME] > 0; }));
+    }
+
+    // AVS answers PlaybackNearlyFinished with the next item, which should be prepared right away.
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST_2);
+    std::shared_ptr<AVSDirective> playDirective = AVSDirective::create(
+        "", avsMessageHeader, ENQUEUE_REMOTE_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    auto directiveHandlerResult = std::unique_ptr<MockDirectiveHandlerResult>(new MockDirectiveHandlerResult);
+    m_audioPlayer->CapabilityAgent::preHandleDirective(playDirective, std::move(directiveHandlerResult));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_EQ(std::future_status::ready, preparedFuture.wait_for(WAIT_TIMEOUT));
+
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), urlSetSource(REMOTE_URL_TEST)).Times(1);
+    m_audioPlayer->onPlaybackFinished(sourceId);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ASSERT_TRUE(m_messageSentTrigger.wait_for(
+        lock, WAIT_TIMEOUT, [this] { return m_expectedMessages[PLAYBACK_FINISHED_NAME] > 0; }));
+    EXPECT_EQ(1, m_expectedMessages[PLAYBACK_NEARLY_FINISHED_NAME]);
+}
+
+/**
+ * Test that without an @c onPlaybackNearlyFinished notification, the next @c AudioItem is not prepared.
+ */
+
+TEST_F(AudioPlayerTest, testNextItemNotPreparedBeforeNearlyFinished) {
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), prepareNextSource(_, _)).Times(0);
+
+    sendPlayDirective();
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST_2);
+    std::shared_ptr<AVSDirective> playDirective = AVSDirective::create(
+        "", avsMessageHeader, ENQUEUE_REMOTE_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    std::promise<void> completedPromise;
+    auto completedFuture = completedPromise.get_future();
+    auto directiveHandlerResult = std::unique_ptr<MockDirectiveHandlerResult>(new MockDirectiveHandlerResult);
+    EXPECT_CALL(*directiveHandlerResult, setCompleted())
+        .WillOnce(InvokeWithoutArgs([&completedPromise] { completedPromise.set_value(); }));
+    m_audioPlayer->CapabilityAgent::preHandleDirective(playDirective, std::move(directiveHandlerResult));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_EQ(std::future_status::ready, completedFuture.wait_for(WAIT_TIMEOUT));
+}
+
 /**
  * Test @c onBufferUnderrun and expect a PlaybackStutterStarted message
  */
@@ -131,15 +131,21 @@ bool SQLiteNotificationsStorage::open() {
         return false;
     }
 
-    if (!m_database.tableExists(NOTIFICATION_INDICATOR_TABLE_NAME)) {
-        ACSDK_ERROR(
-            LX("openFailed").d("reason", "table doesn't exist").d("TableName", NOTIFICATION_INDICATOR_TABLE_NAME));
+    // The database file may be shared with other components, in which case our tables may not exist yet.
+    if (!m_database.tableExists(NOTIFICATION_INDICATOR_TABLE_NAME) &&
+        !m_database.performQuery(CREATE_NOTIFICATION_INDICATOR_TABLE_SQL_STRING)) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "failed to create notification indicator table"));
+        close();
         return false;
     }
 
     if (!m_database.tableExists(INDICATOR_STATE_NAME)) {
-        ACSDK_ERROR(LX("openFailed").d("reason", "table doesn't exist").d("TableName", INDICATOR_STATE_NAME));
-        return false;
+        if (!m_database.performQuery(CREATE_INDICATOR_STATE_TABLE_SQL_STRING) ||
+            !setIndicatorState(IndicatorState::OFF)) {
+            ACSDK_ERROR(LX("openFailed").d("reason", "failed to create indicator state table"));
+            close();
+            return false;
+        }
     }
 
     return true;
@@ -93,7 +93,18 @@ bool SQLiteSettingStorage::createDatabase() {
 }
 
 bool SQLiteSettingStorage::open() {
-    return m_database.open();
+    if (!m_database.open()) {
+        return false;
+    }
+
+    // The database file may be shared with other components, in which case the settings table may not exist yet.
+    if (!m_database.tableExists(SETTINGS_TABLE_NAME) && !m_database.performQuery(CREATE_SETTINGS_TABLE_SQL_STRING)) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "PerformQueryFailed"));
+        close();
+        return false;
+    }
+
+    return true;
 }
 
 void SQLiteSettingStorage::close() {
@@ -34,6 +34,7 @@
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h>
+#include <AVSCommon/Utils/Timing/LatencyTrace.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
@@ -124,6 +125,8 @@ public:
 
     void onPlaybackStopped(SourceId id) override;
 
+    void onFirstBufferRendered(SourceId id, std::chrono::milliseconds latency) override;
+
 private:
     /**
      * This class has all the data that is needed to process @c Speak directives.
@@ -263,6 +266,15 @@ private:
      */
     void executePlaybackStarted();
 
+    /**
+     * Handle (on the @c m_executor thread) notification that the first buffer of speech has been rendered, by tracing
+     * it under the dialogRequestId of the current Speak directive.
+     *
+     * @param id The id of the source whose first buffer was rendered.
+     * @param time The time at which the buffer was rendered.
+     */
+    void executeFirstBufferRendered(SourceId id, avsCommon::utils::timing::LatencyTrace::Clock::time_point time);
+
     /**
      * Handle (on the @c m_executor thread) notification that speech playback has finished.
      */
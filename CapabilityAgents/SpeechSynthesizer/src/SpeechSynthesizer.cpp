@@ -246,6 +246,12 @@ void SpeechSynthesizer::onPlaybackStarted(SourceId id) {
     }
 }
 
+void SpeechSynthesizer::onFirstBufferRendered(SourceId id, std::chrono::milliseconds latency) {
+    ACSDK_DEBUG9(LX("onFirstBufferRendered").d("callbackSourceId", id).d("latencyInMilliseconds", latency.count()));
+    auto renderedTime = timing::LatencyTrace::Clock::now();
+    m_executor.submit([this, id, renderedTime] { executeFirstBufferRendered(id, renderedTime); });
+}
+
 void SpeechSynthesizer::onPlaybackFinished(SourceId id) {
     ACSDK_DEBUG9(LX("onPlaybackFinished").d("callbackSourceId", id));
     ACSDK_METRIC_IDS(TAG, "SpeechFinished", "", "", Metrics::Location::SPEECH_SYNTHESIZER_RECEIVE);
@@ -465,6 +471,8 @@ void SpeechSynthesizer::executeHandle(std::shared_ptr<DirectiveInfo> info) {
         ACSDK_ERROR(LX("executeHandleFailed").d("reason", "invalidDirectiveInfo"));
         return;
     }
+    timing::LatencyTrace::getInstance().record(
+        timing::LatencyTrace::Point::SPEAK_HANDLED, speakInfo->directive->getDialogRequestId());
     addToDirectiveQueue(speakInfo);
 }
 
@@ -602,6 +610,18 @@ void SpeechSynthesizer::executePlaybackStarted() {
     }
 }
 
+void SpeechSynthesizer::executeFirstBufferRendered(SourceId id, timing::LatencyTrace::Clock::time_point time) {
+    ACSDK_DEBUG9(LX("executeFirstBufferRendered").d("callbackSourceId", id));
+    if (id != m_mediaSourceId || !m_currentInfo) {
+        ACSDK_DEBUG9(LX("executeFirstBufferRenderedIgnored")
+                         .d("reason", "notCurrentSource")
+                         .d("sourceId", m_mediaSourceId));
+        return;
+    }
+    timing::LatencyTrace::getInstance().record(
+        timing::LatencyTrace::Point::FIRST_BUFFER_RENDERED, m_currentInfo->directive->getDialogRequestId(), time);
+}
+
 void SpeechSynthesizer::executePlaybackFinished() {
     ACSDK_DEBUG(LX("executePlaybackFinished"));
     if (!m_currentInfo) {
@@ -711,6 +731,8 @@ std::string SpeechSynthesizer::buildPayload(std::string& token) {
 
 void SpeechSynthesizer::startPlaying() {
     ACSDK_DEBUG9(LX("startPlaying"));
+    timing::LatencyTrace::getInstance().record(
+        timing::LatencyTrace::Point::SET_SOURCE, m_currentInfo->directive->getDialogRequestId());
     m_mediaSourceId = m_speechPlayer->setSource(std::move(m_currentInfo->attachmentReader));
     if (MediaPlayerInterface::ERROR == m_mediaSourceId) {
         ACSDK_ERROR(LX("startPlayingFailed").d("reason", "setSourceFailed"));
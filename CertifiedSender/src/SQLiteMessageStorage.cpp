@@ -102,7 +102,18 @@ bool SQLiteMessageStorage::createDatabase() {
 }
 
 bool SQLiteMessageStorage::open() {
-    return m_database.open();
+    if (!m_database.open()) {
+        return false;
+    }
+
+    // The database file may be shared with other components, in which case the messages table may not exist yet.
+    if (!m_database.tableExists(MESSAGES_TABLE_NAME) && !m_database.performQuery(CREATE_MESSAGES_TABLE_SQL_STRING)) {
+        ACSDK_ERROR(LX("openFailed").m("Table could not be created."));
+        close();
+        return false;
+    }
+
+    return true;
 }
 
 void SQLiteMessageStorage::close() {
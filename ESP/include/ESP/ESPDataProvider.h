@@ -31,18 +31,31 @@ namespace alexaClientSDK {
 namespace esp {
 
 /**
- * The ESPDataProvider is used to connect the sample app with the ESP library. When enabled, the ESPDataProvider object
- * feeds the ESP Library constantly using its own thread.
+ * The ESPDataProvider is used to connect the sample app with the ESP library.  In @c Mode::CONTINUOUS, the
+ * ESPDataProvider object feeds the ESP Library constantly using its own thread.  In @c Mode::ON_DEMAND, it does no work
+ * until a wake word is detected, and then feeds the ESP library the wake word and the audio before it, which the stream
+ * still holds.
  */
 class ESPDataProvider : public ESPDataProviderInterface {
 public:
+    /// When the ESP library is fed.
+    enum class Mode {
+        /// Every frame of the stream is fed to the ESP library as it is written.
+        CONTINUOUS,
+        /// Only the frames of @c getESPDataForWakeWord()'s window are fed to the ESP library, when it is called.
+        ON_DEMAND
+    };
+
     /**
      * Create a unique pointer for an ESPDataProvider.
      *
      * @param audioProvider Should have the audio input stream used by the wakeword engine and the input parameters.
+     * @param mode When to feed the ESP library.
      * @return A valid ESPDataProvider pointer if creation succeeds and a empty pointer if it fails.
      */
-    static std::unique_ptr<ESPDataProvider> create(const capabilityAgents::aip::AudioProvider& audioProvider);
+    static std::unique_ptr<ESPDataProvider> create(
+        const capabilityAgents::aip::AudioProvider& audioProvider,
+        Mode mode = Mode::CONTINUOUS);
 
     /**
      * ESPDataProvider Destructor.
@@ -52,6 +65,9 @@ public:
     /// @name Overridden ESPDataProviderInterface methods.
     /// @{
     capabilityAgents::aip::ESPData getESPData() override;
+    capabilityAgents::aip::ESPData getESPDataForWakeWord(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex) override;
     bool isEnabled() const override;
     void disable() override;
     void enable() override;
@@ -79,15 +95,36 @@ private:
      */
     void espLoop();
 
+    /**
+     * Feeds the ESP library a window of the stream in @c Mode::ON_DEMAND.  @c m_mutex must be held when this is called.
+     *
+     * @param beginIndex The index in the stream of the first sample of the wake word.
+     * @param endIndex The index in the stream of the sample after the wake word.
+     * @return The ESPData of the window, or ESPData::EMPTY_ESP_DATA if the window could not be read.
+     */
+    capabilityAgents::aip::ESPData computeWindowLocked(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex);
+
     /**
      * ESPDataProvider constructor.
      *
-     * @param reader Audio input stream that should be used to feed the ESP library.
+     * @param stream The audio input stream used by the wakeword engine.
+     * @param reader Audio input stream reader that should be used to feed the ESP library in @c Mode::CONTINUOUS, or
+     *     @c nullptr in @c Mode::ON_DEMAND.
      * @param frameSize The audio frame size per ms in bits.
+     * @param mode When to feed the ESP library.
      */
-    ESPDataProvider(std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> reader, unsigned int frameSize);
+    ESPDataProvider(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        unsigned int frameSize,
+        Mode mode);
+
+    /// The audio input stream used by the wakeword engine, which @c Mode::ON_DEMAND reads windows of.
+    std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
 
-    // Unique pointer to a valid stream reader.
+    // Unique pointer to a valid stream reader in @c Mode::CONTINUOUS.
     std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
 
     /// Object responsible for VAD algorithm.
@@ -99,7 +136,7 @@ private:
     /// Thread that keeps feeding audio to ESP library.
     std::thread m_thread;
 
-    /// Serializes access to m_FrameEnergyCompute.
+    /// Serializes access to m_FrameEnergyCompute, and to m_vad in @c Mode::ON_DEMAND.
     std::mutex m_mutex;
 
     /// Indicates if ESP data is provided or not. The access to this variable is guarded by @c m_mutex.
@@ -110,6 +147,12 @@ private:
 
     /// Keeps the frame size.
     unsigned int m_frameSize;
+
+    /// When the ESP library is fed.
+    const Mode m_mode;
+
+    /// The ESPData of the last wake word in @c Mode::ON_DEMAND.  The access to this variable is guarded by @c m_mutex.
+    capabilityAgents::aip::ESPData m_lastESPData;
 };
 
 }  // namespace esp
@@ -16,6 +16,7 @@
 #define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPDATAPROVIDERINTERFACE_H_
 
 #include <AIP/ESPData.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
 
 namespace alexaClientSDK {
 namespace esp {
@@ -37,6 +38,20 @@ public:
      */
     virtual capabilityAgents::aip::ESPData getESPData() = 0;
 
+    /**
+     * Retrieve the ESPData for a wake word.  Providers which compute ESP over the wake word and the audio before it,
+     * rather than over the whole stream, override this; by default it returns @c getESPData().
+     *
+     * @param beginIndex The index in the stream of the first sample of the wake word.
+     * @param endIndex The index in the stream of the sample after the wake word.
+     * @return Collected ESPData if ESP is enabled, otherwise it returns ESPData::EMPTY_ESP_DATA.
+     */
+    virtual capabilityAgents::aip::ESPData getESPDataForWakeWord(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex) {
+        return getESPData();
+    }
+
     /**
      * Return whether the ESP is enabled or not.
      *
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
+#define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "VAD_Features/VAD_class.h"
+
+#include <AIP/VoiceActivityDetectorInterface.h>
+
+namespace alexaClientSDK {
+namespace esp {
+
+/**
+ * The ESPVoiceActivityDetector lets an @c EndOfSpeechDetector classify frames with the voice activity detector of the
+ * ESP library, the same detector the @c ESPDataProvider measures the voiced energy with.
+ */
+class ESPVoiceActivityDetector : public capabilityAgents::aip::VoiceActivityDetectorInterface {
+public:
+    /**
+     * Create a unique pointer for an ESPVoiceActivityDetector.
+     *
+     * @return A valid ESPVoiceActivityDetector pointer.
+     */
+    static std::unique_ptr<ESPVoiceActivityDetector> create();
+
+    /// @name Overridden VoiceActivityDetectorInterface methods.
+    /// @{
+    size_t getFrameSizeInSamples() override;
+    void reset() override;
+    bool isVoiced(const int16_t* samples) override;
+    /// @}
+
+private:
+    /**
+     * ESPVoiceActivityDetector constructor.
+     *
+     * @param frameSize The number of samples in a frame.
+     */
+    ESPVoiceActivityDetector(unsigned int frameSize);
+
+    /// Keeps the frame size.
+    unsigned int m_frameSize;
+
+    /// Object responsible for VAD algorithm.
+    VADClass m_vad;
+
+    /// A copy of the frame being classified, which the ESP library takes as writable.
+    std::vector<short> m_frame;
+};
+
+}  // namespace esp
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
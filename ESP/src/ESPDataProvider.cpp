@@ -12,6 +12,10 @@
  * express or implied. See the License for the specific language governing
  * permissions and limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 #include <AIP/AudioProvider.h>
 #include <AIP/ESPData.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
@@ -44,10 +48,18 @@ namespace esp {
 
 static const auto TIMEOUT = std::chrono::seconds(1);
 
+/**
+ * How much of the audio before a wake word @c Mode::ON_DEMAND feeds the ESP library, which measures the ambient energy
+ * in it.  The stream the wakeword engine reads holds far more than this.
+ */
+static const std::chrono::milliseconds AMBIENT_WINDOW(2000);
+
 using AudioInputStream = avsCommon::avs::AudioInputStream;
 using ESPData = alexaClientSDK::capabilityAgents::aip::ESPData;
 
-std::unique_ptr<ESPDataProvider> ESPDataProvider::create(const capabilityAgents::aip::AudioProvider& audioProvider) {
+std::unique_ptr<ESPDataProvider> ESPDataProvider::create(
+    const capabilityAgents::aip::AudioProvider& audioProvider,
+    Mode mode) {
     if ((ESP_COMPATIBLE_SAMPLE_RATE != audioProvider.format.sampleRateHz) ||
         (ESP_COMPATIBLE_SAMPLE_SIZE_IN_BITS != audioProvider.format.sampleSizeInBits)) {
         ACSDK_ERROR(LX(__func__)
@@ -59,13 +71,17 @@ std::unique_ptr<ESPDataProvider> ESPDataProvider::create(const capabilityAgents:
 
     unsigned int frameSize = (audioProvider.format.sampleRateHz / 1000) * ESP_FRAMES_IN_MILLISECONDS;
 
-    auto reader = audioProvider.stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::BLOCKING);
-    if (!reader) {
-        ACSDK_ERROR(LX(__func__).d("reason", "createReaderFailed"));
-        return nullptr;
+    std::unique_ptr<AudioInputStream::Reader> reader;
+    if (Mode::CONTINUOUS == mode) {
+        reader = audioProvider.stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::BLOCKING);
+        if (!reader) {
+            ACSDK_ERROR(LX(__func__).d("reason", "createReaderFailed"));
+            return nullptr;
+        }
     }
 
-    auto connector = std::unique_ptr<ESPDataProvider>(new ESPDataProvider(std::move(reader), frameSize));
+    auto connector = std::unique_ptr<ESPDataProvider>(
+        new ESPDataProvider(audioProvider.stream, std::move(reader), frameSize, mode));
     connector->enable();
     return connector;
 }
@@ -80,12 +96,27 @@ ESPDataProvider::~ESPDataProvider() {
 ESPData ESPDataProvider::getESPData() {
     std::lock_guard<std::mutex> lock{m_mutex};
     if (m_isEnabled) {
+        if (Mode::ON_DEMAND == m_mode) {
+            return m_lastESPData;
+        }
         return ESPData{std::to_string(m_frameEnergyCompute.getVoicedEnergy()),
                        std::to_string(m_frameEnergyCompute.getAmbientEnergy())};
     }
     return ESPData::EMPTY_ESP_DATA;
 }
 
+ESPData ESPDataProvider::getESPDataForWakeWord(AudioInputStream::Index beginIndex, AudioInputStream::Index endIndex) {
+    if (Mode::CONTINUOUS == m_mode) {
+        return getESPData();
+    }
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (!m_isEnabled) {
+        return ESPData::EMPTY_ESP_DATA;
+    }
+    m_lastESPData = computeWindowLocked(beginIndex, endIndex);
+    return m_lastESPData;
+}
+
 bool ESPDataProvider::isEnabled() const {
     return m_isEnabled;
 }
@@ -148,18 +179,79 @@ void ESPDataProvider::espLoop() {
     m_reader->close();
 }
 
+ESPData ESPDataProvider::computeWindowLocked(AudioInputStream::Index beginIndex, AudioInputStream::Index endIndex) {
+    if (avsCommon::sdkInterfaces::KeyWordObserverInterface::UNSPECIFIED_INDEX == beginIndex ||
+        avsCommon::sdkInterfaces::KeyWordObserverInterface::UNSPECIFIED_INDEX == endIndex || endIndex <= beginIndex) {
+        ACSDK_ERROR(LX("computeWindowFailed").d("reason", "invalidIndices").d("begin", beginIndex).d("end", endIndex));
+        return ESPData::EMPTY_ESP_DATA;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // A new reader starts at the oldest audio the stream holds.
+    auto reader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("computeWindowFailed").d("reason", "createReaderFailed"));
+        return ESPData::EMPTY_ESP_DATA;
+    }
+    auto oldestIndex = reader->tell();
+    if (beginIndex < oldestIndex) {
+        ACSDK_ERROR(LX("computeWindowFailed")
+                        .d("reason", "wakeWordOverwritten")
+                        .d("begin", beginIndex)
+                        .d("oldest", oldestIndex));
+        return ESPData::EMPTY_ESP_DATA;
+    }
+    AudioInputStream::Index ambientSamples = ESP_COMPATIBLE_SAMPLE_RATE * AMBIENT_WINDOW.count() / 1000;
+    auto windowBegin = beginIndex - std::min(beginIndex - oldestIndex, ambientSamples);
+    if (!reader->seek(windowBegin)) {
+        ACSDK_ERROR(LX("computeWindowFailed").d("reason", "seekFailed").d("index", windowBegin));
+        return ESPData::EMPTY_ESP_DATA;
+    }
+
+    m_vad.blkReset();
+    m_frameEnergyCompute.blkReset();
+    Word64 currentFrameEnergy = 0;
+    bool GVAD = false;
+    std::vector<short> procBuff(m_frameSize);
+    size_t numFrames = (endIndex - windowBegin) / m_frameSize;
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        size_t numWords = 0;
+        while (numWords < m_frameSize) {
+            auto words = reader->read(procBuff.data() + numWords, m_frameSize - numWords, TIMEOUT);
+            if (words <= 0) {
+                ACSDK_ERROR(LX("computeWindowFailed").d("reason", "readFailed").d("error", words).d("frame", frame));
+                return ESPData::EMPTY_ESP_DATA;
+            }
+            numWords += words;
+        }
+        m_vad.process(procBuff.data(), GVAD, currentFrameEnergy);
+        m_frameEnergyCompute.process(GVAD, currentFrameEnergy);
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ACSDK_INFO(LX("computeWindow").d("frames", numFrames).d("durationInMicroseconds", duration.count()));
+    return ESPData{std::to_string(m_frameEnergyCompute.getVoicedEnergy()),
+                   std::to_string(m_frameEnergyCompute.getAmbientEnergy())};
+}
+
 ESPDataProvider::ESPDataProvider(
+    std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
     std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
-    unsigned int frameSize) :
+    unsigned int frameSize,
+    Mode mode) :
+        m_stream{stream},
         m_reader{std::move(reader)},
         m_vad{frameSize},
         m_frameEnergyCompute{frameSize},
         m_isEnabled{true},
         m_isShuttingDown{false},
-        m_frameSize{frameSize} {
+        m_frameSize{frameSize},
+        m_mode{mode} {
     m_vad.blkReset();
     m_frameEnergyCompute.blkReset();
-    m_thread = std::thread(&ESPDataProvider::espLoop, this);
+    if (Mode::CONTINUOUS == m_mode) {
+        m_thread = std::thread(&ESPDataProvider::espLoop, this);
+    }
 }
 
 }  // namespace esp
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "ESP/ESPVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace esp {
+
+/// The ESP compatible AVS sample rate of 16 kHz.
+static const unsigned int ESP_COMPATIBLE_SAMPLE_RATE = 16000;
+
+/// The ESP frame size in ms.  The ESP library supports 8ms, 15ms and 16ms
+static const unsigned int ESP_FRAMES_IN_MILLISECONDS = 16;
+
+std::unique_ptr<ESPVoiceActivityDetector> ESPVoiceActivityDetector::create() {
+    unsigned int frameSize = (ESP_COMPATIBLE_SAMPLE_RATE / 1000) * ESP_FRAMES_IN_MILLISECONDS;
+    return std::unique_ptr<ESPVoiceActivityDetector>(new ESPVoiceActivityDetector(frameSize));
+}
+
+size_t ESPVoiceActivityDetector::getFrameSizeInSamples() {
+    return m_frameSize;
+}
+
+void ESPVoiceActivityDetector::reset() {
+    m_vad.blkReset();
+}
+
+bool ESPVoiceActivityDetector::isVoiced(const int16_t* samples) {
+    std::copy(samples, samples + m_frameSize, m_frame.begin());
+    Word64 frameEnergy = 0;
+    bool GVAD = false;
+    m_vad.process(m_frame.data(), GVAD, frameEnergy);
+    return GVAD;
+}
+
+ESPVoiceActivityDetector::ESPVoiceActivityDetector(unsigned int frameSize) :
+        m_frameSize{frameSize},
+        m_vad{frameSize},
+        m_frame(frameSize) {
+    m_vad.blkReset();
+}
+
+}  // namespace esp
+}  // namespace alexaClientSDK
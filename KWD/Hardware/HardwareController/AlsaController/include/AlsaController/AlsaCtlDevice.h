@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_ALSACTLDEVICE_H_
+#define ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_ALSACTLDEVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "AlsaController/CtlDeviceInterface.h"
+
+/// The ALSA control handle, as declared by <alsa/asoundlib.h>.
+typedef struct _snd_ctl snd_ctl_t;
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A @c CtlDeviceInterface over an ALSA control device, whose DSP raises the "KP Detect Control" element on a keyword
+ * and switches mode with the "Capture Stream mode" element.
+ */
+class AlsaCtlDevice : public CtlDeviceInterface {
+public:
+    /**
+     * Opens an ALSA control device, subscribes to its events, and reloads its DSP's topology.
+     *
+     * @param name The name of the control device, such as "hw:0".
+     * @return The device, or @c nullptr if it could not be opened or set up.
+     */
+    static std::unique_ptr<AlsaCtlDevice> create(const std::string& name);
+
+    /// Destructor.  Closes the control device.
+    ~AlsaCtlDevice() override;
+
+    /// @name CtlDeviceInterface Functions
+    /// @{
+    int getEventDescriptor() override;
+    bool readDetection(int* begin, int* end) override;
+    bool writeCaptureMode(CaptureMode mode) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param ctl The control device, which the device closes.
+     */
+    AlsaCtlDevice(snd_ctl_t* ctl);
+
+    /**
+     * Subscribes to the control device's events, and reloads its DSP's topology.
+     *
+     * @return Whether the device was set up.
+     */
+    bool init();
+
+    /// The control device.
+    snd_ctl_t* m_ctl;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_ALSACTLDEVICE_H_
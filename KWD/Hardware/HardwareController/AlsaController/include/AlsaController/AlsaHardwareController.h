@@ -7,16 +7,20 @@
 #ifndef ALEXA_CLIENT_SDK_KWD_ALSA_HW_CTRL_H_
 #define ALEXA_CLIENT_SDK_KWD_ALSA_HW_CTRL_H_
 
+#include <atomic>
 #include <chrono>
-#include <string>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
-#include <atomic>
-
-#include <alsa/asoundlib.h>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include "AVSCommon/SDKInterfaces/AudioInputProcessorObserverInterface.h"
 #include "AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h"
 
+#include "AlsaController/CtlDeviceInterface.h"
 #include "HardwareController/AbstractHardwareController.h"
 
 namespace alexaClientSDK {
@@ -28,12 +32,18 @@ using namespace avsCommon::sdkInterfaces;
 /**
  * Hardware controller for an ALSA audio driver.
  *
+ * The controller owns one I/O thread, which waits on the control device's
+ * events and on a queue of mode changes.  Observer callbacks only record the
+ * mode they want and wake the thread, so they never block on the codec.  If
+ * the mode changes again before the thread gets to it, only the latest mode
+ * is written, and a mode which is already set is not written again.
+ *
  * IMPORTANT: It is very important to note, that this must be added to the
  * list of observers for the Dialog UX states AFTER the observer which operates
  * the microphone. Otherwise, errors will occur as a result of the audio device
  * being unavailable when the controller tries to put it back into the WoV mode.
  */
-class AlsaHardwareController 
+class AlsaHardwareController
     : public AbstractHardwareController
     , public AudioInputProcessorObserverInterface
     , public DialogUXStateObserverInterface {
@@ -41,6 +51,27 @@ public:
     /// Alias to the @c AudioInputProcessorObserverInterface::state for brevity
     using AipState = AudioInputProcessorObserverInterface::State;
 
+    /// Alias to the @c CtlDeviceInterface::CaptureMode for brevity
+    using CaptureMode = CtlDeviceInterface::CaptureMode;
+
+    /// How the mode control has been written since the controller was created.
+    struct ControlWriteStatistics {
+        /// The number of modes requested by the observer callbacks.
+        uint64_t requests;
+        /// The number of requests replaced by a later one before they were written.
+        uint64_t coalesced;
+        /// The number of writes to the mode control, including failed ones.
+        uint64_t writes;
+        /// The number of writes which failed.
+        uint64_t failures;
+        /// The time from the request to the end of the most recent write.
+        std::chrono::nanoseconds lastLatency;
+        /// The longest time from a request to the end of its write.
+        std::chrono::nanoseconds maxLatency;
+        /// The sum of the times from a request to the end of its write.
+        std::chrono::nanoseconds totalLatency;
+    };
+
     /**
      * Creates a new pointer to an @c AlsaHardwareController.
      *
@@ -50,6 +81,16 @@ public:
      */
     static std::shared_ptr<AlsaHardwareController> create(std::string name, std::string keyword);
 
+    /**
+     * Creates a new pointer to an @c AlsaHardwareController over a control device.
+     *
+     * @param device The control device, which the controller owns
+     * @param keyword Keyword which will be detected from the control device
+     * @return @c AlsaHardwareController, nullptr otherwise
+     */
+    static std::shared_ptr<AlsaHardwareController> create(
+            std::unique_ptr<CtlDeviceInterface> device, std::string keyword);
+
     /// @name AbstractHardwareController Functions
     /// @{
     /**
@@ -66,7 +107,7 @@ public:
     /// @{
     void onStateChanged(AipState state) override;
     /// @}
-    
+
     /// @name DialogUXStateObserverInterface Functions
     /// @{
     /**
@@ -76,9 +117,16 @@ public:
      */
     void onDialogUXStateChanged(DialogUXState newState) override;
     /// @}
-    
+
+    /**
+     * Get how the mode control has been written.
+     *
+     * @return The statistics so far
+     */
+    ControlWriteStatistics getControlWriteStatistics() const;
+
     /**
-     * Destructor.
+     * Destructor.  Stops the I/O thread.
      */
     ~AlsaHardwareController();
 
@@ -86,29 +134,83 @@ private:
     /**
      * Constructor.
      *
-     * @param name Name of the ALSA device to connect to
-     * @param keyword Keyword which will be detected from the ALSA control device
+     * @param device The control device
+     * @param keyword Keyword which will be detected from the control device
      */
-    AlsaHardwareController(std::string name, std::string keyword);
+    AlsaHardwareController(std::unique_ptr<CtlDeviceInterface> device, std::string keyword);
 
     /**
-     * Initialize the connection to the ALSA driver.
+     * Set up the event queue and start the I/O thread.
      *
      * @return @c true if init succeeds, @c false otherwise
      */
     bool init();
 
-    /// Name of the ALSA controller to connect to
-    std::string m_name;
+    /**
+     * Ask the I/O thread to put the device into a mode, replacing any mode
+     * which has not been written yet.
+     *
+     * @param mode The mode
+     */
+    void requestCaptureMode(CaptureMode mode);
+
+    /// Wait for events on the control device and the command queue until shut down.
+    void ioLoop();
+
+    /**
+     * Read an event from the control device, and queue it if it is a detection.
+     *
+     * @param time When the event was raised
+     */
+    void readDetection(std::chrono::steady_clock::time_point time);
+
+    /// Write the mode last requested, unless it is already set.
+    void writePendingCaptureMode();
 
-    /// Keyword which is detected by the ALSA control device
+    /// Keyword which is detected by the control device
     std::string m_keyword;
 
-    /// Handle to the ALSA control device
-    snd_ctl_t* m_ctl;
+    /// The control device, only used by the I/O thread once it has started
+    std::unique_ptr<CtlDeviceInterface> m_device;
+
+    /// The epoll instance the I/O thread waits on
+    int m_epollFd;
+
+    /// The eventfd which wakes the I/O thread for a request or to shut down
+    int m_commandFd;
+
+    /// Serializes access to the members below
+    mutable std::mutex m_mutex;
+
+    /// Notified when a detection is queued or the controller shuts down
+    std::condition_variable m_detectionAvailable;
+
+    /// Detections which have not been read yet
+    std::deque<std::unique_ptr<KeywordDetection>> m_detections;
+
+    /// Whether a mode has been requested and not written yet
+    bool m_hasPendingMode;
+
+    /// The mode last requested
+    CaptureMode m_pendingMode;
+
+    /// When the oldest unwritten request was made
+    std::chrono::steady_clock::time_point m_pendingSince;
+
+    /// How the mode control has been written
+    ControlWriteStatistics m_statistics;
+
+    /// Whether the controller is shutting down
+    bool m_isShuttingDown;
+
+    /// Whether the device's mode is known, only used by the I/O thread
+    bool m_hasWrittenMode;
+
+    /// The mode the device was last put into, only used by the I/O thread
+    CaptureMode m_writtenMode;
 
-    /// Flags for checking if the device is in the WoV state
-    std::atomic<bool> m_isWakeOnVoice;
+    /// The I/O thread
+    std::thread m_ioThread;
 };
 
 } // kwd
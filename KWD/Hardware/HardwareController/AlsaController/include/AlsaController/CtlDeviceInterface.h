@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_CTLDEVICEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_CTLDEVICEINTERFACE_H_
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * The control device of a DSP which detects keywords: it raises an event when it detects one, and has a mode control
+ * which switches it between listening for the keyword and streaming captured audio.
+ *
+ * The device is used from one thread at a time.
+ */
+class CtlDeviceInterface {
+public:
+    /// The modes of the DSP.
+    enum class CaptureMode {
+        /// Listening for the keyword.
+        WAKE_ON_VOICE,
+        /// Streaming captured audio.
+        CAPTURE_STREAMING
+    };
+
+    /// Destructor.
+    virtual ~CtlDeviceInterface() = default;
+
+    /**
+     * Gets the file descriptor which becomes readable when the device has an event to read.
+     *
+     * @return The file descriptor.
+     */
+    virtual int getEventDescriptor() = 0;
+
+    /**
+     * Reads an event, and the position of the keyword if the event was a detection.
+     *
+     * @param[out] begin Where the keyword begins in the DSP's history, in samples.
+     * @param[out] end Where the keyword ends in the DSP's history, in samples.
+     * @return Whether the event was a detection.
+     */
+    virtual bool readDetection(int* begin, int* end) = 0;
+
+    /**
+     * Writes the mode control, which may take as long as the codec takes to switch.
+     *
+     * @param mode The mode.
+     * @return Whether the write succeeded.
+     */
+    virtual bool writeCaptureMode(CaptureMode mode) = 0;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_HARDWARE_HARDWARECONTROLLER_ALSACONTROLLER_INCLUDE_ALSACONTROLLER_CTLDEVICEINTERFACE_H_
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+
+#include <alsa/asoundlib.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AlsaController/AlsaCtlDevice.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AlsaCtlDevice");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The control the DSP raises when it detects the keyword.
+static const char* CTL_DETECT_NAME = "KP Detect Control";
+
+/// The control which switches the DSP between listening for the keyword and streaming.
+static const char* CTL_CAP_STREAM_MODE = "Capture Stream mode";
+
+/// The control which loads and unloads the DSP's topology.
+static const char* CTL_DSP_TOPO = "DSP Load Topology Control";
+
+/// The value of @c CTL_DSP_TOPO which unloads the topology.
+static const long DSP_UNLOAD = 0;
+
+/// The value of @c CTL_DSP_TOPO which loads the topology.
+static const long DSP_LOAD = 1;
+
+/// The value of @c CTL_CAP_STREAM_MODE which listens for the keyword.
+static const long KP_WAKE_ON_VOICE = 0;
+
+/// The value of @c CTL_CAP_STREAM_MODE which streams captured audio.
+static const long KP_CAPTURE_STREAMING = 1;
+
+/**
+ * Logs a failed ALSA call.
+ *
+ * @param result The result of the call.
+ * @param call The name of the call.
+ * @return Whether the call succeeded.
+ */
+static bool succeeded(int result, const char* call) {
+    if (result < 0) {
+        ACSDK_ERROR(LX("alsaCallFailed").d("call", call).d("error", snd_strerror(result)));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes an integer mixer control.
+ *
+ * @param ctl The control device.
+ * @param name The name of the control.
+ * @param value The value.
+ * @return Whether the write succeeded.
+ */
+static bool writeControl(snd_ctl_t* ctl, const char* name, long value) {
+    snd_ctl_elem_value_t* control;
+    snd_ctl_elem_value_alloca(&control);
+    snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
+    snd_ctl_elem_value_set_name(control, name);
+    snd_ctl_elem_value_set_index(control, 0);
+    snd_ctl_elem_value_set_integer(control, 0, value);
+    if (!succeeded(snd_ctl_elem_write(ctl, control), "snd_ctl_elem_write")) {
+        ACSDK_ERROR(LX("writeControlFailed").d("name", name).d("value", value));
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<AlsaCtlDevice> AlsaCtlDevice::create(const std::string& name) {
+    snd_ctl_t* ctl = nullptr;
+    if (!succeeded(snd_ctl_open(&ctl, name.c_str(), SND_CTL_READONLY), "snd_ctl_open")) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "openFailed").d("name", name));
+        return nullptr;
+    }
+    std::unique_ptr<AlsaCtlDevice> device(new AlsaCtlDevice(ctl));
+    if (!device->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initFailed").d("name", name));
+        return nullptr;
+    }
+    return device;
+}
+
+AlsaCtlDevice::~AlsaCtlDevice() {
+    // Closing the connection also frees everything allocated for it.
+    snd_ctl_close(m_ctl);
+}
+
+int AlsaCtlDevice::getEventDescriptor() {
+    struct pollfd fd;
+    if (snd_ctl_poll_descriptors(m_ctl, &fd, 1) != 1) {
+        ACSDK_ERROR(LX("getEventDescriptorFailed").d("reason", "noPollDescriptor"));
+        return -1;
+    }
+    return fd.fd;
+}
+
+bool AlsaCtlDevice::readDetection(int* begin, int* end) {
+    snd_ctl_event_t* event;
+    snd_ctl_event_alloca(&event);
+    if (!succeeded(snd_ctl_read(m_ctl, event), "snd_ctl_read")) {
+        return false;
+    }
+
+    // Writing the mode raises an event too, so only the detect control's events are detections.
+    if (snd_ctl_event_get_type(event) != SND_CTL_EVENT_ELEM ||
+        std::strcmp(snd_ctl_event_elem_get_name(event), CTL_DETECT_NAME) != 0) {
+        return false;
+    }
+
+    snd_ctl_elem_value_t* control;
+    snd_ctl_elem_value_alloca(&control);
+    snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
+    snd_ctl_elem_value_set_name(control, CTL_DETECT_NAME);
+    snd_ctl_elem_value_set_index(control, 0);
+    if (!succeeded(snd_ctl_elem_read(m_ctl, control), "snd_ctl_elem_read")) {
+        return false;
+    }
+
+    // The DSP packs the begin and end of the keyword into the halves of the value.
+    uint32_t value = snd_ctl_elem_value_get_integer(control, 0);
+    uint16_t* payload = reinterpret_cast<uint16_t*>(&value);
+    *begin = payload[0];
+    *end = payload[1];
+    return true;
+}
+
+bool AlsaCtlDevice::writeCaptureMode(CaptureMode mode) {
+    switch (mode) {
+        case CaptureMode::WAKE_ON_VOICE:
+            return writeControl(m_ctl, CTL_CAP_STREAM_MODE, KP_WAKE_ON_VOICE);
+        case CaptureMode::CAPTURE_STREAMING:
+            return writeControl(m_ctl, CTL_CAP_STREAM_MODE, KP_CAPTURE_STREAMING);
+    }
+    return false;
+}
+
+AlsaCtlDevice::AlsaCtlDevice(snd_ctl_t* ctl) : m_ctl{ctl} {
+}
+
+bool AlsaCtlDevice::init() {
+    static const int subscribe = 1;
+    if (!succeeded(snd_ctl_subscribe_events(m_ctl, subscribe), "snd_ctl_subscribe_events")) {
+        return false;
+    }
+    ACSDK_DEBUG(LX("init").d("event", "reloadingDspTopology"));
+    return writeControl(m_ctl, CTL_DSP_TOPO, DSP_UNLOAD) && writeControl(m_ctl, CTL_DSP_TOPO, DSP_LOAD);
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -4,8 +4,16 @@
  * TODO: Add Intel copyright
  */
 
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
+#include "AlsaController/AlsaCtlDevice.h"
 #include "AlsaController/AlsaHardwareController.h"
 
 namespace alexaClientSDK {
@@ -15,24 +23,30 @@ namespace kwd {
 static const std::string TAG("AlsaHardwareController");
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-// ALSA control device name for receving keyphrase detection events
-#define CTL_DETECT_NAME "KP Detect Control"
-#define CTL_CAP_STREAM_MODE "Capture Stream mode"
-#define CTL_DSP_TOPO "DSP Load Topology Control"
-
-// DSP unload/load values
-#define DSP_UNLOAD 0
-#define DSP_LOAD   1
+// The number of descriptors the I/O thread waits on: the control device and the command queue
+static const int MAX_EPOLL_EVENTS = 2;
 
-// Multi-Turn modes
-#define KP_WAKE_ON_VOICE     0
-#define KP_CAPTURE_STREAMING 1
+std::shared_ptr<AlsaHardwareController> AlsaHardwareController::create(
+        std::string name, std::string keyword)
+{
+    auto device = AlsaCtlDevice::create(name);
+    if(!device) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "openCtlDeviceFailed").d("name", name));
+        return nullptr;
+    }
+    return create(std::move(device), keyword);
+}
 
 std::shared_ptr<AlsaHardwareController> AlsaHardwareController::create(
-        std::string name, std::string keyword) 
+        std::unique_ptr<CtlDeviceInterface> device, std::string keyword)
 {
+    if(!device) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullDevice"));
+        return nullptr;
+    }
+
     std::shared_ptr<AlsaHardwareController> ctrl = std::shared_ptr<AlsaHardwareController>(
-            new AlsaHardwareController(name, keyword));
+            new AlsaHardwareController(std::move(device), keyword));
 
     if(!ctrl->init()) {
         ACSDK_ERROR(LX("createFailed").d("reason", "initHardwareControllerFailed"));
@@ -44,162 +58,228 @@ std::shared_ptr<AlsaHardwareController> AlsaHardwareController::create(
 
 std::unique_ptr<KeywordDetection> AlsaHardwareController::read(
         std::chrono::milliseconds timeout) {
-    // Get the file descriptor
-    struct pollfd fds[1];
-    snd_ctl_poll_descriptors(m_ctl, &fds[0], 1);
-
-    int ret = poll(fds, 1, timeout.count());
-    
-    if(ret == 0) {
-        // 0 indicates a timeout
-        return nullptr;
-    } else if(ret < 0) {
-        // < 0 indicates an error occurred
-        ACSDK_ERROR(LX("readFailed")
-                .d("reason", "pollFailed")
-                .d("error_code", snd_strerror(ret)));
-        return nullptr;
-    }
-
-    snd_ctl_event_t* event;
-    snd_ctl_event_alloca(&event);
-    if(snd_ctl_read(m_ctl, event) < 0) {
-        ACSDK_ERROR(LX("readFailed")
-                .d("reason", "sndReadFailed")
-                .d("error_code", snd_strerror(ret)));
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(!m_detectionAvailable.wait_for(lock, timeout, [this] {
+            return !m_detections.empty() || m_isShuttingDown; })) {
         return nullptr;
     }
-
-    // Get reference to the KP detect control device
-    snd_ctl_elem_value_t* control;
-    snd_ctl_elem_value_alloca(&control);
-    snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
-    snd_ctl_elem_value_set_name(control, CTL_DETECT_NAME);
-    snd_ctl_elem_value_set_index(control, 0);
-    
-    if((ret = snd_ctl_elem_read(m_ctl, control)) != 0) {
-        ACSDK_ERROR(LX("readFailed")
-                .d("reason", "sndCtrlElemReadFailed")
-                .d("error_code", snd_strerror(ret)));
+    if(m_detections.empty()) {
         return nullptr;
     }
-
-    uint32_t value = snd_ctl_elem_value_get_integer(control, 0);
-    uint16_t* payload = reinterpret_cast<uint16_t*>(&value);
-    
-    auto detection = KeywordDetection::create(payload[0], payload[1], m_keyword);
-
-    ACSDK_DEBUG(LX("read")
-            .d("event", "keywordDetection")
-            .d("begin", payload[0])
-            .d("end", payload[1]));
-
+    auto detection = std::move(m_detections.front());
+    m_detections.pop_front();
     return detection;
 }
 
 void AlsaHardwareController::onStateChanged(AipState state) {
     if(state == AipState::EXPECTING_SPEECH) {
-        ACSDK_DEBUG(LX("onStateChanged").d("event", "setCaptureStremingMode"));
-        int ret = 0;
-        // Create handle to the streaming mode control device 
-        snd_ctl_elem_value_t* control;
-        snd_ctl_elem_value_alloca(&control);
-        snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
-        snd_ctl_elem_value_set_name(control, CTL_CAP_STREAM_MODE);
-        snd_ctl_elem_value_set_index(control, 0);
-        // Set mode to streaming mode
-        snd_ctl_elem_value_set_integer(control, 0, KP_CAPTURE_STREAMING);
-        if((ret = snd_ctl_elem_write(m_ctl, control)) != 0) {
-            ACSDK_ERROR(LX("writeFailed")
-                    .d("reason", "setCaptureStreamModeFailed")
-                    .d("error_code", snd_strerror(ret)));
-        }
-        m_isWakeOnVoice = false;
+        ACSDK_DEBUG(LX("onStateChanged").d("event", "setCaptureStreamingMode"));
+        requestCaptureMode(CaptureMode::CAPTURE_STREAMING);
     }
 }
 
 void AlsaHardwareController::onDialogUXStateChanged(DialogUXState state) {
-    if(state == DialogUXState::IDLE && !m_isWakeOnVoice) {
+    if(state == DialogUXState::IDLE) {
         ACSDK_DEBUG(LX("onDialogUXStateChanged").d("event", "setWakeOnVoiceMode"));
-        int ret = 0;
-        // Create handle to the streaming mode control device 
-        snd_ctl_elem_value_t* control;
-        snd_ctl_elem_value_alloca(&control);
-        snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
-        snd_ctl_elem_value_set_name(control, CTL_CAP_STREAM_MODE);
-        snd_ctl_elem_value_set_index(control, 0);
-        // Set mode to streaming mode
-        snd_ctl_elem_value_set_integer(control, 0, KP_WAKE_ON_VOICE);
-        if((ret = snd_ctl_elem_write(m_ctl, control)) != 0) {
-            ACSDK_ERROR(LX("writeFailed")
-                    .d("reason", "setWakeOnVoiceModeFailed")
-                    .d("error_code", snd_strerror(ret)));
-        }
-        m_isWakeOnVoice = true;
+        requestCaptureMode(CaptureMode::WAKE_ON_VOICE);
     }
 }
 
-AlsaHardwareController::AlsaHardwareController(std::string name, std::string keyword) :
-    m_name(name), m_keyword(keyword), m_ctl(NULL), m_isWakeOnVoice(false)
+AlsaHardwareController::ControlWriteStatistics AlsaHardwareController::getControlWriteStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+AlsaHardwareController::AlsaHardwareController(
+        std::unique_ptr<CtlDeviceInterface> device, std::string keyword) :
+    m_keyword(keyword),
+    m_device(std::move(device)),
+    m_epollFd(-1),
+    m_commandFd(-1),
+    m_hasPendingMode(false),
+    m_pendingMode(CaptureMode::WAKE_ON_VOICE),
+    m_statistics(),
+    m_isShuttingDown(false),
+    m_hasWrittenMode(false),
+    m_writtenMode(CaptureMode::WAKE_ON_VOICE)
 {}
 
 AlsaHardwareController::~AlsaHardwareController() {
-    // Note: snd_ctl_close both closes the connection and frees all of its
-    // allocated resources (see ALSA docs for more info)
-    if(m_ctl != NULL) {
-        snd_ctl_close(m_ctl);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_detectionAvailable.notify_all();
+    if(m_ioThread.joinable()) {
+        uint64_t wake = 1;
+        if(::write(m_commandFd, &wake, sizeof(wake)) != sizeof(wake)) {
+            ACSDK_ERROR(LX("shutdownFailed").d("reason", "wakeIoThreadFailed").d("error", std::strerror(errno)));
+        }
+        m_ioThread.join();
+    }
+    if(m_commandFd >= 0) {
+        close(m_commandFd);
+    }
+    if(m_epollFd >= 0) {
+        close(m_epollFd);
     }
 }
 
 bool AlsaHardwareController::init() {
-    int ret = 0;
-
-    if((ret = snd_ctl_open(&m_ctl, m_name.c_str(), SND_CTL_READONLY)) < 0) {
-        ACSDK_ERROR(LX("initFailed")
-                .d("reason", "openAlsaCtrlFailed")
-                .d("error_code", snd_strerror(ret)));
+    int ctlFd = m_device->getEventDescriptor();
+    if(ctlFd < 0) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "noCtlDescriptor"));
         return false;
     }
 
-    // Note: 1 tells the API to subscribe
-    if((ret = snd_ctl_subscribe_events(m_ctl, 1)) < 0) {
-        ACSDK_ERROR(LX("initFailed")
-                .d("reason", "alsaCtrlSubscribeFailed")
-                .d("error_code", snd_strerror(ret)));
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_commandFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(m_epollFd < 0 || m_commandFd < 0) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createEventQueueFailed").d("error", std::strerror(errno)));
         return false;
     }
 
-    // Create handle to the DSP topology control device
-    snd_ctl_elem_value_t* control;
-    snd_ctl_elem_value_alloca(&control);
-    snd_ctl_elem_value_set_interface(control, SND_CTL_ELEM_IFACE_MIXER);
-    snd_ctl_elem_value_set_name(control, CTL_DSP_TOPO);
-    snd_ctl_elem_value_set_index(control, 0);
-    
-    // Unload the DSP's topology
-    ACSDK_DEBUG(LX("dspUnload")
-            .d("message", "Unloading DSP topology"));
-    snd_ctl_elem_value_set_integer(control, 0, DSP_UNLOAD);
-    if((ret = snd_ctl_elem_write(m_ctl, control)) != 0) {
-        ACSDK_ERROR(LX("writeFailed")
-                .d("reason", "dspUnloadFailed")
-                .d("error_code", snd_strerror(ret)));
+    struct epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = ctlFd;
+    if(epoll_ctl(m_epollFd, EPOLL_CTL_ADD, ctlFd, &event) < 0) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "watchCtlDescriptorFailed").d("error", std::strerror(errno)));
         return false;
     }
-
-    // Load the DSP's topology
-    ACSDK_DEBUG(LX("dspLoad")
-            .d("message", "Loading DSP topology"));
-    snd_ctl_elem_value_set_integer(control, 0, DSP_LOAD);
-    if((ret = snd_ctl_elem_write(m_ctl, control)) != 0) {
-        ACSDK_ERROR(LX("writeFailed")
-                .d("reason", "dspLoadFailed")
-                .d("error_code", snd_strerror(ret)));
+    event.data.fd = m_commandFd;
+    if(epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_commandFd, &event) < 0) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "watchCommandQueueFailed").d("error", std::strerror(errno)));
         return false;
     }
 
+    m_ioThread = std::thread(&AlsaHardwareController::ioLoop, this);
     return true;
 }
 
+void AlsaHardwareController::requestCaptureMode(CaptureMode mode) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_statistics.requests;
+        if(m_hasPendingMode) {
+            ++m_statistics.coalesced;
+        } else {
+            m_hasPendingMode = true;
+            m_pendingSince = std::chrono::steady_clock::now();
+        }
+        m_pendingMode = mode;
+    }
+
+    // The eventfd adds up the wakes, so a burst of requests wakes the thread once.
+    uint64_t wake = 1;
+    if(::write(m_commandFd, &wake, sizeof(wake)) != sizeof(wake)) {
+        ACSDK_ERROR(LX("requestCaptureModeFailed").d("reason", "wakeIoThreadFailed").d("error", std::strerror(errno)));
+    }
+}
+
+void AlsaHardwareController::ioLoop() {
+    int ctlFd = m_device->getEventDescriptor();
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    while(true) {
+        int count = epoll_wait(m_epollFd, events, MAX_EPOLL_EVENTS, -1);
+        // The DSP raises the event as soon as the keyword ends, so this is when
+        // the end of the keyword was captured, give or take the period.
+        auto time = std::chrono::steady_clock::now();
+        if(count < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            ACSDK_ERROR(LX("ioLoopFailed").d("reason", "epollWaitFailed").d("error", std::strerror(errno)));
+            break;
+        }
+
+        // Read detections first, so a write to a slow codec does not hold them up.
+        bool hasCommand = false;
+        for(int i = 0; i < count; ++i) {
+            if(events[i].data.fd == ctlFd) {
+                readDetection(time);
+            } else if(events[i].data.fd == m_commandFd) {
+                uint64_t wakes;
+                if(::read(m_commandFd, &wakes, sizeof(wakes)) < 0 && errno != EAGAIN) {
+                    ACSDK_ERROR(LX("ioLoopFailed")
+                            .d("reason", "readCommandQueueFailed")
+                            .d("error", std::strerror(errno)));
+                }
+                hasCommand = true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_isShuttingDown) {
+                break;
+            }
+        }
+        if(hasCommand) {
+            writePendingCaptureMode();
+        }
+    }
+}
+
+void AlsaHardwareController::readDetection(std::chrono::steady_clock::time_point time) {
+    int begin = 0;
+    int end = 0;
+    if(!m_device->readDetection(&begin, &end)) {
+        return;
+    }
+
+    auto detection = KeywordDetection::create(begin, end, m_keyword, time);
+    ACSDK_DEBUG(LX("read")
+            .d("event", "keywordDetection")
+            .d("begin", begin)
+            .d("end", end));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detections.push_back(std::move(detection));
+    }
+    m_detectionAvailable.notify_one();
+}
+
+void AlsaHardwareController::writePendingCaptureMode() {
+    CaptureMode mode;
+    std::chrono::steady_clock::time_point since;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_hasPendingMode) {
+            return;
+        }
+        m_hasPendingMode = false;
+        mode = m_pendingMode;
+        since = m_pendingSince;
+    }
+    if(m_hasWrittenMode && mode == m_writtenMode) {
+        return;
+    }
+
+    bool succeeded = m_device->writeCaptureMode(mode);
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since);
+    if(succeeded) {
+        m_hasWrittenMode = true;
+        m_writtenMode = mode;
+    } else {
+        // The device may be in either mode now, so write the next request whatever it is.
+        m_hasWrittenMode = false;
+        ACSDK_ERROR(LX("writeFailed")
+                .d("reason", "setCaptureModeFailed")
+                .d("mode", mode == CaptureMode::WAKE_ON_VOICE ? "WAKE_ON_VOICE" : "CAPTURE_STREAMING"));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_statistics.writes;
+    if(!succeeded) {
+        ++m_statistics.failures;
+    }
+    m_statistics.lastLatency = latency;
+    m_statistics.totalLatency += latency;
+    if(latency > m_statistics.maxLatency) {
+        m_statistics.maxLatency = latency;
+    }
+}
+
 } // kwd
 } // alexaClientSDK
@@ -9,6 +9,7 @@
 #ifndef ALEXA_CLIENT_SDK_KWD_KEYWORD_DETECTION_H_
 #define ALEXA_CLIENT_SDK_KWD_KEYWORD_DETECTION_H_
 
+#include <chrono>
 #include <string>
 #include <memory>
 
@@ -27,10 +28,14 @@ public:
      * @param begin Index where the keyword begins
      * @param end Index where the keyword ends
      * @param keyword The keyword that was recognized
+     * @param time When the hardware signalled the detection, which is when
+     * the end of the keyword had been captured
      * @return @c KeywordDetection, else nullptr otherwise
      */
     static std::unique_ptr<KeywordDetection> create(
-            int begin, int end, std::string keyword);
+            int begin, int end, std::string keyword,
+            std::chrono::steady_clock::time_point time =
+                std::chrono::steady_clock::now());
 
     /// Get the beginning index
     int getBegin();
@@ -41,6 +46,9 @@ public:
     /// Get the keyword that was detected
     std::string getKeyword();
 
+    /// Get when the hardware signalled the detection
+    std::chrono::steady_clock::time_point getTime();
+
 private:
     /**
      * Constructor.
@@ -48,12 +56,15 @@ private:
      * @param begin Index where the keyword begins
      * @param end Index where the keyword ends
      * @param keyword The keyword that was recognized
+     * @param time When the hardware signalled the detection
      */
-    KeywordDetection(int begin, int end, std::string keyword);
+    KeywordDetection(int begin, int end, std::string keyword,
+            std::chrono::steady_clock::time_point time);
     
     int m_begin;
     int m_end;
     std::string m_keyword;
+    std::chrono::steady_clock::time_point m_time;
 };
 
 } // kwd
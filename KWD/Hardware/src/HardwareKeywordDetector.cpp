@@ -6,9 +6,10 @@
 
 #include "Hardware/HardwareKeywordDetector.h"
 
-#include <AVSCommon/Utils/Logger/Logger.h>
+#include <algorithm>
 
-#define SAMPLE_OFFSET 9000
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/SDS/TimeIndex.h>
 
 namespace alexaClientSDK {
 namespace kwd {
@@ -28,6 +29,12 @@ static const std::string TAG("HardwareKeywordDetector");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/**
+ * The number of samples of history the DSP reports keyword positions in,
+ * which ends where the DSP raised the detection event.
+ */
+static const AudioInputStream::Index SAMPLE_OFFSET = 9000;
+
 std::unique_ptr<HardwareKeywordDetector> HardwareKeywordDetector::create(
     std::shared_ptr<AudioInputStream> stream,
     AudioFormat audioFormat,
@@ -103,7 +110,8 @@ bool HardwareKeywordDetector::init() {
 
 void HardwareKeywordDetector::detectionLoop() {
     std::unique_ptr<KeywordDetection> detection;
-    int streamIdx = 0;
+    AudioInputStream::Index streamIdx = 0;
+    auto timeIndex = m_stream->getTimeIndex();
 
     // Notify the state observers, abd set to ACTIVE
     notifyKeyWordDetectorStateObservers(
@@ -117,18 +125,25 @@ void HardwareKeywordDetector::detectionLoop() {
             continue;
         }
 
-        // Advance the reader to where the writer currently is
-        m_streamReader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
-        // Get the current index of the reader, which should be at the end
-        streamIdx = m_streamReader->tell();
+        // Find the index of the audio captured when the DSP raised the event.
+        // With a time index this is exact however late this thread is woken;
+        // otherwise use where the writer currently is, which is late by as
+        // much as the writer has written since the event.
+        if(!timeIndex || !timeIndex->getIndex(detection->getTime(), &streamIdx)) {
+            // Advance the reader to where the writer currently is
+            m_streamReader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+            // Get the current index of the reader, which should be at the end
+            streamIdx = m_streamReader->tell();
+        }
 
-        int offset = (streamIdx == 0) ? 0 : SAMPLE_OFFSET;
+        auto offset = std::min(streamIdx, SAMPLE_OFFSET);
         auto begin = streamIdx + detection->getBegin() - offset;
         auto end = streamIdx + detection->getEnd() - offset;
 
         ACSDK_DEBUG(LX("detectionLoop")
                 .d("event", "keywordDetection")
                 .d("sds_offset", streamIdx)
+                .d("timeIndexed", timeIndex != nullptr)
                 .d("begin", begin)
                 .d("end", end));
 
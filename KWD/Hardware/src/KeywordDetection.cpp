@@ -12,14 +12,16 @@ namespace alexaClientSDK {
 namespace kwd {
 
 std::unique_ptr<KeywordDetection> KeywordDetection::create(
-        int begin, int end, std::string keyword) 
+        int begin, int end, std::string keyword,
+        std::chrono::steady_clock::time_point time)
 {
     return std::unique_ptr<KeywordDetection>(
-            new KeywordDetection(begin, end, keyword));
+            new KeywordDetection(begin, end, keyword, time));
 }
 
-KeywordDetection::KeywordDetection(int begin, int end, std::string keyword) :
-    m_begin(begin), m_end(end), m_keyword(keyword)
+KeywordDetection::KeywordDetection(int begin, int end, std::string keyword,
+        std::chrono::steady_clock::time_point time) :
+    m_begin(begin), m_end(end), m_keyword(keyword), m_time(time)
 {}
 
 int KeywordDetection::getBegin() {
@@ -34,5 +36,9 @@ std::string KeywordDetection::getKeyword() {
     return m_keyword;
 }
 
+std::chrono::steady_clock::time_point KeywordDetection::getTime() {
+    return m_time;
+}
+
 } // kwd
 } // alexaClientSdk
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AlsaHardwareControllerTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "AlsaController/AlsaHardwareController.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using CaptureMode = CtlDeviceInterface::CaptureMode;
+
+/// The keyword the controller reports.
+static const std::string KEYWORD = "ALEXA";
+
+/// How long to wait for something which should happen.
+static const std::chrono::milliseconds TIMEOUT(2000);
+
+/// How long to wait for something which should not happen.
+static const std::chrono::milliseconds SHORT_TIMEOUT(50);
+
+/// A control device whose detections are injected through a pipe, and whose mode writes can be held up.
+class FakeCtlDevice : public CtlDeviceInterface {
+public:
+    /// Constructor.
+    FakeCtlDevice() : m_isBlocked{false}, m_isWriting{false} {
+        if (pipe(m_pipe) != 0) {
+            m_pipe[0] = m_pipe[1] = -1;
+        }
+    }
+
+    /// Destructor.
+    ~FakeCtlDevice() override {
+        close(m_pipe[0]);
+        close(m_pipe[1]);
+    }
+
+    int getEventDescriptor() override {
+        return m_pipe[0];
+    }
+
+    bool readDetection(int* begin, int* end) override {
+        int payload[2];
+        if (::read(m_pipe[0], payload, sizeof(payload)) != sizeof(payload) || payload[0] < 0) {
+            return false;
+        }
+        *begin = payload[0];
+        *end = payload[1];
+        return true;
+    }
+
+    bool writeCaptureMode(CaptureMode mode) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isWriting = true;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this] { return !m_isBlocked; });
+        m_isWriting = false;
+        m_writes.push_back(mode);
+        m_changed.notify_all();
+        return true;
+    }
+
+    /**
+     * Raises an event, as the DSP does on a detection or a write to another control.
+     *
+     * @param begin Where the keyword begins, or negative for an event which is not a detection.
+     * @param end Where the keyword ends.
+     */
+    void raiseEvent(int begin, int end) {
+        int payload[2] = {begin, end};
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(payload)), write(m_pipe[1], payload, sizeof(payload)));
+    }
+
+    /**
+     * Sets whether writes wait, as they do while a codec switches mode.
+     *
+     * @param isBlocked Whether writes wait.
+     */
+    void setBlocked(bool isBlocked) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isBlocked = isBlocked;
+        m_changed.notify_all();
+    }
+
+    /**
+     * Waits for a write to start.
+     *
+     * @return Whether a write started before @c TIMEOUT.
+     */
+    bool waitForWriteToStart() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, TIMEOUT, [this] { return m_isWriting; });
+    }
+
+    /**
+     * Waits for a number of writes to finish.
+     *
+     * @param count The number of writes.
+     * @param timeout How long to wait.
+     * @return The modes written.
+     */
+    std::vector<CaptureMode> waitForWrites(size_t count, std::chrono::milliseconds timeout = TIMEOUT) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait_for(lock, timeout, [this, count] { return m_writes.size() >= count; });
+        return m_writes;
+    }
+
+private:
+    /// The pipe events are raised through.
+    int m_pipe[2];
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when any of the members below change.
+    std::condition_variable m_changed;
+
+    /// Whether writes wait.
+    bool m_isBlocked;
+
+    /// Whether a write is in progress.
+    bool m_isWriting;
+
+    /// The modes written.
+    std::vector<CaptureMode> m_writes;
+};
+
+/// Test harness for @c AlsaHardwareController.
+class AlsaHardwareControllerTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /// The device, owned by @c m_controller.
+    FakeCtlDevice* m_device;
+
+    /// The controller.
+    std::shared_ptr<AlsaHardwareController> m_controller;
+};
+
+void AlsaHardwareControllerTest::SetUp() {
+    std::unique_ptr<FakeCtlDevice> device(new FakeCtlDevice());
+    m_device = device.get();
+    m_controller = AlsaHardwareController::create(std::move(device), KEYWORD);
+    ASSERT_TRUE(m_controller);
+}
+
+/// Test that create() rejects a missing device.
+TEST_F(AlsaHardwareControllerTest, createWithoutDevice) {
+    EXPECT_FALSE(AlsaHardwareController::create(std::unique_ptr<CtlDeviceInterface>(), KEYWORD));
+}
+
+/// Test that read() returns detections in order, timestamped when they were raised, and skips other events.
+TEST_F(AlsaHardwareControllerTest, readsDetections) {
+    EXPECT_FALSE(m_controller->read(SHORT_TIMEOUT));
+
+    auto before = std::chrono::steady_clock::now();
+    m_device->raiseEvent(-1, 0);
+    m_device->raiseEvent(100, 200);
+    m_device->raiseEvent(300, 400);
+    auto detection = m_controller->read(TIMEOUT);
+    ASSERT_TRUE(detection);
+    EXPECT_EQ(100, detection->getBegin());
+    EXPECT_EQ(200, detection->getEnd());
+    EXPECT_EQ(KEYWORD, detection->getKeyword());
+    EXPECT_GE(detection->getTime(), before);
+    EXPECT_LE(detection->getTime(), std::chrono::steady_clock::now());
+
+    detection = m_controller->read(TIMEOUT);
+    ASSERT_TRUE(detection);
+    EXPECT_EQ(300, detection->getBegin());
+    EXPECT_FALSE(m_controller->read(SHORT_TIMEOUT));
+}
+
+/// Test that the states map to modes, and a mode which is already set is not written again.
+TEST_F(AlsaHardwareControllerTest, writesModeForStates) {
+    m_controller->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    ASSERT_EQ(1u, m_device->waitForWrites(1).size());
+    m_controller->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    m_controller->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::THINKING);
+    m_controller->onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING);
+    m_controller->onStateChanged(AudioInputProcessorObserverInterface::State::EXPECTING_SPEECH);
+    auto writes = m_device->waitForWrites(2);
+    EXPECT_EQ(std::vector<CaptureMode>({CaptureMode::WAKE_ON_VOICE, CaptureMode::CAPTURE_STREAMING}), writes);
+    EXPECT_EQ(2u, m_device->waitForWrites(3, SHORT_TIMEOUT).size());
+
+    auto statistics = m_controller->getControlWriteStatistics();
+    EXPECT_EQ(3u, statistics.requests);
+    EXPECT_EQ(2u, statistics.writes);
+    EXPECT_EQ(0u, statistics.failures);
+}
+
+/**
+ * Test that callbacks return while a write is held up, the requests made meanwhile are coalesced into a write of the
+ * latest mode, and detections are still read.
+ */
+TEST_F(AlsaHardwareControllerTest, coalescesRequestsWhileWriting) {
+    m_device->setBlocked(true);
+    m_controller->onStateChanged(AudioInputProcessorObserverInterface::State::EXPECTING_SPEECH);
+    ASSERT_TRUE(m_device->waitForWriteToStart());
+
+    auto start = std::chrono::steady_clock::now();
+    m_controller->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    m_controller->onStateChanged(AudioInputProcessorObserverInterface::State::EXPECTING_SPEECH);
+    m_controller->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    auto callbackTime = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(callbackTime, SHORT_TIMEOUT);
+
+    m_device->raiseEvent(100, 200);
+    std::this_thread::sleep_for(SHORT_TIMEOUT);
+    m_device->setBlocked(false);
+    auto writes = m_device->waitForWrites(2);
+    EXPECT_EQ(std::vector<CaptureMode>({CaptureMode::CAPTURE_STREAMING, CaptureMode::WAKE_ON_VOICE}), writes);
+    EXPECT_EQ(2u, m_device->waitForWrites(3, SHORT_TIMEOUT).size());
+    EXPECT_TRUE(m_controller->read(TIMEOUT));
+
+    auto statistics = m_controller->getControlWriteStatistics();
+    EXPECT_EQ(4u, statistics.requests);
+    EXPECT_EQ(2u, statistics.coalesced);
+    EXPECT_EQ(2u, statistics.writes);
+    EXPECT_GE(statistics.maxLatency, SHORT_TIMEOUT);
+    EXPECT_GE(statistics.totalLatency, statistics.maxLatency);
+    std::cout << "Callbacks took " << std::chrono::duration_cast<std::chrono::microseconds>(callbackTime).count()
+              << " us while a write was held up; control write latency: max "
+              << statistics.maxLatency.count() / 1000 << " us, last " << statistics.lastLatency.count() / 1000
+              << " us" << std::endl;
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
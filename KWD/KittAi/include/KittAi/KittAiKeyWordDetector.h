@@ -57,7 +57,7 @@ public:
      * Creates a @c KittAiKeyWordDetector.
      *
      * @param stream The stream of audio data. This should be formatted in LPCM encoded with 16 bits per sample and
-     * have a sample rate of 16 kHz. Additionally, the data should be in little endian format.
+     * have a sample rate of 16 kHz. Data in the other byte order from the platform's is swapped as it is read.
      * @param audioFormat The format of the audio data located within the stream.
      * @param keyWordObservers The observers to notify of keyword detections.
      * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
@@ -95,7 +95,7 @@ private:
      * Constructor.
      *
      * @param stream The stream of audio data. This should be formatted in LPCM encoded with 16 bits per sample and
-     * have a sample rate of 16 kHz. Additionally, the data should be in little endian format.
+     * have a sample rate of 16 kHz. Data in the other byte order from the platform's is swapped as it is read.
      * @param audioFormat The format of the audio data located within the stream.
      * @param keyWordObservers The observers to notify of keyword detections.
      * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
@@ -169,6 +169,9 @@ private:
      * sampling rate of the audio data passed in.
      */
     const size_t m_maxSamplesPerPush;
+
+    /// Whether the stream is in the other byte order from the platform's, so that each block must be swapped.
+    const bool m_isByteswappingRequired;
 };
 
 }  // namespace kwd
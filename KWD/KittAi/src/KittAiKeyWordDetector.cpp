@@ -16,6 +16,7 @@
 #include <memory>
 #include <sstream>
 
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 
@@ -51,10 +52,6 @@ static const std::string KITT_DELIMITER = ",";
 static const avsCommon::utils::AudioFormat::Encoding KITT_AI_COMPATIBLE_ENCODING =
     avsCommon::utils::AudioFormat::Encoding::LPCM;
 
-/// The Kitt.ai compatible endianness which is little endian.
-static const avsCommon::utils::AudioFormat::Endianness KITT_AI_COMPATIBLE_ENDIANNESS =
-    avsCommon::utils::AudioFormat::Endianness::LITTLE;
-
 /// Kitt.ai returns -2 if silence is detected.
 static const int KITT_AI_SILENCE_DETECTION_RESULT = -2;
 
@@ -78,11 +75,6 @@ std::unique_ptr<KittAiKeyWordDetector> KittAiKeyWordDetector::create(
         ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
         return nullptr;
     }
-    // TODO: ACSDK-249 - Investigate cpu usage of converting bytes between endianness and if it's not too much, do it.
-    if (isByteswappingRequired(audioFormat)) {
-        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
-        return nullptr;
-    }
     std::unique_ptr<KittAiKeyWordDetector> detector(new KittAiKeyWordDetector(
         stream,
         audioFormat,
@@ -119,7 +111,8 @@ KittAiKeyWordDetector::KittAiKeyWordDetector(
     std::chrono::milliseconds msToPushPerIteration) :
         AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
         m_stream{stream},
-        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()} {
+        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()},
+        m_isByteswappingRequired{isByteswappingRequired(audioFormat)} {
     std::stringstream sensitivities;
     std::stringstream modelPaths;
     for (unsigned int i = 0; i < kittAiConfigurations.size(); ++i) {
@@ -173,13 +166,6 @@ bool KittAiKeyWordDetector::isAudioFormatCompatibleWithKittAi(avsCommon::utils::
                         .d("sampleSizeInBits", audioFormat.sampleSizeInBits));
         return false;
     }
-    if (audioFormat.endianness != KITT_AI_COMPATIBLE_ENDIANNESS) {
-        ACSDK_ERROR(LX("isAudioFormatCompatibleWithKittAiFailed")
-                        .d("reason", "endiannessMismatch")
-                        .d("kittAiEndianness", KITT_AI_COMPATIBLE_ENDIANNESS)
-                        .d("endianness", audioFormat.endianness));
-        return false;
-    }
     if (audioFormat.encoding != KITT_AI_COMPATIBLE_ENCODING) {
         ACSDK_ERROR(LX("isAudioFormatCompatibleWithKittAiFailed")
                         .d("reason", "encodingMismatch")
@@ -203,6 +189,9 @@ void KittAiKeyWordDetector::detectionLoop() {
         } else if (wordsRead > 0) {
             // Words were successfully read.
             notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+            if (m_isByteswappingRequired) {
+                avsCommon::utils::audio::kernels::byteswap16(audioDataToPush, audioDataToPush, wordsRead);
+            }
             int detectionResult = m_kittAiEngine->RunDetection(audioDataToPush, wordsRead);
             if (detectionResult > 0) {
                 // > 0 indicates a keyword was found
@@ -319,8 +319,8 @@ TEST_F(KittAiKeyWordTest, invalidStream) {
     ASSERT_FALSE(detector);
 }
 
-/// Tests that we don't get back a valid detector if an invalid endianness is passed in.
-TEST_F(KittAiKeyWordTest, incompatibleEndianness) {
+/// Tests that we get back a valid detector for a stream in the other byte order, which the detector converts.
+TEST_F(KittAiKeyWordTest, otherEndiannessIsConverted) {
     auto rawBuffer = std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(500000);
     auto uniqueSds = avsCommon::avs::AudioInputStream::create(rawBuffer, 2, 1);
     std::shared_ptr<AudioInputStream> sds = std::move(uniqueSds);
@@ -336,7 +336,7 @@ TEST_F(KittAiKeyWordTest, incompatibleEndianness) {
         {config},
         1.0,
         false);
-    ASSERT_FALSE(detector);
+    ASSERT_TRUE(detector);
 }
 
 /// Tests that we get back the expected number of keywords for the four_alexa.wav file for one keyword observer.
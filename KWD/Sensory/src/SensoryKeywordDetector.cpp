@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "Sensory/SensoryKeywordDetector.h"
@@ -53,10 +54,6 @@ static const unsigned int SENSORY_COMPATIBLE_NUM_CHANNELS = 1;
 static const avsCommon::utils::AudioFormat::Encoding SENSORY_COMPATIBLE_ENCODING =
     avsCommon::utils::AudioFormat::Encoding::LPCM;
 
-/// The Sensory compatible endianness which is little endian.
-static const avsCommon::utils::AudioFormat::Endianness SENSORY_COMPATIBLE_ENDIANNESS =
-    avsCommon::utils::AudioFormat::Endianness::LITTLE;
-
 /**
  * Checks to see if an @c avsCommon::utils::AudioFormat is compatible with Sensory.
  *
@@ -71,13 +68,6 @@ static bool isAudioFormatCompatibleWithSensory(avsCommon::utils::AudioFormat aud
                         .d("encoding", audioFormat.encoding));
         return false;
     }
-    if (SENSORY_COMPATIBLE_ENDIANNESS != audioFormat.endianness) {
-        ACSDK_ERROR(LX("isAudioFormatCompatibleWithSensoryFailed")
-                        .d("reason", "incompatibleEndianess")
-                        .d("sensoryEndianness", SENSORY_COMPATIBLE_ENDIANNESS)
-                        .d("endianness", audioFormat.endianness));
-        return false;
-    }
     if (SENSORY_COMPATIBLE_SAMPLE_RATE != audioFormat.sampleRateHz) {
         ACSDK_ERROR(LX("isAudioFormatCompatibleWithSensoryFailed")
                         .d("reason", "incompatibleSampleRate")
@@ -175,12 +165,6 @@ std::unique_ptr<SensoryKeywordDetector> SensoryKeywordDetector::create(
         return nullptr;
     }
 
-    // TODO: ACSDK-249 - Investigate cpu usage of converting bytes between endianness and if it's not too much, do it.
-    if (isByteswappingRequired(audioFormat)) {
-        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
-        return nullptr;
-    }
-
     if (!isAudioFormatCompatibleWithSensory(audioFormat)) {
         return nullptr;
     }
@@ -210,7 +194,8 @@ SensoryKeywordDetector::SensoryKeywordDetector(
         AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
         m_stream{stream},
         m_session{nullptr},
-        m_maxSamplesPerPush((audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()) {
+        m_maxSamplesPerPush((audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()),
+        m_isByteswappingRequired{isByteswappingRequired(audioFormat)} {
 }
 
 bool SensoryKeywordDetector::init(const std::string& modelFilePath) {
@@ -353,6 +338,10 @@ void SensoryKeywordDetector::detectionLoop() {
             m_session = newSession;
         } else if (wordsRead > 0) {
             // Words were successfully read.
+            if (m_isByteswappingRequired) {
+                avsCommon::utils::audio::kernels::byteswap16(
+                    audioDataToPush.data(), audioDataToPush.data(), wordsRead);
+            }
             snsrSetStream(
                 m_session,
                 SNSR_SOURCE_AUDIO_PCM,
@@ -322,8 +322,8 @@ TEST_F(SensoryKeywordTest, invalidStream) {
     ASSERT_FALSE(detector);
 }
 
-/// Tests that we don't get back a valid detector if an invalid endianness is passed in.
-TEST_F(SensoryKeywordTest, incompatibleEndianness) {
+/// Tests that we get back a valid detector for a stream in the other byte order, which the detector converts.
+TEST_F(SensoryKeywordTest, otherEndiannessIsConverted) {
     auto rawBuffer = std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(500000);
     auto uniqueSds = avsCommon::avs::AudioInputStream::create(rawBuffer, 2, 1);
     std::shared_ptr<AudioInputStream> sds = std::move(uniqueSds);
@@ -332,7 +332,7 @@ TEST_F(SensoryKeywordTest, incompatibleEndianness) {
 
     auto detector =
         SensoryKeywordDetector::create(sds, compatibleAudioFormat, {keyWordObserver1}, {stateObserver}, modelFilePath);
-    ASSERT_FALSE(detector);
+    ASSERT_TRUE(detector);
 }
 
 /// Tests that we get back the expected number of keywords for the four_alexa.wav file for one keyword observer.
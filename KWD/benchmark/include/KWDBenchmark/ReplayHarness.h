@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_REPLAYHARNESS_H_
+#define ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_REPLAYHARNESS_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <KWD/AbstractKeywordDetector.h>
+
+#include "KWDBenchmark/WavCorpus.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+/**
+ * Replays a @c WavCorpus to a keyword detector through an @c AudioInputStream, as a microphone would, and measures how
+ * the detector did: which keywords it found and how late, how much CPU time it took per second of audio, and how often
+ * it fell so far behind that its reader was overrun.
+ *
+ * The recordings are written one after another, each followed by some silence, in chunks paced at a multiple of real
+ * time, or as fast as they can be written.  The detector is made by a factory, so that any @c AbstractKeywordDetector
+ * can be replayed to.
+ */
+class ReplayHarness {
+public:
+    /**
+     * Makes a detector which reads a stream and notifies an observer of keywords.
+     *
+     * @param stream The stream.
+     * @param audioFormat The format of the stream.
+     * @param observer The observer.
+     * @return The detector, or @c nullptr if the detector could not be made.
+     */
+    using DetectorFactory = std::function<std::unique_ptr<AbstractKeywordDetector>(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface> observer)>;
+
+    /// The settings of a replay.
+    struct Config {
+        /// Constructor, which sets the defaults.
+        Config();
+
+        /// How many times faster than real time to write the audio, or 0 to write it as fast as possible.
+        double speed;
+        /// The amount of audio written at a time.
+        std::chrono::milliseconds chunkDuration;
+        /// The silence written after each recording, so that the detector can finish with it.
+        std::chrono::milliseconds tailDuration;
+        /// How long to wait after writing everything for the detector to finish.
+        std::chrono::milliseconds drainDuration;
+        /// The amount of audio the stream holds.
+        std::chrono::milliseconds bufferDuration;
+        /// How far from the end of a labelled keyword a detection of it may end and still be taken for it.
+        std::chrono::milliseconds matchTolerance;
+    };
+
+    /// A keyword the detector found.
+    struct Detection {
+        /// The name of the recording the keyword was found in.
+        std::string recording;
+        /// The keyword.
+        std::string keyword;
+        /// Where the keyword ends from the start of the recording, by the detector.
+        std::chrono::milliseconds end;
+        /**
+         * How much later than the labelled end the detector said the keyword ends, which is negative if it said
+         * earlier.  This is only valid if @c matched.
+         */
+        std::chrono::milliseconds endError;
+        /**
+         * How long after the labelled end of the keyword was written the detector notified its observer, which is
+         * negative if it notified before.  This is only valid if @c matched.
+         */
+        std::chrono::microseconds latency;
+        /// Whether the detection matches a labelled keyword.
+        bool matched;
+    };
+
+    /// What a replay measured.
+    struct Report {
+        /// The seconds of audio written, including the silence after each recording.
+        double audioSeconds;
+        /// How long the replay took.
+        std::chrono::microseconds wallTime;
+        /// The CPU time the process spent other than writing.
+        std::chrono::microseconds detectorCpuTime;
+        /// The CPU time spent writing.
+        std::chrono::microseconds writerCpuTime;
+        /// The number of times the detector's reader was overrun.
+        uint64_t overruns;
+        /// The keywords the detector found, in the order it found them.
+        std::vector<Detection> detections;
+        /// The number of labelled keywords.
+        size_t labels;
+        /// The number of labelled keywords the detector found.
+        size_t hits;
+        /// The number of labelled keywords the detector did not find.
+        size_t misses;
+        /// The number of keywords the detector found which were not labelled.
+        size_t falseAlarms;
+    };
+
+    /**
+     * Creates a @c ReplayHarness.
+     *
+     * @param factory The factory of the detector.
+     * @param config The settings of the replay.
+     * @return The harness, or @c nullptr if the factory or the settings are invalid.
+     */
+    static std::unique_ptr<ReplayHarness> create(DetectorFactory factory, const Config& config = Config());
+
+    /**
+     * Replays a corpus to a new detector.
+     *
+     * @param corpus The corpus.
+     * @param[out] report What the replay measured.
+     * @return Whether the replay ran.
+     */
+    bool run(const WavCorpus& corpus, Report* report);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param factory The factory of the detector.
+     * @param config The settings of the replay.
+     */
+    ReplayHarness(DetectorFactory factory, const Config& config);
+
+    /// The factory of the detector.
+    const DetectorFactory m_factory;
+
+    /// The settings of the replay.
+    const Config m_config;
+};
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_REPLAYHARNESS_H_
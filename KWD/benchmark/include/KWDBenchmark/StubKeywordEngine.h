@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_STUBKEYWORDENGINE_H_
+#define ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_STUBKEYWORDENGINE_H_
+
+#include <string>
+#include <vector>
+
+#include <KWD/KeywordEngineInterface.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+/**
+ * A deterministic stand-in for a keyword spotting engine, for benchmarking the keyword detection pipeline when no real
+ * engine is installed.
+ *
+ * Each 10 ms frame is projected onto a bank of cosine filters, which costs about as much per sample as the feature
+ * extraction of a small engine, and the energy of the projections is taken as the level of the frame.  A keyword is
+ * reported at the end of each stretch of frames whose level rises far enough above the noise floor for long enough.
+ * The keywords depend only on the audio, so the same audio always gives the same keywords at the same indices.
+ */
+class StubKeywordEngine : public KeywordEngineInterface {
+public:
+    /// The settings of the engine.
+    struct Config {
+        /// Constructor, which sets the defaults.
+        Config();
+
+        /// The keyword to report.
+        std::string keyword;
+        /// How far above the noise floor, in dB, a frame must be to be part of a keyword.
+        float riseDb;
+        /// The fewest consecutive frames which make a keyword.
+        size_t minFrames;
+        /// The number of filters each frame is projected onto.
+        size_t numFilters;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param config The settings of the engine.
+     */
+    StubKeywordEngine(const Config& config = Config());
+
+    /// @name KeywordEngineInterface Functions
+    /// @{
+    std::string getName() const override;
+    void reset() override;
+    void process(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override;
+    /// @}
+
+private:
+    /**
+     * Measures a frame, and finds whether a keyword ends with it.
+     *
+     * @param frameEndIndex The index in the stream of the sample after the frame.
+     * @param[out] detections The keywords found, which are appended to.
+     */
+    void processFrame(avsCommon::avs::AudioInputStream::Index frameEndIndex, std::vector<Detection>* detections);
+
+    /// The settings of the engine.
+    const Config m_config;
+
+    /// The filters, one after another.
+    std::vector<float> m_filters;
+
+    /// The samples of the current frame.
+    std::vector<float> m_frame;
+
+    /// The number of samples of the current frame so far.
+    size_t m_frameFill;
+
+    /// The level of the noise floor, in dB, or a negative value before the first frame.
+    float m_floorDb;
+
+    /// The number of consecutive frames above the floor.
+    size_t m_activeFrames;
+
+    /// The index in the stream of the first sample of the current stretch of frames above the floor.
+    avsCommon::avs::AudioInputStream::Index m_activeBeginIndex;
+};
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_STUBKEYWORDENGINE_H_
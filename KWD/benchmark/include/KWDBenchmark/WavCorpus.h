@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_WAVCORPUS_H_
+#define ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_WAVCORPUS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+/**
+ * The recordings of a directory, which a @c ReplayHarness replays to a keyword detector.
+ *
+ * Every @c .wav file in the directory is loaded, in name order, and must be 16 kHz, 16-bit mono PCM, which is the
+ * format the keyword detectors take.  A recording may be labelled with the keywords spoken in it by a file of the same
+ * name with the extension @c .labels, each line of which is a keyword and the time its utterance ends in
+ * milliseconds, such as:
+ *
+ * @code
+ * # keyword endMs
+ * ALEXA 1340
+ * @endcode
+ *
+ * Blank lines and lines starting with @c # are ignored.
+ */
+class WavCorpus {
+public:
+    /// A keyword spoken in a recording.
+    struct Label {
+        /// The keyword.
+        std::string keyword;
+        /// The time from the start of the recording at which the keyword ends.
+        std::chrono::milliseconds end;
+    };
+
+    /// A recording and its labels.
+    struct Recording {
+        /// The name of the file of the recording.
+        std::string name;
+        /// The samples.
+        std::vector<int16_t> samples;
+        /// The keywords spoken in the recording, which is empty if the recording is not labelled.
+        std::vector<Label> labels;
+    };
+
+    /// The sample rate the recordings must have.
+    static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+    /**
+     * Loads the recordings of a directory.
+     *
+     * @param directory The directory.
+     * @return The recordings, or @c nullptr if the directory has no recordings or any of them, or their labels, could
+     *     not be read.
+     */
+    static std::unique_ptr<WavCorpus> create(const std::string& directory);
+
+    /**
+     * Reads a 16 kHz, 16-bit mono PCM WAV file with @c avsCommon::utils::audio::readWavFile().
+     *
+     * @param path The path of the file.
+     * @param[out] samples The samples.
+     * @return Whether the file was read.
+     */
+    static bool readWav(const std::string& path, std::vector<int16_t>* samples);
+
+    /**
+     * Reads a labels file.
+     *
+     * @param path The path of the file.
+     * @param[out] labels The labels.
+     * @return Whether the file was read.
+     */
+    static bool readLabels(const std::string& path, std::vector<Label>* labels);
+
+    /**
+     * Gets the recordings.
+     *
+     * @return The recordings, in name order.
+     */
+    const std::vector<Recording>& getRecordings() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param recordings The recordings.
+     */
+    WavCorpus(std::vector<Recording> recordings);
+
+    /// The recordings, in name order.
+    const std::vector<Recording> m_recordings;
+};
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_BENCHMARK_INCLUDE_KWDBENCHMARK_WAVCORPUS_H_
@@ -0,0 +1,287 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file KeywordDetectorBenchmark.cpp
+///
+/// Replays directories of recordings to a keyword detector and reports how it did.  Run with no arguments for usage.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <KWD/KeywordDetectorHost.h>
+
+#ifdef KWD_KITTAI
+#include <KittAi/KittAiKeyWordDetector.h>
+#endif
+#ifdef KWD_SENSORY
+#include <Sensory/SensoryKeywordDetector.h>
+#endif
+
+#include "KWDBenchmark/ReplayHarness.h"
+#include "KWDBenchmark/StubKeywordEngine.h"
+#include "KWDBenchmark/WavCorpus.h"
+
+using namespace alexaClientSDK;
+using namespace alexaClientSDK::avsCommon::avs;
+using namespace alexaClientSDK::avsCommon::sdkInterfaces;
+using namespace alexaClientSDK::kwd;
+using namespace alexaClientSDK::kwd::benchmark;
+
+#ifdef KWD_KITTAI
+/// The audio amplifier level of the Kitt.ai engine, which is what the SampleApp uses.
+static const float KITT_AI_AUDIO_GAIN = 2.0;
+
+/// Whether the Kitt.ai engine applies its front end processing, which is what the SampleApp does.
+static const bool KITT_AI_APPLY_FRONT_END_PROCESSING = true;
+#endif
+
+/// The settings of the benchmark which are not settings of the replay.
+struct Options {
+    /// The detector to replay to.
+    std::string engine = "stub";
+    /// The model of the detector.
+    std::string model;
+    /// The resource file of the detector.
+    std::string resource;
+    /// The keyword of the detector.
+    std::string keyword = "ALEXA";
+    /// The sensitivity of the detector.
+    double sensitivity = 0.6;
+    /// Whether to print each detection.
+    bool verbose = false;
+    /// The directories of recordings.
+    std::vector<std::string> directories;
+};
+
+/**
+ * Prints how to run the benchmark.
+ *
+ * @param program The name of the program.
+ */
+static void printUsage(const std::string& program) {
+    std::cerr << "USAGE: " << program << " [options] <wav_directory>...\n"
+              << "  --engine <name>         detector to replay to: stub"
+#ifdef KWD_KITTAI
+              << ", kittai"
+#endif
+#ifdef KWD_SENSORY
+              << ", sensory"
+#endif
+              << " (default stub)\n"
+              << "  --speed <multiple>      multiple of real time to replay at, or 0 for unthrottled (default 1)\n"
+              << "  --tail <ms>             silence after each recording (default 500)\n"
+              << "  --drain <ms>            wait after the last recording (default 1000)\n"
+              << "  --buffer <ms>           audio the stream holds (default 15000)\n"
+              << "  --tolerance <ms>        how far a detection may end from its label (default 500)\n"
+              << "  --model <path>          model of the detector (kittai .umdl, sensory .snsr)\n"
+              << "  --resource <path>       resource file of the detector (kittai common.res)\n"
+              << "  --keyword <keyword>     keyword of the detector (default ALEXA)\n"
+              << "  --sensitivity <value>   sensitivity of the detector (default 0.6)\n"
+              << "  --verbose               print each detection\n"
+              << "Each <name>.wav may be labelled by a <name>.labels file of \"<keyword> <endMs>\" lines."
+              << std::endl;
+}
+
+/**
+ * Parses the command line.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param[out] config The settings of the replay.
+ * @param[out] options The other settings.
+ * @return Whether the command line is valid.
+ */
+static bool parseArguments(int argc, char** argv, ReplayHarness::Config* config, Options* options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ("--verbose" == argument) {
+            options->verbose = true;
+        } else if (argument.compare(0, 2, "--") != 0) {
+            options->directories.push_back(argument);
+        } else if (!hasValue) {
+            std::cerr << "Missing value of " << argument << std::endl;
+            return false;
+        } else {
+            std::string value = argv[++i];
+            if ("--engine" == argument) {
+                options->engine = value;
+            } else if ("--speed" == argument) {
+                config->speed = std::atof(value.c_str());
+            } else if ("--tail" == argument) {
+                config->tailDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--drain" == argument) {
+                config->drainDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--buffer" == argument) {
+                config->bufferDuration = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--tolerance" == argument) {
+                config->matchTolerance = std::chrono::milliseconds(std::atoi(value.c_str()));
+            } else if ("--model" == argument) {
+                options->model = value;
+            } else if ("--resource" == argument) {
+                options->resource = value;
+            } else if ("--keyword" == argument) {
+                options->keyword = value;
+            } else if ("--sensitivity" == argument) {
+                options->sensitivity = std::atof(value.c_str());
+            } else {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return false;
+            }
+        }
+    }
+    return !options->directories.empty();
+}
+
+/**
+ * Makes the factory of the detector the options name.
+ *
+ * @param options The settings of the benchmark.
+ * @return The factory, or an empty function if the detector is not available in this build.
+ */
+static ReplayHarness::DetectorFactory createFactory(const Options& options) {
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> stateObservers;
+    if ("stub" == options.engine) {
+        StubKeywordEngine::Config engineConfig;
+        engineConfig.keyword = options.keyword;
+        return [engineConfig, stateObservers](
+                   std::shared_ptr<AudioInputStream> stream,
+                   avsCommon::utils::AudioFormat audioFormat,
+                   std::shared_ptr<KeyWordObserverInterface> observer) -> std::unique_ptr<AbstractKeywordDetector> {
+            return KeywordDetectorHost::create(
+                stream, audioFormat, {std::make_shared<StubKeywordEngine>(engineConfig)}, {observer}, stateObservers);
+        };
+    }
+#ifdef KWD_KITTAI
+    if ("kittai" == options.engine) {
+        return [options, stateObservers](
+                   std::shared_ptr<AudioInputStream> stream,
+                   avsCommon::utils::AudioFormat audioFormat,
+                   std::shared_ptr<KeyWordObserverInterface> observer) -> std::unique_ptr<AbstractKeywordDetector> {
+            return KittAiKeyWordDetector::create(
+                stream,
+                audioFormat,
+                {observer},
+                stateObservers,
+                options.resource,
+                {{options.model, options.keyword, options.sensitivity}},
+                KITT_AI_AUDIO_GAIN,
+                KITT_AI_APPLY_FRONT_END_PROCESSING);
+        };
+    }
+#endif
+#ifdef KWD_SENSORY
+    if ("sensory" == options.engine) {
+        return [options, stateObservers](
+                   std::shared_ptr<AudioInputStream> stream,
+                   avsCommon::utils::AudioFormat audioFormat,
+                   std::shared_ptr<KeyWordObserverInterface> observer) -> std::unique_ptr<AbstractKeywordDetector> {
+            return SensoryKeywordDetector::create(stream, audioFormat, {observer}, stateObservers, options.model);
+        };
+    }
+#endif
+    return ReplayHarness::DetectorFactory();
+}
+
+/**
+ * Prints what a replay measured.
+ *
+ * @param report What the replay measured.
+ * @param verbose Whether to print each detection.
+ */
+static void printReport(const ReplayHarness::Report& report, bool verbose) {
+    int64_t totalEndError = 0;
+    int64_t maxEndError = 0;
+    std::vector<int64_t> latencies;
+    for (const auto& detection : report.detections) {
+        if (verbose) {
+            std::cout << "  " << detection.recording << ": " << detection.keyword << " ending at "
+                      << detection.end.count() << " ms";
+            if (detection.matched) {
+                std::cout << ", " << detection.endError.count() << " ms from the label, notified "
+                          << detection.latency.count() / 1000.0 << " ms after the labelled end was written";
+            } else {
+                std::cout << ", false alarm";
+            }
+            std::cout << std::endl;
+        }
+        if (detection.matched) {
+            totalEndError += detection.endError.count();
+            maxEndError = std::max<int64_t>(maxEndError, std::abs(detection.endError.count()));
+            latencies.push_back(detection.latency.count());
+        }
+    }
+    std::cout << "  Audio: " << report.audioSeconds << " s, replayed in " << report.wallTime.count() / 1000000.0
+              << " s\n"
+              << "  Detections: " << report.detections.size() << " (" << report.hits << " of " << report.labels
+              << " labels found, " << report.misses << " missed, " << report.falseAlarms << " false alarms)\n";
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "  End error: mean " << totalEndError / static_cast<int64_t>(latencies.size()) << " ms, max |"
+                  << maxEndError << "| ms\n"
+                  << "  Latency from the labelled end being written: median "
+                  << latencies[latencies.size() / 2] / 1000.0 << " ms, max " << latencies.back() / 1000.0 << " ms\n";
+    }
+    std::cout << "  Detector CPU: " << report.detectorCpuTime.count() / report.audioSeconds
+              << " us per audio second (" << report.detectorCpuTime.count() / (report.audioSeconds * 10000.0)
+              << "% of a core in real time)\n"
+              << "  Writer CPU: " << report.writerCpuTime.count() / report.audioSeconds << " us per audio second\n"
+              << "  Overruns: " << report.overruns << std::endl;
+}
+
+int main(int argc, char** argv) {
+    ReplayHarness::Config config;
+    Options options;
+    if (!parseArguments(argc, argv, &config, &options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    auto factory = createFactory(options);
+    if (!factory) {
+        std::cerr << "The " << options.engine << " detector is not available in this build" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto harness = ReplayHarness::create(factory, config);
+    if (!harness) {
+        std::cerr << "Invalid replay settings" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Detector: " << options.engine << ", speed: ";
+    if (config.speed > 0.0) {
+        std::cout << config.speed << "x real time" << std::endl;
+    } else {
+        std::cout << "unthrottled" << std::endl;
+    }
+
+    int result = EXIT_SUCCESS;
+    for (const auto& directory : options.directories) {
+        std::cout << directory << ":" << std::endl;
+        auto corpus = WavCorpus::create(directory);
+        ReplayHarness::Report report;
+        if (!corpus) {
+            std::cout << "  Unable to load the recordings" << std::endl;
+            result = EXIT_FAILURE;
+        } else if (!harness->run(*corpus, &report)) {
+            std::cout << "  Unable to replay the recordings" << std::endl;
+            result = EXIT_FAILURE;
+        } else {
+            printReport(report, options.verbose);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWDBenchmark/ReplayHarness.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ReplayHarness");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of samples per millisecond of the recordings.
+static const size_t SAMPLES_PER_MS = WavCorpus::SAMPLE_RATE_HZ / 1000;
+
+/// The size of a sample in bytes.
+static const size_t WORD_SIZE = sizeof(int16_t);
+
+/// The most readers the stream allows, which is what the SampleApp allows.
+static const size_t MAX_READERS = 10;
+
+/// A keyword the detector notified its observer of.
+struct Notification {
+    /// The keyword.
+    std::string keyword;
+    /// The index in the stream of the sample after the keyword.
+    AudioInputStream::Index endIndex;
+    /// When the observer was notified.
+    std::chrono::steady_clock::time_point time;
+};
+
+/// An observer which records the keywords the detector finds.
+class ReplayObserver : public KeyWordObserverInterface {
+public:
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_notifications.push_back({keyword, endIndex, now});
+    }
+
+    /**
+     * Gets the keywords the detector found.
+     *
+     * @return The keywords, in the order they were found.
+     */
+    std::vector<Notification> getNotifications() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_notifications;
+    }
+
+private:
+    /// Serializes access to @c m_notifications.
+    std::mutex m_mutex;
+
+    /// The keywords found, in the order they were found.
+    std::vector<Notification> m_notifications;
+};
+
+/// A chunk of audio the harness has written.
+struct WriteRecord {
+    /// The index in the stream of the sample after the chunk.
+    AudioInputStream::Index endIndex;
+    /// When the chunk was written.
+    std::chrono::steady_clock::time_point time;
+};
+
+/// Where a recording was written in the stream.
+struct Placement {
+    /// The index in the stream of the first sample of the recording.
+    AudioInputStream::Index beginIndex;
+    /// The index in the stream of the sample after the silence which follows the recording.
+    AudioInputStream::Index endIndex;
+};
+
+/**
+ * Gets the CPU time used by the process.
+ *
+ * @return The CPU time.
+ */
+static std::chrono::microseconds processCpuTime() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::microseconds(
+        (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/**
+ * Gets the CPU time used by the calling thread.
+ *
+ * @return The CPU time.
+ */
+static std::chrono::microseconds threadCpuTime() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::microseconds(static_cast<int64_t>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+}
+
+/**
+ * Converts a number of samples into a duration.
+ *
+ * @param samples The number of samples, which may be negative.
+ * @return The duration.
+ */
+static std::chrono::milliseconds toDuration(int64_t samples) {
+    return std::chrono::milliseconds(samples / static_cast<int64_t>(SAMPLES_PER_MS));
+}
+
+ReplayHarness::Config::Config() :
+        speed{1.0},
+        chunkDuration{10},
+        tailDuration{500},
+        drainDuration{1000},
+        bufferDuration{15000},
+        matchTolerance{500} {
+}
+
+std::unique_ptr<ReplayHarness> ReplayHarness::create(DetectorFactory factory, const Config& config) {
+    if (!factory) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullFactory"));
+        return nullptr;
+    }
+    if (config.speed < 0.0 || config.chunkDuration.count() <= 0 || config.bufferDuration <= config.chunkDuration ||
+        config.tailDuration.count() < 0 || config.drainDuration.count() < 0 || config.matchTolerance.count() < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidConfig"));
+        return nullptr;
+    }
+    return std::unique_ptr<ReplayHarness>(new ReplayHarness(factory, config));
+}
+
+bool ReplayHarness::run(const WavCorpus& corpus, Report* report) {
+    if (!report) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "nullReport"));
+        return false;
+    }
+    size_t bufferSize =
+        AudioInputStream::calculateBufferSize(m_config.bufferDuration.count() * SAMPLES_PER_MS, WORD_SIZE, MAX_READERS);
+    std::shared_ptr<AudioInputStream> stream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), WORD_SIZE, MAX_READERS);
+    if (!stream) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "createStreamFailed"));
+        return false;
+    }
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "createWriterFailed"));
+        return false;
+    }
+    AudioFormat format = {AudioFormat::Encoding::LPCM,
+                          AudioFormat::Endianness::LITTLE,
+                          WavCorpus::SAMPLE_RATE_HZ,
+                          static_cast<unsigned int>(WORD_SIZE * CHAR_BIT),
+                          1,
+                          true,
+                          AudioFormat::Layout::INTERLEAVED};
+    auto observer = std::make_shared<ReplayObserver>();
+    auto detector = m_factory(stream, format, observer);
+    if (!detector) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "createDetectorFailed"));
+        return false;
+    }
+
+    const size_t chunkSize = m_config.chunkDuration.count() * SAMPLES_PER_MS;
+    const std::vector<int16_t> silence(m_config.tailDuration.count() * SAMPLES_PER_MS, 0);
+    std::vector<WriteRecord> writes;
+    std::vector<Placement> placements;
+    size_t samplesWritten = 0;
+    auto startProcessCpuTime = processCpuTime();
+    auto startWriterCpuTime = threadCpuTime();
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto writeSamples = [&](const int16_t* samples, size_t numSamples) {
+        for (size_t offset = 0; offset < numSamples; offset += chunkSize) {
+            size_t size = std::min(chunkSize, numSamples - offset);
+            writer->write(samples + offset, size);
+            samplesWritten += size;
+            writes.push_back({writer->tell(), std::chrono::steady_clock::now()});
+            if (m_config.speed > 0.0) {
+                std::this_thread::sleep_until(
+                    startTime + std::chrono::microseconds(static_cast<int64_t>(
+                                    samplesWritten * 1000.0 / (SAMPLES_PER_MS * m_config.speed))));
+            }
+        }
+    };
+    for (const auto& recording : corpus.getRecordings()) {
+        auto beginIndex = writer->tell();
+        writeSamples(recording.samples.data(), recording.samples.size());
+        writeSamples(silence.data(), silence.size());
+        placements.push_back({beginIndex, writer->tell()});
+    }
+    auto writerCpuTime = threadCpuTime() - startWriterCpuTime;
+    std::this_thread::sleep_for(m_config.drainDuration);
+    report->wallTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    report->overruns = detector->getOverrunCount();
+    auto notifications = observer->getNotifications();
+    detector.reset();
+    report->detectorCpuTime = processCpuTime() - startProcessCpuTime - writerCpuTime;
+    report->writerCpuTime = writerCpuTime;
+    report->audioSeconds = static_cast<double>(samplesWritten) / WavCorpus::SAMPLE_RATE_HZ;
+
+    // Match each detection to the nearest labelled keyword it could be, which is not already matched.
+    const auto& recordings = corpus.getRecordings();
+    std::vector<std::vector<bool>> isLabelMatched(recordings.size());
+    for (size_t i = 0; i < recordings.size(); ++i) {
+        isLabelMatched[i].resize(recordings[i].labels.size(), false);
+    }
+    const int64_t tolerance = m_config.matchTolerance.count() * SAMPLES_PER_MS;
+    report->detections.clear();
+    report->hits = 0;
+    for (const auto& notification : notifications) {
+        auto placement = std::find_if(placements.begin(), placements.end(), [&notification](const Placement& p) {
+            return notification.endIndex > p.beginIndex && notification.endIndex <= p.endIndex;
+        });
+        if (placements.end() == placement) {
+            ACSDK_WARN(LX("unplacedDetection").d("keyword", notification.keyword).d("endIndex", notification.endIndex));
+            continue;
+        }
+        size_t recordingIndex = placement - placements.begin();
+        const auto& recording = recordings[recordingIndex];
+        Detection detection;
+        detection.recording = recording.name;
+        detection.keyword = notification.keyword;
+        detection.end = toDuration(notification.endIndex - placement->beginIndex);
+        detection.matched = false;
+        int64_t bestDistance = tolerance + 1;
+        size_t bestLabel = 0;
+        for (size_t i = 0; i < recording.labels.size(); ++i) {
+            const auto& label = recording.labels[i];
+            int64_t labelIndex = placement->beginIndex + label.end.count() * SAMPLES_PER_MS;
+            int64_t distance = std::abs(static_cast<int64_t>(notification.endIndex) - labelIndex);
+            if (!isLabelMatched[recordingIndex][i] && label.keyword == notification.keyword &&
+                distance < bestDistance) {
+                bestDistance = distance;
+                bestLabel = i;
+            }
+        }
+        if (bestDistance <= tolerance) {
+            isLabelMatched[recordingIndex][bestLabel] = true;
+            AudioInputStream::Index labelIndex =
+                placement->beginIndex + recording.labels[bestLabel].end.count() * SAMPLES_PER_MS;
+            auto written = std::lower_bound(
+                writes.begin(), writes.end(), labelIndex, [](const WriteRecord& write, AudioInputStream::Index index) {
+                    return write.endIndex < index;
+                });
+            if (writes.end() == written) {
+                --written;
+            }
+            detection.matched = true;
+            detection.endError =
+                toDuration(static_cast<int64_t>(notification.endIndex) - static_cast<int64_t>(labelIndex));
+            detection.latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(notification.time - written->time);
+            ++report->hits;
+        }
+        report->detections.push_back(detection);
+    }
+    report->labels = 0;
+    for (const auto& recording : recordings) {
+        report->labels += recording.labels.size();
+    }
+    report->misses = report->labels - report->hits;
+    report->falseAlarms = report->detections.size() - report->hits;
+    return true;
+}
+
+ReplayHarness::ReplayHarness(DetectorFactory factory, const Config& config) : m_factory{factory}, m_config(config) {
+}
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "KWDBenchmark/StubKeywordEngine.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+using namespace avsCommon::avs;
+
+/// The name of the engine.
+static const std::string NAME = "stub";
+
+/// The number of samples in a frame, which is 10 ms at 16 kHz.
+static const size_t FRAME_SIZE = 160;
+
+/// How far, in dB per frame, the noise floor may rise while no keyword is being spoken.
+static const float FLOOR_RISE_PER_FRAME_DB = 0.01f;
+
+/// Pi.
+static const float PI = 3.14159265358979f;
+
+StubKeywordEngine::Config::Config() : keyword{"ALEXA"}, riseDb{20.0f}, minFrames{20}, numFilters{40} {
+}
+
+StubKeywordEngine::StubKeywordEngine(const Config& config) :
+        m_config(config),
+        m_filters(config.numFilters * FRAME_SIZE),
+        m_frame(FRAME_SIZE) {
+    for (size_t filter = 0; filter < m_config.numFilters; ++filter) {
+        for (size_t i = 0; i < FRAME_SIZE; ++i) {
+            m_filters[filter * FRAME_SIZE + i] = std::cos(PI * (filter + 1) * (i + 0.5f) / FRAME_SIZE);
+        }
+    }
+    reset();
+}
+
+std::string StubKeywordEngine::getName() const {
+    return NAME;
+}
+
+void StubKeywordEngine::reset() {
+    m_frameFill = 0;
+    m_floorDb = -1.0f;
+    m_activeFrames = 0;
+    m_activeBeginIndex = 0;
+}
+
+void StubKeywordEngine::process(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex,
+    std::vector<Detection>* detections) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        m_frame[m_frameFill] = samples[i];
+        if (++m_frameFill == FRAME_SIZE) {
+            m_frameFill = 0;
+            processFrame(beginIndex + i + 1, detections);
+        }
+    }
+}
+
+void StubKeywordEngine::processFrame(AudioInputStream::Index frameEndIndex, std::vector<Detection>* detections) {
+    float energy = 0.0f;
+    for (size_t filter = 0; filter < m_config.numFilters; ++filter) {
+        const float* coefficients = &m_filters[filter * FRAME_SIZE];
+        float projection = 0.0f;
+        for (size_t i = 0; i < FRAME_SIZE; ++i) {
+            projection += coefficients[i] * m_frame[i];
+        }
+        energy += projection * projection;
+    }
+    float levelDb = 10.0f * std::log10(energy / (FRAME_SIZE * m_config.numFilters) + 1.0f);
+    if (m_floorDb < 0.0f) {
+        m_floorDb = levelDb;
+    }
+
+    if (levelDb > m_floorDb + m_config.riseDb) {
+        if (0 == m_activeFrames) {
+            m_activeBeginIndex = frameEndIndex - FRAME_SIZE;
+        }
+        ++m_activeFrames;
+        return;
+    }
+    if (m_activeFrames >= m_config.minFrames) {
+        detections->push_back({m_config.keyword, m_activeBeginIndex, frameEndIndex - FRAME_SIZE});
+    }
+    m_activeFrames = 0;
+    m_floorDb = std::min(levelDb, m_floorDb + FLOOR_RISE_PER_FRAME_DB);
+}
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
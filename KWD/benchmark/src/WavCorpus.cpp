@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWDBenchmark/WavCorpus.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("WavCorpus");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The extension of recordings.
+static const std::string WAV_EXTENSION = ".wav";
+
+/// The extension of labels files.
+static const std::string LABELS_EXTENSION = ".labels";
+
+/**
+ * Checks whether a string ends with a suffix.
+ *
+ * @param value The string.
+ * @param suffix The suffix.
+ * @return Whether @c value ends with @c suffix.
+ */
+static bool endsWith(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() && 0 == value.compare(value.size() - suffix.size(), suffix.size(), suffix);
+}
+
+std::unique_ptr<WavCorpus> WavCorpus::create(const std::string& directory) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "openDirectoryFailed").d("directory", directory));
+        return nullptr;
+    }
+    std::vector<std::string> names;
+    while (auto entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (endsWith(name, WAV_EXTENSION)) {
+            names.push_back(name);
+        }
+    }
+    closedir(dir);
+    if (names.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noRecordings").d("directory", directory));
+        return nullptr;
+    }
+    std::sort(names.begin(), names.end());
+
+    std::vector<Recording> recordings;
+    for (const auto& name : names) {
+        Recording recording;
+        recording.name = name;
+        auto path = directory + "/" + name;
+        if (!readWav(path, &recording.samples)) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "readWavFailed").d("path", path));
+            return nullptr;
+        }
+        auto labelsPath = path.substr(0, path.size() - WAV_EXTENSION.size()) + LABELS_EXTENSION;
+        if (std::ifstream(labelsPath).good() && !readLabels(labelsPath, &recording.labels)) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "readLabelsFailed").d("path", labelsPath));
+            return nullptr;
+        }
+        recordings.push_back(std::move(recording));
+    }
+    return std::unique_ptr<WavCorpus>(new WavCorpus(std::move(recordings)));
+}
+
+bool WavCorpus::readWav(const std::string& path, std::vector<int16_t>* samples) {
+    unsigned int sampleRateHz = 0;
+    unsigned int numChannels = 0;
+    if (!avsCommon::utils::audio::readWavFile(path, &sampleRateHz, &numChannels, samples)) {
+        ACSDK_ERROR(LX("readWavFailed").d("reason", "readWavFileFailed").d("path", path));
+        return false;
+    }
+    if (SAMPLE_RATE_HZ != sampleRateHz || 1 != numChannels) {
+        ACSDK_ERROR(LX("readWavFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("path", path)
+                        .d("sampleRateHz", sampleRateHz)
+                        .d("numChannels", numChannels));
+        return false;
+    }
+    return true;
+}
+
+bool WavCorpus::readLabels(const std::string& path, std::vector<Label>* labels) {
+    if (!labels) {
+        ACSDK_ERROR(LX("readLabelsFailed").d("reason", "nullLabels"));
+        return false;
+    }
+    std::ifstream file(path);
+    if (!file.good()) {
+        ACSDK_ERROR(LX("readLabelsFailed").d("reason", "openFailed").d("path", path));
+        return false;
+    }
+    labels->clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream stream(line);
+        std::string keyword;
+        if (!(stream >> keyword) || '#' == keyword[0]) {
+            continue;
+        }
+        long endMs = 0;
+        std::string extra;
+        if (!(stream >> endMs) || endMs < 0 || (stream >> extra)) {
+            ACSDK_ERROR(LX("readLabelsFailed").d("reason", "malformedLine").d("path", path).d("line", lineNumber));
+            return false;
+        }
+        labels->push_back({keyword, std::chrono::milliseconds(endMs)});
+    }
+    return true;
+}
+
+const std::vector<WavCorpus::Recording>& WavCorpus::getRecordings() const {
+    return m_recordings;
+}
+
+WavCorpus::WavCorpus(std::vector<Recording> recordings) : m_recordings{std::move(recordings)} {
+}
+
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ReplayHarnessTest.cpp
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <KWD/KeywordDetectorHost.h>
+
+#include "KWDBenchmark/ReplayHarness.h"
+#include "KWDBenchmark/StubKeywordEngine.h"
+#include "KWDBenchmark/WavCorpus.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace benchmark {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+/// The path to the inputs folder, which is passed on the command line.
+std::string inputsDirPath;
+
+/// The number of labelled keywords in the inputs folder.
+static const size_t NUM_LABELS = 6;
+
+/**
+ * Makes a factory of a @c KeywordDetectorHost running a @c StubKeywordEngine.
+ *
+ * @return The factory.
+ */
+static ReplayHarness::DetectorFactory createStubFactory() {
+    return [](std::shared_ptr<AudioInputStream> stream,
+              avsCommon::utils::AudioFormat audioFormat,
+              std::shared_ptr<KeyWordObserverInterface> observer) -> std::unique_ptr<AbstractKeywordDetector> {
+        return KeywordDetectorHost::create(
+            stream,
+            audioFormat,
+            {std::make_shared<StubKeywordEngine>()},
+            {observer},
+            std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>>());
+    };
+}
+
+/// Test that the recordings of a directory are loaded in name order, with their labels.
+TEST(ReplayHarnessTest, loadsRecordingsAndLabels) {
+    auto corpus = WavCorpus::create(inputsDirPath);
+    ASSERT_TRUE(corpus);
+    const auto& recordings = corpus->getRecordings();
+    ASSERT_EQ(2u, recordings.size());
+    EXPECT_EQ("alexa_stop_alexa_joke.wav", recordings[0].name);
+    EXPECT_EQ("four_alexa.wav", recordings[1].name);
+    EXPECT_FALSE(recordings[0].samples.empty());
+    ASSERT_EQ(2u, recordings[0].labels.size());
+    EXPECT_EQ("ALEXA", recordings[0].labels[0].keyword);
+    EXPECT_EQ(std::chrono::milliseconds(1310), recordings[0].labels[0].end);
+    EXPECT_EQ(4u, recordings[1].labels.size());
+
+    EXPECT_FALSE(WavCorpus::create(inputsDirPath + "/nonexistent"));
+}
+
+/// Test that malformed labels are rejected.
+TEST(ReplayHarnessTest, rejectsMalformedLabels) {
+    const std::string path = "ReplayHarnessTest.labels";
+    std::vector<WavCorpus::Label> labels;
+    std::ofstream(path) << "ALEXA 100\n\n# comment\nSTOP 200\n";
+    ASSERT_TRUE(WavCorpus::readLabels(path, &labels));
+    ASSERT_EQ(2u, labels.size());
+    EXPECT_EQ("STOP", labels[1].keyword);
+    EXPECT_EQ(std::chrono::milliseconds(200), labels[1].end);
+    std::ofstream(path) << "ALEXA\n";
+    EXPECT_FALSE(WavCorpus::readLabels(path, &labels));
+    std::ofstream(path) << "ALEXA 100 200\n";
+    EXPECT_FALSE(WavCorpus::readLabels(path, &labels));
+    std::remove(path.c_str());
+}
+
+/// Test that the stub engine finds the same keywords at the same places each time the corpus is replayed.
+TEST(ReplayHarnessTest, stubReplayIsDeterministic) {
+    auto corpus = WavCorpus::create(inputsDirPath);
+    ASSERT_TRUE(corpus);
+    ReplayHarness::Config config;
+    config.speed = 0.0;
+    config.drainDuration = std::chrono::milliseconds(200);
+    auto harness = ReplayHarness::create(createStubFactory(), config);
+    ASSERT_TRUE(harness);
+
+    ReplayHarness::Report first;
+    ReplayHarness::Report second;
+    ASSERT_TRUE(harness->run(*corpus, &first));
+    ASSERT_TRUE(harness->run(*corpus, &second));
+    EXPECT_EQ(0u, first.overruns);
+    ASSERT_FALSE(first.detections.empty());
+    ASSERT_EQ(first.detections.size(), second.detections.size());
+    for (size_t i = 0; i < first.detections.size(); ++i) {
+        EXPECT_EQ(first.detections[i].recording, second.detections[i].recording);
+        EXPECT_EQ(first.detections[i].end, second.detections[i].end);
+        EXPECT_EQ(first.detections[i].matched, second.detections[i].matched);
+    }
+    EXPECT_EQ(NUM_LABELS, first.labels);
+    EXPECT_EQ(first.labels, first.hits + first.misses);
+    EXPECT_EQ(first.detections.size(), first.hits + first.falseAlarms);
+    EXPECT_GT(first.hits, 0u);
+    EXPECT_GT(first.detectorCpuTime.count(), 0);
+}
+
+/// Test that a paced replay takes as long as the audio at that speed, and measures how late detections are notified.
+TEST(ReplayHarnessTest, pacedReplayMeasuresLatency) {
+    auto corpus = WavCorpus::create(inputsDirPath);
+    ASSERT_TRUE(corpus);
+    ReplayHarness::Config config;
+    config.speed = 4.0;
+    config.drainDuration = std::chrono::milliseconds(200);
+    auto harness = ReplayHarness::create(createStubFactory(), config);
+    ASSERT_TRUE(harness);
+
+    ReplayHarness::Report report;
+    ASSERT_TRUE(harness->run(*corpus, &report));
+    EXPECT_GE(report.wallTime.count(), static_cast<int64_t>(report.audioSeconds / config.speed * 1000000));
+    EXPECT_EQ(0u, report.overruns);
+    for (const auto& detection : report.detections) {
+        if (detection.matched) {
+            EXPECT_LE(std::abs(detection.endError.count()), config.matchTolerance.count());
+        }
+    }
+    std::cout << "Stub engine at " << config.speed << "x: " << report.hits << " of " << report.labels
+              << " labels found, " << report.falseAlarms << " false alarms, "
+              << report.detectorCpuTime.count() / report.audioSeconds << " us of CPU per audio second" << std::endl;
+}
+
+/// Test that create() rejects a missing factory and invalid settings.
+TEST(ReplayHarnessTest, createWithInvalidArguments) {
+    EXPECT_FALSE(ReplayHarness::create(ReplayHarness::DetectorFactory()));
+    ReplayHarness::Config config;
+    config.speed = -1.0;
+    EXPECT_FALSE(ReplayHarness::create(createStubFactory(), config));
+    config = ReplayHarness::Config();
+    config.chunkDuration = std::chrono::milliseconds(0);
+    EXPECT_FALSE(ReplayHarness::create(createStubFactory(), config));
+}
+
+}  // namespace test
+}  // namespace benchmark
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::kwd::benchmark::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
@@ -16,6 +16,7 @@
 #ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_ABSTRACTKEYWORDDETECTOR_H_
 #define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_ABSTRACTKEYWORDDETECTOR_H_
 
+#include <atomic>
 #include <mutex>
 #include <unordered_set>
 
@@ -59,6 +60,14 @@ public:
     void removeKeyWordDetectorStateObserver(
         std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface> keyWordDetectorStateObserver);
 
+    /**
+     * Gets the number of times the detector's reader has been overrun by the writer, which means the detector could
+     * not keep up with the audio and skipped some of it.  Only overruns seen by @c readFromStream() are counted.
+     *
+     * @return The number of overruns.
+     */
+    uint64_t getOverrunCount() const;
+
     /**
      * Destructor.
      */
@@ -152,6 +161,9 @@ private:
      * multiple times.
      */
     avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState m_detectorState;
+
+    /// The number of times @c readFromStream() has found the reader overrun.
+    std::atomic<uint64_t> m_overrunCount;
 };
 
 }  // namespace kwd
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORHOST_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORHOST_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/Audio/Resampler.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+#include "KWD/KeywordEngineInterface.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword detector which runs several keyword engines, such as a wake word engine and a command word engine, on one
+ * reader and one thread.  Each block of audio is read from the stream once, into one buffer, and passed to every
+ * enabled engine in the order the engines were given.  Keywords any engine finds are sent to the keyword observers.
+ *
+ * Engines can be disabled and enabled while the host runs, and the host accounts for the thread CPU time each engine
+ * spends processing audio.
+ *
+ * Engines take one channel at 16 kHz in the platform's byte order, so the host converts a stream in another byte
+ * order, with several channels, or at another rate as it reads each block.  When it resamples, the indices it passes
+ * to the engines count the resampled samples, and it maps the indices of the keywords they find back to the stream,
+ * to within the resampler's delay of a few milliseconds.
+ */
+class KeywordDetectorHost : public AbstractKeywordDetector {
+public:
+    /// What the host has measured of an engine.
+    struct EngineStatistics {
+        /// Whether the engine is enabled.
+        bool enabled;
+        /// The thread CPU time the engine has spent processing audio.
+        std::chrono::nanoseconds cpuTime;
+        /// The number of samples the engine has processed, after any resampling.
+        uint64_t samplesProcessed;
+        /// The number of keywords the engine has found.
+        uint64_t detections;
+    };
+
+    /**
+     * Creates a @c KeywordDetectorHost, which starts reading the stream.
+     *
+     * @param stream The stream of audio data. This should be formatted in LPCM encoded with 16 bits per sample, with a
+     *     word for each frame of all the channels.
+     * @param audioFormat The format of the audio data located within the stream, which may be in either byte order,
+     *     have any number of interleaved channels, and be at any rate the host can resample to 16 kHz.
+     * @param engines The engines to run, which must have distinct names.  All are enabled.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the host.
+     * @param msToPushPerIteration The amount of audio in milliseconds to read and pass to the engines at a time.
+     * @return A new @c KeywordDetectorHost, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<KeywordDetectorHost> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(10));
+
+    /**
+     * Destructor.
+     */
+    ~KeywordDetectorHost() override;
+
+    /**
+     * Enables or disables an engine.  A disabled engine is not passed audio, and is reset before it is passed audio
+     * again.
+     *
+     * @param name The name of the engine.
+     * @param enabled Whether the engine should be enabled.
+     * @return Whether the host runs an engine of that name.
+     */
+    bool setEngineEnabled(const std::string& name, bool enabled);
+
+    /**
+     * Gets what the host has measured of an engine.
+     *
+     * @param name The name of the engine.
+     * @param[out] statistics The statistics of the engine.
+     * @return Whether the host runs an engine of that name.
+     */
+    bool getEngineStatistics(const std::string& name, EngineStatistics* statistics) const;
+
+private:
+    /// An engine and its accounting.
+    struct EngineSlot {
+        /**
+         * Constructor.
+         *
+         * @param engine The engine.
+         */
+        EngineSlot(std::shared_ptr<KeywordEngineInterface> engine);
+
+        /// The engine.
+        const std::shared_ptr<KeywordEngineInterface> engine;
+
+        /// The name of the engine.
+        const std::string name;
+
+        /// Whether the engine is enabled.
+        std::atomic<bool> enabled;
+
+        /// Whether the engine was passed the last block, which only the detection thread accesses.
+        bool wasEnabled;
+
+        /// The thread CPU time the engine has spent processing audio, in nanoseconds.
+        std::atomic<int64_t> cpuTimeInNanoseconds;
+
+        /// The number of samples the engine has processed.
+        std::atomic<uint64_t> samplesProcessed;
+
+        /// The number of keywords the engine has found.
+        std::atomic<uint64_t> detections;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param stream The stream of audio data.
+     * @param engines The engines to run.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the host.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param wordsPerPush The number of words to read and convert at a time.
+     * @param resampler The resampler to 16 kHz, or @c nullptr if the stream is already at 16 kHz.
+     */
+    KeywordDetectorHost(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        avsCommon::utils::AudioFormat audioFormat,
+        size_t wordsPerPush,
+        std::unique_ptr<avsCommon::utils::audio::Resampler> resampler);
+
+    /**
+     * Creates the reader and starts the detection thread.
+     *
+     * @return Whether the host started.
+     */
+    bool init();
+
+    /**
+     * Finds the slot of an engine.
+     *
+     * @param name The name of the engine.
+     * @return The slot, or @c nullptr if the host runs no engine of that name.
+     */
+    EngineSlot* findSlot(const std::string& name) const;
+
+    /**
+     * Converts a block read from the stream to the samples the engines take.
+     *
+     * @param words The words read, which may be converted in place.
+     * @param numWords The number of words read.
+     * @param[out] samples The samples the engines take.
+     * @return The number of samples the engines take.
+     */
+    size_t convert(int16_t* words, size_t numWords, const int16_t** samples);
+
+    /**
+     * Maps an index the engines were passed to the stream.
+     *
+     * @param engineIndex The index the engines were passed.
+     * @param blockIndex The index in the stream of the block the engines were passed last.
+     * @param engineBlockIndex The index the engines were passed for that block.
+     * @return The index in the stream.
+     */
+    avsCommon::avs::AudioInputStream::Index toStreamIndex(
+        avsCommon::avs::AudioInputStream::Index engineIndex,
+        avsCommon::avs::AudioInputStream::Index blockIndex,
+        avsCommon::avs::AudioInputStream::Index engineBlockIndex) const;
+
+    /// The main function that reads data and passes it to the engines.
+    void detectionLoop();
+
+    /// Indicates whether the internal main loop should keep running.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The stream of audio data.
+    const std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The reader that will be used to read audio data from the stream.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_streamReader;
+
+    /// The engines, in the order they are passed audio.  The vector is not changed after construction.
+    std::vector<std::unique_ptr<EngineSlot>> m_slots;
+
+    /// The number of words to read and convert at a time.
+    const size_t m_wordsPerPush;
+
+    /// The number of channels of a word.
+    const size_t m_numChannels;
+
+    /// Whether the stream's byte order differs from the platform's.
+    const bool m_isByteswappingRequired;
+
+    /// The resampler to 16 kHz, or @c nullptr if the stream is already at 16 kHz.
+    const std::unique_ptr<avsCommon::utils::audio::Resampler> m_resampler;
+
+    /// The rate of the stream.
+    const unsigned int m_sampleRateHz;
+
+    /// The mixed down samples of a block, which are only used by the detection thread.
+    std::vector<int16_t> m_monoSamples;
+
+    /// The samples of a block the engines are passed, which are only used by the detection thread.
+    std::vector<int16_t> m_engineSamples;
+
+    /**
+     * Internal thread that reads audio from the buffer and feeds it to the engines. Only one instance of this thread
+     * runs at a time.
+     */
+    std::thread m_detectionThread;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORHOST_H_
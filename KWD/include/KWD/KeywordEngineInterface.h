@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword spotting engine which @c KeywordDetectorHost feeds.  Unlike an @c AbstractKeywordDetector, an engine does
+ * not read the stream itself; the host reads each block of audio once and passes it to every enabled engine in turn,
+ * on the host's detection thread.
+ *
+ * Engines receive one channel of 16-bit samples at 16 kHz, in the platform's byte order.  If the stream is in another
+ * format, the host converts it, and the indices the engines are passed count the converted samples; the host maps the
+ * indices of the keywords they find back to the stream.
+ */
+class KeywordEngineInterface {
+public:
+    /// A keyword found by an engine.
+    struct Detection {
+        /// The keyword.
+        std::string keyword;
+        /// The index in the stream of the first sample of the keyword.
+        avsCommon::avs::AudioInputStream::Index beginIndex;
+        /// The index in the stream of the sample after the keyword.
+        avsCommon::avs::AudioInputStream::Index endIndex;
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~KeywordEngineInterface() = default;
+
+    /**
+     * Gets the name of the engine, which the host uses to enable, disable and account for it.
+     *
+     * @return The name.
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * Discards any audio the engine has buffered.  The host calls this when the audio it passes next does not follow
+     * on from the audio it passed last, which happens when the engine is enabled again and when the reader overruns.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Processes a block of audio.
+     *
+     * @param samples The samples.
+     * @param numSamples The number of samples.
+     * @param beginIndex The index in the stream of the first sample.
+     * @param[out] detections The keywords found, which the engine appends to.
+     */
+    virtual void process(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) = 0;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "KWD/AbstractKeywordDetector.h"
@@ -61,7 +62,12 @@ AbstractKeywordDetector::AbstractKeywordDetector(
     std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers) :
         m_keyWordObservers{keyWordObservers},
         m_keyWordDetectorStateObservers{keyWordDetectorStateObservers},
-        m_detectorState{KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED} {
+        m_detectorState{KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED},
+        m_overrunCount{0} {
+}
+
+uint64_t AbstractKeywordDetector::getOverrunCount() const {
+    return m_overrunCount;
 }
 
 void AbstractKeywordDetector::notifyKeyWordObservers(
@@ -108,6 +114,7 @@ ssize_t AbstractKeywordDetector::readFromStream(
     } else if (wordsRead < 0) {
         switch (wordsRead) {
             case AudioInputStream::Reader::Error::OVERRUN:
+                ++m_overrunCount;
                 ACSDK_ERROR(LX("readFromStreamFailed")
                                 .d("reason", "streamOverrun")
                                 .d("numWordsOverrun",
@@ -137,15 +144,8 @@ ssize_t AbstractKeywordDetector::readFromStream(
 }
 
 bool AbstractKeywordDetector::isByteswappingRequired(avsCommon::utils::AudioFormat audioFormat) {
-    bool isPlatformLittleEndian = false;
-    int num = 1;
-    char* firstBytePtr = reinterpret_cast<char*>(&num);
-    if (*firstBytePtr == 1) {
-        isPlatformLittleEndian = true;
-    }
-
     bool isFormatLittleEndian = (audioFormat.endianness == avsCommon::utils::AudioFormat::Endianness::LITTLE);
-    return isPlatformLittleEndian != isFormatLittleEndian;
+    return avsCommon::utils::audio::kernels::isPlatformLittleEndian() != isFormatLittleEndian;
 }
 
 }  // namespace kwd
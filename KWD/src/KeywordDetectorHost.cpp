@@ -0,0 +1,315 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <ctime>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWD/KeywordDetectorHost.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::audio;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("KeywordDetectorHost");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of milliseconds per second.
+static const size_t MILLISECONDS_PER_SECOND = 1000;
+
+/// The sample rate the engines take.
+static const unsigned int ENGINE_SAMPLE_RATE_HZ = 16000;
+
+/// The timeout to use for read calls to the SharedDataStream.
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS(1000);
+
+/// The number of bits per sample the engines are passed.
+static const unsigned int COMPATIBLE_SAMPLE_SIZE_IN_BITS = 16;
+
+/**
+ * Gets the CPU time used by the calling thread.
+ *
+ * @return The CPU time, in nanoseconds.
+ */
+static int64_t threadCpuTimeInNanoseconds() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+std::unique_ptr<KeywordDetectorHost> KeywordDetectorHost::create(
+    std::shared_ptr<AudioInputStream> stream,
+    avsCommon::utils::AudioFormat audioFormat,
+    std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    std::chrono::milliseconds msToPushPerIteration) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (avsCommon::utils::AudioFormat::Encoding::LPCM != audioFormat.encoding ||
+        COMPATIBLE_SAMPLE_SIZE_IN_BITS != audioFormat.sampleSizeInBits || 0 == audioFormat.numChannels ||
+        (audioFormat.numChannels > 1 && avsCommon::utils::AudioFormat::Layout::INTERLEAVED != audioFormat.layout) ||
+        stream->getWordSize() != audioFormat.numChannels * sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits)
+                        .d("numChannels", audioFormat.numChannels)
+                        .d("wordSize", stream->getWordSize()));
+        return nullptr;
+    }
+    if (engines.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noEngines"));
+        return nullptr;
+    }
+    std::unordered_set<std::string> names;
+    for (const auto& engine : engines) {
+        if (!engine) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "nullEngine"));
+            return nullptr;
+        }
+        if (!names.insert(engine->getName()).second) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "duplicateEngineName").d("name", engine->getName()));
+            return nullptr;
+        }
+    }
+    size_t wordsPerPush = audioFormat.sampleRateHz * msToPushPerIteration.count() / MILLISECONDS_PER_SECOND;
+    if (0 == wordsPerPush) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidPushSize").d("ms", msToPushPerIteration.count()));
+        return nullptr;
+    }
+    std::unique_ptr<Resampler> resampler;
+    if (ENGINE_SAMPLE_RATE_HZ != audioFormat.sampleRateHz) {
+        resampler = Resampler::create(audioFormat.sampleRateHz, ENGINE_SAMPLE_RATE_HZ);
+        if (!resampler) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedSampleRate").d("rate", audioFormat.sampleRateHz));
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<KeywordDetectorHost> host(new KeywordDetectorHost(
+        stream,
+        engines,
+        keyWordObservers,
+        keyWordDetectorStateObservers,
+        audioFormat,
+        wordsPerPush,
+        std::move(resampler)));
+    if (!host->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initHostFailed"));
+        return nullptr;
+    }
+    return host;
+}
+
+KeywordDetectorHost::~KeywordDetectorHost() {
+    m_isShuttingDown = true;
+    if (m_detectionThread.joinable()) {
+        m_detectionThread.join();
+    }
+}
+
+bool KeywordDetectorHost::setEngineEnabled(const std::string& name, bool enabled) {
+    auto slot = findSlot(name);
+    if (!slot) {
+        ACSDK_ERROR(LX("setEngineEnabledFailed").d("reason", "unknownEngine").d("name", name));
+        return false;
+    }
+    slot->enabled = enabled;
+    ACSDK_DEBUG(LX("setEngineEnabled").d("name", name).d("enabled", enabled));
+    return true;
+}
+
+bool KeywordDetectorHost::getEngineStatistics(const std::string& name, EngineStatistics* statistics) const {
+    if (!statistics) {
+        ACSDK_ERROR(LX("getEngineStatisticsFailed").d("reason", "nullStatistics"));
+        return false;
+    }
+    auto slot = findSlot(name);
+    if (!slot) {
+        ACSDK_ERROR(LX("getEngineStatisticsFailed").d("reason", "unknownEngine").d("name", name));
+        return false;
+    }
+    statistics->enabled = slot->enabled;
+    statistics->cpuTime = std::chrono::nanoseconds(slot->cpuTimeInNanoseconds);
+    statistics->samplesProcessed = slot->samplesProcessed;
+    statistics->detections = slot->detections;
+    return true;
+}
+
+KeywordDetectorHost::EngineSlot::EngineSlot(std::shared_ptr<KeywordEngineInterface> engine) :
+        engine{engine},
+        name{engine->getName()},
+        enabled{true},
+        wasEnabled{true},
+        cpuTimeInNanoseconds{0},
+        samplesProcessed{0},
+        detections{0} {
+}
+
+KeywordDetectorHost::KeywordDetectorHost(
+    std::shared_ptr<AudioInputStream> stream,
+    std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    avsCommon::utils::AudioFormat audioFormat,
+    size_t wordsPerPush,
+    std::unique_ptr<Resampler> resampler) :
+        AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
+        m_isShuttingDown{false},
+        m_stream{stream},
+        m_wordsPerPush{wordsPerPush},
+        m_numChannels{audioFormat.numChannels},
+        m_isByteswappingRequired{isByteswappingRequired(audioFormat)},
+        m_resampler{std::move(resampler)},
+        m_sampleRateHz{audioFormat.sampleRateHz} {
+    if (m_numChannels > 1) {
+        m_monoSamples.resize(wordsPerPush);
+    }
+    if (m_resampler) {
+        m_engineSamples.resize(m_resampler->getMaxOutputSize(wordsPerPush));
+    }
+    for (const auto& engine : engines) {
+        m_slots.emplace_back(new EngineSlot(engine));
+    }
+}
+
+bool KeywordDetectorHost::init() {
+    m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!m_streamReader) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+        return false;
+    }
+    m_detectionThread = std::thread(&KeywordDetectorHost::detectionLoop, this);
+    return true;
+}
+
+KeywordDetectorHost::EngineSlot* KeywordDetectorHost::findSlot(const std::string& name) const {
+    for (const auto& slot : m_slots) {
+        if (slot->name == name) {
+            return slot.get();
+        }
+    }
+    return nullptr;
+}
+
+size_t KeywordDetectorHost::convert(int16_t* words, size_t numWords, const int16_t** samples) {
+    if (m_isByteswappingRequired) {
+        kernels::byteswap16(words, words, numWords * m_numChannels);
+    }
+    *samples = words;
+    if (m_numChannels > 1) {
+        kernels::downmixToMono(words, m_numChannels, m_monoSamples.data(), numWords);
+        *samples = m_monoSamples.data();
+    }
+    if (!m_resampler) {
+        return numWords;
+    }
+    auto numSamples = m_resampler->process(*samples, numWords, m_engineSamples.data());
+    *samples = m_engineSamples.data();
+    return numSamples;
+}
+
+AudioInputStream::Index KeywordDetectorHost::toStreamIndex(
+    AudioInputStream::Index engineIndex,
+    AudioInputStream::Index blockIndex,
+    AudioInputStream::Index engineBlockIndex) const {
+    if (!m_resampler) {
+        return engineIndex;
+    }
+    auto offset = (static_cast<int64_t>(engineIndex) - static_cast<int64_t>(engineBlockIndex)) * m_sampleRateHz /
+                  static_cast<int64_t>(ENGINE_SAMPLE_RATE_HZ);
+    return static_cast<AudioInputStream::Index>(std::max<int64_t>(0, static_cast<int64_t>(blockIndex) + offset));
+}
+
+void KeywordDetectorHost::detectionLoop() {
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    std::vector<int16_t> audioDataToPush(m_wordsPerPush * m_numChannels);
+    // When the host resamples, the engines are passed indices which count the resampled samples.
+    AudioInputStream::Index nextEngineIndex = 0;
+    std::vector<KeywordEngineInterface::Detection> detections;
+    while (!m_isShuttingDown) {
+        bool didErrorOccur = false;
+        auto blockIndex = m_streamReader->tell();
+        auto wordsRead = readFromStream(
+            m_streamReader,
+            m_stream,
+            audioDataToPush.data(),
+            m_wordsPerPush,
+            TIMEOUT_FOR_READ_CALLS,
+            &didErrorOccur);
+        if (didErrorOccur) {
+            break;
+        } else if (AudioInputStream::Reader::Error::OVERRUN == wordsRead) {
+            // The base class has moved the reader to the writer, so the next block does not follow on from the last.
+            for (auto& slot : m_slots) {
+                slot->wasEnabled = false;
+            }
+            if (m_resampler) {
+                m_resampler->reset();
+            }
+        } else if (wordsRead > 0) {
+            const int16_t* samples = nullptr;
+            auto numSamples = convert(audioDataToPush.data(), wordsRead, &samples);
+            auto engineBlockIndex = m_resampler ? nextEngineIndex : blockIndex;
+            nextEngineIndex += numSamples;
+            if (0 == numSamples) {
+                continue;
+            }
+            for (auto& slot : m_slots) {
+                if (!slot->enabled) {
+                    slot->wasEnabled = false;
+                    continue;
+                }
+                auto start = threadCpuTimeInNanoseconds();
+                if (!slot->wasEnabled) {
+                    slot->engine->reset();
+                    slot->wasEnabled = true;
+                }
+                slot->engine->process(samples, numSamples, engineBlockIndex, &detections);
+                slot->cpuTimeInNanoseconds += threadCpuTimeInNanoseconds() - start;
+                slot->samplesProcessed += numSamples;
+                slot->detections += detections.size();
+                for (const auto& detection : detections) {
+                    ACSDK_DEBUG(LX("keywordDetected").d("engine", slot->name).d("keyword", detection.keyword));
+                    notifyKeyWordObservers(
+                        m_stream,
+                        detection.keyword,
+                        toStreamIndex(detection.beginIndex, blockIndex, engineBlockIndex),
+                        toStreamIndex(detection.endIndex, blockIndex, engineBlockIndex));
+                }
+                detections.clear();
+            }
+        }
+    }
+    m_streamReader->close();
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
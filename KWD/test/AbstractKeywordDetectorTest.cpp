@@ -17,6 +17,7 @@
 #include <gmock/gmock.h>
 
 #include <unordered_set>
+#include <vector>
 
 #include <AVSCommon/Utils/AudioFormat.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
@@ -73,6 +74,24 @@ public:
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState state) {
         notifyKeyWordDetectorStateObservers(state);
     };
+
+    /**
+     * Reads from a stream.
+     *
+     * @param reader The stream reader.
+     * @param stream The stream.
+     * @param buf The buffer to read into.
+     * @param nWords The number of words to read.
+     * @return The number of words read.
+     */
+    ssize_t read(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        void* buf,
+        size_t nWords) {
+        bool errorOccurred = false;
+        return readFromStream(reader, stream, buf, nWords, std::chrono::milliseconds(0), &errorOccurred);
+    }
 };
 
 class AbstractKeyWordDetectorTest : public ::testing::Test {
@@ -170,6 +189,37 @@ TEST_F(AbstractKeyWordDetectorTest, testObserversDontGetNotifiedOfSameStateTwice
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
 }
 
+/// Test that each overrun readFromStream() finds is counted.
+TEST_F(AbstractKeyWordDetectorTest, testOverrunsAreCounted) {
+    using avsCommon::avs::AudioInputStream;
+    const size_t numWords = 16;
+    auto bufferSize = AudioInputStream::calculateBufferSize(numWords, sizeof(int16_t), 1);
+    std::shared_ptr<AudioInputStream> stream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+    ASSERT_TRUE(stream);
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+    std::vector<int16_t> samples(numWords, 0);
+    EXPECT_EQ(0u, detector->getOverrunCount());
+
+    writer->write(samples.data(), numWords);
+    EXPECT_EQ(static_cast<ssize_t>(numWords), detector->read(reader, stream, samples.data(), numWords));
+    EXPECT_EQ(0u, detector->getOverrunCount());
+
+    writer->write(samples.data(), numWords);
+    writer->write(samples.data(), numWords);
+    EXPECT_EQ(AudioInputStream::Reader::Error::OVERRUN, detector->read(reader, stream, samples.data(), numWords));
+    EXPECT_EQ(1u, detector->getOverrunCount());
+
+    // The reader has been moved to the writer, so it reads the next write without overrunning again.
+    writer->write(samples.data(), numWords);
+    EXPECT_EQ(static_cast<ssize_t>(numWords), detector->read(reader, stream, samples.data(), numWords));
+    EXPECT_EQ(1u, detector->getOverrunCount());
+}
+
 }  // namespace test
 }  // namespace kwd
 }  // namespace alexaClientSDK
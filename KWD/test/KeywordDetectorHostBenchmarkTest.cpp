@@ -0,0 +1,346 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file KeywordDetectorHostBenchmarkTest.cpp
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Audio/PcmFile.h>
+
+#include "KWD/KeywordDetectorHost.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The path to the inputs folder, which is passed on the command line.
+std::string inputsDirPath;
+
+/// The recordings the engines are run on.
+static const std::vector<std::string> RECORDINGS = {"/four_alexa.wav", "/alexa_stop_alexa_joke.wav"};
+
+/// The number of times the recordings are repeated, so that the engines process a couple of minutes of audio.
+static const int REPEATS = 10;
+
+/// The number of times each configuration is run, of which the cheapest is reported.
+static const int ROUNDS = 3;
+
+/// The sample rate of the recordings.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples in a frame the stub engines measure, which is 10 ms.
+static const size_t FRAME_SIZE = 160;
+
+/// How long to wait for the engines to process the audio.
+static const std::chrono::seconds TIMEOUT(60);
+
+/**
+ * A stand-in for a keyword spotting engine, which finds a keyword wherever the level of a band of the audio rises far
+ * enough above its floor.  Each frame is filtered and measured, so that the engine spends CPU time on each sample as a
+ * real engine's feature extraction does.
+ */
+class StubEngine : public KeywordEngineInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the engine.
+     * @param keyword The keyword the engine reports.
+     * @param preEmphasis The coefficient of the first-order filter the engine applies.
+     * @param riseDb How far above its floor in dB the level must rise for a keyword.
+     * @param totalSamples The number of samples after which @c waitForAllSamples() returns.
+     */
+    StubEngine(
+        const std::string& name,
+        const std::string& keyword,
+        float preEmphasis,
+        float riseDb,
+        size_t totalSamples) :
+            m_name{name},
+            m_keyword{keyword},
+            m_preEmphasis{preEmphasis},
+            m_riseDb{riseDb},
+            m_totalSamples{totalSamples},
+            m_numDetections{0},
+            m_numSamples{0} {
+        reset();
+    }
+
+    std::string getName() const override {
+        return m_name;
+    }
+
+    void reset() override {
+        m_previousSample = 0.0f;
+        m_floorDb = 0.0f;
+        m_isActive = false;
+        m_frameEnergy = 0.0f;
+        m_frameFill = 0;
+    }
+
+    void process(
+        const int16_t* samples,
+        size_t numSamples,
+        AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override {
+        for (size_t i = 0; i < numSamples; ++i) {
+            float sample = samples[i];
+            float filtered = sample - m_preEmphasis * m_previousSample;
+            m_previousSample = sample;
+            m_frameEnergy += filtered * filtered;
+            if (++m_frameFill < FRAME_SIZE) {
+                continue;
+            }
+            float levelDb = 10.0f * std::log10(m_frameEnergy / FRAME_SIZE + 1.0f);
+            m_frameEnergy = 0.0f;
+            m_frameFill = 0;
+            if (0.0f == m_floorDb) {
+                m_floorDb = levelDb;
+            }
+            if (!m_isActive && levelDb > m_floorDb + m_riseDb) {
+                m_isActive = true;
+                auto endIndex = beginIndex + i + 1;
+                detections->push_back({m_keyword, endIndex - FRAME_SIZE, endIndex});
+                ++m_numDetections;
+            } else if (m_isActive && levelDb < m_floorDb + m_riseDb / 2) {
+                m_isActive = false;
+            }
+            if (!m_isActive) {
+                m_floorDb = std::min(levelDb, m_floorDb + 0.01f);
+            }
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_numSamples += numSamples;
+        if (m_numSamples >= m_totalSamples) {
+            m_wakeTrigger.notify_all();
+        }
+    }
+
+    /**
+     * Waits for the engine to process all the samples.
+     *
+     * @return Whether the engine processed them before the timeout.
+     */
+    bool waitForAllSamples() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this] { return m_numSamples >= m_totalSamples; });
+    }
+
+    /**
+     * Gets the number of keywords the engine found.
+     *
+     * @return The number of keywords.
+     */
+    size_t getNumDetections() const {
+        return m_numDetections;
+    }
+
+private:
+    /// The name of the engine.
+    const std::string m_name;
+
+    /// The keyword the engine reports.
+    const std::string m_keyword;
+
+    /// The coefficient of the first-order filter the engine applies.
+    const float m_preEmphasis;
+
+    /// How far above its floor in dB the level must rise for a keyword.
+    const float m_riseDb;
+
+    /// The number of samples after which @c waitForAllSamples() returns.
+    const size_t m_totalSamples;
+
+    /// The last sample, for the filter.
+    float m_previousSample;
+
+    /// The level of the quietest recent audio, in dB.
+    float m_floorDb;
+
+    /// Whether the level is above the floor.
+    bool m_isActive;
+
+    /// The energy of the current frame so far.
+    float m_frameEnergy;
+
+    /// The number of samples of the current frame so far.
+    size_t m_frameFill;
+
+    /// The number of keywords found, which is read after the engine has processed all the samples.
+    size_t m_numDetections;
+
+    /// Serializes access to @c m_numSamples.
+    std::mutex m_mutex;
+
+    /// Notified when the engine has processed all the samples.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of samples processed.
+    size_t m_numSamples;
+};
+
+/**
+ * Gets the CPU time used by the process.
+ *
+ * @return The CPU time.
+ */
+static std::chrono::microseconds processCpuTime() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::microseconds(
+        (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/// What a configuration of hosts measured.
+struct Result {
+    /// The CPU time the process spent.
+    std::chrono::microseconds cpuTime;
+    /// The CPU time the engines spent, as the hosts accounted for it.
+    std::chrono::microseconds engineCpuTime;
+    /// The keywords found by each engine.
+    std::vector<size_t> detections;
+};
+
+/**
+ * Runs the audio through a wake word stub engine and a command stub engine, either on one host with one reader and
+ * one thread, or on a host each, which is how separate detectors run today.
+ *
+ * @param samples The audio.
+ * @param shareHost Whether the engines share a host.
+ * @param[out] result What was measured.
+ */
+static void runEngines(const std::vector<int16_t>& samples, bool shareHost, Result* result) {
+    AudioFormat format = {AudioFormat::Encoding::LPCM,
+                          AudioFormat::Endianness::LITTLE,
+                          SAMPLE_RATE_HZ,
+                          16,
+                          1,
+                          true,
+                          AudioFormat::Layout::INTERLEAVED};
+    auto bufferSize = AudioInputStream::calculateBufferSize(samples.size(), sizeof(int16_t), 2);
+    std::shared_ptr<AudioInputStream> stream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 2);
+    ASSERT_TRUE(stream);
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+
+    auto wakeWordEngine = std::make_shared<StubEngine>("wakeWord", "ALEXA", 0.97f, 20.0f, samples.size());
+    auto commandEngine = std::make_shared<StubEngine>("command", "STOP", 0.5f, 25.0f, samples.size());
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> observers;
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> stateObservers;
+    auto start = processCpuTime();
+    std::vector<std::unique_ptr<KeywordDetectorHost>> hosts;
+    if (shareHost) {
+        hosts.push_back(
+            KeywordDetectorHost::create(stream, format, {wakeWordEngine, commandEngine}, observers, stateObservers));
+    } else {
+        hosts.push_back(KeywordDetectorHost::create(stream, format, {wakeWordEngine}, observers, stateObservers));
+        hosts.push_back(KeywordDetectorHost::create(stream, format, {commandEngine}, observers, stateObservers));
+    }
+    for (const auto& host : hosts) {
+        ASSERT_TRUE(host);
+    }
+    ASSERT_TRUE(wakeWordEngine->waitForAllSamples());
+    ASSERT_TRUE(commandEngine->waitForAllSamples());
+    result->cpuTime = processCpuTime() - start;
+    result->engineCpuTime = std::chrono::microseconds::zero();
+    result->detections = {wakeWordEngine->getNumDetections(), commandEngine->getNumDetections()};
+    KeywordDetectorHost::EngineStatistics statistics;
+    for (const auto& host : hosts) {
+        for (const auto& name : {"wakeWord", "command"}) {
+            if (host->getEngineStatistics(name, &statistics)) {
+                result->engineCpuTime += std::chrono::duration_cast<std::chrono::microseconds>(statistics.cpuTime);
+            }
+        }
+    }
+}
+
+/**
+ * Prints the cheapest of the runs of a configuration.
+ *
+ * @param title The configuration.
+ * @param results The runs.
+ * @param audioSeconds The seconds of audio each run processed.
+ */
+static void report(const std::string& title, const std::vector<Result>& results, double audioSeconds) {
+    auto best = std::min_element(results.begin(), results.end(), [](const Result& lhs, const Result& rhs) {
+        return lhs.cpuTime < rhs.cpuTime;
+    });
+    std::cout << title << ": " << best->cpuTime.count() / audioSeconds << " us of CPU per audio second, of which "
+              << (best->cpuTime - best->engineCpuTime).count() / audioSeconds << " us outside the engines"
+              << std::endl;
+}
+
+/**
+ * Runs the recordings through two stub engines unthrottled, on one host and on a host each, and reports the CPU time
+ * per second of audio of each.  Both must find the same keywords, since each engine is passed the same audio either
+ * way.
+ */
+TEST(KeywordDetectorHostBenchmarkTest, sharedHostAgainstHostPerEngine) {
+    std::vector<int16_t> samples;
+    for (int i = 0; i < REPEATS; ++i) {
+        for (const auto& recording : RECORDINGS) {
+            std::vector<int16_t> recordingSamples;
+            ASSERT_TRUE(audio::readPcmFile(inputsDirPath + recording, SAMPLE_RATE_HZ, 1, &recordingSamples))
+                << "Unable to read " << inputsDirPath + recording;
+            samples.insert(samples.end(), recordingSamples.begin(), recordingSamples.end());
+        }
+    }
+    double audioSeconds = static_cast<double>(samples.size()) / SAMPLE_RATE_HZ;
+    std::cout << "Audio: " << audioSeconds << " s" << std::endl;
+
+    std::vector<Result> shared(ROUNDS);
+    std::vector<Result> separate(ROUNDS);
+    for (int i = 0; i < ROUNDS; ++i) {
+        runEngines(samples, true, &shared[i]);
+        runEngines(samples, false, &separate[i]);
+        EXPECT_GT(shared[i].detections[0], 0u);
+        EXPECT_EQ(shared[i].detections, separate[i].detections);
+    }
+    report("One host (1 reader, 1 thread, 1 copy per block)", shared, audioSeconds);
+    report("A host per engine (2 readers, 2 threads, 2 copies per block)", separate, audioSeconds);
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::kwd::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
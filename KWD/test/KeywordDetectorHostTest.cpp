@@ -0,0 +1,452 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file KeywordDetectorHostTest.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Audio/PcmKernels.h>
+
+#include "KWD/KeywordDetectorHost.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The sample value which the fake engine takes for a keyword.
+static const int16_t KEYWORD_MARKER = 12345;
+
+/// The keyword the fake engine reports.
+static const std::string KEYWORD = "ALEXA";
+
+/// The number of samples the stream holds.
+static const size_t STREAM_SIZE = 16000;
+
+/// The number of samples in a block the host reads, which is 10 ms.
+static const size_t BLOCK_SIZE = 160;
+
+/// The sample rate of the resampled stream.
+static const unsigned int HIGH_SAMPLE_RATE_HZ = 48000;
+
+/// The number of samples of a 16 kHz stream in each sample of the resampled stream.
+static const size_t DECIMATION = 3;
+
+/// How far the index of a keyword found in resampled audio may be from where it is in the stream.
+static const size_t RESAMPLED_INDEX_TOLERANCE = 200;
+
+/// How long to wait for the detection thread.
+static const std::chrono::seconds TIMEOUT(2);
+
+/// An engine which records the audio it is passed, and finds a keyword wherever a sample is @c KEYWORD_MARKER.
+class FakeEngine : public KeywordEngineInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the engine.
+     */
+    FakeEngine(const std::string& name) : m_name{name}, m_numResets{0}, m_numSamples{0}, m_lastIndex{0} {
+    }
+
+    std::string getName() const override {
+        return m_name;
+    }
+
+    void reset() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_numResets;
+    }
+
+    void process(
+        const int16_t* samples,
+        size_t numSamples,
+        AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blockIndices.push_back(beginIndex);
+        for (size_t i = 0; i < numSamples; ++i) {
+            if (KEYWORD_MARKER == samples[i]) {
+                detections->push_back({KEYWORD, beginIndex + i, beginIndex + i + 1});
+            }
+        }
+        m_numSamples += numSamples;
+        m_lastIndex = beginIndex + numSamples;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits for the engine to be passed the audio up to an index.
+     *
+     * @param index The index of the sample after the last one to wait for.
+     * @return Whether the audio was passed before the timeout.
+     */
+    bool waitForIndex(AudioInputStream::Index index) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, index] { return m_lastIndex >= index; });
+    }
+
+    /// The name of the engine.
+    const std::string m_name;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a block is processed.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of calls to @c reset().
+    int m_numResets;
+
+    /// The number of samples processed.
+    size_t m_numSamples;
+
+    /// The index of the sample after the last one processed.
+    AudioInputStream::Index m_lastIndex;
+
+    /// The index of the first sample of each block processed.
+    std::vector<AudioInputStream::Index> m_blockIndices;
+};
+
+/// An observer which records keyword detections.
+class TestKeyWordObserver : public KeyWordObserverInterface {
+public:
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_keywords.push_back(keyword);
+        m_beginIndices.push_back(beginIndex);
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits for detections.
+     *
+     * @param numDetections The number of detections to wait for.
+     * @return Whether there were that many detections before the timeout.
+     */
+    bool waitForDetections(size_t numDetections) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(
+            lock, TIMEOUT, [this, numDetections] { return m_keywords.size() >= numDetections; });
+    }
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a keyword is detected.
+    std::condition_variable m_wakeTrigger;
+
+    /// The keywords detected.
+    std::vector<std::string> m_keywords;
+
+    /// The begin indices of the keywords detected.
+    std::vector<AudioInputStream::Index> m_beginIndices;
+};
+
+/// Test harness for @c KeywordDetectorHost.
+class KeywordDetectorHostTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /**
+     * Creates a host of both engines.
+     *
+     * @param commandFirst Whether the command engine is passed each block before the wake word engine.
+     * @return The host.
+     */
+    std::unique_ptr<KeywordDetectorHost> createHost(bool commandFirst = false);
+
+    /**
+     * Replaces the stream with one of another word size.
+     *
+     * @param wordSize The size of a word, which holds a sample of every channel.
+     */
+    void createStream(size_t wordSize);
+
+    /**
+     * Waits for the host to account for the samples an engine has processed, which it does after the engine returns.
+     *
+     * @param host The host.
+     * @param name The name of the engine.
+     * @param numSamples The number of samples to wait for.
+     * @param[out] statistics The statistics of the engine.
+     * @return Whether the host accounted for that many samples before the timeout.
+     */
+    bool waitForStatistics(
+        KeywordDetectorHost* host,
+        const std::string& name,
+        uint64_t numSamples,
+        KeywordDetectorHost::EngineStatistics* statistics);
+
+    /**
+     * Writes blocks of silence, with a keyword marker at a sample.
+     *
+     * @param numBlocks The number of blocks.
+     * @param markerOffset The offset of the marker from the first sample written, or @c numBlocks * BLOCK_SIZE for no
+     *     marker.
+     */
+    void writeBlocks(size_t numBlocks, size_t markerOffset);
+
+    /// The format of the stream.
+    AudioFormat m_format;
+
+    /// The stream, which has room for only one reader so that the host must share its reader between its engines.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer of the stream.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The first engine.
+    std::shared_ptr<FakeEngine> m_wakeWordEngine;
+
+    /// The second engine.
+    std::shared_ptr<FakeEngine> m_commandEngine;
+
+    /// The observer of detections.
+    std::shared_ptr<TestKeyWordObserver> m_observer;
+};
+
+void KeywordDetectorHostTest::SetUp() {
+    m_format = {AudioFormat::Encoding::LPCM,
+                AudioFormat::Endianness::LITTLE,
+                16000,
+                16,
+                1,
+                true,
+                AudioFormat::Layout::INTERLEAVED};
+    createStream(sizeof(int16_t));
+    m_wakeWordEngine = std::make_shared<FakeEngine>("wakeWord");
+    m_commandEngine = std::make_shared<FakeEngine>("command");
+    m_observer = std::make_shared<TestKeyWordObserver>();
+}
+
+std::unique_ptr<KeywordDetectorHost> KeywordDetectorHostTest::createHost(bool commandFirst) {
+    std::vector<std::shared_ptr<KeywordEngineInterface>> engines = {m_wakeWordEngine, m_commandEngine};
+    if (commandFirst) {
+        std::swap(engines[0], engines[1]);
+    }
+    return KeywordDetectorHost::create(
+        m_stream,
+        m_format,
+        engines,
+        {m_observer},
+        std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>>());
+}
+
+void KeywordDetectorHostTest::createStream(size_t wordSize) {
+    m_writer.reset();
+    auto bufferSize = AudioInputStream::calculateBufferSize(STREAM_SIZE, wordSize, 1);
+    m_stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), wordSize, 1);
+    ASSERT_TRUE(m_stream);
+    m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(m_writer);
+}
+
+bool KeywordDetectorHostTest::waitForStatistics(
+    KeywordDetectorHost* host,
+    const std::string& name,
+    uint64_t numSamples,
+    KeywordDetectorHost::EngineStatistics* statistics) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (host->getEngineStatistics(name, statistics) && statistics->samplesProcessed < numSamples) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return statistics->samplesProcessed == numSamples;
+}
+
+void KeywordDetectorHostTest::writeBlocks(size_t numBlocks, size_t markerOffset) {
+    std::vector<int16_t> samples(numBlocks * BLOCK_SIZE, 0);
+    if (markerOffset < samples.size()) {
+        samples[markerOffset] = KEYWORD_MARKER;
+    }
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), m_writer->write(samples.data(), samples.size()));
+}
+
+/// Test that create() rejects a missing stream, missing or ambiguous engines, and formats the engines cannot take.
+TEST_F(KeywordDetectorHostTest, createWithInvalidArguments) {
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> observers;
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> stateObservers;
+    EXPECT_FALSE(KeywordDetectorHost::create(nullptr, m_format, {m_wakeWordEngine}, observers, stateObservers));
+    EXPECT_FALSE(KeywordDetectorHost::create(m_stream, m_format, {}, observers, stateObservers));
+    EXPECT_FALSE(
+        KeywordDetectorHost::create(m_stream, m_format, {m_wakeWordEngine, nullptr}, observers, stateObservers));
+    EXPECT_FALSE(KeywordDetectorHost::create(
+        m_stream, m_format, {m_wakeWordEngine, std::make_shared<FakeEngine>("wakeWord")}, observers, stateObservers));
+    auto format = m_format;
+    format.numChannels = 2;
+    EXPECT_FALSE(KeywordDetectorHost::create(m_stream, format, {m_wakeWordEngine}, observers, stateObservers));
+    format = m_format;
+    format.sampleSizeInBits = 32;
+    EXPECT_FALSE(KeywordDetectorHost::create(m_stream, format, {m_wakeWordEngine}, observers, stateObservers));
+    format = m_format;
+    format.sampleRateHz = 0;
+    EXPECT_FALSE(KeywordDetectorHost::create(m_stream, format, {m_wakeWordEngine}, observers, stateObservers));
+}
+
+/// Test that every engine is passed every block, from the one reader of a stream which allows no other.
+TEST_F(KeywordDetectorHostTest, fansOutEachBlockToEveryEngine) {
+    auto host = createHost();
+    ASSERT_TRUE(host);
+    EXPECT_FALSE(m_stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING));
+    writeBlocks(10, 10 * BLOCK_SIZE);
+    ASSERT_TRUE(m_wakeWordEngine->waitForIndex(10 * BLOCK_SIZE));
+    ASSERT_TRUE(m_commandEngine->waitForIndex(10 * BLOCK_SIZE));
+
+    std::lock_guard<std::mutex> wakeWordLock(m_wakeWordEngine->m_mutex);
+    std::lock_guard<std::mutex> commandLock(m_commandEngine->m_mutex);
+    EXPECT_EQ(m_wakeWordEngine->m_blockIndices, m_commandEngine->m_blockIndices);
+    EXPECT_EQ(10 * BLOCK_SIZE, m_wakeWordEngine->m_numSamples);
+    EXPECT_EQ(0, m_wakeWordEngine->m_numResets);
+
+    KeywordDetectorHost::EngineStatistics statistics;
+    ASSERT_TRUE(waitForStatistics(host.get(), "command", 10 * BLOCK_SIZE, &statistics));
+    EXPECT_TRUE(statistics.enabled);
+    EXPECT_EQ(0u, statistics.detections);
+    EXPECT_FALSE(host->getEngineStatistics("unknown", &statistics));
+}
+
+/// Test that a keyword any engine finds is sent to the observers, with the indices the engine found.
+TEST_F(KeywordDetectorHostTest, detectionsAreNotified) {
+    auto host = createHost();
+    ASSERT_TRUE(host);
+    writeBlocks(10, 5 * BLOCK_SIZE + 7);
+    ASSERT_TRUE(m_observer->waitForDetections(2));
+    {
+        std::lock_guard<std::mutex> lock(m_observer->m_mutex);
+        EXPECT_EQ(KEYWORD, m_observer->m_keywords[0]);
+        EXPECT_EQ(5 * BLOCK_SIZE + 7, m_observer->m_beginIndices[0]);
+        EXPECT_EQ(5 * BLOCK_SIZE + 7, m_observer->m_beginIndices[1]);
+    }
+    KeywordDetectorHost::EngineStatistics statistics;
+    ASSERT_TRUE(host->getEngineStatistics("wakeWord", &statistics));
+    EXPECT_EQ(1u, statistics.detections);
+}
+
+/// Test that a stream in the other byte order is swapped before the engines are passed it.
+TEST_F(KeywordDetectorHostTest, swapsBytesOfOtherByteOrder) {
+    m_format.endianness = audio::kernels::isPlatformLittleEndian() ? AudioFormat::Endianness::BIG
+                                                                   : AudioFormat::Endianness::LITTLE;
+    auto host = createHost();
+    ASSERT_TRUE(host);
+
+    std::vector<int16_t> samples(10 * BLOCK_SIZE, 0);
+    samples[5 * BLOCK_SIZE + 7] = KEYWORD_MARKER;
+    for (auto& sample : samples) {
+        auto word = static_cast<uint16_t>(sample);
+        sample = static_cast<int16_t>(static_cast<uint16_t>(word << 8 | word >> 8));
+    }
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), m_writer->write(samples.data(), samples.size()));
+    ASSERT_TRUE(m_observer->waitForDetections(2));
+    std::lock_guard<std::mutex> lock(m_observer->m_mutex);
+    EXPECT_EQ(5 * BLOCK_SIZE + 7, m_observer->m_beginIndices[0]);
+}
+
+/// Test that interleaved channels are mixed down to the one channel the engines take.
+TEST_F(KeywordDetectorHostTest, mixesChannelsDownToMono) {
+    createStream(2 * sizeof(int16_t));
+    m_format.numChannels = 2;
+    auto host = createHost();
+    ASSERT_TRUE(host);
+
+    std::vector<int16_t> samples(2 * 10 * BLOCK_SIZE, 0);
+    samples[2 * (5 * BLOCK_SIZE + 7)] = KEYWORD_MARKER;
+    samples[2 * (5 * BLOCK_SIZE + 7) + 1] = KEYWORD_MARKER;
+    // A marker in one channel only is mixed down to another value.
+    samples[2 * (6 * BLOCK_SIZE)] = KEYWORD_MARKER;
+    ASSERT_EQ(static_cast<ssize_t>(10 * BLOCK_SIZE), m_writer->write(samples.data(), 10 * BLOCK_SIZE));
+    ASSERT_TRUE(m_wakeWordEngine->waitForIndex(10 * BLOCK_SIZE));
+    ASSERT_TRUE(m_observer->waitForDetections(2));
+    std::lock_guard<std::mutex> lock(m_observer->m_mutex);
+    EXPECT_EQ(2u, m_observer->m_keywords.size());
+    EXPECT_EQ(5 * BLOCK_SIZE + 7, m_observer->m_beginIndices[0]);
+}
+
+/// Test that a 48 kHz stream is resampled to 16 kHz, and keywords are found where they are in the stream.
+TEST_F(KeywordDetectorHostTest, resamplesAndMapsIndicesBack) {
+    m_format.sampleRateHz = HIGH_SAMPLE_RATE_HZ;
+    auto host = createHost();
+    ASSERT_TRUE(host);
+
+    // A run of markers, which comes out of the filter as a run of markers once it has settled.
+    const size_t numSamples = 10 * DECIMATION * BLOCK_SIZE;
+    const size_t markerOffset = 5 * DECIMATION * BLOCK_SIZE;
+    std::vector<int16_t> samples(numSamples, 0);
+    std::fill(samples.begin() + markerOffset, samples.end(), KEYWORD_MARKER);
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), m_writer->write(samples.data(), samples.size()));
+    ASSERT_TRUE(m_observer->waitForDetections(1));
+    {
+        std::lock_guard<std::mutex> lock(m_observer->m_mutex);
+        EXPECT_NEAR(markerOffset, m_observer->m_beginIndices[0], RESAMPLED_INDEX_TOLERANCE);
+    }
+    ASSERT_TRUE(m_wakeWordEngine->waitForIndex(numSamples / DECIMATION - 1));
+    std::lock_guard<std::mutex> lock(m_wakeWordEngine->m_mutex);
+    EXPECT_NEAR(numSamples / DECIMATION, m_wakeWordEngine->m_numSamples, 1);
+}
+
+/// Test that a disabled engine is skipped, and is reset before it is passed audio again.
+TEST_F(KeywordDetectorHostTest, disabledEngineIsSkippedAndResetWhenEnabled) {
+    // The command engine comes first so that it has been skipped for the last block once the wake word engine has it.
+    auto host = createHost(true);
+    ASSERT_TRUE(host);
+    EXPECT_FALSE(host->setEngineEnabled("unknown", false));
+    ASSERT_TRUE(host->setEngineEnabled("command", false));
+    writeBlocks(10, 3 * BLOCK_SIZE);
+    ASSERT_TRUE(m_wakeWordEngine->waitForIndex(10 * BLOCK_SIZE));
+    ASSERT_TRUE(m_observer->waitForDetections(1));
+
+    KeywordDetectorHost::EngineStatistics statistics;
+    ASSERT_TRUE(host->getEngineStatistics("command", &statistics));
+    EXPECT_FALSE(statistics.enabled);
+    EXPECT_EQ(0u, statistics.samplesProcessed);
+    EXPECT_EQ(0, statistics.cpuTime.count());
+
+    ASSERT_TRUE(host->setEngineEnabled("command", true));
+    writeBlocks(5, 5 * BLOCK_SIZE);
+    ASSERT_TRUE(m_commandEngine->waitForIndex(15 * BLOCK_SIZE));
+    {
+        std::lock_guard<std::mutex> lock(m_commandEngine->m_mutex);
+        EXPECT_EQ(1, m_commandEngine->m_numResets);
+        EXPECT_EQ(5 * BLOCK_SIZE, m_commandEngine->m_numSamples);
+        EXPECT_EQ(10 * BLOCK_SIZE, m_commandEngine->m_blockIndices.front());
+    }
+    ASSERT_TRUE(waitForStatistics(host.get(), "command", 5 * BLOCK_SIZE, &statistics));
+    EXPECT_TRUE(statistics.enabled);
+    EXPECT_GT(statistics.cpuTime.count(), 0);
+
+    std::lock_guard<std::mutex> lock(m_observer->m_mutex);
+    EXPECT_EQ(1u, m_observer->m_keywords.size());
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -16,7 +16,10 @@
 #ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_ATTACHMENTREADERSOURCE_H_
 #define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_ATTACHMENTREADERSOURCE_H_
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
@@ -28,6 +31,13 @@
 namespace alexaClientSDK {
 namespace mediaPlayer {
 
+/**
+ * A source which plays the audio of an @c AttachmentReader.
+ *
+ * The attachment is read on a thread of its own while the appsrc element needs data. With a blocking reader, that
+ * thread sleeps until the writer of the attachment signals that data is available, so waiting for a slow stream
+ * neither blocks the worker thread of the @c MediaPlayer nor wakes it up repeatedly.
+ */
 class AttachmentReaderSource : public BaseStreamSource {
 public:
     /**
@@ -36,12 +46,14 @@ public:
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param attachmentReader The @c AttachmentReader from which to create the pipeline source from.
      * @param audioFormat The audioFormat to be used when playing raw PCM data.
+     * @param chunkSize The most bytes read from the attachment into each buffer pushed into the pipeline.
      * @return An instance of the @c AttachmentReaderSource if successful else a @c nullptr.
      */
     static std::unique_ptr<AttachmentReaderSource> create(
         PipelineInterface* pipeline,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
-        const avsCommon::utils::AudioFormat* audioFormat);
+        const avsCommon::utils::AudioFormat* audioFormat,
+        size_t chunkSize = DEFAULT_CHUNK_SIZE);
 
     ~AttachmentReaderSource();
 
@@ -56,10 +68,12 @@ private:
      *
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param attachmentReader The @c AttachmentReader from which to create the pipeline source from.
+     * @param chunkSize The most bytes read from the attachment into each buffer pushed into the pipeline.
      */
     AttachmentReaderSource(
         PipelineInterface* pipeline,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        size_t chunkSize);
 
     /// @name Overridden BaseStreamSource methods.
     /// @{
@@ -67,16 +81,41 @@ private:
     void close() override;
     gboolean handleReadData() override;
     gboolean handleSeekData(guint64 offset) override;
+    void startReading() override;
+    void stopReading() override;
     /// @}
 
+    /**
+     * The loop of @c m_readThread, which reads the attachment while the appsrc element needs data.
+     */
+    void readLoop();
+
     /// @name RequiresShutdown Functions
     /// @{
     void doShutdown() override{};
     /// @}
 
 private:
+    /// Serializes access to @c m_reader, which is read on @c m_readThread and seeked on a streaming thread.
+    std::mutex m_readerMutex;
+
     /// The @c AttachmentReader to read audioData from.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Wakes up @c m_readThread when reading starts or the source closes.
+    std::condition_variable m_wakeRead;
+
+    /// Whether the appsrc element needs data.
+    bool m_isReading;
+
+    /// Whether the source is closing, in which case @c m_readThread exits.
+    bool m_isClosing;
+
+    /// The thread reading the attachment. It is started when the appsrc element first needs data.
+    std::thread m_readThread;
 };
 
 }  // namespace mediaPlayer
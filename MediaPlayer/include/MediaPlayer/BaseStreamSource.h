@@ -16,6 +16,7 @@
 #ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_BASESTREAMSOURCE_H_
 #define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_BASESTREAMSOURCE_H_
 
+#include <cstddef>
 #include <memory>
 
 #include <gst/gst.h>
@@ -30,13 +31,17 @@ namespace mediaPlayer {
 
 class BaseStreamSource : public SourceInterface {
 public:
+    /// The default number of bytes read from the source into each buffer pushed into the appsrc element.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
     /**
      * Constructor.
      *
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param className The name of the class to be passed to @c RequiresShutdown.
+     * @param chunkSize The number of bytes read from the source into each buffer pushed into the appsrc element.
      */
-    BaseStreamSource(PipelineInterface* pipeline, const std::string& className);
+    BaseStreamSource(PipelineInterface* pipeline, const std::string& className, size_t chunkSize = DEFAULT_CHUNK_SIZE);
 
     ~BaseStreamSource() override;
 
@@ -82,6 +87,26 @@ protected:
      */
     virtual gboolean handleSeekData(guint64 offset) = 0;
 
+    /**
+     * Starts reading data and pushing it into the appsrc element, once the appsrc element needs data. This is called
+     * on the worker thread. By default, the @c onReadData() handler is installed on the worker thread.
+     */
+    virtual void startReading();
+
+    /**
+     * Stops reading data, once the appsrc element has enough data. This is called on the worker thread. By default,
+     * the @c onReadData() handler is uninstalled.
+     */
+    virtual void stopReading();
+
+    /**
+     * Takes a buffer of @c m_chunkSize bytes from the pool of this source. Buffers go back to the pool once GStreamer
+     * has consumed them, so that reading does not allocate a new buffer for each chunk.
+     *
+     * @return The buffer, or @c nullptr if none could be acquired.
+     */
+    GstBuffer* acquireBuffer();
+
     /**
      * Get the AppSrc to which this instance should feed audio data.
      *
@@ -160,6 +185,15 @@ private:
     /// The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
     PipelineInterface* m_pipeline;
 
+    /// The number of bytes read from the source into each buffer pushed into the appsrc element.
+    const size_t m_chunkSize;
+
+    /// The pool of the buffers pushed into the appsrc element.
+    GstBufferPool* m_bufferPool;
+
+    /// The appsrc and decoder taken from the @c DecoderPool of @c m_pipeline, to be given back on destruction.
+    DecoderPool::Chain m_chain;
+
     /// The sourceId used to identify the installation of the @c onReadData() handler.
     guint m_sourceId;
 
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODERPOOL_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODERPOOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A pool of the transient elements of the @c MediaPlayer pipeline: an appsrc and the decodebin behind it.
+ *
+ * Creating these elements for every source, and loading the plugins a decodebin picks for its first stream, delays the
+ * first audio of each source. The pool creates its chains ahead of time, loads the decoder plugins of the formats
+ * sent by AVS when it is created, and takes back the chains of finished sources so later sources reuse them.
+ *
+ * The chains handed out hold a reference owned by the caller, and must not be in a bin when they are released.
+ *
+ * This class is thread safe.
+ */
+class DecoderPool {
+public:
+    /// An appsrc and the decodebin linked behind it when in use.
+    struct Chain {
+        /// Constructor.
+        Chain();
+
+        /// The source element.
+        GstAppSrc* appsrc;
+
+        /// The decoder element.
+        GstElement* decoder;
+    };
+
+    /**
+     * Creates a pool filled with a number of chains.
+     *
+     * @param size The number of chains to create ahead of time, and the most chains kept for reuse.
+     * @return The pool, or @c nullptr if the elements could not be created.
+     */
+    static std::unique_ptr<DecoderPool> create(size_t size);
+
+    /// Destructor. Releases the chains in the pool.
+    ~DecoderPool();
+
+    /**
+     * Takes a chain from the pool, creating one if the pool is empty.
+     *
+     * @param[out] chain The chain. Its elements hold a reference owned by the caller.
+     * @return Whether a chain was returned.
+     */
+    bool acquire(Chain* chain);
+
+    /**
+     * Returns a chain to the pool, which resets it for the next source, or releases it if the pool is full.
+     *
+     * @param chain The chain. The reference the caller holds on its elements is taken over by the pool.
+     */
+    void release(const Chain& chain);
+
+    /**
+     * Gets the number of chains handed out which had been used by an earlier source.
+     *
+     * @return The number of reused chains.
+     */
+    size_t getNumReused();
+
+private:
+    /// A chain which is ready for a source.
+    struct PooledChain {
+        /// The chain.
+        Chain chain;
+
+        /// Whether the chain has been used by an earlier source.
+        bool isReused;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param size The most chains kept for reuse.
+     */
+    DecoderPool(size_t size);
+
+    /**
+     * Creates the elements of a chain.
+     *
+     * @param[out] chain The chain.
+     * @return Whether the elements were created.
+     */
+    static bool createChain(Chain* chain);
+
+    /**
+     * Releases the elements of a chain.
+     *
+     * @param chain The chain.
+     */
+    static void destroyChain(const Chain& chain);
+
+    /// The most chains kept for reuse.
+    const size_t m_size;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The chains which are ready for a source.
+    std::vector<PooledChain> m_chains;
+
+    /// The number of chains handed out which had been used by an earlier source.
+    size_t m_numReused;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODERPOOL_H_
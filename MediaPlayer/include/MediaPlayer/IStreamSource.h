@@ -37,11 +37,13 @@ public:
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param stream The @c std::istream from which to create the pipeline source.
      * @param repeat Whether the stream should be replayed until stopped.
+     * @param chunkSize The number of bytes read from the stream into each buffer pushed into the pipeline.
      */
     static std::unique_ptr<IStreamSource> create(
         PipelineInterface* pipeline,
         std::shared_ptr<std::istream> stream,
-        bool repeat);
+        bool repeat,
+        size_t chunkSize = DEFAULT_CHUNK_SIZE);
 
     /**
      * Destructor.
@@ -55,8 +57,9 @@ private:
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param stream The @c std::istream from which to create the pipeline source.
      * @param repeat Whether the stream should be replayed until stopped.
+     * @param chunkSize The number of bytes read from the stream into each buffer pushed into the pipeline.
      */
-    IStreamSource(PipelineInterface* pipeline, std::shared_ptr<std::istream> stream, bool repeat);
+    IStreamSource(PipelineInterface* pipeline, std::shared_ptr<std::istream> stream, bool repeat, size_t chunkSize);
 
     /// @name Overridden SourceInterface methods.
     /// @{
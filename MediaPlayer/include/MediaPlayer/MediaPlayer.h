@@ -22,6 +22,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <queue>
@@ -37,6 +38,7 @@
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
 #include <PlaylistParser/UrlContentToAttachmentConverter.h>
 
+#include "MediaPlayer/DecoderPool.h"
 #include "MediaPlayer/OffsetManager.h"
 #include "MediaPlayer/PipelineInterface.h"
 #include "MediaPlayer/SourceInterface.h"
@@ -84,6 +86,9 @@ public:
     SourceId setSource(std::shared_ptr<std::istream> stream, bool repeat) override;
     SourceId setSource(const std::string& url, std::chrono::milliseconds offset = std::chrono::milliseconds::zero())
         override;
+    bool prepareNextSource(
+        const std::string& url,
+        std::chrono::milliseconds offset = std::chrono::milliseconds::zero()) override;
 
     bool play(SourceId id) override;
     bool stop(SourceId id) override;
@@ -113,6 +118,7 @@ public:
     GstAppSrc* getAppSrc() const override;
     void setDecoder(GstElement* decoder) override;
     GstElement* getDecoder() const override;
+    DecoderPool* getDecoderPool() const override;
     GstElement* getPipeline() const override;
     guint queueCallback(const std::function<gboolean()>* callback) override;
     /// @}
@@ -125,6 +131,9 @@ public:
     void doShutdown() override;
 
 private:
+    /// Forwards the streaming errors of a prepared source once it plays, and records those which happen before.
+    class NextSourceErrorObserver;
+
     /**
      * The @c AudioPipeline consists of the following elements:
      * @li @c appsrc The appsrc element is used as the source to which audio data is provided.
@@ -320,6 +329,45 @@ private:
      */
     void handleSetIStreamSource(std::shared_ptr<std::istream> stream, bool repeat, std::promise<SourceId>* promise);
 
+    /**
+     * Worker thread handler for preparing the next url source while the current one plays.
+     *
+     * @param url The url of the next source.
+     * @param offset The offset the next source will start playing from.
+     * @param promise A promise to fulfill with whether the source is being prepared.
+     */
+    void handlePrepareNextSource(const std::string& url, std::chrono::milliseconds offset, std::promise<bool>* promise);
+
+    /**
+     * Stops preparing the next source, if any, and releases it.
+     */
+    void discardNextSource();
+
+    /**
+     * Starts polling the position of the current source to tell when it is nearly finished, unless it already is.
+     */
+    void startNearlyFinishedTimer();
+
+    /**
+     * Stops polling the position of the current source.
+     */
+    void stopNearlyFinishedTimer();
+
+    /**
+     * The callback of the timer polling the position of the current source.
+     *
+     * @param pointer The instance of this @c MediaPlayer.
+     * @return Whether to keep polling.
+     */
+    static gboolean onNearlyFinishedTimer(gpointer pointer);
+
+    /**
+     * Checks whether the current source is nearly finished, and notifies the observer if so.
+     *
+     * @return Whether to keep polling.
+     */
+    gboolean handleNearlyFinishedTimer();
+
     /**
      * Internal method to update the volume according to a gstreamer bug fix
      * https://bugzilla.gnome.org/show_bug.cgi?id=793081
@@ -425,6 +473,41 @@ private:
      */
     void sendPlaybackFinished();
 
+    /**
+     * Sends the playback nearly finished notification to the observer.
+     */
+    void sendPlaybackNearlyFinished();
+
+    /**
+     * The probe installed on the sink pad of the audio sink, which notes when the first buffer of a source reaches it.
+     * This is called on a streaming thread.
+     *
+     * @param pad The sink pad of the audio sink.
+     * @param info The buffer.
+     * @param pointer The instance of this @c MediaPlayer.
+     * @return @c GST_PAD_PROBE_OK, to let the buffer through.
+     */
+    static GstPadProbeReturn onAudioSinkBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer pointer);
+
+    /**
+     * The callback added to the event loop once the first buffer of a source has reached the audio sink.
+     *
+     * @param pointer The instance of this @c MediaPlayer.
+     * @return @c false, to be called only once.
+     */
+    static gboolean onFirstBufferRenderedCallback(gpointer pointer);
+
+    /**
+     * Removes the first buffer rendered callback from the event loop if it has not run yet, and forgets the source it
+     * was about.
+     */
+    void cancelFirstBufferRenderedCallback();
+
+    /**
+     * Sends the first buffer rendered notification to the observer, if it is about the current source.
+     */
+    void sendFirstBufferRendered();
+
     /**
      * Sends the playback paused notification to the observer.
      */
@@ -566,6 +649,48 @@ private:
 
     /// Stream offset before we teardown the pipeline
     std::chrono::milliseconds m_offsetBeforeTeardown;
+
+    /// The pool of appsrc and decoder elements which the sources take their elements from.
+    std::unique_ptr<DecoderPool> m_decoderPool;
+
+    /// The number of bytes read from a source into each buffer pushed into the pipeline.
+    size_t m_readChunkSize;
+
+    /// The time at which the latest @c setSource() call was made.
+    std::chrono::steady_clock::time_point m_setSourceTime;
+
+    /// The source whose first buffer has not reached the audio sink yet, or @c ERROR_SOURCE_ID if there is none.
+    std::atomic<SourceId> m_firstBufferPendingId;
+
+    /// The source whose first buffer has just reached the audio sink, or @c ERROR_SOURCE_ID if there is none.
+    std::atomic<SourceId> m_firstBufferRenderedId;
+
+    /// Serializes access to @c m_firstBufferRenderedSourceId between the streaming thread and the event loop.
+    std::mutex m_firstBufferRenderedMutex;
+
+    /// The id of the pending first buffer rendered callback in the event loop, or 0 if there is none.
+    guint m_firstBufferRenderedSourceId;
+
+    /// Flag to indicate when a playback nearly finished notification has been sent to the observer.
+    bool m_playbackNearlyFinishedSent;
+
+    /// The id of the timer polling the position of the current source, or 0 if it is not running.
+    guint m_nearlyFinishedTimerId;
+
+    /// Streams the url of the prepared source, if any, into an attachment while the current source plays.
+    std::shared_ptr<playlistParser::UrlContentToAttachmentConverter> m_nextUrlConverter;
+
+    /// The reader of the attachment of the prepared source, which holds back its writer once the buffer is full.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_nextReader;
+
+    /// The error observer of @c m_nextUrlConverter.
+    std::shared_ptr<NextSourceErrorObserver> m_nextErrorObserver;
+
+    /// The url of the prepared source.
+    std::string m_nextUrl;
+
+    /// The offset of the prepared source.
+    std::chrono::milliseconds m_nextOffset;
 };
 
 }  // namespace mediaPlayer
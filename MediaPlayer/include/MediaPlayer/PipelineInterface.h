@@ -23,6 +23,8 @@
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
 
+#include "MediaPlayer/DecoderPool.h"
+
 namespace alexaClientSDK {
 namespace mediaPlayer {
 
@@ -62,6 +64,13 @@ public:
      */
     virtual GstElement* getDecoder() const = 0;
 
+    /**
+     * Gets the pool from which the appSrc and decoder elements of the @c AudioPipeline are taken.
+     *
+     * @return The pool.
+     */
+    virtual DecoderPool* getDecoderPool() const = 0;
+
     /**
      * Gets the pipeline of the @c AudioPipeline.
      *
@@ -37,14 +37,21 @@ static const std::string TAG("AttachmentReaderSource");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The number of bytes read from the attachment with each read in the read loop.
-static const unsigned int CHUNK_SIZE(4096);
+/**
+ * The longest a blocking read waits for data. Reads wake up as soon as the writer signals that data is available, so
+ * this only bounds how long closing the source may wait for a read in progress.
+ */
+static const std::chrono::milliseconds READ_TIMEOUT(100);
+
+/// How long to wait before reading again when a non-blocking read finds no data.
+static const std::chrono::milliseconds NONBLOCKING_RETRY_INTERVAL(10);
 
 std::unique_ptr<AttachmentReaderSource> AttachmentReaderSource::create(
     PipelineInterface* pipeline,
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
-    const avsCommon::utils::AudioFormat* audioFormat) {
-    std::unique_ptr<AttachmentReaderSource> result(new AttachmentReaderSource(pipeline, attachmentReader));
+    const avsCommon::utils::AudioFormat* audioFormat,
+    size_t chunkSize) {
+    std::unique_ptr<AttachmentReaderSource> result(new AttachmentReaderSource(pipeline, attachmentReader, chunkSize));
     if (result->init(audioFormat)) {
         return result;
     }
@@ -57,35 +64,77 @@ AttachmentReaderSource::~AttachmentReaderSource() {
 
 AttachmentReaderSource::AttachmentReaderSource(
     PipelineInterface* pipeline,
-    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader) :
-        BaseStreamSource{pipeline, "AttachmentReaderSource"},
-        m_reader{reader} {};
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+    size_t chunkSize) :
+        BaseStreamSource{pipeline, "AttachmentReaderSource", chunkSize},
+        m_reader{reader},
+        m_isReading{false},
+        m_isClosing{false} {};
 
 bool AttachmentReaderSource::isPlaybackRemote() const {
     return false;
 }
 
 bool AttachmentReaderSource::isOpen() {
+    std::lock_guard<std::mutex> lock(m_readerMutex);
     return m_reader != nullptr;
 }
 
 void AttachmentReaderSource::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isClosing = true;
+        m_wakeRead.notify_all();
+    }
+    if (m_readThread.joinable()) {
+        m_readThread.join();
+    }
+    std::lock_guard<std::mutex> lock(m_readerMutex);
     if (m_reader) {
         m_reader->close();
     }
     m_reader.reset();
 }
 
-gboolean AttachmentReaderSource::handleReadData() {
-    if (!m_reader) {
-        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "attachmentReaderIsNullPtr"));
-        return false;
+void AttachmentReaderSource::startReading() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isClosing) {
+        return;
     }
+    m_isReading = true;
+    if (!m_readThread.joinable()) {
+        m_readThread = std::thread(&AttachmentReaderSource::readLoop, this);
+    }
+    m_wakeRead.notify_all();
+}
 
-    auto buffer = gst_buffer_new_allocate(nullptr, CHUNK_SIZE, nullptr);
+void AttachmentReaderSource::stopReading() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isReading = false;
+}
+
+void AttachmentReaderSource::readLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeRead.wait(lock, [this] { return m_isReading || m_isClosing; });
+        if (m_isClosing) {
+            return;
+        }
+        lock.unlock();
+        auto keepReading = handleReadData();
+        lock.lock();
+        if (!keepReading) {
+            // The end of the data has been signaled. Only a seek, followed by a request for data, restarts reading.
+            m_isReading = false;
+        }
+    }
+}
+
+gboolean AttachmentReaderSource::handleReadData() {
+    auto buffer = acquireBuffer();
 
     if (!buffer) {
-        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewAllocateFailed"));
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "acquireBufferFailed"));
         signalEndOfData();
         return false;
     }
@@ -99,7 +148,17 @@ gboolean AttachmentReaderSource::handleReadData() {
     }
 
     auto status = AttachmentReader::ReadStatus::OK;
-    auto size = m_reader->read(info.data, info.size, &status);
+    size_t size = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_readerMutex);
+        if (!m_reader) {
+            ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "attachmentReaderIsNullPtr"));
+            gst_buffer_unmap(buffer, &info);
+            gst_buffer_unref(buffer);
+            return false;
+        }
+        size = m_reader->read(info.data, info.size, &status, READ_TIMEOUT);
+    }
 
     ACSDK_DEBUG9(LX("read").d("size", size).d("status", static_cast<int>(status)));
 
@@ -120,17 +179,21 @@ gboolean AttachmentReaderSource::handleReadData() {
         // Fall through to retry reading later.
         case AttachmentReader::ReadStatus::OK_TIMEDOUT:
             if (size > 0) {
-                installOnReadDataHandler();
+                // The appsrc element takes the buffer over, even if pushing it fails.
                 auto flowRet = gst_app_src_push_buffer(getAppSrc(), buffer);
                 if (flowRet != GST_FLOW_OK) {
                     ACSDK_ERROR(LX("handleReadDataFailed")
                                     .d("reason", "gstAppSrcPushBufferFailed")
                                     .d("error", gst_flow_get_name(flowRet)));
-                    break;
+                    return false;
                 }
             } else {
                 gst_buffer_unref(buffer);
-                updateOnReadDataHandler();
+                if (AttachmentReader::ReadStatus::OK_WOULDBLOCK == status) {
+                    // A non-blocking reader cannot wait for data, so wait here before reading again.
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wakeRead.wait_for(lock, NONBLOCKING_RETRY_INTERVAL, [this] { return m_isClosing; });
+                }
             }
             return true;
         case AttachmentReader::ReadStatus::ERROR_OVERRUN:
@@ -149,6 +212,7 @@ gboolean AttachmentReaderSource::handleReadData() {
 
 gboolean AttachmentReaderSource::handleSeekData(guint64 offset) {
     ACSDK_DEBUG9(LX("handleSeekData").d("offset", offset));
+    std::lock_guard<std::mutex> lock(m_readerMutex);
     if (m_reader) {
         return m_reader->seek(offset);
     } else {
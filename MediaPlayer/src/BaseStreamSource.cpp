@@ -40,6 +40,14 @@ static const std::string TAG("BaseStreamSource");
 /// The interval to wait (in milliseconds) between successive attempts to read audio data when none is available.
 static const guint RETRY_INTERVALS_MILLISECONDS[] = {0, 10, 10, 10, 20, 20, 50, 100};
 
+/**
+ * The number of buffers the pool of each source allocates up front. The pool grows beyond this as needed, since the
+ * amount of data queued in the pipeline is bounded by the appsrc element instead.
+ */
+static const guint MIN_POOLED_BUFFERS = 4;
+
+constexpr size_t BaseStreamSource::DEFAULT_CHUNK_SIZE;
+
 /**
  * Method that returns a string to be used in CAPS negotiation (generating right PADS between gstreamer elements based
  * on audio data.) For raw PCM data without header audioFormat information needs to be passed explicitly for a
@@ -83,9 +91,11 @@ static std::string getCapsString(const AudioFormat& audioFormat) {
     return caps.str();
 }
 
-BaseStreamSource::BaseStreamSource(PipelineInterface* pipeline, const std::string& className) :
+BaseStreamSource::BaseStreamSource(PipelineInterface* pipeline, const std::string& className, size_t chunkSize) :
         SourceInterface(className),
         m_pipeline{pipeline},
+        m_chunkSize{chunkSize},
+        m_bufferPool{nullptr},
         m_sourceId{0},
         m_sourceRetryCount{0},
         m_handleNeedDataFunction{[this]() { return handleNeedData(); }},
@@ -103,16 +113,20 @@ BaseStreamSource::~BaseStreamSource() {
     g_signal_handler_disconnect(m_pipeline->getAppSrc(), m_enoughDataHandlerId);
     g_signal_handler_disconnect(m_pipeline->getAppSrc(), m_seekDataHandlerId);
     if (m_pipeline->getPipeline()) {
-        if (m_pipeline->getAppSrc()) {
-            gst_bin_remove(GST_BIN(m_pipeline->getPipeline()), GST_ELEMENT(m_pipeline->getAppSrc()));
+        auto bin = GST_OBJECT(m_pipeline->getPipeline());
+        if (m_chain.appsrc && GST_OBJECT_PARENT(m_chain.appsrc) == bin) {
+            gst_bin_remove(GST_BIN(bin), GST_ELEMENT(m_chain.appsrc));
         }
         m_pipeline->setAppSrc(nullptr);
 
-        if (m_pipeline->getDecoder()) {
-            gst_bin_remove(GST_BIN(m_pipeline->getPipeline()), GST_ELEMENT(m_pipeline->getDecoder()));
+        if (m_chain.decoder && GST_OBJECT_PARENT(m_chain.decoder) == bin) {
+            gst_bin_remove(GST_BIN(bin), m_chain.decoder);
         }
         m_pipeline->setDecoder(nullptr);
     }
+    if ((m_chain.appsrc || m_chain.decoder) && m_pipeline->getDecoderPool()) {
+        m_pipeline->getDecoderPool()->release(m_chain);
+    }
     {
         std::lock_guard<std::mutex> lock(m_callbackIdMutex);
         if (m_needDataCallbackId && !g_source_remove(m_needDataCallbackId)) {
@@ -123,14 +137,45 @@ BaseStreamSource::~BaseStreamSource() {
         }
     }
     uninstallOnReadDataHandler();
+    if (m_bufferPool) {
+        // Buffers still held by GStreamer keep the pool alive until they are released.
+        gst_buffer_pool_set_active(m_bufferPool, FALSE);
+        gst_object_unref(m_bufferPool);
+    }
 }
 
 bool BaseStreamSource::init(const AudioFormat* audioFormat) {
-    auto appsrc = reinterpret_cast<GstAppSrc*>(gst_element_factory_make("appsrc", "src"));
-    if (!appsrc) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "createSourceElementFailed"));
+    if (!m_pipeline) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "pipelineIsNotSet"));
+        return false;
+    }
+
+    if (0 == m_chunkSize) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "zeroChunkSize"));
+        return false;
+    }
+
+    m_bufferPool = gst_buffer_pool_new();
+    auto config = gst_buffer_pool_get_config(m_bufferPool);
+    gst_buffer_pool_config_set_params(config, nullptr, m_chunkSize, MIN_POOLED_BUFFERS, 0);
+    if (!gst_buffer_pool_set_config(m_bufferPool, config) || !gst_buffer_pool_set_active(m_bufferPool, TRUE)) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "activateBufferPoolFailed"));
+        return false;
+    }
+
+    auto decoderPool = m_pipeline->getDecoderPool();
+    if (!decoderPool) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "decoderPoolIsNotSet"));
+        return false;
+    }
+
+    // The appsrc and decoder are taken from the pool, so that they need not be created for every source.
+    if (!decoderPool->acquire(&m_chain)) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "acquireDecoderChainFailed"));
         return false;
     }
+    auto appsrc = m_chain.appsrc;
+    auto decoder = m_chain.decoder;
     gst_app_src_set_stream_type(appsrc, GST_APP_STREAM_TYPE_SEEKABLE);
 
     GstCaps* audioCaps = nullptr;
@@ -148,17 +193,6 @@ bool BaseStreamSource::init(const AudioFormat* audioFormat) {
         ACSDK_DEBUG9(LX("initNoAudioFormat"));
     }
 
-    auto decoder = gst_element_factory_make("decodebin", "decoder");
-    if (!decoder) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "createDecoderElementFailed"));
-        return false;
-    }
-
-    if (!m_pipeline) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "pipelineIsNotSet"));
-        return false;
-    }
-
     if (!gst_bin_add(GST_BIN(m_pipeline->getPipeline()), reinterpret_cast<GstElement*>(appsrc))) {
         ACSDK_ERROR(LX("initFailed").d("reason", "addingAppSrcToPipelineFailed"));
         return false;
@@ -216,6 +250,23 @@ bool BaseStreamSource::init(const AudioFormat* audioFormat) {
     return true;
 }
 
+void BaseStreamSource::startReading() {
+    installOnReadDataHandler();
+}
+
+void BaseStreamSource::stopReading() {
+    uninstallOnReadDataHandler();
+}
+
+GstBuffer* BaseStreamSource::acquireBuffer() {
+    GstBuffer* buffer = nullptr;
+    if (!m_bufferPool || gst_buffer_pool_acquire_buffer(m_bufferPool, &buffer, nullptr) != GST_FLOW_OK) {
+        ACSDK_ERROR(LX("acquireBufferFailed").d("reason", "gstBufferPoolAcquireBufferFailed"));
+        return nullptr;
+    }
+    return buffer;
+}
+
 GstAppSrc* BaseStreamSource::getAppSrc() const {
     if (!m_pipeline) {
         return nullptr;
@@ -304,7 +355,7 @@ gboolean BaseStreamSource::handleNeedData() {
     ACSDK_DEBUG9(LX("handleNeedDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_needDataCallbackId = 0;
-    installOnReadDataHandler();
+    startReading();
     return false;
 }
 
@@ -323,7 +374,7 @@ gboolean BaseStreamSource::handleEnoughData() {
     ACSDK_DEBUG9(LX("handleEnoughDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_enoughDataCallbackId = 0;
-    uninstallOnReadDataHandler();
+    stopReading();
     return false;
 }
 
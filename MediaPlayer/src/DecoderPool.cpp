@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/DecoderPool.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DecoderPool");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * The element factories a decodebin picks to decode the MP3 streams AVS sends for speech and most music. Their plugins
+ * are loaded when the pool is created rather than when the first such stream is decoded. Not all of them need to be
+ * installed.
+ */
+static const char* MP3_ELEMENT_FACTORY_NAMES[] = {"typefind", "id3demux", "mpegaudioparse", "mpg123audiodec", "mad"};
+
+DecoderPool::Chain::Chain() : appsrc{nullptr}, decoder{nullptr} {
+}
+
+std::unique_ptr<DecoderPool> DecoderPool::create(size_t size) {
+    for (auto name : MP3_ELEMENT_FACTORY_NAMES) {
+        auto factory = gst_element_factory_find(name);
+        if (!factory) {
+            ACSDK_DEBUG9(LX("elementFactoryNotFound").d("name", name));
+            continue;
+        }
+        auto feature = gst_plugin_feature_load(GST_PLUGIN_FEATURE(factory));
+        if (feature) {
+            gst_object_unref(feature);
+        } else {
+            ACSDK_WARN(LX("loadPluginFeatureFailed").d("name", name));
+        }
+        gst_object_unref(factory);
+    }
+
+    std::unique_ptr<DecoderPool> pool(new DecoderPool(size));
+    for (size_t i = 0; i < size; ++i) {
+        PooledChain pooledChain;
+        if (!createChain(&pooledChain.chain)) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createChainFailed"));
+            return nullptr;
+        }
+        pooledChain.isReused = false;
+        pool->m_chains.push_back(pooledChain);
+    }
+    return pool;
+}
+
+DecoderPool::~DecoderPool() {
+    for (auto& pooledChain : m_chains) {
+        destroyChain(pooledChain.chain);
+    }
+}
+
+bool DecoderPool::acquire(Chain* chain) {
+    if (!chain) {
+        ACSDK_ERROR(LX("acquireFailed").d("reason", "nullChain"));
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_chains.empty()) {
+            *chain = m_chains.back().chain;
+            if (m_chains.back().isReused) {
+                ++m_numReused;
+            }
+            m_chains.pop_back();
+            return true;
+        }
+    }
+    ACSDK_DEBUG9(LX("acquire").d("reason", "poolEmpty"));
+    return createChain(chain);
+}
+
+void DecoderPool::release(const Chain& chain) {
+    if (!chain.appsrc || !chain.decoder) {
+        destroyChain(chain);
+        return;
+    }
+    if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(GST_ELEMENT(chain.appsrc), GST_STATE_NULL) ||
+        GST_STATE_CHANGE_FAILURE == gst_element_set_state(chain.decoder, GST_STATE_NULL)) {
+        ACSDK_WARN(LX("releaseFailed").d("reason", "resetStateFailed"));
+        destroyChain(chain);
+        return;
+    }
+    // Disconnect the handler which linked the decoder into the pipeline, since the next source connects its own.
+    g_signal_handlers_disconnect_matched(
+        chain.decoder,
+        G_SIGNAL_MATCH_ID,
+        g_signal_lookup("pad-added", GST_TYPE_ELEMENT),
+        0,
+        nullptr,
+        nullptr,
+        nullptr);
+    // Undo what a raw audio source sets up, so the next source starts from the defaults.
+    gst_app_src_set_caps(chain.appsrc, nullptr);
+    g_object_set(G_OBJECT(chain.appsrc), "format", GST_FORMAT_BYTES, NULL);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_chains.size() >= m_size) {
+        destroyChain(chain);
+        return;
+    }
+    PooledChain pooledChain;
+    pooledChain.chain = chain;
+    pooledChain.isReused = true;
+    m_chains.push_back(pooledChain);
+}
+
+size_t DecoderPool::getNumReused() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numReused;
+}
+
+DecoderPool::DecoderPool(size_t size) : m_size{size}, m_numReused{0} {
+}
+
+bool DecoderPool::createChain(Chain* chain) {
+    auto appsrc = gst_element_factory_make("appsrc", "src");
+    if (!appsrc) {
+        ACSDK_ERROR(LX("createChainFailed").d("reason", "createSourceElementFailed"));
+        return false;
+    }
+    auto decoder = gst_element_factory_make("decodebin", "decoder");
+    if (!decoder) {
+        ACSDK_ERROR(LX("createChainFailed").d("reason", "createDecoderElementFailed"));
+        gst_object_unref(gst_object_ref_sink(appsrc));
+        return false;
+    }
+    // Own the elements, so that adding them to the pipeline does not take the reference handed to the caller.
+    chain->appsrc = GST_APP_SRC(gst_object_ref_sink(appsrc));
+    chain->decoder = GST_ELEMENT(gst_object_ref_sink(decoder));
+    return true;
+}
+
+void DecoderPool::destroyChain(const Chain& chain) {
+    if (chain.appsrc) {
+        gst_element_set_state(GST_ELEMENT(chain.appsrc), GST_STATE_NULL);
+        gst_object_unref(chain.appsrc);
+    }
+    if (chain.decoder) {
+        gst_element_set_state(chain.decoder, GST_STATE_NULL);
+        gst_object_unref(chain.decoder);
+    }
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -37,22 +37,24 @@ static const std::string TAG("IStreamSource");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The number of bytes read from the attachment with each read in the read loop.
-static const unsigned int CHUNK_SIZE(4096);
-
 std::unique_ptr<IStreamSource> IStreamSource::create(
     PipelineInterface* pipeline,
     std::shared_ptr<std::istream> stream,
-    bool repeat) {
-    std::unique_ptr<IStreamSource> result(new IStreamSource(pipeline, std::move(stream), repeat));
+    bool repeat,
+    size_t chunkSize) {
+    std::unique_ptr<IStreamSource> result(new IStreamSource(pipeline, std::move(stream), repeat, chunkSize));
     if (result->init()) {
         return result;
     }
     return nullptr;
 };
 
-IStreamSource::IStreamSource(PipelineInterface* pipeline, std::shared_ptr<std::istream> stream, bool repeat) :
-        BaseStreamSource{pipeline, "IStreamSource"},
+IStreamSource::IStreamSource(
+    PipelineInterface* pipeline,
+    std::shared_ptr<std::istream> stream,
+    bool repeat,
+    size_t chunkSize) :
+        BaseStreamSource{pipeline, "IStreamSource", chunkSize},
         m_stream{stream},
         m_repeat{repeat} {};
 
@@ -87,10 +89,10 @@ gboolean IStreamSource::handleReadData() {
         return false;
     }
 
-    auto buffer = gst_buffer_new_allocate(nullptr, CHUNK_SIZE, nullptr);
+    auto buffer = acquireBuffer();
 
     if (!buffer) {
-        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewAllocateFailed"));
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "acquireBufferFailed"));
         signalEndOfData();
         return false;
     }
@@ -15,6 +15,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <mutex>
 #include <unordered_map>
 
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
@@ -48,6 +49,9 @@ static const std::string TAG("MediaPlayer");
 static const std::string MEDIAPLAYER_CONFIGURATION_ROOT_KEY = "gstreamerMediaPlayer";
 /// The key in our config file to find the output conversion type.
 static const std::string MEDIAPLAYER_OUTPUT_CONVERSION_ROOT_KEY = "outputConversion";
+
+/// Key under the root configuration node for the number of bytes read from a source into each buffer.
+static const std::string MEDIAPLAYER_READ_CHUNK_SIZE_KEY = "readChunkSizeInBytes";
 /// The acceptable conversion keys to find in the config file
 /// Key strings are mapped to gstreamer capabilities documented here:
 /// https://gstreamer.freedesktop.org/documentation/design/mediatype-audio-raw.html
@@ -92,6 +96,75 @@ static const gdouble VOLUME_ZERO = 0.0000001;
 /// The amount to wait before stopping the pipeline on an end-of-stream message to avoid cutting audio short prematurely
 static const std::chrono::milliseconds SLEEP_AFTER_END_OF_AUDIO{300};
 
+/**
+ * How long before the end of a source the observer is told it is nearly finished. This leaves time to connect to and
+ * buffer the next source, without opening its url so early that it might expire before it plays.
+ */
+static const std::chrono::seconds NEARLY_FINISHED_THRESHOLD{10};
+
+/// How often the position of the playing source is polled to tell when it is nearly finished.
+static const guint NEARLY_FINISHED_POLL_INTERVAL_MS = 500;
+
+/**
+ * The number of appsrc and decoder chains created ahead of time, and kept for reuse. One is used by the current source,
+ * and one is ready for the next.
+ */
+static const size_t DECODER_POOL_SIZE = 2;
+
+class MediaPlayer::NextSourceErrorObserver
+        : public alexaClientSDK::playlistParser::UrlContentToAttachmentConverter::ErrorObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param mediaPlayer The observer to forward errors to once the prepared source plays.
+     */
+    NextSourceErrorObserver(std::weak_ptr<ErrorObserverInterface> mediaPlayer) :
+            m_mediaPlayer{mediaPlayer},
+            m_forwarding{false},
+            m_failed{false} {
+    }
+
+    void onError() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_forwarding) {
+            m_failed = true;
+            return;
+        }
+        auto mediaPlayer = m_mediaPlayer.lock();
+        if (mediaPlayer) {
+            mediaPlayer->onError();
+        }
+    }
+
+    /**
+     * Starts forwarding errors, as the prepared source is about to play.
+     *
+     * @return @c false if streaming the prepared source already failed, in which case it should not be used.
+     */
+    bool startForwarding() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_failed) {
+            return false;
+        }
+        m_forwarding = true;
+        return true;
+    }
+
+private:
+    /// The observer to forward errors to.
+    std::weak_ptr<ErrorObserverInterface> m_mediaPlayer;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Whether errors are forwarded.
+    bool m_forwarding;
+
+    /// Whether an error happened before errors were forwarded.
+    bool m_failed;
+};
+
 /**
  * Processes tags found in the tagList.
  * Called through gst_tag_list_foreach.
@@ -162,6 +235,8 @@ MediaPlayer::~MediaPlayer() {
     if (m_mainLoopThread.joinable()) {
         m_mainLoopThread.join();
     }
+    stopNearlyFinishedTimer();
+    discardNextSource();
     gst_object_unref(m_pipeline.pipeline);
     resetPipeline();
 
@@ -175,7 +250,10 @@ MediaPlayer::SourceId MediaPlayer::setSource(
     ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "AttachmentReader"));
     std::promise<MediaPlayer::SourceId> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, &reader, &promise, audioFormat]() {
+    auto setSourceTime = std::chrono::steady_clock::now();
+    std::function<gboolean()> callback = [this, &reader, &promise, audioFormat, setSourceTime]() {
+        m_setSourceTime = setSourceTime;
+        discardNextSource();
         handleSetAttachmentReaderSource(std::move(reader), &promise, audioFormat);
         return false;
     };
@@ -189,7 +267,10 @@ MediaPlayer::SourceId MediaPlayer::setSource(std::shared_ptr<std::istream> strea
     ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "istream"));
     std::promise<MediaPlayer::SourceId> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, &stream, repeat, &promise]() {
+    auto setSourceTime = std::chrono::steady_clock::now();
+    std::function<gboolean()> callback = [this, &stream, repeat, &promise, setSourceTime]() {
+        m_setSourceTime = setSourceTime;
+        discardNextSource();
         handleSetIStreamSource(stream, repeat, &promise);
         return false;
     };
@@ -203,7 +284,9 @@ MediaPlayer::SourceId MediaPlayer::setSource(const std::string& url, std::chrono
     ACSDK_DEBUG9(LX("setSourceForUrlCalled").sensitive("url", url));
     std::promise<MediaPlayer::SourceId> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, url, offset, &promise]() {
+    auto setSourceTime = std::chrono::steady_clock::now();
+    std::function<gboolean()> callback = [this, url, offset, &promise, setSourceTime]() {
+        m_setSourceTime = setSourceTime;
         handleSetUrlSource(url, offset, &promise);
         return false;
     };
@@ -213,6 +296,20 @@ MediaPlayer::SourceId MediaPlayer::setSource(const std::string& url, std::chrono
     return ERROR_SOURCE_ID;
 }
 
+bool MediaPlayer::prepareNextSource(const std::string& url, std::chrono::milliseconds offset) {
+    ACSDK_DEBUG9(LX("prepareNextSourceCalled").sensitive("url", url));
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+    std::function<gboolean()> callback = [this, url, offset, &promise]() {
+        handlePrepareNextSource(url, offset, &promise);
+        return false;
+    };
+    if (queueCallback(&callback) != UNQUEUED_CALLBACK) {
+        return future.get();
+    }
+    return false;
+}
+
 uint64_t MediaPlayer::getNumBytesBuffered() {
     ACSDK_DEBUG9(LX("getNumBytesBuffered"));
     if (m_pipeline.appsrc) {
@@ -525,6 +622,10 @@ GstElement* MediaPlayer::getDecoder() const {
     return m_pipeline.decoder;
 }
 
+DecoderPool* MediaPlayer::getDecoderPool() const {
+    return m_decoderPool.get();
+}
+
 GstElement* MediaPlayer::getPipeline() const {
     return m_pipeline.pipeline;
 }
@@ -547,7 +648,14 @@ MediaPlayer::MediaPlayer(
         m_playPending{false},
         m_pausePending{false},
         m_resumePending{false},
-        m_pauseImmediately{false} {
+        m_pauseImmediately{false},
+        m_readChunkSize{BaseStreamSource::DEFAULT_CHUNK_SIZE},
+        m_firstBufferPendingId{ERROR_SOURCE_ID},
+        m_firstBufferRenderedId{ERROR_SOURCE_ID},
+        m_firstBufferRenderedSourceId{0},
+        m_playbackNearlyFinishedSent{false},
+        m_nearlyFinishedTimerId{0},
+        m_nextOffset{std::chrono::milliseconds::zero()} {
 }
 
 bool MediaPlayer::init() {
@@ -563,6 +671,21 @@ bool MediaPlayer::init() {
 
     m_mainLoopThread = std::thread(g_main_loop_run, m_mainLoop);
 
+    int readChunkSize = 0;
+    ConfigurationNode::getRoot()[MEDIAPLAYER_CONFIGURATION_ROOT_KEY].getInt(
+        MEDIAPLAYER_READ_CHUNK_SIZE_KEY, &readChunkSize, static_cast<int>(BaseStreamSource::DEFAULT_CHUNK_SIZE));
+    if (readChunkSize <= 0) {
+        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "invalidReadChunkSize").d("readChunkSize", readChunkSize));
+        return false;
+    }
+    m_readChunkSize = static_cast<size_t>(readChunkSize);
+
+    m_decoderPool = DecoderPool::create(DECODER_POOL_SIZE);
+    if (!m_decoderPool) {
+        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "createDecoderPoolFailed"));
+        return false;
+    }
+
     if (!setupPipeline()) {
         ACSDK_ERROR(LX("initPlayerFailed").d("reason", "setupPipelineFailed"));
         return false;
@@ -713,6 +836,15 @@ bool MediaPlayer::setupPipeline() {
         }
     }
 
+    // Watch the buffers reaching the audio sink, to measure how long each source takes to start.
+    GstPad* sinkPad = gst_element_get_static_pad(m_pipeline.audioSink, "sink");
+    if (!sinkPad) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "getAudioSinkPadFailed"));
+        return false;
+    }
+    gst_pad_add_probe(sinkPad, GST_PAD_PROBE_TYPE_BUFFER, &MediaPlayer::onAudioSinkBuffer, this, nullptr);
+    gst_object_unref(sinkPad);
+
     return true;
 }
 
@@ -723,6 +855,8 @@ void MediaPlayer::tearDownTransientPipelineElements() {
         sendPlaybackStopped();
     }
     m_currentId = ERROR_SOURCE_ID;
+    m_firstBufferPendingId = ERROR_SOURCE_ID;
+    stopNearlyFinishedTimer();
     cleanUpSource();
     m_offsetManager.clear();
     m_playPending = false;
@@ -731,6 +865,7 @@ void MediaPlayer::tearDownTransientPipelineElements() {
     m_pauseImmediately = false;
     m_playbackStartedSent = false;
     m_playbackFinishedSent = false;
+    m_playbackNearlyFinishedSent = false;
     m_isPaused = false;
     m_isBufferUnderrun = false;
 }
@@ -817,6 +952,8 @@ void MediaPlayer::doShutdown() {
         m_urlConverter->shutdown();
     }
     m_urlConverter.reset();
+    stopNearlyFinishedTimer();
+    discardNextSource();
     m_playerObserver.reset();
 }
 
@@ -1063,7 +1200,8 @@ void MediaPlayer::handleSetAttachmentReaderSource(
 
     tearDownTransientPipelineElements();
 
-    std::shared_ptr<SourceInterface> source = AttachmentReaderSource::create(this, reader, audioFormat);
+    std::shared_ptr<SourceInterface> source =
+        AttachmentReaderSource::create(this, reader, audioFormat, m_readChunkSize);
 
     if (!source) {
         ACSDK_ERROR(LX("handleSetAttachmentReaderSourceFailed").d("reason", "sourceIsNullptr"));
@@ -1083,6 +1221,7 @@ void MediaPlayer::handleSetAttachmentReaderSource(
 
     m_source = source;
     m_currentId = ++g_id;
+    m_firstBufferPendingId = m_currentId;
     m_offsetManager.setIsSeekable(true);
     promise->set_value(m_currentId);
 }
@@ -1095,7 +1234,7 @@ void MediaPlayer::handleSetIStreamSource(
 
     tearDownTransientPipelineElements();
 
-    std::shared_ptr<SourceInterface> source = IStreamSource::create(this, stream, repeat);
+    std::shared_ptr<SourceInterface> source = IStreamSource::create(this, stream, repeat, m_readChunkSize);
 
     if (!source) {
         ACSDK_ERROR(LX("handleSetIStreamSourceFailed").d("reason", "sourceIsNullptr"));
@@ -1115,6 +1254,7 @@ void MediaPlayer::handleSetIStreamSource(
 
     m_source = source;
     m_currentId = ++g_id;
+    m_firstBufferPendingId = m_currentId;
     promise->set_value(m_currentId);
 }
 
@@ -1126,6 +1266,18 @@ void MediaPlayer::handleSetUrlSource(
 
     tearDownTransientPipelineElements();
 
+    if (m_nextUrlConverter && url == m_nextUrl && offset == m_nextOffset && m_nextErrorObserver->startForwarding()) {
+        // The url has been fetched and buffered while the previous source played, so only the decoder is rebuilt.
+        ACSDK_DEBUG(LX("handleSetSourceForUrl").d("reason", "usingPreparedSource"));
+        m_urlConverter = std::move(m_nextUrlConverter);
+        auto reader = std::move(m_nextReader);
+        m_nextErrorObserver.reset();
+        m_nextUrl.clear();
+        handleSetAttachmentReaderSource(reader, promise);
+        return;
+    }
+    discardNextSource();
+
     m_urlConverter = alexaClientSDK::playlistParser::UrlContentToAttachmentConverter::create(
         m_contentFetcherFactory, url, shared_from_this(), offset);
     if (!m_urlConverter) {
@@ -1149,6 +1301,93 @@ void MediaPlayer::handleSetUrlSource(
     handleSetAttachmentReaderSource(reader, promise);
 }
 
+void MediaPlayer::handlePrepareNextSource(
+    const std::string& url,
+    std::chrono::milliseconds offset,
+    std::promise<bool>* promise) {
+    ACSDK_DEBUG(LX("handlePrepareNextSourceCalled"));
+
+    discardNextSource();
+
+    auto errorObserver = std::make_shared<NextSourceErrorObserver>(shared_from_this());
+    auto urlConverter = alexaClientSDK::playlistParser::UrlContentToAttachmentConverter::create(
+        m_contentFetcherFactory, url, errorObserver, offset);
+    if (!urlConverter) {
+        ACSDK_ERROR(LX("prepareNextSourceFailed").d("reason", "badUrlConverter"));
+        promise->set_value(false);
+        return;
+    }
+    auto attachment = urlConverter->getAttachment();
+    std::shared_ptr<AttachmentReader> reader =
+        attachment ? attachment->createReader(sds::ReaderPolicy::BLOCKING) : nullptr;
+    if (!reader) {
+        ACSDK_ERROR(LX("prepareNextSourceFailed").d("reason", "failedToCreateAttachmentReader"));
+        urlConverter->shutdown();
+        promise->set_value(false);
+        return;
+    }
+
+    m_nextUrlConverter = urlConverter;
+    m_nextReader = reader;
+    m_nextErrorObserver = errorObserver;
+    m_nextUrl = url;
+    m_nextOffset = offset;
+    promise->set_value(true);
+}
+
+void MediaPlayer::discardNextSource() {
+    if (m_nextUrlConverter) {
+        ACSDK_DEBUG9(LX("discardNextSource"));
+        m_nextUrlConverter->shutdown();
+    }
+    m_nextUrlConverter.reset();
+    m_nextReader.reset();
+    m_nextErrorObserver.reset();
+    m_nextUrl.clear();
+}
+
+void MediaPlayer::startNearlyFinishedTimer() {
+    if (m_nearlyFinishedTimerId != 0 || m_playbackNearlyFinishedSent) {
+        return;
+    }
+    m_nearlyFinishedTimerId = g_timeout_add(NEARLY_FINISHED_POLL_INTERVAL_MS, &onNearlyFinishedTimer, this);
+}
+
+void MediaPlayer::stopNearlyFinishedTimer() {
+    if (m_nearlyFinishedTimerId != 0) {
+        g_source_remove(m_nearlyFinishedTimerId);
+        m_nearlyFinishedTimerId = 0;
+    }
+}
+
+gboolean MediaPlayer::onNearlyFinishedTimer(gpointer pointer) {
+    return static_cast<MediaPlayer*>(pointer)->handleNearlyFinishedTimer();
+}
+
+gboolean MediaPlayer::handleNearlyFinishedTimer() {
+    if (ERROR_SOURCE_ID == m_currentId || m_playbackNearlyFinishedSent) {
+        m_nearlyFinishedTimerId = 0;
+        return false;
+    }
+    if (m_isPaused || m_isBufferUnderrun) {
+        return true;
+    }
+    gint64 position = -1;
+    gint64 duration = -1;
+    if (!gst_element_query_position(m_pipeline.pipeline, GST_FORMAT_TIME, &position) ||
+        !gst_element_query_duration(m_pipeline.pipeline, GST_FORMAT_TIME, &duration) || duration <= 0 ||
+        position < 0) {
+        // The duration of live streams and of some encodings is unknown until the end.
+        return true;
+    }
+    if (std::chrono::nanoseconds(duration - position) > NEARLY_FINISHED_THRESHOLD) {
+        return true;
+    }
+    m_nearlyFinishedTimerId = 0;
+    sendPlaybackNearlyFinished();
+    return false;
+}
+
 void MediaPlayer::handlePlay(SourceId id, std::promise<bool>* promise) {
     ACSDK_DEBUG(LX("handlePlayCalled").d("idPassed", id).d("currentId", (m_currentId)));
     if (!validateSourceAndId(id)) {
@@ -1433,6 +1672,7 @@ void MediaPlayer::sendPlaybackStarted() {
         if (m_playerObserver) {
             m_playerObserver->onPlaybackStarted(m_currentId);
         }
+        startNearlyFinishedTimer();
     }
 }
 
@@ -1458,6 +1698,63 @@ void MediaPlayer::sendPlaybackFinished() {
     m_urlConverter.reset();
 }
 
+void MediaPlayer::sendPlaybackNearlyFinished() {
+    if (m_playbackNearlyFinishedSent) {
+        return;
+    }
+    m_playbackNearlyFinishedSent = true;
+    ACSDK_DEBUG(LX("callingOnPlaybackNearlyFinished").d("currentId", m_currentId));
+    if (m_playerObserver) {
+        m_playerObserver->onPlaybackNearlyFinished(m_currentId);
+    }
+}
+
+GstPadProbeReturn MediaPlayer::onAudioSinkBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    auto id = mediaPlayer->m_firstBufferPendingId.exchange(ERROR_SOURCE_ID);
+    if (id != ERROR_SOURCE_ID) {
+        mediaPlayer->m_firstBufferRenderedId = id;
+        // The id is kept so that the callback can be removed before it outlives the source or this player.
+        std::lock_guard<std::mutex> lock(mediaPlayer->m_firstBufferRenderedMutex);
+        if (0 == mediaPlayer->m_firstBufferRenderedSourceId) {
+            mediaPlayer->m_firstBufferRenderedSourceId = g_idle_add(&onFirstBufferRenderedCallback, pointer);
+        }
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+gboolean MediaPlayer::onFirstBufferRenderedCallback(gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    {
+        std::lock_guard<std::mutex> lock(mediaPlayer->m_firstBufferRenderedMutex);
+        mediaPlayer->m_firstBufferRenderedSourceId = 0;
+    }
+    mediaPlayer->sendFirstBufferRendered();
+    return false;
+}
+
+void MediaPlayer::cancelFirstBufferRenderedCallback() {
+    std::lock_guard<std::mutex> lock(m_firstBufferRenderedMutex);
+    if (m_firstBufferRenderedSourceId != 0) {
+        g_source_remove(m_firstBufferRenderedSourceId);
+        m_firstBufferRenderedSourceId = 0;
+    }
+    m_firstBufferRenderedId = ERROR_SOURCE_ID;
+}
+
+void MediaPlayer::sendFirstBufferRendered() {
+    auto id = m_firstBufferRenderedId.exchange(ERROR_SOURCE_ID);
+    if (ERROR_SOURCE_ID == id || id != m_currentId) {
+        return;
+    }
+    auto latency =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_setSourceTime);
+    ACSDK_DEBUG(LX("callingOnFirstBufferRendered").d("currentId", id).d("latencyInMs", latency.count()));
+    if (m_playerObserver) {
+        m_playerObserver->onFirstBufferRendered(id, latency);
+    }
+}
+
 void MediaPlayer::sendPlaybackPaused() {
     ACSDK_DEBUG(LX("callingOnPlaybackPaused").d("currentId", m_currentId));
     m_pausePending = false;
@@ -1549,6 +1846,8 @@ void MediaPlayer::cleanUpSource() {
     if (m_pipeline.pipeline) {
         gst_element_set_state(m_pipeline.pipeline, GST_STATE_NULL);
     }
+    // No more buffers reach the audio sink once the pipeline has stopped, so no new callback can be added after this.
+    cancelFirstBufferRenderedCallback();
     if (m_source) {
         m_source->shutdown();
     }
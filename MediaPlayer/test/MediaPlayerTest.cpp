@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <sys/resource.h>
+
 #include <algorithm>
 #include <chrono>
 #include <condition_variable>
@@ -91,6 +93,12 @@ static std::unordered_map<std::string, std::string> urlsToContentTypes;
 
 static std::unordered_map<std::string, std::string> urlsToContent;
 
+/// How long the mock content fetchers take before they start delivering a body, standing in for the network.
+static std::chrono::milliseconds fetchLatency;
+
+/// The fetch latency used when testing the preparation of the next source.
+static const std::chrono::milliseconds FETCH_LATENCY(1000);
+
 /// A mock content fetcher
 class MockContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
 public:
@@ -119,12 +127,16 @@ public:
             if (urlAndContent == urlsToContent.end()) {
                 return nullptr;
             }
+            std::this_thread::sleep_for(fetchLatency);
             std::promise<long> statusPromise;
             auto statusFuture = statusPromise.get_future();
             statusPromise.set_value(200);
+            // Like an HTTP server, provide the content-type along with the content.
+            auto urlAndContentType = urlsToContentTypes.find(m_url);
             std::promise<std::string> contentTypePromise;
             auto contentTypeFuture = contentTypePromise.get_future();
-            contentTypePromise.set_value("");
+            contentTypePromise.set_value(
+                urlAndContentType == urlsToContentTypes.end() ? "" : urlAndContentType->second);
             auto attachment = writeStringIntoAttachment(urlAndContent->second, writer);
             if (!attachment) {
                 return nullptr;
@@ -322,6 +334,8 @@ public:
 
     void onTags(SourceId id, std::unique_ptr<const VectorOfTags> vectorOfTags) override;
 
+    void onFirstBufferRendered(SourceId id, std::chrono::milliseconds latency) override;
+
     /**
      * Wait for a message to be received.
      *
@@ -400,6 +414,19 @@ public:
      */
     bool waitForTags(SourceId id, const std::chrono::milliseconds duration = std::chrono::milliseconds(5000));
 
+    /**
+     * Wait for the first buffer of a source to be rendered.
+     *
+     * @param id The @c SourceId expected in a callback.
+     * @param[out] latency The latency reported in the callback.
+     * @param duration Number of milliseconds to wait before giving up.
+     * @return true if the callback was received within the specified duration, else false.
+     */
+    bool waitForFirstBufferRendered(
+        SourceId id,
+        std::chrono::milliseconds* latency,
+        const std::chrono::milliseconds duration = std::chrono::milliseconds(5000));
+
     /**
      * TODO: Make this class a mock and remove this.
      *
@@ -436,6 +463,8 @@ private:
     std::condition_variable m_wakePlaybackError;
     /// Trigger to wake up m_wakeTags calls.
     std::condition_variable m_wakeTags;
+    /// Trigger to wake up waitForFirstBufferRendered calls.
+    std::condition_variable m_wakeFirstBufferRendered;
 
     // TODO: Make this class a mock and remove these.
     int m_onPlaybackStartedCallCount = 0;
@@ -458,6 +487,9 @@ private:
     bool m_tags;
 
     SourceId m_lastId = 0;
+
+    /// The latencies reported by onFirstBufferRendered, by source.
+    std::unordered_map<SourceId, std::chrono::milliseconds> m_firstBufferLatencies;
 };
 
 void MockPlayerObserver::onPlaybackStarted(SourceId id) {
@@ -508,6 +540,26 @@ void MockPlayerObserver::onPlaybackStopped(SourceId id) {
     m_wakePlaybackStopped.notify_all();
 };
 
+void MockPlayerObserver::onFirstBufferRendered(SourceId id, std::chrono::milliseconds latency) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    EXPECT_EQ(0u, m_firstBufferLatencies.count(id));
+    m_firstBufferLatencies[id] = latency;
+    m_wakeFirstBufferRendered.notify_all();
+}
+
+bool MockPlayerObserver::waitForFirstBufferRendered(
+    SourceId id,
+    std::chrono::milliseconds* latency,
+    const std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_wakeFirstBufferRendered.wait_for(
+            lock, duration, [this, id]() { return m_firstBufferLatencies.count(id) != 0; })) {
+        return false;
+    }
+    *latency = m_firstBufferLatencies[id];
+    return true;
+}
+
 bool MockPlayerObserver::waitForPlaybackStarted(SourceId id, const std::chrono::milliseconds duration) {
     std::unique_lock<std::mutex> lock(m_mutex);
     if (!m_wakePlaybackStarted.wait_for(lock, duration, [this, id]() { return m_playbackStarted && id == m_lastId; })) {
@@ -617,6 +669,7 @@ public:
 };
 
 void MediaPlayerTest::SetUp() {
+    fetchLatency = std::chrono::milliseconds::zero();
     m_playerObserver = std::make_shared<MockPlayerObserver>();
     m_mediaPlayer = MediaPlayer::create(std::make_shared<MockContentFetcherFactory>());
     ASSERT_TRUE(m_mediaPlayer);
@@ -656,6 +709,25 @@ TEST_F(MediaPlayerTest, testStartPlayWaitForEnd) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
 }
 
+/**
+ * Play two attachments one after the other, so that the second reuses the decoder of the first. Check that the time
+ * from setting each source to its first buffer reaching the audio sink is reported once per source.
+ */
+TEST_F(MediaPlayerTest, testFirstBufferRenderedReportedPerSource) {
+    for (int i = 0; i < 2; ++i) {
+        auto setSourceTime = std::chrono::steady_clock::now();
+        MediaPlayer::SourceId sourceId;
+        setAttachmentReaderSource(&sourceId);
+        ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+
+        std::chrono::milliseconds latency;
+        ASSERT_TRUE(m_playerObserver->waitForFirstBufferRendered(sourceId, &latency));
+        auto elapsed = std::chrono::steady_clock::now() - setSourceTime;
+        EXPECT_GE(elapsed, latency);
+        ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
+    }
+}
+
 /**
  * Set the source of the @c MediaPlayer to a url representing a single audio file. Playback audio till the end.
  * Check whether the playback started and playback finished notifications are received.
@@ -669,6 +741,42 @@ TEST_F(MediaPlayerTest, testStartPlayForUrl) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
 }
 
+/**
+ * Play a url three times in a row over a slow connection, preparing the second play while the first one plays but not
+ * the third. Check that the prepared source starts without waiting for the fetch, and that the other one does not.
+ */
+TEST_F(MediaPlayerTest, testPrepareNextSourceRemovesFetchGap) {
+    std::string url_single(FILE_PREFIX + inputsDirPath + MP3_FILE_PATH);
+    fetchLatency = FETCH_LATENCY;
+    auto timeout = MP3_FILE_LENGTH + FETCH_LATENCY * 2;
+
+    auto sourceId = m_mediaPlayer->setSource(url_single);
+    ASSERT_NE(ERROR_SOURCE_ID, sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId, timeout));
+    ASSERT_TRUE(m_mediaPlayer->prepareNextSource(url_single));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, timeout));
+
+    auto finishTime = std::chrono::steady_clock::now();
+    sourceId = m_mediaPlayer->setSource(url_single);
+    ASSERT_NE(ERROR_SOURCE_ID, sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId, timeout));
+    auto preparedGap = std::chrono::steady_clock::now() - finishTime;
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, timeout));
+
+    finishTime = std::chrono::steady_clock::now();
+    sourceId = m_mediaPlayer->setSource(url_single);
+    ASSERT_NE(ERROR_SOURCE_ID, sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId, timeout));
+    auto unpreparedGap = std::chrono::steady_clock::now() - finishTime;
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, timeout));
+
+    EXPECT_LT(preparedGap, FETCH_LATENCY);
+    EXPECT_GE(unpreparedGap, FETCH_LATENCY);
+}
+
 /**
  * Set the source of the @c MediaPlayer twice consecutively to a url representing a single audio file.
  * Playback audio till the end. Check whether the playback started and playback finished notifications
@@ -977,6 +1085,38 @@ TEST_F(MediaPlayerTest, testRecoveryFromPausedReads) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, std::chrono::milliseconds(20000)));
 }
 
+/**
+ * Benchmark playing an attachment which trickles in the way speech does, a little data every 100 milliseconds. Logs the
+ * CPU time used per second of audio, and checks that waiting for data does not keep a thread busy.
+ */
+TEST_F(MediaPlayerTest, testTricklingAttachmentCpuUsage) {
+    MediaPlayer::SourceId sourceId;
+    // About 6000 bytes per second, the rate of the MP3 test file, in 100 millisecond intervals.
+    setAttachmentReaderSource(&sourceId, 1, std::vector<size_t>(100, 600));
+
+    rusage startUsage;
+    ASSERT_EQ(0, getrusage(RUSAGE_SELF, &startUsage));
+    auto startTime = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, std::chrono::milliseconds(15000)));
+    auto wallTime = std::chrono::steady_clock::now() - startTime;
+    rusage endUsage;
+    ASSERT_EQ(0, getrusage(RUSAGE_SELF, &endUsage));
+
+    auto toMicroseconds = [](const timeval& time) {
+        return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+    };
+    auto cpuTime = toMicroseconds(endUsage.ru_utime) + toMicroseconds(endUsage.ru_stime) -
+                   toMicroseconds(startUsage.ru_utime) - toMicroseconds(startUsage.ru_stime);
+    auto cpuMillisecondsPerSecond = std::chrono::duration_cast<std::chrono::milliseconds>(cpuTime).count() * 1000 /
+                                    std::chrono::duration_cast<std::chrono::milliseconds>(MP3_FILE_LENGTH).count();
+    ACSDK_INFO(LX("testTricklingAttachmentCpuUsage")
+                   .d("cpuMillisecondsPerSecondOfAudio", cpuMillisecondsPerSecond)
+                   .d("wallMilliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(wallTime).count()));
+    EXPECT_LT(cpuTime, wallTime / 2);
+}
+
 /// Tests playing a dummy playlist
 TEST_F(MediaPlayerTest, testStartPlayWithUrlPlaylistWaitForEnd) {
     MediaPlayer::SourceId sourceId = m_mediaPlayer->setSource(TEST_M3U_PLAYLIST_URL);
@@ -18,6 +18,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
@@ -53,6 +54,34 @@ public:
     /// A return value that indicates a failure to start the playlist parsing.
     static const int START_FAILURE = 0;
 
+    /**
+     * The download of a playlist entry, which the parser started while determining whether the entry is a playlist.
+     */
+    struct EntryContent {
+        /// The fetcher performing the download. The download may stop once the fetcher is destroyed.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentFetcher;
+
+        /// The content returned by @c contentFetcher.
+        std::unique_ptr<avsCommon::utils::HTTPContent> httpContent;
+
+        /// The bytes at the start of the content, which have already been read from @c reader.
+        std::string prefix;
+
+        /// A reader from which to read the rest of the content, following @c prefix.
+        std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> reader;
+    };
+
+    /**
+     * Takes the download of the entry which is being passed to an observer, so that the observer can use it instead of
+     * fetching the entry again. This may only be called from within
+     * @c PlaylistParserObserverInterface::onPlaylistEntryParsed(). A download which has not been taken by the time
+     * that callback returns is dropped.
+     *
+     * @param requestId The id of the request the entry belongs to.
+     * @return The download of the entry, or @c nullptr if the parser did not download the entry.
+     */
+    std::unique_ptr<EntryContent> takeEntryContent(int requestId);
+
     void doShutdown() override;
 
 private:
@@ -60,6 +89,8 @@ private:
     struct UrlAndInfo {
         std::string url;
         std::chrono::milliseconds length;
+        /// Whether the URL is a segment of an HLS media playlist, which is known to be media without downloading it.
+        bool isMediaSegment;
     };
 
     /// A struct used to encapsulate information retrieved from an M3U playlist.
@@ -67,7 +98,8 @@ private:
         std::vector<UrlAndInfo> childrenUrls;
         bool endlistTagPresent;
         bool streamInfTagPresent;
-        M3UContent() : endlistTagPresent{false}, streamInfTagPresent{false} {};
+        bool targetDurationTagPresent;
+        M3UContent() : endlistTagPresent{false}, streamInfTagPresent{false}, targetDurationTagPresent{false} {};
     };
 
     /**
@@ -125,15 +157,36 @@ private:
     static void removeCarriageReturnFromLine(std::string* line);
 
     /**
-     * Retrieves content from a URL and stores it into a string.
+     * Reads content from a stream and appends it to a string, until at least a number of bytes have been read or the
+     * stream closes.
      *
-     * @param url The URL to retrieve from.
-     * @param [out] content The playlist content.
+     * @param reader The reader to read the content from.
+     * @param numBytes The number of bytes to read.
+     * @param [out] content The string to append the content to.
      * @return @c true if no error occured or @c false otherwise.
-     * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
-     * on a media URL could be blocking forever as the URL might point to a live stream.
+     * @note Passing a large @c numBytes for a stream from a media URL could be blocking forever as the URL might point
+     * to a live stream.
      */
-    bool getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const;
+    static bool readContent(
+        avsCommon::avs::attachment::AttachmentReader* reader,
+        size_t numBytes,
+        std::string* content);
+
+    /**
+     * Notifies the observer of an entry, offering it the download of the entry for the duration of the callback.
+     *
+     * @param id The id of the request.
+     * @param observer The observer to notify.
+     * @param urlAndInfo The entry.
+     * @param parseResult The result of parsing the playlist so far.
+     * @param entryContent The download of the entry, or @c nullptr if the entry was not downloaded.
+     */
+    void notifyObserver(
+        int id,
+        std::shared_ptr<avsCommon::utils::playlistParser::PlaylistParserObserverInterface> observer,
+        const UrlAndInfo& urlAndInfo,
+        avsCommon::utils::playlistParser::PlaylistParseResult parseResult,
+        std::unique_ptr<EntryContent> entryContent);
 
     /**
      * Determines whether the provided url is an absolute url as opposed to a relative url. This is done by simply
@@ -174,6 +227,15 @@ private:
     /// Used to indicate that a shutdown is occurring.
     std::atomic<bool> m_shuttingDown;
 
+    /// Serializes access to @c m_entryContentRequestId and @c m_entryContent.
+    std::mutex m_entryContentMutex;
+
+    /// The id of the request the entry currently being passed to an observer belongs to.
+    int m_entryContentRequestId;
+
+    /// The download of the entry currently being passed to an observer, if it has not been taken.
+    std::unique_ptr<EntryContent> m_entryContent;
+
     /**
      * @c Executor which queues up operations from asynchronous API calls.
      *
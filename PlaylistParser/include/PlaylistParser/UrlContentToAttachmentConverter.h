@@ -16,6 +16,7 @@
 #ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_URLCONTENTTOATTACHMENTCONVERTER_H_
 #define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_URLCONTENTTOATTACHMENTCONVERTER_H_
 
+#include <deque>
 #include <memory>
 
 #include <AVSCommon/AVS/Attachment/InProcessAttachment.h>
@@ -46,6 +47,36 @@ public:
         virtual void onError() = 0;
     };
 
+    /// Statistics about the streaming of the entries of a playlist into the attachment.
+    struct StreamingStatistics {
+        /// Constructor.
+        StreamingStatistics();
+
+        /// The number of entries written into the attachment.
+        size_t numEntries;
+
+        /// The number of bytes of entries written into the attachment.
+        uint64_t numBytes;
+
+        /// The number of entries whose download started before their turn to be written came.
+        size_t numPrefetchedEntries;
+
+        /// The number of times the data of an entry stopped arriving for a read timeout after its first byte.
+        size_t numUnderruns;
+
+        /// The longest wait for the first byte of an entry once the previous entry had been written.
+        std::chrono::milliseconds maxEntryGap;
+
+        /// The total of the waits for the first byte of each entry once the previous entry had been written.
+        std::chrono::milliseconds totalEntryGap;
+    };
+
+    /// The default maximum number of entries downloaded ahead of the entry being written.
+    static constexpr size_t DEFAULT_MAX_PREFETCHED_ENTRIES = 3;
+
+    /// The default memory budget, in bytes, for the entries downloaded ahead of the entry being written.
+    static constexpr size_t DEFAULT_PREFETCH_BUFFER_SIZE_IN_BYTES = 0x200000;
+
     /**
      * Creates a converter object. Note that calling this function will commence the parsing and streaming of the URL
      * into the internal attachment. If a desired start time is specified, this function will attempt to start streaming
@@ -59,6 +90,13 @@ public:
      * @param startTime The desired time to attempt to start streaming from. Note that this will only succeed
      * in cases where the URL points to a playlist with metadata about individual chunks within it. If none are found,
      * streaming will begin from the beginning.
+     * @param maxPrefetchedEntries The maximum number of playlist entries downloaded ahead of the entry being written,
+     * so that each entry is ready by the time the previous one has been written. Zero downloads each entry only when
+     * its turn comes. Only entries with a known duration, such as HLS media segments, are downloaded ahead, since the
+     * others may be endless live streams.
+     * @param prefetchBufferSizeInBytes The memory budget for the entries downloaded ahead. No more entries are
+     * downloaded ahead once the bytes the downloads in progress are expected to hold, judged by what they have
+     * buffered and by the average size of the entries written so far, would exceed it.
      * @return A @c std::shared_ptr to the new @c UrlContentToAttachmentConverter object or @c nullptr on failure.
      *
      * @note This object is intended to be used once. Subsequent calls to @c convertPlaylistToAttachment() will fail.
@@ -67,7 +105,9 @@ public:
         std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
         const std::string& url,
         std::shared_ptr<ErrorObserverInterface> observer,
-        std::chrono::milliseconds startTime = std::chrono::milliseconds::zero());
+        std::chrono::milliseconds startTime = std::chrono::milliseconds::zero(),
+        size_t maxPrefetchedEntries = DEFAULT_MAX_PREFETCHED_ENTRIES,
+        size_t prefetchBufferSizeInBytes = DEFAULT_PREFETCH_BUFFER_SIZE_IN_BYTES);
 
     /**
      * Returns the attachment into which the URL content was streamed into.
@@ -90,6 +130,13 @@ public:
      */
     std::chrono::milliseconds getDesiredStreamingPoint();
 
+    /**
+     * Gets statistics about the entries written into the attachment so far.
+     *
+     * @return The statistics.
+     */
+    StreamingStatistics getStreamingStatistics();
+
     void doShutdown() override;
 
 private:
@@ -102,12 +149,31 @@ private:
      * @param desiredStartTime The desired time to attempt to start streaming from. Note that this will only succeed
      * in cases where the URL points to a playlist with metadata about individual chunks within it. If none are found,
      * streaming will begin from the beginning.
+     * @param maxPrefetchedEntries The maximum number of entries downloaded ahead of the entry being written.
+     * @param prefetchBufferSizeInBytes The memory budget for the entries downloaded ahead.
      */
     UrlContentToAttachmentConverter(
         std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
         const std::string& url,
         std::shared_ptr<ErrorObserverInterface> observer,
-        std::chrono::milliseconds startTime);
+        std::chrono::milliseconds startTime,
+        size_t maxPrefetchedEntries,
+        size_t prefetchBufferSizeInBytes);
+
+    /// A playlist entry waiting to be written into the stream.
+    struct PendingEntry {
+        /// The url of the entry.
+        std::string url;
+
+        /// The download of the entry, or @c nullptr if it has not started yet.
+        std::shared_ptr<PlaylistParser::EntryContent> content;
+
+        /// The duration of the entry, or @c INVALID_DURATION if the playlist does not give one.
+        std::chrono::milliseconds duration;
+
+        /// Whether the download started before the entry's turn to be written came.
+        bool prefetched;
+    };
 
     void onPlaylistEntryParsed(
         int requestId,
@@ -115,6 +181,55 @@ private:
         avsCommon::utils::playlistParser::PlaylistParseResult parseResult,
         std::chrono::milliseconds duration = PlaylistParserObserverInterface::INVALID_DURATION) override;
 
+    /**
+     * Queues an entry to be written into the stream, and starts its download if there is room for it.
+     *
+     * @param url The url of the entry.
+     * @param duration The duration of the entry, or @c INVALID_DURATION if the playlist does not give one.
+     * @param entryContent The download of the url already started by the @c PlaylistParser, or @c nullptr.
+     * @return The queued entry.
+     */
+    std::shared_ptr<PendingEntry> queueEntry(
+        const std::string& url,
+        std::chrono::milliseconds duration,
+        std::shared_ptr<PlaylistParser::EntryContent> entryContent);
+
+    /**
+     * Starts the downloads of the queued entries, in order, until the download limits are reached.
+     *
+     * @note This must be called with @c m_entriesMutex held.
+     */
+    void startDownloadsLocked();
+
+    /**
+     * Starts downloading a url.
+     *
+     * @param url The url to download.
+     * @return The download. Failures to start it are reported when it is written.
+     */
+    std::shared_ptr<PlaylistParser::EntryContent> startDownload(const std::string& url);
+
+    /**
+     * Gets the number of bytes a download has buffered which have not been written yet.
+     *
+     * @param entryContent The download.
+     * @return The number of bytes.
+     */
+    static uint64_t getBufferedBytes(PlaylistParser::EntryContent& entryContent);
+
+    /**
+     * Removes an entry from the queue, which cancels its download if it is still in progress, and starts the
+     * downloads that the removal makes room for.
+     *
+     * @param entry The entry to remove.
+     */
+    void finishEntry(std::shared_ptr<PendingEntry> entry);
+
+    /**
+     * Stops all downloads, including those of entries that are queued but not yet written.
+     */
+    void stopDownloads();
+
     /**
      * @name Executor Thread Functions
      *
@@ -125,11 +240,35 @@ private:
     /// @{
 
     /**
-     * Downloads the content from the url and writes it into the internal stream.
+     * Downloads the content of a queued entry, unless it is already downloading, and writes it into the internal
+     * stream.
      *
+     * @param entry The entry.
      * @return @c true if the content was successfully streamed and written or @c false otherwise.
      */
-    bool writeUrlContentIntoStream(std::string url);
+    bool writeUrlContentIntoStream(std::shared_ptr<PendingEntry> entry);
+
+    /**
+     * Writes the rest of a download into the internal stream.
+     *
+     * @param entryContent The download.
+     * @param startTime When the previous entry had been written, which is when the wait for this entry began.
+     * @param[in,out] statistics The statistics to add the entry to.
+     * @return @c true if the content was successfully streamed and written or @c false otherwise.
+     */
+    bool writeEntryContentIntoStream(
+        std::shared_ptr<PlaylistParser::EntryContent> entryContent,
+        std::chrono::steady_clock::time_point startTime,
+        StreamingStatistics* statistics);
+
+    /**
+     * Writes data into the internal stream, waiting for room as needed.
+     *
+     * @param data The data to write.
+     * @param size The number of bytes to write.
+     * @return @c true if all of the data was written or @c false otherwise.
+     */
+    bool writeIntoStream(const char* data, size_t size);
 
     /// @}
 
@@ -157,6 +296,24 @@ private:
     /// Flag to indicate if a shutdown is occurring.
     std::atomic<bool> m_shuttingDown;
 
+    /// The maximum number of entries downloaded ahead of the entry being written.
+    const size_t m_maxPrefetchedEntries;
+
+    /// The memory budget for the entries downloaded ahead of the entry being written.
+    const size_t m_prefetchBufferSizeInBytes;
+
+    /// Serializes access to the members below.
+    std::mutex m_entriesMutex;
+
+    /// The entries waiting to be written into the stream, in order. The first is the one being written.
+    std::deque<std::shared_ptr<PendingEntry>> m_pendingEntries;
+
+    /// Whether no more downloads should be started.
+    bool m_downloadsStopped;
+
+    /// Statistics about the entries written so far.
+    StreamingStatistics m_statistics;
+
     /**
      * @name @c onPlaylistEntryParsed Callback Variables
      *
@@ -16,6 +16,7 @@
 #include "PlaylistParser/PlaylistParser.h"
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
@@ -43,6 +44,9 @@ static const std::string PLS_CONTENT_TYPE = "scpls";
 /// The number of bytes read from the attachment with each read in the read loop.
 static const size_t CHUNK_SIZE(1024);
 
+/// The number of bytes at the start of the content of a URL which are inspected to recognize a playlist.
+static const size_t SNIFF_SIZE(16);
+
 /// The id of each request.
 static int g_id = 0;
 
@@ -63,6 +67,12 @@ static const std::string EXTSTREAMINF = "#EXT-X-STREAM-INF";
  */
 static const std::string ENDLIST = "#EXT-X-ENDLIST";
 
+/**
+ * A tag which every HLS media playlist has, and in which each URL tagged with @c EXTINF is a media segment rather than
+ * a playlist.
+ */
+static const std::string TARGETDURATION = "#EXT-X-TARGETDURATION";
+
 /// The first line of a PLS playlist.
 static const std::string PLS_PLAYLIST_HEADER = "[playlist]";
 
@@ -103,7 +113,36 @@ PlaylistParser::PlaylistParser(
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) :
         RequiresShutdown{"PlaylistParser"},
         m_contentFetcherFactory{contentFetcherFactory},
-        m_shuttingDown{false} {
+        m_shuttingDown{false},
+        m_entryContentRequestId{0} {
+}
+
+std::unique_ptr<PlaylistParser::EntryContent> PlaylistParser::takeEntryContent(int requestId) {
+    std::lock_guard<std::mutex> lock(m_entryContentMutex);
+    if (requestId != m_entryContentRequestId) {
+        return nullptr;
+    }
+    return std::move(m_entryContent);
+}
+
+void PlaylistParser::notifyObserver(
+    int id,
+    std::shared_ptr<avsCommon::utils::playlistParser::PlaylistParserObserverInterface> observer,
+    const UrlAndInfo& urlAndInfo,
+    avsCommon::utils::playlistParser::PlaylistParseResult parseResult,
+    std::unique_ptr<EntryContent> entryContent) {
+    {
+        std::lock_guard<std::mutex> lock(m_entryContentMutex);
+        m_entryContentRequestId = id;
+        m_entryContent = std::move(entryContent);
+    }
+    observer->onPlaylistEntryParsed(id, urlAndInfo.url, parseResult, urlAndInfo.length);
+    {
+        std::lock_guard<std::mutex> lock(m_entryContentMutex);
+        entryContent = std::move(m_entryContent);
+    }
+    // Drop a download the observer did not take outside of the lock, as stopping it may block.
+    entryContent.reset();
 }
 
 void PlaylistParser::doDepthFirstSearch(
@@ -117,12 +156,12 @@ void PlaylistParser::doDepthFirstSearch(
      * 2. While vector isn't empty, pop from front and push children, in the order they appeared, to front of vector.
      */
     std::deque<UrlAndInfo> urlsToParse;
-    urlsToParse.push_front({rootUrl, INVALID_DURATION});
+    urlsToParse.push_front({rootUrl, INVALID_DURATION, false});
     std::string lastUrlParsed;
     while (!urlsToParse.empty() && !m_shuttingDown) {
         auto urlAndInfo = urlsToParse.front();
         urlsToParse.pop_front();
-        if (urlAndInfo.length != INVALID_DURATION) {
+        if (urlAndInfo.length != INVALID_DURATION || urlAndInfo.isMediaSegment) {
             // This is a media URL and not a playlist
             ACSDK_DEBUG9(LX("foundNonPlaylistURL"));
             observer->onPlaylistEntryParsed(
@@ -134,24 +173,42 @@ void PlaylistParser::doDepthFirstSearch(
             continue;
         }
         auto contentFetcher = m_contentFetcherFactory->create(urlAndInfo.url);
+        /*
+         * The URL is downloaded only once: its type is determined from the content-type header and the first bytes of
+         * the content, after which the download is either parsed as a playlist or passed on to the observer.
+         */
         auto httpContent = contentFetcher->getContent(
-            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
-        if (!httpContent || !(*httpContent)) {
+            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+        if (!httpContent || !(*httpContent) || !httpContent->dataStream) {
             ACSDK_ERROR(LX("getHTTPContent").d("reason", "badHTTPContentReceived"));
             observer->onPlaylistEntryParsed(
                 id, urlAndInfo.url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR, urlAndInfo.length);
             return;
         }
+        auto reader = httpContent->dataStream->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
+        std::string content;
+        if (!reader || !readContent(reader.get(), SNIFF_SIZE, &content)) {
+            ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
+            observer->onPlaylistEntryParsed(
+                id, urlAndInfo.url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR, urlAndInfo.length);
+            return;
+        }
         std::string contentType = httpContent->contentType.get();
         ACSDK_DEBUG9(LX("PlaylistParser")
                          .d("contentType", contentType)
                          .sensitive("url", urlAndInfo.url)
                          .d("length", urlAndInfo.length.count()));
         std::transform(contentType.begin(), contentType.end(), contentType.begin(), ::tolower);
-        // Checking the HTML content type to see if the URL is a playlist.
-        if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos) {
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
+        auto takeContent = [&contentFetcher, &httpContent, &reader, &content]() {
+            return std::unique_ptr<EntryContent>(
+                new EntryContent{std::move(contentFetcher), std::move(httpContent), content, std::move(reader)});
+        };
+        auto result = urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
+                                          : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING;
+        // Checking the HTML content type, then the start of the content, to see if the URL is a playlist.
+        if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos ||
+            content.compare(0, M3U8_PLAYLIST_HEADER.length(), M3U8_PLAYLIST_HEADER) == 0) {
+            if (!readContent(reader.get(), std::numeric_limits<size_t>::max(), &content)) {
                 ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
                 observer->onPlaylistEntryParsed(
                     id,
@@ -161,7 +218,7 @@ void PlaylistParser::doDepthFirstSearch(
                 return;
             }
             // This playlist may either be M3U or M3U8 so some additional parsing is required.
-            bool isM3U8 = isM3UPlaylistM3U8(playlistContent);
+            bool isM3U8 = isM3UPlaylistM3U8(content);
             if (isM3U8) {
                 ACSDK_DEBUG9(LX("isM3U8Playlist").sensitive("url", urlAndInfo.url));
             } else {
@@ -172,15 +229,10 @@ void PlaylistParser::doDepthFirstSearch(
                     playlistTypesToNotBeParsed.begin(),
                     playlistTypesToNotBeParsed.end(),
                     isM3U8 ? PlaylistType::M3U8 : PlaylistType::M3U) != playlistTypesToNotBeParsed.end()) {
-                observer->onPlaylistEntryParsed(
-                    id,
-                    urlAndInfo.url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
-                    urlAndInfo.length);
+                notifyObserver(id, observer, urlAndInfo, result, takeContent());
                 continue;
             }
-            auto M3UContent = parseM3UContent(urlAndInfo.url, playlistContent);
+            auto M3UContent = parseM3UContent(urlAndInfo.url, content);
             const auto& childrenUrls = M3UContent.childrenUrls;
             if (childrenUrls.empty()) {
                 ACSDK_ERROR(LX("noChildrenURLs"));
@@ -242,7 +294,9 @@ void PlaylistParser::doDepthFirstSearch(
                     urlsToParse.push_front(*reverseIt);
                 }
             }
-        } else if (contentType.find(PLS_CONTENT_TYPE) != std::string::npos) {
+        } else if (
+            contentType.find(PLS_CONTENT_TYPE) != std::string::npos ||
+            content.compare(0, PLS_PLAYLIST_HEADER.length(), PLS_PLAYLIST_HEADER) == 0) {
             ACSDK_DEBUG9(LX("isPLSPlaylist").sensitive("url", urlAndInfo.url));
             /*
              * This is for sure a PLS playlist, so if PLS is one of the desired playlist types to not be parsed, then
@@ -250,16 +304,10 @@ void PlaylistParser::doDepthFirstSearch(
              */
             if (std::find(playlistTypesToNotBeParsed.begin(), playlistTypesToNotBeParsed.end(), PlaylistType::PLS) !=
                 playlistTypesToNotBeParsed.end()) {
-                observer->onPlaylistEntryParsed(
-                    id,
-                    urlAndInfo.url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
-                    urlAndInfo.length);
+                notifyObserver(id, observer, urlAndInfo, result, takeContent());
                 continue;
             }
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
+            if (!readContent(reader.get(), std::numeric_limits<size_t>::max(), &content)) {
                 observer->onPlaylistEntryParsed(
                     id,
                     urlAndInfo.url,
@@ -267,7 +315,7 @@ void PlaylistParser::doDepthFirstSearch(
                     urlAndInfo.length);
                 return;
             }
-            auto childrenUrls = parsePLSContent(urlAndInfo.url, playlistContent);
+            auto childrenUrls = parsePLSContent(urlAndInfo.url, content);
             if (childrenUrls.empty()) {
                 observer->onPlaylistEntryParsed(
                     id,
@@ -277,49 +325,31 @@ void PlaylistParser::doDepthFirstSearch(
                 return;
             }
             for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                urlsToParse.push_front({*reverseIt, INVALID_DURATION});
+                urlsToParse.push_front({*reverseIt, INVALID_DURATION, false});
             }
         } else {
             ACSDK_DEBUG9(LX("foundNonPlaylistURL"));
             // This is a non-playlist URL or a playlist that we don't support (M3U, M3U8, PLS).
-            observer->onPlaylistEntryParsed(
-                id,
-                urlAndInfo.url,
-                urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                    : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
-                urlAndInfo.length);
+            notifyObserver(id, observer, urlAndInfo, result, takeContent());
         }
     }
 }
 
-bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const {
-    if (!content) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullString"));
-        return false;
-    }
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent =
-        contentFetcher->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
-    if (!httpContent) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullHTTPContentReceived"));
-        return false;
-    }
-    if (!(*httpContent)) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "badHTTPContentReceived"));
-        return false;
-    }
-    auto reader = httpContent->dataStream->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
-    if (!reader) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "failedToCreateStreamReader"));
+bool PlaylistParser::readContent(
+    avsCommon::avs::attachment::AttachmentReader* reader,
+    size_t numBytes,
+    std::string* content) {
+    if (!reader || !content) {
+        ACSDK_ERROR(LX("readContentFailed").d("reason", "nullReaderOrString"));
         return false;
     }
     avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
         avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
-    std::string playlistContent;
     std::vector<char> buffer(CHUNK_SIZE, 0);
+    size_t bytesRemaining = numBytes;
     bool streamClosed = false;
-    while (!streamClosed) {
-        auto bytesRead = reader->read(buffer.data(), buffer.size(), &readStatus);
+    while (!streamClosed && bytesRemaining > 0) {
+        auto bytesRead = reader->read(buffer.data(), std::min(buffer.size(), bytesRemaining), &readStatus);
         switch (readStatus) {
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED:
                 streamClosed = true;
@@ -330,16 +360,16 @@ bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url,
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
-                playlistContent.append(buffer.data(), bytesRead);
+                content->append(buffer.data(), bytesRead);
+                bytesRemaining -= bytesRead;
                 break;
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
-                ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "readError"));
+                ACSDK_ERROR(LX("readContentFailed").d("reason", "readError"));
                 return false;
         }
     }
-    *content = playlistContent;
     return true;
 }
 
@@ -353,6 +383,7 @@ PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& pl
     std::string line;
     UrlAndInfo entry;
     entry.length = INVALID_DURATION;
+    entry.isMediaSegment = false;
     while (std::getline(iss, line)) {
         removeCarriageReturnFromLine(&line);
         std::istringstream iss2(line);
@@ -364,6 +395,9 @@ PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& pl
         if (firstChar == '#') {
             if (line.compare(0, EXTINF.length(), EXTINF) == 0) {
                 entry.length = parseRuntime(line);
+                entry.isMediaSegment = true;
+            } else if (line.compare(0, TARGETDURATION.length(), TARGETDURATION) == 0) {
+                parsedContent.targetDurationTagPresent = true;
             } else if (line.compare(0, EXTSTREAMINF.length(), EXTSTREAMINF) == 0) {
                 parsedContent.streamInfTagPresent = true;
             } else if (line.compare(0, ENDLIST.length(), ENDLIST) == 0) {
@@ -377,6 +411,7 @@ PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& pl
             parsedContent.childrenUrls.push_back(entry);
             entry.url.clear();
             entry.length = INVALID_DURATION;
+            entry.isMediaSegment = false;
         } else {
             std::string absoluteURL;
             if (getAbsoluteURLFromRelativePathToURL(playlistURL, line, &absoluteURL)) {
@@ -384,9 +419,16 @@ PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& pl
                 parsedContent.childrenUrls.push_back(entry);
                 entry.url.clear();
                 entry.length = INVALID_DURATION;
+                entry.isMediaSegment = false;
             }
         }
     }
+    if (!parsedContent.targetDurationTagPresent) {
+        // Outside of an HLS media playlist, an #EXTINF tag may just as well describe a playlist.
+        for (auto& child : parsedContent.childrenUrls) {
+            child.isMediaSegment = false;
+        }
+    }
     return parsedContent;
 }
 
@@ -15,6 +15,9 @@
 
 #include "PlaylistParser/UrlContentToAttachmentConverter.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 namespace alexaClientSDK {
@@ -33,16 +36,40 @@ static const std::string TAG("UrlContentToAttachmentConverter");
 static const std::chrono::milliseconds UNVALID_DURATION =
     avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION;
 
+/// The number of bytes read from the download of an entry with each read in the read loop.
+static const size_t CHUNK_SIZE(4096);
+
+/// The timeout for a blocking read from the download of an entry.
+static const std::chrono::milliseconds TIMEOUT_FOR_BLOCKING_READ(100);
+
+/// The timeout for a blocking write call to the stream.
+static const std::chrono::milliseconds TIMEOUT_FOR_BLOCKING_WRITE(100);
+
+// The definition for these static class members.
+constexpr size_t UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCHED_ENTRIES;
+constexpr size_t UrlContentToAttachmentConverter::DEFAULT_PREFETCH_BUFFER_SIZE_IN_BYTES;
+
+UrlContentToAttachmentConverter::StreamingStatistics::StreamingStatistics() :
+        numEntries{0},
+        numBytes{0},
+        numPrefetchedEntries{0},
+        numUnderruns{0},
+        maxEntryGap{0},
+        totalEntryGap{0} {
+}
+
 std::shared_ptr<UrlContentToAttachmentConverter> UrlContentToAttachmentConverter::create(
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
     const std::string& url,
     std::shared_ptr<ErrorObserverInterface> observer,
-    std::chrono::milliseconds startTime) {
+    std::chrono::milliseconds startTime,
+    size_t maxPrefetchedEntries,
+    size_t prefetchBufferSizeInBytes) {
     if (!contentFetcherFactory) {
         return nullptr;
     }
-    auto thisSharedPointer = std::shared_ptr<UrlContentToAttachmentConverter>(
-        new UrlContentToAttachmentConverter(contentFetcherFactory, url, observer, startTime));
+    auto thisSharedPointer = std::shared_ptr<UrlContentToAttachmentConverter>(new UrlContentToAttachmentConverter(
+        contentFetcherFactory, url, observer, startTime, maxPrefetchedEntries, prefetchBufferSizeInBytes));
     auto retVal = thisSharedPointer->m_playlistParser->parsePlaylist(url, thisSharedPointer);
     if (0 == retVal) {
         thisSharedPointer->shutdown();
@@ -59,12 +86,17 @@ UrlContentToAttachmentConverter::UrlContentToAttachmentConverter(
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
     const std::string& url,
     std::shared_ptr<ErrorObserverInterface> observer,
-    std::chrono::milliseconds startTime) :
+    std::chrono::milliseconds startTime,
+    size_t maxPrefetchedEntries,
+    size_t prefetchBufferSizeInBytes) :
         RequiresShutdown{"UrlContentToAttachmentConverter"},
         m_desiredStreamPoint{startTime},
         m_contentFetcherFactory{contentFetcherFactory},
         m_observer{observer},
         m_shuttingDown{false},
+        m_maxPrefetchedEntries{maxPrefetchedEntries},
+        m_prefetchBufferSizeInBytes{prefetchBufferSizeInBytes},
+        m_downloadsStopped{false},
         m_runningTotal{0},
         m_startedStreaming{false},
         m_streamWriterClosed{false} {
@@ -82,6 +114,11 @@ std::chrono::milliseconds UrlContentToAttachmentConverter::getDesiredStreamingPo
     return m_desiredStreamPoint;
 }
 
+UrlContentToAttachmentConverter::StreamingStatistics UrlContentToAttachmentConverter::getStreamingStatistics() {
+    std::lock_guard<std::mutex> lock{m_entriesMutex};
+    return m_statistics;
+}
+
 void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
     int requestId,
     std::string url,
@@ -104,6 +141,15 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             m_startStreamingPointPromise.set_value(std::chrono::seconds::zero());
         }
     }
+    /*
+     * The download of the entry which starts the stream is written right away, so take it over from the parser rather
+     * than fetching the URL again. Later entries are fetched by the prefetcher, which bounds how far ahead of the
+     * entry being written they are downloaded.
+     */
+    std::shared_ptr<PlaylistParser::EntryContent> entryContent;
+    if (!m_startedStreaming) {
+        entryContent = m_playlistParser->takeEntryContent(requestId);
+    }
     m_startedStreaming = true;
     ACSDK_DEBUG3(LX("onPlaylistEntryParsed").d("status", parseResult));
     switch (parseResult) {
@@ -112,6 +158,7 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
                 ACSDK_DEBUG9(LX("closingWriter"));
                 m_streamWriter->close();
                 m_streamWriterClosed = true;
+                stopDownloads();
                 std::unique_lock<std::mutex> lock{m_mutex};
                 auto observer = m_observer;
                 lock.unlock();
@@ -120,9 +167,10 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
                 }
             });
             break;
-        case avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS:
-            m_executor.submit([this, url]() {
-                if (!m_streamWriterClosed && !writeUrlContentIntoStream(url)) {
+        case avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS: {
+            auto entry = queueEntry(url, duration, entryContent);
+            m_executor.submit([this, entry]() {
+                if (!m_streamWriterClosed && !writeUrlContentIntoStream(entry)) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed"));
                     std::unique_lock<std::mutex> lock{m_mutex};
                     auto observer = m_observer;
@@ -134,14 +182,19 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
                 ACSDK_DEBUG9(LX("closingWriter"));
                 m_streamWriter->close();
                 m_streamWriterClosed = true;
+                finishEntry(entry);
+                stopDownloads();
             });
             break;
-        case avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING:
-            m_executor.submit([this, url]() {
-                if (!m_streamWriterClosed && !writeUrlContentIntoStream(url)) {
+        }
+        case avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING: {
+            auto entry = queueEntry(url, duration, entryContent);
+            m_executor.submit([this, entry]() {
+                if (!m_streamWriterClosed && !writeUrlContentIntoStream(entry)) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed").d("info", "closingWriter"));
                     m_streamWriter->close();
                     m_streamWriterClosed = true;
+                    stopDownloads();
                     std::unique_lock<std::mutex> lock{m_mutex};
                     auto observer = m_observer;
                     lock.unlock();
@@ -149,34 +202,250 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
                         observer->onError();
                     }
                 }
+                finishEntry(entry);
             });
             break;
+        }
         default:
             return;
     }
 }
 
-bool UrlContentToAttachmentConverter::writeUrlContentIntoStream(std::string url) {
+std::shared_ptr<UrlContentToAttachmentConverter::PendingEntry> UrlContentToAttachmentConverter::queueEntry(
+    const std::string& url,
+    std::chrono::milliseconds duration,
+    std::shared_ptr<PlaylistParser::EntryContent> entryContent) {
+    auto entry = std::make_shared<PendingEntry>();
+    entry->url = url;
+    entry->duration = duration;
+    entry->content = entryContent;
+    entry->prefetched = false;
+    std::lock_guard<std::mutex> lock{m_entriesMutex};
+    m_pendingEntries.push_back(entry);
+    startDownloadsLocked();
+    return entry;
+}
+
+void UrlContentToAttachmentConverter::startDownloadsLocked() {
+    if (m_downloadsStopped || m_pendingEntries.empty()) {
+        return;
+    }
+    // The entry being written is always downloading.
+    auto& front = m_pendingEntries.front();
+    if (!front->content) {
+        front->content = startDownload(front->url);
+        ACSDK_DEBUG9(LX("startDownload").d("prefetched", false));
+    }
+    /*
+     * Only entries with a known duration, such as the media segments of an HLS playlist, are downloaded ahead. Entries
+     * without one, such as the alternative URLs of a PLS or M3U playlist, may be endless live streams which would
+     * buffer for as long as they are left downloading.
+     *
+     * Up to m_maxPrefetchedEntries are downloaded ahead, as long as the bytes they are expected to hold fit in the
+     * memory budget. A download is expected to hold the larger of what it has buffered so far and the average size of
+     * the entries written so far, which is unknown until the first entry has been written.
+     */
+    uint64_t averageEntrySize = m_statistics.numEntries > 0 ? m_statistics.numBytes / m_statistics.numEntries : 0;
+    uint64_t expectedBytes = 0;
+    size_t numPrefetched = 0;
+    for (auto it = std::next(m_pendingEntries.begin()); it != m_pendingEntries.end(); ++it) {
+        auto& entry = *it;
+        if (numPrefetched >= m_maxPrefetchedEntries || UNVALID_DURATION == entry->duration) {
+            break;
+        }
+        if (!entry->content) {
+            if (expectedBytes + averageEntrySize > m_prefetchBufferSizeInBytes) {
+                break;
+            }
+            entry->prefetched = true;
+            entry->content = startDownload(entry->url);
+            ACSDK_DEBUG9(LX("startDownload").d("prefetched", true).d("expectedBytes", expectedBytes));
+        }
+        expectedBytes += std::max(getBufferedBytes(*entry->content), averageEntrySize);
+        ++numPrefetched;
+    }
+}
+
+uint64_t UrlContentToAttachmentConverter::getBufferedBytes(PlaylistParser::EntryContent& entryContent) {
+    uint64_t numBytes = entryContent.prefix.size();
+    if (entryContent.reader) {
+        numBytes += entryContent.reader->getNumUnreadBytes();
+    }
+    return numBytes;
+}
+
+std::shared_ptr<PlaylistParser::EntryContent> UrlContentToAttachmentConverter::startDownload(const std::string& url) {
+    auto entryContent = std::make_shared<PlaylistParser::EntryContent>();
+    entryContent->contentFetcher = m_contentFetcherFactory->create(url);
+    if (!entryContent->contentFetcher) {
+        return entryContent;
+    }
+    entryContent->httpContent = entryContent->contentFetcher->getContent(
+        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    if (entryContent->httpContent && entryContent->httpContent->dataStream) {
+        entryContent->reader =
+            entryContent->httpContent->dataStream->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
+    }
+    return entryContent;
+}
+
+void UrlContentToAttachmentConverter::finishEntry(std::shared_ptr<PendingEntry> entry) {
+    std::shared_ptr<PlaylistParser::EntryContent> content;
+    {
+        std::lock_guard<std::mutex> lock{m_entriesMutex};
+        auto it = std::find(m_pendingEntries.begin(), m_pendingEntries.end(), entry);
+        if (it != m_pendingEntries.end()) {
+            m_pendingEntries.erase(it);
+        }
+        content = std::move(entry->content);
+        startDownloadsLocked();
+    }
+    // Destroying the download outside the lock, since it waits for the download thread to stop.
+    content.reset();
+}
+
+void UrlContentToAttachmentConverter::stopDownloads() {
+    std::vector<std::shared_ptr<PlaylistParser::EntryContent>> contents;
+    {
+        std::lock_guard<std::mutex> lock{m_entriesMutex};
+        m_downloadsStopped = true;
+        for (auto& entry : m_pendingEntries) {
+            contents.push_back(std::move(entry->content));
+        }
+    }
+    // Destroying the downloads outside the lock, since each waits for its download thread to stop.
+    contents.clear();
+}
+
+bool UrlContentToAttachmentConverter::writeUrlContentIntoStream(std::shared_ptr<PendingEntry> entry) {
     ACSDK_DEBUG9(LX("writeUrlContentIntoStream").d("info", "beginning"));
 
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent = contentFetcher->getContent(
-        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, m_streamWriter);
+    auto startTime = std::chrono::steady_clock::now();
+    std::shared_ptr<PlaylistParser::EntryContent> entryContent;
+    StreamingStatistics statistics;
+    {
+        std::lock_guard<std::mutex> lock{m_entriesMutex};
+        startDownloadsLocked();
+        entryContent = entry->content;
+        statistics.numPrefetchedEntries = entry->prefetched ? 1 : 0;
+    }
+    if (!entryContent) {
+        return false;
+    }
+    auto& httpContent = entryContent->httpContent;
     if (!httpContent) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "nullHTTPContentReceived"));
         return false;
     }
-    if (!(*httpContent)) {
+    // A download handed over by the parser has had its status checked already.
+    if (httpContent->statusCode.valid() && !(*httpContent)) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "badHTTPContentReceived"));
         return false;
     }
+    if (!entryContent->reader) {
+        ACSDK_ERROR(LX("getContentFailed").d("reason", "nullReader"));
+        return false;
+    }
+    if (!writeEntryContentIntoStream(entryContent, startTime, &statistics)) {
+        return false;
+    }
     if (m_shuttingDown) {
         return false;
     }
-    ACSDK_DEBUG9(LX("writeUrlContentIntoStreamSuccess"));
+
+    std::lock_guard<std::mutex> lock{m_entriesMutex};
+    m_statistics.numEntries += statistics.numEntries;
+    m_statistics.numBytes += statistics.numBytes;
+    m_statistics.numPrefetchedEntries += statistics.numPrefetchedEntries;
+    m_statistics.numUnderruns += statistics.numUnderruns;
+    m_statistics.maxEntryGap = std::max(m_statistics.maxEntryGap, statistics.maxEntryGap);
+    m_statistics.totalEntryGap += statistics.totalEntryGap;
+    ACSDK_DEBUG9(LX("writeUrlContentIntoStreamSuccess")
+                     .d("bytes", statistics.numBytes)
+                     .d("prefetched", statistics.numPrefetchedEntries)
+                     .d("gapMs", statistics.maxEntryGap.count())
+                     .d("underruns", statistics.numUnderruns));
     return true;
 }
 
+bool UrlContentToAttachmentConverter::writeEntryContentIntoStream(
+    std::shared_ptr<PlaylistParser::EntryContent> entryContent,
+    std::chrono::steady_clock::time_point startTime,
+    StreamingStatistics* statistics) {
+    ACSDK_DEBUG9(LX("writeEntryContentIntoStream").d("info", "beginning"));
+
+    bool receivedData = false;
+    auto writeData = [this, &startTime, &receivedData, statistics](const char* data, size_t size) {
+        if (size > 0 && !receivedData) {
+            receivedData = true;
+            statistics->maxEntryGap =
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+            statistics->totalEntryGap = statistics->maxEntryGap;
+        }
+        statistics->numBytes += size;
+        return writeIntoStream(data, size);
+    };
+
+    if (!writeData(entryContent->prefix.data(), entryContent->prefix.size())) {
+        return false;
+    }
+    avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
+        avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+    std::vector<char> buffer(CHUNK_SIZE, 0);
+    while (!m_shuttingDown) {
+        auto bytesRead =
+            entryContent->reader->read(buffer.data(), buffer.size(), &readStatus, TIMEOUT_FOR_BLOCKING_READ);
+        switch (readStatus) {
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED:
+                if (!writeData(buffer.data(), bytesRead)) {
+                    return false;
+                }
+                statistics->numEntries = 1;
+                ACSDK_DEBUG9(LX("writeEntryContentIntoStreamSuccess"));
+                return true;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
+                if (avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT == readStatus &&
+                    receivedData && 0 == bytesRead) {
+                    ++statistics->numUnderruns;
+                }
+                if (!writeData(buffer.data(), bytesRead)) {
+                    return false;
+                }
+                break;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("writeEntryContentIntoStreamFailed").d("reason", "readError"));
+                return false;
+        }
+    }
+    return false;
+}
+
+bool UrlContentToAttachmentConverter::writeIntoStream(const char* data, size_t size) {
+    while (size > 0 && !m_shuttingDown) {
+        auto writeStatus = avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
+        auto bytesWritten = m_streamWriter->write(data, size, &writeStatus, TIMEOUT_FOR_BLOCKING_WRITE);
+        data += bytesWritten;
+        size -= bytesWritten;
+        switch (writeStatus) {
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::TIMEDOUT:
+                // might still have bytes to write
+                continue;
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::CLOSED:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("writeIntoStreamFailed").d("writeStatus", static_cast<int>(writeStatus)));
+                return false;
+        }
+    }
+    return 0 == size;
+}
+
 void UrlContentToAttachmentConverter::doShutdown() {
     m_streamWriter->close();
 
@@ -185,10 +454,15 @@ void UrlContentToAttachmentConverter::doShutdown() {
         m_observer.reset();
     }
     m_shuttingDown = true;
+    stopDownloads();
     m_executor.shutdown();
     m_playlistParser->shutdown();
     m_playlistParser.reset();
     m_streamWriter.reset();
+    {
+        std::lock_guard<std::mutex> lock{m_entriesMutex};
+        m_pendingEntries.clear();
+    }
     if (!m_startedStreaming) {
         m_startStreamingPointPromise.set_value(std::chrono::seconds::zero());
     }
@@ -225,6 +225,15 @@ static const std::vector<std::chrono::milliseconds> TEST_HLS_LIVE_STREAM_DURATIO
 
 static const size_t NUM_PARSES_EXPECTED_WHEN_NO_PARSING = 1;
 
+/// A PLS playlist served with a content-type which does not identify it as a playlist.
+static const std::string TEST_PLS_PLAYLIST_AS_TEXT_URL{"http://sanjayisthecoolest.com/sampleAsText.pls"};
+
+/// An HLS playlist served with a content-type which does not identify it as a playlist.
+static const std::string TEST_HLS_PLAYLIST_AS_BINARY_URL{"http://sanjayisthecoolest.com/sampleAsBinary.m3u8"};
+
+/// The content of the media URLs.
+static const std::string TEST_MEDIA_CONTENT = "ID3 this is the content of a media file, and not a playlist";
+
 static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     // Valid playlist content types
     {TEST_M3U_PLAYLIST_URL, "audio/mpegurl"},
@@ -234,6 +243,8 @@ static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, "audio/mpegurl"},
     {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, "audio/mpegurl"},
     // Not playlist content types
+    {TEST_PLS_PLAYLIST_AS_TEXT_URL, "text/plain"},
+    {TEST_HLS_PLAYLIST_AS_BINARY_URL, "application/octet-stream"},
     {"http://stream.radiotime.com/sample.mp3", "audio/mpeg"},
     {"http://live-mp3-128.kexp.org", "audio/mpeg"},
     {"http://76.74.255.139/bismarck/live/bismarck.mov_9684358.aac", "audio/mpeg"},
@@ -252,7 +263,9 @@ static std::unordered_map<std::string, std::string> urlsToContent{
     {TEST_HLS_PLAYLIST_URL, TEST_HLS_PLAYLIST_CONTENT},
     {TEST_PLS_PLAYLIST_URL, TEST_PLS_CONTENT},
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, TEST_HLS_RECURSIVE_PLAYLIST_CONTENT},
-    {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_1}};
+    {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_1},
+    {TEST_PLS_PLAYLIST_AS_TEXT_URL, TEST_PLS_CONTENT},
+    {TEST_HLS_PLAYLIST_AS_BINARY_URL, TEST_HLS_PLAYLIST_CONTENT}};
 
 /// A mock content fetcher
 class MockContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
@@ -278,10 +291,14 @@ public:
                     avsCommon::utils::HTTPContent{std::move(statusFuture), std::move(contentTypeFuture), nullptr});
             }
         } else if (fetchOption == FetchOptions::ENTIRE_BODY) {
-            auto it2 = urlsToContent.find(m_url);
-            if (it2 == urlsToContent.end()) {
+            // Like an HTTP server, provide the content-type along with the content of any known URL.
+            auto it1 = urlsToContentTypes.find(m_url);
+            if (it1 == urlsToContentTypes.end()) {
                 return nullptr;
-            } else {
+            }
+            std::string content = TEST_MEDIA_CONTENT;
+            auto it2 = urlsToContent.find(m_url);
+            if (it2 != urlsToContent.end()) {
                 static bool liveStreamPlaylistRequested = false;
                 if (m_url == TEST_HLS_LIVE_STREAM_PLAYLIST_URL) {
                     if (!liveStreamPlaylistRequested) {
@@ -291,16 +308,16 @@ public:
                         it2->second = TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_2;
                     }
                 }
-                std::promise<long> statusPromise;
-                auto statusFuture = statusPromise.get_future();
-                statusPromise.set_value(200);
-                std::promise<std::string> contentTypePromise;
-                auto contentTypeFuture = contentTypePromise.get_future();
-                contentTypePromise.set_value("");
-                return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(
-                    avsCommon::utils::HTTPContent{
-                        std::move(statusFuture), std::move(contentTypeFuture), writeStringIntoAttachment(it2->second)});
+                content = it2->second;
             }
+            std::promise<long> statusPromise;
+            auto statusFuture = statusPromise.get_future();
+            statusPromise.set_value(200);
+            std::promise<std::string> contentTypePromise;
+            auto contentTypeFuture = contentTypePromise.get_future();
+            contentTypePromise.set_value(it1->second);
+            return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(avsCommon::utils::HTTPContent{
+                std::move(statusFuture), std::move(contentTypeFuture), writeStringIntoAttachment(content)});
         } else {
             return nullptr;
         }
@@ -327,11 +344,32 @@ private:
     std::string m_url;
 };
 
-/// A mock factory that creates mock content fetchers
+/// A mock factory that creates mock content fetchers, and counts the requests made to each URL.
 class MockContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
+public:
     std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_requestCounts[url];
         return avsCommon::utils::memory::make_unique<MockContentFetcher>(url);
     }
+
+    /**
+     * Gets the number of requests made to a URL.
+     *
+     * @param url The URL.
+     * @return The number of content fetchers created for @c url.
+     */
+    int getRequestCount(const std::string& url) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_requestCounts[url];
+    }
+
+private:
+    /// The number of content fetchers created for each URL.
+    std::unordered_map<std::string, int> m_requestCounts;
+
+    /// A mutex to guard @c m_requestCounts.
+    std::mutex m_mutex;
 };
 
 /**
@@ -384,6 +422,67 @@ private:
     std::condition_variable m_callbackOccurred;
 };
 
+/**
+ * An observer which takes over the downloads of the entries the parser passes to it, and reads them to the end.
+ */
+class EntryContentTakingObserver : public avsCommon::utils::playlistParser::PlaylistParserObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param playlistParser The parser to take the downloads from.
+     */
+    EntryContentTakingObserver(PlaylistParser* playlistParser) : m_playlistParser{playlistParser} {
+    }
+
+    void onPlaylistEntryParsed(
+        int requestId,
+        std::string url,
+        avsCommon::utils::playlistParser::PlaylistParseResult parseResult,
+        std::chrono::milliseconds duration) {
+        std::string content;
+        auto entryContent = m_playlistParser->takeEntryContent(requestId);
+        if (entryContent) {
+            content = entryContent->prefix;
+            std::vector<char> buffer(TEST_MEDIA_CONTENT.size());
+            auto readStatus = avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+            while (readStatus != avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED) {
+                auto bytesRead = entryContent->reader->read(buffer.data(), buffer.size(), &readStatus);
+                content.append(buffer.data(), bytesRead);
+            }
+        }
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_contents.push_back(content);
+        m_callbackOccurred.notify_one();
+    }
+
+    /**
+     * Waits for the PlaylistParserObserverInterface##onPlaylistEntryParsed() call N times.
+     *
+     * @param numCallbacksExpected The number of callbacks expected.
+     * @return The content read from the download of each entry, or an empty string if there was no download.
+     */
+    std::vector<std::string> waitForNCallbacks(size_t numCallbacksExpected) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_callbackOccurred.wait_for(
+            lock, SHORT_TIMEOUT, [this, numCallbacksExpected]() { return m_contents.size() == numCallbacksExpected; });
+        return m_contents;
+    }
+
+private:
+    /// The parser to take the downloads from.
+    PlaylistParser* m_playlistParser;
+
+    /// The content read from the download of each entry.
+    std::vector<std::string> m_contents;
+
+    /// A mutex to guard against new callbacks.
+    std::mutex m_mutex;
+
+    /// A condition variable to wait for callbacks.
+    std::condition_variable m_callbackOccurred;
+};
+
 class PlaylistParserTest : public ::testing::Test {
 protected:
     void SetUp() {
@@ -543,6 +642,80 @@ TEST_F(PlaylistParserTest, testParsingLiveStreamPlaylist) {
     }
 }
 
+/**
+ * Tests that each URL is requested only once while parsing a playlist.
+ * Calls @c parsePlaylist and expects one request for the playlist and one for each of its entries.
+ */
+TEST_F(PlaylistParserTest, testEachUrlRequestedOnce) {
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_M3U_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    EXPECT_EQ(1, mockFactory->getRequestCount(TEST_M3U_PLAYLIST_URL));
+    for (const auto& url : TEST_M3U_PLAYLIST_URLS) {
+        EXPECT_EQ(1, mockFactory->getRequestCount(url));
+    }
+}
+
+/**
+ * Tests that the segments of an HLS media playlist are not requested while parsing it, including those without a
+ * duration.  Calls @c parsePlaylist and expects only the playlist to be requested.
+ */
+TEST_F(PlaylistParserTest, testHlsMediaSegmentsNotRequested) {
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_HLS_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_HLS_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_HLS_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    EXPECT_EQ(1, mockFactory->getRequestCount(TEST_HLS_PLAYLIST_URL));
+    for (const auto& url : TEST_HLS_PLAYLIST_URLS) {
+        EXPECT_EQ(0, mockFactory->getRequestCount(url));
+    }
+}
+
+/**
+ * Tests parsing of playlists served with content-types which do not identify them as playlists.
+ * Calls @c parsePlaylist and expects the playlists to be recognized from their content.
+ */
+TEST_F(PlaylistParserTest, testRecognizingPlaylistsFromContent) {
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_PLS_PLAYLIST_AS_TEXT_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_PLS_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_PLS_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_PLS_PLAYLIST_URLS.at(i));
+    }
+
+    auto hlsObserver = std::make_shared<TestParserObserver>();
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_HLS_PLAYLIST_AS_BINARY_URL, hlsObserver));
+    results = hlsObserver->waitForNCallbacks(TEST_HLS_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_HLS_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_HLS_PLAYLIST_URLS.at(i));
+    }
+}
+
+/**
+ * Tests that an observer can take over the download of an entry.
+ * Calls @c parsePlaylist and expects the complete content of each entry to be read from the downloads handed over.
+ */
+TEST_F(PlaylistParserTest, testTakingEntryContent) {
+    auto observer = std::make_shared<EntryContentTakingObserver>(playlistParser.get());
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_M3U_PLAYLIST_URL, observer));
+    auto contents = observer->waitForNCallbacks(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES, contents.size());
+    for (const auto& content : contents) {
+        EXPECT_EQ(TEST_MEDIA_CONTENT, content);
+    }
+}
+
+/**
+ * Tests that the download of a playlist which is not to be parsed is handed over with its content intact.
+ */
+TEST_F(PlaylistParserTest, testTakingContentOfPlaylistNotParsed) {
+    auto observer = std::make_shared<EntryContentTakingObserver>(playlistParser.get());
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_HLS_PLAYLIST_URL, observer, {PlaylistParser::PlaylistType::M3U8}));
+    auto contents = observer->waitForNCallbacks(NUM_PARSES_EXPECTED_WHEN_NO_PARSING);
+    ASSERT_EQ(NUM_PARSES_EXPECTED_WHEN_NO_PARSING, contents.size());
+    EXPECT_EQ(TEST_HLS_PLAYLIST_CONTENT, contents.at(0));
+}
+
 }  // namespace test
 }  // namespace playlistParser
 }  // namespace alexaClientSDK
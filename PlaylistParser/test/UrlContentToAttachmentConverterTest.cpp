@@ -0,0 +1,643 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+#include "PlaylistParser/UrlContentToAttachmentConverter.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// The url of the test playlist.
+static const std::string TEST_PLAYLIST_URL{"http://localhost/live.m3u8"};
+
+/// The url of a PLS playlist of alternative live streams.
+static const std::string TEST_PLS_PLAYLIST_URL{"http://localhost/live.pls"};
+
+/// The number of entries in the test playlist.
+static const int NUM_ENTRIES = 6;
+
+/// The number of entries in the PLS playlist.
+static const int NUM_PLS_ENTRIES = 3;
+
+/// The number of bytes of each entry of the PLS playlist served before its download is released, which lets the
+/// parser identify the entry.
+static const size_t PLS_SNIFF_SIZE = 16;
+
+/// How long to wait for the downloads to reach an expected state, or for the whole playlist to be streamed.
+static const std::chrono::seconds TIMEOUT{10};
+
+/// The maximum number of entries downloaded ahead in most tests.
+static const size_t MAX_PREFETCHED_ENTRIES = 2;
+
+/**
+ * Gets the url of an entry of the test playlist.
+ *
+ * @param index The index of the entry.
+ * @return The url.
+ */
+static std::string getEntryUrl(int index) {
+    return "http://localhost/segment" + std::to_string(index) + ".aac";
+}
+
+/**
+ * Gets the content of an entry of the test playlist.
+ *
+ * @param index The index of the entry.
+ * @return The content.
+ */
+static std::string getEntryContent(int index) {
+    return "<media of segment " + std::to_string(index) + ">";
+}
+
+/**
+ * Gets the content of the test playlist, an HLS playlist of @c NUM_ENTRIES entries.
+ *
+ * @return The content.
+ */
+static std::string getPlaylistContent() {
+    std::string content = "#EXTM3U\n#EXT-X-TARGETDURATION:10\n";
+    for (int i = 0; i < NUM_ENTRIES; ++i) {
+        content += "#EXTINF:10,\n" + getEntryUrl(i) + "\n";
+    }
+    return content + "#EXT-X-ENDLIST\n";
+}
+
+/**
+ * Gets the content of the PLS playlist, whose @c NUM_PLS_ENTRIES entries have no duration.
+ *
+ * @return The content.
+ */
+static std::string getPlsPlaylistContent() {
+    std::string content = "[playlist]\n";
+    for (int i = 0; i < NUM_PLS_ENTRIES; ++i) {
+        content += "File" + std::to_string(i + 1) + "=" + getEntryUrl(i) + "\n";
+    }
+    return content + "NumberOfEntries=" + std::to_string(NUM_PLS_ENTRIES) + "\n";
+}
+
+/**
+ * Holds back the downloads of playlist entries until the test releases them, and keeps track of them, so that tests
+ * can bring the converter into a given state without depending on timing.
+ */
+class DownloadGate {
+public:
+    /**
+     * Constructor.
+     *
+     * @param numUnreleasedBytes The number of bytes of each entry served before its download is released.
+     */
+    DownloadGate(size_t numUnreleasedBytes) :
+            m_numUnreleasedBytes{numUnreleasedBytes},
+            m_autoRelease{false},
+            m_numStartedDownloads{0},
+            m_numEndedDownloads{0},
+            m_maxActiveDownloads{0} {
+    }
+
+    /**
+     * Gets the number of bytes of each entry served before its download is released.
+     *
+     * @return The number of bytes.
+     */
+    size_t getNumUnreleasedBytes() const {
+        return m_numUnreleasedBytes;
+    }
+
+    /**
+     * Releases the downloads of an entry.
+     *
+     * @param index The index of the entry.
+     */
+    void release(int index) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_releasedEntries.insert(index);
+        m_wakeTrigger.notify_all();
+    }
+
+    /// Releases all downloads, including those started from now on.
+    void releaseAll() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_autoRelease = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits until a download of an entry is released or cancelled.
+     *
+     * @param index The index of the entry.
+     * @param cancelled Whether the download is cancelled, which is guarded by this gate.
+     * @return Whether the download was released.
+     */
+    bool waitForRelease(int index, const bool* cancelled) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_wakeTrigger.wait(lock, [this, index, cancelled] {
+            return *cancelled || m_autoRelease || m_releasedEntries.count(index) > 0;
+        });
+        return !*cancelled;
+    }
+
+    /**
+     * Cancels a download waiting in @c waitForRelease().
+     *
+     * @param[out] cancelled Whether the download is cancelled, which is guarded by this gate.
+     */
+    void cancel(bool* cancelled) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        *cancelled = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    /// Records the start of a download.
+    void downloadStarted() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_numStartedDownloads;
+        m_maxActiveDownloads = std::max(m_maxActiveDownloads, m_numStartedDownloads - m_numEndedDownloads);
+        m_wakeTrigger.notify_all();
+    }
+
+    /// Records the end of a download, whether it completed or was cancelled.
+    void downloadEnded() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_numEndedDownloads;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits until a number of downloads have started.
+     *
+     * @param numDownloads The number of downloads.
+     * @return Whether they started before the timeout.
+     */
+    bool waitForDownloadsStarted(int numDownloads) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_wakeTrigger.wait_for(
+            lock, TIMEOUT, [this, numDownloads] { return m_numStartedDownloads >= numDownloads; });
+    }
+
+    /**
+     * Waits until a number of downloads have ended.
+     *
+     * @param numDownloads The number of downloads.
+     * @return Whether they ended before the timeout.
+     */
+    bool waitForDownloadsEnded(int numDownloads) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_wakeTrigger.wait_for(
+            lock, TIMEOUT, [this, numDownloads] { return m_numEndedDownloads >= numDownloads; });
+    }
+
+    /**
+     * Gets the number of downloads started so far.
+     *
+     * @return The number of downloads.
+     */
+    int getNumStartedDownloads() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_numStartedDownloads;
+    }
+
+    /**
+     * Gets the number of downloads in progress.
+     *
+     * @return The number of downloads.
+     */
+    int getNumActiveDownloads() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_numStartedDownloads - m_numEndedDownloads;
+    }
+
+    /**
+     * Gets the largest number of downloads which were in progress at the same time.
+     *
+     * @return The number of downloads.
+     */
+    int getMaxActiveDownloads() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_maxActiveDownloads;
+    }
+
+private:
+    /// The number of bytes of each entry served before its download is released.
+    const size_t m_numUnreleasedBytes;
+
+    /// Serializes access to the members below, and to the cancellation flags of the downloads.
+    std::mutex m_mutex;
+
+    /// Wakes up the downloads waiting for release, and the test waiting for downloads.
+    std::condition_variable m_wakeTrigger;
+
+    /// The indices of the entries whose downloads are released.
+    std::set<int> m_releasedEntries;
+
+    /// Whether all downloads are released.
+    bool m_autoRelease;
+
+    /// The number of downloads started.
+    int m_numStartedDownloads;
+
+    /// The number of downloads ended.
+    int m_numEndedDownloads;
+
+    /// The largest number of downloads which were in progress at the same time.
+    int m_maxActiveDownloads;
+};
+
+/**
+ * A content fetcher which serves the test playlists right away, and their entries once a @c DownloadGate releases
+ * them, from a thread of its own like a real fetcher.
+ */
+class GatedContentFetcher : public HTTPContentFetcherInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param url The url to fetch.
+     * @param statusCode The status code to answer with.
+     * @param gate The gate which releases the download of a playlist entry.
+     */
+    GatedContentFetcher(const std::string& url, long statusCode, std::shared_ptr<DownloadGate> gate) :
+            m_url{url},
+            m_statusCode{statusCode},
+            m_gate{gate},
+            m_cancelled{false} {
+    }
+
+    ~GatedContentFetcher() {
+        m_gate->cancel(&m_cancelled);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    std::unique_ptr<avsCommon::utils::HTTPContent> getContent(
+        FetchOptions fetchOption,
+        std::shared_ptr<AttachmentWriter> writer) override {
+        if (fetchOption != FetchOptions::ENTIRE_BODY || writer) {
+            return nullptr;
+        }
+        std::promise<long> statusPromise;
+        std::promise<std::string> contentTypePromise;
+        auto stream = std::make_shared<InProcessAttachment>(m_url);
+        std::shared_ptr<AttachmentWriter> streamWriter =
+            stream->createWriter(avsCommon::utils::sds::WriterPolicy::BLOCKING);
+        auto httpContent = avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(
+            avsCommon::utils::HTTPContent{statusPromise.get_future(), contentTypePromise.get_future(), stream});
+        statusPromise.set_value(m_statusCode);
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+
+        if (TEST_PLAYLIST_URL == m_url || TEST_PLS_PLAYLIST_URL == m_url) {
+            bool isPls = TEST_PLS_PLAYLIST_URL == m_url;
+            contentTypePromise.set_value(isPls ? "audio/x-scpls" : "application/vnd.apple.mpegurl");
+            auto content = isPls ? getPlsPlaylistContent() : getPlaylistContent();
+            streamWriter->write(content.data(), content.size(), &writeStatus);
+            streamWriter->close();
+            return httpContent;
+        }
+
+        contentTypePromise.set_value("audio/aac");
+        int index = -1;
+        for (int i = 0; i < NUM_ENTRIES; ++i) {
+            if (getEntryUrl(i) == m_url) {
+                index = i;
+            }
+        }
+        std::string content = index >= 0 ? getEntryContent(index) : "";
+        m_gate->downloadStarted();
+        m_thread = std::thread([this, streamWriter, content, index]() {
+            auto writeStatus = AttachmentWriter::WriteStatus::OK;
+            auto numUnreleasedBytes = std::min(content.size(), m_gate->getNumUnreleasedBytes());
+            streamWriter->write(content.data(), numUnreleasedBytes, &writeStatus);
+            if (m_gate->waitForRelease(index, &m_cancelled)) {
+                streamWriter->write(
+                    content.data() + numUnreleasedBytes, content.size() - numUnreleasedBytes, &writeStatus);
+            }
+            // The download ends before the stream does, since the reader may start the next one on seeing the end.
+            m_gate->downloadEnded();
+            streamWriter->close();
+        });
+        return httpContent;
+    }
+
+private:
+    /// The url to fetch.
+    const std::string m_url;
+
+    /// The status code to answer with.
+    const long m_statusCode;
+
+    /// The gate which releases the download of a playlist entry.
+    std::shared_ptr<DownloadGate> m_gate;
+
+    /// Whether the download was cancelled, which is guarded by @c m_gate.
+    bool m_cancelled;
+
+    /// The download thread.
+    std::thread m_thread;
+};
+
+/// A factory of @c GatedContentFetchers.
+class GatedContentFetcherFactory : public HTTPContentFetcherInterfaceFactoryInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param failingUrl A url to answer with a 404 status code.
+     * @param numUnreleasedBytes The number of bytes of each entry served before its download is released.
+     */
+    GatedContentFetcherFactory(const std::string& failingUrl = "", size_t numUnreleasedBytes = 0) :
+            m_failingUrl{failingUrl},
+            m_gate{std::make_shared<DownloadGate>(numUnreleasedBytes)} {
+    }
+
+    std::unique_ptr<HTTPContentFetcherInterface> create(const std::string& url) override {
+        return avsCommon::utils::memory::make_unique<GatedContentFetcher>(
+            url, url == m_failingUrl ? 404 : 200, m_gate);
+    }
+
+    /**
+     * Gets the gate which releases the downloads of playlist entries.
+     *
+     * @return The gate.
+     */
+    std::shared_ptr<DownloadGate> getGate() {
+        return m_gate;
+    }
+
+private:
+    /// A url to answer with a 404 status code.
+    const std::string m_failingUrl;
+
+    /// The gate which releases the downloads of playlist entries.
+    std::shared_ptr<DownloadGate> m_gate;
+};
+
+/// An observer which records whether an error was reported.
+class TestErrorObserver : public UrlContentToAttachmentConverter::ErrorObserverInterface {
+public:
+    TestErrorObserver() : m_hasError{false} {
+    }
+
+    void onError() override {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_hasError = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits for an error to be reported.
+     *
+     * @param timeout How long to wait.
+     * @return Whether an error was reported.
+     */
+    bool waitForError(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_wakeTrigger.wait_for(lock, timeout, [this] { return m_hasError; });
+    }
+
+private:
+    /// Serializes access to @c m_hasError.
+    std::mutex m_mutex;
+
+    /// Wakes up waiters for an error.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether an error was reported.
+    bool m_hasError;
+};
+
+class UrlContentToAttachmentConverterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_observer = std::make_shared<TestErrorObserver>();
+        m_errorReported = false;
+    }
+
+    /**
+     * Starts streaming a playlist.
+     *
+     * @param factory The factory of the content fetchers.
+     * @param maxPrefetchedEntries The maximum number of entries downloaded ahead.
+     * @param prefetchBufferSizeInBytes The memory budget for the entries downloaded ahead.
+     * @param url The url of the playlist.
+     * @return The converter streaming the playlist.
+     */
+    std::shared_ptr<UrlContentToAttachmentConverter> startStreaming(
+        std::shared_ptr<GatedContentFetcherFactory> factory,
+        size_t maxPrefetchedEntries,
+        size_t prefetchBufferSizeInBytes = UrlContentToAttachmentConverter::DEFAULT_PREFETCH_BUFFER_SIZE_IN_BYTES,
+        const std::string& url = TEST_PLAYLIST_URL) {
+        return UrlContentToAttachmentConverter::create(
+            factory,
+            url,
+            m_observer,
+            std::chrono::milliseconds::zero(),
+            maxPrefetchedEntries,
+            prefetchBufferSizeInBytes);
+    }
+
+    /**
+     * Reads the whole stream of a converter, and shuts the converter down.
+     *
+     * @param converter The converter.
+     * @param[out] statistics The statistics of the streaming.
+     * @param expectError Whether the streaming is expected to fail, and so worth waiting for an error report.
+     * @return The content of the stream.
+     */
+    std::string readStream(
+        std::shared_ptr<UrlContentToAttachmentConverter> converter,
+        UrlContentToAttachmentConverter::StreamingStatistics* statistics,
+        bool expectError = false) {
+        if (!converter) {
+            return "";
+        }
+        auto reader = converter->getAttachment()->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
+        std::string content;
+        std::vector<char> buffer(64);
+        auto readStatus = AttachmentReader::ReadStatus::OK;
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (readStatus != AttachmentReader::ReadStatus::CLOSED && std::chrono::steady_clock::now() < deadline) {
+            auto bytesRead = reader->read(buffer.data(), buffer.size(), &readStatus, std::chrono::milliseconds(100));
+            content.append(buffer.data(), bytesRead);
+        }
+        *statistics = converter->getStreamingStatistics();
+        // The error is reported after the stream closes, and no longer once the converter has shut down.
+        m_errorReported = m_observer->waitForError(expectError ? TIMEOUT : std::chrono::milliseconds::zero());
+        converter->shutdown();
+        return content;
+    }
+
+    /**
+     * Gets the content of the whole test playlist.
+     *
+     * @return The content of all of the entries, in order.
+     */
+    std::string getExpectedContent() {
+        std::string content;
+        for (int i = 0; i < NUM_ENTRIES; ++i) {
+            content += getEntryContent(i);
+        }
+        return content;
+    }
+
+    /// The observer of errors.
+    std::shared_ptr<TestErrorObserver> m_observer;
+
+    /// Whether an error was reported by the last streaming.
+    bool m_errorReported;
+};
+
+/**
+ * Test that entries downloaded ahead are written in playlist order, even when later entries finish downloading first.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testEntriesWrittenInOrder) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>();
+    auto gate = factory->getGate();
+    auto converter = startStreaming(factory, UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCHED_ENTRIES);
+    ASSERT_TRUE(converter);
+    auto numDownloads = static_cast<int>(UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCHED_ENTRIES) + 1;
+    ASSERT_TRUE(gate->waitForDownloadsStarted(numDownloads));
+    for (int i = numDownloads - 1; i >= 0; --i) {
+        gate->release(i);
+    }
+    gate->releaseAll();
+
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    EXPECT_EQ(getExpectedContent(), readStream(converter, &statistics));
+    EXPECT_EQ(static_cast<size_t>(NUM_ENTRIES), statistics.numEntries);
+    EXPECT_EQ(getExpectedContent().size(), statistics.numBytes);
+    // The entries after the gated ones are only downloaded ahead if the parser has queued them in time.
+    EXPECT_GE(statistics.numPrefetchedEntries, UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCHED_ENTRIES);
+    EXPECT_LE(statistics.numPrefetchedEntries, static_cast<size_t>(NUM_ENTRIES - 1));
+    EXPECT_FALSE(m_errorReported);
+}
+
+/**
+ * Test that no more than the configured number of entries is downloaded ahead of the entry being written, and that
+ * the next one starts once the entry being written is done.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testPrefetchIsBounded) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>();
+    auto gate = factory->getGate();
+    auto converter = startStreaming(factory, MAX_PREFETCHED_ENTRIES);
+    ASSERT_TRUE(converter);
+    auto numDownloads = static_cast<int>(MAX_PREFETCHED_ENTRIES) + 1;
+    ASSERT_TRUE(gate->waitForDownloadsStarted(numDownloads));
+    EXPECT_EQ(numDownloads, gate->getNumStartedDownloads());
+
+    gate->release(0);
+    ASSERT_TRUE(gate->waitForDownloadsStarted(numDownloads + 1));
+    EXPECT_EQ(numDownloads, gate->getNumActiveDownloads());
+    gate->releaseAll();
+
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    EXPECT_EQ(getExpectedContent(), readStream(converter, &statistics));
+    EXPECT_EQ(numDownloads, gate->getMaxActiveDownloads());
+    // The entries after the gated ones are only downloaded ahead if the parser has queued them in time.
+    EXPECT_GE(statistics.numPrefetchedEntries, static_cast<size_t>(numDownloads));
+    EXPECT_LE(statistics.numPrefetchedEntries, static_cast<size_t>(NUM_ENTRIES - 1));
+}
+
+/**
+ * Test that each entry is downloaded only when its turn comes if no entries are to be downloaded ahead.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testNoPrefetch) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>();
+    factory->getGate()->releaseAll();
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    EXPECT_EQ(getExpectedContent(), readStream(startStreaming(factory, 0), &statistics));
+    EXPECT_EQ(1, factory->getGate()->getMaxActiveDownloads());
+    EXPECT_EQ(0u, statistics.numPrefetchedEntries);
+}
+
+/**
+ * Test that once the size of the entries is known, no entries are downloaded ahead if their bytes do not fit in the
+ * memory budget.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testMemoryBudgetLimitsPrefetch) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>();
+    auto gate = factory->getGate();
+    auto converter = startStreaming(factory, MAX_PREFETCHED_ENTRIES, 1);
+    ASSERT_TRUE(converter);
+    // Until an entry has been written there is no size to judge the entries by.
+    ASSERT_TRUE(gate->waitForDownloadsStarted(static_cast<int>(MAX_PREFETCHED_ENTRIES) + 1));
+    gate->releaseAll();
+
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    EXPECT_EQ(getExpectedContent(), readStream(converter, &statistics));
+    EXPECT_EQ(MAX_PREFETCHED_ENTRIES, statistics.numPrefetchedEntries);
+}
+
+/**
+ * Test that the entries of a playlist without durations, which may be endless live streams, are not downloaded ahead.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testEntriesWithoutDurationNotPrefetched) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>("", PLS_SNIFF_SIZE);
+    auto gate = factory->getGate();
+    auto converter = startStreaming(
+        factory,
+        UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCHED_ENTRIES,
+        UrlContentToAttachmentConverter::DEFAULT_PREFETCH_BUFFER_SIZE_IN_BYTES,
+        TEST_PLS_PLAYLIST_URL);
+    ASSERT_TRUE(converter);
+    // The parser downloads each entry to identify it, and drops the downloads of all but the first, which is written.
+    ASSERT_TRUE(gate->waitForDownloadsEnded(NUM_PLS_ENTRIES - 1));
+    EXPECT_EQ(NUM_PLS_ENTRIES, gate->getNumStartedDownloads());
+    gate->releaseAll();
+
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    std::string expectedContent;
+    for (int i = 0; i < NUM_PLS_ENTRIES; ++i) {
+        expectedContent += getEntryContent(i);
+    }
+    EXPECT_EQ(expectedContent, readStream(converter, &statistics));
+    EXPECT_EQ(static_cast<size_t>(NUM_PLS_ENTRIES), statistics.numEntries);
+    EXPECT_EQ(0u, statistics.numPrefetchedEntries);
+}
+
+/**
+ * Test that an entry which fails to download is reported as an error and ends the stream.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testFailedEntry) {
+    auto factory = std::make_shared<GatedContentFetcherFactory>(getEntryUrl(2));
+    factory->getGate()->releaseAll();
+    UrlContentToAttachmentConverter::StreamingStatistics statistics;
+    EXPECT_EQ(
+        getEntryContent(0) + getEntryContent(1),
+        readStream(startStreaming(factory, MAX_PREFETCHED_ENTRIES), &statistics, true));
+    EXPECT_EQ(2u, statistics.numEntries);
+    EXPECT_TRUE(m_errorReported);
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
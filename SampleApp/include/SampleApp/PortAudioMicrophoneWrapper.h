@@ -34,9 +34,14 @@ public:
      * Creates a @c PortAudioMicrophoneWrapper.
      *
      * @param stream The shared data stream to write to.
+     * @param numChannels The number of microphone channels to capture.  Each word of @c stream holds one 16-bit
+     *     sample of every channel.
      * @return A unique_ptr to a @c PortAudioMicrophoneWrapper if creation was successful and @c nullptr otherwise.
      */
-    static std::unique_ptr<PortAudioMicrophoneWrapper> create(std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer, std::shared_ptr<avsCommon::avs::AudioInputStream> stream);
+    static std::unique_ptr<PortAudioMicrophoneWrapper> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        int numChannels = 1);
 
     /**
      * Stops streaming from the microphone.
@@ -69,8 +74,12 @@ private:
      * Constructor.
      *
      * @param stream The shared data stream to write to.
+     * @param numChannels The number of microphone channels to capture.
      */
-    PortAudioMicrophoneWrapper(std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer, std::shared_ptr<avsCommon::avs::AudioInputStream> stream);
+    PortAudioMicrophoneWrapper(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        int numChannels);
 
     /**
      * The callback that PortAudio will issue when audio is avaiable to read.
@@ -112,6 +121,9 @@ private:
     /// The stream of audio data.
     const std::shared_ptr<avsCommon::avs::AudioInputStream> m_audioInputStream;
 
+    /// The number of microphone channels captured.
+    const int m_numChannels;
+
     /// The writer that will be used to writer audio data into the sds.
     std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
 
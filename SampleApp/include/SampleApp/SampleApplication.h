@@ -23,6 +23,7 @@
 #include "UserInputManager.h"
 
 #ifdef KWD
+#include <AudioFrontend/AudioFrontend.h>
 #include <KWD/AbstractKeywordDetector.h>
 #endif
 #include <ExternalMediaPlayer/ExternalMediaPlayer.h>
@@ -164,6 +165,9 @@ private:
     /// The Wakeword Detector which can wake up the client using audio input.
     std::unique_ptr<kwd::AbstractKeywordDetector> m_keywordDetector;
 #endif
+
+    /// The front end which beamforms a microphone array into the audio the SDK reads, if the device has an array.
+    std::unique_ptr<audioFrontend::AudioFrontend> m_audioFrontend;
 };
 
 }  // namespace sampleApp
@@ -27,7 +27,6 @@ namespace sampleApp {
 
 using avsCommon::avs::AudioInputStream;
 
-static const int NUM_INPUT_CHANNELS = 1;
 static const int NUM_OUTPUT_CHANNELS = 0;
 static const double SAMPLE_RATE = 16000;
 static const char* DEVICE_NAME = "s1000";
@@ -52,12 +51,18 @@ static const std::string PORTAUDIO_CONFIG_SUGGESTED_LATENCY_KEY("suggestedLatenc
 
 std::unique_ptr<PortAudioMicrophoneWrapper> PortAudioMicrophoneWrapper::create(
     std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer,
-    std::shared_ptr<AudioInputStream> stream) {
+    std::shared_ptr<AudioInputStream> stream,
+    int numChannels) {
     if (!stream) {
         ConsolePrinter::simplePrint("Invalid stream passed to PortAudioMicrophoneWrapper");
         return nullptr;
     }
-    std::unique_ptr<PortAudioMicrophoneWrapper> portAudioMicrophoneWrapper(new PortAudioMicrophoneWrapper(buffer, stream));
+    if (numChannels < 1 || stream->getWordSize() != numChannels * sizeof(int16_t)) {
+        ConsolePrinter::simplePrint("Stream word size does not match the number of channels");
+        return nullptr;
+    }
+    std::unique_ptr<PortAudioMicrophoneWrapper> portAudioMicrophoneWrapper(
+        new PortAudioMicrophoneWrapper(buffer, stream, numChannels));
     if (!portAudioMicrophoneWrapper->initialize()) {
         ConsolePrinter::simplePrint("Failed to initialize PortAudioMicrophoneWrapper");
         return nullptr;
@@ -65,8 +70,12 @@ std::unique_ptr<PortAudioMicrophoneWrapper> PortAudioMicrophoneWrapper::create(
     return portAudioMicrophoneWrapper;
 }
 
-PortAudioMicrophoneWrapper::PortAudioMicrophoneWrapper(std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer, std::shared_ptr<AudioInputStream> stream) :
+PortAudioMicrophoneWrapper::PortAudioMicrophoneWrapper(
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Buffer> buffer,
+    std::shared_ptr<AudioInputStream> stream,
+    int numChannels) :
         m_audioInputStream{stream},
+        m_numChannels{numChannels},
         m_paStream{nullptr},
         m_buffer(buffer) {
 }
@@ -139,7 +148,7 @@ bool PortAudioMicrophoneWrapper::openStream() {
     unsigned long framesPerBuffer = paFramesPerBufferUnspecified;
     PaStreamParameters inputParameters;
     bzero( &inputParameters, sizeof( inputParameters ) );
-    inputParameters.channelCount = NUM_INPUT_CHANNELS;
+    inputParameters.channelCount = m_numChannels;
     inputParameters.device = devId;
     inputParameters.hostApiSpecificStreamInfo = NULL;
     inputParameters.sampleFormat = paInt16;
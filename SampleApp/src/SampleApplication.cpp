@@ -33,10 +33,17 @@
 
 #ifdef ENABLE_ESP
 #include <ESP/ESPDataProvider.h>
+#include <ESP/ESPVoiceActivityDetector.h>
 #else
 #include <ESP/DummyESPDataProvider.h>
 #endif
 
+#ifdef ENABLE_OPUS
+#include <AIP/OpusAudioEncoder.h>
+#endif
+
+#include <AIP/EnergyVoiceActivityDetector.h>
+
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
 #include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
@@ -74,6 +81,9 @@ static const std::chrono::seconds AMOUNT_OF_AUDIO_DATA_IN_BUFFER = std::chrono::
 /// The size of the ring buffer.
 static const size_t BUFFER_SIZE_IN_SAMPLES = (SAMPLE_RATE_HZ)*AMOUNT_OF_AUDIO_DATA_IN_BUFFER.count();
 
+/// The number of writes to the stream to remember the times of, which covers the buffer at a write every 10ms.
+static const size_t TIME_INDEX_CAPACITY = AMOUNT_OF_AUDIO_DATA_IN_BUFFER.count() * 100;
+
 /// Key for the root node value containing configuration values for SampleApp.
 static const std::string SAMPLE_APP_CONFIG_KEY("sampleApp");
 
@@ -86,6 +96,51 @@ static const std::string ENDPOINT_KEY("endpoint");
 /// Key for setting if display cards are supported or not under the @c SAMPLE_APP_CONFIG_KEY configuration node.
 static const std::string DISPLAY_CARD_KEY("displayCardsSupported");
 
+/// Key for the cache of media fetched over HTTP under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string HTTP_CONTENT_CACHE_KEY("httpContentCache");
+
+/// Key for the directory of the cache under the @c HTTP_CONTENT_CACHE_KEY configuration node.
+static const std::string HTTP_CONTENT_CACHE_DIRECTORY_KEY("directory");
+
+/// Key for the size budget of the cache under the @c HTTP_CONTENT_CACHE_KEY configuration node.
+static const std::string HTTP_CONTENT_CACHE_MAX_SIZE_KEY("maxSizeInBytes");
+
+/// The size budget of the cache of media fetched over HTTP, if the configuration does not specify one.
+static const int DEFAULT_HTTP_CONTENT_CACHE_MAX_SIZE_IN_BYTES = 16 * 1024 * 1024;
+
+/// Key for the local end of speech detection under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string END_OF_SPEECH_DETECTION_KEY("endOfSpeechDetection");
+
+/// Key for whether to end Recognize uploads locally under the @c END_OF_SPEECH_DETECTION_KEY configuration node.
+static const std::string END_OF_SPEECH_DETECTION_ENABLED_KEY("enabled");
+
+/// Key for the silence which ends speech under the @c END_OF_SPEECH_DETECTION_KEY configuration node.
+static const std::string HANGOVER_KEY("hangoverInMilliseconds");
+
+/// Key for how long to wait for speech to begin under the @c END_OF_SPEECH_DETECTION_KEY configuration node.
+static const std::string NO_SPEECH_TIMEOUT_KEY("noSpeechTimeoutInMilliseconds");
+
+/// Key for the ESP settings under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string ESP_KEY("esp");
+
+/// Key for whether to compute ESP only over the audio of each wake word under the @c ESP_KEY configuration node.
+static const std::string ESP_COMPUTE_ON_DEMAND_KEY("computeOnDemand");
+
+/// Key for the microphone array front end under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string AUDIO_FRONTEND_KEY("audioFrontend");
+
+/// Key for the number of microphones of the linear array under the @c AUDIO_FRONTEND_KEY configuration node.
+static const std::string NUM_MICROPHONES_KEY("numMicrophones");
+
+/// Key for the distance between neighbouring microphones under the @c AUDIO_FRONTEND_KEY configuration node.
+static const std::string MICROPHONE_SPACING_KEY("microphoneSpacingInMillimeters");
+
+/// Key for the direction the array listens in under the @c AUDIO_FRONTEND_KEY configuration node.
+static const std::string STEERING_ANGLE_KEY("steeringAngleInDegrees");
+
+/// The maximum number of readers of the microphone array stream, which only the audio front end reads.
+static const size_t MICROPHONE_ARRAY_MAX_READERS = 1;
+
 /// Timeout for reset timer - timeout is currently 3 mintues
 static const std::chrono::milliseconds RESET_TIMEOUT = std::chrono::milliseconds(3 * 60 * 1000);
 
@@ -306,7 +361,26 @@ bool SampleApplication::initialize(
     auto config = alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode::getRoot();
     auto sampleAppConfig = config[SAMPLE_APP_CONFIG_KEY];
 
-    auto httpContentFetcherFactory = std::make_shared<avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory>();
+    /*
+     * Alert and notification sounds and other short media are fetched again and again, so keep them in a cache on disk
+     * if the configuration says where.
+     */
+    std::shared_ptr<avsCommon::utils::libcurlUtils::HTTPContentCache> httpContentCache;
+    std::string httpContentCacheDirectory;
+    if (sampleAppConfig[HTTP_CONTENT_CACHE_KEY].getString(
+            HTTP_CONTENT_CACHE_DIRECTORY_KEY, &httpContentCacheDirectory)) {
+        int maxSizeInBytes = DEFAULT_HTTP_CONTENT_CACHE_MAX_SIZE_IN_BYTES;
+        sampleAppConfig[HTTP_CONTENT_CACHE_KEY].getInt(
+            HTTP_CONTENT_CACHE_MAX_SIZE_KEY, &maxSizeInBytes, DEFAULT_HTTP_CONTENT_CACHE_MAX_SIZE_IN_BYTES);
+        httpContentCache =
+            avsCommon::utils::libcurlUtils::HTTPContentCache::create(httpContentCacheDirectory, maxSizeInBytes);
+        if (!httpContentCache) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the HTTP content cache!");
+        }
+    }
+
+    auto httpContentFetcherFactory =
+        std::make_shared<avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory>(httpContentCache);
 
     m_speakMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
         httpContentFetcherFactory, avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED, "SpeakMediaPlayer");
@@ -422,6 +496,51 @@ bool SampleApplication::initialize(
     bool displayCardsSupported;
     config[SAMPLE_APP_CONFIG_KEY].getBool(DISPLAY_CARD_KEY, &displayCardsSupported, true);
 
+    std::shared_ptr<alexaClientSDK::capabilityAgents::aip::AudioEncoder> audioEncoder;
+#ifdef ENABLE_OPUS
+    /*
+     * Creating the audio encoder - Recognize audio is uploaded as Opus rather than LPCM, which cuts the upload to an
+     * eighth of its size.
+     */
+    audioEncoder = alexaClientSDK::capabilityAgents::aip::AudioEncoder::create(
+        alexaClientSDK::capabilityAgents::aip::OpusAudioEncoder::create());
+    if (!audioEncoder) {
+        alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the Opus audio encoder!");
+        return false;
+    }
+#endif
+
+    std::shared_ptr<alexaClientSDK::capabilityAgents::aip::EndOfSpeechDetector> endOfSpeechDetector;
+    auto endOfSpeechConfig = sampleAppConfig[END_OF_SPEECH_DETECTION_KEY];
+    bool endOfSpeechDetectionEnabled = false;
+    endOfSpeechConfig.getBool(END_OF_SPEECH_DETECTION_ENABLED_KEY, &endOfSpeechDetectionEnabled, false);
+    if (endOfSpeechDetectionEnabled) {
+        /*
+         * Creating the end of speech detector - Recognize uploads end as soon as the user stops speaking, rather than
+         * when the StopCapture directive arrives from AVS.
+         */
+        alexaClientSDK::capabilityAgents::aip::EndOfSpeechDetector::Config endOfSpeechDetectorConfig;
+        int hangover = static_cast<int>(endOfSpeechDetectorConfig.hangover.count());
+        endOfSpeechConfig.getInt(HANGOVER_KEY, &hangover, hangover);
+        endOfSpeechDetectorConfig.hangover = std::chrono::milliseconds(hangover);
+        int noSpeechTimeout = static_cast<int>(endOfSpeechDetectorConfig.noSpeechTimeout.count());
+        endOfSpeechConfig.getInt(NO_SPEECH_TIMEOUT_KEY, &noSpeechTimeout, noSpeechTimeout);
+        endOfSpeechDetectorConfig.noSpeechTimeout = std::chrono::milliseconds(noSpeechTimeout);
+#ifdef ENABLE_ESP
+        std::shared_ptr<alexaClientSDK::capabilityAgents::aip::VoiceActivityDetectorInterface> voiceActivityDetector =
+            alexaClientSDK::esp::ESPVoiceActivityDetector::create();
+#else
+        std::shared_ptr<alexaClientSDK::capabilityAgents::aip::VoiceActivityDetectorInterface> voiceActivityDetector =
+            alexaClientSDK::capabilityAgents::aip::EnergyVoiceActivityDetector::create();
+#endif
+        endOfSpeechDetector = alexaClientSDK::capabilityAgents::aip::EndOfSpeechDetector::create(
+            voiceActivityDetector, endOfSpeechDetectorConfig);
+        if (!endOfSpeechDetector) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the end of speech detector!");
+            return false;
+        }
+    }
+
     /*
      * Creating the DefaultClient - this component serves as an out-of-box default object that instantiates and "glues"
      * together all the modules.
@@ -450,7 +569,9 @@ bool SampleApplication::initialize(
             displayCardsSupported,
             firmwareVersion,
             true,
-            nullptr);
+            nullptr,
+            audioEncoder,
+            endOfSpeechDetector);
 
     if (!client) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create default SDK client!");
@@ -510,6 +631,15 @@ bool SampleApplication::initialize(
         return false;
     }
 
+    /*
+     * Timestamping the writes to the stream, so that keyword detections and taps can be mapped to the exact audio
+     * captured when they happened.
+     */
+    if (!sharedDataStream->enableTimeIndex(TIME_INDEX_CAPACITY)) {
+        alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to enable the stream's time index!");
+        return false;
+    }
+
     alexaClientSDK::avsCommon::utils::AudioFormat compatibleAudioFormat;
     compatibleAudioFormat.sampleRateHz = SAMPLE_RATE_HZ;
     compatibleAudioFormat.sampleSizeInBits = WORD_SIZE * CHAR_BIT;
@@ -549,8 +679,48 @@ bool SampleApplication::initialize(
         holdCanOverride,
         holdCanBeOverridden);
 
+    /*
+     * Creating the audio front end, if the device has a microphone array. The microphones are captured into a stream of
+     * their own, and the front end beamforms them into the mono stream the rest of the SDK reads.
+     */
+    auto micBuffer = buffer;
+    auto micStream = sharedDataStream;
+    int numMicrophones = 1;
+    auto audioFrontendConfig = config[SAMPLE_APP_CONFIG_KEY][AUDIO_FRONTEND_KEY];
+    audioFrontendConfig.getInt(NUM_MICROPHONES_KEY, &numMicrophones, 1);
+    if (numMicrophones > 1) {
+        int spacingInMillimeters = 0;
+        int steeringAngleInDegrees = 0;
+        audioFrontendConfig.getInt(MICROPHONE_SPACING_KEY, &spacingInMillimeters, 0);
+        audioFrontendConfig.getInt(STEERING_ANGLE_KEY, &steeringAngleInDegrees, 0);
+
+        size_t micWordSize = WORD_SIZE * numMicrophones;
+        micBuffer = std::make_shared<alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer>(
+            alexaClientSDK::avsCommon::avs::AudioInputStream::calculateBufferSize(
+                BUFFER_SIZE_IN_SAMPLES, micWordSize, MICROPHONE_ARRAY_MAX_READERS));
+        micStream = alexaClientSDK::avsCommon::avs::AudioInputStream::create(
+            micBuffer, micWordSize, MICROPHONE_ARRAY_MAX_READERS);
+        if (!micStream) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create microphone array stream!");
+            return false;
+        }
+
+        auto micFormat = compatibleAudioFormat;
+        micFormat.numChannels = numMicrophones;
+        micFormat.layout = alexaClientSDK::avsCommon::utils::AudioFormat::Layout::INTERLEAVED;
+        alexaClientSDK::audioFrontend::FrontendProcessor::Config frontendConfig;
+        frontendConfig.delaysInSamples = alexaClientSDK::audioFrontend::DelayAndSumBeamformer::computeLinearArrayDelays(
+            numMicrophones, spacingInMillimeters, steeringAngleInDegrees, SAMPLE_RATE_HZ);
+        m_audioFrontend = alexaClientSDK::audioFrontend::AudioFrontend::create(
+            micStream, micFormat, sharedDataStream, frontendConfig);
+        if (!m_audioFrontend) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the audio front end!");
+            return false;
+        }
+    }
+
     std::shared_ptr<alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper> micWrapper =
-        alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper::create(buffer, sharedDataStream);
+        alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper::create(micBuffer, micStream, numMicrophones);
     if (!micWrapper) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create PortAudioMicrophoneWrapper!");
         return false;
@@ -575,7 +745,11 @@ bool SampleApplication::initialize(
 
 #ifdef ENABLE_ESP
     // Creating ESP connector
-    std::shared_ptr<esp::ESPDataProviderInterface> espProvider = esp::ESPDataProvider::create(wakeWordAudioProvider);
+    bool computeEspOnDemand = false;
+    config[SAMPLE_APP_CONFIG_KEY][ESP_KEY].getBool(ESP_COMPUTE_ON_DEMAND_KEY, &computeEspOnDemand, false);
+    std::shared_ptr<esp::ESPDataProviderInterface> espProvider = esp::ESPDataProvider::create(
+        wakeWordAudioProvider,
+        computeEspOnDemand ? esp::ESPDataProvider::Mode::ON_DEMAND : esp::ESPDataProvider::Mode::CONTINUOUS);
     std::shared_ptr<esp::ESPDataModifierInterface> espModifier = nullptr;
 #else
     // Create dummy ESP connector
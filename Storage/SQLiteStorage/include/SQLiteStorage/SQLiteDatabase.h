@@ -32,6 +32,11 @@ namespace sqliteStorage {
  * A basic class for performing basic SQLite database operations.  This the boilerplate code used to manage the
  * SQLiteDatabase.  This database is not thread-safe, and must be protected before being used in a mutlithreaded
  * fashion.
+ *
+ * All @c SQLiteDatabase instances in a process which refer to the same database file share a single underlying
+ * SQLite connection (and therefore a single page cache and set of journal files).  This allows several storage
+ * components to be configured with the same @c databaseFilePath, each using its own tables.  The shared connection
+ * is closed when the last instance referring to it is closed.
  */
 class SQLiteDatabase {
 public:
@@ -54,6 +59,10 @@ public:
     /**
      * The internal SQLite DB is created.
      *
+     * If the last call to @c open() failed because there was no DB at the path specified, and a DB has been created
+     * there since, by another instance sharing the file, that DB is opened instead.  Stores sharing a file may then
+     * each call @c open() and, if it fails, @c initialize() concurrently.
+     *
      * @return true, if the (empty) DB is created successfully.  If there is already a DB at the path specified, this
      * function fails and returns false.  It also returns false if the database is already opened or if there is an
      * internal failure in creating the DB.
@@ -107,11 +116,33 @@ public:
     std::unique_ptr<SQLiteStatement> createStatement(const std::string& sqlString);
 
 private:
+    /**
+     * Registers @c m_dbHandle, a new connection, as the connection to share with other instances referring to the
+     * same file.  The caller must hold the lock of the shared connections.
+     *
+     * @param connectionKey The key to share the connection under, or an empty string to leave it unshared.
+     */
+    void shareConnectionLocked(const std::string& connectionKey);
+
+    /**
+     * Opens the existing DB, sharing the connection of another instance if there is one.  The caller must hold the
+     * lock of the shared connections.
+     *
+     * @return true, if the DB is opened successfully.
+     */
+    bool openLocked();
+
     /// The path to use when creating/opening the internal SQLite DB.
     const std::string m_storageFilePath;
 
     /// The sqlite database handle.
     sqlite3* m_dbHandle;
+
+    /// The key under which @c m_dbHandle is shared with other instances, or empty if the handle is not shared.
+    std::string m_connectionKey;
+
+    /// Whether the last call to @c open() found no file, which @c initialize() then allows to have been created since.
+    bool m_fileMissingOnOpen;
 };
 
 }  // namespace sqliteStorage
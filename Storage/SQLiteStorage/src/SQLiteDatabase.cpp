@@ -15,6 +15,11 @@
 
 #include "SQLiteStorage/SQLiteDatabase.h"
 
+#include <climits>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
 #include <AVSCommon/Utils/File/FileUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
@@ -34,9 +39,40 @@ static const std::string TAG("SQLiteDatabase");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// A SQLite connection which is shared between all the @c SQLiteDatabase instances referring to the same file.
+struct SharedConnection {
+    /// The sqlite database handle.
+    sqlite3* dbHandle;
+
+    /// The number of @c SQLiteDatabase instances currently using @c dbHandle.
+    unsigned int refCount;
+};
+
+/// Mutex serializing access to the table of shared connections.
+static std::mutex g_sharedConnectionsMutex;
+
+/// The table of shared connections, keyed by the canonical path of the database file.
+static std::unordered_map<std::string, SharedConnection> g_sharedConnections;
+
+/**
+ * Get the key under which the connection to a database file is shared.  Different paths referring to the same
+ * existing file map to the same key.
+ *
+ * @param filePath The path of the database file.
+ * @return The canonical path of the file if it exists, otherwise an empty string.
+ */
+static std::string getConnectionKey(const std::string& filePath) {
+    char resolvedPath[PATH_MAX];
+    if (!realpath(filePath.c_str(), resolvedPath)) {
+        return "";
+    }
+    return resolvedPath;
+}
+
 SQLiteDatabase::SQLiteDatabase(const std::string& storageFilePath) :
         m_storageFilePath{storageFilePath},
-        m_dbHandle{nullptr} {
+        m_dbHandle{nullptr},
+        m_fileMissingOnOpen{false} {
 }
 
 SQLiteDatabase::~SQLiteDatabase() {
@@ -57,7 +93,17 @@ bool SQLiteDatabase::initialize() {
         return false;
     }
 
+    // The file is created and its connection registered under one lock, so that open() either finds no file or the
+    // registered connection.
+    std::lock_guard<std::mutex> lock(g_sharedConnectionsMutex);
+    bool fileMissingOnOpen = m_fileMissingOnOpen;
+    m_fileMissingOnOpen = false;
     if (avsCommon::utils::file::fileExists(m_storageFilePath)) {
+        if (fileMissingOnOpen) {
+            // Another instance sharing the file created it since open() found none, so join its connection.
+            ACSDK_INFO(LX(__func__).m("File created since open, opening it.").d("file path", m_storageFilePath));
+            return openLocked();
+        }
         ACSDK_ERROR(LX(__func__).m("File specified already exists.").d("file path", m_storageFilePath));
         return false;
     }
@@ -68,6 +114,7 @@ bool SQLiteDatabase::initialize() {
         return false;
     }
 
+    shareConnectionLocked(getConnectionKey(m_storageFilePath));
     return true;
 }
 
@@ -77,20 +124,50 @@ bool SQLiteDatabase::open() {
         return false;
     }
 
-    if (!avsCommon::utils::file::fileExists(m_storageFilePath)) {
+    std::lock_guard<std::mutex> lock(g_sharedConnectionsMutex);
+    m_fileMissingOnOpen = !avsCommon::utils::file::fileExists(m_storageFilePath);
+    if (m_fileMissingOnOpen) {
         ACSDK_ERROR(LX(__func__).m("File specified does not exist.").d("file path", m_storageFilePath));
         return false;
     }
 
+    return openLocked();
+}
+
+bool SQLiteDatabase::openLocked() {
+    auto connectionKey = getConnectionKey(m_storageFilePath);
+    if (!connectionKey.empty()) {
+        auto it = g_sharedConnections.find(connectionKey);
+        if (it != g_sharedConnections.end()) {
+            ++it->second.refCount;
+            m_dbHandle = it->second.dbHandle;
+            m_connectionKey = connectionKey;
+            return true;
+        }
+    }
+
     m_dbHandle = openSQLiteDatabase(m_storageFilePath);
     if (!m_dbHandle) {
         ACSDK_ERROR(LX(__func__).m("Database could not be opened.").d("file path", m_storageFilePath));
         return false;
     }
 
+    shareConnectionLocked(connectionKey);
     return true;
 }
 
+void SQLiteDatabase::shareConnectionLocked(const std::string& connectionKey) {
+    if (connectionKey.empty()) {
+        return;
+    }
+    if (!g_sharedConnections.insert({connectionKey, {m_dbHandle, 1}}).second) {
+        // A connection to a previous file at this path is still open, leave the new connection unshared.
+        ACSDK_WARN(LX(__func__).m("Stale shared connection found, not sharing.").d("file path", m_storageFilePath));
+        return;
+    }
+    m_connectionKey = connectionKey;
+}
+
 bool SQLiteDatabase::performQuery(const std::string& sqlString) {
     if (!alexaClientSDK::storage::sqliteStorage::performQuery(m_dbHandle, sqlString)) {
         ACSDK_ERROR(LX(__func__).m("Table could not be created.").d("SQL string", sqlString));
@@ -119,10 +196,26 @@ bool SQLiteDatabase::clearTable(const std::string& tableName) {
 }
 
 void SQLiteDatabase::close() {
-    if (m_dbHandle) {
-        closeSQLiteDatabase(m_dbHandle);
-        m_dbHandle = nullptr;
+    if (!m_dbHandle) {
+        return;
     }
+
+    if (!m_connectionKey.empty()) {
+        std::lock_guard<std::mutex> lock(g_sharedConnectionsMutex);
+        auto it = g_sharedConnections.find(m_connectionKey);
+        m_connectionKey.clear();
+        if (it != g_sharedConnections.end() && it->second.dbHandle == m_dbHandle) {
+            if (--it->second.refCount > 0) {
+                // Other instances are still using the connection.
+                m_dbHandle = nullptr;
+                return;
+            }
+            g_sharedConnections.erase(it);
+        }
+    }
+
+    closeSQLiteDatabase(m_dbHandle);
+    m_dbHandle = nullptr;
 }
 
 std::unique_ptr<alexaClientSDK::storage::sqliteStorage::SQLiteStatement> SQLiteDatabase::createStatement(
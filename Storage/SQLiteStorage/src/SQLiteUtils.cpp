@@ -86,7 +86,8 @@ sqlite3* createSQLiteDatabase(const std::string& filePath) {
         return nullptr;
     }
 
-    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    // Connections may be shared by components running on different threads, so always use the serialized mode.
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX;
     sqlite3* dbHandle = openSQLiteDatabaseHelper(filePath, flags);
 
     if (!dbHandle) {
@@ -102,7 +103,7 @@ sqlite3* openSQLiteDatabase(const std::string& filePath) {
         return nullptr;
     }
 
-    int flags = SQLITE_OPEN_READWRITE;
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_FULLMUTEX;
     sqlite3* dbHandle = openSQLiteDatabaseHelper(filePath, flags);
 
     if (!dbHandle) {
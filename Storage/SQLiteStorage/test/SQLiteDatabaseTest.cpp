@@ -14,6 +14,7 @@
  */
 
 #include <cstdlib>
+#include <thread>
 
 #include <sys/time.h>
 
@@ -34,6 +35,9 @@ static std::string g_workingDirectory;
 static const std::string BAD_PATH =
     "_/_/_/there/is/no/way/this/path/should/exist/,/so/it/should/cause/an/error/when/creating/the/db";
 
+/// The number of times to try opening a file while another thread creates it.
+static const int MAX_OPEN_ATTEMPTS = 10000;
+
 /**
  * Helper function that generates a unique filepath using the passed in g_workingDirectory.
  *
@@ -130,6 +134,71 @@ TEST(SQLiteDatabaseTest, OpenTwice) {
     db1.close();
 }
 
+/// Test that instances opened on the same file share their connection, and therefore each other's tables.
+TEST(SQLiteDatabaseTest, SharedConnectionSeesOtherTables) {
+    auto dbFilePath = generateDbFilePath();
+    SQLiteDatabase db1(dbFilePath);
+    ASSERT_TRUE(db1.initialize());
+
+    SQLiteDatabase db2(dbFilePath);
+    ASSERT_TRUE(db2.open());
+
+    ASSERT_TRUE(db1.performQuery("CREATE TABLE first (id INT PRIMARY KEY NOT NULL);"));
+    ASSERT_TRUE(db2.performQuery("CREATE TABLE second (id INT PRIMARY KEY NOT NULL);"));
+    ASSERT_TRUE(db1.tableExists("second"));
+    ASSERT_TRUE(db2.tableExists("first"));
+
+    db2.close();
+    db1.close();
+}
+
+/// Test that closing one instance does not close the connection still used by another.
+TEST(SQLiteDatabaseTest, SharedConnectionOutlivesFirstClose) {
+    auto dbFilePath = generateDbFilePath();
+    SQLiteDatabase db1(dbFilePath);
+    ASSERT_TRUE(db1.initialize());
+    ASSERT_TRUE(db1.performQuery("CREATE TABLE shared (id INT PRIMARY KEY NOT NULL);"));
+
+    SQLiteDatabase db2(dbFilePath);
+    ASSERT_TRUE(db2.open());
+    db1.close();
+
+    ASSERT_TRUE(db2.performQuery("INSERT INTO shared (id) VALUES (1);"));
+    ASSERT_TRUE(db2.clearTable("shared"));
+
+    // Reopening after the last close must create a new connection.
+    db2.close();
+    ASSERT_TRUE(db1.open());
+    ASSERT_TRUE(db1.tableExists("shared"));
+    db1.close();
+}
+
+/// Test that an instance opening the file while another creates it shares the creator's connection.
+TEST(SQLiteDatabaseTest, OpenWhileInitializingSharesConnection) {
+    auto dbFilePath = generateDbFilePath();
+    SQLiteDatabase db1(dbFilePath);
+    SQLiteDatabase db2(dbFilePath);
+
+    bool opened = false;
+    std::thread opener([&db2, &opened] {
+        for (int attempt = 0; attempt < MAX_OPEN_ATTEMPTS && !opened; ++attempt) {
+            opened = db2.open();
+        }
+    });
+    ASSERT_TRUE(db1.initialize());
+    opener.join();
+    if (!opened) {
+        ASSERT_TRUE(db2.open());
+    }
+
+    // A temporary table is only visible to the connection which created it.
+    ASSERT_TRUE(db1.performQuery("CREATE TEMP TABLE temporary (id INT PRIMARY KEY NOT NULL);"));
+    ASSERT_TRUE(db2.performQuery("INSERT INTO temporary (id) VALUES (1);"));
+
+    db2.close();
+    db1.close();
+}
+
 }  // namespace test
 }  // namespace sqliteStorage
 }  // namespace storage
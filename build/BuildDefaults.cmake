@@ -27,9 +27,15 @@ include(PlaylistParser)
 # Setup media player variables.
 include(MediaPlayer)
 
+# Setup Opus variables.
+include(Opus)
+
 # Setup PortAudio variables.
 include(PortAudio)
 
+# Setup ALSA capture variables.
+include(AlsaCapture)
+
 # Setup Test Options variables.
 include(TestOptions)
 
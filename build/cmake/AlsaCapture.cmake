@@ -0,0 +1,20 @@
+#
+# Set up ALSA capture for the AudioCapture library.
+#
+# To build with ALSA capture, run the following command,
+#     cmake <path-to-source>
+#       -DALSA_CAPTURE=ON
+#
+# The ALSA headers and library are found with CMake's FindALSA module, which may be pointed at a sysroot with
+# -DALSA_INCLUDE_DIR=<path-to-alsa-include-dir> -DALSA_LIBRARY=<path-to-libasound>.
+#
+
+option(ALSA_CAPTURE "Enable ALSA capture in the AudioCapture library." OFF)
+
+if(ALSA_CAPTURE)
+    find_package(ALSA)
+    if(NOT ALSA_FOUND)
+        message(FATAL_ERROR "Must have the ALSA headers and library to enable ALSA capture.")
+    endif()
+    add_definitions(-DALSA_CAPTURE)
+endif()
@@ -0,0 +1,15 @@
+#
+# Setup the Opus encoder build.
+#
+# To encode the audio of Recognize events with Opus before it is uploaded, run the following command,
+#     cmake <path-to-source> -DOPUS=ON.
+#
+
+option(OPUS "Enable Opus encoding of Recognize audio." OFF)
+
+set(PKG_CONFIG_USE_CMAKE_PREFIX_PATH ON)
+if(OPUS)
+    find_package(PkgConfig)
+    pkg_check_modules(OPUS REQUIRED opus>=1.1)
+    add_definitions(-DENABLE_OPUS)
+endif()